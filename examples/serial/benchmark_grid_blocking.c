@@ -0,0 +1,266 @@
+/*
+ * File:        benchmark_grid_blocking.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Timing of the 3D HJ ENO/WENO + RK1 kernels with and without
+ *              cache blocking of the fillbox (see setGridBlockDims()).
+ */
+
+/*
+ * Usage:  benchmark_grid_blocking [N [block_size [num_steps]]]
+ *
+ * For each of the HJ_ENO2, HJ_ENO3 and HJ_WENO5 gradient approximations,
+ * a normal velocity step (gradient, right-hand side, RK1 update) is timed
+ * on an N^3 grid, first sweeping the entire fillbox with each kernel and
+ * then block by block with blocks of N x block_size x block_size cells.
+ * The maximum difference between the two results is reported as well;
+ * it should be zero.
+ *
+ * The defaults are N = 128, block_size = 16 and num_steps = 5.  Thirteen
+ * data arrays of (N+8)^3 values are allocated, i.e. roughly 0.25 GB for
+ * N = 128, 1.9 GB for N = 256 and 15 GB for N = 512 (double precision).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "LSMLIB_config.h"
+#include "lsm_grid.h"
+#include "lsm_macros.h"
+#include "lsm_spatial_derivatives3d.h"
+#include "lsm_level_set_evolution3d.h"
+#include "lsm_tvd_runge_kutta3d.h"
+
+#define NUM_SCHEMES 3
+
+typedef struct {
+  LSMLIB_REAL *phi, *phi_next, *rhs;
+  LSMLIB_REAL *phi_x_plus, *phi_y_plus, *phi_z_plus;
+  LSMLIB_REAL *phi_x_minus, *phi_y_minus, *phi_z_minus;
+  LSMLIB_REAL *D1, *D2, *D3;
+} BenchmarkArrays;
+
+static void computeNormalVelocityStep(BenchmarkArrays *a, Grid *g,
+                                      Grid *bg, int scheme,
+                                      LSMLIB_REAL *vel_n, LSMLIB_REAL *dt);
+
+
+int main(int argc, char **argv)
+{
+  int N = 128, block_size = 16, num_steps = 5;
+  int grid_dims[3], block_dims[3];
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0};
+  LSMLIB_REAL x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL vel_n = 1.0, dt, err, max_err;
+  LSMLIB_REAL *phi_flat, *tmp;
+  const char *scheme_names[NUM_SCHEMES] = {"HJ_ENO2", "HJ_ENO3", "HJ_WENO5"};
+
+  Grid *g;
+  Grid block_grid;
+  BenchmarkArrays a;
+  int i, j, k, idx, b, num_blocks, scheme, step;
+  LSMLIB_REAL x, y, z;
+  clock_t t0;
+  double time_flat = 0.0, time_blocked = 0.0;
+
+  if (argc > 1) N = atoi(argv[1]);
+  if (argc > 2) block_size = atoi(argv[2]);
+  if (argc > 3) num_steps = atoi(argv[3]);
+  if ( (N < 8) || (block_size < 0) || (num_steps < 1) ) {
+    fprintf(stderr,
+      "Usage: benchmark_grid_blocking [N [block_size [num_steps]]]\n");
+    return 1;
+  }
+
+  grid_dims[0] = grid_dims[1] = grid_dims[2] = N;
+  g = createGridSetGridDims(3, grid_dims, x_lo, x_hi, VERY_HIGH);
+  dt = 0.5*g->dx[0];
+
+  a.phi         = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.phi_next    = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.rhs         = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.phi_x_plus  = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.phi_y_plus  = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.phi_z_plus  = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.phi_x_minus = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.phi_y_minus = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.phi_z_minus = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.D1          = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.D2          = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  a.D3          = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  phi_flat      = (LSMLIB_REAL*) malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+
+  printf("\n*********** Cache blocking benchmark *************\n\n");
+  printf("Grid: %d^3 (ghostbox %d^3), block: %d x %d x %d, steps: %d\n\n",
+         N, g->grid_dims_ghostbox[0], N, block_size, block_size, num_steps);
+  printf("%-10s %14s %14s %10s %14s\n",
+         "scheme", "flat [s]", "blocked [s]", "speedup", "max diff");
+
+  for (scheme = 0; scheme < NUM_SCHEMES; scheme++) {
+
+    /* flat sweep, then blocked sweep starting from the same data */
+    for (b = 0; b < 2; b++) {
+      block_dims[0] = 0;
+      block_dims[1] = block_dims[2] = (b == 0) ? 0 : block_size;
+      setGridBlockDims(g, block_dims);
+
+      /* sphere of radius 0.5 with a perturbation */
+      for (k = 0; k < g->grid_dims_ghostbox[2]; k++) {
+        for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+          for (i = 0; i < g->grid_dims_ghostbox[0]; i++) {
+            idx = i + j*g->grid_dims_ghostbox[0]
+                + k*g->grid_dims_ghostbox[0]*g->grid_dims_ghostbox[1];
+            x = g->x_lo_ghostbox[0] + i*g->dx[0];
+            y = g->x_lo_ghostbox[1] + j*g->dx[1];
+            z = g->x_lo_ghostbox[2] + k*g->dx[2];
+            a.phi[idx] = sqrt(x*x + y*y + z*z) - 0.5 + 0.05*sin(5*x)*y;
+            a.phi_next[idx] = a.phi[idx];
+          }
+        }
+      }
+
+      t0 = clock();
+      for (step = 0; step < num_steps; step++) {
+        computeNormalVelocityStep(&a, g, &block_grid, scheme, &vel_n, &dt);
+        /* swap phi and phi_next (ghost cells are left unchanged) */
+        tmp = a.phi; a.phi = a.phi_next; a.phi_next = tmp;
+      }
+
+      if (b == 0) {
+        time_flat = (double)(clock() - t0)/CLOCKS_PER_SEC;
+        for (idx = 0; idx < g->num_gridpts; idx++) phi_flat[idx] = a.phi[idx];
+      } else {
+        time_blocked = (double)(clock() - t0)/CLOCKS_PER_SEC;
+      }
+    }
+
+    max_err = 0.0;
+    for (idx = 0; idx < g->num_gridpts; idx++) {
+      err = fabs(a.phi[idx] - phi_flat[idx]);
+      if (err > max_err) max_err = err;
+    }
+
+    num_blocks = getGridNumBlocks(g);
+    printf("%-10s %14.3f %14.3f %10.2f %14g   (%d blocks)\n",
+           scheme_names[scheme], time_flat, time_blocked,
+           (time_blocked > 0) ? time_flat/time_blocked : 0.0, max_err,
+           num_blocks);
+  }
+  printf("\n**************************************************\n\n");
+
+  free(a.phi);        free(a.phi_next);    free(a.rhs);
+  free(a.phi_x_plus); free(a.phi_y_plus);  free(a.phi_z_plus);
+  free(a.phi_x_minus);free(a.phi_y_minus); free(a.phi_z_minus);
+  free(a.D1);         free(a.D2);          free(a.D3);
+  free(phi_flat);
+  destroyGrid(g);
+
+  return 0;
+}
+
+
+/*
+ * computeNormalVelocityStep() takes a single forward Euler step of
+ * phi_t + vel_n |grad(phi)| = 0 from a.phi to a.phi_next using the
+ * HJ_ENO2 (scheme = 0), HJ_ENO3 (1) or HJ_WENO5 (2) gradient.  The
+ * kernels are applied block by block over the blocks of g; the undivided
+ * differences of a block are kept in the scratch box of the block.
+ */
+static void computeNormalVelocityStep(BenchmarkArrays *a, Grid *g,
+                                      Grid *bg, int scheme,
+                                      LSMLIB_REAL *vel_n, LSMLIB_REAL *dt)
+{
+  int b, num_blocks = getGridNumBlocks(g);
+  int sb[6];
+  LSMLIB_REAL zero = 0.0;
+
+  SET_DATA_TO_CONSTANT(a->rhs, g, zero)
+
+  for (b = 0; b < num_blocks; b++) {
+    getGridBlock(g, b, bg);
+    getGridBlockScratchBox(g, bg, sb);
+
+    if (scheme == 0) {
+      LSM3D_HJ_ENO2(a->phi_x_plus, a->phi_y_plus, a->phi_z_plus,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->phi_x_minus, a->phi_y_minus, a->phi_z_minus,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->phi,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->D1,
+        &(sb[0]), &(sb[1]), &(sb[2]), &(sb[3]), &(sb[4]), &(sb[5]),
+        a->D2,
+        &(sb[0]), &(sb[1]), &(sb[2]), &(sb[3]), &(sb[4]), &(sb[5]),
+        &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+        &(bg->klo_fb), &(bg->khi_fb),
+        &(g->dx[0]), &(g->dx[1]), &(g->dx[2]));
+    } else if (scheme == 1) {
+      LSM3D_HJ_ENO3(a->phi_x_plus, a->phi_y_plus, a->phi_z_plus,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->phi_x_minus, a->phi_y_minus, a->phi_z_minus,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->phi,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->D1,
+        &(sb[0]), &(sb[1]), &(sb[2]), &(sb[3]), &(sb[4]), &(sb[5]),
+        a->D2,
+        &(sb[0]), &(sb[1]), &(sb[2]), &(sb[3]), &(sb[4]), &(sb[5]),
+        a->D3,
+        &(sb[0]), &(sb[1]), &(sb[2]), &(sb[3]), &(sb[4]), &(sb[5]),
+        &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+        &(bg->klo_fb), &(bg->khi_fb),
+        &(g->dx[0]), &(g->dx[1]), &(g->dx[2]));
+    } else {
+      LSM3D_HJ_WENO5(a->phi_x_plus, a->phi_y_plus, a->phi_z_plus,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->phi_x_minus, a->phi_y_minus, a->phi_z_minus,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->phi,
+        &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+        &(bg->klo_gb), &(bg->khi_gb),
+        a->D1,
+        &(sb[0]), &(sb[1]), &(sb[2]), &(sb[3]), &(sb[4]), &(sb[5]),
+        &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+        &(bg->klo_fb), &(bg->khi_fb),
+        &(g->dx[0]), &(g->dx[1]), &(g->dx[2]));
+    }
+
+    LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(a->rhs,
+      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+      &(bg->klo_gb), &(bg->khi_gb),
+      a->phi_x_plus, a->phi_y_plus, a->phi_z_plus,
+      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+      &(bg->klo_gb), &(bg->khi_gb),
+      a->phi_x_minus, a->phi_y_minus, a->phi_z_minus,
+      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+      &(bg->klo_gb), &(bg->khi_gb),
+      vel_n,
+      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+      &(bg->klo_fb), &(bg->khi_fb));
+    LSM3D_RK1_STEP(a->phi_next,
+      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+      &(bg->klo_gb), &(bg->khi_gb),
+      a->phi,
+      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+      &(bg->klo_gb), &(bg->khi_gb),
+      a->rhs,
+      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+      &(bg->klo_gb), &(bg->khi_gb),
+      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+      &(bg->klo_fb), &(bg->khi_fb),
+      dt);
+  }
+}
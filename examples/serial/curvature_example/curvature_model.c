@@ -47,8 +47,14 @@ int main(int argc, char **argv)
        sprintf(fname,"%s",argv[1]);
        options = createOptionsFromInputFile(fname);
    }
+   else if( argc == 3 )
+   { /* restart from a container file written by a previous run */
+     options = createOptionsFromInputFile(argv[1]);
+     fname_data_in = argv[2];
+   }
    else if( argc >= 4 )
    { /* read data from provided input files */
+     options = createOptionsFromInputFile(argv[1]);
      fname_data_in = argv[2];
      fname_grid_in = argv[3];
      fname_mask_in = argv[4];
@@ -58,6 +64,7 @@ int main(int argc, char **argv)
      printf("\nRunning options:");
      printf("\n\t./curvature_model");
      printf("\n\t./curvature_model input_file");
+     printf("\n\t./curvature_model input_file restart.lsm");
      printf("\n\t./curvature_model input_file data_init grid mask");
      printf("\n"); 
    }
@@ -47,7 +47,7 @@ void curvatureModelMedium3dMainLoop(
   LSMLIB_REAL   cfl_number = 0.5;
   
   /* time variables */
-  LSMLIB_REAL   t, dt, dt_sub, max_H, dt_corr;
+  LSMLIB_REAL   t, dt, dt_block, dt_sub, max_H, dt_corr;
   LSMLIB_REAL   tplot, dt_min, dt_max;
   LSMLIB_REAL   tmax_r = 5*grid->dx[0]; /* max time for reinitialization */
   
@@ -62,6 +62,10 @@ void curvatureModelMedium3dMainLoop(
   int      OUTER_STEP, INNER_STEP, TOTAL_STEP;
   int      reinit_steps, last_reinit_step, ave_reinit_steps;
   
+  /* cache blocks of the fill box */
+  int      b, num_blocks;
+  Grid     block_grid, *bg = &block_grid;
+  
   /* writing shortcuts */
   Grid             *g = grid;
   LSM_DataArrays   *d = data_arrays;
@@ -123,6 +127,8 @@ void curvatureModelMedium3dMainLoop(
 		&eps);	 
   	
   tplot = (TPLOT < o->tmax ) ? TPLOT : o->tmax;
+  
+  num_blocks = getGridNumBlocks(g);
    		
   dt_min = 100.0; dt_max = 0;
    		
@@ -147,116 +153,123 @@ void curvatureModelMedium3dMainLoop(
       
       SET_DATA_TO_CONSTANT(d->lse_rhs,g,zero)    
      
-      if(o->a > 0)
-      {  
-         /* Compute upwinding gradient approximations */
-          LSM3D_HJ_ENO2(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		    &(g->klo_fb), &(g->khi_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));   
-         vel_n = o->a;
-	 
-	 LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(d->lse_rhs,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &vel_n,
-		    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		    &(g->klo_fb), &(g->khi_fb));
+      /* the right hand side is assembled block by block (see
+       * setGridBlockDims()) so that the derivatives of a block are
+       * consumed while they are still in cache
+       */
+      for(b = 0; b < num_blocks; b++)
+      {
+        getGridBlock(g,b,bg);
+
+        if(o->a > 0)
+        {  
+           /* Compute upwinding gradient approximations */
+            LSM3D_HJ_ENO2_NO_SCRATCH(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));   
+           vel_n = o->a;
+         
+           LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(d->lse_rhs,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &vel_n,
+                      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb));
                   
-	 /* figure out dt for hyperbolic term */
-	 LSM3D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT(&dt,&vel_n,
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus,  d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		    &(g->klo_fb), &(g->khi_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),		    
-		    &cfl_number);  
+           /* figure out dt for hyperbolic term */
+           LSM3D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT(&dt_block,&vel_n,
+                      d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x_minus, d->phi_y_minus,  d->phi_z_minus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),              
+                      &cfl_number);  
+           if( (b == 0) || (dt_block < dt) ) dt = dt_block;
+        }
+
+        if( o->b > 0)
+        {
+          /* Compute derivatives needed for curvature term*/
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x, d->phi_y, d->phi_z,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D1_fb), &(bg->ihi_D1_fb), 
+                      &(bg->jlo_D1_fb), &(bg->jhi_D1_fb),
+                      &(bg->klo_D1_fb), &(bg->khi_D1_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2])); 
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xx, d->phi_xy, d->phi_xz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D2_fb), &(bg->ihi_D2_fb), 
+                      &(bg->jlo_D2_fb), &(bg->jhi_D2_fb),
+                      &(bg->klo_D2_fb), &(bg->khi_D2_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2])); 
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xy, d->phi_yy, d->phi_yz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_y,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D2_fb), &(bg->ihi_D2_fb), 
+                      &(bg->jlo_D2_fb), &(bg->jhi_D2_fb),
+                      &(bg->klo_D2_fb), &(bg->khi_D2_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xz, d->phi_yz, d->phi_zz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_z,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D2_fb), &(bg->ihi_D2_fb), 
+                      &(bg->jlo_D2_fb), &(bg->jhi_D2_fb),
+                      &(bg->klo_D2_fb), &(bg->khi_D2_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));             
+        
+          LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS(d->lse_rhs,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x,d->phi_y,d->phi_z,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_xx,d->phi_xy,d->phi_xz,
+                      d->phi_yy,d->phi_yz,d->phi_zz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(o->b),
+                      &(bg->ilo_fb), &(bg->ihi_fb), 
+                      &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb));
+        }
       }
-      else dt = tplot;
-     
+      if(o->a <= 0) dt = tplot;
+
       if( o->b > 0)
       {
-	/* Compute derivatives needed for curvature term*/
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x, d->phi_y, d->phi_z,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D1_fb), &(g->ihi_D1_fb), 
-		    &(g->jlo_D1_fb), &(g->jhi_D1_fb),
-		    &(g->klo_D1_fb), &(g->khi_D1_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));	
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xx, d->phi_xy, d->phi_xz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));	
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xy, d->phi_yy, d->phi_yz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_y,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xz, d->phi_yz, d->phi_zz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));		    
-	
-	LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS(d->lse_rhs,
-	            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,d->phi_y,d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_xx,d->phi_xy,d->phi_xz,
-		    d->phi_yy,d->phi_yz,d->phi_zz,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(o->b),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb));
-	 
 	/* correct dt due to parabolic (curvature) term */
         if( o->a > 0 )
 	   max_H = cfl_number / dt;
@@ -297,121 +310,116 @@ void curvatureModelMedium3dMainLoop(
 
       SET_DATA_TO_CONSTANT(d->lse_rhs,g,zero)
       
-      if(o->a)
+      for(b = 0; b < num_blocks; b++)
       {
-	  LSM3D_HJ_ENO2(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_stage1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		    &(g->klo_fb), &(g->khi_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
-	 LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(d->lse_rhs,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &vel_n,
-		    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		    &(g->klo_fb), &(g->khi_fb));	    
-      }
+        getGridBlock(g,b,bg);
+
+        if(o->a)
+        {
+            LSM3D_HJ_ENO2_NO_SCRATCH(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_stage1,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+           LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(d->lse_rhs,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &vel_n,
+                      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb));            
+        }
       
-      if( o->b )
-      {
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x,d->phi_y,d->phi_z,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_stage1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D1_fb), &(g->ihi_D1_fb), 
-		    &(g->jlo_D1_fb), &(g->jhi_D1_fb),
-		    &(g->klo_D1_fb), &(g->khi_D1_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));	
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xx,d->phi_xy,d->phi_xz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));	
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xy,d->phi_yy,d->phi_yz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_y,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb), 
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
-	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xz, d->phi_yz, d->phi_zz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));		    
-	//Compute_and_add_curvature3d_lse_rhs(g,p,curv_tmp,grad_mag2)
-	LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS(d->lse_rhs,
-	            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,d->phi_y,d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_xx,d->phi_xy,d->phi_xz,
-		    d->phi_yy,d->phi_yz,d->phi_zz,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(o->b),
-		    &(g->ilo_D2_fb), &(g->ihi_D2_fb), 
-		    &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-		    &(g->klo_D2_fb), &(g->khi_D2_fb));
+        if( o->b )
+        {
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x,d->phi_y,d->phi_z,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_stage1,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D1_fb), &(bg->ihi_D1_fb), 
+                      &(bg->jlo_D1_fb), &(bg->jhi_D1_fb),
+                      &(bg->klo_D1_fb), &(bg->khi_D1_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2])); 
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xx,d->phi_xy,d->phi_xz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D2_fb), &(bg->ihi_D2_fb), 
+                      &(bg->jlo_D2_fb), &(bg->jhi_D2_fb),
+                      &(bg->klo_D2_fb), &(bg->khi_D2_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2])); 
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xy,d->phi_yy,d->phi_yz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_y,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D2_fb), &(bg->ihi_D2_fb), 
+                      &(bg->jlo_D2_fb), &(bg->jhi_D2_fb),
+                      &(bg->klo_D2_fb), &(bg->khi_D2_fb), 
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+          LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xz, d->phi_yz, d->phi_zz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_z,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_D2_fb), &(bg->ihi_D2_fb), 
+                      &(bg->jlo_D2_fb), &(bg->jhi_D2_fb),
+                      &(bg->klo_D2_fb), &(bg->khi_D2_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));             
+          //Compute_and_add_curvature3d_lse_rhs(g,p,curv_tmp,grad_mag2)
+          LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS(d->lse_rhs,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_x,d->phi_y,d->phi_z,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      d->phi_xx,d->phi_xy,d->phi_xz,
+                      d->phi_yy,d->phi_yz,d->phi_zz,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(o->b),
+                      &(bg->ilo_fb), &(bg->ihi_fb), 
+                      &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb));
+        }
+
+        LSM3D_LOW_STORAGE_TVD_RK2_STAGE2(d->phi,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     d->phi_stage1,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     d->lse_rhs,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                     &(bg->klo_fb), &(bg->khi_fb),
+                     &dt);
       }
-     
-      LSM3D_TVD_RK2_STAGE2(d->phi_next,
-                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi_stage1,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->lse_rhs,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		   &(g->klo_fb), &(g->khi_fb),
-		   &dt);
 
       /* boundary conditions */
-      signedLinearExtrapolationBC(d->phi_next,g,bdry_location_idx);	 
+      signedLinearExtrapolationBC(d->phi,g,bdry_location_idx);	 
 	 
       /* masking enforced so that the interface stays within pore space */	 
-       if(o->do_mask) IMPOSE_MASK(d->phi,d->mask,d->phi_next,g)  
-       else           COPY_DATA(d->phi,d->phi_next,g)
+       if(o->do_mask) IMPOSE_MASK(d->phi,d->mask,d->phi,g)
        
       dt_sub = dt_sub + dt;
    } /*inner loop */
@@ -461,7 +469,6 @@ void curvatureModelMedium3dMainLoop(
   ave_reinit_steps =ceil( (LSMLIB_REAL)(ave_reinit_steps) / (LSMLIB_REAL)(reinit_steps) );
   fprintf(fp_out,"\nTotal steps %d  Reinit. steps %d",TOTAL_STEP,reinit_steps);
   fprintf(fp_out,"\nReinitialized on average every %d steps.\n",ave_reinit_steps);
-  
 }
 
 
@@ -492,6 +499,9 @@ void reinitializeMedium3d(
     
     int    use_phi0_for_sign = 0;    
     int    bdry_location_idx = 9; /* all boundaries */
+    
+    int    b, num_blocks;
+    Grid   block_grid, *bg = &block_grid;
    
       /* writing shortcuts */
     Grid             *g = grid;
@@ -500,127 +510,121 @@ void reinitializeMedium3d(
    
     t_r = 0;
     dt_r = cfl_number * (g->dx)[0];
+    num_blocks = getGridNumBlocks(g);
       
     COPY_DATA(d->phi0,d->phi,g)
     
     while(t_r < tmax_r )
     {
-      LSM3D_HJ_ENO2(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-		    d->phi,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		    &(g->klo_fb), &(g->khi_fb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));   
-		    		    
-      LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(d->lse_rhs,
-                 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi0,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		 &(g->klo_fb), &(g->khi_fb),
-		 &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
-		 &use_phi0_for_sign);
+      for(b = 0; b < num_blocks; b++)
+      {
+        getGridBlock(g,b,bg);
+
+        LSM3D_HJ_ENO2_NO_SCRATCH(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb),&(bg->khi_gb),
+                      d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb),&(bg->khi_gb),
+                      d->phi,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb),
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));   
+                                    
+        LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(d->lse_rhs,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi0,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                   &(bg->klo_fb), &(bg->khi_fb),
+                   &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
+                   &use_phi0_for_sign);
  
-       LSM3D_TVD_RK2_STAGE1(d->phi_stage1,
-                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->lse_rhs,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		   &(g->klo_fb), &(g->khi_fb),
-		   &dt_r);
+         LSM3D_TVD_RK2_STAGE1(d->phi_stage1,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     d->phi,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     d->lse_rhs,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                     &(bg->klo_fb), &(bg->khi_fb),
+                     &dt_r);
+      }
       /* boundary conditions */
       signedLinearExtrapolationBC(d->phi_stage1,g,bdry_location_idx);	 	 	    
       
-      LSM3D_HJ_ENO2(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-		    d->phi_stage1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		    &(g->klo_fb), &(g->khi_fb), 
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
-       LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(d->lse_rhs,
-                 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_stage1,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi0,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		 &(g->klo_fb), &(g->khi_fb),
-		 &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
-		 &use_phi0_for_sign);
-	 
-       LSM3D_TVD_RK2_STAGE2(d->phi_next,
-                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi_stage1,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->lse_rhs,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
-		   &(g->klo_fb), &(g->khi_fb),
-		   &dt_r);
+      for(b = 0; b < num_blocks; b++)
+      {
+        getGridBlock(g,b,bg);
+
+        LSM3D_HJ_ENO2_NO_SCRATCH(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb),&(bg->khi_gb),
+                      d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb),&(bg->khi_gb),
+                      d->phi_stage1,
+                      &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                      &(bg->klo_gb), &(bg->khi_gb),
+                      &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                      &(bg->klo_fb), &(bg->khi_fb), 
+                      &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+         LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(d->lse_rhs,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi_stage1,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi0,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                   &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                   &(bg->klo_gb), &(bg->khi_gb),
+                   &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                   &(bg->klo_fb), &(bg->khi_fb),
+                   &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
+                   &use_phi0_for_sign);
+         
+         LSM3D_LOW_STORAGE_TVD_RK2_STAGE2(d->phi,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     d->phi_stage1,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     d->lse_rhs,
+                     &(bg->ilo_gb), &(bg->ihi_gb), &(bg->jlo_gb), &(bg->jhi_gb),
+                     &(bg->klo_gb), &(bg->khi_gb),
+                     &(bg->ilo_fb), &(bg->ihi_fb), &(bg->jlo_fb), &(bg->jhi_fb),
+                     &(bg->klo_fb), &(bg->khi_fb),
+                     &dt_r);
+      }
    	   
        /* boundary conditions */
-       signedLinearExtrapolationBC(d->phi_next,g,bdry_location_idx); 
+       signedLinearExtrapolationBC(d->phi,g,bdry_location_idx); 
       
        /* masking enforced so that the interface stays within pore space */
-       if(o->do_mask) IMPOSE_MASK(d->phi,d->mask,d->phi_next,g)	 
-       else           COPY_DATA(d->phi,d->phi_next,g)
+       if(o->do_mask) IMPOSE_MASK(d->phi,d->mask,d->phi,g)
        
        t_r = t_r + dt_r;   
     }
 }	 
-
@@ -42,6 +42,10 @@
 #define AVE_GRAD_PHI_MAX 1.1
 
 static unsigned char mark_gb=127, mark_D1=126, mark_D2=125, mark_fb=124;
+
+static void markNarrowBandBoundaryLayers3dLocal(LSM_DataArrays *,Grid *);
+static void reinitializeLevels01Medium3dLocal(LSM_DataArrays *,Grid *,
+                                             Options *,LSMLIB_REAL);
  
 /* 
 *  Main loop for localized constant curvature level set method model in 3D.
@@ -59,14 +63,14 @@ void curvatureModelMedium3dLocalMainLoop(
   LSMLIB_REAL   cfl_number = 0.5;
   
   /* time variables */
-  LSMLIB_REAL   t, dt, dt_sub, max_H, dt_corr;
+  LSMLIB_REAL   t, dt, dt_sub, max_H, dt_corr, dt_stage2;
   LSMLIB_REAL   tplot, dt_min, dt_max;
   
   LSMLIB_REAL   max_abs_err, eps, eps_stop;
  
   LSMLIB_REAL   zero = 0.0;
-  LSMLIB_REAL   vel_n, vol_phi, vol_max, vol_phi_prev, rel_vol_diff;
-  int      i, nx, nxy;  
+  LSMLIB_REAL   vel_n, b_curv, vol_phi, vol_max, vol_phi_prev, rel_vol_diff;
+  int      n, nx, nxy;  
   
   int      bdry_location_idx = 9; /* extrapolate all boundaries */
   
@@ -80,8 +84,9 @@ void curvatureModelMedium3dLocalMainLoop(
   Options          *o = options;
    
   /* variables specific for localization */
-  LSMLIB_REAL   beta, gamma;
+  LSMLIB_REAL   beta, gamma, phi_far;
   int      nlo_index, nhi_index, level; 
+  unsigned char *far_pts;
   
   LSMLIB_REAL   frac_nb, last_reinit_time, grad_phi_ave;  
   int      nb_level0, nb_level1, nb_level2;
@@ -89,7 +94,6 @@ void curvatureModelMedium3dLocalMainLoop(
   
   int      nlo_index_outer, nhi_index_outer;
   int      n_outer, change_sgn;
-  int      n_lo_copy[6], n_hi_copy[6];
   int      change_sgn_steps, grad_phi_ave_steps;
    
   t = 0;
@@ -122,6 +126,10 @@ void curvatureModelMedium3dLocalMainLoop(
             1.0/((g->dx)[2]*(g->dx)[2]);
   dt_corr *= 2.0*o->b;
   
+  /* coefficients of the normal velocity and curvature terms */
+  vel_n  = ( o->a > 0 ) ? o->a : 0.0;
+  b_curv = ( o->b > 0 ) ? o->b : 0.0;
+  
   /* this eps is suggested for Heaviside function in Fedkiw/Osher book */
   eps = 1.5*(g->dx[0]);
   nx = (g->grid_dims_ghostbox)[0];
@@ -157,8 +165,11 @@ void curvatureModelMedium3dLocalMainLoop(
   /* will need narrow band level 0,1,2,3 */
   level = 3; 
   
-  /* localization: reinitialize globally so T0 can be set */
-  reinitializeMedium3d(d,g,o,gamma + g->dx[0]); 	 
+  /* localization: magnitude of phi, phi_stage1 and phi_next at the grid
+     points more than FAR_CELLS grid cells away from the level 0 narrow
+     band (see curvature_model_top.h) */
+  phi_far = FAR_CELLS*(g->dx)[0];
+  far_pts = (unsigned char *)malloc(g->num_gridpts*sizeof(unsigned char));
 
   /* localization - allocated number of index points array elements */
   nlo_index = 0; 
@@ -166,6 +177,28 @@ void curvatureModelMedium3dLocalMainLoop(
   nlo_index_outer = 0;
   nhi_index_outer = d->num_alloc_index_outer_pts-1;
   
+  /* localization: reinitialize within the narrow band so T0 can be set;
+     only the narrow band points of phi_stage1 and phi_next are updated 
+     during a time step, the other points start out equal to phi */
+  COPY_DATA(d->phi_stage1,d->phi,g)
+  COPY_DATA(d->phi_next,d->phi,g)
+  LSM3D_DETERMINE_NARROW_BAND(d->phi,
+       &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+       &(g->klo_gb), &(g->khi_gb),
+       d->narrow_band,
+       &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+       &(g->klo_gb), &(g->khi_gb),
+       d->index_x, d->index_y, d->index_z,
+       &nlo_index, &nhi_index,
+       d->n_lo,d->n_hi,
+       d->index_outer_pts,
+       &nlo_index_outer, &nhi_index_outer,
+       &(d->nlo_outer_plus),  &(d->nhi_outer_plus),
+       &(d->nlo_outer_minus), &(d->nhi_outer_minus),
+       &gamma,&beta,&level);
+  markNarrowBandBoundaryLayers3dLocal(d,g);
+  reinitializeLevels01Medium3dLocal(d,g,o,gamma + g->dx[0]);
+
   OUTER_STEP = 0; INNER_STEP = 0; TOTAL_STEP = 0;
   last_reinit_step = 0; last_reinit_time = 0;
   reinit_steps = change_sgn_steps = grad_phi_ave_steps = 0;
@@ -178,7 +211,6 @@ void curvatureModelMedium3dLocalMainLoop(
     OUTER_STEP++;
     dt_sub = 0;
     
-    COPY_DATA(d->phi_prev,d->phi,g)
     vol_phi_prev = vol_phi; 
     
     while( dt_sub < tplot )
@@ -206,173 +238,47 @@ void curvatureModelMedium3dLocalMainLoop(
       /* mark boundary layers in narrow_band array 
       *  These layer marks to be used in Fortran functions for checking if the
       *	 point is in the correct fill box.
-     */     	   	   
-      LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
-       	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-           &(g->klo_gb), &(g->khi_gb),
-	   &(g->ilo_D2_fb), &(g->ihi_D2_fb), &(g->jlo_D2_fb), &(g->jhi_D2_fb),
-           &(g->klo_D2_fb), &(g->khi_D2_fb),
-	   &mark_D2);
-	   
-      LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
-       	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-           &(g->klo_gb), &(g->khi_gb),
-	   &(g->ilo_D1_fb), &(g->ihi_D1_fb), &(g->jlo_D1_fb), &(g->jhi_D1_fb),
-           &(g->klo_D1_fb), &(g->khi_D1_fb),
-	   &mark_D1);
-	   
-      LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
-       	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-           &(g->klo_gb), &(g->khi_gb),
-	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-           &(g->klo_gb), &(g->khi_gb),
-	   &mark_gb);	   	   
+      */
+      markNarrowBandBoundaryLayers3dLocal(d,g);
+
+      if( dt_sub == 0 )
+      { /* localization: at the start of a time interval, reset the 
+           values left far outside of the narrow band by earlier time 
+	   steps (this is where tiled storage releases tiles, see 
+	   curvature_model3d_tiled.c) */
+        for(n = 0; n < g->num_gridpts; n++)
+	   far_pts[n] = ( (d->narrow_band)[n] == 1 ) ? 0 : 1;
+        markFarGridPoints3d(far_pts,g->grid_dims_ghostbox,FAR_CELLS);
+
+        SET_DATA_FAR_FROM_NARROW_BAND(d->phi_stage1,d->phi,far_pts,phi_far,g)
+        SET_DATA_FAR_FROM_NARROW_BAND(d->phi_next,d->phi,far_pts,phi_far,g)
+        SET_DATA_FAR_FROM_NARROW_BAND(d->phi,d->phi,far_pts,phi_far,g)
+        COPY_DATA(d->phi_prev,d->phi,g)
+      }
 	   
-      LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL(d->lse_rhs,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0]);
-     
-      if(o->a > 0)
-      {  
-         /* Compute upwinding gradient approximations */ 
-          LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+      /* Compute the normal velocity and curvature terms of the level set
+         equation and the time spacing for the hyperbolic term in a single 
+         pass over the narrow band (no derivative arrays are stored) */
+      LSM3D_COMPUTE_CONST_NORMAL_VEL_CONST_CURV_LSE_RHS_LOCAL(d->lse_rhs,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
 		    d->phi,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
+		    &vel_n, &b_curv,
+		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),&cfl_number,
+		    &dt,
 		    d->index_x, d->index_y, d->index_z,
 		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    &(d->n_lo)[1],&(d->n_hi)[1],
-		    &(d->n_lo)[2],&(d->n_hi)[2],
 		    d->narrow_band,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1,&mark_D2); 
-	 
-	 vel_n = o->a;
-	 
-	 LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &vel_n,
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],		    
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
 		    &mark_fb);
-                  
-	 /* figure out time spacing for hyperbolic term */
-	 LSM3D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT_LOCAL(&dt,&vel_n,
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus,  d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),		    
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),&cfl_number,
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],		    
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),	
-		    &mark_fb);  
-      }
-      else dt = tplot;
-     
+
+      if( o->a <= 0 ) dt = tplot;
+
       if( o->b > 0)
       {
-	/* Compute derivatives needed for curvature */	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_x, d->phi_y, d->phi_z,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z, 
-		    &(d->n_lo)[0],&(d->n_hi)[1],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D1);	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xx, d->phi_xy, d->phi_xz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z, 
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);		
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xy, d->phi_yy, d->phi_yz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_y,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xz, d->phi_yz, d->phi_zz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);
-		    
-	LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
-	            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,d->phi_y,d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_xx,d->phi_xy,d->phi_xz,
-		    d->phi_yy,d->phi_yz,d->phi_zz,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(o->b),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0], &(d->n_hi)[0],
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb);
-		    	
 	/* correct dt due to parabolic (curvature) term */
         if( o->a > 0 )
 	   max_H = cfl_number / dt;
@@ -380,7 +286,7 @@ void curvatureModelMedium3dLocalMainLoop(
 	   max_H = 0;
 	   
 	dt =  cfl_number / (max_H + dt_corr);
-      }	    
+      }
 
       if( dt < DT_MIN_TO_CORRECT ) dt = DT_MIN; 
        
@@ -428,130 +334,22 @@ void curvatureModelMedium3dLocalMainLoop(
       /* masking enforced so that the interface stays within pore space */
       if(o->do_mask) IMPOSE_MASK_LOCAL(d->phi_stage1,d->mask,d->phi_stage1,g,d);       
 
-      LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL(d->lse_rhs,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[2]);  
-      
-      if(o->a)
-      {
-	  LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+      /* right-hand side at phi_stage1 (the time spacing is not needed) */
+      LSM3D_COMPUTE_CONST_NORMAL_VEL_CONST_CURV_LSE_RHS_LOCAL(d->lse_rhs,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
 		    d->phi_stage1,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    &(d->n_lo)[1],&(d->n_hi)[1],
-		    &(d->n_lo)[2],&(d->n_hi)[2],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1,&mark_D2);   
-		        
-	 LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &vel_n,
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],		    
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb);	    
-      }
-      
-      if( o->b )
-      {       
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_x,d->phi_y,d->phi_z,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_stage1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[1],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D1);		
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xx,d->phi_xy,d->phi_xz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);		
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xy,d->phi_yy,d->phi_yz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_y,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xz, d->phi_yz, d->phi_zz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
+		    &vel_n, &b_curv,
+		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),&cfl_number,
+		    &dt_stage2,
 		    d->index_x, d->index_y, d->index_z,
 		    &(d->n_lo)[0],&(d->n_hi)[0],
 		    d->narrow_band,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);
-
-	LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
-	            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,d->phi_y,d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_xx,d->phi_xy,d->phi_xz,
-		    d->phi_yy,d->phi_yz,d->phi_zz,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(o->b),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0], &(d->n_hi)[0],
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
 		    &mark_fb);
-      }     
      
       /* localization: modify equation by a cut-off function */
       LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(d->phi_stage1, d->lse_rhs,
@@ -654,26 +452,7 @@ void curvatureModelMedium3dLocalMainLoop(
            last_reinit_step = TOTAL_STEP;
 	   reinit_steps++;	   
 	   
-           /* N0 for reinitialization purposes is tube T0 plus its
-	     first neighbors; essentially level 0 and level 1 narrow band */
-	     
-	   for(i = 0; i < 6; i++)
-	   {
-	     n_lo_copy[i] = d->n_lo[i];    n_hi_copy[i] = d->n_hi[i];
-	   }
-	   
-	   /* shift limits in order to reinitialize on wider narrow band */
-	   d->n_hi[0] = d->n_hi[1];
-	   d->n_lo[1] = d->n_lo[2];   d->n_hi[1] = d->n_hi[2];
-	   d->n_lo[2] = d->n_lo[3];   d->n_hi[2] = d->n_hi[3];
-	         
-           reinitializeMedium3dLocal(d,g,o,gamma + 2*g->dx[0]);
-	   
-	   /* copy old limit values back */
-	   for(i = 0; i < 6; i++)
-	   {
-	      d->n_lo[i] = n_lo_copy[i];  d->n_hi[i] = n_hi_copy[i];
-	   }
+           reinitializeLevels01Medium3dLocal(d,g,o,gamma + 2*g->dx[0]);
        }
     
       dt_sub = dt_sub + dt;
@@ -735,6 +514,7 @@ void curvatureModelMedium3dLocalMainLoop(
          TOTAL_STEP, reinit_steps,change_sgn_steps,grad_phi_ave_steps);
   fprintf(fp_out,"\nReinitialized on average every %d steps.\n",ave_reinit_steps); 
   
+  free(far_pts);
 }
 
 
@@ -783,7 +563,7 @@ void reinitializeMedium3dLocal(
     
     while(t_r < tmax_r )
     {
-       LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+       LSM3D_HJ_ENO2_LOCAL_NO_SCRATCH(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
                     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb),&(g->khi_gb),
                     d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
@@ -792,12 +572,6 @@ void reinitializeMedium3dLocal(
 		    d->phi,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
 		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
 		    d->index_x, d->index_y, d->index_z,
 		    &(d->n_lo)[0],&(d->n_hi)[0],
@@ -806,7 +580,7 @@ void reinitializeMedium3dLocal(
 		    d->narrow_band,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1,&mark_D2);
+		    &mark_fb);
 		    
       LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(d->lse_rhs,
                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
@@ -852,7 +626,7 @@ void reinitializeMedium3dLocal(
       /* boundary conditions */ 
       signedLinearExtrapolationBC(d->phi_stage1,g,bdry_location_idx);
       
-      LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+      LSM3D_HJ_ENO2_LOCAL_NO_SCRATCH(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
                     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb),&(g->khi_gb),
                     d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
@@ -861,12 +635,6 @@ void reinitializeMedium3dLocal(
 		    d->phi_stage1,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
 		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
 		    d->index_x, d->index_y, d->index_z,
 		    &(d->n_lo)[0],&(d->n_hi)[0],
@@ -875,7 +643,7 @@ void reinitializeMedium3dLocal(
 		    d->narrow_band,
 		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1, &mark_D2);   
+		    &mark_fb);   
  
        LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(d->lse_rhs,
                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
@@ -932,3 +700,125 @@ void reinitializeMedium3dLocal(
     }
 }	 
 
+
+/*
+*  markNarrowBandBoundaryLayers3dLocal() marks the boundary layers of the
+*  fillboxes in the narrow_band array.  These layer marks are used in the
+*  Fortran functions for checking if a point is in the correct fill box.
+*/
+static void markNarrowBandBoundaryLayers3dLocal(
+     LSM_DataArrays *d,
+     Grid           *g)
+{
+  LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
+       &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+       &(g->klo_gb), &(g->khi_gb),
+       &(g->ilo_D2_fb), &(g->ihi_D2_fb), &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+       &(g->klo_D2_fb), &(g->khi_D2_fb),
+       &mark_D2);
+	   
+  LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
+       &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+       &(g->klo_gb), &(g->khi_gb),
+       &(g->ilo_D1_fb), &(g->ihi_D1_fb), &(g->jlo_D1_fb), &(g->jhi_D1_fb),
+       &(g->klo_D1_fb), &(g->khi_D1_fb),
+       &mark_D1);
+	   
+  LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
+       &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+       &(g->klo_gb), &(g->khi_gb),
+       &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+       &(g->klo_gb), &(g->khi_gb),
+       &mark_gb);
+}
+
+
+/*
+*  reinitializeLevels01Medium3dLocal() calls reinitializeMedium3dLocal()
+*  on a wider narrow band: N0 for reinitialization purposes is tube T0 
+*  plus its first neighbors; essentially level 0 and level 1 narrow band.
+*/
+static void reinitializeLevels01Medium3dLocal(
+     LSM_DataArrays *d,
+     Grid           *g,
+     Options        *o,
+     LSMLIB_REAL    tmax_r)
+{
+  int  i, n_lo_copy[6], n_hi_copy[6];
+	     
+  for(i = 0; i < 6; i++)
+  {
+    n_lo_copy[i] = d->n_lo[i];    n_hi_copy[i] = d->n_hi[i];
+  }
+	   
+  /* shift limits in order to reinitialize on wider narrow band */
+  d->n_hi[0] = d->n_hi[1];
+  d->n_lo[1] = d->n_lo[2];   d->n_hi[1] = d->n_hi[2];
+  d->n_lo[2] = d->n_lo[3];   d->n_hi[2] = d->n_hi[3];
+	         
+  reinitializeMedium3dLocal(d,g,o,tmax_r);
+	   
+  /* copy old limit values back */
+  for(i = 0; i < 6; i++)
+  {
+    d->n_lo[i] = n_lo_copy[i];  d->n_hi[i] = n_hi_copy[i];
+  }
+}
+
+
+/*
+*  markFarGridPoints3d() marks the grid points that are more than 
+*  far_cells grid cells away (in the maximum norm) from a set of seed
+*  points, e.g. the level 0 narrow band points.
+*
+*  Arguments:
+*   far       - on entry, 0 at the seed points and non-zero elsewhere;
+*               on return, 0 at the grid points within far_cells grid 
+*               cells of a seed point and 1 elsewhere
+*   box_dims  - dimensions of the far array (i changes fastest)
+*   far_cells - distance in grid cells (at most 254)
+*/
+void markFarGridPoints3d(
+     unsigned char *far,
+     int           *box_dims,
+     int           far_cells)
+{
+  int  dir, stride, len, num_outer, o, i, m, idx, dist;
+
+  /* the maximum norm distance is computed one direction at a time from
+     the grid points within far_cells grid cells along the previous
+     directions */
+  stride = 1;
+  for(dir = 0; dir < 3; dir++)
+  {
+    len = box_dims[dir];
+    num_outer = box_dims[0]*box_dims[1]*box_dims[2]/(stride*len);
+    for(o = 0; o < num_outer; o++)
+    {
+      for(i = 0; i < stride; i++)
+      {
+        /* forward sweep: distance to the nearest seed point below */
+        idx = o*stride*len + i;
+        dist = far_cells + 1;
+	for(m = 0; m < len; m++, idx += stride)
+	{
+	  if( far[idx] == 0 )           dist = 0;
+	  else if( dist <= far_cells )  dist++;
+	  far[idx] = (unsigned char) dist;
+	}
+
+        /* backward sweep: distance to the nearest seed point above */
+	idx -= stride;
+        dist = far_cells + 1;
+	for(m = 0; m < len; m++, idx -= stride)
+	{
+	  if( far[idx] == 0 )           dist = 0;
+	  else if( dist <= far_cells )  dist++;
+	  far[idx] = ( (far[idx] <= far_cells) || (dist <= far_cells) ) ?
+	             0 : 1;
+	}
+      }
+    }
+    stride *= len;
+  }
+}
@@ -12,5 +12,6 @@
 
 void  curvatureModelMedium3dLocalMainLoop(Options *,LSM_DataArrays  *,Grid  *,FILE *);
 void  reinitializeMedium3dLocal(LSM_DataArrays *,Grid *,Options *,LSMLIB_REAL);
+void  markFarGridPoints3d(unsigned char *,int *,int);
 
 #endif
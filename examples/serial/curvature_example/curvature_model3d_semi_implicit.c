@@ -0,0 +1,481 @@
+/*
+ * File:        curvature_model3d_semi_implicit.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Support file for 3D constant curvature flow with
+ *              semi-implicit time integration.
+ */
+
+/* System headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/* LSMLIB headers */
+#include "LSMLIB_config.h"
+#include "lsm_level_set_evolution3d.h"
+#include "lsm_spatial_derivatives3d.h"
+#include "lsm_utilities3d.h"
+#include "lsm_tvd_runge_kutta3d.h"
+#include "lsm_semi_implicit3d.h"
+#include "lsm_geometry3d.h"
+
+/* LSMLIB Serial package headers */
+#include "lsm_boundary_conditions.h"
+#include "lsm_macros.h"
+
+/* Local headers */
+#include "curvature_model_top.h"
+#include "curvature_model3d.h"
+#include "curvature_model3d_semi_implicit.h"
+
+#define DT_MIN_TO_CORRECT 1e-5
+#define DT_MIN            0.001
+
+static void computeCurvatureModelRHS(LSMLIB_REAL *,LSM_DataArrays *,Grid *,
+                                     Options *,LSMLIB_REAL,LSMLIB_REAL *);
+static void projectRHSOntoMask(LSMLIB_REAL *,LSMLIB_REAL *,LSMLIB_REAL *,
+                               Grid *);
+
+/*
+*  Main loop for constant curvature level set method model in 3D using
+*  semi-implicit time integration (see lsm_semi_implicit3d.h).
+*
+*  The right-hand side is computed exactly as in
+*  curvatureModelMedium3dMainLoop(), but before each TVD Runge-Kutta stage
+*  it is passed through LSM3D_SEMI_IMPLICIT_CURVATURE_RHS(), which treats
+*  the curvature term semi-implicitly.  Each stage is then stable for time
+*  steps limited only by the CFL condition for the normal velocity term,
+*  so there is no dt ~ dx^2 restriction due to the curvature term.
+*
+*  NOTES:
+*  - If there is no normal velocity term (a = 0), the time step is set to
+*    cfl_number*dx/b, i.e. the step that the CFL condition would give
+*    for a normal velocity equal to b.
+*  - Before the semi-implicit solve, the right-hand side is set to zero
+*    outside of the pore space and where the mask constraint would undo
+*    the update (see projectRHSOntoMask()).  With explicit time
+*    integration, the right-hand side at these grid points has no effect
+*    on the interface, but the implicit operator would spread it into the
+*    pore space and the interface would come to rest at a different
+*    position.
+*  - The tridiagonal solves couple all grid points along each grid line,
+*    so the fill box is not split into cache blocks ('block_size' is
+*    ignored).
+*/
+
+void curvatureModelMedium3dSemiImplicitMainLoop(
+     Options          *options,
+     LSM_DataArrays   *data_arrays,
+     Grid             *grid,
+     FILE             *fp_out)
+{
+  LSMLIB_REAL   cfl_number = 0.5;
+
+  /* time variables */
+  LSMLIB_REAL   t, dt, dt_sub;
+  LSMLIB_REAL   tplot, dt_min, dt_max;
+  LSMLIB_REAL   tmax_r = 5*grid->dx[0]; /* max time for reinitialization */
+
+  LSMLIB_REAL   max_abs_err, eps, eps_stop;
+
+  LSMLIB_REAL   vol_phi, vol_max, vol_phi_prev, rel_vol_diff;
+
+  int      bdry_location_idx = 9; /* extrapolate all boundaries */
+
+  int      OUTER_STEP, INNER_STEP, TOTAL_STEP;
+  int      reinit_steps, last_reinit_step, ave_reinit_steps;
+
+  /* work array for the tridiagonal solves */
+  int      n_work;
+  LSMLIB_REAL   *work;
+
+  /* writing shortcuts */
+  Grid             *g = grid;
+  LSM_DataArrays   *d = data_arrays;
+  Options          *o = options;
+
+  t = 0;
+  /* every TPLOT time period we evaluate max. abs. error as well as
+  *  reinitalize the function as needed.
+  */
+  max_abs_err = 1000.0;
+
+  /* stopping criterion - somewhat arbitrary,
+    modify EMAX_STOP in the accompanying .h file
+  */
+  eps_stop = EMAX_STOP *(g->dx)[0]; //stopping criterion
+  if( options->print_details)
+  {
+    fprintf(fp_out,"\nTPLOT %g eps_stop %g set internally\n",TPLOT,eps_stop);
+    fprintf(fp_out,"Simulation continues until given time tmax is reached\n");
+    fprintf(fp_out,"or max.abs.error for phi(:,t) - phi(:,t-TPLOT)");
+    fprintf(fp_out," is less than eps_stop.\n");
+    fprintf(fp_out,"Curvature term is integrated semi-implicitly.\n");
+    fprintf(fp_out,"-----------------------------------------------------\n");
+    fprintf(fp_out,"\nEach TPLOT time, we report on:");
+    fprintf(fp_out,"\nvol_phi - the volume occupied by the neg. level set phase");
+    fprintf(fp_out,"\nvol_frac - the fraction of pore space (vol_max)");
+    fprintf(fp_out," occupied by the neg. level set phase");
+    fprintf(fp_out,"\nrel_vol_diff - the relative volume difference btw two time steps");
+    fprintf(fp_out,"\n");
+  }
+
+  /* this eps is suggested for Heaviside function in Fedkiw/Osher book */
+  eps = 1.5*(g->dx[0]);
+
+  /* the work array must cover the longest grid line of the fill box */
+  n_work = (g->grid_dims_ghostbox)[0];
+  if( (g->grid_dims_ghostbox)[1] > n_work ) n_work = (g->grid_dims_ghostbox)[1];
+  if( (g->grid_dims_ghostbox)[2] > n_work ) n_work = (g->grid_dims_ghostbox)[2];
+  work = (LSMLIB_REAL *)malloc(n_work*sizeof(LSMLIB_REAL));
+
+  /* compute volume of the pore space */
+  LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO(&vol_max,
+	        d->mask,
+		&(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		&(g->klo_gb), &(g->khi_gb),
+		&(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+		&(g->klo_fb), &(g->khi_fb),
+		&(g->dx[0]),&(g->dx[1]),&(g->dx[2]),
+		&eps);
+
+  /* compute volume of the fluid */
+  LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO(&vol_phi,
+	        d->phi,
+		&(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		&(g->klo_gb), &(g->khi_gb),
+		&(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+		&(g->klo_fb), &(g->khi_fb),
+		&(g->dx[0]),&(g->dx[1]),&(g->dx[2]),
+		&eps);
+
+  tplot = (TPLOT < o->tmax ) ? TPLOT : o->tmax;
+
+  dt_min = 100.0; dt_max = 0;
+
+  OUTER_STEP = 0; INNER_STEP = 0; TOTAL_STEP = 0;
+  last_reinit_step = 0;
+  reinit_steps = ave_reinit_steps = 0;
+
+  while( (t < o->tmax)  && (max_abs_err > eps_stop) && (vol_phi > eps_stop))
+  {  /* outer loop - the code is set up to output some error information
+     *  volume fractions etc. as the computation progresses
+     */
+    OUTER_STEP++;
+    dt_sub = 0;
+
+    COPY_DATA(d->phi_prev,d->phi,g)
+    vol_phi_prev = vol_phi;
+
+    while( dt_sub < tplot )
+    { /* inner loop */
+      INNER_STEP++;
+      TOTAL_STEP++;
+
+      computeCurvatureModelRHS(d->phi,d,g,o,cfl_number,&dt);
+      if(o->do_mask) projectRHSOntoMask(d->lse_rhs,d->phi,d->mask,g);
+
+      /* time step is limited by the normal velocity term only */
+      if( o->a <= 0 )
+      {
+        if( o->b > 0 ) dt = cfl_number*(g->dx)[0]/o->b;
+        else           dt = tplot;
+      }
+
+      if( dt < DT_MIN_TO_CORRECT ) dt = DT_MIN;
+
+      if(dt_sub + dt > tplot)
+      {
+	  dt = tplot - dt_sub;
+      }
+
+      /* collect info on max. and min. time spacing */
+      if(dt > dt_max) dt_max = dt;
+      if(dt < dt_min) dt_min = dt;
+
+      LSM3D_SEMI_IMPLICIT_CURVATURE_RHS(d->lse_rhs,
+                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		   &(g->klo_gb), &(g->khi_gb),
+		   work, &n_work,
+		   &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+		   &(g->klo_fb), &(g->khi_fb),
+		   &dt, &(o->b),
+		   &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+
+      LSM3D_TVD_RK2_STAGE1(d->phi_stage1,
+                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		   &(g->klo_gb), &(g->khi_gb),
+		   d->phi,
+		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		   &(g->klo_gb), &(g->khi_gb),
+		   d->lse_rhs,
+		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		   &(g->klo_gb), &(g->khi_gb),
+		   &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+		   &(g->klo_fb), &(g->khi_fb),
+		   &dt);
+      /* boundary conditions */
+      signedLinearExtrapolationBC(d->phi_stage1,g,bdry_location_idx);
+
+      /* masking enforced so that the interface stays within pore space */
+      if(o->do_mask) IMPOSE_MASK(d->phi_stage1,d->mask,d->phi_stage1,g);
+
+      computeCurvatureModelRHS(d->phi_stage1,d,g,o,cfl_number,
+                               (LSMLIB_REAL *)NULL);
+      if(o->do_mask) projectRHSOntoMask(d->lse_rhs,d->phi_stage1,d->mask,g);
+
+      LSM3D_SEMI_IMPLICIT_CURVATURE_RHS(d->lse_rhs,
+                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		   &(g->klo_gb), &(g->khi_gb),
+		   work, &n_work,
+		   &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+		   &(g->klo_fb), &(g->khi_fb),
+		   &dt, &(o->b),
+		   &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+
+      LSM3D_LOW_STORAGE_TVD_RK2_STAGE2(d->phi,
+                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                   &(g->klo_gb), &(g->khi_gb),
+                   d->phi_stage1,
+                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                   &(g->klo_gb), &(g->khi_gb),
+                   d->lse_rhs,
+                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                   &(g->klo_gb), &(g->khi_gb),
+                   &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+                   &(g->klo_fb), &(g->khi_fb),
+                   &dt);
+
+      /* boundary conditions */
+      signedLinearExtrapolationBC(d->phi,g,bdry_location_idx);
+
+      /* masking enforced so that the interface stays within pore space */
+       if(o->do_mask) IMPOSE_MASK(d->phi,d->mask,d->phi,g)
+
+      dt_sub = dt_sub + dt;
+   } /*inner loop */
+
+   t = t + dt_sub;
+
+   if(o->do_reinit)
+   {  /* periodic reinitialization of the level set function */
+      reinitializeMedium3d(d,g,o,tmax_r);
+
+      ave_reinit_steps += TOTAL_STEP - last_reinit_step;
+      last_reinit_step = TOTAL_STEP;
+      reinit_steps++;
+   }
+
+   /* compute max abs error */
+   LSM3D_MAX_NORM_DIFF(&max_abs_err,d->phi,
+            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+	    &(g->klo_gb), &(g->khi_gb),
+	    d->phi_prev,
+	    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+	    &(g->klo_gb), &(g->khi_gb),
+	    &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+	    &(g->klo_fb), &(g->khi_fb));
+   LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO(&vol_phi,
+	    d->phi,
+            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+	    &(g->klo_gb), &(g->khi_gb),
+            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+            &(g->klo_gb), &(g->khi_gb),
+            &(g->dx[0]),&(g->dx[1]),&(g->dx[2]),
+	    &eps);
+
+   printf("Time interval [%g,%g], max. abs. error %g\n", t-tplot,t,max_abs_err);
+   fprintf(fp_out,"Time interval [%g,%g], max. abs. error %g\n",t-tplot,t,
+                                                                  max_abs_err);
+   /* relative difference in volume */
+   rel_vol_diff = fabs(vol_phi_prev - vol_phi)/vol_phi_prev;
+   fprintf(fp_out," rel_vol_diff %g vol_phi %g vol_frac %g\n",
+                                 rel_vol_diff,vol_phi,vol_phi/vol_max);
+   fprintf(fp_out," dt_min %g dt_max %g\n",dt_min,dt_max);
+   fflush(stdout); fflush(fp_out);
+  } /* outer loop */
+
+
+  /* Print out statistics on reinitialization */
+  ave_reinit_steps =ceil( (LSMLIB_REAL)(ave_reinit_steps) / (LSMLIB_REAL)(reinit_steps) );
+  fprintf(fp_out,"\nTotal steps %d  Reinit. steps %d",TOTAL_STEP,reinit_steps);
+  fprintf(fp_out,"\nReinitialized on average every %d steps.\n",ave_reinit_steps);
+
+  free(work);
+}
+
+
+/*
+*  computeCurvatureModelRHS() sets lse_rhs to the right-hand side of the
+*  level set equation phi_t + a |grad_phi| = b kappa |grad_phi| evaluated
+*  using phi (curvature term treated explicitly).
+*
+*  Arguments:
+*   phi          - level set function
+*   data_arrays  - LSMLIB Serial package data arrays structure
+*   grid         - LSMLIB Serial package Grid structure
+*   options      - (local) Options structure; elements used are 'a' and 'b'
+*   cfl_number   - CFL number for the normal velocity term
+*   dt           - if not NULL and a > 0, set to the stable time step for
+*                  the normal velocity term
+*/
+
+static void computeCurvatureModelRHS(
+     LSMLIB_REAL    *phi,
+     LSM_DataArrays *data_arrays,
+     Grid           *grid,
+     Options        *options,
+     LSMLIB_REAL     cfl_number,
+     LSMLIB_REAL    *dt)
+{
+  LSMLIB_REAL   zero = 0.0;
+  LSMLIB_REAL   vel_n;
+
+  /* writing shortcuts */
+  Grid             *g = grid;
+  LSM_DataArrays   *d = data_arrays;
+  Options          *o = options;
+
+  SET_DATA_TO_CONSTANT(d->lse_rhs,g,zero)
+
+  if(o->a > 0)
+  {
+     /* Compute upwinding gradient approximations */
+     LSM3D_HJ_ENO2_NO_SCRATCH(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                phi,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+                &(g->klo_fb), &(g->khi_fb),
+                &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+     vel_n = o->a;
+
+     LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(d->lse_rhs,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &vel_n,
+                &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+                &(g->klo_fb), &(g->khi_fb));
+
+     /* figure out dt for hyperbolic term */
+     if( dt )
+     {
+       LSM3D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT(dt,&vel_n,
+                d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_x_minus, d->phi_y_minus,  d->phi_z_minus,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+                &(g->klo_fb), &(g->khi_fb),
+                &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
+                &cfl_number);
+     }
+  }
+
+  if( o->b > 0)
+  {
+    /* Compute derivatives needed for curvature term*/
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x, d->phi_y, d->phi_z,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                phi,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &(g->ilo_D1_fb), &(g->ihi_D1_fb),
+                &(g->jlo_D1_fb), &(g->jhi_D1_fb),
+                &(g->klo_D1_fb), &(g->khi_D1_fb),
+                &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xx, d->phi_xy, d->phi_xz,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_x,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &(g->ilo_D2_fb), &(g->ihi_D2_fb),
+                &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+                &(g->klo_D2_fb), &(g->khi_D2_fb),
+                &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xy, d->phi_yy, d->phi_yz,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_y,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &(g->ilo_D2_fb), &(g->ihi_D2_fb),
+                &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+                &(g->klo_D2_fb), &(g->khi_D2_fb),
+                &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xz, d->phi_yz, d->phi_zz,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_z,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &(g->ilo_D2_fb), &(g->ihi_D2_fb),
+                &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+                &(g->klo_D2_fb), &(g->khi_D2_fb),
+                &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+
+    LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS(d->lse_rhs,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_x,d->phi_y,d->phi_z,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                d->phi_xx,d->phi_xy,d->phi_xz,
+                d->phi_yy,d->phi_yz,d->phi_zz,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &(o->b),
+                &(g->ilo_fb), &(g->ihi_fb),
+                &(g->jlo_fb), &(g->jhi_fb),
+                &(g->klo_fb), &(g->khi_fb));
+  }
+}
+
+
+/*
+*  projectRHSOntoMask() sets the right-hand side to zero at grid points
+*  outside of the pore space (mask > 0) and at grid points where the 
+*  constraint phi >= mask (see IMPOSE_MASK()) is active and the 
+*  right-hand side would decrease phi.
+*
+*  Arguments:
+*   lse_rhs  - right-hand side of the level set equation
+*   phi      - level set function used to compute lse_rhs
+*   mask     - masking level set function
+*   grid     - LSMLIB Serial package Grid structure
+*/
+
+static void projectRHSOntoMask(
+     LSMLIB_REAL *lse_rhs,
+     LSMLIB_REAL *phi,
+     LSMLIB_REAL *mask,
+     Grid        *grid)
+{
+  int idx;
+
+  for(idx = 0; idx < grid->num_gridpts; idx++)
+  {
+    if( (mask[idx] > 0) || 
+        ((mask[idx] >= phi[idx]) && (lse_rhs[idx] < 0)) ) lse_rhs[idx] = 0;
+  }
+}
@@ -0,0 +1,17 @@
+/*
+ * File:        curvature_model3d_semi_implicit.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Support header file for 3D constant curvature flow with
+ *              semi-implicit time integration.
+ */
+#ifndef INCLUDED_CURV_MODEL3D_SEMI_IMPLICIT_H
+#define INCLUDED_CURV_MODEL3D_SEMI_IMPLICIT_H
+
+void  curvatureModelMedium3dSemiImplicitMainLoop(Options *,LSM_DataArrays  *,
+                                                 Grid  *,FILE *);
+
+#endif
@@ -0,0 +1,1158 @@
+/*
+ * File:        curvature_model3d_tiled.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Support file for localized 3D constant curvature flow with
+ *              tiled (sparse) narrow band storage.
+ */
+
+/* System headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* LSMLIB headers */
+#include "LSMLIB_config.h"
+#include "lsm_level_set_evolution3d_local.h"
+#include "lsm_spatial_derivatives3d_local.h"
+#include "lsm_utilities3d_local.h"
+#include "lsm_tvd_runge_kutta3d_local.h"
+#include "lsm_reinitialization3d_local.h"
+#include "lsm_geometry3d.h"
+#include "lsm_localization3d.h"
+
+/* LSMLIB Serial package headers */
+#include "lsm_boundary_conditions.h"
+#include "lsm_macros.h"
+#include "lsm_data_arrays.h"
+
+/* Local headers */
+#include "curvature_model_top.h"
+#include "curvature_model3d.h"
+#include "curvature_model3d_local.h"
+#include "curvature_model3d_tiled.h"
+
+#define DT_MIN_TO_CORRECT 1e-5
+#define DT_MIN            0.001
+
+/* limits for average gradient of phi within the narrow band: it
+   shouldn't be too far away from 1.0 */
+#define AVE_GRAD_PHI_MIN 0.9
+#define AVE_GRAD_PHI_MAX 1.1
+
+static unsigned char mark_fb=124;
+
+static int  determineTileNarrowBand(LSM_DataArrays *,int,Grid *,
+                                    LSMLIB_REAL *,LSMLIB_REAL *,int *);
+static int  getTileNarrowBandIndices(LSM_DataArrays *,int,int);
+static void setTileDataFarFromNarrowBand(LSM_DataArrays *,int,
+                                        unsigned char *,LSMLIB_REAL);
+static void imposeBoundaryConditionsTiled(LSM_DataArrays *,int);
+static void getTileMask(LSM_DataArrays *,int,LSMLIB_REAL **,LSMLIB_REAL *);
+static void imposeMaskTile(LSM_DataArrays *,int,int,int,int);
+
+/*
+*  Main loop for localized constant curvature level set method model in 3D
+*  with the narrow band data stored in tiles (data arrays allocated with
+*  tile_size > 0, see allocateMemoryForLSMDataArrays()).
+*
+*  The time stepping is the same as in curvatureModelMedium3dLocalMainLoop()
+*  but every stage is carried out tile by tile: the kernels read phi over
+*  the ghostbox of a tile (gathered into data_arrays->tile_arrays) and 
+*  read and write all other data directly in the tile.  The calculation 
+*  produces the same level set function as the localized main loop.
+*
+*  On entry, data_arrays->phi and data_arrays->mask hold the initial level
+*  set function and the mask; they are copied into tiles and freed.  On
+*  return, they hold the final level set function and the mask restored
+*  from the tiles.  The mask is only stored where |mask| < FAR_CELLS*dx
+*  (and is clamped to +/-FAR_CELLS*dx elsewhere), which assumes that the
+*  mask is a signed distance function so that the clamped values are 
+*  never imposed at narrow band points.
+*/
+
+void curvatureModelMedium3dTiledMainLoop(
+     Options          *options,
+     LSM_DataArrays   *data_arrays,
+     Grid             *grid,
+     FILE             *fp_out)
+{
+  LSMLIB_REAL   cfl_number = 0.5;
+
+  /* time variables */
+  LSMLIB_REAL   t, dt, dt_tile, dt_sub, max_H, dt_corr, dt_stage2;
+  LSMLIB_REAL   tplot, dt_min, dt_max;
+
+  LSMLIB_REAL   max_abs_err, max_abs_err_tile, eps, eps_stop;
+
+  LSMLIB_REAL   vel_n, b_curv, vol_phi, vol_max, vol_phi_prev, rel_vol_diff;
+  LSMLIB_REAL   vol_tile;
+  int      m, n, n_pts;
+
+  int      OUTER_STEP, INNER_STEP, TOTAL_STEP;
+  int      reinit_steps, last_reinit_step, ave_reinit_steps;
+
+  /* writing shortcuts */
+  Grid             *g = grid;
+  LSM_DataArrays   *d = data_arrays;
+  Options          *o = options;
+
+  /* variables specific for localization */
+  LSMLIB_REAL   beta, gamma, phi_far;
+  int      level;
+
+  LSMLIB_REAL   frac_nb, last_reinit_time, grad_phi_ave, grad_phi_ave_tile;
+  LSMLIB_REAL   grad_phi_sum;
+  int      nb_level0, nb_level1, nb_level2, nb_count;
+  int      reinit_trigger;
+
+  int      change_sgn;
+  int      change_sgn_steps, grad_phi_ave_steps;
+
+  /* outer layer sign flags: [plus/minus list][positive/non-positive] */
+  int      outer_sign[2][2];
+  LSMLIB_REAL   phi_old, phi_new;
+
+  /* variables specific for tiled storage */
+  LSM_TiledBand    *tb = d->tiled_band;
+  LSM_DataArrays   *td = d->tile_arrays;
+  Grid             tile_grid;
+  Grid             *tg = &tile_grid;
+  int      tile, int_lo[3], int_hi[3];
+  LSMLIB_REAL      *phi_tile, *phi_next_tile, *mask_tile;
+  LSMLIB_REAL      mask_val, mask_outside;
+  unsigned char    *nb_tile, *far_box;
+
+  if( !tb )
+  {
+     fprintf(stderr,"ERROR: tiled storage not allocated (tile_size %d)\n",
+             d->tile_size);
+     return;
+  }
+  if( o->do_mask && !(d->tiled_mask) )
+  {
+     fprintf(stderr,"ERROR: masking requires a mask\n");
+     return;
+  }
+
+  t = 0;
+  /* every TPLOT time period we evaluate max. abs. error as well as
+  *  reinitalize the function as needed.
+  */
+  max_abs_err = 1000.0;
+
+  /* stopping criterion - somewhat arbitrary,
+    modify EMAX_STOP in the accompanying .h file
+  */
+  eps_stop = EMAX_STOP *(g->dx)[0]; //stopping criterion
+  if( options->print_details)
+  {
+    fprintf(fp_out,"\nTPLOT %g eps_stop %g set internally\n",TPLOT,eps_stop);
+    fprintf(fp_out,"Simulation continues until given time tmax is reached\n");
+    fprintf(fp_out,"or max.abs.error for phi(:,t) - phi(:,t-TPLOT)");
+    fprintf(fp_out," is less than eps_stop.\n");
+    fprintf(fp_out,"-----------------------------------------------------\n");
+    fprintf(fp_out,"\nEach TPLOT time, we report on:");
+    fprintf(fp_out,"\nvol_phi - the volume occupied by the neg. level set phase");
+    fprintf(fp_out,"\nvol_frac - the fraction of pore space (vol_max)");
+    fprintf(fp_out," occupied by the neg. level set phase");
+    fprintf(fp_out,"\nrel_vol_diff - the relative volume difference btw two time steps");
+    fprintf(fp_out,"\nactive tiles - the number of tiles stored");
+    fprintf(fp_out," (tile size %d)",d->tile_size);
+    fprintf(fp_out,"\n");
+  }
+
+  /* correction for time spacing due to parabolic (curvature) term */
+  dt_corr = 1.0/((g->dx)[0]*(g->dx)[0]) + 1.0/((g->dx)[1]*(g->dx)[1]) +
+            1.0/((g->dx)[2]*(g->dx)[2]);
+  dt_corr *= 2.0*o->b;
+
+  /* coefficients of the normal velocity and curvature terms */
+  vel_n  = ( o->a > 0 ) ? o->a : 0.0;
+  b_curv = ( o->b > 0 ) ? o->b : 0.0;
+
+  /* this eps is suggested for Heaviside function in Fedkiw/Osher book */
+  eps = 1.5*(g->dx[0]);
+
+  /* compute volume of the pore space */
+  LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO(&vol_max,
+	        d->mask,
+		&(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		&(g->klo_gb), &(g->khi_gb),
+		&(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+		&(g->klo_fb), &(g->khi_fb),
+		&(g->dx[0]),&(g->dx[1]),&(g->dx[2]),
+		&eps);
+
+  /* compute volume of the fluid */
+  LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO(&vol_phi,
+	        d->phi,
+		&(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+		&(g->klo_gb), &(g->khi_gb),
+		&(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+		&(g->klo_fb), &(g->khi_fb),
+		&(g->dx[0]),&(g->dx[1]),&(g->dx[2]),
+		&eps);
+
+  tplot = (TPLOT < o->tmax ) ? TPLOT : o->tmax;
+  dt_min = 100.0; dt_max = 0;
+
+  /* localization: parameters for the 2nd order ENO or 3rd order WENO
+     defining the narrow band width */
+  beta = 2*(g->dx)[0]; gamma = 4*(g->dx)[0];
+  /* will need narrow band level 0,1,2,3 */
+  level = 3;
+
+  /* localization: magnitude of phi, phi_stage1 and phi_next at the grid
+     points more than FAR_CELLS grid cells away from the level 0 narrow
+     band (as in curvatureModelMedium3dLocalMainLoop()) */
+  phi_far = FAR_CELLS*(g->dx)[0];
+
+  /* tiled storage: a tile is active if a tile within FAR_CELLS grid 
+     cells of it contains level 0 narrow band points; inactive tiles 
+     hold +/-phi_far */
+  setTiledBandBackgroundValue(tb,LSM_TILED_PHI,phi_far);
+  setTiledBandBackgroundValue(tb,LSM_TILED_PHI_STAGE1,phi_far);
+  setTiledBandBackgroundValue(tb,LSM_TILED_PHI_NEXT,phi_far);
+  setTiledBandBackgroundValue(tb,LSM_TILED_PHI0,phi_far);
+  setTiledBandBackgroundValue(tb,LSM_TILED_PHI_PREV,phi_far);
+  setTiledBandActivateNeighbors(tb,(FAR_CELLS + d->tile_size - 1)/d->tile_size);
+  initializeTiledBandFromArray(tb,LSM_TILED_PHI,d->phi,gamma);
+  copyTiledBandField(tb,LSM_TILED_PHI_STAGE1,LSM_TILED_PHI);
+  copyTiledBandField(tb,LSM_TILED_PHI_NEXT,LSM_TILED_PHI);
+  free(d->phi);
+  d->phi = (LSMLIB_REAL *)NULL;
+
+  if( d->tiled_mask )
+  {
+     setTiledBandBackgroundValue(d->tiled_mask,0,phi_far);
+     initializeTiledBandFromArray(d->tiled_mask,0,d->mask,phi_far);
+     free(d->mask);
+     d->mask = (LSMLIB_REAL *)NULL;
+  }
+
+  /* localization: reinitialize within the narrow band so T0 can be set */
+  for(n = 0; n < tb->num_active_tiles; n++)
+  {
+     determineTileNarrowBand(d,(tb->active_tiles)[n],tg,
+                             &gamma,&beta,&level);
+  }
+  reinitializeMedium3dTiled(d,o,gamma + g->dx[0]);
+
+  /* scratch space for finding the grid points far from the level 0 
+     narrow band around a tile */
+  far_box = (unsigned char *)malloc( (d->tile_size + 2*FAR_CELLS)
+                                    *(d->tile_size + 2*FAR_CELLS)
+                                    *(d->tile_size + 2*FAR_CELLS)
+                                    *sizeof(unsigned char));
+
+  OUTER_STEP = 0; INNER_STEP = 0; TOTAL_STEP = 0;
+  last_reinit_step = 0; last_reinit_time = 0;
+  reinit_steps = change_sgn_steps = grad_phi_ave_steps = 0;
+  ave_reinit_steps = 0;
+
+  while( (t < o->tmax)  && (max_abs_err > eps_stop) && (vol_phi > eps_stop))
+  {  /* outer loop - the code is set up to output some error information
+     *  volume fractions etc. as the computation progresses
+     */
+    OUTER_STEP++;
+    dt_sub = 0;
+
+    vol_phi_prev = vol_phi;
+
+    while( dt_sub < tplot )
+    { /* inner loop */
+      INNER_STEP++;
+      TOTAL_STEP++;
+
+      /* tiled storage: activate tiles the interface moved into */
+      updateTiledBandActiveTiles(tb,LSM_TILED_PHI,gamma,0);
+
+      /* localization : determine T0 and compute the right-hand side
+         of the level set equation tile by tile; the time step is the
+         minimum over all tiles */
+      dt = LSMLIB_REAL_MAX;
+      for(n = 0; n < tb->num_active_tiles; n++)
+      {
+         tile = (tb->active_tiles)[n];
+	 determineTileNarrowBand(d,tile,tg,&gamma,&beta,&level);
+
+	 if( (tb->tile_level)[tile] != 1 ) continue;
+	 if( getTileNarrowBandIndices(d,tile,0) == 0 ) continue;
+	 getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+
+         LSM3D_COMPUTE_CONST_NORMAL_VEL_CONST_CURV_LSE_RHS_LOCAL(
+	            getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    td->phi,
+		    &(tg->ilo_gb), &(tg->ihi_gb), &(tg->jlo_gb), &(tg->jhi_gb),
+		    &(tg->klo_gb), &(tg->khi_gb),
+		    &vel_n, &b_curv,
+		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),&cfl_number,
+		    &dt_tile,
+		    td->index_x, td->index_y, td->index_z,
+		    &(td->n_lo)[0],&(td->n_hi)[0],
+		    getTiledBandTileNarrowBand(tb,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    &mark_fb);
+
+	 if( dt_tile < dt ) dt = dt_tile;
+      }
+
+      if( dt_sub == 0 )
+      { /* localization: at the start of a time interval, reset the 
+           values left far outside of the narrow band by earlier time
+	   steps (the right-hand side computed above only depends on 
+	   values near the narrow band) */
+         for(n = 0; n < tb->num_active_tiles; n++)
+	 {
+	    setTileDataFarFromNarrowBand(d,(tb->active_tiles)[n],far_box,
+	                                 phi_far);
+	 }
+
+         /* tiled storage: tiles are only released at the start of a time
+           interval (after the reset), so phi_prev is kept for every tile
+	   that is active during the time interval */
+         updateTiledBandActiveTiles(tb,LSM_TILED_PHI,gamma,1);
+         copyTiledBandField(tb,LSM_TILED_PHI_PREV,LSM_TILED_PHI);
+      }
+
+      if( o->a <= 0 ) dt = tplot;
+
+      if( o->b > 0)
+      {
+	/* correct dt due to parabolic (curvature) term */
+        if( o->a > 0 )
+	   max_H = cfl_number / dt;
+	else
+	   max_H = 0;
+
+	dt =  cfl_number / (max_H + dt_corr);
+      }
+
+      if( dt < DT_MIN_TO_CORRECT ) dt = DT_MIN;
+
+      if(dt_sub + dt > tplot)
+      {
+	  dt = tplot - dt_sub;
+      }
+
+      /* collect info on max. and min. time spacing */
+      if(dt > dt_max) dt_max = dt;
+      if(dt < dt_min) dt_min = dt;
+
+      /* first TVD RK2 stage (only data within the tile is used) */
+      for(n = 0; n < tb->num_active_tiles; n++)
+      {
+         tile = (tb->active_tiles)[n];
+	 if( (tb->tile_level)[tile] != 1 ) continue;
+	 if( getTileNarrowBandIndices(d,tile,0) == 0 ) continue;
+	 getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+
+         /* localization: modify equation by a cut-off function */
+         LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(
+	            getTiledBandTileData(tb,LSM_TILED_PHI,tile), 
+		    getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    td->index_x, td->index_y, td->index_z,
+		    &(td->n_lo)[0],&(td->n_hi)[0],
+		    getTiledBandTileNarrowBand(tb,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    &mark_fb,
+		    &beta,&gamma);
+
+         LSM3D_TVD_RK2_STAGE1_LOCAL(
+	           getTiledBandTileData(tb,LSM_TILED_PHI_STAGE1,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_PHI,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &dt,
+		   td->index_x, td->index_y, td->index_z,
+		   &(td->n_lo)[0],&(td->n_hi)[0],
+		   getTiledBandTileNarrowBand(tb,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &mark_fb);
+      }
+
+      /* boundary conditions */
+      imposeBoundaryConditionsTiled(d,LSM_TILED_PHI_STAGE1);
+
+      /* masking enforced so that the interface stays within pore space */
+      if(o->do_mask)
+      {
+         for(n = 0; n < tb->num_active_tiles; n++)
+	 {
+            tile = (tb->active_tiles)[n];
+	    if( (tb->tile_level)[tile] != 1 ) continue;
+	    imposeMaskTile(d,tile,LSM_TILED_PHI_STAGE1,LSM_TILED_PHI_STAGE1,0);
+	 }
+      }
+
+      /* second TVD RK2 stage */
+      for(n = 0; n < tb->num_active_tiles; n++)
+      {
+         tile = (tb->active_tiles)[n];
+	 if( (tb->tile_level)[tile] != 1 ) continue;
+	 if( getTileNarrowBandIndices(d,tile,0) == 0 ) continue;
+	 getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+	 getTiledBandTileGrid(tb,tile,tg);
+	 getTiledBandTileGhostboxData(tb,LSM_TILED_PHI_STAGE1,tile,
+	                              td->phi_stage1);
+
+         /* right-hand side at phi_stage1 (the time spacing is not needed) */
+         LSM3D_COMPUTE_CONST_NORMAL_VEL_CONST_CURV_LSE_RHS_LOCAL(
+	            getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    td->phi_stage1,
+		    &(tg->ilo_gb), &(tg->ihi_gb), &(tg->jlo_gb), &(tg->jhi_gb),
+		    &(tg->klo_gb), &(tg->khi_gb),
+		    &vel_n, &b_curv,
+		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),&cfl_number,
+		    &dt_stage2,
+		    td->index_x, td->index_y, td->index_z,
+		    &(td->n_lo)[0],&(td->n_hi)[0],
+		    getTiledBandTileNarrowBand(tb,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    &mark_fb);
+
+         /* localization: modify equation by a cut-off function */
+         LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(
+	            getTiledBandTileData(tb,LSM_TILED_PHI_STAGE1,tile),
+		    getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    td->index_x, td->index_y, td->index_z,
+		    &(td->n_lo)[0],&(td->n_hi)[0],
+		    getTiledBandTileNarrowBand(tb,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    &mark_fb,&beta,&gamma);
+
+         LSM3D_TVD_RK2_STAGE2_LOCAL(
+	           getTiledBandTileData(tb,LSM_TILED_PHI_NEXT,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_PHI_STAGE1,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_PHI,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &dt,
+		   td->index_x, td->index_y, td->index_z,
+		   &(td->n_lo)[0],&(td->n_hi)[0],
+		   getTiledBandTileNarrowBand(tb,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &mark_fb);
+      }
+
+      /* boundary conditions */
+      imposeBoundaryConditionsTiled(d,LSM_TILED_PHI_NEXT);
+
+      /* localization : check if the sign of the level set function
+                       changes in the outer layer of the narrow band
+		       where  gamma > |phi| >= beta; the outer layer is
+		       split according to the sign of phi before the
+		       update (as in LSM3D_CHECK_OUTER_NARROW_BAND_LAYER) */
+      outer_sign[0][0] = outer_sign[0][1] = 0;
+      outer_sign[1][0] = outer_sign[1][1] = 0;
+
+      for(n = 0; n < tb->num_active_tiles; n++)
+      {
+         tile = (tb->active_tiles)[n];
+	 phi_tile = getTiledBandTileData(tb,LSM_TILED_PHI,tile);
+	 phi_next_tile = getTiledBandTileData(tb,LSM_TILED_PHI_NEXT,tile);
+
+	 if( (tb->tile_level)[tile] == 1 )
+	 {
+	    nb_tile = getTiledBandTileNarrowBand(tb,tile);
+	    getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+	    n_pts = (int_hi[0] - int_lo[0] + 1)*(int_hi[1] - int_lo[1] + 1)
+	          * (int_hi[2] - int_lo[2] + 1);
+	    if( o->do_mask ) getTileMask(d,tile,&mask_tile,&mask_outside);
+	    for(m = 0; m < n_pts; m++)
+	    {
+	       if( nb_tile[m] != 1 ) continue;
+
+               /* masking enforced so that the interface stays within
+	          pore space */
+	       phi_new = phi_next_tile[m];
+	       if( o->do_mask )
+	       {
+	          mask_val = (mask_tile) ? mask_tile[m] : mask_outside;
+	          if( mask_val > phi_new ) phi_new = mask_val;
+	       }
+
+	       phi_old = phi_tile[m];
+	       if( fabs(phi_old) >= beta )
+	          outer_sign[phi_old <= 0][phi_new <= 0] = 1;
+
+	       if( o->do_mask ) phi_tile[m] = phi_new;
+	    }
+	 }
+
+	 if( !(o->do_mask) )
+	   memcpy(phi_tile,phi_next_tile,tb->tile_alloc_size*sizeof(LSMLIB_REAL));
+      }
+
+      change_sgn = ( outer_sign[0][0] && outer_sign[0][1] ) ||
+                   ( outer_sign[1][0] && outer_sign[1][1] );
+
+      if(change_sgn)
+      {  /* if the sign changed, the interface is close to the narrow
+            band border so reinitialization needs to be triggerred */
+         reinit_trigger = 1;
+	 change_sgn_steps++;
+      }
+      else
+      {
+         /* localization : compute the average value of the norm
+	 of the gradient over the level 0 points in the tile interiors */
+	 grad_phi_sum = 0; nb_count = 0;
+         for(n = 0; n < tb->num_active_tiles; n++)
+         {
+            tile = (tb->active_tiles)[n];
+	    if( (tb->tile_level)[tile] != 1 ) continue;
+	    n_pts = getTileNarrowBandIndices(d,tile,0);
+	    if( n_pts == 0 ) continue;
+	    getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+	    getTiledBandTileGrid(tb,tile,tg);
+	    getTiledBandTileGhostboxData(tb,LSM_TILED_PHI,tile,td->phi);
+
+            LSM3D_COMPUTE_AVE_GRAD_PHI_LOCAL(&grad_phi_ave_tile,
+	         td->phi,
+                 &(tg->ilo_gb), &(tg->ihi_gb), &(tg->jlo_gb), &(tg->jhi_gb),
+                 &(tg->klo_gb), &(tg->khi_gb),
+                 &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
+                 td->index_x, td->index_y, td->index_z,
+                 &(td->n_lo)[0],&(td->n_hi)[0],
+                 getTiledBandTileNarrowBand(tb,tile),
+		 &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		 &int_lo[2], &int_hi[2],
+	         &mark_fb);
+
+	    grad_phi_sum += grad_phi_ave_tile*n_pts;
+	    nb_count += n_pts;
+	 }
+	 grad_phi_ave = ( nb_count > 0 ) ? grad_phi_sum/nb_count : 0.0;
+
+	if(( grad_phi_ave < AVE_GRAD_PHI_MIN ) ||
+	   ( grad_phi_ave > AVE_GRAD_PHI_MAX ))
+	{
+	     /* if the norm "considerably" deviates from 1.0, trigger
+	        reinitialization */
+	    reinit_trigger = 1;
+	    grad_phi_ave_steps++;
+	}
+	else
+	{  /* reinitialize if haven't done so for long time */
+	   if( t + dt_sub - last_reinit_time >= TPLOT )
+	       reinit_trigger = 1;
+	   else
+	       reinit_trigger = 0;
+	}
+      }
+
+      /* localization: reinitalize if needed */
+      if(reinit_trigger)
+       {
+           /* gather some stats on how often we reinitialize */
+	   last_reinit_time = t;
+           ave_reinit_steps += TOTAL_STEP - last_reinit_step;
+           last_reinit_step = TOTAL_STEP;
+	   reinit_steps++;
+
+           reinitializeMedium3dTiled(d,o,gamma + 2*g->dx[0]);
+       }
+
+      dt_sub = dt_sub + dt;
+   } /* inner loop */
+
+   t = t + dt_sub;
+
+   /* compute max abs error only in the narrow band, volume and number
+      of narrow band points tile by tile; inactive tiles hold 
+      +/-phi_far, so they contribute to the volume if negative */
+   max_abs_err = 0;
+   vol_phi = 0;
+   nb_level0 = nb_level1 = nb_level2 = 0;
+   for(tile = 0; tile < tb->num_tiles_total; tile++)
+   {
+      getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+      n_pts = (int_hi[0] - int_lo[0] + 1)*(int_hi[1] - int_lo[1] + 1)
+            * (int_hi[2] - int_lo[2] + 1);
+      phi_tile = getTiledBandTileData(tb,LSM_TILED_PHI,tile);
+      if( !phi_tile )
+      {
+         if( (tb->tile_sign)[tile] < 0 )
+	    vol_phi += n_pts*(g->dx)[0]*(g->dx)[1]*(g->dx)[2];
+	 continue;
+      }
+
+      LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO(&vol_tile,
+	    phi_tile,
+            &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+            &int_lo[2], &int_hi[2],
+            &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+            &int_lo[2], &int_hi[2],
+            &(g->dx[0]),&(g->dx[1]),&(g->dx[2]),
+	    &eps);
+      vol_phi += vol_tile;
+
+      /* checking the number of points on the narrow band */
+      nb_tile = getTiledBandTileNarrowBand(tb,tile);
+      for(m = 0; m < n_pts; m++)
+      {
+         if( nb_tile[m] == 1 )      nb_level0++;
+	 else if( nb_tile[m] == 2 ) nb_level1++;
+	 else if( nb_tile[m] == 3 ) nb_level2++;
+      }
+
+      if( (tb->tile_level)[tile] != 1 ) continue;
+      if( getTileNarrowBandIndices(d,tile,0) == 0 ) continue;
+
+      LSM3D_MAX_NORM_DIFF_LOCAL(&max_abs_err_tile,phi_tile,
+            &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+            &int_lo[2], &int_hi[2],
+	    getTiledBandTileData(tb,LSM_TILED_PHI_PREV,tile),
+            &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+            &int_lo[2], &int_hi[2],
+	    td->index_x, td->index_y, td->index_z,
+            &(td->n_lo)[0],&(td->n_hi)[0],
+            nb_tile,
+            &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+            &int_lo[2], &int_hi[2],
+            &mark_fb);
+      if( max_abs_err_tile > max_abs_err ) max_abs_err = max_abs_err_tile;
+   }
+
+   printf("Time interval [%g,%g], max. abs. error %g\n", t-tplot,t,max_abs_err);
+   fprintf(fp_out,"Time interval [%g,%g], max. abs. error %g\n",t-tplot,t,
+                                                                  max_abs_err);
+   /* relative difference in volume */
+   rel_vol_diff = fabs(vol_phi_prev - vol_phi)/vol_phi_prev;
+   fprintf(fp_out," rel_vol_diff %g vol_phi %g vol_frac %g\n",
+                                 rel_vol_diff,vol_phi,vol_phi/vol_max);
+   fprintf(fp_out," dt_min %g dt_max %g\n",dt_min,dt_max);
+   fflush(stdout); fflush(fp_out);
+
+   frac_nb = (nb_level0 + nb_level1 + nb_level2)/(LSMLIB_REAL)g->num_gridpts;
+   fprintf(fp_out,"narrow band level0 %8d all levels %d total frac %g\n",
+             nb_level0,nb_level0+nb_level1+nb_level2,frac_nb);
+   fprintf(fp_out,"active tiles %d of %d (mask %d) stored grid points frac %g\n",
+             tb->num_active_tiles,tb->num_tiles_total,
+	     (d->tiled_mask) ? d->tiled_mask->num_active_tiles : 0,
+	     tb->num_active_tiles*(LSMLIB_REAL)(tb->tile_alloc_size)
+	                                        /g->num_gridpts);
+
+   fflush(stdout); fflush(fp_out);
+  } /* outer loop */
+
+  ave_reinit_steps =ceil( (LSMLIB_REAL)(ave_reinit_steps) / (LSMLIB_REAL)(reinit_steps) );
+  fprintf(fp_out,"\nTotal steps %d   Reinit. steps %d  (change sign %d, grad_phi_ave %d)",
+         TOTAL_STEP, reinit_steps,change_sgn_steps,grad_phi_ave_steps);
+  fprintf(fp_out,"\nReinitialized on average every %d steps.\n",ave_reinit_steps);
+
+  free(far_box);
+
+  /* return the final level set function and the mask on the full grid */
+  d->phi = (LSMLIB_REAL *)malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+  copyTiledBandToArray(tb,LSM_TILED_PHI,d->phi);
+  if( d->tiled_mask )
+  {
+     d->mask = (LSMLIB_REAL *)malloc(g->num_gridpts*sizeof(LSMLIB_REAL));
+     copyTiledBandToArray(d->tiled_mask,0,d->mask);
+  }
+}
+
+
+/*
+*  reinitializeMedium3dTiled() reinitializes the level set function using the
+*  second order accuracy ENO and TVD RK routines.
+*  The computation is performed locally (within the narrow band levels 0
+*  and 1) tile by tile, as in reinitializeMedium3dLocal().
+*
+*  Arguments:
+*   data_arrays  - LSMLIB Serial package data arrays structure with tiled 
+*                  storage; the narrow band levels of the tiles must be 
+*                  set (see determineTileNarrowBand())
+*   options      - (local) Options structure; the only element used is 'do_mask'
+*   tmax_r -     Maximal running time for reinitialization. Note that the normal
+*               velocity in the reinitialization level set equation is 1. This
+*	        time is hence equal to the distance from the interface within
+*	        which the level set function will be replaced by a signed
+*	        distance function.
+*
+*/
+
+void reinitializeMedium3dTiled(
+     LSM_DataArrays *data_arrays,
+     Options        *options,
+     LSMLIB_REAL         tmax_r)
+{
+    LSMLIB_REAL cfl_number = 0.5;
+    LSMLIB_REAL t_r, dt_r;
+
+    int    use_phi0_for_sign = 0;
+    int    n, tile, int_lo[3], int_hi[3];
+    int    stage, field_cur, field_next;
+
+     /* writing shortcuts */
+    LSM_DataArrays   *d = data_arrays;
+    LSM_TiledBand    *tb = data_arrays->tiled_band;
+    LSM_DataArrays   *td = data_arrays->tile_arrays;
+    Grid             *g = tb->grid;
+    Options          *o = options;
+    Grid             tile_grid;
+    Grid             *tg = &tile_grid;
+
+    t_r = 0;
+    dt_r = cfl_number * (g->dx)[0];
+
+    copyTiledBandField(tb,LSM_TILED_PHI0,LSM_TILED_PHI);
+
+    while(t_r < tmax_r )
+    {
+      /* the two TVD RK2 stages differ only in the data the right-hand 
+         side is computed from and in the field that is updated */
+      for(stage = 1; stage <= 2; stage++)
+      {
+        field_cur = (stage == 1) ? LSM_TILED_PHI : LSM_TILED_PHI_STAGE1;
+        field_next = (stage == 1) ? LSM_TILED_PHI_STAGE1 : LSM_TILED_PHI_NEXT;
+
+        for(n = 0; n < tb->num_active_tiles; n++)
+        {
+          tile = (tb->active_tiles)[n];
+	  if( ((tb->tile_level)[tile] == 0) || ((tb->tile_level)[tile] > 2) )
+	     continue;
+
+          /* N0 for reinitialization purposes is tube T0 plus its
+	     first neighbors; essentially level 0 and level 1 narrow band */
+	  if( getTileNarrowBandIndices(d,tile,1) == 0 ) continue;
+	  getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+	  getTiledBandTileGrid(tb,tile,tg);
+	  getTiledBandTileGhostboxData(tb,field_cur,tile,td->phi);
+
+          LSM3D_HJ_ENO2_LOCAL_NO_SCRATCH(
+	            td->phi_x_plus, td->phi_y_plus, td->phi_z_plus,
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+                    td->phi_x_minus, td->phi_y_minus, td->phi_z_minus,
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    td->phi,
+		    &(tg->ilo_gb), &(tg->ihi_gb), &(tg->jlo_gb), &(tg->jhi_gb),
+		    &(tg->klo_gb), &(tg->khi_gb),
+		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
+		    td->index_x, td->index_y, td->index_z,
+		    &(td->n_lo)[0],&(td->n_hi)[0],
+		    &(td->n_lo)[1],&(td->n_hi)[1],
+		    &(td->n_lo)[2],&(td->n_hi)[2],
+		    getTiledBandTileNarrowBand(tb,tile),
+		    &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		    &int_lo[2], &int_hi[2],
+		    &mark_fb);
+
+          LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(
+	         getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		 &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		 &int_lo[2], &int_hi[2],
+		 td->phi,
+		 &(tg->ilo_gb), &(tg->ihi_gb), &(tg->jlo_gb), &(tg->jhi_gb),
+		 &(tg->klo_gb), &(tg->khi_gb),
+		 getTiledBandTileData(tb,LSM_TILED_PHI0,tile),
+		 &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		 &int_lo[2], &int_hi[2],
+		 td->phi_x_plus, td->phi_y_plus, td->phi_z_plus,
+		 &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		 &int_lo[2], &int_hi[2],
+		 td->phi_x_minus, td->phi_y_minus, td->phi_z_minus,
+		 &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		 &int_lo[2], &int_hi[2],
+		 &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
+		 &use_phi0_for_sign,
+		 td->index_x, td->index_y, td->index_z,
+		 &(td->n_lo)[0],&(td->n_hi)[0],
+		 getTiledBandTileNarrowBand(tb,tile),
+		 &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		 &int_lo[2], &int_hi[2],
+		 &mark_fb);
+
+          if( stage == 1 )
+	  {
+            LSM3D_TVD_RK2_STAGE1_LOCAL(
+	           getTiledBandTileData(tb,LSM_TILED_PHI_STAGE1,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_PHI,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &dt_r,
+		   td->index_x, td->index_y, td->index_z,
+		   &(td->n_lo)[0],&(td->n_hi)[0],
+		   getTiledBandTileNarrowBand(tb,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &mark_fb);
+	  }
+	  else
+	  {
+            LSM3D_TVD_RK2_STAGE2_LOCAL(
+	           getTiledBandTileData(tb,LSM_TILED_PHI_NEXT,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_PHI_STAGE1,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_PHI,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   getTiledBandTileData(tb,LSM_TILED_LSE_RHS,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &dt_r,
+		   td->index_x, td->index_y, td->index_z,
+		   &(td->n_lo)[0],&(td->n_hi)[0],
+		   getTiledBandTileNarrowBand(tb,tile),
+		   &int_lo[0], &int_hi[0], &int_lo[1], &int_hi[1],
+		   &int_lo[2], &int_hi[2],
+		   &mark_fb);
+	  }
+        }
+
+        /* boundary conditions */
+        imposeBoundaryConditionsTiled(d,field_next);
+      }
+
+      for(n = 0; n < tb->num_active_tiles; n++)
+      {
+         tile = (tb->active_tiles)[n];
+
+         /* masking enforced so that the interface stays within pore space */
+	 if( !(o->do_mask) )
+	 {
+	    memcpy(getTiledBandTileData(tb,LSM_TILED_PHI,tile),
+	           getTiledBandTileData(tb,LSM_TILED_PHI_NEXT,tile),
+		   tb->tile_alloc_size*sizeof(LSMLIB_REAL));
+	 }
+	 else if( ((tb->tile_level)[tile] > 0) && ((tb->tile_level)[tile] <= 2) )
+	 {
+	    imposeMaskTile(d,tile,LSM_TILED_PHI,LSM_TILED_PHI_NEXT,1);
+	 }
+      }
+
+      t_r = t_r + dt_r;
+    }
+}
+
+
+/*
+*  determineTileNarrowBand() gathers phi over the ghostbox of a tile into
+*  the scratch arrays, determines the narrow band levels over the tile
+*  ghostbox (LSM3D_DETERMINE_NARROW_BAND) and stores them for the tile
+*  interior.  On return, tg describes the tile ghostbox.  Tiles that are
+*  not near a tile with level 0 narrow band points contain no narrow 
+*  band points, so their narrow band levels are cleared instead (tg and
+*  the scratch arrays are not set).
+*
+*  Returns the lowest narrow band level in the tile interior plus one
+*  (0 if the tile interior contains no narrow band points).
+*/
+static int determineTileNarrowBand(
+     LSM_DataArrays *d,
+     int            tile,
+     Grid           *tg,
+     LSMLIB_REAL    *gamma,
+     LSMLIB_REAL    *beta,
+     int            *level)
+{
+  LSM_TiledBand  *tb = d->tiled_band;
+  LSM_DataArrays *td = d->tile_arrays;
+  int nlo_index = 0, nhi_index = tb->tile_box_size - 1;
+  int nlo_index_outer = 0, nhi_index_outer = td->num_alloc_index_outer_pts-1;
+
+  if( !isTiledBandTileNearOccupiedTile(tb,tile,1) )
+  {
+     if( (tb->tile_level)[tile] != 0 ) clearTiledBandTileNarrowBand(tb,tile);
+     return 0;
+  }
+
+  getTiledBandTileGrid(tb,tile,tg);
+  getTiledBandTileGhostboxData(tb,LSM_TILED_PHI,tile,td->phi);
+
+  LSM3D_DETERMINE_NARROW_BAND(td->phi,
+       &(tg->ilo_gb), &(tg->ihi_gb), &(tg->jlo_gb), &(tg->jhi_gb),
+       &(tg->klo_gb), &(tg->khi_gb),
+       td->narrow_band,
+       &(tg->ilo_gb), &(tg->ihi_gb), &(tg->jlo_gb), &(tg->jhi_gb),
+       &(tg->klo_gb), &(tg->khi_gb),
+       td->index_x, td->index_y, td->index_z,
+       &nlo_index, &nhi_index,
+       td->n_lo,td->n_hi,
+       td->index_outer_pts,
+       &nlo_index_outer, &nhi_index_outer,
+       &(td->nlo_outer_plus),  &(td->nhi_outer_plus),
+       &(td->nlo_outer_minus), &(td->nhi_outer_minus),
+       gamma,beta,level);
+
+  return setTiledBandTileInteriorNarrowBand(tb,tile,td->narrow_band);
+}
+
+
+/*
+*  getTileNarrowBandIndices() stores the narrow band points of levels 0 
+*  through 'level' in the interior of a tile that lie in the fillbox of 
+*  the grid in the index arrays of the scratch arrays.  They are stored
+*  as narrow band level 0 (levels 1 and 2 are empty), so together with 
+*  the narrow band array of the tile they can be passed to the localized
+*  kernels; ghostcells of the grid are left out as in the localized main
+*  loop, where they are marked in the narrow band array.
+*
+*  Returns the number of points.
+*/
+static int getTileNarrowBandIndices(
+     LSM_DataArrays *d,
+     int            tile,
+     int            level)
+{
+  LSM_DataArrays *td = d->tile_arrays;
+  int n_pts;
+
+  n_pts = getTiledBandTileNarrowBandIndices(d->tiled_band,tile,level,1,
+                                   td->index_x,td->index_y,td->index_z);
+  (td->n_lo)[0] = 0;      (td->n_hi)[0] = n_pts - 1;
+  (td->n_lo)[1] = n_pts;  (td->n_hi)[1] = n_pts - 1;
+  (td->n_lo)[2] = n_pts;  (td->n_hi)[2] = n_pts - 1;
+
+  return n_pts;
+}
+
+
+/*
+*  setTileDataFarFromNarrowBand() sets phi, phi_stage1 and phi_next to 
+*  +/-value (following the sign of phi) at the grid points of a tile that
+*  are more than FAR_CELLS grid cells away from the level 0 narrow band
+*  points in the fillbox of the grid (see markFarGridPoints3d()).  The
+*  level 0 narrow band points are collected from the tiles around the 
+*  tile into far_box, which must hold (tile_size + 2*FAR_CELLS)^3 values.
+*/
+static void setTileDataFarFromNarrowBand(
+     LSM_DataArrays *d,
+     int            tile,
+     unsigned char  *far_box,
+     LSMLIB_REAL    value)
+{
+  LSM_TiledBand *tb = d->tiled_band;
+  Grid          *g = tb->grid;
+  LSMLIB_REAL   *phi = getTiledBandTileData(tb,LSM_TILED_PHI,tile);
+  LSMLIB_REAL   *phi_stage1 = getTiledBandTileData(tb,LSM_TILED_PHI_STAGE1,tile);
+  LSMLIB_REAL   *phi_next = getTiledBandTileData(tb,LSM_TILED_PHI_NEXT,tile);
+  unsigned char *nb;
+  LSMLIB_REAL   phi_far;
+  int  int_lo[3], int_hi[3], box_lo[3], box_hi[3], box_dims[3];
+  int  tr_lo[3], tr_hi[3], n_lo[3], n_hi[3], lo[3], hi[3];
+  int  fb_lo[3], fb_hi[3], gb_lo[3], gb_hi[3], tc[3];
+  int  i, j, k, m, n, idx, n_nx, n_nxy, dir, num_seeds = 0;
+  int  num_tile_seeds = 0, max_tile_dim = 0;
+
+  gb_lo[0] = g->ilo_gb;  gb_hi[0] = g->ihi_gb;
+  gb_lo[1] = g->jlo_gb;  gb_hi[1] = g->jhi_gb;
+  gb_lo[2] = g->klo_gb;  gb_hi[2] = g->khi_gb;
+  fb_lo[0] = g->ilo_fb;  fb_hi[0] = g->ihi_fb;
+  fb_lo[1] = g->jlo_fb;  fb_hi[1] = g->jhi_fb;
+  fb_lo[2] = g->klo_fb;  fb_hi[2] = g->khi_fb;
+
+  /* box of grid points within FAR_CELLS grid cells of the tile and the
+     range of tiles that overlap it */
+  getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+  for(dir = 0; dir < 3; dir++)
+  {
+     box_lo[dir] = int_lo[dir] - FAR_CELLS;
+     box_hi[dir] = int_hi[dir] + FAR_CELLS;
+     if( box_lo[dir] < gb_lo[dir] ) box_lo[dir] = gb_lo[dir];
+     if( box_hi[dir] > gb_hi[dir] ) box_hi[dir] = gb_hi[dir];
+     box_dims[dir] = box_hi[dir] - box_lo[dir] + 1;
+     if( int_hi[dir] - int_lo[dir] + 1 > max_tile_dim )
+        max_tile_dim = int_hi[dir] - int_lo[dir] + 1;
+     tr_lo[dir] = (box_lo[dir] - (tb->tile_origin)[dir])/(tb->tile_dims)[dir];
+     tr_hi[dir] = (box_hi[dir] - (tb->tile_origin)[dir])/(tb->tile_dims)[dir];
+  }
+  memset(far_box,1,box_dims[0]*box_dims[1]*box_dims[2]*sizeof(unsigned char));
+
+  /* level 0 narrow band points in the fillbox of the grid; only tiles
+     with tile_level 1 contain such points */
+  for(tc[2] = tr_lo[2]; tc[2] <= tr_hi[2]; tc[2]++)
+  for(tc[1] = tr_lo[1]; tc[1] <= tr_hi[1]; tc[1]++)
+  for(tc[0] = tr_lo[0]; tc[0] <= tr_hi[0]; tc[0]++)
+  {
+     n = tc[0] + (tb->num_tiles)[0]*(tc[1] + (tb->num_tiles)[1]*tc[2]);
+     if( (tb->tile_level)[n] != 1 ) continue;
+
+     if( n == tile ) num_tile_seeds = num_seeds;
+     nb = getTiledBandTileNarrowBand(tb,n);
+     getTiledBandTileInterior(tb,n,n_lo,n_hi);
+     n_nx = n_hi[0] - n_lo[0] + 1;
+     n_nxy = n_nx*(n_hi[1] - n_lo[1] + 1);
+     for(dir = 0; dir < 3; dir++)
+     {
+        lo[dir] = (n_lo[dir] > box_lo[dir]) ? n_lo[dir] : box_lo[dir];
+        if( lo[dir] < fb_lo[dir] ) lo[dir] = fb_lo[dir];
+        hi[dir] = (n_hi[dir] < box_hi[dir]) ? n_hi[dir] : box_hi[dir];
+        if( hi[dir] > fb_hi[dir] ) hi[dir] = fb_hi[dir];
+     }
+
+     for(k = lo[2]; k <= hi[2]; k++)
+     for(j = lo[1]; j <= hi[1]; j++)
+     {
+        m = (lo[0] - n_lo[0]) + (j - n_lo[1])*n_nx + (k - n_lo[2])*n_nxy;
+        idx = (lo[0] - box_lo[0]) + box_dims[0]*( (j - box_lo[1])
+                                    + box_dims[1]*(k - box_lo[2]) );
+        for(i = lo[0]; i <= hi[0]; i++, m++, idx++)
+        {
+           if( nb[m] != 1 ) continue;
+           far_box[idx] = 0;
+           num_seeds++;
+        }
+     }
+     if( n == tile ) num_tile_seeds = num_seeds - num_tile_seeds;
+  }
+
+  /* no grid point of a tile is far from a level 0 narrow band point in
+     the tile if the tile is at most FAR_CELLS+1 grid cells wide */
+  if( (num_tile_seeds > 0) && (max_tile_dim <= FAR_CELLS + 1) ) return;
+  if( num_seeds > 0 ) markFarGridPoints3d(far_box,box_dims,FAR_CELLS);
+
+  m = 0;
+  for(k = int_lo[2]; k <= int_hi[2]; k++)
+  for(j = int_lo[1]; j <= int_hi[1]; j++)
+  {
+     idx = (int_lo[0] - box_lo[0]) + box_dims[0]*( (j - box_lo[1])
+                                     + box_dims[1]*(k - box_lo[2]) );
+     for(i = int_lo[0]; i <= int_hi[0]; i++, m++, idx++)
+     {
+        if( !far_box[idx] ) continue;
+        phi_far = (phi[m] < 0) ? -value : value;
+        phi_stage1[m] = phi_next[m] = phi[m] = phi_far;
+     }
+  }
+}
+
+
+/*
+*  imposeBoundaryConditionsTiled() imposes the boundary conditions on a
+*  field for the tiles that contain ghostcells of the full grid.  The 
+*  ghostcells of the full grid within a tile are filled by linear 
+*  extrapolation from the same tile (see lsm_tiled_band.h), so the 
+*  boundary conditions are imposed directly on the tile data.
+*/
+static void imposeBoundaryConditionsTiled(
+     LSM_DataArrays *d,
+     int            field)
+{
+  int  bdry_location_idx = 9; /* extrapolate all boundaries */
+  LSM_TiledBand *tb = d->tiled_band;
+  Grid *g = tb->grid;
+  Grid bc_grid;
+  int  n, tile, int_lo[3], int_hi[3];
+
+  for(n = 0; n < tb->num_active_tiles; n++)
+  {
+     tile = (tb->active_tiles)[n];
+     getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+     if( (int_lo[0] >= g->ilo_fb) && (int_hi[0] <= g->ihi_fb) &&
+         (int_lo[1] >= g->jlo_fb) && (int_hi[1] <= g->jhi_fb) &&
+         (int_lo[2] >= g->klo_fb) && (int_hi[2] <= g->khi_fb) ) continue;
+
+     /* the ghostbox of bc_grid is the tile interior and its fillbox is
+        the part of the fillbox of the full grid within the tile, so 
+	only ghostcells of the full grid are filled */
+     bc_grid = *g;
+     bc_grid.ilo_gb = int_lo[0];  bc_grid.ihi_gb = int_hi[0];
+     bc_grid.jlo_gb = int_lo[1];  bc_grid.jhi_gb = int_hi[1];
+     bc_grid.klo_gb = int_lo[2];  bc_grid.khi_gb = int_hi[2];
+     bc_grid.ilo_fb = (g->ilo_fb > int_lo[0]) ? g->ilo_fb : int_lo[0];
+     bc_grid.ihi_fb = (g->ihi_fb < int_hi[0]) ? g->ihi_fb : int_hi[0];
+     bc_grid.jlo_fb = (g->jlo_fb > int_lo[1]) ? g->jlo_fb : int_lo[1];
+     bc_grid.jhi_fb = (g->jhi_fb < int_hi[1]) ? g->jhi_fb : int_hi[1];
+     bc_grid.klo_fb = (g->klo_fb > int_lo[2]) ? g->klo_fb : int_lo[2];
+     bc_grid.khi_fb = (g->khi_fb < int_hi[2]) ? g->khi_fb : int_hi[2];
+
+     signedLinearExtrapolationBC(getTiledBandTileData(tb,field,tile),
+                                 &bc_grid,bdry_location_idx);
+  }
+}
+
+
+/*
+*  getTileMask() returns the mask on a tile: a pointer to the data of
+*  tiled_mask if the tile is active in tiled_mask and NULL otherwise, in
+*  which case the mask is constant on the tile (mask_outside).
+*/
+static void getTileMask(
+     LSM_DataArrays *d,
+     int            tile,
+     LSMLIB_REAL    **mask_tile,
+     LSMLIB_REAL    *mask_outside)
+{
+  LSM_TiledBand *tm = d->tiled_mask;
+
+  *mask_tile = getTiledBandTileData(tm,0,tile);
+  *mask_outside = (tm->tile_sign)[tile]*(tm->background)[0];
+}
+
+
+/*
+*  imposeMaskTile() imposes the constraint 'phi <= mask' at the narrow
+*  band points of levels 0 through 'level' in the interior of a tile
+*  (see IMPOSE_MASK_LOCAL in lsm_macros.h).  The masked values of field
+*  field_src are stored in field field_dst.
+*/
+static void imposeMaskTile(
+     LSM_DataArrays *d,
+     int            tile,
+     int            field_dst,
+     int            field_src,
+     int            level)
+{
+  LSM_TiledBand *tb = d->tiled_band;
+  LSMLIB_REAL   *phi_masked = getTiledBandTileData(tb,field_dst,tile);
+  LSMLIB_REAL   *phi = getTiledBandTileData(tb,field_src,tile);
+  unsigned char *nb = getTiledBandTileNarrowBand(tb,tile);
+  LSMLIB_REAL   *mask, mask_outside, mask_val;
+  int int_lo[3], int_hi[3], n_pts, m;
+
+  getTileMask(d,tile,&mask,&mask_outside);
+  getTiledBandTileInterior(tb,tile,int_lo,int_hi);
+  n_pts = (int_hi[0] - int_lo[0] + 1)*(int_hi[1] - int_lo[1] + 1)
+        * (int_hi[2] - int_lo[2] + 1);
+  for(m = 0; m < n_pts; m++)
+  {
+     if( (nb[m] == 0) || (nb[m] > level+1) ) continue;
+     mask_val = (mask) ? mask[m] : mask_outside;
+     phi_masked[m] = (mask_val > phi[m]) ? mask_val : phi[m];
+  }
+}
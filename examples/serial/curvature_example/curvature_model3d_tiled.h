@@ -0,0 +1,17 @@
+/*
+ * File:        curvature_model3d_tiled.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Support header file for localized 3D constant curvature flow
+ *              with tiled (sparse) narrow band storage.
+ */
+#ifndef INCLUDED_CURV_MODEL3D_TILED_H
+#define INCLUDED_CURV_MODEL3D_TILED_H
+
+void  curvatureModelMedium3dTiledMainLoop(Options *,LSM_DataArrays  *,Grid  *,FILE *);
+void  reinitializeMedium3dTiled(LSM_DataArrays *,Options *,LSMLIB_REAL);
+
+#endif
@@ -11,6 +11,7 @@
 /* System headers */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 
@@ -21,11 +22,14 @@
 /*LSMLIB Serial headers */
 #include "lsm_macros.h"
 #include "lsm_grid.h"
+#include "lsm_container.h"
 
 /* Local headers */
 #include "curvature_model_top.h"
 #include "curvature_model3d.h"
 #include "curvature_model3d_local.h"
+#include "curvature_model3d_tiled.h"
+#include "curvature_model3d_semi_implicit.h"
 
 /* 
 *  Top routine for constant curvature flow: sets input options and 
@@ -42,10 +46,13 @@ int  curvatureModelTop(
   LSM_DataArrays *data_arrays; 
   /* grid structure */
   Grid *grid;   
+  /* restart file */
+  LSM_Container *restart;
+  LSMLIB_REAL   *restart_phi, *restart_mask;
    /* time parameters */
   time_t   time0, time1;
  
-  int     n1[3], n2[3], i;
+  int     n1[3], n2[3], i, return_status = 0;
   char    fname[256];
   FILE    *fp_out; 
   
@@ -56,8 +63,7 @@ int  curvatureModelTop(
   
   data_arrays = allocateLSMDataArrays();
     
-  if( (fname_data_in == NULL) || (fname_grid_in == NULL) || 
-      (fname_mask_in == NULL) )
+  if( fname_data_in == NULL )
   {
      /* Allocate/initialize mask and Grid structure.
         Mask is assumed to be a level set function that is negative in the
@@ -78,6 +84,42 @@ int  curvatureModelTop(
         IMPOSE_MASK(data_arrays->phi,data_arrays->mask,data_arrays->phi,grid)
      }					
   }
+  else if( (fname_grid_in == NULL) || (fname_mask_in == NULL) )
+  {
+     /* Restart from a container file written by a previous run.  The
+        fields are memory-mapped by the container, so they are copied 
+        into arrays owned by data_arrays that the main loops may free 
+        or replace. */
+     restart = openLSMContainer(fname_data_in);
+     if( restart == NULL )
+     {
+        printf("\nCould not open restart file %s",fname_data_in);
+        printf("\nTerminating...");
+        return 1;
+     }
+     grid = readGridFromLSMContainer(restart);
+     restart_phi = getLSMContainerField(restart,"phi",&(n1[0]));
+     restart_mask = getLSMContainerField(restart,"mask",&(n2[0]));
+     if( (restart_phi == NULL) || (restart_mask == NULL) ||
+         (n1[0] != grid->num_gridpts) || (n2[0] != grid->num_gridpts) )
+     {
+        printf("\nRestart file %s does not contain 'phi' and 'mask'",
+                                                            fname_data_in);
+        printf(" fields matching the grid\n");
+        printf("\nTerminating...");
+        closeLSMContainer(restart);
+        return 1;
+     }
+     data_arrays->phi = 
+       (LSMLIB_REAL *)malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+     data_arrays->mask = 
+       (LSMLIB_REAL *)malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+     memcpy(data_arrays->phi,restart_phi,
+            grid->num_gridpts*sizeof(LSMLIB_REAL));
+     memcpy(data_arrays->mask,restart_mask,
+            grid->num_gridpts*sizeof(LSMLIB_REAL));
+     closeLSMContainer(restart);
+  }
   else
   {
      /* Read input data arrays and grid */
@@ -135,8 +177,19 @@ int  curvatureModelTop(
   /* Run the curvature model, only 3d supported so far */
   if( grid->num_dims == 3 )
   {
-    if(options->narrow_band)
+    if(options->block_size > 0)
+    { /* block the j-k plane, keep full rows in i (unit stride) */
+      int block_dims[3] = {0, options->block_size, options->block_size};
+      setGridBlockDims(grid,block_dims);
+    }
+    
+    if(options->narrow_band && (options->tile_size > 0))
+      curvatureModelMedium3dTiledMainLoop(options,data_arrays,grid,fp_out);
+    else if(options->narrow_band)
       curvatureModelMedium3dLocalMainLoop(options,data_arrays,grid,fp_out);
+    else if(options->semi_implicit)
+      curvatureModelMedium3dSemiImplicitMainLoop(options,data_arrays,grid,
+                                                 fp_out);
     else
       curvatureModelMedium3dMainLoop(options,data_arrays,grid,fp_out);								
   }
@@ -146,6 +199,11 @@ int  curvatureModelTop(
   {
     sprintf(fname,"%s/data_final",options->path);
     writeDataArray(data_arrays->phi,grid,fname,GZIP);    
+    
+    /* grid, final level set function and mask in a single file that
+       can be used to restart the calculation */
+    sprintf(fname,"%s/restart.lsm",options->path);
+    if( writeRestartFile(fname,grid,data_arrays) ) return_status = 1;
   }  
  
   /* Clean up memory */
@@ -158,7 +216,49 @@ int  curvatureModelTop(
   fprintf(fp_out,"\nExecution time %g  seconds.\n", difftime(time1,time0));
   fflush(fp_out);
   
-  return 0;
+  return return_status;
+}
+
+
+/* 
+*  writeRestartFile() writes the grid, level set function and mask to a 
+*  container file (see lsm_container.h) that can be passed to 
+*  curvature_model as a restart file.
+*
+*  Returns 0 on success; 1 otherwise (an incomplete file is removed).
+*/
+
+int writeRestartFile(
+     char           *fname,
+     Grid           *grid,
+     LSM_DataArrays *data_arrays)
+{
+  LSM_Container *container;
+  int            error;
+  
+  if( (data_arrays->phi == NULL) || (data_arrays->mask == NULL) )
+  {
+    printf("\nRestart file %s not written: 'phi' or 'mask' missing",fname);
+    return 1;
+  }
+  
+  container = createLSMContainer(fname,grid);
+  if( container == NULL )
+  {
+    printf("\nCould not open file %s",fname);
+    return 1;
+  }
+  error = writeLSMContainerField(container,"phi",data_arrays->phi,
+                                 grid->num_gridpts,LSM_CONTAINER_REAL);
+  error |= writeLSMContainerField(container,"mask",data_arrays->mask,
+                                  grid->num_gridpts,LSM_CONTAINER_REAL);
+  error |= closeLSMContainer(container);
+  if( error ) 
+  {
+    printf("\nError writing file %s",fname);
+    remove(fname);
+  }
+  return error;
 }
 
 
@@ -180,7 +280,33 @@ void setArrayAllocationCurvatureModel(
        data_arrays->index_z = (int *)NULL;
        data_arrays->index_outer_pts = (int *)NULL;
     }
-        
+    else
+    { /* Localized model computes the curvature term directly from phi */
+       data_arrays->phi_x = data_arrays->phi_y = data_arrays->phi_z = (LSMLIB_REAL *)NULL;
+       data_arrays->phi_xx = data_arrays->phi_xy = data_arrays->phi_yy = (LSMLIB_REAL *)NULL;
+       data_arrays->phi_zz = data_arrays->phi_xz = data_arrays->phi_yz = (LSMLIB_REAL *)NULL;
+    }
+
+    if( options->narrow_band && (options->tile_size > 0) )
+    { /* Tiled model keeps the level set functions in tiles and the
+         remaining arrays in scratch arrays covering a single tile
+	 (see allocateMemoryForLSMDataArrays()) */
+       data_arrays->tile_size = options->tile_size;
+       data_arrays->phi_stage2 = data_arrays->phi_extra = (LSMLIB_REAL *)NULL;
+       data_arrays->normal_velocity = (LSMLIB_REAL *)NULL;
+       data_arrays->solid_narrow_band = (unsigned char *)NULL;
+       data_arrays->solid_index_x = data_arrays->solid_index_y = (int *)NULL;
+       data_arrays->solid_index_z = (int *)NULL;
+       data_arrays->solid_normal_x = data_arrays->solid_normal_y = (LSMLIB_REAL *)NULL;
+       data_arrays->solid_normal_z = (LSMLIB_REAL *)NULL;
+    }
+
+    if( !options->narrow_band )
+    { /* Time steps on the full grid use the low-storage TVD-RK2 form,
+         which updates phi in place */
+       data_arrays->phi_next = (LSMLIB_REAL *)NULL;
+    }
+
     if(options->b == 0)
     { /* Second order derivatives will (presumably) not be used */
        data_arrays->phi_xx = data_arrays->phi_xy = data_arrays->phi_yy = (LSMLIB_REAL *)NULL;
@@ -194,11 +320,6 @@ void setArrayAllocationCurvatureModel(
        data_arrays->phi_z_minus  = data_arrays->phi_z_plus = (LSMLIB_REAL *)NULL;
     }
 
-    if( options->accuracy_id != 2 )
-    { /* 3rd order differences used only for HJ ENO3 */
-       data_arrays->D3 = (LSMLIB_REAL *)NULL;
-    }
-
     if( options->accuracy_id <= MEDIUM )
     {
        data_arrays->phi_stage2 = (LSMLIB_REAL *)NULL;
@@ -14,11 +14,17 @@
 #define EMAX_STOP 0.05
 #define TPLOT     0.1
 
+/* localized calculations reset the level set function to +/-FAR_CELLS*dx
+   at the start of every TPLOT time period at the grid points more than
+   FAR_CELLS grid cells away from the level 0 narrow band */
+#define FAR_CELLS 16
+
 #include "lsm_options.h"
 #include "lsm_data_arrays.h"
 
 int    curvatureModelTop(Options *,char *,char *,char *);
 void   setArrayAllocationCurvatureModel(Options *, LSM_DataArrays *);
+int    writeRestartFile(char *, Grid *, LSM_DataArrays *);
 Grid  *createMaskThroatFromSpheres3d(LSMLIB_REAL**,Options *);
 
 #endif
@@ -68,6 +68,9 @@ Options *createOptionsDefault(void)
   options->do_mask = 1;
 
   options->narrow_band = 0;
+  options->tile_size = 0;
+  options->block_size = 0;
+  options->semi_implicit = 0;
   
   /* User additions */
   
@@ -103,6 +106,9 @@ Options *copyOptions(Options *options_src)
   options->do_mask = options_src->do_mask;	
 
   options->narrow_band = options_src->narrow_band;
+  options->tile_size = options_src->tile_size;
+  options->block_size = options_src->block_size;
+  options->semi_implicit = options_src->semi_implicit;
   
   /* User additions */
   
@@ -174,14 +180,40 @@ Options *createOptionsFromInputFile(char *filename)
       }
     }
     else if( c == 'b' )
-    {  /* 'b' */
-      sscanf(line+n,"%*s %lf ",&tmp);
-      options->b = tmp; 
+    { /* could be 'b' or 'block_size' */
+      if ( tolower(line[n+1]) == 'l' )
+      {
+        sscanf(line+n,"%*s %d ",&tmp1);
+        if( tmp1 >= 0 )
+          options->block_size = tmp1;
+        else
+        {
+          printf("\nIncorrect block_size option %d, set to default.\n",tmp1);
+        }
+      }
+      else
+      {
+        sscanf(line+n,"%*s %lf ",&tmp);
+        options->b = tmp;
+      }
     }
     else if( c == 't' )
-    { /* tmax */
-      sscanf(line+n,"%*s %lf ",&tmp);
-      options->tmax = tmp;
+    { /* could be 'tmax' or 'tile_size' */
+      if ( tolower(line[n+1]) == 'i' )
+      {
+        sscanf(line+n,"%*s %d ",&tmp1);
+        if( tmp1 >= 0 )
+          options->tile_size = tmp1;
+        else
+        {
+          printf("\nIncorrect tile_size option %d, set to default.\n",tmp1);
+        }
+      }
+      else
+      {
+        sscanf(line+n,"%*s %lf ",&tmp);
+        options->tmax = tmp;
+      }
     }
     else if( c == 'd' )
     { /* could be 'dx' or 'do_reinit' */
@@ -252,6 +284,16 @@ Options *createOptionsFromInputFile(char *filename)
         printf("\nIncorrect save_data option %d, set to default.\n",tmp1);
       }
     }
+    else if( c == 's' && (tolower(line[n+1]) == 'e') )
+    { /* 'semi_implicit' */
+      sscanf(line+n,"%*s %d ",&tmp1);
+      if ( (tmp1 == 0) || (tmp1 == 1))
+        options->semi_implicit = tmp1;
+      else
+      {
+        printf("\nIncorrect semi_implicit option %d, set to default.\n",tmp1);
+      }
+    }
 
 
     /* User additions */
@@ -303,6 +345,12 @@ void  printOptions(Options *options,FILE *fp)
                                                               options->do_mask);
   fprintf(fp,"  narrow_band   %4d [ apply narrow banding (1) or not (0)]\n",
                                                           options->narrow_band);							      							    
+  fprintf(fp,"  tile_size     %4d [ tile size for narrow band storage (0 - full arrays)]\n",
+                                                            options->tile_size);
+  fprintf(fp,"  block_size    %4d [ j-k cache block size (0 - no blocking)]\n",
+                                                           options->block_size);
+  fprintf(fp,"  semi_implicit %4d [ semi-implicit curvature term (1) or explicit (0)]\n",
+                                                        options->semi_implicit);
 
   /* User additions */
   fprintf(fp,"  print_details %4d [ print details (1) or not (0)   ]\n",
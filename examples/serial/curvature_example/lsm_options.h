@@ -67,6 +67,12 @@ typedef struct _Options
 			   LSM_DataArrays structure */
 			   
    int    narrow_band;      /* use narrow banding or no */			   
+   int    tile_size;        /* store narrow band data in tiles of
+                               tile_size^3 grid cells (0 - full arrays) */
+   int    block_size;       /* sweep the fill box in j-k cache blocks of
+                               block_size^2 columns (0 - no blocking) */
+   int    semi_implicit;    /* integrate the curvature term semi-implicitly
+                               (1) or explicitly (0) */
    
    /* User additions */
    
@@ -0,0 +1,238 @@
+/*
+ * File:        benchmarkEikonalEngines.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Benchmark program comparing the fast marching and fast
+ *              sweeping engines for the fast marching method functions
+ */
+
+
+/* System headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Header for Fast Marching Method Algorithm class */
+#include "LSMLIB_config.h"
+#include "lsm_fast_marching_method.h"
+
+/************************************************************************
+ *
+ * Benchmark program for the Eikonal equation engines.
+ *
+ * Usage:  benchmarkEikonalEngines [N]
+ *
+ * The distance function, extension field and Eikonal equation
+ * calculations are timed on an N x N x N grid (default N = 100) using
+ * both the fast marching method and the fast sweeping method.  The 
+ * maximum difference between the two solutions is reported.  Elapsed 
+ * (wall clock) times are reported.  When LSMLIB is configured with
+ * --enable-openmp, the fast sweeping method is timed using 1, 2, 4, ...
+ * threads up to the maximum number of threads (see OMP_NUM_THREADS).
+ * The fast marching method is always single-threaded.
+ *
+ ************************************************************************
+ */
+
+/* number of calculations benchmarked */
+#define NUM_BENCHMARKS  (3)
+
+/* runs the benchmark calculation with the specified engine */
+double runBenchmark(
+  int benchmark,
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *result,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *source_field,
+  LSMLIB_REAL *speed,
+  int spatial_derivative_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+
+int main( int argc, char *argv[])
+{
+  /* field variables */
+  LSMLIB_REAL *phi;
+  LSMLIB_REAL *source_field;
+  LSMLIB_REAL *speed;
+  LSMLIB_REAL *result_fmm;
+  LSMLIB_REAL *result_fsm;
+
+  /* grid parameters */
+  LSMLIB_REAL X_lo[3] = {-1.0,-1.0,-1.0};
+  LSMLIB_REAL X_hi[3] = {1.0,1.0,1.0};
+  LSMLIB_REAL dx[3];
+  int N;
+  int i,j,k;
+  int idx;
+  int num_gridpts;
+  int grid_dims[3];
+
+  /* numerical parameters */
+  int spatial_derivative_order = 1;
+
+  /* auxilliary variables */
+  LSMLIB_REAL x,y,z;
+  LSMLIB_REAL center[3], radius;
+  const char *benchmark_names[NUM_BENCHMARKS] =
+    {"distance function", "extension field", "Eikonal equation"};
+  int benchmark;
+  int max_threads;
+
+  /* set up grid */
+  N = 100;
+  if (argc > 1) N = atoi(argv[1]);
+  if (N < 2) {
+    fprintf(stderr, "ERROR: grid size must be at least 2\n");
+    return -1;
+  }
+  num_gridpts = 1;
+  for (i = 0; i < 3; i++) {
+    dx[i] = (X_hi[i]-X_lo[i])/N;
+    grid_dims[i] = N;
+    num_gridpts *= grid_dims[i];
+  }
+
+  /* allocate memory for field data */
+  phi = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  source_field = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  speed = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  result_fmm = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  result_fsm = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+
+  /* initialize data */
+  center[0] = 0.1; center[1] = -0.2; center[2] = 0.05;
+  radius = 0.4;
+  for (k = 0; k < grid_dims[2]; k++) {
+    for (j = 0; j < grid_dims[1]; j++) {
+      for (i = 0; i < grid_dims[0]; i++) {
+        idx = i + j*grid_dims[0] + k*grid_dims[0]*grid_dims[1];
+        x = X_lo[0] + dx[0]*(0.5 + i);
+        y = X_lo[1] + dx[1]*(0.5 + j);
+        z = X_lo[2] + dx[2]*(0.5 + k);
+
+        phi[idx] = sqrt( (x-center[0])*(x-center[0])
+                       + (y-center[1])*(y-center[1])
+                       + (z-center[2])*(z-center[2]) ) - radius;
+        source_field[idx] = x + y*z;
+        speed[idx] = 1.0 + 0.1*sin(M_PI*x)*cos(M_PI*y);
+      }
+    }
+  }
+
+  /* determine the thread counts to benchmark */
+#ifdef _OPENMP
+  max_threads = omp_get_max_threads();
+#else
+  max_threads = 1;
+#endif
+
+  /* run benchmarks */
+  printf("Eikonal engine benchmark (%d x %d x %d grid, up to %d threads)\n",
+         grid_dims[0], grid_dims[1], grid_dims[2], max_threads);
+  printf("%-20s %8s %8s %12s %10s %12s\n",
+         "calculation", "engine", "threads", "time (s)", "FMM/FSM",
+         "max diff");
+  for (benchmark = 0; benchmark < NUM_BENCHMARKS; benchmark++) {
+    double time_fmm, time_fsm;
+    int num_threads;
+
+    time_fmm = runBenchmark(benchmark, LSM_EIKONAL_ENGINE_FAST_MARCHING,
+                            result_fmm, phi, source_field, speed,
+                            spatial_derivative_order, grid_dims, dx);
+    printf("%-20s %8s %8d %12.3f\n", benchmark_names[benchmark],
+           "FMM", 1, time_fmm);
+
+    for (num_threads = 1; ; num_threads *= 2) {
+      LSMLIB_REAL max_diff = 0.0;
+
+      if (num_threads > max_threads) num_threads = max_threads;
+#ifdef _OPENMP
+      omp_set_num_threads(num_threads);
+#endif
+      time_fsm = runBenchmark(benchmark, LSM_EIKONAL_ENGINE_FAST_SWEEPING,
+                              result_fsm, phi, source_field, speed,
+                              spatial_derivative_order, grid_dims, dx);
+
+      for (idx = 0; idx < num_gridpts; idx++) {
+        LSMLIB_REAL diff = fabs(result_fmm[idx] - result_fsm[idx]);
+        if (diff > max_diff) max_diff = diff;
+      }
+
+      printf("%-20s %8s %8d %12.3f %10.2f %12.3e\n", 
+             benchmark_names[benchmark], "FSM", num_threads, time_fsm, 
+             time_fmm/time_fsm, max_diff);
+
+      if (num_threads == max_threads) break;
+    }
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+
+  /* clean up memory */
+  free(phi);
+  free(source_field);
+  free(speed);
+  free(result_fmm);
+  free(result_fsm);
+
+  return 0;
+}
+
+
+double runBenchmark(
+  int benchmark,
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *result,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *source_field,
+  LSMLIB_REAL *speed,
+  int spatial_derivative_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  struct timeval start, end;
+
+  gettimeofday(&start, 0);
+  if (benchmark == 0) {
+
+    computeDistanceFunctionWithEngine3d(
+      engine, result, phi, 0, spatial_derivative_order, grid_dims, dx);
+
+  } else if (benchmark == 1) {
+
+    /* the extension field is compared instead of the distance function */
+    int num_gridpts = grid_dims[0]*grid_dims[1]*grid_dims[2];
+    LSMLIB_REAL *distance_function =
+      (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+    computeExtensionFieldsWithEngine3d(
+      engine, distance_function, &result, phi, 0, &source_field, 0, 1,
+      spatial_derivative_order, LSMLIB_REAL_MAX, grid_dims, dx);
+    free(distance_function);
+
+  } else {
+
+    /* zero level set of phi is used as the initial front */
+    int num_gridpts = grid_dims[0]*grid_dims[1]*grid_dims[2];
+    int idx;
+    for (idx = 0; idx < num_gridpts; idx++) {
+      result[idx] = (fabs(phi[idx]) < dx[0]) ? 0.0 : -1.0;
+    }
+    solveEikonalEquationWithEngine3d(
+      engine, result, speed, 0, spatial_derivative_order, grid_dims, dx);
+
+  }
+  gettimeofday(&end, 0);
+
+  return (end.tv_sec - start.tv_sec) + 1.0e-6*(end.tv_usec - start.tv_usec);
+}
@@ -0,0 +1,249 @@
+/*
+ * File:        benchmarkFMMQueues.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Benchmark program comparing the binary heap and bucketed
+ *              priority queues for the fast marching method functions
+ */
+
+
+/* System headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/* Header for Fast Marching Method Algorithm class */
+#include "LSMLIB_config.h"
+#include "lsm_fast_marching_method.h"
+
+/************************************************************************
+ *
+ * Benchmark program for the Fast Marching Method trial point queues.
+ *
+ * Usage:  benchmarkFMMQueues [N_3d [N_2d]]
+ *
+ * The distance function, extension field and Eikonal equation
+ * calculations are timed on an N_3d x N_3d x N_3d grid (default 
+ * N_3d = 100) and on an N_2d x N_2d grid (default N_2d = 1000) using
+ * both the binary heap and the bucketed queue.  The maximum difference
+ * between the two solutions is reported.
+ *
+ ************************************************************************
+ */
+
+/* number of FMM calculations benchmarked */
+#define NUM_BENCHMARKS  (3)
+
+/* runs all benchmark calculations on an N^num_dims grid */
+void runBenchmarks(int num_dims, int N);
+
+/* runs the benchmark calculation with the specified queue type */
+double runBenchmark(
+  int num_dims,
+  int benchmark,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL *result,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *source_field,
+  LSMLIB_REAL *speed,
+  int spatial_derivative_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+
+int main( int argc, char *argv[])
+{
+  int N_3d = 100;
+  int N_2d = 1000;
+
+  if (argc > 1) N_3d = atoi(argv[1]);
+  if (argc > 2) N_2d = atoi(argv[2]);
+  if ( (N_3d < 2) || (N_2d < 2) ) {
+    fprintf(stderr, "ERROR: grid size must be at least 2\n");
+    return -1;
+  }
+
+  runBenchmarks(3, N_3d);
+  printf("\n");
+  runBenchmarks(2, N_2d);
+
+  return 0;
+}
+
+
+void runBenchmarks(int num_dims, int N)
+{
+  /* field variables */
+  LSMLIB_REAL *phi;
+  LSMLIB_REAL *source_field;
+  LSMLIB_REAL *speed;
+  LSMLIB_REAL *result_heap;
+  LSMLIB_REAL *result_bucketed;
+
+  /* grid parameters */
+  LSMLIB_REAL X_lo[3] = {-1.0,-1.0,-1.0};
+  LSMLIB_REAL X_hi[3] = {1.0,1.0,1.0};
+  LSMLIB_REAL dx[3];
+  int i,j,k;
+  int idx;
+  int num_gridpts;
+  int grid_dims[3];
+
+  /* numerical parameters */
+  int spatial_derivative_order = 1;
+
+  /* auxilliary variables */
+  LSMLIB_REAL x,y,z;
+  LSMLIB_REAL center[3], radius;
+  const char *benchmark_names[NUM_BENCHMARKS] =
+    {"distance function", "extension field", "Eikonal equation"};
+  int benchmark;
+
+  /* set up grid (the third dimension is collapsed in 2d) */
+  num_gridpts = 1;
+  for (i = 0; i < 3; i++) {
+    dx[i] = (X_hi[i]-X_lo[i])/N;
+    grid_dims[i] = (i < num_dims) ? N : 1;
+    num_gridpts *= grid_dims[i];
+  }
+
+  /* allocate memory for field data */
+  phi = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  source_field = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  speed = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  result_heap = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  result_bucketed = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+
+  /* initialize data */
+  center[0] = 0.1; center[1] = -0.2; center[2] = 0.05;
+  radius = 0.4;
+  for (k = 0; k < grid_dims[2]; k++) {
+    for (j = 0; j < grid_dims[1]; j++) {
+      for (i = 0; i < grid_dims[0]; i++) {
+        idx = i + j*grid_dims[0] + k*grid_dims[0]*grid_dims[1];
+        x = X_lo[0] + dx[0]*(0.5 + i);
+        y = X_lo[1] + dx[1]*(0.5 + j);
+        z = (num_dims == 3) ? X_lo[2] + dx[2]*(0.5 + k) : center[2];
+
+        phi[idx] = sqrt( (x-center[0])*(x-center[0])
+                       + (y-center[1])*(y-center[1])
+                       + (z-center[2])*(z-center[2]) ) - radius;
+        source_field[idx] = x + y*z;
+        speed[idx] = 1.0 + 0.5*sin(M_PI*x)*cos(M_PI*y);
+      }
+    }
+  }
+
+  /* run benchmarks */
+  if (num_dims == 3) {
+    printf("Fast marching method queue benchmark (%d x %d x %d grid)\n",
+           grid_dims[0], grid_dims[1], grid_dims[2]);
+  } else {
+    printf("Fast marching method queue benchmark (%d x %d grid)\n",
+           grid_dims[0], grid_dims[1]);
+  }
+  printf("%-20s %12s %12s %16s\n",
+         "calculation", "heap (s)", "bucketed (s)", "max diff");
+  for (benchmark = 0; benchmark < NUM_BENCHMARKS; benchmark++) {
+    double time_heap, time_bucketed;
+    LSMLIB_REAL max_diff = 0.0;
+
+    time_heap = runBenchmark(num_dims, benchmark, FMM_CORE_BINARY_HEAP,
+                             result_heap, phi, source_field, speed,
+                             spatial_derivative_order, grid_dims, dx);
+    time_bucketed = runBenchmark(num_dims, benchmark, 
+                                 FMM_CORE_BUCKETED_QUEUE,
+                                 result_bucketed, phi, source_field, speed,
+                                 spatial_derivative_order, grid_dims, dx);
+
+    for (idx = 0; idx < num_gridpts; idx++) {
+      LSMLIB_REAL diff = fabs(result_heap[idx] - result_bucketed[idx]);
+      if (diff > max_diff) max_diff = diff;
+    }
+
+    printf("%-20s %12.3f %12.3f %16.3e\n", benchmark_names[benchmark],
+           time_heap, time_bucketed, max_diff);
+  }
+
+  /* clean up memory */
+  free(phi);
+  free(source_field);
+  free(speed);
+  free(result_heap);
+  free(result_bucketed);
+}
+
+
+double runBenchmark(
+  int num_dims,
+  int benchmark,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL *result,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *source_field,
+  LSMLIB_REAL *speed,
+  int spatial_derivative_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  FMM_CoreQueueType default_queue_type = FMM_Core_getDefaultQueueType();
+  clock_t start;
+  double elapsed_time;
+
+  FMM_Core_setDefaultQueueType(queue_type);
+
+  start = clock();
+  if ( (benchmark == 0) && (num_dims == 3) ) {
+
+    computeDistanceFunction3d(
+      result, phi, 0, spatial_derivative_order, grid_dims, dx);
+
+  } else if (benchmark == 0) {
+
+    computeDistanceFunction2d(
+      result, phi, 0, spatial_derivative_order, grid_dims, dx);
+
+  } else if (benchmark == 1) {
+
+    /* the extension field is compared instead of the distance function */
+    int num_gridpts = grid_dims[0]*grid_dims[1]*grid_dims[2];
+    LSMLIB_REAL *distance_function =
+      (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+    if (num_dims == 3) {
+      computeExtensionFields3d(
+        distance_function, &result, phi, 0, &source_field, 0, 1,
+        spatial_derivative_order, grid_dims, dx);
+    } else {
+      computeExtensionFields2d(
+        distance_function, &result, phi, 0, &source_field, 0, 1,
+        spatial_derivative_order, grid_dims, dx);
+    }
+    free(distance_function);
+
+  } else {
+
+    /* zero level set of phi is used as the initial front */
+    int num_gridpts = grid_dims[0]*grid_dims[1]*grid_dims[2];
+    int idx;
+    for (idx = 0; idx < num_gridpts; idx++) {
+      result[idx] = (fabs(phi[idx]) < dx[0]) ? 0.0 : -1.0;
+    }
+    if (num_dims == 3) {
+      solveEikonalEquation3d(
+        result, speed, 0, spatial_derivative_order, grid_dims, dx);
+    } else {
+      solveEikonalEquation2d(
+        result, speed, 0, spatial_derivative_order, grid_dims, dx);
+    }
+
+  }
+  elapsed_time = ((double) (clock() - start))/CLOCKS_PER_SEC;
+
+  FMM_Core_setDefaultQueueType(default_queue_type);
+
+  return elapsed_time;
+}
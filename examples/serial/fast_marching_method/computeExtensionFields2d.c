@@ -125,6 +125,7 @@ int main( int argc, char *argv[])
     phi,
     mask,
     source_fields,
+    0, /* NULL extension_mask */
     num_ext_fields,
     spatial_derivative_order,
     grid_dims,
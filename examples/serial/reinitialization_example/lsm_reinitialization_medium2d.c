@@ -51,16 +51,12 @@ void lsm2dReinitializationMedium(
 
   while(t_r < tmax_r )
   { 
-    LSM2D_HJ_ENO2(l->phi_x_plus, l->phi_y_plus,
+    LSM2D_HJ_ENO2_NO_SCRATCH(l->phi_x_plus, l->phi_y_plus,
              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
              l->phi_x_minus, l->phi_y_minus,
 	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 	     l->phi,
 	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-	     l->D1,
-	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-	     l->D2,
-	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 	     &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
 	     &((g->dx)[0]),
 	     &((g->dx)[1]));
@@ -91,16 +87,12 @@ void lsm2dReinitializationMedium(
     /* boundary conditions */	  
     signedLinearExtrapolationBC(l->phi_stage1, g, ALL_BOUNDARIES);
 
-    LSM2D_HJ_ENO2(l->phi_x_plus, l->phi_y_plus,
+    LSM2D_HJ_ENO2_NO_SCRATCH(l->phi_x_plus, l->phi_y_plus,
              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
              l->phi_x_minus, l->phi_y_minus,
 	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 	     l->phi_stage1,
 	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-	     l->D1,
-	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-	     l->D2,
-	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 	     &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
 	     &((g->dx)[0]),
 	     &((g->dx)[1]));	 
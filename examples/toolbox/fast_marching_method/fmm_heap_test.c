@@ -20,7 +20,8 @@
  * Helper function declarations
  ************************************************************************/
 #define TEST_DIM (2)
-void printGridIndex(int grid_idx[FMM_HEAP_MAX_NDIM]);
+#define TEST_GRID_SIZE (8)
+void printGridIndex(int idx);
 
 
 /************************************************************************
@@ -32,12 +33,13 @@ void printGridIndex(int grid_idx[FMM_HEAP_MAX_NDIM]);
 int main( int argc, char *argv[])
 {
   int i,j;
-  int grid_idx[FMM_HEAP_MAX_NDIM];
+  int grid_idx[TEST_DIM];
+  int idx;
 
   /* 
    * Heap Test code
    */
-  FMM_Heap *fmm_heap = FMM_Heap_createHeap(0,0,0);
+  FMM_Heap *fmm_heap = FMM_Heap_createHeap(0,0);
   FMM_Heap_printHeapData(fmm_heap);
 
   int N = 4;  // number of cells in each grid direction
@@ -52,10 +54,11 @@ int main( int argc, char *argv[])
 
       grid_idx[0] = i;
       grid_idx[1] = j;
+      idx = grid_idx[0] + grid_idx[1]*TEST_GRID_SIZE;
       value = 1.0*rand()/RAND_MAX;
-      node_handle = FMM_Heap_insertNode(fmm_heap,grid_idx,value);
+      node_handle = FMM_Heap_insertNode(fmm_heap,idx,value);
       printf("Node handle = %d, ", node_handle);
-      printf("Grid Index = "); printGridIndex(grid_idx); printf(", ");
+      printf("Grid Index = "); printGridIndex(idx); printf(", ");
       printf("Value = %g, \n", value); 
       printf("   Heap Size = %d, ", FMM_Heap_getHeapSize(fmm_heap));
       printf("Heap Mem Size = %d\n", FMM_Heap_getHeapMemSize(fmm_heap));
@@ -71,11 +74,11 @@ int main( int argc, char *argv[])
     FMM_HeapNode root = FMM_Heap_extractMin(fmm_heap,&moved_node,&moved_handle);
     printf("---------------------\n");
     printf("Root: \n");
-    printf("Grid Index = "); printGridIndex(root.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(root.idx); printf(", ");
     printf("Value = %g, ", root.value); 
     printf("Heap Position = %d\n", root.heap_pos);
     printf("Moved Node: \n");
-    printf("Grid Index = "); printGridIndex(moved_node.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(moved_node.idx); printf(", ");
     printf("Value = %g, ", moved_node.value);
     printf("Heap Position = %d\n", moved_node.heap_pos); 
     printf("   Node Handle = %d\n", moved_handle); 
@@ -97,13 +100,15 @@ int main( int argc, char *argv[])
   for (i = 0; i<N; i++) {
     for (j = 0; j<N; j++) {
       LSMLIB_REAL value = 1.0*rand()/RAND_MAX;
-      int node_handle = FMM_Heap_insertNode(fmm_heap,grid_idx,value);
+      int node_handle;
 
       grid_idx[0] = i+N;
       grid_idx[1] = j+N;
+      idx = grid_idx[0] + grid_idx[1]*TEST_GRID_SIZE;
+      node_handle = FMM_Heap_insertNode(fmm_heap,idx,value);
 
       printf("Node handle = %d, ", node_handle);
-      printf("Grid Index = "); printGridIndex(grid_idx); printf(", ");
+      printf("Grid Index = "); printGridIndex(idx); printf(", ");
       printf("Value = %g\n", value); 
       printf("   Heap Size = %d, ", FMM_Heap_getHeapSize(fmm_heap));
       printf("Heap Mem Size = %d\n", FMM_Heap_getHeapMemSize(fmm_heap));
@@ -118,7 +123,7 @@ int main( int argc, char *argv[])
     FMM_HeapNode root = FMM_Heap_extractMin(fmm_heap,NULL,&moved_handle);
     printf("---------------------\n");
     printf("Root: \n");
-    printf("Grid Index = "); printGridIndex(root.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(root.idx); printf(", ");
     printf("Value = %g, ", root.value); 
     printf("Heap Position = %d\n", root.heap_pos); 
     printf("Moved Node: \n");
@@ -143,11 +148,11 @@ int main( int argc, char *argv[])
     FMM_HeapNode root = FMM_Heap_extractMin(fmm_heap,&moved_node,NULL);
     printf("---------------------\n");
     printf("Root: \n");
-    printf("Grid Index = "); printGridIndex(root.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(root.idx); printf(", ");
     printf("Value = %g, ", root.value); 
     printf("Heap Position = %d\n", root.heap_pos); 
     printf("Moved Node: \n");
-    printf("Grid Index = "); printGridIndex(moved_node.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(moved_node.idx); printf(", ");
     printf("Value = %g, ", moved_node.value); 
     printf("Heap Position = %d\n", moved_node.heap_pos); 
     printf("Heap Size = %d, ", FMM_Heap_getHeapSize(fmm_heap));
@@ -170,7 +175,7 @@ int main( int argc, char *argv[])
     FMM_HeapNode root = FMM_Heap_extractMin(fmm_heap,NULL,NULL);
     printf("---------------------\n");
     printf("Root: \n");
-    printf("Grid Index = "); printGridIndex(root.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(root.idx); printf(", ");
     printf("Value = %g, ", root.value);
     printf("Heap Position = %d\n", root.heap_pos);
     printf("Heap Size = %d, ", FMM_Heap_getHeapSize(fmm_heap));
@@ -192,14 +197,14 @@ int main( int argc, char *argv[])
     FMM_HeapNode node = FMM_Heap_getNode(fmm_heap,i);
     printf("Before:  \n");
     printf("   Node handle = %d, ", i);
-    printf("Grid Index = "); printGridIndex(node.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(node.idx); printf(", ");
     printf("Value = %g, ", node.value);
     printf("Heap Position = %d\n", node.heap_pos); 
     FMM_Heap_updateNode(fmm_heap,i,value);
     node = FMM_Heap_getNode(fmm_heap,i);
     printf("After:  \n");
     printf("   Node handle = %d, ", i); 
-    printf("Grid Index = "); printGridIndex(node.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(node.idx); printf(", ");
     printf("Value = %g, ", node.value); 
     printf("Heap Position = %d\n", node.heap_pos); 
     printf("   Heap Size = %d, ", FMM_Heap_getHeapSize(fmm_heap));
@@ -213,14 +218,14 @@ int main( int argc, char *argv[])
     FMM_HeapNode node = FMM_Heap_getNode(fmm_heap,i);
     printf("Before:  \n");
     printf("   Node handle = %d, ", i);
-    printf("Grid Index = "); printGridIndex(node.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(node.idx); printf(", ");
     printf("Value = %g, ", node.value);
     printf("Heap Position = %d\n", node.heap_pos);
     FMM_Heap_updateNode(fmm_heap,i,value);
     node = FMM_Heap_getNode(fmm_heap,i);
     printf("After:  \n");
     printf("   Node handle = %d, ", i); 
-    printf("Grid Index = "); printGridIndex(node.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(node.idx); printf(", ");
     printf("Value = %g, ", node.value); 
     printf("Heap Position = %d\n", node.heap_pos); 
     printf("   Heap Size = %d, ", FMM_Heap_getHeapSize(fmm_heap));
@@ -239,11 +244,11 @@ int main( int argc, char *argv[])
     FMM_HeapNode root = FMM_Heap_extractMin(fmm_heap,&moved_node,&moved_handle);
     printf("---------------------\n");
     printf("Root: \n");
-    printf("Grid Index = "); printGridIndex(root.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(root.idx); printf(", ");
     printf("Value = %g, ", root.value); 
     printf("Heap Position = %d\n", root.heap_pos); 
     printf("Moved Node: \n");
-    printf("Grid Index = "); printGridIndex(moved_node.grid_idx); printf(", ");
+    printf("Grid Index = "); printGridIndex(moved_node.idx); printf(", ");
     printf("Value = %g, ",  moved_node.value); 
     printf("Heap Position = %d\n", moved_node.heap_pos);
     printf("   Node Handle = %d\n", moved_handle);
@@ -265,13 +270,14 @@ int main( int argc, char *argv[])
   return(0);
 }
 
-void printGridIndex(int grid_idx[FMM_HEAP_MAX_NDIM])
+void printGridIndex(int idx)
 {
   int i;
 
   printf("(");
   for (i = 0; i<TEST_DIM; i++) {
-    printf("%d", grid_idx[i]);
+    printf("%d", (idx < 0) ? -1 : idx%TEST_GRID_SIZE);
+    if (idx >= 0) idx /= TEST_GRID_SIZE;
     if (i<TEST_DIM-1) printf(",");
   } 
   printf(")");
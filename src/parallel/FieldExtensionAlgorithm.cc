@@ -81,6 +81,9 @@ FieldExtensionAlgorithm<DIM>::FieldExtensionAlgorithm(
   d_phi_bc_module = new BoundaryConditionModule<DIM>;
   d_ext_field_bc_module = new BoundaryConditionModule<DIM>;
 
+  // no persistent scratch data has been allocated yet
+  d_persistent_scratch_data_bytes = 0;
+
   // initialize variables and communication objects
   initializeVariables(phi_ghostcell_width);
   initializeCommunicationObjects();
@@ -164,6 +167,9 @@ FieldExtensionAlgorithm<DIM>::FieldExtensionAlgorithm(
   // set verbose-mode
   d_verbose_mode = verbose_mode;
 
+  // scratch data is allocated for each calculation by default
+  d_use_persistent_scratch_data = LSM_DEFAULT_USE_PERSISTENT_SCRATCH_DATA;
+
   // check that the user-specifeid parameters are acceptable
   checkParameters();
 
@@ -171,6 +177,9 @@ FieldExtensionAlgorithm<DIM>::FieldExtensionAlgorithm(
   d_phi_bc_module = new BoundaryConditionModule<DIM>;
   d_ext_field_bc_module = new BoundaryConditionModule<DIM>;
 
+  // no persistent scratch data has been allocated yet
+  d_persistent_scratch_data_bytes = 0;
+
   // initialize variables and communication objects
   initializeVariables(phi_ghostcell_width);
   initializeCommunicationObjects();
@@ -196,10 +205,12 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionField(
 
   // allocate patch data for requird to compute extension field
   const int num_levels = d_patch_hierarchy->getNumberLevels();
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = 
-      d_patch_hierarchy->getPatchLevel(ln);
-    level->allocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(d_scratch_data);
+    }
   }
 
   /*
@@ -437,10 +448,12 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionField(
   }
 
   // deallocate patch data that was allocated to compute extension fields
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level 
-      = d_patch_hierarchy->getPatchLevel(ln);
-    level->deallocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData(d_scratch_data);
+    }
   }
 }
 
@@ -465,10 +478,12 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionFieldForSingleComponent(
 
   // allocate patch data for required to compute extension field
   const int num_levels = d_patch_hierarchy->getNumberLevels();
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = 
-      d_patch_hierarchy->getPatchLevel(ln);
-    level->allocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(d_scratch_data);
+    }
   }
 
   /*
@@ -674,10 +689,12 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionFieldForSingleComponent(
   }
 
   // deallocate patch data that was allocated to compute extension fields
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level 
-      = d_patch_hierarchy->getPatchLevel(ln);
-    level->deallocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData(d_scratch_data);
+    }
   }
 }
 
@@ -739,11 +756,61 @@ void FieldExtensionAlgorithm<DIM>::resetHierarchyConfiguration(
     finest_level,
     d_ext_field_scratch_ghostcell_width);
 
+  // (re)allocate persistent scratch data on the levels that changed
+  if (d_use_persistent_scratch_data) {
+    for (int ln = coarsest_level; ln <= finest_level; ln++) {
+      Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData(d_scratch_data);
+      level->allocatePatchData(d_scratch_data);
+    }
+    d_persistent_scratch_data_bytes = 
+      LevelSetMethodToolbox<DIM>::computePatchDataMemoryUsage(
+        hierarchy, d_scratch_data);
+  }
+
   // set d_hierarchy_configuration_needs_reset to (finest_level < 0)
   d_hierarchy_configuration_needs_reset = (finest_level < 0);
 }
 
 
+/* setUsePersistentScratchData() */
+template <int DIM>
+void FieldExtensionAlgorithm<DIM>::setUsePersistentScratchData(
+  const bool use_persistent_scratch_data)
+{
+  if (use_persistent_scratch_data == d_use_persistent_scratch_data) return;
+  d_use_persistent_scratch_data = use_persistent_scratch_data;
+
+  // allocate or free scratch data on all levels
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+    Pointer< PatchLevel<DIM> > level = 
+      d_patch_hierarchy->getPatchLevel(ln);
+    if (d_use_persistent_scratch_data) {
+      level->allocatePatchData(d_scratch_data);
+    } else {
+      level->deallocatePatchData(d_scratch_data);
+    }
+  }
+
+  if (d_use_persistent_scratch_data) {
+    d_persistent_scratch_data_bytes = 
+      LevelSetMethodToolbox<DIM>::computePatchDataMemoryUsage(
+        d_patch_hierarchy, d_scratch_data);
+  } else {
+    d_persistent_scratch_data_bytes = 0;
+  }
+}
+
+
+/* getPersistentScratchDataBytes() */
+template <int DIM>
+size_t FieldExtensionAlgorithm<DIM>::getPersistentScratchDataBytes() const
+{
+  return d_persistent_scratch_data_bytes;
+}
+
+
 /* advanceFieldExtensionEqnUsingTVDRK1() */
 template <int DIM> 
 void FieldExtensionAlgorithm<DIM>::advanceFieldExtensionEqnUsingTVDRK1(
@@ -1554,6 +1621,10 @@ void FieldExtensionAlgorithm<DIM>::getFromInput(
     }
   }
 
+  // get persistent scratch data flag
+  d_use_persistent_scratch_data = db->getBoolWithDefault(
+    "use_persistent_scratch_data", LSM_DEFAULT_USE_PERSISTENT_SCRATCH_DATA);
+
   // get verbose mode
   d_verbose_mode = db->getBoolWithDefault(
     "verbose_mode", LSM_DEFAULT_VERBOSE_MODE);
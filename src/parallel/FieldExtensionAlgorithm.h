@@ -60,8 +60,18 @@
  *                                (default = 0.0)
  * - verbose_mode               = flag to activate/deactivate verbose-mode 
  *                                (default = false)
+ * - use_persistent_scratch_data = flag to keep the scratch PatchData
+ *                                allocated between field extension
+ *                                calculations (default = false)
  *
  * <h3> NOTES: </h3>
+ *
+ * - When use_persistent_scratch_data is true, the scratch PatchData is
+ *   allocated by resetHierarchyConfiguration() and kept allocated
+ *   between field extension calculations instead of being allocated and
+ *   deallocated on every call.  This reduces the allocation overhead
+ *   for PatchHierarchies with many small patches at the cost of the
+ *   memory reported by getPersistentScratchDataBytes().
  * 
  * - The values of the extension field in grid cells adjacent to 
  *   the zero level set in the directions of the coordinate axes 
@@ -476,6 +486,34 @@ public:
     const int coarsest_level,
     const int finest_level);
 
+  /*!
+   * setUsePersistentScratchData() activates or deactivates persistent
+   * scratch PatchData (see NOTES in class description).  When activated,
+   * the scratch PatchData is immediately allocated on all levels of the
+   * PatchHierarchy; when deactivated, it is deallocated.
+   *
+   * Arguments:
+   *  - use_persistent_scratch_data (in):  true to keep scratch PatchData
+   *                                       allocated between calls
+   *
+   * Return value:                         none
+   *
+   */
+  virtual void setUsePersistentScratchData(
+    const bool use_persistent_scratch_data);
+
+  /*!
+   * getPersistentScratchDataBytes() returns the number of bytes of 
+   * scratch PatchData kept allocated on this processor.
+   *
+   * Arguments:      none
+   *
+   * Return value:   number of bytes of persistent scratch PatchData
+   *                 (zero if persistent scratch PatchData is not used)
+   *
+   */
+  virtual size_t getPersistentScratchDataBytes() const;
+
   //! @}
 
 
@@ -720,6 +758,10 @@ protected:
   // ComponentSelector to organize variables
   ComponentSelector d_scratch_data;
 
+  // persistent scratch data
+  bool d_use_persistent_scratch_data;
+  size_t d_persistent_scratch_data_bytes;
+
   /*
    * Boundary condition objects
    */
@@ -21,6 +21,10 @@
 #define LSM_DEFAULT_SPATIAL_DERIVATIVE_ENO_ORDER         (3)
 #define LSM_DEFAULT_TVD_RUNGE_KUTTA_ORDER                (3)
 #define LSM_DEFAULT_CFL_NUMBER                           (0.5)
+#define LSM_DEFAULT_USE_PERSISTENT_SCRATCH_DATA          (false)
+#define LSM_DEFAULT_GHOSTCELL_EXCHANGE_INTERVAL          (0)
+#define LSM_DEFAULT_CONVERGENCE_CHECK_INTERVAL           (1)
+#define LSM_DEFAULT_BATCH_GHOSTCELL_FILLS                (false)
 #define LSM_DEFAULT_VERBOSE_MODE                         (false)
 
 #endif
@@ -13,6 +13,7 @@
 
 // System Headers
 #include <float.h>
+#include <math.h>
 #include <sstream>
 
 #include "LevelSetFunctionIntegrator.h" 
@@ -46,6 +47,14 @@ extern "C" {
   #include "lsm_level_set_evolution1d.h"
   #include "lsm_level_set_evolution2d.h"
   #include "lsm_level_set_evolution3d.h"
+  #include "lsm_level_set_evolution2d_local.h"
+  #include "lsm_level_set_evolution3d_local.h"
+  #include "lsm_localization2d.h"
+  #include "lsm_localization3d.h"
+  #include "lsm_spatial_derivatives2d_local.h"
+  #include "lsm_spatial_derivatives3d_local.h"
+  #include "lsm_tvd_runge_kutta2d_local.h"
+  #include "lsm_tvd_runge_kutta3d_local.h"
   #include "lsm_utilities1d.h"
   #include "lsm_utilities2d.h"
   #include "lsm_utilities3d.h"
@@ -70,10 +79,28 @@ using namespace pdat;
 #define LSM_DEFAULT_USE_AMR                              (false)
 #define LSM_DEFAULT_REGRID_INTERVAL                      (5)  // KTC - ADJUST
 #define LSM_DEFAULT_TAG_BUFFER_WIDTH                     (2)  // KTC - ADJUST
+#define LSM_DEFAULT_SKIP_REDUNDANT_GHOSTCELL_FILLS       (false)
+#define LSM_DEFAULT_USE_LOW_STORAGE_RUNGE_KUTTA          (false)
+#define LSM_DEFAULT_USE_ADAPTIVE_REGRIDDING              (false)
+#define LSM_DEFAULT_REGRID_BUFFER_FRACTION               (0.5)
 #define LSM_DEFAULT_REFINEMENT_CUTOFF_VALUE              (1.0)  // KTC - ADJUST
+#define LSM_DEFAULT_USE_NARROW_BAND                      (false)
+#define LSM_DEFAULT_NARROW_BAND_WIDTH                    (4.0)
+#define LSM_DEFAULT_NARROW_BAND_INNER_WIDTH              (2.0)
 #define LSM_DEFAULT_VERBOSE_MODE                         (false)
 #define LSM_STOP_TOLERANCE_MAX_ITERATIONS                (1000)
 
+/*
+ * Marks for the ghost cell layers of the narrow band.  Narrow band
+ * points with values up to LSM_NARROW_BAND_MARK_FB lie in the interior 
+ * of the patch (values 1 to level+1 are used for the narrow band 
+ * levels).
+ */
+#define LSM_NARROW_BAND_MARK_GB                          (127)
+#define LSM_NARROW_BAND_MARK_D1                          (126)
+#define LSM_NARROW_BAND_MARK_D2                          (125)
+#define LSM_NARROW_BAND_MARK_FB                          (124)
+
 #ifdef LSMLIB_DEBUG_NO_INLINE
 #include "LevelSetFunctionIntegrator.inline"
 #endif
@@ -100,7 +127,17 @@ LevelSetFunctionIntegrator<DIM>::LevelSetFunctionIntegrator(
   d_grad_psi_plus_handle(-1),
   d_grad_psi_minus_handle(-1),
   d_grad_psi_upwind_handle(-1),
-  d_rhs_psi_handle(-1)
+  d_rhs_psi_handle(-1),
+  d_phi_regrid_reference_handle(-1),
+  d_psi_regrid_reference_handle(-1),
+  d_interface_displacement(0.0),
+  d_narrow_band_D1_handle(-1),
+  d_narrow_band_D2_handle(-1),
+  d_narrow_band_level(0),
+  d_persistent_scratch_data_bytes(0),
+  d_num_scratch_data_allocations(0),
+  d_level_set_ghostcells_filled(false),
+  d_num_ghostcell_fills_skipped(0)
 {
 #ifdef DEBUG_CHECK_ASSERTIONS
   assert(!input_db.isNull());
@@ -199,7 +236,10 @@ LevelSetFunctionIntegrator<DIM>::LevelSetFunctionIntegrator(
       d_reinitialization_max_iters,
       d_reinitialization_stop_tol,
       d_verbose_mode,
-      "phi reinitialization algorithm");
+      "phi reinitialization algorithm",
+      d_reinitialization_ghostcell_exchange_interval,
+      d_reinitialization_convergence_check_interval,
+      d_reinitialization_batch_ghostcell_fills);
 
   // create reinitialization algorithm for psi (if necessary)
   if (d_codimension == 2) {
@@ -216,8 +256,19 @@ LevelSetFunctionIntegrator<DIM>::LevelSetFunctionIntegrator(
         d_reinitialization_max_iters,
         d_reinitialization_stop_tol,
         d_verbose_mode,
-        "psi reinitialization algorithm");
+        "psi reinitialization algorithm",
+        d_reinitialization_ghostcell_exchange_interval,
+        d_reinitialization_convergence_check_interval,
+        d_reinitialization_batch_ghostcell_fills);
    }
+
+  // keep scratch data for reinitialization allocated (if requested)
+  d_phi_reinitialization_alg->setUsePersistentScratchData(
+    d_use_persistent_scratch_data);
+  if (d_codimension == 2) {
+    d_psi_reinitialization_alg->setUsePersistentScratchData(
+      d_use_persistent_scratch_data);
+  }
  
   // create orthogonalization algorithm for codimension-two problems
   if (d_codimension == 2) {
@@ -283,6 +334,8 @@ LevelSetFunctionIntegrator<DIM>::printClassData(
   os << "d_spatial_derivative_type = " << d_spatial_derivative_type << endl;
   os << "d_spatial_derivative_order = " << d_spatial_derivative_order << endl;
   os << "d_tvd_runge_kutta_order = " << d_tvd_runge_kutta_order << endl;
+  os << "d_use_low_storage_runge_kutta = " 
+     << (d_use_low_storage_runge_kutta ? "true" : "false") << endl;
   os << "d_reinitialization_interval = " 
      << d_reinitialization_interval << endl;
   os << "d_reinitialization_stop_tol = " 
@@ -291,6 +344,13 @@ LevelSetFunctionIntegrator<DIM>::printClassData(
      << d_reinitialization_stop_dist << endl;
   os << "d_reinitialization_max_iters = " 
      << d_reinitialization_max_iters << endl;
+  os << "d_reinitialization_ghostcell_exchange_interval = " 
+     << d_reinitialization_ghostcell_exchange_interval << endl;
+  os << "d_reinitialization_convergence_check_interval = " 
+     << d_reinitialization_convergence_check_interval << endl;
+  os << "d_reinitialization_batch_ghostcell_fills = " 
+     << (d_reinitialization_batch_ghostcell_fills ? "true" : "false") 
+     << endl;
   os << "d_orthogonalization_interval = " 
      << d_orthogonalization_interval << endl;
   os << "d_orthogonalization_stop_tol = " 
@@ -306,6 +366,30 @@ LevelSetFunctionIntegrator<DIM>::printClassData(
   os << "d_regrid_interval = " << d_regrid_interval << endl;
   os << "d_tag_buffer_width = " << d_tag_buffer_width << endl;
   os << "d_refinement_cutoff_value = " << d_refinement_cutoff_value << endl;
+  os << "d_use_adaptive_regridding = " 
+     << (d_use_adaptive_regridding ? "true" : "false") << endl;
+  os << "d_regrid_buffer_fraction = " << d_regrid_buffer_fraction << endl;
+  os << "d_interface_displacement = " << d_interface_displacement << endl;
+
+  os << "Narrow band parameters" << endl;
+  os << "----------------------" << endl;
+  os << "d_use_narrow_band = " << (d_use_narrow_band ? "true" : "false") 
+     << endl;
+  os << "d_narrow_band_width = " << d_narrow_band_width << endl;
+  os << "d_narrow_band_inner_width = " << d_narrow_band_inner_width << endl;
+
+  os << "Scratch data parameters" << endl;
+  os << "-----------------------" << endl;
+  os << "d_use_persistent_scratch_data = " 
+     << (d_use_persistent_scratch_data ? "true" : "false") << endl;
+  os << "persistent scratch data bytes = " 
+     << getPersistentScratchDataBytes() << endl;
+  os << "d_num_scratch_data_allocations = " 
+     << d_num_scratch_data_allocations << endl;
+  os << "d_skip_redundant_ghostcell_fills = " 
+     << (d_skip_redundant_ghostcell_fills ? "true" : "false") << endl;
+  os << "d_num_ghostcell_fills_skipped = " 
+     << d_num_ghostcell_fills_skipped << endl;
 
   os << "PatchData Handles" << endl;
   os << "-----------------" << endl;
@@ -368,36 +452,45 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
 
   // allocate scratch space
   const int num_levels = d_patch_hierarchy->getNumberLevels();
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = 
-      d_patch_hierarchy->getPatchLevel(ln);
-    level->allocatePatchData( d_compute_stable_dt_scratch_variables );
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData( d_compute_stable_dt_scratch_variables );
+    }
+    d_num_scratch_data_allocations++;
   }
  
   // fill boundary data to for phi/psi to be used for computing
-  // velocity field
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    // NOTE: true indicates that physical boundary conditions should
-    //       be set.
-    d_fill_bdry_sched_compute_stable_dt[ln]->fillData(d_current_time,true);
-  }
-  for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
-    d_bc_module->imposeBoundaryConditions(
-      d_phi_handles[0],
-      d_lower_bc_phi[comp], 
-      d_upper_bc_phi[comp], 
-      d_spatial_derivative_type,
-      d_spatial_derivative_order,
-      comp);
-    if (d_codimension == 2) {
+  // velocity field (unless the ghost cells are still current from the 
+  // synchronization at the end of the last time step)
+  if (d_skip_redundant_ghostcell_fills && d_level_set_ghostcells_filled) {
+    d_num_ghostcell_fills_skipped++;
+  } else {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      // NOTE: true indicates that physical boundary conditions should
+      //       be set.
+      d_fill_bdry_sched_compute_stable_dt[ln]->fillData(d_current_time,true);
+    }
+    for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
       d_bc_module->imposeBoundaryConditions(
-        d_psi_handles[0],
-        d_lower_bc_psi[comp], 
-        d_upper_bc_psi[comp], 
+        d_phi_handles[0],
+        d_lower_bc_phi[comp], 
+        d_upper_bc_phi[comp], 
         d_spatial_derivative_type,
         d_spatial_derivative_order,
         comp);
+      if (d_codimension == 2) {
+        d_bc_module->imposeBoundaryConditions(
+          d_psi_handles[0],
+          d_lower_bc_psi[comp], 
+          d_upper_bc_psi[comp], 
+          d_spatial_derivative_type,
+          d_spatial_derivative_order,
+          comp);
+      }
     }
+    d_level_set_ghostcells_filled = true;
   }
 
   // loop over PatchHierarchy and compute the maximum stable
@@ -577,10 +670,12 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
   } // end case: user_specified_dt not provided
 
   // deallocate patch data that was allocated for the time advance
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level 
-      = d_patch_hierarchy->getPatchLevel(ln);
-    level->deallocatePatchData( d_compute_stable_dt_scratch_variables );
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level 
+        = d_patch_hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData( d_compute_stable_dt_scratch_variables );
+    }
   }
 
   return max_stable_dt;
@@ -598,40 +693,54 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
   // if this is the first time step, synchronize data across processors 
   // NOTE:  normally this is done at the end of the time advance
   if (d_current_time == d_start_time) {
-    for ( int ln=0 ; ln < num_levels; ln++ ) {
-      // NOTE: true indicates that physical boundary conditions should
-      //       be set.
-      d_fill_bdry_sched_time_advance[0][ln]
-       ->fillData(d_current_time,true);
-    }
-    for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
-      d_bc_module->imposeBoundaryConditions(
-        d_phi_handles[0],
-        d_lower_bc_phi[comp], 
-        d_upper_bc_phi[comp], 
-        d_spatial_derivative_type,
-        d_spatial_derivative_order,
-        comp);
-      if (d_codimension == 2) {
+    if (d_skip_redundant_ghostcell_fills && d_level_set_ghostcells_filled) {
+      d_num_ghostcell_fills_skipped++;
+    } else {
+      for ( int ln=0 ; ln < num_levels; ln++ ) {
+        // NOTE: true indicates that physical boundary conditions should
+        //       be set.
+        d_fill_bdry_sched_time_advance[0][ln]
+         ->fillData(d_current_time,true);
+      }
+      for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
         d_bc_module->imposeBoundaryConditions(
-          d_psi_handles[0],
-          d_lower_bc_psi[comp], 
-          d_upper_bc_psi[comp], 
+          d_phi_handles[0],
+          d_lower_bc_phi[comp], 
+          d_upper_bc_phi[comp], 
           d_spatial_derivative_type,
           d_spatial_derivative_order,
           comp);
+        if (d_codimension == 2) {
+          d_bc_module->imposeBoundaryConditions(
+            d_psi_handles[0],
+            d_lower_bc_psi[comp], 
+            d_upper_bc_psi[comp], 
+            d_spatial_derivative_type,
+            d_spatial_derivative_order,
+            comp);
+        }
       }
+      d_level_set_ghostcells_filled = true;
     }
   } // end synchronization of data for initial time step
 
   // allocate scratch space
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = 
-      d_patch_hierarchy->getPatchLevel(ln);
-    level->allocatePatchData( d_time_advance_scratch_variables );
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData( d_time_advance_scratch_variables );
+    }
+    d_num_scratch_data_allocations++;
+  }
+
+  // determine narrow band around the zero level set
+  if (d_use_narrow_band) {
+    buildNarrowBand();
   }
  
   // advance level set equation using TVD Runge-Kutta 
+  d_level_set_ghostcells_filled = false;
   switch(d_tvd_runge_kutta_order) {
     case 1: { // first-order TVD RK (e.g. Forward Euler)
       advanceLevelSetEqnUsingTVDRK1(dt);
@@ -696,13 +805,16 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
     d_reinitialization_count = 0;
   } 
 
-  // determine if patch hierarchy needs to be regridded
-  // KTC - DO SOMETHING SMARTER
-  // regrid patch hierachy
+  // determine if patch hierarchy needs to be regridded: either when
+  // the zero level set has moved far enough into the tag buffer
+  // (adaptive regridding) or every regrid_interval time steps
   bool regrid_needed = false;
-  if (0 == d_regrid_count%d_regrid_interval) 
-  {
-    regrid_needed = true;
+  if (d_use_adaptive_regridding) {
+    regrid_needed = interfaceDisplacementRequiresRegrid();
+  } else {
+    regrid_needed = (0 == d_regrid_count%d_regrid_interval);
+  }
+  if (regrid_needed) {
     d_regrid_count = 1;
   } else {
     d_regrid_count++;
@@ -713,10 +825,12 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
   d_num_integration_steps_taken++;
 
   // deallocate patch data that was allocated for the time advance
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level 
-      = d_patch_hierarchy->getPatchLevel(ln);
-    level->deallocatePatchData( d_time_advance_scratch_variables );
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level 
+        = d_patch_hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData( d_time_advance_scratch_variables );
+    }
   }
 
   // synchronize data across processors
@@ -744,6 +858,7 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
         comp);
     }
   }
+  d_level_set_ghostcells_filled = true;
 
   // reinitialize level set functions to approximate distance functions
   return regrid_needed;
@@ -819,6 +934,12 @@ void LevelSetFunctionIntegrator<DIM>::putToDatabase(Pointer<Database> db)
   db->putInteger("d_regrid_interval", d_regrid_interval);
   db->putInteger("d_tag_buffer_width", d_tag_buffer_width);
   db->putDouble("d_refinement_cutoff_value", d_refinement_cutoff_value);
+  db->putBool("d_use_adaptive_regridding", d_use_adaptive_regridding);
+  db->putDouble("d_regrid_buffer_fraction", d_regrid_buffer_fraction);
+
+  db->putBool("d_use_narrow_band", d_use_narrow_band); 
+  db->putDouble("d_narrow_band_width", d_narrow_band_width);
+  db->putDouble("d_narrow_band_inner_width", d_narrow_band_inner_width);
 
   db->putBool("d_verbose_mode", d_verbose_mode); 
 
@@ -861,6 +982,8 @@ void LevelSetFunctionIntegrator<DIM>::initializeLevelData (
   const Pointer< BasePatchLevel<DIM> > old_level,
   const bool allocate_data)
 {
+  // ghost cells must be filled again after a level is (re)initialized
+  d_level_set_ghostcells_filled = false;
 
 #ifdef DEBUG_CHECK_ASSERTIONS
    assert(!hierarchy.isNull());
@@ -985,6 +1108,9 @@ void LevelSetFunctionIntegrator<DIM>::setBoundaryConditions(
       } 
     } 
   }
+
+  // ghost cells must be filled using the new boundary conditions
+  d_level_set_ghostcells_filled = false;
 }
 
 
@@ -1081,11 +1207,14 @@ void LevelSetFunctionIntegrator<DIM>::resetHierarchyConfiguration(
   }
 #endif
 
+  // ghost cells must be filled on the new hierarchy configuration
+  d_level_set_ghostcells_filled = false;
+
   int num_levels = hierarchy->getNumberLevels();
 
   // reset communications schedules used to fill boundary data 
   // during time advance
-  for (int k = 0; k < d_tvd_runge_kutta_order; k++) {
+  for (int k = 0; k < d_num_time_advance_buffers; k++) {
     d_fill_bdry_sched_time_advance[k].resizeArray(num_levels);
 
     for (int ln = coarsest_level; ln <= finest_level; ln++) {
@@ -1140,6 +1269,100 @@ void LevelSetFunctionIntegrator<DIM>::resetHierarchyConfiguration(
     finest_level,
     d_level_set_ghostcell_width);
 
+  // save the level set functions used to detect when the next regrid
+  // is needed
+  if (d_use_adaptive_regridding) {
+    resetRegridReference();
+  }
+
+  // (re)allocate persistent scratch data on the levels that changed
+  // NOTE: the scratch data for computing the stable dt is a subset of
+  //       the scratch data for the time advance
+  if (d_use_persistent_scratch_data) {
+    for (int ln = coarsest_level; ln <= finest_level; ln++) {
+      Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData(d_time_advance_scratch_variables);
+      level->allocatePatchData(d_time_advance_scratch_variables);
+    }
+    d_num_scratch_data_allocations++;
+    d_persistent_scratch_data_bytes = 
+      LevelSetMethodToolbox<DIM>::computePatchDataMemoryUsage(
+        d_patch_hierarchy, d_time_advance_scratch_variables);
+  }
+
+}
+
+
+/* resetRegridReference() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::resetRegridReference()
+{
+  for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
+    LevelSetMethodToolbox<DIM>::copySAMRAIData(
+      d_patch_hierarchy, 
+      d_phi_regrid_reference_handle, d_phi_handles[0],
+      comp, comp);
+    if (d_codimension == 2) {
+      LevelSetMethodToolbox<DIM>::copySAMRAIData(
+        d_patch_hierarchy, 
+        d_psi_regrid_reference_handle, d_psi_handles[0],
+        comp, comp);
+    }
+  }
+  d_interface_displacement = 0.0;
+}
+
+
+/* interfaceDisplacementRequiresRegrid() */
+template <int DIM> 
+bool LevelSetFunctionIntegrator<DIM>::interfaceDisplacementRequiresRegrid()
+{
+  // estimate the displacement of the zero level set(s) since the last
+  // regrid
+  LSMLIB_REAL displacement = 0.0;
+  for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
+    LSMLIB_REAL comp_displacement = 
+      LevelSetMethodToolbox<DIM>::maxNormOfDifferenceNearZeroLevelSet(
+        d_patch_hierarchy, 
+        d_phi_handles[0], d_phi_regrid_reference_handle,
+        d_control_volume_handle, d_refinement_cutoff_value,
+        comp, comp);
+    if (comp_displacement > displacement) displacement = comp_displacement;
+
+    if (d_codimension == 2) {
+      comp_displacement = 
+        LevelSetMethodToolbox<DIM>::maxNormOfDifferenceNearZeroLevelSet(
+          d_patch_hierarchy, 
+          d_psi_handles[0], d_psi_regrid_reference_handle,
+          d_control_volume_handle, d_refinement_cutoff_value,
+          comp, comp);
+      if (comp_displacement > displacement) displacement = comp_displacement;
+    }
+  }
+  d_interface_displacement = displacement;
+
+  // compute the width of the tag buffer on the level that is tagged 
+  // to create the finest level (the coarsest level if there is only 
+  // one level)
+  int tag_ln = d_patch_hierarchy->getFinestLevelNumber() - 1;
+  if (tag_ln < 0) tag_ln = 0;
+  const IntVector<DIM> ratio = 
+    d_patch_hierarchy->getPatchLevel(tag_ln)->getRatio();
+  const double* dx_coarsest = d_grid_geometry->getDx();
+  LSMLIB_REAL dx_min = dx_coarsest[0]/ratio(0);
+  for (int dim = 1; dim < DIM; dim++) {
+    LSMLIB_REAL dx = dx_coarsest[dim]/ratio(dim);
+    if (dx < dx_min) dx_min = dx;
+  }
+  LSMLIB_REAL buffer_width = d_tag_buffer_width*dx_min;
+
+  if (d_verbose_mode) {
+    pout << d_object_name << "::interfaceDisplacementRequiresRegrid(): "
+         << "displacement since last regrid = " << displacement
+         << ", tag buffer width = " << buffer_width << endl;
+  }
+
+  return (displacement >= d_regrid_buffer_fraction*buffer_width);
 }
 
 
@@ -1165,12 +1388,19 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK1(
     // advance phi through TVD-RK1 step 
     computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
                                comp);
-    LevelSetMethodToolbox<DIM>::TVDRK1Step(
-      d_patch_hierarchy,
-      d_phi_handles[0], 
-      d_phi_handles[rk_stage], 
-      d_rhs_phi_handle, dt,
-      comp, comp, 0); // components of PatchData to use in TVD-RK1 step
+    if (d_use_narrow_band) {
+      advanceLevelSetEqnStageLocal(RK1_STEP,
+        d_phi_handles[0],
+        d_phi_handles[rk_stage],
+        -1, dt, comp);
+    } else {
+      LevelSetMethodToolbox<DIM>::TVDRK1Step(
+        d_patch_hierarchy,
+        d_phi_handles[0], 
+        d_phi_handles[rk_stage], 
+        d_rhs_phi_handle, dt,
+        comp, comp, 0); // components of PatchData to use in TVD-RK1 step
+    }
 
     if (d_codimension == 2) {
 
@@ -1214,13 +1444,20 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
     // advance phi through the first stage of TVD-RK2 
     computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
                                comp);
-    LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
-      d_patch_hierarchy,
-      d_phi_handles[rk_stage+1],
-      d_phi_handles[rk_stage],
-      d_rhs_phi_handle, dt,
-      comp, comp, 0); // components of PatchData to use in first 
-                      // stage TVD-RK2 step
+    if (d_use_narrow_band) {
+      advanceLevelSetEqnStageLocal(TVD_RK2_STAGE1,
+        d_phi_handles[rk_stage+1],
+        d_phi_handles[rk_stage],
+        -1, dt, comp);
+    } else {
+      LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
+        d_patch_hierarchy,
+        d_phi_handles[rk_stage+1],
+        d_phi_handles[rk_stage],
+        d_rhs_phi_handle, dt,
+        comp, comp, 0); // components of PatchData to use in first 
+                        // stage TVD-RK2 step
+    }
 
     if (d_codimension == 2) {
 
@@ -1285,14 +1522,22 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
     // advance phi through the second stage of TVD-RK2 
     computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
                                comp);
-    LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
-      d_patch_hierarchy,
-      d_phi_handles[0],
-      d_phi_handles[rk_stage],
-      d_phi_handles[0],
-      d_rhs_phi_handle, dt,
-      comp, comp, comp, 0); // components of PatchData to use in final 
-                            // stage of TVD-RK2 step
+    if (d_use_narrow_band) {
+      advanceLevelSetEqnStageLocal(TVD_RK2_STAGE2,
+        d_phi_handles[0],
+        d_phi_handles[rk_stage],
+        d_phi_handles[0],
+        dt, comp);
+    } else {
+      LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
+        d_patch_hierarchy,
+        d_phi_handles[0],
+        d_phi_handles[rk_stage],
+        d_phi_handles[0],
+        d_rhs_phi_handle, dt,
+        comp, comp, comp, 0); // components of PatchData to use in final 
+                              // stage of TVD-RK2 step
+    }
 
     if (d_codimension == 2) {
 
@@ -1338,13 +1583,20 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
     // advance phi through the first stage of TVD-RK3
     computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
                                comp);
-    LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
-      d_patch_hierarchy,
-      d_phi_handles[rk_stage+1],
-      d_phi_handles[rk_stage],
-      d_rhs_phi_handle, dt,
-      comp, comp, 0); // components of PatchData to use in first stage 
-                      // of TVD-RK3 step
+    if (d_use_narrow_band) {
+      advanceLevelSetEqnStageLocal(TVD_RK3_STAGE1,
+        d_phi_handles[rk_stage+1],
+        d_phi_handles[rk_stage],
+        -1, dt, comp);
+    } else {
+      LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
+        d_patch_hierarchy,
+        d_phi_handles[rk_stage+1],
+        d_phi_handles[rk_stage],
+        d_rhs_phi_handle, dt,
+        comp, comp, 0); // components of PatchData to use in first stage 
+                        // of TVD-RK3 step
+    }
 
     if (d_codimension == 2) {
   
@@ -1409,28 +1661,60 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
     // advance phi through the second stage of TVD-RK3
     computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
                                comp);
-    LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
-      d_patch_hierarchy,
-      d_phi_handles[rk_stage+1],
-      d_phi_handles[rk_stage],
-      d_phi_handles[rk_stage-1],
-      d_rhs_phi_handle, dt,
-      comp, comp, comp, 0); // components of PatchData to use in second 
-                            // stage of TVD-RK3 step
+    if (d_use_narrow_band && d_use_low_storage_runge_kutta) {
+      advanceLevelSetEqnStageLocal(LOW_STORAGE_TVD_RK3_STAGE2,
+        d_phi_handles[rk_stage],
+        d_phi_handles[rk_stage],
+        d_phi_handles[rk_stage-1],
+        dt, comp);
+    } else if (d_use_narrow_band) {
+      advanceLevelSetEqnStageLocal(TVD_RK3_STAGE2,
+        d_phi_handles[rk_stage+1],
+        d_phi_handles[rk_stage],
+        d_phi_handles[rk_stage-1],
+        dt, comp);
+    } else if (d_use_low_storage_runge_kutta) {
+      LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage2(
+        d_patch_hierarchy,
+        d_phi_handles[rk_stage],
+        d_phi_handles[rk_stage-1],
+        d_rhs_phi_handle, dt,
+        comp, comp, 0); // components of PatchData to use in second 
+                        // stage of TVD-RK3 step
+    } else {
+      LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
+        d_patch_hierarchy,
+        d_phi_handles[rk_stage+1],
+        d_phi_handles[rk_stage],
+        d_phi_handles[rk_stage-1],
+        d_rhs_phi_handle, dt,
+        comp, comp, comp, 0); // components of PatchData to use in second 
+                              // stage of TVD-RK3 step
+    }
 
     if (d_codimension == 2) {
 
       // advance psi through the second stage of TVD-RK3
       computeLevelSetEquationRHS(PSI,d_psi_handles[rk_stage],
                                  comp);
-      LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
-        d_patch_hierarchy,
-        d_psi_handles[rk_stage+1],
-        d_psi_handles[rk_stage],
-        d_psi_handles[rk_stage-1],
-        d_rhs_psi_handle, dt,
-        comp, comp, comp, 0); // components of PatchData to use in second 
-                              // stage of TVD-RK3 step
+      if (d_use_low_storage_runge_kutta) {
+        LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage2(
+          d_patch_hierarchy,
+          d_psi_handles[rk_stage],
+          d_psi_handles[rk_stage-1],
+          d_rhs_psi_handle, dt,
+          comp, comp, 0); // components of PatchData to use in second 
+                          // stage of TVD-RK3 step
+      } else {
+        LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
+          d_patch_hierarchy,
+          d_psi_handles[rk_stage+1],
+          d_psi_handles[rk_stage],
+          d_psi_handles[rk_stage-1],
+          d_rhs_psi_handle, dt,
+          comp, comp, comp, 0); // components of PatchData to use in  
+                                // second stage of TVD-RK3 step
+      }
     }
   } // end loop over vector level set function
 
@@ -1440,7 +1724,9 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   // { begin Stage 3
 
   // advance TVD RK3 stage counter
-  rk_stage = 2;
+  // NOTE: the low-storage form keeps the second stage approximation
+  //       in the PatchData used for the first stage
+  rk_stage = (d_use_low_storage_runge_kutta ? 1 : 2);
 
   // fill scratch space for second stage of time advance
   for ( int ln=0 ; ln < num_levels; ln++ ) {
@@ -1481,14 +1767,22 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
     // advance phi through the second stage of TVD-RK3
     computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
                                comp);
-    LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
-      d_patch_hierarchy,
-      d_phi_handles[0],
-      d_phi_handles[rk_stage],
-      d_phi_handles[0],
-      d_rhs_phi_handle, dt,
-      comp, comp, comp, 0); // components of PatchData to use in final 
-                            // stage of TVD-RK3 step
+    if (d_use_narrow_band) {
+      advanceLevelSetEqnStageLocal(TVD_RK3_STAGE3,
+        d_phi_handles[0],
+        d_phi_handles[rk_stage],
+        d_phi_handles[0],
+        dt, comp);
+    } else {
+      LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
+        d_patch_hierarchy,
+        d_phi_handles[0],
+        d_phi_handles[rk_stage],
+        d_phi_handles[0],
+        d_rhs_phi_handle, dt,
+        comp, comp, comp, 0); // components of PatchData to use in final 
+                              // stage of TVD-RK3 step
+    }
 
     if (d_codimension == 2) {
   
@@ -1520,6 +1814,13 @@ void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHS(
   const int phi_handle,
   const int component)
 {
+  // compute RHS only at the narrow band points if the narrow band is used
+  // NOTE: the narrow band is only supported for codimension-one problems
+  if (d_use_narrow_band) {
+    computeLevelSetEquationRHSLocal(phi_handle, component);
+    return;
+  }
+
   int rhs_handle;
   if (level_set_fcn == PHI) {
     rhs_handle = d_rhs_phi_handle;
@@ -1966,12 +2267,1490 @@ void LevelSetFunctionIntegrator<DIM>::addNormalVelocityTermToLevelSetEquationRHS
 }
 
 
+/* buildNarrowBand() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::buildNarrowBand()
+{
+  // marks for the ghost cell layers of the narrow band, listed from
+  // the outermost layer inwards
+  const unsigned char ghostcell_layer_marks[3] = { LSM_NARROW_BAND_MARK_GB,
+                                                   LSM_NARROW_BAND_MARK_D1,
+                                                   LSM_NARROW_BAND_MARK_D2 };
+  const int num_ghostcell_layers = d_level_set_ghostcell_width[0];
+
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  d_narrow_band_data.resize(d_num_level_set_fcn_components);
+  for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
+
+    d_narrow_band_data[comp].resize(num_levels);
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+      Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
+      d_narrow_band_data[comp][ln].resize(level->getNumberOfPatches());
+
+      typename PatchLevel<DIM>::Iterator pi;
+      for (pi.initialize(level); pi; pi++) { // loop over patches
+        const int pn = *pi;
+        Pointer< Patch<DIM> > patch = level->getPatch(pn);
+        if ( patch.isNull() ) {
+          TBOX_ERROR(  d_object_name 
+                    << "::buildNarrowBand(): "
+                    << "Cannot find patch. Null patch pointer."
+                    << endl);
+        }
+
+        NarrowBandPatchData& nb = d_narrow_band_data[comp][ln][pn];
+
+        // get pointers to data and index space ranges
+        Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+          patch->getPatchData( d_phi_handles[0] );
+
+        Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+          patch->getPatchGeometry();
+#ifdef LSMLIB_DOUBLE_PRECISION
+        const double* dx = patch_geom->getDx();
+#else
+        const double* dx_double = patch_geom->getDx();
+        float dx[DIM];
+        for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
+#endif
+
+        Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+        const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
+        const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+
+        LSMLIB_REAL* phi = phi_data->getPointer(comp);
+        const int num_pts = phi_ghostbox.size();
+
+        // narrow band widths are specified in terms of the number of 
+        // grid cells
+        LSMLIB_REAL min_dx = dx[0];
+        for (int dim = 1; dim < DIM; dim++) {
+          if (dx[dim] < min_dx) min_dx = dx[dim];
+        }
+        LSMLIB_REAL width = d_narrow_band_width*min_dx;
+        LSMLIB_REAL width_inner = d_narrow_band_inner_width*min_dx;
+
+        // skip patches where min |phi| is not less than the narrow band
+        // width (the scan stops at the first narrow band point, so it 
+        // is cheap for patches that contain the zero level set) and 
+        // release their narrow band data
+        nb.empty = true;
+        for (int i = 0; i < num_pts; i++) {
+          if (fabs(phi[i]) < width) {
+            nb.empty = false;
+            break;
+          }
+        }
+        if (nb.empty) {
+          vector<unsigned char>().swap(nb.narrow_band);
+          for (int dim = 0; dim < DIM; dim++) {
+            vector<int>().swap(nb.index[dim]);
+          }
+          continue;
+        }
+
+        // the index arrays are determined in scratch space large enough
+        // to hold every point of the ghostbox, which is shared by all 
+        // patches
+        if (static_cast<int>(d_narrow_band_index_outer.size()) < num_pts) {
+          for (int dim = 0; dim < DIM; dim++) {
+            d_narrow_band_index[dim].resize(num_pts);
+          }
+          d_narrow_band_index_outer.resize(num_pts);
+        }
+        int* index[LSM_DIM_MAX];
+        for (int dim = 0; dim < DIM; dim++) {
+          index[dim] = &d_narrow_band_index[dim][0];
+        }
+        nb.narrow_band.resize(num_pts);
+        nb.n_lo.resize(d_narrow_band_level+1);
+        nb.n_hi.resize(d_narrow_band_level+1);
+        int nlo_index = 0;
+        int nhi_index = num_pts-1;
+        int nlo_index_outer_plus, nhi_index_outer_plus;
+        int nlo_index_outer_minus, nhi_index_outer_minus;
+
+        if (DIM == 3) {
+
+          LSM3D_DETERMINE_NARROW_BAND(
+            phi,
+            &phi_ghostbox_lower[0],
+            &phi_ghostbox_upper[0],
+            &phi_ghostbox_lower[1],
+            &phi_ghostbox_upper[1],
+            &phi_ghostbox_lower[2],
+            &phi_ghostbox_upper[2],
+            &nb.narrow_band[0],
+            &phi_ghostbox_lower[0],
+            &phi_ghostbox_upper[0],
+            &phi_ghostbox_lower[1],
+            &phi_ghostbox_upper[1],
+            &phi_ghostbox_lower[2],
+            &phi_ghostbox_upper[2],
+            index[0], index[1], index[2],
+            &nlo_index, &nhi_index,
+            &nb.n_lo[0], &nb.n_hi[0],
+            &d_narrow_band_index_outer[0],
+            &nlo_index, &nhi_index,
+            &nlo_index_outer_plus, &nhi_index_outer_plus,
+            &nlo_index_outer_minus, &nhi_index_outer_minus,
+            &width, &width_inner,
+            &d_narrow_band_level);
+
+        } else if (DIM == 2) {
+
+          LSM2D_DETERMINE_NARROW_BAND(
+            phi,
+            &phi_ghostbox_lower[0],
+            &phi_ghostbox_upper[0],
+            &phi_ghostbox_lower[1],
+            &phi_ghostbox_upper[1],
+            &nb.narrow_band[0],
+            &phi_ghostbox_lower[0],
+            &phi_ghostbox_upper[0],
+            &phi_ghostbox_lower[1],
+            &phi_ghostbox_upper[1],
+            index[0], index[1],
+            &nlo_index, &nhi_index,
+            &nb.n_lo[0], &nb.n_hi[0],
+            &d_narrow_band_index_outer[0],
+            &nlo_index, &nhi_index,
+            &nlo_index_outer_plus, &nhi_index_outer_plus,
+            &nlo_index_outer_minus, &nhi_index_outer_minus,
+            &width, &width_inner,
+            &d_narrow_band_level);
+
+        } else {  // Unsupported dimension
+          TBOX_ERROR(  d_object_name 
+                    << "::buildNarrowBand(): "
+                    << "Invalid value of DIM.  "
+                    << "Only DIM = 2 and 3 are supported."
+                    << endl);
+        } // end switch over dimension (DIM) of calculation
+
+        // copy the index arrays into storage sized to the narrow band
+        const int num_narrow_band_pts = nb.n_hi[d_narrow_band_level]+1;
+        for (int dim = 0; dim < DIM; dim++) {
+          vector<int>(index[dim], index[dim] + num_narrow_band_pts).swap(
+            nb.index[dim]);
+        }
+
+        // mark the ghost cell layers so that the narrow band kernels 
+        // only update the interior of the patch (innermost layer first 
+        // so that the outer layers take precedence at the corners)
+        for (int k = num_ghostcell_layers-1; k >= 0; k--) {
+          Box<DIM> layer_box = phi_ghostbox;
+          layer_box.grow(IntVector<DIM>(-k));
+          const IntVector<DIM> layer_box_lower = layer_box.lower();
+          const IntVector<DIM> layer_box_upper = layer_box.upper();
+
+          if (DIM == 3) {
+
+            LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(
+              &nb.narrow_band[0],
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              &layer_box_lower[0],
+              &layer_box_upper[0],
+              &layer_box_lower[1],
+              &layer_box_upper[1],
+              &layer_box_lower[2],
+              &layer_box_upper[2],
+              &ghostcell_layer_marks[k]);
+
+          } else if (DIM == 2) {
+
+            LSM2D_MARK_NARROW_BAND_BOUNDARY_LAYER(
+              &nb.narrow_band[0],
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &layer_box_lower[0],
+              &layer_box_upper[0],
+              &layer_box_lower[1],
+              &layer_box_upper[1],
+              &ghostcell_layer_marks[k]);
+
+          } else {  // Unsupported dimension
+            TBOX_ERROR(  d_object_name 
+                      << "::buildNarrowBand(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 2 and 3 are supported."
+                      << endl);
+          } // end switch over dimension (DIM) of calculation
+        }
+
+      } // end loop over patches in level
+    } // end loop over levels in hierarchy
+  } // end loop over level set function components
+}
+
+
+/* computeLevelSetEquationRHSLocal() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHSLocal(
+  const int phi_handle,
+  const int component)
+{
+  const unsigned char mark_fb = LSM_NARROW_BAND_MARK_FB;
+  const unsigned char mark_D1 = LSM_NARROW_BAND_MARK_D1;
+  const unsigned char mark_D2 = LSM_NARROW_BAND_MARK_D2;
+
+  const bool use_external_velocity = 
+    d_lsm_velocity_field_strategy->providesExternalVelocityField();
+  const bool use_normal_velocity = 
+    d_lsm_velocity_field_strategy->providesNormalVelocityField();
+
+  int velocity_handle = -1;
+  if (use_external_velocity) {
+    velocity_handle = d_lsm_velocity_field_strategy->
+      getExternalVelocityFieldPatchDataHandle(component);
+  }
+  int normal_velocity_handle = -1;
+  if (use_normal_velocity) {
+    normal_velocity_handle = d_lsm_velocity_field_strategy->
+      getNormalVelocityFieldPatchDataHandle(PHI, component);
+  }
+
+  // loop over PatchHierarchy and compute the RHS of the level set 
+  // equation at the narrow band points by calling Fortran routines
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
+    
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) { // loop over patches
+      const int pn = *pi;
+
+      // skip patches that do not contain any narrow band points
+      const NarrowBandPatchData& nb = d_narrow_band_data[component][ln][pn];
+      if (nb.empty) continue;
+
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  d_object_name 
+                  << "::computeLevelSetEquationRHSLocal(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      // get pointers to data and index space ranges
+      // NOTE: the narrow band and the undivided differences are defined
+      //       on the ghostbox of phi while the RHS and the spatial 
+      //       derivatives are only defined on the interior of the patch
+      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+        patch->getPatchData( phi_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+        patch->getPatchData( d_rhs_phi_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_plus_data =
+        patch->getPatchData( d_grad_phi_plus_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_minus_data =
+        patch->getPatchData( d_grad_phi_minus_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+        patch->getPatchData( d_narrow_band_D1_handle );
+
+      Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+        patch->getPatchGeometry();
+#ifdef LSMLIB_DOUBLE_PRECISION
+      const double* dx = patch_geom->getDx();
+#else
+      const double* dx_double = patch_geom->getDx();
+      float dx[DIM];
+      for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
+#endif
+
+      Box<DIM> ghostbox = phi_data->getGhostBox();
+      const IntVector<DIM> ghostbox_lower = ghostbox.lower();
+      const IntVector<DIM> ghostbox_upper = ghostbox.upper();
+
+      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+      Box<DIM> grad_ghostbox = grad_phi_plus_data->getGhostBox();
+      const IntVector<DIM> grad_ghostbox_lower = grad_ghostbox.lower();
+      const IntVector<DIM> grad_ghostbox_upper = grad_ghostbox.upper();
+
+      LSMLIB_REAL* phi = phi_data->getPointer(component);
+      LSMLIB_REAL* rhs = rhs_data->getPointer();
+      LSMLIB_REAL* grad_phi_plus[LSM_DIM_MAX];
+      LSMLIB_REAL* grad_phi_minus[LSM_DIM_MAX];
+      for (int dim = 0; dim < DIM; dim++) {
+        grad_phi_plus[dim] = grad_phi_plus_data->getPointer(dim);
+        grad_phi_minus[dim] = grad_phi_minus_data->getPointer(dim);
+      }
+      LSMLIB_REAL* D1 = D1_data->getPointer();
+      LSMLIB_REAL* D2 = 0;
+      if (d_spatial_derivative_order == 2) {
+        Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
+          patch->getPatchData( d_narrow_band_D2_handle );
+        D2 = D2_data->getPointer();
+      }
+
+      const int* index[LSM_DIM_MAX];
+      for (int dim = 0; dim < DIM; dim++) {
+        index[dim] = &nb.index[dim][0];
+      }
+      const unsigned char* narrow_band = &nb.narrow_band[0];
+
+      // zero out level set equation RHS at all narrow band points
+      if (DIM == 3) {
+
+        LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL(
+          rhs,
+          &rhs_ghostbox_lower[0],
+          &rhs_ghostbox_upper[0],
+          &rhs_ghostbox_lower[1],
+          &rhs_ghostbox_upper[1],
+          &rhs_ghostbox_lower[2],
+          &rhs_ghostbox_upper[2],
+          index[0], index[1], index[2],
+          &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+          narrow_band,
+          &ghostbox_lower[0],
+          &ghostbox_upper[0],
+          &ghostbox_lower[1],
+          &ghostbox_upper[1],
+          &ghostbox_lower[2],
+          &ghostbox_upper[2],
+          &mark_fb);
+
+      } else if (DIM == 2) {
+
+        LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL(
+          rhs,
+          &rhs_ghostbox_lower[0],
+          &rhs_ghostbox_upper[0],
+          &rhs_ghostbox_lower[1],
+          &rhs_ghostbox_upper[1],
+          index[0], index[1],
+          &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+          narrow_band,
+          &ghostbox_lower[0],
+          &ghostbox_upper[0],
+          &ghostbox_lower[1],
+          &ghostbox_upper[1],
+          &mark_fb);
+
+      } else {  // Unsupported dimension
+        TBOX_ERROR(  d_object_name 
+                  << "::computeLevelSetEquationRHSLocal(): "
+                  << "Invalid value of DIM.  "
+                  << "Only DIM = 2 and 3 are supported."
+                  << endl);
+      } // end switch over dimension (DIM) of calculation
+
+      // compute plus and minus spatial derivatives at the narrow band 
+      // points
+      if (use_external_velocity || use_normal_velocity) {
+
+        if (d_spatial_derivative_order == 1) {
+
+          if (DIM == 3) {
+
+            LSM3D_HJ_ENO1_LOCAL(
+              grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              &grad_ghostbox_lower[2],
+              &grad_ghostbox_upper[2],
+              grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              &grad_ghostbox_lower[2],
+              &grad_ghostbox_upper[2],
+              phi,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              D1,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &dx[0], &dx[1], &dx[2],
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[0],
+              &nb.n_lo[1], &nb.n_hi[1],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb, &mark_D1);
+
+          } else if (DIM == 2) {
+
+            LSM2D_HJ_ENO1_LOCAL(
+              grad_phi_plus[0], grad_phi_plus[1],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              grad_phi_minus[0], grad_phi_minus[1],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              phi,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              D1,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &dx[0], &dx[1],
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[0],
+              &nb.n_lo[1], &nb.n_hi[1],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb, &mark_D1);
+
+          } else {  // Unsupported dimension
+            TBOX_ERROR(  d_object_name 
+                      << "::computeLevelSetEquationRHSLocal(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 2 and 3 are supported."
+                      << endl);
+          } // end switch over dimension (DIM) of calculation
+
+        } else {  // d_spatial_derivative_order == 2
+
+          if (DIM == 3) {
+
+            LSM3D_HJ_ENO2_LOCAL(
+              grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              &grad_ghostbox_lower[2],
+              &grad_ghostbox_upper[2],
+              grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              &grad_ghostbox_lower[2],
+              &grad_ghostbox_upper[2],
+              phi,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              D1,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              D2,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &dx[0], &dx[1], &dx[2],
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[0],
+              &nb.n_lo[1], &nb.n_hi[1],
+              &nb.n_lo[2], &nb.n_hi[2],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb, &mark_D1, &mark_D2);
+
+          } else if (DIM == 2) {
+
+            LSM2D_HJ_ENO2_LOCAL(
+              grad_phi_plus[0], grad_phi_plus[1],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              grad_phi_minus[0], grad_phi_minus[1],
+              &grad_ghostbox_lower[0],
+              &grad_ghostbox_upper[0],
+              &grad_ghostbox_lower[1],
+              &grad_ghostbox_upper[1],
+              phi,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              D1,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              D2,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &dx[0], &dx[1],
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[0],
+              &nb.n_lo[1], &nb.n_hi[1],
+              &nb.n_lo[2], &nb.n_hi[2],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb, &mark_D1, &mark_D2);
+
+          } else {  // Unsupported dimension
+            TBOX_ERROR(  d_object_name 
+                      << "::computeLevelSetEquationRHSLocal(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 2 and 3 are supported."
+                      << endl);
+          } // end switch over dimension (DIM) of calculation
+
+        } // end switch over spatial derivative order
+
+      }
+
+      // add contribution of advection term to level set equation RHS
+      if (use_external_velocity) {
+
+        Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_upwind_data =
+          patch->getPatchData( d_grad_phi_upwind_handle );
+        Pointer< CellData<DIM,LSMLIB_REAL> > velocity_data =
+          patch->getPatchData( velocity_handle );
+
+        Box<DIM> vel_ghostbox = velocity_data->getGhostBox();
+        const IntVector<DIM> vel_ghostbox_lower = vel_ghostbox.lower();
+        const IntVector<DIM> vel_ghostbox_upper = vel_ghostbox.upper();
+
+        LSMLIB_REAL* grad_phi_upwind[LSM_DIM_MAX];
+        LSMLIB_REAL* vel[LSM_DIM_MAX];
+        for (int dim = 0; dim < DIM; dim++) {
+          grad_phi_upwind[dim] = grad_phi_upwind_data->getPointer(dim);
+          vel[dim] = velocity_data->getPointer(dim);
+        }
+
+        if (DIM == 3) {
+
+          LSM3D_SELECT_UPWIND_HJ_LOCAL(
+            grad_phi_upwind[0], grad_phi_upwind[1], grad_phi_upwind[2],
+            grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+            grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            &grad_ghostbox_lower[2],
+            &grad_ghostbox_upper[2],
+            vel[0], vel[1], vel[2],
+            &vel_ghostbox_lower[0],
+            &vel_ghostbox_upper[0],
+            &vel_ghostbox_lower[1],
+            &vel_ghostbox_upper[1],
+            &vel_ghostbox_lower[2],
+            &vel_ghostbox_upper[2],
+            index[0], index[1], index[2],
+            &nb.n_lo[0], &nb.n_hi[0],
+            narrow_band,
+            &ghostbox_lower[0],
+            &ghostbox_upper[0],
+            &ghostbox_lower[1],
+            &ghostbox_upper[1],
+            &ghostbox_lower[2],
+            &ghostbox_upper[2],
+            &mark_fb);
+
+          LSM3D_ADD_ADVECTION_TERM_TO_LSE_RHS_LOCAL(
+            rhs,
+            &rhs_ghostbox_lower[0],
+            &rhs_ghostbox_upper[0],
+            &rhs_ghostbox_lower[1],
+            &rhs_ghostbox_upper[1],
+            &rhs_ghostbox_lower[2],
+            &rhs_ghostbox_upper[2],
+            grad_phi_upwind[0], grad_phi_upwind[1], grad_phi_upwind[2],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            &grad_ghostbox_lower[2],
+            &grad_ghostbox_upper[2],
+            vel[0], vel[1], vel[2],
+            &vel_ghostbox_lower[0],
+            &vel_ghostbox_upper[0],
+            &vel_ghostbox_lower[1],
+            &vel_ghostbox_upper[1],
+            &vel_ghostbox_lower[2],
+            &vel_ghostbox_upper[2],
+            index[0], index[1], index[2],
+            &nb.n_lo[0], &nb.n_hi[0],
+            narrow_band,
+            &ghostbox_lower[0],
+            &ghostbox_upper[0],
+            &ghostbox_lower[1],
+            &ghostbox_upper[1],
+            &ghostbox_lower[2],
+            &ghostbox_upper[2],
+            &mark_fb);
+
+        } else if (DIM == 2) {
+
+          LSM2D_SELECT_UPWIND_HJ_LOCAL(
+            grad_phi_upwind[0], grad_phi_upwind[1],
+            grad_phi_plus[0], grad_phi_plus[1],
+            grad_phi_minus[0], grad_phi_minus[1],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            vel[0], vel[1],
+            &vel_ghostbox_lower[0],
+            &vel_ghostbox_upper[0],
+            &vel_ghostbox_lower[1],
+            &vel_ghostbox_upper[1],
+            index[0], index[1],
+            &nb.n_lo[0], &nb.n_hi[0],
+            narrow_band,
+            &ghostbox_lower[0],
+            &ghostbox_upper[0],
+            &ghostbox_lower[1],
+            &ghostbox_upper[1],
+            &mark_fb);
+
+          LSM2D_ADD_ADVECTION_TERM_TO_LSE_RHS_LOCAL(
+            rhs,
+            &rhs_ghostbox_lower[0],
+            &rhs_ghostbox_upper[0],
+            &rhs_ghostbox_lower[1],
+            &rhs_ghostbox_upper[1],
+            grad_phi_upwind[0], grad_phi_upwind[1],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            vel[0], vel[1],
+            &vel_ghostbox_lower[0],
+            &vel_ghostbox_upper[0],
+            &vel_ghostbox_lower[1],
+            &vel_ghostbox_upper[1],
+            index[0], index[1],
+            &nb.n_lo[0], &nb.n_hi[0],
+            narrow_band,
+            &ghostbox_lower[0],
+            &ghostbox_upper[0],
+            &ghostbox_lower[1],
+            &ghostbox_upper[1],
+            &mark_fb);
+
+        } else {  // Unsupported dimension
+          TBOX_ERROR(  d_object_name 
+                    << "::computeLevelSetEquationRHSLocal(): "
+                    << "Invalid value of DIM.  "
+                    << "Only DIM = 2 and 3 are supported."
+                    << endl);
+        } // end switch over dimension (DIM) of calculation
+
+      }
+
+      // add contribution of normal velocity term to level set equation RHS
+      if (use_normal_velocity) {
+
+        Pointer< CellData<DIM,LSMLIB_REAL> > normal_velocity_data =
+          patch->getPatchData( normal_velocity_handle );
+
+        Box<DIM> vel_n_ghostbox = normal_velocity_data->getGhostBox();
+        const IntVector<DIM> vel_n_ghostbox_lower = vel_n_ghostbox.lower();
+        const IntVector<DIM> vel_n_ghostbox_upper = vel_n_ghostbox.upper();
+
+        LSMLIB_REAL* vel_n = normal_velocity_data->getPointer();
+
+        if (DIM == 3) {
+
+          LSM3D_ADD_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
+            rhs,
+            &rhs_ghostbox_lower[0],
+            &rhs_ghostbox_upper[0],
+            &rhs_ghostbox_lower[1],
+            &rhs_ghostbox_upper[1],
+            &rhs_ghostbox_lower[2],
+            &rhs_ghostbox_upper[2],
+            grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            &grad_ghostbox_lower[2],
+            &grad_ghostbox_upper[2],
+            grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            &grad_ghostbox_lower[2],
+            &grad_ghostbox_upper[2],
+            vel_n,
+            &vel_n_ghostbox_lower[0],
+            &vel_n_ghostbox_upper[0],
+            &vel_n_ghostbox_lower[1],
+            &vel_n_ghostbox_upper[1],
+            &vel_n_ghostbox_lower[2],
+            &vel_n_ghostbox_upper[2],
+            index[0], index[1], index[2],
+            &nb.n_lo[0], &nb.n_hi[0],
+            narrow_band,
+            &ghostbox_lower[0],
+            &ghostbox_upper[0],
+            &ghostbox_lower[1],
+            &ghostbox_upper[1],
+            &ghostbox_lower[2],
+            &ghostbox_upper[2],
+            &mark_fb);
+
+        } else if (DIM == 2) {
+
+          LSM2D_ADD_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
+            rhs,
+            &rhs_ghostbox_lower[0],
+            &rhs_ghostbox_upper[0],
+            &rhs_ghostbox_lower[1],
+            &rhs_ghostbox_upper[1],
+            grad_phi_plus[0], grad_phi_plus[1],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            grad_phi_minus[0], grad_phi_minus[1],
+            &grad_ghostbox_lower[0],
+            &grad_ghostbox_upper[0],
+            &grad_ghostbox_lower[1],
+            &grad_ghostbox_upper[1],
+            vel_n,
+            &vel_n_ghostbox_lower[0],
+            &vel_n_ghostbox_upper[0],
+            &vel_n_ghostbox_lower[1],
+            &vel_n_ghostbox_upper[1],
+            index[0], index[1],
+            &nb.n_lo[0], &nb.n_hi[0],
+            narrow_band,
+            &ghostbox_lower[0],
+            &ghostbox_upper[0],
+            &ghostbox_lower[1],
+            &ghostbox_upper[1],
+            &mark_fb);
+
+        } else {  // Unsupported dimension
+          TBOX_ERROR(  d_object_name 
+                    << "::computeLevelSetEquationRHSLocal(): "
+                    << "Invalid value of DIM.  "
+                    << "Only DIM = 2 and 3 are supported."
+                    << endl);
+        } // end switch over dimension (DIM) of calculation
+
+      }
+
+      // multiply the RHS by the cut-off function of the localized level 
+      // set method (cut-off widths are in physical units)
+      LSMLIB_REAL min_dx = dx[0];
+      for (int dim = 1; dim < DIM; dim++) {
+        if (dx[dim] < min_dx) min_dx = dx[dim];
+      }
+      LSMLIB_REAL beta = d_narrow_band_inner_width*min_dx;
+      LSMLIB_REAL gamma = d_narrow_band_width*min_dx;
+
+      if (DIM == 3) {
+
+        LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_FB_LOCAL(
+          phi,
+          &ghostbox_lower[0],
+          &ghostbox_upper[0],
+          &ghostbox_lower[1],
+          &ghostbox_upper[1],
+          &ghostbox_lower[2],
+          &ghostbox_upper[2],
+          rhs,
+          &rhs_ghostbox_lower[0],
+          &rhs_ghostbox_upper[0],
+          &rhs_ghostbox_lower[1],
+          &rhs_ghostbox_upper[1],
+          &rhs_ghostbox_lower[2],
+          &rhs_ghostbox_upper[2],
+          index[0], index[1], index[2],
+          &nb.n_lo[0], &nb.n_hi[0],
+          narrow_band,
+          &ghostbox_lower[0],
+          &ghostbox_upper[0],
+          &ghostbox_lower[1],
+          &ghostbox_upper[1],
+          &ghostbox_lower[2],
+          &ghostbox_upper[2],
+          &mark_fb,
+          &beta, &gamma);
+
+      } else if (DIM == 2) {
+
+        LSM2D_MULTIPLY_CUT_OFF_LSE_RHS_FB_LOCAL(
+          phi,
+          &ghostbox_lower[0],
+          &ghostbox_upper[0],
+          &ghostbox_lower[1],
+          &ghostbox_upper[1],
+          rhs,
+          &rhs_ghostbox_lower[0],
+          &rhs_ghostbox_upper[0],
+          &rhs_ghostbox_lower[1],
+          &rhs_ghostbox_upper[1],
+          index[0], index[1],
+          &nb.n_lo[0], &nb.n_hi[0],
+          narrow_band,
+          &ghostbox_lower[0],
+          &ghostbox_upper[0],
+          &ghostbox_lower[1],
+          &ghostbox_upper[1],
+          &mark_fb,
+          &beta, &gamma);
+
+      } else {  // Unsupported dimension
+        TBOX_ERROR(  d_object_name 
+                  << "::computeLevelSetEquationRHSLocal(): "
+                  << "Invalid value of DIM.  "
+                  << "Only DIM = 2 and 3 are supported."
+                  << endl);
+      } // end switch over dimension (DIM) of calculation
+
+    } // end loop over patches in level
+  } // end loop over levels in hierarchy
+}
+
+
+/* advanceLevelSetEqnStageLocal() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnStageLocal(
+  const TVD_RK_STAGE_TYPE stage,
+  const int u_out_handle,
+  const int u_in_handle,
+  const int u_cur_handle,
+  const LSMLIB_REAL dt,
+  const int component)
+{
+  const unsigned char mark_fb = LSM_NARROW_BAND_MARK_FB;
+
+  // loop over PatchHierarchy and carry out the TVD Runge-Kutta stage 
+  // at the narrow band points by calling Fortran routines
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
+    
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) { // loop over patches
+      const int pn = *pi;
+
+      // skip patches that do not contain any narrow band points
+      const NarrowBandPatchData& nb = d_narrow_band_data[component][ln][pn];
+      if (nb.empty) continue;
+
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  d_object_name 
+                  << "::advanceLevelSetEqnStageLocal(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      // get pointers to data and index space ranges
+      Pointer< CellData<DIM,LSMLIB_REAL> > u_out_data =
+        patch->getPatchData( u_out_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > u_in_data =
+        patch->getPatchData( u_in_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+        patch->getPatchData( d_rhs_phi_handle );
+
+      Box<DIM> ghostbox = u_out_data->getGhostBox();
+      const IntVector<DIM> ghostbox_lower = ghostbox.lower();
+      const IntVector<DIM> ghostbox_upper = ghostbox.upper();
+
+      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+      LSMLIB_REAL* u_out = u_out_data->getPointer(component);
+      LSMLIB_REAL* u_in = u_in_data->getPointer(component);
+      LSMLIB_REAL* u_cur = u_in;
+      if (u_cur_handle >= 0) {
+        Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+          patch->getPatchData( u_cur_handle );
+        u_cur = u_cur_data->getPointer(component);
+      }
+      LSMLIB_REAL* rhs = rhs_data->getPointer();
+
+      const int* index[LSM_DIM_MAX];
+      for (int dim = 0; dim < DIM; dim++) {
+        index[dim] = &nb.index[dim][0];
+      }
+      const unsigned char* narrow_band = &nb.narrow_band[0];
+
+      if (DIM == 3) {
+
+        switch (stage) {
+          case RK1_STEP: {
+            LSM3D_RK1_STEP_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &rhs_ghostbox_lower[2],
+              &rhs_ghostbox_upper[2],
+              &dt,
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK2_STAGE1: {
+            LSM3D_TVD_RK2_STAGE1_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &rhs_ghostbox_lower[2],
+              &rhs_ghostbox_upper[2],
+              &dt,
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK2_STAGE2: {
+            LSM3D_TVD_RK2_STAGE2_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &rhs_ghostbox_lower[2],
+              &rhs_ghostbox_upper[2],
+              &dt,
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK3_STAGE1: {
+            LSM3D_TVD_RK3_STAGE1_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &rhs_ghostbox_lower[2],
+              &rhs_ghostbox_upper[2],
+              &dt,
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK3_STAGE2: {
+            LSM3D_TVD_RK3_STAGE2_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &rhs_ghostbox_lower[2],
+              &rhs_ghostbox_upper[2],
+              &dt,
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb);
+            break;
+          }
+          case LOW_STORAGE_TVD_RK3_STAGE2: {
+            LSM3D_LOW_STORAGE_TVD_RK3_STAGE2_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &rhs_ghostbox_lower[2],
+              &rhs_ghostbox_upper[2],
+              &dt,
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK3_STAGE3: {
+            LSM3D_TVD_RK3_STAGE3_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &rhs_ghostbox_lower[2],
+              &rhs_ghostbox_upper[2],
+              &dt,
+              index[0], index[1], index[2],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &ghostbox_lower[2],
+              &ghostbox_upper[2],
+              &mark_fb);
+            break;
+          }
+          default: {
+            TBOX_ERROR(  d_object_name 
+                      << "::advanceLevelSetEqnStageLocal(): "
+                      << "Unsupported TVD Runge-Kutta stage."
+                      << endl);
+          }
+        } // end switch over TVD Runge-Kutta stage
+
+      } else if (DIM == 2) {
+
+        switch (stage) {
+          case RK1_STEP: {
+            LSM2D_RK1_STEP_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &dt,
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK2_STAGE1: {
+            LSM2D_TVD_RK2_STAGE1_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &dt,
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK2_STAGE2: {
+            LSM2D_TVD_RK2_STAGE2_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &dt,
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK3_STAGE1: {
+            LSM2D_TVD_RK3_STAGE1_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &dt,
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK3_STAGE2: {
+            LSM2D_TVD_RK3_STAGE2_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &dt,
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb);
+            break;
+          }
+          case LOW_STORAGE_TVD_RK3_STAGE2: {
+            LSM2D_LOW_STORAGE_TVD_RK3_STAGE2_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &dt,
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb);
+            break;
+          }
+          case TVD_RK3_STAGE3: {
+            LSM2D_TVD_RK3_STAGE3_LOCAL(
+              u_out,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_in,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              u_cur,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              rhs,
+              &rhs_ghostbox_lower[0],
+              &rhs_ghostbox_upper[0],
+              &rhs_ghostbox_lower[1],
+              &rhs_ghostbox_upper[1],
+              &dt,
+              index[0], index[1],
+              &nb.n_lo[0], &nb.n_hi[d_narrow_band_level],
+              narrow_band,
+              &ghostbox_lower[0],
+              &ghostbox_upper[0],
+              &ghostbox_lower[1],
+              &ghostbox_upper[1],
+              &mark_fb);
+            break;
+          }
+          default: {
+            TBOX_ERROR(  d_object_name 
+                      << "::advanceLevelSetEqnStageLocal(): "
+                      << "Unsupported TVD Runge-Kutta stage."
+                      << endl);
+          }
+        } // end switch over TVD Runge-Kutta stage
+
+      } else {  // Unsupported dimension
+        TBOX_ERROR(  d_object_name 
+                  << "::advanceLevelSetEqnStageLocal(): "
+                  << "Invalid value of DIM.  "
+                  << "Only DIM = 2 and 3 are supported."
+                  << endl);
+      } // end switch over dimension (DIM) of calculation
+
+    } // end loop over patches in level
+  } // end loop over levels in hierarchy
+}
+
+
 /* reinitializeLevelSetFunctions() */
 template <int DIM> 
 void LevelSetFunctionIntegrator<DIM>::reinitializeLevelSetFunctions(
   const LEVEL_SET_FCN_TYPE level_set_fcn,
   const int max_iterations)
 {
+  // the ghost cells of the level set functions are not reinitialized
+  d_level_set_ghostcells_filled = false;
+
   if (level_set_fcn == PHI) {
     for (int comp=0; comp < d_num_level_set_fcn_components; comp++) {
       d_phi_reinitialization_alg->
@@ -2001,6 +3780,9 @@ void LevelSetFunctionIntegrator<DIM>::orthogonalizeLevelSetFunctions(
   const int max_reinit_iterations,
   const int max_ortho_iterations)
 {
+  // the ghost cells of the level set functions are not orthogonalized
+  d_level_set_ghostcells_filled = false;
+
   if (level_set_fcn == PHI) {
     reinitializeLevelSetFunctions(PSI, max_reinit_iterations);
     for (int comp=0; comp < d_num_level_set_fcn_components; comp++) {
@@ -2054,6 +3836,13 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
               << endl );
   }
 
+  // the narrow band kernels use one extra ghost cell to hold the 
+  // undivided differences used to compute the spatial derivatives 
+  if (d_use_narrow_band) {
+    scratch_ghostcell_width++;
+    d_narrow_band_level = scratch_ghostcell_width;
+  }
+
   d_level_set_ghostcell_width = IntVector<DIM>(scratch_ghostcell_width);
   IntVector<DIM> zero_ghostcell_width(0);
 
@@ -2097,7 +3886,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
   }
  
   // reserve memory for scratch variable PatchData Handles
-  d_phi_handles.reserve(d_tvd_runge_kutta_order);
+  d_phi_handles.reserve(d_num_time_advance_buffers);
 
   // phi - "CURRENT" context for time advance
   d_phi_handles[0] = var_db->registerVariableAndContext(
@@ -2105,7 +3894,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
   d_solution_variables.setFlag(d_phi_handles[0]);
 
   // phi - "SCRATCH" context for time advance
-  for (int k=1; k < d_tvd_runge_kutta_order; k++) {
+  for (int k=1; k < d_num_time_advance_buffers; k++) {
     stringstream context_name("");
     context_name << "TVD_RK_SCRATCH_" << k;
     d_phi_handles[k] = var_db->registerVariableAndContext(
@@ -2127,6 +3916,13 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
     grad_phi_variable, plus_context, zero_ghostcell_width);
   d_grad_phi_minus_handle = var_db->registerVariableAndContext(
     grad_phi_variable, minus_context, zero_ghostcell_width);
+  if ( d_use_narrow_band &&
+       d_lsm_velocity_field_strategy->providesExternalVelocityField() ) {
+    // NOTE: the upwind grad(phi) is selected from the forward and 
+    //       backward grad(phi) at narrow band points 
+    d_time_advance_scratch_variables.setFlag(d_grad_phi_plus_handle);
+    d_time_advance_scratch_variables.setFlag(d_grad_phi_minus_handle);
+  }
   if (d_lsm_velocity_field_strategy->providesNormalVelocityField()) {
     d_compute_stable_dt_scratch_variables.setFlag(d_grad_phi_plus_handle);
     d_compute_stable_dt_scratch_variables.setFlag(d_grad_phi_minus_handle);
@@ -2150,12 +3946,39 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
     rhs_phi_variable, scratch_context, zero_ghostcell_width);
   d_time_advance_scratch_variables.setFlag(d_rhs_phi_handle);
 
+  // undivided differences for narrow band spatial derivatives 
+  if (d_use_narrow_band) {
+    Pointer< CellVariable<DIM,LSMLIB_REAL> > D1_variable;
+    if (var_db->checkVariableExists("D1 (LSMLIB)")) {
+      D1_variable = var_db->getVariable("D1 (LSMLIB)");
+    } else {
+      D1_variable = new CellVariable<DIM,LSMLIB_REAL>("D1 (LSMLIB)", 1);
+    }
+    Pointer< CellVariable<DIM,LSMLIB_REAL> > D2_variable;
+    if (var_db->checkVariableExists("D2 (LSMLIB)")) {
+      D2_variable = var_db->getVariable("D2 (LSMLIB)");
+    } else {
+      D2_variable = new CellVariable<DIM,LSMLIB_REAL>("D2 (LSMLIB)", 1);
+    }
+    Pointer<VariableContext> narrow_band_context = 
+      var_db->getContext("NARROW_BAND_SCRATCH");
+
+    d_narrow_band_D1_handle = var_db->registerVariableAndContext(
+      D1_variable, narrow_band_context, d_level_set_ghostcell_width);
+    d_time_advance_scratch_variables.setFlag(d_narrow_band_D1_handle);
+    if (d_spatial_derivative_order == 2) {
+      d_narrow_band_D2_handle = var_db->registerVariableAndContext(
+        D2_variable, narrow_band_context, d_level_set_ghostcell_width);
+      d_time_advance_scratch_variables.setFlag(d_narrow_band_D2_handle);
+    }
+  }
+
 
   /* 
    * Initialize psi variables for codimension-two problems
    */
   // reserve memory for scratch variable PatchData Handles
-  d_psi_handles.reserve(d_tvd_runge_kutta_order);
+  d_psi_handles.reserve(d_num_time_advance_buffers);
 
   if (d_codimension == 2) {
 
@@ -2181,7 +4004,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
     d_solution_variables.setFlag(d_psi_handles[0]);
 
     // psi - "SCRATCH" context for time advance
-    for (int k=1; k < d_tvd_runge_kutta_order; k++) {
+    for (int k=1; k < d_num_time_advance_buffers; k++) {
       stringstream context_name("");
       context_name << "TVD_RK_SCRATCH_" << k;
       d_psi_handles[k] = var_db->registerVariableAndContext(
@@ -2228,7 +4051,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
 
   } else { // set PatchData handles for filling psi scratch data to -1 
            // (a bogus value)
-    for (int k=0; k < d_tvd_runge_kutta_order; k++) 
+    for (int k=0; k < d_num_time_advance_buffers; k++) 
       d_psi_handles[k] = -1;
   }
 
@@ -2245,6 +4068,25 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
     control_volume, current_context, zero_ghostcell_width);
   d_persistent_variables.setFlag(d_control_volume_handle);
 
+  /*
+   * Initialize copies of phi and psi used to detect when a regrid is
+   * needed (adaptive regridding only)
+   */
+  if (d_use_adaptive_regridding) {
+    Pointer<VariableContext> regrid_reference_context = 
+      var_db->getContext("REGRID_REFERENCE");
+    d_phi_regrid_reference_handle = var_db->registerVariableAndContext(
+      phi_variable, regrid_reference_context, zero_ghostcell_width);
+    d_persistent_variables.setFlag(d_phi_regrid_reference_handle);
+    if (d_codimension == 2) {
+      Pointer< CellVariable<DIM,LSMLIB_REAL> > psi_variable = 
+        var_db->getVariable("psi (LSMLIB)");
+      d_psi_regrid_reference_handle = var_db->registerVariableAndContext(
+        psi_variable, regrid_reference_context, zero_ghostcell_width);
+      d_persistent_variables.setFlag(d_psi_regrid_reference_handle);
+    }
+  }
+
   /*
    * Register phi, psi, and control volume as restart PatchData items.
    */
@@ -2298,10 +4140,10 @@ void LevelSetFunctionIntegrator<DIM>::initializeCommunicationObjects()
 
   // set up objects for filling boundary data during the 
   // time advance of the level set functions
-  d_fill_bdry_time_advance.resizeArray(d_tvd_runge_kutta_order);
-  d_fill_bdry_sched_time_advance.resizeArray(d_tvd_runge_kutta_order);
+  d_fill_bdry_time_advance.resizeArray(d_num_time_advance_buffers);
+  d_fill_bdry_sched_time_advance.resizeArray(d_num_time_advance_buffers);
 
-  for (int k = 0; k < d_tvd_runge_kutta_order; k++) {
+  for (int k = 0; k < d_num_time_advance_buffers; k++) {
     d_fill_bdry_time_advance[k] = new RefineAlgorithm<DIM>;
 
     // empty out the boundary bdry fill schedules 
@@ -2462,6 +4304,31 @@ void LevelSetFunctionIntegrator<DIM>::getFromInput(
     d_orthogonalization_max_iters = LSM_DEFAULT_ORTHOGONALIZATION_MAX_ITERS;
   }
 
+  // get reinitialization communication parameters (never read from 
+  // restart)
+  d_reinitialization_ghostcell_exchange_interval = db->getIntegerWithDefault(
+    "reinitialization_ghostcell_exchange_interval", 
+    LSM_DEFAULT_GHOSTCELL_EXCHANGE_INTERVAL);
+  d_reinitialization_convergence_check_interval = db->getIntegerWithDefault(
+    "reinitialization_convergence_check_interval", 
+    LSM_DEFAULT_CONVERGENCE_CHECK_INTERVAL);
+  d_reinitialization_batch_ghostcell_fills = db->getBoolWithDefault(
+    "reinitialization_batch_ghostcell_fills", 
+    LSM_DEFAULT_BATCH_GHOSTCELL_FILLS);
+
+  // get persistent scratch data flag (never read from restart)
+  d_use_persistent_scratch_data = db->getBoolWithDefault(
+    "use_persistent_scratch_data", LSM_DEFAULT_USE_PERSISTENT_SCRATCH_DATA);
+
+  // get low-storage Runge-Kutta flag (never read from restart)
+  d_use_low_storage_runge_kutta = db->getBoolWithDefault(
+    "use_low_storage_runge_kutta", LSM_DEFAULT_USE_LOW_STORAGE_RUNGE_KUTTA);
+
+  // get redundant ghost cell fill flag (never read from restart)
+  d_skip_redundant_ghostcell_fills = db->getBoolWithDefault(
+    "skip_redundant_ghostcell_fills", 
+    LSM_DEFAULT_SKIP_REDUNDANT_GHOSTCELL_FILLS);
+
   // get verbose mode
   if (is_from_restart) {
     if (db->keyExists("verbose_mode")) d_verbose_mode = 
@@ -2581,8 +4448,66 @@ void LevelSetFunctionIntegrator<DIM>::getFromInput(
       LSM_DEFAULT_TAG_BUFFER_WIDTH);
     d_refinement_cutoff_value = db->getDoubleWithDefault(
       "refinement_cutoff_value", LSM_DEFAULT_REFINEMENT_CUTOFF_VALUE);
+    d_use_adaptive_regridding = db->getBoolWithDefault(
+      "use_adaptive_regridding", LSM_DEFAULT_USE_ADAPTIVE_REGRIDDING);
+    d_regrid_buffer_fraction = db->getDoubleWithDefault(
+      "regrid_buffer_fraction", LSM_DEFAULT_REGRID_BUFFER_FRACTION);
+    if (d_use_adaptive_regridding && (d_regrid_buffer_fraction <= 0.0)) {
+      TBOX_ERROR(  d_object_name
+                << "::getFromInput(): "
+                << "regrid_buffer_fraction must be positive."
+                << endl );
+    }
+
+    // read in narrow band parameters
+    d_use_narrow_band = db->getBoolWithDefault("use_narrow_band", 
+      LSM_DEFAULT_USE_NARROW_BAND);
+    d_narrow_band_width = db->getDoubleWithDefault("narrow_band_width", 
+      LSM_DEFAULT_NARROW_BAND_WIDTH);
+    d_narrow_band_inner_width = db->getDoubleWithDefault(
+      "narrow_band_inner_width", LSM_DEFAULT_NARROW_BAND_INNER_WIDTH);
+
+    // check that the narrow band can be used for this calculation
+    if (d_use_narrow_band) {
+      if ( (DIM != 2) && (DIM != 3) ) {
+        TBOX_ERROR(d_object_name 
+                << "::getFromInput(): "
+                << "Narrow band only supported for DIM = 2 and 3."
+                << endl );
+      }
+      if ( (d_spatial_derivative_type != ENO) ||
+           (d_spatial_derivative_order > 2) ) {
+        TBOX_ERROR(d_object_name 
+                << "::getFromInput(): "
+                << "Narrow band only supported for ENO1 and ENO2 "
+                << "spatial derivatives."
+                << endl );
+      }
+      if (d_codimension != 1) {
+        TBOX_ERROR(d_object_name 
+                << "::getFromInput(): "
+                << "Narrow band only supported for codimension-one "
+                << "problems."
+                << endl );
+      }
+      if ( (d_narrow_band_inner_width <= 0.0) ||
+           (d_narrow_band_inner_width >= d_narrow_band_width) ) {
+        TBOX_ERROR(d_object_name 
+                << "::getFromInput(): "
+                << "narrow_band_inner_width must be positive and "
+                << "smaller than narrow_band_width."
+                << endl );
+      }
+    }
   } // end case (NOT FROM RESTART)
 
+  // the low-storage form of TVD-RK3 reuses the PatchData for the
+  // first stage to store the second stage
+  d_num_time_advance_buffers = d_tvd_runge_kutta_order;
+  if (d_use_low_storage_runge_kutta && (d_tvd_runge_kutta_order == 3)) {
+    d_num_time_advance_buffers = 2;
+  }
+
 }
 
 
@@ -2645,6 +4570,19 @@ void LevelSetFunctionIntegrator<DIM>::getFromRestart()
   d_regrid_interval = db->getInteger("d_regrid_interval");
   d_tag_buffer_width = db->getInteger("d_tag_buffer_width");
   d_refinement_cutoff_value = db->getDouble("d_refinement_cutoff_value");
+  d_use_adaptive_regridding = db->getBoolWithDefault(
+    "d_use_adaptive_regridding", LSM_DEFAULT_USE_ADAPTIVE_REGRIDDING);
+  d_regrid_buffer_fraction = db->getDoubleWithDefault(
+    "d_regrid_buffer_fraction", LSM_DEFAULT_REGRID_BUFFER_FRACTION);
+
+  // NOTE: restart files written before the narrow band parameters were 
+  //       added do not contain them
+  d_use_narrow_band = db->getBoolWithDefault("d_use_narrow_band", 
+    LSM_DEFAULT_USE_NARROW_BAND);
+  d_narrow_band_width = db->getDoubleWithDefault("d_narrow_band_width", 
+    LSM_DEFAULT_NARROW_BAND_WIDTH);
+  d_narrow_band_inner_width = db->getDoubleWithDefault(
+    "d_narrow_band_inner_width", LSM_DEFAULT_NARROW_BAND_INNER_WIDTH);
 
   d_verbose_mode = db->getBool("d_verbose_mode");
 
@@ -73,6 +73,23 @@
  * - reinitialization_max_iters  = maximum number of time steps to take
  *                                 during the reinitialization process
  *                                 (default = 20)
+ * - reinitialization_ghostcell_exchange_interval
+ *                               = number of reinitialization iterations
+ *                                 between ghost cell exchanges (0 to fill
+ *                                 ghost cells before every stage).  See
+ *                                 ReinitializationAlgorithm.
+ *                                 (default = 0)
+ * - reinitialization_convergence_check_interval
+ *                               = number of reinitialization iterations
+ *                                 between evaluations of 
+ *                                 reinitialization_stop_tol (default = 1)
+ * - reinitialization_batch_ghostcell_fills
+ *                               = TRUE if all components of a vector 
+ *                                 level set function should share the
+ *                                 ghost cell exchanges during 
+ *                                 reinitialization.  See 
+ *                                 ReinitializationAlgorithm.
+ *                                 (default = FALSE)
  * - orthogonalization_interval  = interval between orthogonalizing phi
  *                                 and psi for codimension-two problems
  *                                 (default = 10)
@@ -160,9 +177,51 @@
  *                                 (default = 2)
  * - refinement_cutoff_value     = cutoff value for distance function
  *                                 (default = 1.0)
+ * - use_adaptive_regridding     = TRUE if the PatchHierarchy should be
+ *                                 regridded when the zero level set has
+ *                                 moved a significant fraction of the
+ *                                 tag buffer instead of every 
+ *                                 regrid_interval time steps
+ *                                 (default = FALSE)
+ * - regrid_buffer_fraction      = fraction of the tag buffer width that
+ *                                 the zero level set may move before a
+ *                                 regrid is requested.  Only used when
+ *                                 use_adaptive_regridding is TRUE.
+ *                                 (default = 0.5)
+ *
+ * <h4> Narrow Band Parameters: </h4>
+ *
+ * - use_narrow_band             = TRUE if the level set equation should only
+ *                                 be advanced in a narrow band around the
+ *                                 zero level set (localized level set 
+ *                                 method of Peng et al. '99)
+ *                                 (default = FALSE)
+ * - narrow_band_width           = half-width of the narrow band measured in
+ *                                 grid cells (default = 4.0)
+ * - narrow_band_inner_width     = half-width of the inner part of the 
+ *                                 narrow band, where the right-hand side
+ *                                 of the level set equation is not cut 
+ *                                 off, measured in grid cells 
+ *                                 (default = 2.0)
  *
  * <h4> Miscellaneous Parameters: </h4>
  *
+ * - use_low_storage_runge_kutta = TRUE if the TVD-RK3 time advance 
+ *                                 should use the low-storage form, which
+ *                                 keeps only one scratch copy of the 
+ *                                 level set functions (default = FALSE)
+ * - use_persistent_scratch_data = TRUE if the scratch PatchData used
+ *                                 for the time advance, the computation
+ *                                 of the stable time step and 
+ *                                 reinitialization should be kept 
+ *                                 allocated between time steps 
+ *                                 (default = FALSE)
+ * - skip_redundant_ghostcell_fills
+ *                               = TRUE if computeStableDt() should not 
+ *                                 refill the ghost cells of the level 
+ *                                 set functions when they are still 
+ *                                 current from the end of the previous 
+ *                                 time step (default = FALSE)
  * - verbose_mode                = TRUE if status should be output during
  *                                 integration (default = FALSE)
  *
@@ -234,6 +293,71 @@
  *      boundary condition will be overwritten by specified boundary
  *      condition type.
  *
+ *  - When use_adaptive_regridding is TRUE, a copy of the level set 
+ *    functions is saved whenever the PatchHierarchy configuration is 
+ *    reset.  After each time step, the displacement of the zero level 
+ *    set since the last regrid is estimated by the max norm of the 
+ *    change in the level set functions over the cells where 
+ *    |phi| < refinement_cutoff_value at the last regrid (i.e. the cells
+ *    that were tagged for refinement).  A regrid is only requested 
+ *    when this displacement exceeds regrid_buffer_fraction times the 
+ *    width of the tag buffer (tag_buffer_width cells on the level that 
+ *    was tagged to create the finest level), so no time is spent 
+ *    regridding while the zero level set is still well inside the 
+ *    refined region.  regrid_interval is ignored.  The estimate 
+ *    assumes that the level set functions are approximately distance 
+ *    functions near the zero level set.
+ *
+ *  - When use_persistent_scratch_data is TRUE, the scratch PatchData is
+ *    allocated by resetHierarchyConfiguration() (i.e. whenever the 
+ *    PatchHierarchy is regridded) instead of at the beginning and end 
+ *    of every call to computeStableDt(), advanceLevelSetFunctions() and 
+ *    reinitializeLevelSetFunctions().  This removes the allocation 
+ *    overhead for PatchHierarchies with many small patches at the cost 
+ *    of keeping the scratch PatchData resident in memory.  The amount 
+ *    of memory is reported by getPersistentScratchDataBytes().  This 
+ *    parameter is not stored in restart files.
+ *
+ *  - When use_low_storage_runge_kutta is TRUE, the second stage of 
+ *    the TVD-RK3 time advance overwrites the first stage approximation
+ *    (see LevelSetMethodToolbox::LowStorageTVDRK3Stage2()), so only 
+ *    one scratch PatchData for phi (and psi) is allocated instead of 
+ *    two.  The arithmetic is the same as for the standard form, so the 
+ *    results are identical.  Because the components of a vector level 
+ *    set function are advanced one at a time, the velocity field for 
+ *    each component must not depend on the other components of the 
+ *    level set functions.  TVD-RK1 and TVD-RK2 already use the minimum 
+ *    amount of scratch data, so this parameter has no effect on them.  
+ *    This parameter is not stored in restart files.
+ *
+ *  - When skip_redundant_ghostcell_fills is TRUE, the ghost cells of 
+ *    phi (and psi) filled at the end of advanceLevelSetFunctions() are 
+ *    reused by the next call to computeStableDt() instead of being 
+ *    exchanged again, which removes one of the tvd_runge_kutta_order+1 
+ *    ghost cell exchanges per time step.  The ghost cells are refilled 
+ *    after the level set functions are reinitialized, orthogonalized, 
+ *    regridded or when the boundary conditions are changed.  Code that 
+ *    modifies the level set functions directly (through their PatchData
+ *    handles) between time steps must call 
+ *    markLevelSetFunctionsModified().  This option only removes 
+ *    redundant exchanges; it does NOT overlap the ghost cell exchanges
+ *    with computation.  The TVD Runge-Kutta stages still wait for 
+ *    each exchange to complete before computing the RHS because 
+ *    RefineSchedule::fillData() is a blocking call.
+ *
+ *  - When use_narrow_band is TRUE, the narrow band is rebuilt on each
+ *    patch from the current level set function at the start of every 
+ *    time step.  Only the narrow band points are updated during the 
+ *    time step, and patches that do not intersect the narrow band are
+ *    skipped entirely (no narrow band storage is held for them).  The
+ *    RHS and the spatial derivatives are only allocated on the
+ *    interior of each patch.  The narrow band is only supported for
+ *    codimension-one problems in two and three dimensions with ENO1 
+ *    or ENO2 spatial derivatives.  Reinitialization (which is 
+ *    required to keep the level set functions close to distance 
+ *    functions away from the zero level set) and the computation of 
+ *    a stable time step are still carried out on the entire grid.
+ *
  *  - AMR is currently UNAVAILABLE.  It is still in the development 
  *    stages.
  *
@@ -475,6 +599,61 @@ public:
    */
   virtual int numIntegrationStepsTaken() const;
 
+  /*!
+   * getPersistentScratchDataBytes() returns the number of bytes of 
+   * scratch PatchData (including the scratch PatchData of the 
+   * reinitialization algorithms) kept allocated on this processor
+   * between time steps.
+   *
+   * Arguments:      none
+   *
+   * Return value :  number of bytes of persistent scratch PatchData
+   *                 (zero if use_persistent_scratch_data is FALSE)
+   *
+   */
+  virtual size_t getPersistentScratchDataBytes() const;
+
+  /*!
+   * numScratchDataAllocations() returns the number of times that the 
+   * scratch PatchData for the time advance and the computation of the 
+   * stable time step has been allocated on the PatchHierarchy.
+   *
+   * Arguments:      none
+   *
+   * Return value :  number of scratch PatchData allocations
+   *
+   * NOTES:
+   *  - When use_persistent_scratch_data is TRUE, this count is only
+   *    incremented when the PatchHierarchy configuration is reset.
+   *
+   */
+  virtual int numScratchDataAllocations() const;
+
+  /*!
+   * markLevelSetFunctionsModified() notifies the integrator that the 
+   * level set functions have been modified outside of the integrator
+   * so that their ghost cells are refilled before they are next used.
+   * It is only needed when skip_redundant_ghostcell_fills is TRUE.
+   *
+   * Arguments:      none
+   *
+   * Return value :  none
+   *
+   */
+  virtual void markLevelSetFunctionsModified();
+
+  /*!
+   * numGhostCellFillsSkipped() returns the number of ghost cell 
+   * exchanges that were skipped because the ghost cells of the level 
+   * set functions were already current.
+   *
+   * Arguments:      none
+   *
+   * Return value :  number of skipped ghost cell exchanges
+   *
+   */
+  virtual int numGhostCellFillsSkipped() const;
+
   /*!
    * printClassData() prints the values of the data members for 
    * an instance of the LevelSetFunctionIntegrator class.
@@ -1291,6 +1470,157 @@ protected:
   //! @}
 
 
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Narrow band time advance
+   *
+   ****************************************************************/
+
+  /*!
+   * Stages of the TVD Runge-Kutta time integration that are
+   * supported by advanceLevelSetEqnStageLocal().
+   */
+  typedef enum { RK1_STEP = 0,
+                 TVD_RK2_STAGE1 = 1, TVD_RK2_STAGE2 = 2,
+                 TVD_RK3_STAGE1 = 3, TVD_RK3_STAGE2 = 4, 
+                 TVD_RK3_STAGE3 = 5, 
+                 LOW_STORAGE_TVD_RK3_STAGE2 = 6 } TVD_RK_STAGE_TYPE;
+
+  /*!
+   * NarrowBandPatchData holds the narrow band of a single component
+   * of the level set function on a single patch.  
+   *
+   * The narrow_band array covers the ghostbox of the level set 
+   * function.  The index arrays are sized to the narrow band and hold 
+   * the coordinates of the narrow band points with the points of 
+   * level L stored in the range n_lo[L] to n_hi[L].  Ghost cells are 
+   * marked in narrow_band so that the narrow band kernels only update
+   * the interior of the patch.  No storage is held for empty patches.
+   */
+  struct NarrowBandPatchData {
+    bool empty;
+    vector<unsigned char> narrow_band;
+    vector<int> index[DIM];
+    vector<int> n_lo;
+    vector<int> n_hi;
+  };
+
+  /*!
+   * buildNarrowBand() determines the narrow band around the zero 
+   * level set of each component of the current level set function
+   * on every patch of the PatchHierarchy.
+   *
+   * Arguments:      none
+   *
+   * Return value:   none
+   *
+   * NOTES:
+   *  - the ghost cells of the current level set function are assumed
+   *    to be filled.
+   *
+   */
+  virtual void buildNarrowBand();
+
+  /*!
+   * computeLevelSetEquationRHSLocal() computes the right-hand side of 
+   * the level set equation at the narrow band points and multiplies
+   * it by the cut-off function of the localized level set method.
+   *
+   * Arguments:     
+   *  - phi_handle (in):     PatchData handle for phi that should 
+   *                         be used to compute spatial derivatives
+   *  - component (in):      component of level set function that for 
+   *                         which the RHS is being computed
+   *                         (default = 0)
+   *
+   * Return value:           none
+   *
+   * NOTES:
+   *  - the RHS is set to zero at narrow band points that lie in 
+   *    the outer levels of the narrow band (i.e. the points that are 
+   *    only needed for the spatial derivative stencils).
+   *
+   */
+  virtual void computeLevelSetEquationRHSLocal(
+    const int phi_handle,
+    const int component = 0);
+
+  /*!
+   * advanceLevelSetEqnStageLocal() carries out a single stage of a 
+   * TVD Runge-Kutta step at the narrow band points.
+   *
+   * Arguments:     
+   *  - stage (in):          TVD Runge-Kutta stage to carry out
+   *  - u_out_handle (in):   PatchData handle for the result of the stage
+   *  - u_in_handle (in):    PatchData handle for the level set function
+   *                         used to compute the RHS of the stage
+   *  - u_cur_handle (in):   PatchData handle for the level set function
+   *                         at the beginning of the time step (ignored
+   *                         for first stages)
+   *  - dt (in):             time increment
+   *  - component (in):      component of level set function to advance
+   *                         (default = 0)
+   *
+   * Return value:           none
+   *
+   * NOTES:
+   *  - all levels of the narrow band are updated so that the result
+   *    of an intermediate stage can be used to compute the spatial 
+   *    derivatives at the narrow band points in the next stage.
+   *  - LOW_STORAGE_TVD_RK3_STAGE2 is carried out in place, so 
+   *    u_out_handle and u_in_handle must be the same.
+   *
+   */
+  virtual void advanceLevelSetEqnStageLocal(
+    const TVD_RK_STAGE_TYPE stage,
+    const int u_out_handle,
+    const int u_in_handle,
+    const int u_cur_handle,
+    const LSMLIB_REAL dt,
+    const int component = 0);
+
+  //! @}
+
+
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Adaptive regridding
+   *
+   ****************************************************************/
+
+  /*!
+   * resetRegridReference() saves a copy of the level set functions 
+   * that is used as the reference for estimating the displacement of 
+   * the zero level set since the last regrid.
+   *
+   * Arguments:     none
+   *
+   * Return value:  none
+   *
+   */
+  virtual void resetRegridReference();
+
+  /*!
+   * interfaceDisplacementRequiresRegrid() estimates the displacement 
+   * of the zero level set since the last call to resetRegridReference()
+   * and compares it with the regrid threshold.
+   *
+   * Arguments:     none
+   *
+   * Return value:  true if the displacement is at least 
+   *                regrid_buffer_fraction times the width of the tag 
+   *                buffer; false otherwise
+   *
+   */
+  virtual bool interfaceDisplacementRequiresRegrid();
+
+  //! @}
+
+
   //! @{
   /*!
    ****************************************************************
@@ -1387,6 +1717,11 @@ protected:
   int d_spatial_derivative_order;       // order of spatial derivative
   int d_tvd_runge_kutta_order;          // order of TVD Runge-Kutta time 
                                         //   integration
+  bool d_use_low_storage_runge_kutta;   // true if the low-storage form of
+                                        //   TVD-RK3 should be used
+  int d_num_time_advance_buffers;       // number of PatchData (including 
+                                        //   the current data) used to 
+                                        //   store phi during time advance
   int d_reinitialization_interval;      // interval between reinitialization
   LSMLIB_REAL d_reinitialization_stop_tol;   // stopping criterion for termination
                                         //   of evolution of reinitialization 
@@ -1404,6 +1739,16 @@ protected:
                                         //   distance
   int d_reinitialization_max_iters;     // maximum number of time steps 
                                         //   for reinitialization iteration
+  int d_reinitialization_ghostcell_exchange_interval;
+                                        // iterations between ghost cell 
+                                        //   exchanges in reinitialization
+  int d_reinitialization_convergence_check_interval;
+                                        // iterations between convergence
+                                        //   checks in reinitialization
+  bool d_reinitialization_batch_ghostcell_fills;
+                                        // true if the ghost cells of all
+                                        //   components are filled 
+                                        //   together in reinitialization
   int d_orthogonalization_interval;     // interval between orthogonalizing
                                         //   phi and psi for codim-two problems
   LSMLIB_REAL d_orthogonalization_stop_tol;  // stopping criterion for termination
@@ -1429,8 +1774,26 @@ protected:
   int d_tag_buffer_width;               // number of buffer cells to use around
                                         //   cells tagged for refinement
   LSMLIB_REAL d_refinement_cutoff_value;     // cutoff value for distance function
+  bool d_use_adaptive_regridding;            // regrid when zero level set moves
+  LSMLIB_REAL d_regrid_buffer_fraction;      // fraction of tag buffer that zero
+                                             //   level set may move
+
+  // narrow band parameters
+  bool d_use_narrow_band;               // true if the level set equation
+                                        //   should only be advanced in a 
+                                        //   narrow band
+  LSMLIB_REAL d_narrow_band_width;      // half-width of the narrow band
+                                        //   (in grid cells)
+  LSMLIB_REAL d_narrow_band_inner_width; // half-width of the inner part 
+                                        //   of the narrow band 
+                                        //   (in grid cells)
 
   // Miscellaneous parameters
+  bool d_use_persistent_scratch_data;   // true if scratch data should be
+                                        //   kept allocated between time 
+                                        //   steps
+  bool d_skip_redundant_ghostcell_fills; // true if current ghost cells 
+                                        //   should not be refilled
   bool d_verbose_mode;                  // true if status information should
                                         //   be output
 
@@ -1507,9 +1870,30 @@ protected:
   // auxilliary variables
   int d_control_volume_handle;
 
+  // level set functions at the last regrid (adaptive regridding) and
+  // the most recent estimate of the zero level set displacement
+  int d_phi_regrid_reference_handle;
+  int d_psi_regrid_reference_handle;
+  LSMLIB_REAL d_interface_displacement;
+
   // level set ghostcell width
   IntVector<DIM> d_level_set_ghostcell_width;
 
+  // scratch space for the undivided differences used to compute the
+  // spatial derivatives at narrow band points
+  int d_narrow_band_D1_handle;
+  int d_narrow_band_D2_handle;
+
+  // narrow band of each component of the level set function on each 
+  // patch indexed as [component][level number][patch number]
+  // and the number of narrow band levels
+  vector< vector< vector<NarrowBandPatchData> > > d_narrow_band_data;
+  int d_narrow_band_level;
+
+  // scratch space used to determine the narrow band on a patch
+  vector<int> d_narrow_band_index[DIM];
+  vector<int> d_narrow_band_index_outer;
+
   /*
    * Component selectors to organize variables into logical groups
    */
@@ -1541,6 +1925,14 @@ protected:
   LEVEL_SET_FCN_TYPE d_orthogonalization_evolved_field;
   int d_regrid_count;
 
+  // scratch data usage counters
+  size_t d_persistent_scratch_data_bytes;
+  int d_num_scratch_data_allocations;
+
+  // true if the ghost cells of phi and psi are current
+  bool d_level_set_ghostcells_filled;
+  int d_num_ghostcell_fills_skipped;
+
   /*
    * Boundary condition objects
    */
@@ -25,9 +25,12 @@
 #include "CartesianPatchGeometry.h"
 #include "CellData.h" 
 #include "CellVariable.h" 
+#include "Index.h" 
 #include "IntVector.h" 
 #include "Patch.h" 
+#include "PatchDescriptor.h" 
 #include "PatchLevel.h" 
+#include "RefineOperator.h" 
 #include "VariableContext.h" 
 #include "VariableDatabase.h" 
 #include "tbox/Utilities.h"
@@ -69,23 +72,6 @@ using namespace pdat;
 
 namespace LSMLIB {
 
-// parameters for computing spatial derivatives
-template <int DIM> int 
-LevelSetMethodToolbox<DIM>::s_D1_one_ghostcell_handle = -1;
-
-template <int DIM> int 
-LevelSetMethodToolbox<DIM>::s_D1_two_ghostcells_handle = -1;
-template <int DIM> int 
-LevelSetMethodToolbox<DIM>::s_D2_two_ghostcells_handle = -1;
-
-template <int DIM> int 
-LevelSetMethodToolbox<DIM>::s_D1_three_ghostcells_handle = -1;
-template <int DIM> int 
-LevelSetMethodToolbox<DIM>::s_D2_three_ghostcells_handle = -1;
-template <int DIM> int 
-LevelSetMethodToolbox<DIM>::s_D3_three_ghostcells_handle = -1;
-
-
 // parameters for computing unit normal vector
 template <int DIM> int 
 LevelSetMethodToolbox<DIM>::s_compute_normal_grad_phi_handle = -1;
@@ -113,17 +99,20 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
   const int phi_component)
 {
 
-  // make sure that the scratch PatchData handles have been created
-  initializeComputeSpatialDerivativesParameters();
-
   const int finest_level = hierarchy->getFinestLevelNumber();
   for ( int ln=0 ; ln<=finest_level ; ln++ ) {
 
     Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -181,21 +170,9 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
           switch (spatial_derivative_order) { 
             case 1: {
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_one_ghostcell_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_one_ghostcell_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
               if ( DIM == 3 ) {
 
-                LSM3D_UPWIND_HJ_ENO1(
+                LSM3D_UPWIND_HJ_ENO1_NO_SCRATCH(
                   grad_phi[0], grad_phi[1], grad_phi[2],
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -219,13 +196,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[1],
                   &upwind_fcn_ghostbox_lower[2],
                   &upwind_fcn_ghostbox_upper[2],
-                  D1, 
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -236,7 +206,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 
               } else if ( DIM == 2 ) {
 
-                LSM2D_UPWIND_HJ_ENO1(
+                LSM2D_UPWIND_HJ_ENO1_NO_SCRATCH(
                   grad_phi[0], grad_phi[1], 
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -253,11 +223,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[0],
                   &upwind_fcn_ghostbox_lower[1],
                   &upwind_fcn_ghostbox_upper[1],
-                  D1, 
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -266,7 +231,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_UPWIND_HJ_ENO1(
+                LSM1D_UPWIND_HJ_ENO1_NO_SCRATCH(
                   grad_phi[0], 
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -276,9 +241,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   upwind_function[0], 
                   &upwind_fcn_ghostbox_lower[0],
                   &upwind_fcn_ghostbox_upper[0],
-                  D1, 
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -293,35 +255,13 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 
               } // end switch over dimensions
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_one_ghostcell_handle );
-
               break;
             }
             case 2: {
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_two_ghostcells_handle );
-              patch->allocatePatchData( s_D2_two_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_two_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_two_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-
               if ( DIM == 3 ) {
 
-                LSM3D_UPWIND_HJ_ENO2(
+                LSM3D_UPWIND_HJ_ENO2_NO_SCRATCH(
                   grad_phi[0], grad_phi[1], grad_phi[2],
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -345,20 +285,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[1],
                   &upwind_fcn_ghostbox_lower[2],
                   &upwind_fcn_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -369,7 +295,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
   
               } else if ( DIM == 2 ) {
 
-                LSM2D_UPWIND_HJ_ENO2(
+                LSM2D_UPWIND_HJ_ENO2_NO_SCRATCH(
                   grad_phi[0], grad_phi[1], 
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -386,16 +312,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[0],
                   &upwind_fcn_ghostbox_lower[1],
                   &upwind_fcn_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -404,7 +320,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 
               } else if ( DIM == 1 ) {
   
-                LSM1D_UPWIND_HJ_ENO2(
+                LSM1D_UPWIND_HJ_ENO2_NO_SCRATCH(
                   grad_phi[0], 
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -414,12 +330,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   upwind_function[0], 
                   &upwind_fcn_ghostbox_lower[0],
                   &upwind_fcn_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -434,43 +344,13 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 
               } // end switch over dimensions
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_two_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_two_ghostcells_handle );
-
               break;
             }
             case 3: {
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-              patch->allocatePatchData( s_D2_three_ghostcells_handle );
-              patch->allocatePatchData( s_D3_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
-                patch->getPatchData( s_D3_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-              Box<DIM> D3_ghostbox = D3_data->getGhostBox();
-              const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
-              const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-              LSMLIB_REAL* D3 = D3_data->getPointer();
-
               if ( DIM == 3 ) {
 
-                LSM3D_UPWIND_HJ_ENO3(
+                LSM3D_UPWIND_HJ_ENO3_NO_SCRATCH(
                   grad_phi[0], grad_phi[1], grad_phi[2],
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -494,27 +374,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[1],
                   &upwind_fcn_ghostbox_lower[2],
                   &upwind_fcn_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &D3_ghostbox_lower[2],
-                  &D3_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -525,7 +384,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
   
               } else if ( DIM == 2 ) {
 
-                LSM2D_UPWIND_HJ_ENO3(
+                LSM2D_UPWIND_HJ_ENO3_NO_SCRATCH(
                   grad_phi[0], grad_phi[1],
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -542,21 +401,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[0],
                   &upwind_fcn_ghostbox_lower[1],
                   &upwind_fcn_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -565,7 +409,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
   
               } else if ( DIM == 1 ) {
 
-                LSM1D_UPWIND_HJ_ENO3(
+                LSM1D_UPWIND_HJ_ENO3_NO_SCRATCH(
                   grad_phi[0], 
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -575,15 +419,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   upwind_function[0], 
                   &upwind_fcn_ghostbox_lower[0],
                   &upwind_fcn_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -597,11 +432,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                           << endl );
               }
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D3_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -620,21 +450,9 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
           switch (spatial_derivative_order) { 
             case 5: {
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
               if ( DIM == 3 ) {
 
-                LSM3D_UPWIND_HJ_WENO5(
+                LSM3D_UPWIND_HJ_WENO5_NO_SCRATCH(
                   grad_phi[0], grad_phi[1], grad_phi[2],
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -658,13 +476,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[1],
                   &upwind_fcn_ghostbox_lower[2],
                   &upwind_fcn_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -675,7 +486,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
   
               } else if ( DIM == 2 ) {
 
-                LSM2D_UPWIND_HJ_WENO5(
+                LSM2D_UPWIND_HJ_WENO5_NO_SCRATCH(
                   grad_phi[0], grad_phi[1],
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -692,11 +503,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   &upwind_fcn_ghostbox_upper[0],
                   &upwind_fcn_ghostbox_lower[1],
                   &upwind_fcn_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -705,7 +511,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_UPWIND_HJ_WENO5(
+                LSM1D_UPWIND_HJ_WENO5_NO_SCRATCH(
                   grad_phi[0],
                   &grad_phi_ghostbox_lower[0],
                   &grad_phi_ghostbox_upper[0],
@@ -715,9 +521,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   upwind_function[0], 
                   &upwind_fcn_ghostbox_lower[0],
                   &upwind_fcn_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -731,9 +534,6 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                           << endl );
               }
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -773,20 +573,24 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
   const int grad_phi_plus_handle,
   const int grad_phi_minus_handle,
   const int phi_handle,
-  const int phi_component)
+  const int phi_component,
+  const int fillbox_growth)
 {
 
-  // make sure that the scratch PatchData handles have been created
-  initializeComputeSpatialDerivativesParameters();
-
   const int finest_level = hierarchy->getFinestLevelNumber();
   for ( int ln=0 ; ln<=finest_level ; ln++ ) {
 
     Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -814,6 +618,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
         patch->getPatchData( phi_handle );
   
       Box<DIM> fillbox = grad_phi_plus_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
       const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
 
@@ -845,22 +650,9 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
         case ENO: {
           switch (spatial_derivative_order) { 
             case 1: {
-
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_one_ghostcell_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_one_ghostcell_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
               if ( DIM == 3 ) {
 
-                LSM3D_HJ_ENO1(
+                LSM3D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -882,13 +674,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -899,7 +684,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 2 ) {
 
-                LSM2D_HJ_ENO1(
+                LSM2D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -915,11 +700,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -928,7 +708,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_HJ_ENO1(
+                LSM1D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -938,9 +718,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -955,36 +732,13 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } 
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_one_ghostcell_handle );
-
               break;
             }
 
             case 2: {
-
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_two_ghostcells_handle );
-              patch->allocatePatchData( s_D2_two_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_two_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_two_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-
               if ( DIM == 3 ) {
 
-                LSM3D_HJ_ENO2(
+                LSM3D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1006,20 +760,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -1030,7 +770,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 2 ) {
 
-                LSM2D_HJ_ENO2(
+                LSM2D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1046,16 +786,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -1064,7 +794,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_HJ_ENO2(
+                LSM1D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1074,12 +804,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -1094,44 +818,13 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } 
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_two_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_two_ghostcells_handle );
-
               break;
             }
 
             case 3: {
-
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-              patch->allocatePatchData( s_D2_three_ghostcells_handle );
-              patch->allocatePatchData( s_D3_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
-                patch->getPatchData( s_D3_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-              Box<DIM> D3_ghostbox = D3_data->getGhostBox();
-              const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
-              const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-              LSMLIB_REAL* D3 = D3_data->getPointer();
-
               if ( DIM == 3 ) { 
 
-                LSM3D_HJ_ENO3(
+                LSM3D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1153,27 +846,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &D3_ghostbox_lower[2],
-                  &D3_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -1184,7 +856,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 2 ) {
 
-                LSM2D_HJ_ENO3(
+                LSM2D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1200,21 +872,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -1223,7 +880,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_HJ_ENO3(
+                LSM1D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1233,15 +890,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -1256,11 +904,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } 
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D3_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -1278,22 +921,9 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
         case WENO: {
           switch (spatial_derivative_order) { 
             case 5: {
-
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
               if ( DIM == 3 ) {
 
-                LSM3D_HJ_WENO5(
+                LSM3D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1315,13 +945,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -1332,7 +955,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 2 ) {
 
-                LSM2D_HJ_WENO5(
+                LSM2D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1348,11 +971,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &grad_phi_fillbox_lower[1],
@@ -1361,7 +979,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_HJ_WENO5(
+                LSM1D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -1371,9 +989,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &grad_phi_fillbox_lower[0],
                   &grad_phi_fillbox_upper[0],
                   &dx[0]);
@@ -1388,9 +1003,6 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
               } 
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -1431,17 +1043,20 @@ void LevelSetMethodToolbox<DIM>::computeCentralSpatialDerivatives(
   const int phi_component)
 {
 
-  // make sure that the scratch PatchData handles have been created
-  initializeComputeSpatialDerivativesParameters();
-
   const int finest_level = hierarchy->getFinestLevelNumber();
   for ( int ln=0 ; ln<=finest_level ; ln++ ) {
 
     Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -1657,7 +1272,8 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
   const LSMLIB_REAL dt,
   const int u_next_component,
   const int u_cur_component,
-  const int rhs_component)
+  const int rhs_component,
+  const int fillbox_growth)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -1666,9 +1282,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -1699,6 +1321,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
 
       // fill box
       Box<DIM> fillbox = rhs_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -1798,7 +1421,8 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
   const LSMLIB_REAL dt,
   const int u_stage1_component,
   const int u_cur_component,
-  const int rhs_component)
+  const int rhs_component,
+  const int fillbox_growth)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -1807,9 +1431,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -1844,6 +1474,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
 
       // fill box
       Box<DIM> fillbox = u_stage1_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -1945,7 +1576,8 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
   const int u_next_component,
   const int u_stage1_component,
   const int u_cur_component,
-  const int rhs_component)
+  const int rhs_component,
+  const int fillbox_growth)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -1954,9 +1586,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -1999,6 +1637,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
 
       // fill box
       Box<DIM> fillbox = u_next_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2115,7 +1754,8 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
   const LSMLIB_REAL dt,
   const int u_stage1_component,
   const int u_cur_component,
-  const int rhs_component)
+  const int rhs_component,
+  const int fillbox_growth)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -2124,9 +1764,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -2161,6 +1807,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
 
       // fill box
       Box<DIM> fillbox = u_stage1_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2262,7 +1909,8 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
   const int u_stage2_component,
   const int u_stage1_component,
   const int u_cur_component,
-  const int rhs_component)
+  const int rhs_component,
+  const int fillbox_growth)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -2271,9 +1919,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -2316,6 +1970,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
 
       // fill box
       Box<DIM> fillbox = u_stage2_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2422,6 +2077,160 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
 }
 
 
+/* LowStorageTVDRK3Stage2() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage2(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int u_stage_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_stage_component,
+  const int u_cur_component,
+  const int rhs_component,
+  const int fillbox_growth)
+{
+  // loop over PatchHierarchy and take Runge-Kutta step
+  // by calling Fortran routines
+  const int num_levels = patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "LowStorageTVDRK3Stage2(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      // get pointers to data and index space ranges
+      Pointer< CellData<DIM,LSMLIB_REAL> > u_stage_data =
+        patch->getPatchData( u_stage_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+        patch->getPatchData( u_cur_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+        patch->getPatchData( rhs_handle );
+  
+      Box<DIM> u_stage_ghostbox = u_stage_data->getGhostBox();
+      const IntVector<DIM> u_stage_ghostbox_lower = 
+        u_stage_ghostbox.lower();
+      const IntVector<DIM> u_stage_ghostbox_upper = 
+        u_stage_ghostbox.upper();
+
+      Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+      const IntVector<DIM> u_cur_ghostbox_lower = 
+        u_cur_ghostbox.lower();
+      const IntVector<DIM> u_cur_ghostbox_upper = 
+        u_cur_ghostbox.upper();
+
+      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+      // fill box
+      Box<DIM> fillbox = u_stage_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
+      const IntVector<DIM> fillbox_lower = fillbox.lower();
+      const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+      LSMLIB_REAL* u_stage = u_stage_data->getPointer(u_stage_component);
+      LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+      LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+      if ( DIM == 3 ) {
+        LSM3D_LOW_STORAGE_TVD_RK3_STAGE2(
+          u_stage,
+          &u_stage_ghostbox_lower[0],
+          &u_stage_ghostbox_upper[0],
+          &u_stage_ghostbox_lower[1],
+          &u_stage_ghostbox_upper[1],
+          &u_stage_ghostbox_lower[2],
+          &u_stage_ghostbox_upper[2],
+          u_cur,
+          &u_cur_ghostbox_lower[0],
+          &u_cur_ghostbox_upper[0],
+          &u_cur_ghostbox_lower[1],
+          &u_cur_ghostbox_upper[1],
+          &u_cur_ghostbox_lower[2],
+          &u_cur_ghostbox_upper[2],
+          rhs,
+          &rhs_ghostbox_lower[0],
+          &rhs_ghostbox_upper[0],
+          &rhs_ghostbox_lower[1],
+          &rhs_ghostbox_upper[1],
+          &rhs_ghostbox_lower[2],
+          &rhs_ghostbox_upper[2],
+          &fillbox_lower[0],
+          &fillbox_upper[0],
+          &fillbox_lower[1],
+          &fillbox_upper[1],
+          &fillbox_lower[2],
+          &fillbox_upper[2],
+          &dt);
+
+      } else if ( DIM == 2 ) {
+        LSM2D_LOW_STORAGE_TVD_RK3_STAGE2(
+          u_stage,
+          &u_stage_ghostbox_lower[0],
+          &u_stage_ghostbox_upper[0],
+          &u_stage_ghostbox_lower[1],
+          &u_stage_ghostbox_upper[1],
+          u_cur,
+          &u_cur_ghostbox_lower[0],
+          &u_cur_ghostbox_upper[0],
+          &u_cur_ghostbox_lower[1],
+          &u_cur_ghostbox_upper[1],
+          rhs,
+          &rhs_ghostbox_lower[0],
+          &rhs_ghostbox_upper[0],
+          &rhs_ghostbox_lower[1],
+          &rhs_ghostbox_upper[1],
+          &fillbox_lower[0],
+          &fillbox_upper[0],
+          &fillbox_lower[1],
+          &fillbox_upper[1],
+          &dt);
+
+      } else if ( DIM == 1 ) {
+        LSM1D_LOW_STORAGE_TVD_RK3_STAGE2(
+          u_stage,
+          &u_stage_ghostbox_lower[0],
+          &u_stage_ghostbox_upper[0],
+          u_cur,
+          &u_cur_ghostbox_lower[0],
+          &u_cur_ghostbox_upper[0],
+          rhs,
+          &rhs_ghostbox_lower[0],
+          &rhs_ghostbox_upper[0],
+          &fillbox_lower[0],
+          &fillbox_upper[0],
+          &dt);
+
+      } else {  // Unsupported dimension
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "LowStorageTVDRK3Stage2(): "
+                  << "Invalid value of DIM.  "
+                  << "Only DIM = 1, 2, and 3 are supported."
+                  << endl);
+      }
+
+    } // end loop over patches in level
+  } // end loop over levels in hierarchy
+
+}
+
+
 /* TVDRK3Stage3() */
 template <int DIM> 
 void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
@@ -2434,7 +2243,8 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
   const int u_next_component,
   const int u_stage2_component,
   const int u_cur_component,
-  const int rhs_component)
+  const int rhs_component,
+  const int fillbox_growth)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -2443,9 +2253,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -2488,6 +2304,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
 
       // fill box
       Box<DIM> fillbox = u_stage2_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2595,7 +2412,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
 
 
 /* computeDistanceFunctionUsingFMM() */
-template <int DIM> 
+template <int DIM>
 void LevelSetMethodToolbox<DIM>::computeDistanceFunctionUsingFMM(
   Pointer< PatchHierarchy<DIM> > hierarchy,
   const int spatial_derivative_order,
@@ -2604,123 +2421,21 @@ void LevelSetMethodToolbox<DIM>::computeDistanceFunctionUsingFMM(
   const int distance_function_component,
   const int phi_component)
 {
-  const int finest_level = hierarchy->getFinestLevelNumber();
-
-  /*
-   * error checking
-   */
-
-  // TEMP - only single level calculations currently supported
-  if (finest_level > 0) {
-    TBOX_ERROR(  "LevelSetMethodToolbox::"
-              << "computeDistanceFunctionUsingFMM(): "
-              << "Only single level calculations currently supported."
-              << endl );
-  }
-
-  // TEMP - only first-order calculations currently supported
-  if (spatial_derivative_order > 0) {
-    TBOX_WARNING(  "LevelSetMethodToolbox::"
-                << "computeDistanceFunctionUsingFMM(): "
-                << "Only first-order calculations currently supported.  "
-                << "Dropping to first-order calculations." 
-                << endl );
-  }
-
-  for ( int ln=0 ; ln<=finest_level ; ln++ ) {
-
-    Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
-
-    // error checking...only single level calculations currently supported
-    if (level->getNumberOfPatches() > 1) {
-      TBOX_ERROR(  "LevelSetMethodToolbox::"
-                << "computeDistanceFunctionUsingFMM(): "
-                << "Only single patch calculations currently supported."
-                << endl );
-    }
-
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
-      Pointer< Patch<DIM> > patch = level->getPatch(pn);
-      if ( patch.isNull() ) {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
-                  << "computeDistanceFunctionUsingFMM(): "
-                  << "Cannot find patch. Null patch pointer."
-                  << endl );
-      }
-
-      // get geometry information for patch
-      Pointer< CartesianPatchGeometry<DIM> > patch_geom =
-        patch->getPatchGeometry();
-#ifdef LSMLIB_DOUBLE_PRECISION
-      const double* dx = patch_geom->getDx();
-#else
-      const double* dx_double = patch_geom->getDx();
-      float dx[DIM];
-      for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
-#endif
-  
-      // get PatchData for distance function and phi
-      Pointer< CellData<DIM,LSMLIB_REAL> > distance_function_data =
-        patch->getPatchData( distance_function_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
-        patch->getPatchData( phi_handle );
-  
-      // get index space information for PatchData
-      Box<DIM> ghostbox = distance_function_data->getGhostBox();
-      IntVector<DIM> grid_dims_int_vector = 
-        ghostbox.upper() - ghostbox.lower();
-      int* grid_dims = grid_dims_int_vector;
-
-      LSMLIB_REAL* distance_function = 
-        distance_function_data->getPointer(distance_function_component);
-      LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
-
-      // call computeExtensionFields*() from toolbox to carry out
-      // computation
-      if ( DIM == 3 ) {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
-                  << "computeDistanceFunctionUsingFMM(): "
-                  << "DIM = 3 is currently unsupported."
-                  << endl );
-        /*
-        computeExtensionFields3d(
-          distance_function,
-          (LSMLIB_REAL**) 0,
-          phi,
-          (LSMLIB_REAL**) 0,
-          0,
-          grid_dims,
-          (LSMLIB_REAL*) dx);
-        */
-      } else if ( DIM == 2 ) {
-        computeExtensionFields2d(
-          distance_function,
-          (LSMLIB_REAL**) 0,
-          phi,
-          (LSMLIB_REAL*) 0, // NULL mask field
-          (LSMLIB_REAL**) 0,
-          0,
-          spatial_derivative_order,  
-          grid_dims,
-          (LSMLIB_REAL*) dx);
-      } else if ( DIM == 1 ) {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
-                  << "computeDistanceFunctionUsingFMM(): "
-                  << "DIM = 1 is currently unsupported."
-                  << endl );
-      } else {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
-                  << "computeDistanceFunctionUsingFMM(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 2 is currently supported."
-                  << endl );
-
-      } // end switch on DIM
-
-    } // end loop over Patches
-  } // end loop over PatchLevels
+  // the distance function is computed as an extension field calculation
+  // with no extension fields
+  vector<int> extension_field_handles;
+  vector<int> source_field_handles;
+  computeExtensionFieldsUsingFMM(
+    hierarchy,
+    spatial_derivative_order,
+    extension_field_handles,
+    distance_function_handle,
+    source_field_handles,
+    phi_handle,
+    0,
+    distance_function_component,
+    0,
+    phi_component);
 }
 
 
@@ -2744,21 +2459,31 @@ void LevelSetMethodToolbox<DIM>::computeExtensionFieldsUsingFMM(
    * error checking
    */
 
-  // TEMP - only single level calculations currently supported
-  if (finest_level > 0) {
+  if (spatial_derivative_order < 1) {
     TBOX_ERROR(  "LevelSetMethodToolbox::"
               << "computeExtensionFieldsUsingFMM(): "
-              << "Only single level calculations currently supported."
+              << "Invalid spatial derivative order.  "
+              << "Only first- and second-order calculations supported."
               << endl );
   }
 
-  // TEMP - only first-order calculations currently supported
-  if (spatial_derivative_order > 0) {
+  // only first- and second-order fast marching calculations are available
+  int fmm_spatial_derivative_order = spatial_derivative_order;
+  if (spatial_derivative_order > 2) {
     TBOX_WARNING(  "LevelSetMethodToolbox::"
                 << "computeExtensionFieldsUsingFMM(): "
-                << "Only first-order calculations currently supported.  "
-                << "Dropping to first-order calculations." 
+                << "Only first- and second-order calculations supported.  "
+                << "Dropping to second-order calculations."
                 << endl );
+    fmm_spatial_derivative_order = 2;
+  }
+
+  if ( (DIM != 2) && (DIM != 3) ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::"
+              << "computeExtensionFieldsUsingFMM(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 2 and DIM = 3 are currently supported."
+              << endl );
   }
 
   // allocate memory for extension fields and source fields
@@ -2766,117 +2491,332 @@ void LevelSetMethodToolbox<DIM>::computeExtensionFieldsUsingFMM(
   LSMLIB_REAL** extension_fields = new LSMLIB_REAL*[num_extension_fields];
   LSMLIB_REAL** source_fields = new LSMLIB_REAL*[num_extension_fields];
 
-  for ( int ln=0 ; ln<=finest_level ; ln++ ) {
+  // the distance function and extension fields are exchanged between
+  // patches and monitored for convergence together
+  vector<int> exchange_handles(1, distance_function_handle);
+  exchange_handles.insert(exchange_handles.end(), 
+                          extension_field_handles.begin(),
+                          extension_field_handles.end());
+  const int num_exchange_fields = exchange_handles.size();
+  LSMLIB_REAL** exchange_fields = new LSMLIB_REAL*[num_exchange_fields];
+  LSMLIB_REAL** exchange_fields_prev = new LSMLIB_REAL*[num_exchange_fields];
+
+  /*
+   * set up communication algorithm used to exchange the distance
+   * function and extension fields between neighboring patches
+   *
+   * NOTE: on a single level, data is only copied between patches 
+   *       so no refine operator is required.  On finer levels, ghost 
+   *       cells at coarse-fine boundaries are filled by linear 
+   *       interpolation of the values computed on the next coarser 
+   *       level.
+   */
+  VariableDatabase<DIM>* var_db = VariableDatabase<DIM>::getDatabase();
+  Pointer< CartesianGridGeometry<DIM> > grid_geometry =
+    hierarchy->getGridGeometry();
+  Pointer< RefineAlgorithm<DIM> > fill_bdry_alg = new RefineAlgorithm<DIM>;
+  for (int k=0; k < num_exchange_fields; k++) {
+    Pointer< RefineOperator<DIM> > refine_op;  // NULL refine operator
+    if (finest_level > 0) {
+      Pointer< Variable<DIM> > variable;
+      if (!var_db->mapIndexToVariable(exchange_handles[k], variable)) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::"
+                  << "computeExtensionFieldsUsingFMM(): "
+                  << "Specified PatchData handle does not exist."
+                  << endl );
+      }
+      refine_op = grid_geometry->lookupRefineOperator(variable,
+                                                      "LINEAR_REFINE");
+    }
+    fill_bdry_alg->registerRefine(
+      exchange_handles[k],
+      exchange_handles[k],
+      exchange_handles[k],
+      refine_op);
+  }
+
+  // reuse the fast marching work arrays for all patch-local calculations
+  LSM_FMM_Workspace *fmm_workspace = createFMMWorkspace();
+
+  /*
+   * Compute the distance function and extension fields one level at 
+   * a time, starting with the coarsest level, by iterating patch-local 
+   * fast marching calculations.  On the first pass, each patch is 
+   * solved using only its own data (and, on finer levels, the values 
+   * interpolated from the next coarser level at coarse-fine 
+   * boundaries).  On subsequent passes, the ghost cells are filled 
+   * with the values computed on neighboring patches (which may live 
+   * on other processors) and used as boundary data for the 
+   * patch-local calculation.  The iteration terminates when neither 
+   * the distance function nor the extension fields change.  The 
+   * number of passes required is bounded by the number of patches 
+   * the characteristics must cross, so the number of patches on 
+   * the level is used as a safeguard on the number of passes.
+   */
+  for (int ln = 0; ln <= finest_level; ln++) {
 
     Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
+    Pointer< RefineSchedule<DIM> > fill_bdry_sched =
+      fill_bdry_alg->createSchedule(
+        level, ln-1, hierarchy, 0);  // NULL RefinePatchStrategy
+
+    // compute computational domain and boxes on current level (used 
+    // to identify ghost cells at coarse-fine boundaries)
+    BoxArray<DIM> domain(grid_geometry->getPhysicalDomain());
+    domain.refine(level->getRatio());
+    const BoxArray<DIM>& level_boxes = level->getBoxes();
+
+    // allocate scratch memory used to save the previous values of the
+    // distance function and extension fields and to mark boundary data
+    // (sized for the largest patch on this processor and shared by all
+    // patches and passes)
+    int max_num_gridpts = 0;
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) {
+      Pointer< Patch<DIM> > patch = level->getPatch(*pi);
+      Pointer< PatchData<DIM> > distance_function_data =
+        patch->getPatchData( distance_function_handle );
+      const int num_gridpts = distance_function_data->getGhostBox().size();
+      if (num_gridpts > max_num_gridpts) max_num_gridpts = num_gridpts;
+    }
+    LSMLIB_REAL* boundary_mask = new LSMLIB_REAL[max_num_gridpts];
+    for (int k=0; k < num_exchange_fields; k++) {
+      exchange_fields_prev[k] = new LSMLIB_REAL[max_num_gridpts];
+    }
 
-    // error checking...only single level calculations currently supported
-    if (level->getNumberOfPatches() > 1) {
-      TBOX_ERROR(  "LevelSetMethodToolbox::"
-                << "computeExtensionFieldsUsingFMM(): "
-                << "Only single patch calculations currently supported."
-                << endl );
+    if (ln > 0) {
+      // fill ghost cells at coarse-fine boundaries before first pass
+      fill_bdry_sched->fillData(0.0);
     }
 
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
-      Pointer< Patch<DIM> > patch = level->getPatch(pn);
-      if ( patch.isNull() ) {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
-                  << "computeExtensionFieldsUsingFMM(): "
-                  << "Cannot find patch. Null patch pointer."
-                  << endl );
+    const int num_patches = level->getNumberOfPatches();
+    const int max_num_passes = num_patches + 1;
+    int num_passes = 0;
+    LSMLIB_REAL max_change;
+
+    do {
+
+      // fill ghost cells with values from neighboring patches
+      if (num_passes > 0) {
+        fill_bdry_sched->fillData(0.0);
       }
 
-      // get geometry information for patch
-      Pointer< CartesianPatchGeometry<DIM> > patch_geom =
-        patch->getPatchGeometry();
+      max_change = 0.0;
+
+      for (pi.initialize(level); pi; pi++) { // loop over patches
+        const int pn = *pi;
+        Pointer< Patch<DIM> > patch = level->getPatch(pn);
+        if ( patch.isNull() ) {
+          TBOX_ERROR(  "LevelSetMethodToolbox::"
+                    << "computeExtensionFieldsUsingFMM(): "
+                    << "Cannot find patch. Null patch pointer."
+                    << endl );
+        }
+
+        // get geometry information for patch
+        Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+          patch->getPatchGeometry();
 #ifdef LSMLIB_DOUBLE_PRECISION
-      const double* dx = patch_geom->getDx();
+        const double* dx = patch_geom->getDx();
 #else
-      const double* dx_double = patch_geom->getDx();
-      float dx[DIM];
-      for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
+        const double* dx_double = patch_geom->getDx();
+        float dx[DIM];
+        for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
 #endif
-  
-      // get PatchData for distance function and phi
-      Pointer< CellData<DIM,LSMLIB_REAL> > distance_function_data =
-        patch->getPatchData( distance_function_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
-        patch->getPatchData( phi_handle );
-      LSMLIB_REAL* distance_function = 
-        distance_function_data->getPointer(distance_function_component);
-      LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
-  
-      // get PatchData for source fields and extension fields
-      for (int k=0; k < num_extension_fields; k++) {
-        Pointer< CellData<DIM,LSMLIB_REAL> > extension_field_data = 
-          patch->getPatchData( extension_field_handles[k] );
-        Pointer< CellData<DIM,LSMLIB_REAL> > source_field_data = 
-          patch->getPatchData( source_field_handles[k] );
-
-        extension_fields[k] = 
-          extension_field_data->getPointer(extension_field_component);
-        source_fields[k] = 
-          source_field_data->getPointer(source_field_component);
-      }
 
-      // get index space information for PatchData
-      Box<DIM> ghostbox = distance_function_data->getGhostBox();
-      IntVector<DIM> grid_dims_int_vector = 
-        ghostbox.upper() - ghostbox.lower();
-      int* grid_dims = grid_dims_int_vector;
+        // get PatchData for distance function and phi
+        Pointer< CellData<DIM,LSMLIB_REAL> > distance_function_data =
+          patch->getPatchData( distance_function_handle );
+        Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+          patch->getPatchData( phi_handle );
+        LSMLIB_REAL* distance_function =
+          distance_function_data->getPointer(distance_function_component);
+        LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
+        exchange_fields[0] = distance_function;
+
+        // get PatchData for source fields and extension fields
+        for (int k=0; k < num_extension_fields; k++) {
+          Pointer< CellData<DIM,LSMLIB_REAL> > extension_field_data =
+            patch->getPatchData( extension_field_handles[k] );
+          Pointer< CellData<DIM,LSMLIB_REAL> > source_field_data =
+            patch->getPatchData( source_field_handles[k] );
+
+          extension_fields[k] =
+            extension_field_data->getPointer(extension_field_component);
+          source_fields[k] =
+            source_field_data->getPointer(source_field_component);
+          exchange_fields[k+1] = extension_fields[k];
+        }
 
-      // call computeExtensionFields*() from toolbox to carry out
-      // computation
-      if ( DIM == 3 ) {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
-                  << "computeExtensionFieldsUsingFMM(): "
-                  << "DIM = 3 is currently unsupported."
-                  << endl );
-        /*
-        computeExtensionFields3d(
-          distance_function,
-          ext_field
-          phi,
-          (LSMLIB_REAL*) 0,
-          (LSMLIB_REAL**) 0,
-          0,
-          grid_dims,
-          (LSMLIB_REAL*) dx);
-        */
-      } else if ( DIM == 2 ) {
-        computeExtensionFields2d(
-          distance_function,
-          extension_fields,
-          phi,
-          (LSMLIB_REAL*) 0,  // NULL mask field
-          source_fields,
-          num_extension_fields,
-          spatial_derivative_order,
-          grid_dims,
-          (LSMLIB_REAL*) dx);
-      } else if ( DIM == 1 ) {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
-                  << "computeExtensionFieldsUsingFMM(): "
-                  << "DIM = 1 is currently unsupported."
-                  << endl );
-      } else {
-        TBOX_ERROR(  "LevelSetMethodToolbox::"
+        // get index space information for PatchData
+        Box<DIM> ghostbox = distance_function_data->getGhostBox();
+        Box<DIM> box = patch->getBox();
+        IntVector<DIM> grid_dims_int_vector = ghostbox.numberCells();
+        int* grid_dims = grid_dims_int_vector;
+        int num_gridpts = ghostbox.size();
+
+        // save the current values so that the change in the distance
+        // function and extension fields can be measured
+        for (int k=0; k < num_exchange_fields; k++) {
+          for (int idx = 0; idx < num_gridpts; idx++) {
+            exchange_fields_prev[k][idx] = exchange_fields[k][idx];
+          }
+        }
+
+        // collect the parts of the ghostbox that are covered by the
+        // current level and that lie inside the computational domain
+        vector< Box<DIM> > covered_boxes;
+        vector< Box<DIM> > domain_boxes;
+        if ( (ln > 0) && (num_passes == 0) ) {
+          for (int b = 0; b < level_boxes.getNumberOfBoxes(); b++) {
+            Box<DIM> overlap = level_boxes[b] * ghostbox;
+            if (!overlap.empty()) covered_boxes.push_back(overlap);
+          }
+          for (int b = 0; b < domain.getNumberOfBoxes(); b++) {
+            Box<DIM> overlap = domain[b] * ghostbox;
+            if (!overlap.empty()) domain_boxes.push_back(overlap);
+          }
+        }
+
+        // mark ghost cells that contain values computed on neighboring
+        // patches as boundary data.  On the first pass, only ghost
+        // cells at coarse-fine boundaries contain valid data.
+        for (int idx = 0; idx < num_gridpts; idx++) {
+          boundary_mask[idx] = -1.0;
+        }
+        if ( (num_passes > 0) || (ln > 0) ) {
+          for (int idx = 0; idx < num_gridpts; idx++) {
+            Index<DIM> cell(ghostbox.lower());
+            int idx_remainder = idx;
+            for (int i = 0; i < DIM; i++) {
+              cell(i) += idx_remainder%grid_dims[i];
+              idx_remainder /= grid_dims[i];
+            }
+            if ( box.contains(cell) ||
+                 (distance_function[idx] >= LSMLIB_REAL_MAX) ||
+                 (distance_function[idx] <= -LSMLIB_REAL_MAX) ) {
+              continue;
+            }
+
+            if (num_passes == 0) {
+              bool coarse_fine_cell = false;
+              for (int b = 0; b < (int) domain_boxes.size(); b++) {
+                if (domain_boxes[b].contains(cell)) {
+                  coarse_fine_cell = true;
+                  break;
+                }
+              }
+              for (int b = 0; 
+                   coarse_fine_cell && (b < (int) covered_boxes.size()); 
+                   b++) {
+                if (covered_boxes[b].contains(cell)) {
+                  coarse_fine_cell = false;
+                }
+              }
+              if (!coarse_fine_cell) continue;
+            }
+
+            boundary_mask[idx] = 1.0;
+          }
+        }
+
+        // call computeExtensionFieldsWithWorkspace*() (with boundary
+        // data) from toolbox to carry out computation
+        if ( DIM == 3 ) {
+          computeExtensionFieldsWithWorkspace3d(
+            fmm_workspace,
+            distance_function,
+            extension_fields,
+            phi,
+            (LSMLIB_REAL*) 0,  // NULL mask field
+            source_fields,
+            (LSMLIB_REAL*) 0,  // NULL extension_mask field
+            boundary_mask,
+            num_extension_fields,
+            fmm_spatial_derivative_order,
+            LSMLIB_REAL_MAX,   // no cut-off
+            grid_dims,
+            (LSMLIB_REAL*) dx);
+        } else if ( DIM == 2 ) {
+          computeExtensionFieldsWithWorkspace2d(
+            fmm_workspace,
+            distance_function,
+            extension_fields,
+            phi,
+            (LSMLIB_REAL*) 0,  // NULL mask field
+            source_fields,
+            (LSMLIB_REAL*) 0,  // NULL extension_mask field
+            boundary_mask,
+            num_extension_fields,
+            fmm_spatial_derivative_order,
+            LSMLIB_REAL_MAX,   // no cut-off
+            grid_dims,
+            (LSMLIB_REAL*) dx);
+        } // end switch on DIM
+
+        // compute change in distance function and extension fields 
+        // on interior of patch
+        if (num_passes > 0) {
+          for (int idx = 0; idx < num_gridpts; idx++) {
+            Index<DIM> cell(ghostbox.lower());
+            int idx_remainder = idx;
+            for (int i = 0; i < DIM; i++) {
+              cell(i) += idx_remainder%grid_dims[i];
+              idx_remainder /= grid_dims[i];
+            }
+            if (!box.contains(cell)) continue;
+
+            for (int k=0; k < num_exchange_fields; k++) {
+              const LSMLIB_REAL value = exchange_fields[k][idx];
+              const LSMLIB_REAL value_prev = exchange_fields_prev[k][idx];
+              if (value != value_prev) {
+                LSMLIB_REAL change = LSMLIB_REAL_MAX;
+                if ( (value_prev < LSMLIB_REAL_MAX) &&
+                     (value_prev > -LSMLIB_REAL_MAX) ) {
+                  change = value - value_prev;
+                  if (change < 0) change = -change;
+                }
+                if (change > max_change) max_change = change;
+              }
+            }
+          }
+        } else {
+          max_change = LSMLIB_REAL_MAX;
+        }
+
+      } // end loop over Patches
+
+      // take maximum over all processors
+      max_change = tbox::MPI::maxReduction(max_change);
+      num_passes++;
+
+    } while ( (num_patches > 1) && (max_change > LSMLIB_ZERO_TOL) &&
+              (num_passes <= max_num_passes) );
+
+    if ( (num_patches > 1) && (max_change > LSMLIB_ZERO_TOL) ) {
+      TBOX_WARNING(  "LevelSetMethodToolbox::"
                   << "computeExtensionFieldsUsingFMM(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 2 is currently supported."
+                  << "Fast marching iteration across patches on level "
+                  << ln << " did not converge after " 
+                  << num_passes << " passes."
                   << endl );
+    }
 
-      } // end switch on DIM
+    // free scratch memory
+    delete [] boundary_mask;
+    for (int k=0; k < num_exchange_fields; k++) {
+      delete [] exchange_fields_prev[k];
+    }
 
-    } // end loop over Patches
-  } // end loop over PatchLevels
+  } // end loop over levels
+
+  destroyFMMWorkspace(fmm_workspace);
 
   // free memory for extension fields and source fields
-  delete [] extension_fields; 
-  delete [] source_fields; 
+  delete [] extension_fields;
+  delete [] source_fields;
+  delete [] exchange_fields;
+  delete [] exchange_fields_prev;
 }
 
 
@@ -2898,7 +2838,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
        (s_compute_normal_grad_phi_minus_handle < 0) ) {
     initializeComputeUnitNormalParameters();
   }
-  initializeComputeSpatialDerivativesParameters();
 
   const int finest_level = patch_hierarchy->getFinestLevelNumber();
   for ( int ln=0 ; ln<=finest_level ; ln++ ) {
@@ -2991,22 +2930,9 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
       switch (spatial_derivative_type) {
         case ENO: {
           switch (spatial_derivative_order) { 
-            case 1: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_one_ghostcell_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_one_ghostcell_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
+            case 1: {
               if ( DIM == 3 ) {
-                LSM3D_HJ_ENO1(
+                LSM3D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3028,13 +2954,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3045,7 +2964,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
 
-                LSM2D_HJ_ENO1(
+                LSM2D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3061,11 +2980,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3074,7 +2988,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_HJ_ENO1(
+                LSM1D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], 
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3084,9 +2998,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -3101,36 +3012,13 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_one_ghostcell_handle );
-
               break;
             }
 
             case 2: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_two_ghostcells_handle );
-              patch->allocatePatchData( s_D2_two_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_two_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_two_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_ENO2(
+                LSM3D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3152,20 +3040,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3176,7 +3050,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_ENO2(
+                LSM2D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3192,16 +3066,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3210,7 +3074,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
               
-                LSM1D_HJ_ENO2(
+                LSM1D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3220,12 +3084,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -3240,43 +3098,12 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_two_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_two_ghostcells_handle );
-
               break;
             }
             case 3: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-              patch->allocatePatchData( s_D2_three_ghostcells_handle );
-              patch->allocatePatchData( s_D3_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
-                patch->getPatchData( s_D3_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-              Box<DIM> D3_ghostbox = D3_data->getGhostBox();
-              const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
-              const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-              LSMLIB_REAL* D3 = D3_data->getPointer();
-
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_ENO3(
+                LSM3D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3298,27 +3125,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &D3_ghostbox_lower[2],
-                  &D3_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3329,7 +3135,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_ENO3(
+                LSM2D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3345,21 +3151,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3368,7 +3159,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
               
-                LSM1D_HJ_ENO3(
+                LSM1D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3378,15 +3169,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -3401,11 +3183,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D3_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -3423,22 +3200,9 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
         case WENO: {
           switch (spatial_derivative_order) { 
             case 5: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_WENO5(
+                LSM3D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3460,13 +3224,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3477,7 +3234,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_WENO5(
+                LSM2D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3493,11 +3250,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3506,7 +3258,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
               
-                LSM1D_HJ_WENO5(
+                LSM1D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3516,9 +3268,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -3533,9 +3282,6 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -3845,7 +3591,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
        (s_compute_normal_grad_phi_minus_handle < 0) ) {
     initializeComputeUnitNormalParameters();
   }
-  initializeComputeSpatialDerivativesParameters();
 
   const int finest_level = patch_hierarchy->getFinestLevelNumber();
   for ( int ln=0 ; ln<=finest_level ; ln++ ) {
@@ -3939,21 +3684,8 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
         case ENO: {
           switch (spatial_derivative_order) { 
             case 1: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_one_ghostcell_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_one_ghostcell_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
               if ( DIM == 3 ) {
-                LSM3D_HJ_ENO1(
+                LSM3D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3975,13 +3707,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -3992,7 +3717,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
 
-                LSM2D_HJ_ENO1(
+                LSM2D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4008,11 +3733,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -4021,7 +3741,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
 
-                LSM1D_HJ_ENO1(
+                LSM1D_HJ_ENO1_NO_SCRATCH(
                   grad_phi_plus[0], 
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4031,9 +3751,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -4048,36 +3765,13 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_one_ghostcell_handle );
-
               break;
             }
 
             case 2: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_two_ghostcells_handle );
-              patch->allocatePatchData( s_D2_two_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_two_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_two_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_ENO2(
+                LSM3D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4099,20 +3793,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -4123,7 +3803,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_ENO2(
+                LSM2D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4139,16 +3819,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -4157,7 +3827,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
               
-                LSM1D_HJ_ENO2(
+                LSM1D_HJ_ENO2_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4167,12 +3837,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -4187,43 +3851,12 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_two_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_two_ghostcells_handle );
-
               break;
             }
             case 3: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-              patch->allocatePatchData( s_D2_three_ghostcells_handle );
-              patch->allocatePatchData( s_D3_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
-                patch->getPatchData( s_D3_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-              Box<DIM> D3_ghostbox = D3_data->getGhostBox();
-              const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
-              const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-              LSMLIB_REAL* D3 = D3_data->getPointer();
-
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_ENO3(
+                LSM3D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4245,27 +3878,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &D3_ghostbox_lower[2],
-                  &D3_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -4276,7 +3888,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_ENO3(
+                LSM2D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4292,21 +3904,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -4315,7 +3912,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
               
-                LSM1D_HJ_ENO3(
+                LSM1D_HJ_ENO3_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4325,15 +3922,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -4348,11 +3936,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D3_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -4370,22 +3953,9 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
         case WENO: {
           switch (spatial_derivative_order) { 
             case 5: {
-
-              // prepare scratch PatchData for computing grad(phi)
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_WENO5(
+                LSM3D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4407,13 +3977,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[1],
                   &phi_ghostbox_lower[2],
                   &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -4424,7 +3987,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_WENO5(
+                LSM2D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4440,11 +4003,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   &phi_ghostbox_upper[0],
                   &phi_ghostbox_lower[1],
                   &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &fillbox_lower[1],
@@ -4453,7 +4011,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 1 ) {
               
-                LSM1D_HJ_WENO5(
+                LSM1D_HJ_WENO5_NO_SCRATCH(
                   grad_phi_plus[0],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4463,9 +4021,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
                   phi,
                   &phi_ghostbox_lower[0],
                   &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
                   &fillbox_lower[0],
                   &fillbox_upper[0],
                   &dx[0]);
@@ -4480,9 +4035,6 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } 
 
-              // deallocate PatchData for computing grad(phi)
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-
               break;
             }
             default: {
@@ -4804,9 +4356,15 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromGradPhi(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -4930,9 +4488,15 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromGradPhi(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -5095,9 +4659,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // loop over the local patches (concurrently when OpenMP is enabled)
+      vector<int> patch_numbers;
+      getLocalPatchNumbers(level, patch_numbers);
+      const int num_patches = (int) patch_numbers.size();
+      vector<LSMLIB_REAL> volume_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+        const int pn = patch_numbers[pi];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5219,9 +4790,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
                     << endl);
         }
 
-        volume += volume_on_patch;
+        volume_on_patches[pi] = volume_on_patch;
 
       } // end loop over patches in level
+
+      // combine the patch contributions in patch order so that the
+      // result does not depend on the number of threads
+      for (int pi = 0; pi < num_patches; pi++) {
+        volume += volume_on_patches[pi];
+      }
     } // end loop over levels in hierarchy
 
   } else { // integrate over region {x | phi(x) < 0}
@@ -5230,9 +4807,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // loop over the local patches (concurrently when OpenMP is enabled)
+      vector<int> patch_numbers;
+      getLocalPatchNumbers(level, patch_numbers);
+      const int num_patches = (int) patch_numbers.size();
+      vector<LSMLIB_REAL> volume_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+        const int pn = patch_numbers[pi];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5354,9 +4938,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
                     << endl);
         }
 
-        volume += volume_on_patch;
+        volume_on_patches[pi] = volume_on_patch;
 
       } // end loop over patches in level
+
+      // combine the patch contributions in patch order so that the
+      // result does not depend on the number of threads
+      for (int pi = 0; pi < num_patches; pi++) {
+        volume += volume_on_patches[pi];
+      }
     } // end loop over levels in hierarchy
 
   } // end if statement on (region_indicator > 0)
@@ -5385,9 +4975,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfZeroLevelSet(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+    vector<LSMLIB_REAL> volume_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5536,9 +5133,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfZeroLevelSet(
                   << endl);
       }
 
-      volume += volume_on_patch;
+      volume_on_patches[pi] = volume_on_patch;
 
     } // end loop over patches in level
+
+    // combine the patch contributions in patch order so that the
+    // result does not depend on the number of threads
+    for (int pi = 0; pi < num_patches; pi++) {
+      volume += volume_on_patches[pi];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::sumReduction(volume);
@@ -5568,9 +5171,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // loop over the local patches (concurrently when OpenMP is enabled)
+      vector<int> patch_numbers;
+      getLocalPatchNumbers(level, patch_numbers);
+      const int num_patches = (int) patch_numbers.size();
+      vector<LSMLIB_REAL> integral_F_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+        const int pn = patch_numbers[pi];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5714,9 +5324,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
                     << endl);
         }
 
-        integral_F += integral_F_on_patch;
+        integral_F_on_patches[pi] = integral_F_on_patch;
 
       } // end loop over patches in level
+
+      // combine the patch contributions in patch order so that the
+      // result does not depend on the number of threads
+      for (int pi = 0; pi < num_patches; pi++) {
+        integral_F += integral_F_on_patches[pi];
+      }
     } // end loop over levels in hierarchy
 
   } else {
@@ -5725,9 +5341,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // loop over the local patches (concurrently when OpenMP is enabled)
+      vector<int> patch_numbers;
+      getLocalPatchNumbers(level, patch_numbers);
+      const int num_patches = (int) patch_numbers.size();
+      vector<LSMLIB_REAL> integral_F_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+        const int pn = patch_numbers[pi];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5871,9 +5494,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
                     << endl);
         }
 
-        integral_F += integral_F_on_patch;
+        integral_F_on_patches[pi] = integral_F_on_patch;
 
       } // end loop over patches in level
+
+      // combine the patch contributions in patch order so that the
+      // result does not depend on the number of threads
+      for (int pi = 0; pi < num_patches; pi++) {
+        integral_F += integral_F_on_patches[pi];
+      }
     } // end loop over levels in hierarchy
 
   } // end if statement on (region_indicator > 0)
@@ -5904,9 +5533,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeSurfaceIntegral(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+    vector<LSMLIB_REAL> integral_F_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6077,9 +5713,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeSurfaceIntegral(
                   << endl);
       }
 
-      integral_F += integral_F_on_patch;
+      integral_F_on_patches[pi] = integral_F_on_patch;
 
     } // end loop over patches in level
+
+    // combine the patch contributions in patch order so that the
+    // result does not depend on the number of threads
+    for (int pi = 0; pi < num_patches; pi++) {
+      integral_F += integral_F_on_patches[pi];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::sumReduction(integral_F);
@@ -6118,9 +5760,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableAdvectionDt(
       dx[dir] = dx_level0[dir]/ratio_to_coarsest[dir];
     }
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+    vector<LSMLIB_REAL> max_advection_dt_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6228,10 +5877,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableAdvectionDt(
       } // end switch over dimension (DIM) of level set method calculation
 
       // update max_advection_dt
-      if (max_advection_dt_on_patch < max_advection_dt)
-        max_advection_dt = max_advection_dt_on_patch;
+      max_advection_dt_on_patches[pi] = max_advection_dt_on_patch;
 
     } // end loop over patches in level
+
+    // combine the patch contributions
+    for (int pi = 0; pi < num_patches; pi++) {
+      if (max_advection_dt_on_patches[pi] < max_advection_dt)
+        max_advection_dt = max_advection_dt_on_patches[pi];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::minReduction(max_advection_dt);
@@ -6272,9 +5926,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableNormalVelocityDt(
       dx[dir] = dx_level0[dir]/ratio_to_coarsest[dir];
     }
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+    vector<LSMLIB_REAL> max_normal_vel_dt_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6430,10 +6091,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableNormalVelocityDt(
       } // end switch over dimension (DIM) of level set method calculation
 
       // update max_normal_vel_dt
-      if (max_normal_vel_dt_on_patch < max_normal_vel_dt)
-        max_normal_vel_dt = max_normal_vel_dt_on_patch;
+      max_normal_vel_dt_on_patches[pi] = max_normal_vel_dt_on_patch;
 
     } // end loop over patches in level
+
+    // combine the patch contributions
+    for (int pi = 0; pi < num_patches; pi++) {
+      if (max_normal_vel_dt_on_patches[pi] < max_normal_vel_dt)
+        max_normal_vel_dt = max_normal_vel_dt_on_patches[pi];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::minReduction(max_normal_vel_dt);
@@ -6459,9 +6125,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::maxNormOfDifference(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+    vector<LSMLIB_REAL> max_norm_diff_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6585,10 +6258,182 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::maxNormOfDifference(
                   << endl);
       }
 
-      if (max_norm_diff < max_norm_diff_on_patch)
-        max_norm_diff = max_norm_diff_on_patch; 
+      max_norm_diff_on_patches[pi] = max_norm_diff_on_patch;
+
+    } // end loop over patches in level
+
+    // combine the patch contributions
+    for (int pi = 0; pi < num_patches; pi++) {
+      if (max_norm_diff < max_norm_diff_on_patches[pi])
+        max_norm_diff = max_norm_diff_on_patches[pi];
+    }
+  } // end loop over levels in hierarchy
+
+  return tbox::MPI::maxReduction(max_norm_diff);
+}
+
+
+/* maxNormOfDifferenceNearZeroLevelSet() */
+template <int DIM> 
+LSMLIB_REAL LevelSetMethodToolbox<DIM>::maxNormOfDifferenceNearZeroLevelSet(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int phi_handle,
+  const int phi_ref_handle,
+  const int control_volume_handle,
+  const LSMLIB_REAL cutoff,
+  const int phi_component,
+  const int phi_ref_component)
+{
+  LSMLIB_REAL max_norm_diff = 0;
+
+  // loop over PatchHierarchy and compute the max norm of (phi-phi_ref)
+  // near the zero level set by calling Fortran routines
+  const int num_levels = patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    // loop over the local patches (concurrently when OpenMP is enabled)
+    vector<int> patch_numbers;
+    getLocalPatchNumbers(level, patch_numbers);
+    const int num_patches = (int) patch_numbers.size();
+    vector<LSMLIB_REAL> max_norm_diff_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int pi = 0; pi < num_patches; pi++) { // loop over patches
+      const int pn = patch_numbers[pi];
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "maxNormOfDifferenceNearZeroLevelSet(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      // get pointers to data and index space ranges
+      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+        patch->getPatchData( phi_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > phi_ref_data =
+        patch->getPatchData( phi_ref_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > control_volume_data =
+        patch->getPatchData( control_volume_handle );
+  
+      Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+      const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
+      const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+
+      Box<DIM> phi_ref_ghostbox = phi_ref_data->getGhostBox();
+      const IntVector<DIM> phi_ref_ghostbox_lower = phi_ref_ghostbox.lower();
+      const IntVector<DIM> phi_ref_ghostbox_upper = phi_ref_ghostbox.upper();
+
+      Box<DIM> control_volume_ghostbox = 
+        control_volume_data->getGhostBox();
+      const IntVector<DIM> control_volume_ghostbox_lower = 
+        control_volume_ghostbox.lower();
+      const IntVector<DIM> control_volume_ghostbox_upper = 
+        control_volume_ghostbox.upper();
+
+      // interior box
+      Box<DIM> interior_box = phi_data->getBox();
+      const IntVector<DIM> interior_box_lower = interior_box.lower();
+      const IntVector<DIM> interior_box_upper = interior_box.upper();
+
+      LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
+      LSMLIB_REAL* phi_ref = phi_ref_data->getPointer(phi_ref_component);
+      LSMLIB_REAL* control_volume = control_volume_data->getPointer();
+
+      LSMLIB_REAL max_norm_diff_on_patch = 0.0;
+
+      if ( DIM == 3 ) {
+        LSM3D_MAX_NORM_DIFF_NEAR_INTERFACE_CONTROL_VOLUME(
+          &max_norm_diff_on_patch,
+          phi,
+          &phi_ghostbox_lower[0],
+          &phi_ghostbox_upper[0],
+          &phi_ghostbox_lower[1],
+          &phi_ghostbox_upper[1],
+          &phi_ghostbox_lower[2],
+          &phi_ghostbox_upper[2],
+          phi_ref,
+          &phi_ref_ghostbox_lower[0],
+          &phi_ref_ghostbox_upper[0],
+          &phi_ref_ghostbox_lower[1],
+          &phi_ref_ghostbox_upper[1],
+          &phi_ref_ghostbox_lower[2],
+          &phi_ref_ghostbox_upper[2],
+          control_volume,
+          &control_volume_ghostbox_lower[0],
+          &control_volume_ghostbox_upper[0],
+          &control_volume_ghostbox_lower[1],
+          &control_volume_ghostbox_upper[1],
+          &control_volume_ghostbox_lower[2],
+          &control_volume_ghostbox_upper[2],
+          &cutoff,
+          &interior_box_lower[0],
+          &interior_box_upper[0],
+          &interior_box_lower[1],
+          &interior_box_upper[1],
+          &interior_box_lower[2],
+          &interior_box_upper[2]);
+
+      } else if ( DIM == 2 ) {
+        LSM2D_MAX_NORM_DIFF_NEAR_INTERFACE_CONTROL_VOLUME(
+          &max_norm_diff_on_patch,
+          phi,
+          &phi_ghostbox_lower[0],
+          &phi_ghostbox_upper[0],
+          &phi_ghostbox_lower[1],
+          &phi_ghostbox_upper[1],
+          phi_ref,
+          &phi_ref_ghostbox_lower[0],
+          &phi_ref_ghostbox_upper[0],
+          &phi_ref_ghostbox_lower[1],
+          &phi_ref_ghostbox_upper[1],
+          control_volume,
+          &control_volume_ghostbox_lower[0],
+          &control_volume_ghostbox_upper[0],
+          &control_volume_ghostbox_lower[1],
+          &control_volume_ghostbox_upper[1],
+          &cutoff,
+          &interior_box_lower[0],
+          &interior_box_upper[0],
+          &interior_box_lower[1],
+          &interior_box_upper[1]);
+
+      } else if ( DIM == 1 ) {
+        LSM1D_MAX_NORM_DIFF_NEAR_INTERFACE_CONTROL_VOLUME(
+          &max_norm_diff_on_patch,
+          phi,
+          &phi_ghostbox_lower[0],
+          &phi_ghostbox_upper[0],
+          phi_ref,
+          &phi_ref_ghostbox_lower[0],
+          &phi_ref_ghostbox_upper[0],
+          control_volume,
+          &control_volume_ghostbox_lower[0],
+          &control_volume_ghostbox_upper[0],
+          &cutoff,
+          &interior_box_lower[0],
+          &interior_box_upper[0]);
+
+      } else {  // Unsupported dimension
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "maxNormOfDifferenceNearZeroLevelSet(): "
+                  << "Invalid value of DIM.  "
+                  << "Only DIM = 1, 2, and 3 are supported."
+                  << endl);
+      }
+
+      max_norm_diff_on_patches[pi] = max_norm_diff_on_patch;
 
     } // end loop over patches in level
+
+    // combine the patch contributions
+    for (int pi = 0; pi < num_patches; pi++) {
+      if (max_norm_diff < max_norm_diff_on_patches[pi])
+        max_norm_diff = max_norm_diff_on_patches[pi];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::maxReduction(max_norm_diff);
@@ -6688,6 +6533,36 @@ void LevelSetMethodToolbox<DIM>::computeControlVolumes(
 }
 
 
+/* computePatchDataMemoryUsage() */
+template <int DIM>
+size_t LevelSetMethodToolbox<DIM>::computePatchDataMemoryUsage(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const ComponentSelector& patch_data)
+{
+  size_t num_bytes = 0;
+
+  const int num_levels = patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    Pointer< PatchDescriptor<DIM> > descriptor = level->getPatchDescriptor();
+
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) {
+      const int pn = *pi;
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+
+      for (int id = 0; id < patch_data.getSize(); id++) {
+        if (patch_data.isSet(id)) {
+          num_bytes += descriptor->getPatchDataFactory(id)
+                         ->getSizeOfMemory(patch->getBox());
+        }
+      }
+    }
+  }
+
+  return num_bytes;
+}
+
 /* copySAMRAIData() */
 template <int DIM> 
 void LevelSetMethodToolbox<DIM>::copySAMRAIData(
@@ -6802,65 +6677,17 @@ void LevelSetMethodToolbox<DIM>::copySAMRAIData(
 }
 
 
-/* initializeComputeSpatialDerivativesParameters() */
+/* getLocalPatchNumbers() */
 template <int DIM>
-void LevelSetMethodToolbox<DIM>::initializeComputeSpatialDerivativesParameters()
+void LevelSetMethodToolbox<DIM>::getLocalPatchNumbers(
+  const Pointer< PatchLevel<DIM> > level,
+  vector<int>& patch_numbers)
 {
-  // do nothing if PatchData for grad(phi) has already been created
-  if (s_D1_one_ghostcell_handle >= 0) {
-    return;
-  }
-
-  // get pointer to VariableDatabase
-  VariableDatabase<DIM> *var_db = VariableDatabase<DIM>::getDatabase();
-
-  // create zero ghostcell width IntVector
-  IntVector<DIM> one_ghostcell_width(1);
-  IntVector<DIM> two_ghostcells_width(2);
-  IntVector<DIM> three_ghostcells_width(3);
-
-  // create Variables and VariableContext 
-  Pointer< CellVariable<DIM,LSMLIB_REAL> > D1_variable;
-  if (var_db->checkVariableExists("D1")) {
-    D1_variable = var_db->getVariable("D1");
-  } else {
-    D1_variable = new CellVariable<DIM,LSMLIB_REAL>("D1", 1);
-  }
-  Pointer< CellVariable<DIM,LSMLIB_REAL> > D2_variable;
-  if (var_db->checkVariableExists("D2")) {
-    D2_variable = var_db->getVariable("D2");
-  } else {
-    D2_variable = new CellVariable<DIM,LSMLIB_REAL>("D2", 1);
-  }
-  Pointer< CellVariable<DIM,LSMLIB_REAL> > D3_variable;
-  if (var_db->checkVariableExists("D3")) {
-    D3_variable = var_db->getVariable("D3");
-  } else {
-    D3_variable = new CellVariable<DIM,LSMLIB_REAL>("D3", 1);
+  patch_numbers.clear();
+  typename PatchLevel<DIM>::Iterator pi;
+  for (pi.initialize(level); pi; pi++) { 
+    patch_numbers.push_back(*pi);
   }
-  Pointer<VariableContext> one_ghostcell_context = 
-    var_db->getContext("LSM_TOOLBOX_SCRATCH::ONE_GHOSTCELL");
-  Pointer<VariableContext> two_ghostcells_context = 
-    var_db->getContext("LSM_TOOLBOX_SCRATCH::TWO_GHOSTCELLS");
-  Pointer<VariableContext> three_ghostcells_context = 
-    var_db->getContext("LSM_TOOLBOX_SCRATCH::THREE_GHOSTCELLS");
-
-  // register (Variable,VariableContext) pairs with VariableDatabase
-  s_D1_one_ghostcell_handle = var_db->registerVariableAndContext(
-    D1_variable, one_ghostcell_context, one_ghostcell_width);
-
-  s_D1_two_ghostcells_handle = var_db->registerVariableAndContext(
-    D1_variable, two_ghostcells_context, two_ghostcells_width);
-  s_D2_two_ghostcells_handle = var_db->registerVariableAndContext(
-    D2_variable, two_ghostcells_context, two_ghostcells_width);
-
-  s_D1_three_ghostcells_handle = var_db->registerVariableAndContext(
-    D1_variable, three_ghostcells_context, three_ghostcells_width);
-  s_D2_three_ghostcells_handle = var_db->registerVariableAndContext(
-    D2_variable, three_ghostcells_context, three_ghostcells_width);
-  s_D3_three_ghostcells_handle = var_db->registerVariableAndContext(
-    D3_variable, three_ghostcells_context, three_ghostcells_width);
-
 }
 
 
@@ -54,6 +54,17 @@
  *
  *       LevelSetMethodToolbox::function(...)
  *
+ *  - When LSMLIB is configured with --enable-openmp, the patches 
+ *    owned by each processor are processed concurrently (with dynamic 
+ *    scheduling) by the spatial derivative, TVD Runge-Kutta, unit 
+ *    normal (from grad(phi)), integral, stable time step and max norm
+ *    methods.  This allows one MPI process per socket (or node) to be 
+ *    used in place of one per core.  Per-patch results are combined in 
+ *    patch order before the MPI reduction, so the results do not depend
+ *    on the number of threads.  computeUnitNormalVectorFromPhi() and 
+ *    computeSignedUnitNormalVectorFromPhi() allocate scratch PatchData 
+ *    inside the patch loop and remain serial.
+ *
  */
 
 
@@ -202,6 +213,9 @@ public:
    *  - phi_handle (in):                PatchData handle for phi
    *  - phi_component (in):             component of phi for which to compute
    *                                    spatial derivatives (default = 0)
+   *  - fillbox_growth (in):            number of ghost cells of grad(phi)
+   *                                    in which to also compute the 
+   *                                    spatial derivatives (default = 0)
    *
    * Return value:                      none
    *
@@ -214,6 +228,11 @@ public:
    *    for phi is defined with a sufficent number of ghost cells to 
    *    support calculation of the selected ENO/WENO derivative in
    *    the interior of the PatchData for grad(phi).
+   *
+   *  - When fillbox_growth is positive, the PatchData for grad(phi) 
+   *    must have at least fillbox_growth ghost cells and the PatchData
+   *    for phi must have fillbox_growth more ghost cells than required 
+   *    to compute the derivatives in the interior.
    * 
    *  - For more details about the numerical discretizations used by 
    *    computePlusAndMinusSpatialDerivatives(), see "Level Set Methods 
@@ -227,7 +246,8 @@ public:
     const int grad_phi_plus_handle,
     const int grad_phi_minus_handle,
     const int phi_handle,
-    const int phi_component = 0);
+    const int phi_component = 0,
+    const int fillbox_growth = 0);
 
   /*!
    * computeCentralSpatialDerivatives() computes central approximations 
@@ -311,6 +331,8 @@ public:
    *                            (default = 0)
    *  - rhs_component (in):     component of rhs to use in step
    *                            (default = 0)
+   *  - fillbox_growth (in):    number of ghost cells in which to also
+   *                            advance u (default = 0)
    *
    * Return value:              none
    *
@@ -323,7 +345,8 @@ public:
     const LSMLIB_REAL dt,
     const int u_next_component = 0,
     const int u_cur_component = 0,
-    const int rhs_component = 0);
+    const int rhs_component = 0,
+    const int fillbox_growth = 0);
 
   /*!
    * TVDRK2Stage1() advances the solution through the first stage
@@ -342,6 +365,8 @@ public:
    *                              (default = 0)
    *  - rhs_component (in):       component of rhs to use in step
    *                              (default = 0)
+   *  - fillbox_growth (in):      number of ghost cells in which to also
+   *                              advance u (default = 0)
    *
    * Return value:                none
    *
@@ -354,7 +379,8 @@ public:
     const LSMLIB_REAL dt,
     const int u_stage1_component = 0,
     const int u_cur_component = 0,
-    const int rhs_component = 0);
+    const int rhs_component = 0,
+    const int fillbox_growth = 0);
 
   /*!
    * TVDRK2Stage2() completes advancing the solution through a 
@@ -376,6 +402,8 @@ public:
    *                              (default = 0)
    *  - rhs_component (in):       component of rhs to use in step
    *                              (default = 0)
+   *  - fillbox_growth (in):      number of ghost cells in which to also
+   *                              advance u (default = 0)
    *
    * Return value:                none
    *
@@ -390,7 +418,8 @@ public:
     const int u_next_component = 0,
     const int u_stage1_component = 0,
     const int u_cur_component = 0,
-    const int rhs_component = 0);
+    const int rhs_component = 0,
+    const int fillbox_growth = 0);
 
   /*!
    * TVDRK3Stage1() advances the solution through the first stage
@@ -409,6 +438,8 @@ public:
    *                              (default = 0)
    *  - rhs_component (in):       component of rhs to use in step
    *                              (default = 0)
+   *  - fillbox_growth (in):      number of ghost cells in which to also
+   *                              advance u (default = 0)
    *
    * Return value:                none
    *
@@ -421,7 +452,8 @@ public:
     const LSMLIB_REAL dt,
     const int u_stage1_component = 0,
     const int u_cur_component = 0,
-    const int rhs_component = 0);
+    const int rhs_component = 0,
+    const int fillbox_growth = 0);
 
   /*!
    * TVDRK3Stage2() advances the solution through the second stage
@@ -443,6 +475,8 @@ public:
    *                              (default = 0)
    *  - rhs_component (in):       component of rhs to use in step
    *                              (default = 0)
+   *  - fillbox_growth (in):      number of ghost cells in which to also
+   *                              advance u (default = 0)
    *
    * Return value:                none
    *
@@ -457,7 +491,8 @@ public:
     const int u_stage2_component = 0,
     const int u_stage1_component = 0,
     const int u_cur_component = 0,
-    const int rhs_component = 0);
+    const int rhs_component = 0,
+    const int fillbox_growth = 0);
 
   /*!
    * TVDRK3Stage3() completes advancing the solution through a 
@@ -479,6 +514,8 @@ public:
    *                              (default = 0)
    *  - rhs_component (in):       component of rhs to use in step
    *                              (default = 0)
+   *  - fillbox_growth (in):      number of ghost cells in which to also
+   *                              advance u (default = 0)
    *
    * Return value:                none
    *
@@ -493,7 +530,47 @@ public:
     const int u_next_component = 0,
     const int u_stage2_component = 0,
     const int u_cur_component = 0,
-    const int rhs_component = 0);
+    const int rhs_component = 0,
+    const int fillbox_growth = 0);
+
+  /*!
+   * LowStorageTVDRK3Stage2() advances the solution through the second
+   * stage of the third-order TVD Runge-Kutta method, overwriting the
+   * first stage approximation with the second stage approximation.
+   * Together with TVDRK3Stage1() and TVDRK3Stage3() (called with
+   * u_next_handle equal to u_cur_handle), it allows a TVD-RK3 step
+   * to be taken with a single scratch PatchData for u.
+   *
+   * Arguments:     
+   *  - hierarchy (in):           Pointer to PatchHierarchy containing
+   *                              data
+   *  - u_stage_handle (in/out):  PatchData handle for u_approx(t+dt) on
+   *                              input and u_approx(t+dt/2) on output
+   *  - u_cur_handle (in):        PatchData handle for u(t)
+   *  - rhs_handle (in):          PatchData handle for rhs(t)
+   *  - dt (in):                  time increment to advance u
+   *  - u_stage_component (in):   component of u_stage to use in step
+   *                              (default = 0)
+   *  - u_cur_component (in):     component of u_cur to use in step
+   *                              (default = 0)
+   *  - rhs_component (in):       component of rhs to use in step
+   *                              (default = 0)
+   *  - fillbox_growth (in):      number of ghost cells in which to also
+   *                              advance u (default = 0)
+   *
+   * Return value:                none
+   *
+   */
+  static void LowStorageTVDRK3Stage2(
+    Pointer< PatchHierarchy<DIM> > hierarchy,
+    const int u_stage_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_stage_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0,
+    const int fillbox_growth = 0);
 
   //! @}
 
@@ -532,24 +609,22 @@ public:
    * Return value:                        none
    *
    * NOTES:
-   *  - computeDistanceFunctionUsingFMM() currently is only implemented 
-   *    in 2D. Support for 3D calculations will be available in a future 
-   *    release.
+   *  - computeDistanceFunctionUsingFMM() is implemented in 2D and 3D.
    *
-   *  - computeDistanceFunctionUsingFMM() currently only supports 
-   *    first-order calculations.  Support for second-order calculations 
-   *    will be available in a future release.
-   *
-   *  - computeDistanceFunctionUsingFMM() currently only supports
-   *    calculation on a single patch.
+   *  - computeDistanceFunctionUsingFMM() supports first- and 
+   *    second-order calculations on single and multi-level 
+   *    hierarchies (see computeExtensionFieldsUsingFMM()).
    * 
    *  - The number of ghostcells for the PatchData of both the 
    *    distance function and the original level set function 
    *    are assumed to be the same.  If they are not, an 
    *    irrecoverable error is thrown.
    *
-   *  - Parallel computation of the distance function using the
-   *    fast marching method is currently NOT supported
+   *  - computeDistanceFunctionUsingFMM() is just a call to
+   *    computeExtensionFieldsUsingFMM() with no extension fields.
+   *    See the notes for computeExtensionFieldsUsingFMM() for a
+   *    description of how multiple patches and processors are
+   *    handled.
    *
    *  - For more details on the algorithm used by 
    *    computeDistanceFunctionsUsingFMM(), see "Level Set Methods 
@@ -603,20 +678,38 @@ public:
    * Return value:                        none
    *
    * NOTES:
-   *  - computeExtensionFieldsUsingFMM() currently only supports first-order
-   *    calculations.  Support for second-order calculations will be
-   *    available in a future release.
-   *
-   *  - computeExtensionFieldsUsingFMM() currently only supports
-   *    calculation on a single patch.
+   *  - computeExtensionFieldsUsingFMM() supports first- and second-order
+   *    calculations.  Higher values of spatial_derivative_order are
+   *    dropped to second-order.
+   *
+   *  - On multi-level hierarchies, the levels are processed from 
+   *    coarsest to finest.  On finer levels, the ghost cells at
+   *    coarse-fine boundaries are filled by linear interpolation of
+   *    the values on the next coarser level and used as boundary 
+   *    data.  Values on coarser levels are not corrected using the 
+   *    results on finer levels.
    * 
    *  - The number of ghostcells for the PatchData of the extension 
    *    fields, the distance function, the source fields, and the 
    *    original level set function are assumed to be the same.  If 
    *    they are not, an irrecoverable error is thrown. 
    *
-   *  - Parallel computation of the distance function using the
-   *    fast marching method is currently NOT supported 
+   *  - Calculations on multiple patches (possibly distributed across
+   *    multiple processors) are carried out by iterating patch-local
+   *    fast marching calculations.  After each pass, the ghost cells
+   *    of the distance function and extension fields are filled with 
+   *    the values computed on neighboring patches, and these values 
+   *    are used as boundary data for the next pass.  The iteration 
+   *    stops when the maximum change in the distance function and 
+   *    extension fields over all patches falls below LSMLIB_ZERO_TOL.  The number of passes
+   *    is bounded by the number of patches that must be crossed to 
+   *    reach the grid point farthest from the zero level set.
+   *
+   *  - The ghost cells of phi and the source fields MUST be filled 
+   *    before calling computeExtensionFieldsUsingFMM().
+   *
+   *  - The ghost cell exchange copies ALL components of the distance 
+   *    function and extension field PatchData.
    *
    *  - For more details on the algorithm used by 
    *    computeExtensionFieldsUsingFMM(), see "Level Set Methods 
@@ -1023,6 +1116,43 @@ public:
     const int field1_component = 0,
     const int field2_component = 0);
 
+  /*!
+   * maxNormOfDifferenceNearZeroLevelSet() computes the max norm of the 
+   * difference between a level set function and a reference level set 
+   * function in the cells near the zero level set of the reference
+   * (i.e. cells where |phi_ref| < cutoff).  When both level set 
+   * functions are (approximately) distance functions, the result is an
+   * estimate of the maximum distance that the zero level set has moved.
+   *
+   * Arguments:     
+   *  - hierarchy (in):              Pointer to PatchHierarchy containing
+   *                                 data
+   *  - phi_handle (in):             PatchData handle for level set 
+   *                                 function
+   *  - phi_ref_handle (in):         PatchData handle for reference level
+   *                                 set function
+   *  - control_volume_handle (in):  PatchData handle for control volume
+   *  - cutoff (in):                 only cells with |phi_ref| < cutoff 
+   *                                 are included in the calculation
+   *  - phi_component (in):          component of phi to use 
+   *                                 (default = 0)
+   *  - phi_ref_component (in):      component of phi_ref to use 
+   *                                 (default = 0)
+   *
+   * Return value:                   max norm of (phi - phi_ref) near the
+   *                                 zero level set of phi_ref (zero if 
+   *                                 there are no such cells)
+   *
+   */
+  static LSMLIB_REAL maxNormOfDifferenceNearZeroLevelSet(
+    Pointer< PatchHierarchy<DIM> > hierarchy,
+    const int phi_handle,
+    const int phi_ref_handle,
+    const int control_volume_handle,
+    const LSMLIB_REAL cutoff,
+    const int phi_component = 0,
+    const int phi_ref_component = 0);
+
   /*!
    * computeControlVolumes() computes the control volumes for the
    * cells in the specified PatchHierarchy.
@@ -1040,6 +1170,27 @@ public:
     Pointer< PatchHierarchy<DIM> > patch_hierarchy,
     int control_volume_handle);
 
+  /*!
+   * computePatchDataMemoryUsage() computes the number of bytes of 
+   * memory required by the PatchData selected by the ComponentSelector 
+   * on the local patches of the specified PatchHierarchy.
+   *
+   * Arguments:
+   *  - patch_hierarchy (in):  PatchHierarchy containing data
+   *  - patch_data (in):       ComponentSelector for PatchData 
+   *
+   * Return value:             number of bytes on this processor
+   *
+   * NOTES:
+   *  - The memory usage is computed from the PatchDataFactory of each
+   *    selected PatchData component, so the PatchData need not be 
+   *    allocated.
+   *
+   */
+  static size_t computePatchDataMemoryUsage(
+    Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+    const ComponentSelector& patch_data);
+
   /*!
    * copySAMRAIData() copies data from the PatchData associated
    * with the source handle to the PatchData associated with the 
@@ -1080,26 +1231,32 @@ protected:
    ******************************************************************/
 
   /*!
-   * initializeComputeSpatialDerivativesParameters() sets up the 
-   * parameters required for computing spatial derivatives.
+   * initializeComputeUnitNormalParameters() sets up the parameters
+   * required for computing the unit normal vector.
    *
    * Arguments:     none
    *
    * Return value:  none
    *
    */
-  static void initializeComputeSpatialDerivativesParameters();
+  static void initializeComputeUnitNormalParameters();
 
   /*!
-   * initializeComputeUnitNormalParameters() sets up the parameters
-   * required for computing the unit normal vector.
+   * getLocalPatchNumbers() fills patch_numbers with the numbers of
+   * the patches on the specified level that are owned by this 
+   * processor (in the order that they are visited by the 
+   * PatchLevel iterator).
    *
-   * Arguments:     none
+   * Arguments:     
+   *  - level (in):            PatchLevel
+   *  - patch_numbers (out):   numbers of the local patches
    *
    * Return value:  none
    *
    */
-  static void initializeComputeUnitNormalParameters();
+  static void getLocalPatchNumbers(
+    const Pointer< PatchLevel<DIM> > level,
+    vector<int>& patch_numbers);
 
   //! @}
 
@@ -1109,15 +1266,6 @@ protected:
    *
    ******************************************************************/
 
-  // Parameters for computing spatial derivatives
-  // NOTE:  these are set up as needed.
-  static int s_D1_one_ghostcell_handle;
-  static int s_D1_two_ghostcells_handle;
-  static int s_D2_two_ghostcells_handle;
-  static int s_D1_three_ghostcells_handle;
-  static int s_D2_three_ghostcells_handle;
-  static int s_D3_three_ghostcells_handle;
-
   // Parameters for computing unit normal vector 
   // NOTE:  these are set up as needed.
   static int s_compute_normal_grad_phi_handle;
@@ -78,6 +78,9 @@ ReinitializationAlgorithm<DIM>::ReinitializationAlgorithm(
   // create empty BoundaryConditionModule
   d_bc_module = new BoundaryConditionModule<DIM>;
 
+  // no persistent scratch data has been allocated yet
+  d_persistent_scratch_data_bytes = 0;
+
   // initialize variables and communication objects
   initializeVariables();
   initializeCommunicationObjects();
@@ -99,7 +102,10 @@ ReinitializationAlgorithm<DIM>::ReinitializationAlgorithm(
   const int max_iterations,
   const LSMLIB_REAL iteration_stop_tolerance,
   const bool verbose_mode,
-  const string& object_name)
+  const string& object_name,
+  const int ghostcell_exchange_interval,
+  const int convergence_check_interval,
+  const bool batch_ghostcell_fills)
 {
   // set object_name
   d_object_name = object_name;
@@ -155,16 +161,26 @@ ReinitializationAlgorithm<DIM>::ReinitializationAlgorithm(
     }
   }
 
+  // set communication parameters
+  d_ghostcell_exchange_interval = ghostcell_exchange_interval;
+  d_convergence_check_interval = convergence_check_interval;
+  d_batch_ghostcell_fills = batch_ghostcell_fills;
 
   // set verbose-mode
   d_verbose_mode = verbose_mode;
 
+  // scratch data is allocated for each calculation by default
+  d_use_persistent_scratch_data = LSM_DEFAULT_USE_PERSISTENT_SCRATCH_DATA;
+
   // check that the user-specifeid parameters are acceptable
   checkParameters();
 
   // create empty BoundaryConditionModule
   d_bc_module = new BoundaryConditionModule<DIM>;
 
+  // no persistent scratch data has been allocated yet
+  d_persistent_scratch_data_bytes = 0;
+
   // initialize variables and communication objects
   initializeVariables();
   initializeCommunicationObjects();
@@ -186,11 +202,51 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
       0, d_patch_hierarchy->getFinestLevelNumber());
   }
 
+  /*
+   *  compute the number of components in the level set data
+   *  (if it has not already been computed) 
+   */
+  if (d_num_phi_components == 0) {
+    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(0);
+
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) { // loop over patches
+      const int pn = *pi;
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  d_object_name
+                  << "::reinitializeLevelSetFunctions(): " 
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+  
+      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data = 
+        patch->getPatchData( d_phi_handle );
+      d_num_phi_components = phi_data->getDepth();
+  
+      break;  // only need PatchData from one patch for computation
+    }
+  }
+
+  // with deep ghost cells, the scratch data holds the state of a single
+  // component between ghost cell exchanges, so the components are 
+  // reinitialized one at a time
+  if (d_ghostcell_exchange_interval > 0) {
+    for (int component = 0; component < d_num_phi_components; component++) {
+      reinitializeLevelSetFunctionForSingleComponent(
+        component, max_iterations, lower_bc, upper_bc);
+    }
+    return;
+  }
+
   // allocate patch data for required to reinitialize level set function
   const int num_levels = d_patch_hierarchy->getNumberLevels();
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
-    level->allocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(d_scratch_data);
+    }
   }
 
   /*
@@ -232,33 +288,6 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
   } 
 
 
-  /*
-   *  compute the number of components in the level set data
-   *  (if it has not already been computed) 
-   */
-  if (d_num_phi_components == 0) {
-    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(0);
-
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
-      Pointer< Patch<DIM> > patch = level->getPatch(pn);
-      if ( patch.isNull() ) {
-        TBOX_ERROR(  d_object_name
-                  << "::reinitializeLevelSetFunctions(): " 
-                  << "Cannot find patch. Null patch pointer."
-                  << endl);
-      }
-  
-      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data = 
-        patch->getPatchData( d_phi_handle );
-      d_num_phi_components = phi_data->getDepth();
-  
-      break;  // only need PatchData from one patch for computation
-    }
-  }
-
-
   /*
    *  main reinitialization loop
    */
@@ -266,30 +295,45 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
   LSMLIB_REAL delta = 1.0;
   const int phi_handle_after_step = d_phi_handle;
   const int phi_handle_before_step = d_phi_scr_handles[0];
+  const bool batch_ghostcell_fills = 
+    d_batch_ghostcell_fills && (d_num_phi_components > 1);
+  const int num_advances = 
+    (batch_ghostcell_fills ? 1 : d_num_phi_components);
   while ( (count < num_steps) &&
           (!d_use_iteration_stop_tol || (delta > d_iteration_stop_tol)) ) {
 
+    // only compute the change in the level set functions (which requires
+    // a global reduction) every d_convergence_check_interval iterations 
+    // and on the last iteration
+    const bool check_convergence = d_use_iteration_stop_tol && 
+      ( (0 == (count+1)%d_convergence_check_interval) || 
+        (count+1 == num_steps) );
+
     // reset delta to zero
-    delta = 0.0;
+    if (check_convergence) delta = 0.0;
 
-    // loop over components in level set function
-    for (int component = 0; component < d_num_phi_components; component++) {
+    // loop over components in level set function (when the ghost cell
+    // fills are batched, all components are advanced by a single call
+    // that fills their ghost cells together)
+    for (int component = 0; component < num_advances; component++) {
+
+      const int advance_component = (batch_ghostcell_fills ? -1 : component);
 
       // advance reinitialization equation using TVD Runge-Kutta 
       switch(d_tvd_runge_kutta_order) {
         case 1: { // first-order TVD RK (e.g. Forward Euler)
           advanceReinitializationEqnUsingTVDRK1(
-            dt, component, lower_bc, upper_bc);
+            dt, advance_component, lower_bc, upper_bc);
           break;
         }
         case 2: { // second-order TVD RK 
           advanceReinitializationEqnUsingTVDRK2(
-            dt, component, lower_bc, upper_bc);
+            dt, advance_component, lower_bc, upper_bc);
           break;
         }
         case 3: { // third-order TVD RK 
           advanceReinitializationEqnUsingTVDRK3(
-            dt, component, lower_bc, upper_bc);
+            dt, advance_component, lower_bc, upper_bc);
           break;
         }
         default: { // UNSUPPORTED ORDER
@@ -302,13 +346,18 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
       } // end switch on TVD Runge-Kutta order
 
       // update count and delta
-      if (d_use_iteration_stop_tol) {
-        delta += LevelSetMethodToolbox<DIM>::maxNormOfDifference(
-          d_patch_hierarchy, phi_handle_after_step, phi_handle_before_step, 
-          d_control_volume_handle, component, 0);  // 0 is component of field
-                                                   // before the time step
-                                                   // which is just a single
-                                                   // component scratch space
+      // NOTE: the field before the time step is stored in component 0 of
+      //       the scratch space unless the ghost cell fills are batched
+      if (check_convergence) {
+        const int comp_lo = (batch_ghostcell_fills ? 0 : component);
+        const int comp_hi = 
+          (batch_ghostcell_fills ? d_num_phi_components : component+1);
+        for (int comp = comp_lo; comp < comp_hi; comp++) {
+          delta += LevelSetMethodToolbox<DIM>::maxNormOfDifference(
+            d_patch_hierarchy, phi_handle_after_step, phi_handle_before_step,
+            d_control_volume_handle, comp, 
+            (batch_ghostcell_fills ? comp : 0));
+        }
       }
     } // end loop over components of level set function
 
@@ -320,7 +369,7 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
         pout << "  Level set functions reinitialized to a distance "
              << "of approximately " << dt*count << endl;
       }
-      if (d_use_iteration_stop_tol) {
+      if (check_convergence) {
         pout << "  Max norm of change in level set functions: "
              << delta << endl;
       }
@@ -355,9 +404,12 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
   }
 
   // deallocate patch data that was allocated for reinitialization 
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
-    level->deallocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData(d_scratch_data);
+    }
   }
 }
 
@@ -380,9 +432,12 @@ void ReinitializationAlgorithm<DIM>::
 
   // allocate patch data for required for reinitialization calculation
   const int num_levels = d_patch_hierarchy->getNumberLevels();
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
-    level->allocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(d_scratch_data);
+    }
   }
 
   /*
@@ -434,41 +489,59 @@ void ReinitializationAlgorithm<DIM>::
   while ( (count < num_steps) &&
           (!d_use_iteration_stop_tol || (delta > d_iteration_stop_tol)) ) {
 
-    // advance reinitialization equation using TVD Runge-Kutta 
-    switch(d_tvd_runge_kutta_order) {
-      case 1: { // first-order TVD RK (e.g. Forward Euler)
-        advanceReinitializationEqnUsingTVDRK1(
-          dt, component, lower_bc, upper_bc);
-        break;
-      }
-      case 2: { // second-order TVD RK 
-        advanceReinitializationEqnUsingTVDRK2(
-          dt, component, lower_bc, upper_bc);
-        break;
-      }
-      case 3: { // third-order TVD RK 
-        advanceReinitializationEqnUsingTVDRK3(
-          dt, component, lower_bc, upper_bc);
-        break;
-      }
-      default: { // UNSUPPORTED ORDER
-        TBOX_ERROR(  d_object_name
-                  << "::reinitializeLevelSetFunctionForSingleComponent(): " 
-                  << "Unsupported TVD Runge-Kutta order.  "
-                  << "Only TVD-RK1, TVD-RK2, and TVD-RK3 supported."
-                  << endl);
+    // only compute the change in the level set function (which requires
+    // a global reduction) every d_convergence_check_interval iterations 
+    // and on the last iteration
+    const bool check_convergence = d_use_iteration_stop_tol && 
+      ( (0 == (count+1)%d_convergence_check_interval) || 
+        (count+1 == num_steps) );
+
+    // advance reinitialization equation with deep ghost cells
+    if (d_ghostcell_exchange_interval > 0) {
+
+      LSMLIB_REAL change = advanceReinitializationEqnUsingDeepGhostcells(
+        dt, component, count, check_convergence, lower_bc, upper_bc);
+      if (check_convergence) delta = change;
+
+    } else {
+
+      // advance reinitialization equation using TVD Runge-Kutta 
+      switch(d_tvd_runge_kutta_order) {
+        case 1: { // first-order TVD RK (e.g. Forward Euler)
+          advanceReinitializationEqnUsingTVDRK1(
+            dt, component, lower_bc, upper_bc);
+          break;
+        }
+        case 2: { // second-order TVD RK 
+          advanceReinitializationEqnUsingTVDRK2(
+            dt, component, lower_bc, upper_bc);
+          break;
+        }
+        case 3: { // third-order TVD RK 
+          advanceReinitializationEqnUsingTVDRK3(
+            dt, component, lower_bc, upper_bc);
+          break;
+        }
+        default: { // UNSUPPORTED ORDER
+          TBOX_ERROR(  d_object_name
+                    << "::reinitializeLevelSetFunctionForSingleComponent(): " 
+                    << "Unsupported TVD Runge-Kutta order.  "
+                    << "Only TVD-RK1, TVD-RK2, and TVD-RK3 supported."
+                    << endl);
+        }
+      } // end switch on TVD Runge-Kutta order
+
+      // update count and delta
+      if (check_convergence) {
+        delta = LevelSetMethodToolbox<DIM>::maxNormOfDifference(
+          d_patch_hierarchy, phi_handle_after_step, phi_handle_before_step, 
+          d_control_volume_handle, component, 0);  // 0 is component of field
+                                                   // before the time step
+                                                   // which is just a single
+                                                   // component scratch space
       }
-    } // end switch on TVD Runge-Kutta order
-
-    // update count and delta
-    if (d_use_iteration_stop_tol) {
-      delta = LevelSetMethodToolbox<DIM>::maxNormOfDifference(
-        d_patch_hierarchy, phi_handle_after_step, phi_handle_before_step, 
-        d_control_volume_handle, component, 0);  // 0 is component of field
-                                                 // before the time step
-                                                 // which is just a single
-                                                 // component scratch space
-    }
+
+    } // end case: ghost cells filled before every stage
 
     // VERBOSE MODE
     if (d_verbose_mode) {
@@ -478,7 +551,7 @@ void ReinitializationAlgorithm<DIM>::
         pout << "  Level set functions reinitialized to a distance "
              << "of approximately " << dt*count << endl;
       }
-      if (d_use_iteration_stop_tol) {
+      if (check_convergence) {
         pout << "  Max norm of change in level set function: "
              << delta << endl;
       }
@@ -513,9 +586,12 @@ void ReinitializationAlgorithm<DIM>::
   }
 
   // deallocate patch data that was allocated for reinitialization calculation
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
-    level->deallocatePatchData(d_scratch_data);
+  if (!d_use_persistent_scratch_data) {
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      Pointer< PatchLevel<DIM> > level = 
+        d_patch_hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData(d_scratch_data);
+    }
   }
 }
 
@@ -558,11 +634,61 @@ void ReinitializationAlgorithm<DIM>::resetHierarchyConfiguration(
     finest_level,
     d_phi_scratch_ghostcell_width);
 
+  // (re)allocate persistent scratch data on the levels that changed
+  if (d_use_persistent_scratch_data) {
+    for (int ln = coarsest_level; ln <= finest_level; ln++) {
+      Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
+      level->deallocatePatchData(d_scratch_data);
+      level->allocatePatchData(d_scratch_data);
+    }
+    d_persistent_scratch_data_bytes = 
+      LevelSetMethodToolbox<DIM>::computePatchDataMemoryUsage(
+        hierarchy, d_scratch_data);
+  }
+
   // set d_hierarchy_configuration_needs_reset to (finest_level < 0)
   d_hierarchy_configuration_needs_reset = (finest_level < 0);
 }
 
 
+/* setUsePersistentScratchData() */
+template <int DIM>
+void ReinitializationAlgorithm<DIM>::setUsePersistentScratchData(
+  const bool use_persistent_scratch_data)
+{
+  if (use_persistent_scratch_data == d_use_persistent_scratch_data) return;
+  d_use_persistent_scratch_data = use_persistent_scratch_data;
+
+  // allocate or free scratch data on all levels
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+    Pointer< PatchLevel<DIM> > level = 
+      d_patch_hierarchy->getPatchLevel(ln);
+    if (d_use_persistent_scratch_data) {
+      level->allocatePatchData(d_scratch_data);
+    } else {
+      level->deallocatePatchData(d_scratch_data);
+    }
+  }
+
+  if (d_use_persistent_scratch_data) {
+    d_persistent_scratch_data_bytes = 
+      LevelSetMethodToolbox<DIM>::computePatchDataMemoryUsage(
+        d_patch_hierarchy, d_scratch_data);
+  } else {
+    d_persistent_scratch_data_bytes = 0;
+  }
+}
+
+
+/* getPersistentScratchDataBytes() */
+template <int DIM>
+size_t ReinitializationAlgorithm<DIM>::getPersistentScratchDataBytes() const
+{
+  return d_persistent_scratch_data_bytes;
+}
+
+
 /* advanceReinitializationEqnUsingTVDRK1() */
 template <int DIM> 
 void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK1(
@@ -575,15 +701,27 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK1(
   // NOTE: the rk_stage begins at 0 for convenience
   int rk_stage = 0;
 
+  // determine components to advance
+  // NOTE: when all components are advanced together (phi_component < 0),
+  //       component comp of phi is stored in component comp of the 
+  //       scratch space.  Otherwise, it is stored in component 0.
+  const bool all_components = (phi_component < 0);
+  const int comp_lo = (all_components ? 0 : phi_component);
+  const int comp_hi = (all_components ? d_num_phi_components 
+                                      : phi_component+1);
+  const int bc_component = (all_components ? -1 : 0);
+
   /*
    * fill scratch space for time advance
    */
 
-  // copy component of field data to scratch space
-  LevelSetMethodToolbox<DIM>::copySAMRAIData(
-    d_patch_hierarchy,
-    d_phi_scr_handles[0], d_phi_handle,
-    0, phi_component);
+  // copy components of field data to scratch space
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    LevelSetMethodToolbox<DIM>::copySAMRAIData(
+      d_patch_hierarchy,
+      d_phi_scr_handles[0], d_phi_handle,
+      (all_components ? comp : 0), comp);
+  }
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
@@ -597,16 +735,19 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK1(
     upper_bc,
     d_spatial_derivative_type,
     d_spatial_derivative_order,
-    0);
+    bc_component);
 
   // advance reinitialization equation through TVD-RK1 step
-  computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage]);
-  LevelSetMethodToolbox<DIM>::TVDRK1Step(
-    d_patch_hierarchy,
-    d_phi_handle,
-    d_phi_scr_handles[rk_stage], 
-    d_rhs_handle, dt,
-    phi_component, 0, 0); // components of PatchData to use in TVD-RK1 step
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    const int scr_comp = (all_components ? comp : 0);
+    computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage], 0, scr_comp);
+    LevelSetMethodToolbox<DIM>::TVDRK1Step(
+      d_patch_hierarchy,
+      d_phi_handle,
+      d_phi_scr_handles[rk_stage], 
+      d_rhs_handle, dt,
+      comp, scr_comp, 0); // components of PatchData to use in TVD-RK1 step
+  }
 }
 
 
@@ -618,6 +759,13 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK2(
   const IntVector<DIM>& lower_bc,
   const IntVector<DIM>& upper_bc)
 {
+  // determine components to advance (see TVDRK1 NOTE)
+  const bool all_components = (phi_component < 0);
+  const int comp_lo = (all_components ? 0 : phi_component);
+  const int comp_hi = (all_components ? d_num_phi_components 
+                                      : phi_component+1);
+  const int bc_component = (all_components ? -1 : 0);
+
   // { begin Stage 1
 
   // initialize counter for current stage of TVD RK step
@@ -628,11 +776,13 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK2(
    * fill scratch space for first stage of time advance
    */
 
-  // copy component of field data to scratch space
-  LevelSetMethodToolbox<DIM>::copySAMRAIData(
-    d_patch_hierarchy,
-    d_phi_scr_handles[0], d_phi_handle,
-    0, phi_component);
+  // copy components of field data to scratch space
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    LevelSetMethodToolbox<DIM>::copySAMRAIData(
+      d_patch_hierarchy,
+      d_phi_scr_handles[0], d_phi_handle,
+      (all_components ? comp : 0), comp);
+  }
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
@@ -646,16 +796,20 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK2(
     upper_bc,
     d_spatial_derivative_type,
     d_spatial_derivative_order,
-    0);
+    bc_component);
 
   // advance reinitialization equation through the first stage of TVD-RK2
-  computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage]);
-  LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
-    d_patch_hierarchy,
-    d_phi_scr_handles[rk_stage+1],
-    d_phi_scr_handles[rk_stage],
-    d_rhs_handle, dt,
-    0, 0, 0);  // components of PatchData to use in TVD-RK2 step
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    const int scr_comp = (all_components ? comp : 0);
+    computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage], 0, scr_comp);
+    LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
+      d_patch_hierarchy,
+      d_phi_scr_handles[rk_stage+1],
+      d_phi_scr_handles[rk_stage],
+      d_rhs_handle, dt,
+      scr_comp, scr_comp, 0);  // components of PatchData to use in TVD-RK2
+                               // step
+  }
 
   // } end Stage 1
 
@@ -677,17 +831,21 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK2(
     upper_bc,
     d_spatial_derivative_type,
     d_spatial_derivative_order,
-    0);
+    bc_component);
 
   // advance reinitialization equation through the second stage of TVD-RK2
-  computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage]);
-  LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
-    d_patch_hierarchy,
-    d_phi_handle,
-    d_phi_scr_handles[rk_stage],
-    d_phi_scr_handles[0],
-    d_rhs_handle, dt,
-    phi_component, 0, 0, 0);  // components of PatchData to use in TVD-RK2 step
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    const int scr_comp = (all_components ? comp : 0);
+    computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage], 0, scr_comp);
+    LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
+      d_patch_hierarchy,
+      d_phi_handle,
+      d_phi_scr_handles[rk_stage],
+      d_phi_scr_handles[0],
+      d_rhs_handle, dt,
+      comp, scr_comp, scr_comp, 0);  // components of PatchData to use in 
+                                     // TVD-RK2 step
+  }
 
   // } end Stage 2
 }
@@ -701,6 +859,13 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
   const IntVector<DIM>& lower_bc,
   const IntVector<DIM>& upper_bc)
 {
+  // determine components to advance (see TVDRK1 NOTE)
+  const bool all_components = (phi_component < 0);
+  const int comp_lo = (all_components ? 0 : phi_component);
+  const int comp_hi = (all_components ? d_num_phi_components 
+                                      : phi_component+1);
+  const int bc_component = (all_components ? -1 : 0);
+
   // { begin Stage 1
 
   // initialize counter for current stage of TVD RK step
@@ -711,11 +876,13 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
    * fill scratch space for first stage of time advance
    */
 
-  // copy component of field data to scratch space
-  LevelSetMethodToolbox<DIM>::copySAMRAIData(
-    d_patch_hierarchy,
-    d_phi_scr_handles[0], d_phi_handle,
-    0, phi_component);
+  // copy components of field data to scratch space
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    LevelSetMethodToolbox<DIM>::copySAMRAIData(
+      d_patch_hierarchy,
+      d_phi_scr_handles[0], d_phi_handle,
+      (all_components ? comp : 0), comp);
+  }
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
@@ -729,16 +896,20 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
     upper_bc,
     d_spatial_derivative_type,
     d_spatial_derivative_order,
-    0);
+    bc_component);
 
   // advance reinitialization equation through the first stage of TVD-RK3
-  computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage]);
-  LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
-    d_patch_hierarchy,
-    d_phi_scr_handles[rk_stage+1],
-    d_phi_scr_handles[rk_stage],
-    d_rhs_handle, dt,
-    0, 0, 0);  // components of PatchData to use in TVD-RK3 step
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    const int scr_comp = (all_components ? comp : 0);
+    computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage], 0, scr_comp);
+    LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
+      d_patch_hierarchy,
+      d_phi_scr_handles[rk_stage+1],
+      d_phi_scr_handles[rk_stage],
+      d_rhs_handle, dt,
+      scr_comp, scr_comp, 0);  // components of PatchData to use in TVD-RK3
+                               // step
+  }
 
   // } end Stage 1
 
@@ -760,17 +931,21 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
     upper_bc,
     d_spatial_derivative_type,
     d_spatial_derivative_order,
-    0);
+    bc_component);
 
   // advance reinitialization equation through the second stage of TVD-RK3
-  computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage]);
-  LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
-    d_patch_hierarchy,
-    d_phi_scr_handles[rk_stage+1],
-    d_phi_scr_handles[rk_stage],
-    d_phi_scr_handles[rk_stage-1],
-    d_rhs_handle, dt,
-    0, 0, 0, 0);  // components of PatchData to use in TVD-RK3 step
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    const int scr_comp = (all_components ? comp : 0);
+    computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage], 0, scr_comp);
+    LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
+      d_patch_hierarchy,
+      d_phi_scr_handles[rk_stage+1],
+      d_phi_scr_handles[rk_stage],
+      d_phi_scr_handles[rk_stage-1],
+      d_rhs_handle, dt,
+      scr_comp, scr_comp, scr_comp, 0);  // components of PatchData to use 
+                                         // in TVD-RK3 step
+  }
 
   // } end Stage 2
 
@@ -792,26 +967,178 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
     upper_bc,
     d_spatial_derivative_type,
     d_spatial_derivative_order,
-    0);
+    bc_component);
 
   // advance reinitialization equation through the third stage of TVD-RK3
-  computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage]);
-  LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
-    d_patch_hierarchy,
-    d_phi_handle,
-    d_phi_scr_handles[rk_stage],
-    d_phi_scr_handles[0],
-    d_rhs_handle, dt,
-    phi_component, 0, 0, 0);  // components of PatchData to use in TVD-RK3 step
+  for (int comp = comp_lo; comp < comp_hi; comp++) {
+    const int scr_comp = (all_components ? comp : 0);
+    computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage], 0, scr_comp);
+    LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
+      d_patch_hierarchy,
+      d_phi_handle,
+      d_phi_scr_handles[rk_stage],
+      d_phi_scr_handles[0],
+      d_rhs_handle, dt,
+      comp, scr_comp, scr_comp, 0);  // components of PatchData to use in 
+                                     // TVD-RK3 step
+  }
 
   // } end Stage 3
 }
 
 
+/* advanceReinitializationEqnUsingDeepGhostcells() */
+template <int DIM> 
+LSMLIB_REAL ReinitializationAlgorithm<DIM>::
+  advanceReinitializationEqnUsingDeepGhostcells(
+    const LSMLIB_REAL dt,
+    const int phi_component,
+    const int iteration,
+    const bool compute_change,
+    const IntVector<DIM>& lower_bc,
+    const IntVector<DIM>& upper_bc)
+{
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  const int num_stages = d_tvd_runge_kutta_order;
+
+  // number of iterations since the ghost cells were last filled
+  const int block_iteration = iteration%d_ghostcell_exchange_interval;
+
+  /*
+   * fill scratch space (including all ghost cells) at the beginning 
+   * of each block of iterations
+   */
+  if (0 == block_iteration) {
+
+    // copy component of field data to scratch space
+    LevelSetMethodToolbox<DIM>::copySAMRAIData(
+      d_patch_hierarchy,
+      d_phi_scr_handles[0], d_phi_handle,
+      0, phi_component);
+
+    for ( int ln=0 ; ln < num_levels; ln++ ) {
+      // NOTE: 0.0 is "current time" and true indicates that physical 
+      //       boundary conditions should be set.
+      d_phi_fill_bdry_sched[0][ln]->fillData(0.0,true);
+    }
+    d_bc_module->imposeBoundaryConditions(
+      d_phi_scr_handles[0], 
+      lower_bc,
+      upper_bc,
+      d_spatial_derivative_type,
+      d_spatial_derivative_order,
+      0);
+  }
+
+  // number of ghost cells in which the scratch data is still valid 
+  // at the beginning of this step
+  int valid_width = d_phi_scratch_ghostcell_width(0) 
+                  - block_iteration*num_stages*d_stencil_width;
+
+  /*
+   * advance the TVD Runge-Kutta stages on the patch interiors and the 
+   * valid part of the ghost cell region.  The input for stage k is in
+   * d_phi_scr_handles[k]; the result of the last stage overwrites
+   * d_phi_scr_handles[0].
+   */
+  for (int rk_stage = 0; rk_stage < num_stages; rk_stage++) {
+
+    const int fillbox_growth = valid_width - d_stencil_width;
+    const int u_next_handle = (rk_stage+1 < num_stages) ? 
+      d_phi_scr_handles[rk_stage+1] : d_phi_scr_handles[0];
+
+    computeReinitializationEqnRHS(d_phi_scr_handles[rk_stage], 
+                                  fillbox_growth);
+
+    if (1 == num_stages) {
+      LevelSetMethodToolbox<DIM>::TVDRK1Step(
+        d_patch_hierarchy,
+        u_next_handle,
+        d_phi_scr_handles[0], 
+        d_rhs_handle, dt,
+        0, 0, 0, fillbox_growth);
+    } else if (2 == num_stages) {
+      if (0 == rk_stage) {
+        LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
+          d_patch_hierarchy,
+          u_next_handle,
+          d_phi_scr_handles[0],
+          d_rhs_handle, dt,
+          0, 0, 0, fillbox_growth);
+      } else {
+        LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
+          d_patch_hierarchy,
+          u_next_handle,
+          d_phi_scr_handles[1],
+          d_phi_scr_handles[0],
+          d_rhs_handle, dt,
+          0, 0, 0, 0, fillbox_growth);
+      }
+    } else {
+      if (0 == rk_stage) {
+        LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
+          d_patch_hierarchy,
+          u_next_handle,
+          d_phi_scr_handles[0],
+          d_rhs_handle, dt,
+          0, 0, 0, fillbox_growth);
+      } else if (1 == rk_stage) {
+        LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
+          d_patch_hierarchy,
+          u_next_handle,
+          d_phi_scr_handles[1],
+          d_phi_scr_handles[0],
+          d_rhs_handle, dt,
+          0, 0, 0, 0, fillbox_growth);
+      } else {
+        LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
+          d_patch_hierarchy,
+          u_next_handle,
+          d_phi_scr_handles[2],
+          d_phi_scr_handles[0],
+          d_rhs_handle, dt,
+          0, 0, 0, 0, fillbox_growth);
+      }
+    }
+
+    // physical boundary conditions only involve local data, so they 
+    // are imposed after every stage
+    d_bc_module->imposeBoundaryConditions(
+      u_next_handle, 
+      lower_bc,
+      upper_bc,
+      d_spatial_derivative_type,
+      d_spatial_derivative_order,
+      0);
+
+    valid_width = fillbox_growth;
+  }
+
+  // compute the change in the level set function (phi still contains 
+  // the level set function from the beginning of the step)
+  LSMLIB_REAL change = 0.0;
+  if (compute_change) {
+    change = LevelSetMethodToolbox<DIM>::maxNormOfDifference(
+      d_patch_hierarchy, d_phi_scr_handles[0], d_phi_handle,
+      d_control_volume_handle, 0, phi_component);
+  }
+
+  // copy result back into phi
+  LevelSetMethodToolbox<DIM>::copySAMRAIData(
+    d_patch_hierarchy,
+    d_phi_handle, d_phi_scr_handles[0],
+    phi_component, 0);
+
+  return change;
+}
+
+
 /* computeReinitializationEqnRHS() */
 template <int DIM> 
 void ReinitializationAlgorithm<DIM>::computeReinitializationEqnRHS( 
-  const int phi_handle)
+  const int phi_handle,
+  const int fillbox_growth,
+  const int phi_component)
 {
 
   // compute spatial derivatives for the current stage
@@ -821,7 +1148,8 @@ void ReinitializationAlgorithm<DIM>::computeReinitializationEqnRHS(
     d_spatial_derivative_order,
     d_grad_phi_plus_handle,
     d_grad_phi_minus_handle,
-    phi_handle);
+    phi_handle,
+    phi_component, fillbox_growth);
 
   // loop over PatchHierarchy and compute RHS for level set equation
   // by calling Fortran routines
@@ -873,11 +1201,12 @@ void ReinitializationAlgorithm<DIM>::computeReinitializationEqnRHS(
 
       // fill box
       Box<DIM> fillbox = rhs_data->getBox();
+      fillbox.grow(IntVector<DIM>(fillbox_growth));
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
       LSMLIB_REAL* rhs = rhs_data->getPointer();
-      LSMLIB_REAL* phi = phi_data->getPointer();
+      LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
       LSMLIB_REAL* grad_phi_plus[LSM_DIM_MAX];
       LSMLIB_REAL* grad_phi_minus[LSM_DIM_MAX];
       for (int dim = 0; dim < DIM; dim++) {
@@ -1045,9 +1374,20 @@ void ReinitializationAlgorithm<DIM>::initializeVariables()
                 << endl );
   }
 
-  d_phi_scratch_ghostcell_width = 
-    IntVector<DIM>(scratch_ghostcell_width_for_grad);
-  IntVector<DIM> zero_ghostcell_width(0);
+  // with deep ghost cells, the scratch data must hold enough ghost 
+  // cells for ghostcell_exchange_interval TVD Runge-Kutta steps and the
+  // gradient and RHS data are also computed in the ghost cells
+  d_stencil_width = scratch_ghostcell_width_for_grad;
+  IntVector<DIM> grad_ghostcell_width(0);
+  if (d_ghostcell_exchange_interval > 0) {
+    const int deep_ghostcell_width = d_stencil_width
+      * d_tvd_runge_kutta_order*d_ghostcell_exchange_interval;
+    d_phi_scratch_ghostcell_width = IntVector<DIM>(deep_ghostcell_width);
+    grad_ghostcell_width = 
+      IntVector<DIM>(deep_ghostcell_width - d_stencil_width);
+  } else {
+    d_phi_scratch_ghostcell_width = IntVector<DIM>(d_stencil_width);
+  }
 
   /*
    * create variables and PatchData for scratch data
@@ -1079,17 +1419,28 @@ void ReinitializationAlgorithm<DIM>::initializeVariables()
   // clear out ComponentSelector for scratch data
   d_scratch_data.clrAllFlags();
 
+  // the scratch data holds all components of phi when the ghost cell
+  // fills are batched (only possible when ghost cells are filled before
+  // every stage) and a single component otherwise
+  int phi_scratch_depth = 1;
+  if (d_batch_ghostcell_fills && (d_ghostcell_exchange_interval == 0)) {
+    phi_scratch_depth = phi_variable->getDepth();
+  }
+
   // create "SCRATCH" context for phi
   stringstream phi_scratch_variable_name("");
   phi_scratch_variable_name << phi_variable->getName() 
                             << "::REINITIALIZATION_PHI_SCRATCH";
+  if (phi_scratch_depth > 1) {
+    phi_scratch_variable_name << "_ALL_COMPONENTS";
+  }
   Pointer< CellVariable<DIM,LSMLIB_REAL> > phi_scratch_variable;
   if (var_db->checkVariableExists(phi_scratch_variable_name.str())) {
    phi_scratch_variable = var_db->getVariable(
      phi_scratch_variable_name.str());
   } else {
    phi_scratch_variable = new CellVariable<DIM,LSMLIB_REAL>(
-     phi_scratch_variable_name.str(), 1);
+     phi_scratch_variable_name.str(), phi_scratch_depth);
   }
   for (int k=0; k < d_tvd_runge_kutta_order; k++) {
     stringstream context_name("");
@@ -1114,7 +1465,7 @@ void ReinitializationAlgorithm<DIM>::initializeVariables()
    rhs_variable = new CellVariable<DIM,LSMLIB_REAL>(rhs_name.str(), 1);
   }
   d_rhs_handle = var_db->registerVariableAndContext(
-    rhs_variable, scratch_context, zero_ghostcell_width);
+    rhs_variable, scratch_context, grad_ghostcell_width);
   d_scratch_data.setFlag(d_rhs_handle);
 
   // create variables for grad(phi)
@@ -1132,9 +1483,9 @@ void ReinitializationAlgorithm<DIM>::initializeVariables()
   Pointer<VariableContext> grad_phi_minus_context =  
     var_db->getContext("REINITIALIZATION_GRAD_PHI_MINUS");
   d_grad_phi_plus_handle = var_db->registerVariableAndContext(
-    grad_phi_variable, grad_phi_plus_context, zero_ghostcell_width);
+    grad_phi_variable, grad_phi_plus_context, grad_ghostcell_width);
   d_grad_phi_minus_handle = var_db->registerVariableAndContext(
-    grad_phi_variable, grad_phi_minus_context, zero_ghostcell_width);
+    grad_phi_variable, grad_phi_minus_context, grad_ghostcell_width);
   d_scratch_data.setFlag(d_grad_phi_plus_handle);
   d_scratch_data.setFlag(d_grad_phi_minus_handle);
 
@@ -1267,6 +1618,18 @@ void ReinitializationAlgorithm<DIM>::getFromInput(
     }
   }
 
+  // get persistent scratch data flag
+  d_use_persistent_scratch_data = db->getBoolWithDefault(
+    "use_persistent_scratch_data", LSM_DEFAULT_USE_PERSISTENT_SCRATCH_DATA);
+
+  // get communication parameters
+  d_ghostcell_exchange_interval = db->getIntegerWithDefault(
+    "ghostcell_exchange_interval", LSM_DEFAULT_GHOSTCELL_EXCHANGE_INTERVAL);
+  d_convergence_check_interval = db->getIntegerWithDefault(
+    "convergence_check_interval", LSM_DEFAULT_CONVERGENCE_CHECK_INTERVAL);
+  d_batch_ghostcell_fills = db->getBoolWithDefault(
+    "batch_ghostcell_fills", LSM_DEFAULT_BATCH_GHOSTCELL_FILLS);
+
   // get verbose mode
   d_verbose_mode = db->getBoolWithDefault(
     "verbose_mode", LSM_DEFAULT_VERBOSE_MODE);
@@ -1305,6 +1668,20 @@ void ReinitializationAlgorithm<DIM>::checkParameters()
               << "Only TVD-RK1, TVD-RK2, and TVD-RK3 supported."
               << endl );
   }
+
+  // check communication parameters
+  if (d_ghostcell_exchange_interval < 0) {
+    TBOX_ERROR(  d_object_name
+              << "::checkParameters(): "
+              << "ghostcell_exchange_interval must be non-negative."
+              << endl );
+  }
+  if (d_convergence_check_interval < 1) {
+    TBOX_ERROR(  d_object_name
+              << "::checkParameters(): "
+              << "convergence_check_interval must be positive."
+              << endl );
+  }
 }
 
 
@@ -70,10 +70,73 @@
  *                                (default = 0.0)
  * - verbose_mode               = flag to activate/deactivate verbose-mode 
  *                                (default = false)
+ * - use_persistent_scratch_data = flag to keep the scratch PatchData
+ *                                allocated between reinitialization
+ *                                calculations (default = false)
+ * - ghostcell_exchange_interval = number of iterations between ghost cell
+ *                                exchanges.  If 0, ghost cells are filled
+ *                                before every TVD Runge-Kutta stage.
+ *                                (default = 0)
+ * - convergence_check_interval = number of iterations between evaluations
+ *                                of the max norm of the change in the 
+ *                                level set function when 
+ *                                iteration_stop_tolerance is used
+ *                                (default = 1)
+ * - batch_ghostcell_fills      = flag to fill the ghost cells of all
+ *                                components of a vector level set 
+ *                                function together (default = false)
  *
  *
  * <h3> NOTES: </h3>
  *
+ * - When use_persistent_scratch_data is true, the scratch PatchData is
+ *   allocated by resetHierarchyConfiguration() and kept allocated
+ *   between reinitialization calculations instead of being allocated and
+ *   deallocated on every call.  This reduces the allocation overhead
+ *   for PatchHierarchies with many small patches at the cost of the
+ *   memory reported by getPersistentScratchDataBytes().
+ *
+ * - When ghostcell_exchange_interval is set to N > 0, the scratch 
+ *   PatchData is allocated with N times as many ghost cells as are 
+ *   consumed by one TVD Runge-Kutta step.  Ghost cells are filled only
+ *   once every N iterations; in between, each stage is computed on 
+ *   the patch interior and the part of the ghost cell region that is 
+ *   still valid, which shrinks by the width of the spatial derivative 
+ *   stencil with every stage.  Physical boundary conditions are imposed
+ *   after every stage (this requires no communication).  Because the 
+ *   values in the ghost cells that overlap neighboring patches are 
+ *   computed with exactly the same operations as on the neighboring 
+ *   patch, the result is unchanged on a single level.  At coarse-fine 
+ *   boundaries, the ghost cells are advanced by the reinitialization 
+ *   equation instead of being interpolated from the coarser level 
+ *   before every stage.  This mode reduces the number of messages by 
+ *   a factor of N*tvd_runge_kutta_order at the cost of the extra 
+ *   memory and computation in the ghost cell region, so it is most 
+ *   effective for large patches and low-order discretizations.
+ *   Since the scratch PatchData holds the state of a single component 
+ *   between ghost cell exchanges, reinitializeLevelSetFunctions() 
+ *   reinitializes the components one at a time in this mode, so the 
+ *   stopping criteria are applied to each component separately.
+ *
+ * - When batch_ghostcell_fills is true, the scratch PatchData holds all
+ *   of the components of the level set function, so each TVD 
+ *   Runge-Kutta stage copies the level set function, fills the ghost 
+ *   cells and imposes the boundary conditions for all components at 
+ *   once instead of once per component.  For a level set function with
+ *   N components, this reduces the number of ghost cell exchanges (and
+ *   the associated messages) by a factor of N at the cost of N times 
+ *   as much scratch memory for phi.  Only the communication is 
+ *   batched: the spatial derivative and TVD Runge-Kutta kernels are 
+ *   still called once per component, so the computational cost is 
+ *   unchanged.  The result is unchanged.  batch_ghostcell_fills is 
+ *   ignored when ghostcell_exchange_interval > 0.
+ *
+ * - Each evaluation of the iteration_stop_tolerance criterion requires
+ *   a global reduction.  convergence_check_interval = N reduces the
+ *   number of reductions by a factor of N at the cost of performing up 
+ *   to N-1 more iterations than necessary.  The change is always 
+ *   evaluated on the last allowed iteration.
+ *
  * - If no stopping criteria are specified, the reinitialization
  *   calculation is terminated using the stop_distance criterion
  *   with the stop_distance set to the length of the largest 
@@ -211,6 +274,20 @@ public:
    *                                    verbose-mode (default = false)
    *  - object_name (in):               string name for object (default = 
    *                                    "ReinitializationAlgorithm")
+   *  - ghostcell_exchange_interval (in):
+   *                                    number of iterations between ghost
+   *                                    cell exchanges (0 to fill ghost 
+   *                                    cells before every stage)
+   *                                    (default = 0)
+   *  - convergence_check_interval (in):
+   *                                    number of iterations between 
+   *                                    evaluations of the 
+   *                                    iteration_stop_tolerance criterion
+   *                                    (default = 1)
+   *  - batch_ghostcell_fills (in):     flag to fill the ghost cells of 
+   *                                    all components of the level set
+   *                                    function together
+   *                                    (default = false)
    *
    * Return value:                      none
    *
@@ -233,7 +310,12 @@ public:
     const int max_iterations = 0,
     const LSMLIB_REAL iteration_stop_tolerance = 0.0,
     const bool verbose_mode = false,
-    const string& object_name = "ReinitializationAlgorithm");
+    const string& object_name = "ReinitializationAlgorithm",
+    const int ghostcell_exchange_interval = 
+      LSM_DEFAULT_GHOSTCELL_EXCHANGE_INTERVAL,
+    const int convergence_check_interval = 
+      LSM_DEFAULT_CONVERGENCE_CHECK_INTERVAL,
+    const bool batch_ghostcell_fills = LSM_DEFAULT_BATCH_GHOSTCELL_FILLS);
 
   /*!
    * The destructor does nothing.
@@ -394,6 +476,34 @@ public:
     const int coarsest_level,
     const int finest_level);
 
+  /*!
+   * setUsePersistentScratchData() activates or deactivates persistent
+   * scratch PatchData (see NOTES in class description).  When activated,
+   * the scratch PatchData is immediately allocated on all levels of the
+   * PatchHierarchy; when deactivated, it is deallocated.
+   *
+   * Arguments:
+   *  - use_persistent_scratch_data (in):  true to keep scratch PatchData
+   *                                       allocated between calls
+   *
+   * Return value:                         none
+   *
+   */
+  virtual void setUsePersistentScratchData(
+    const bool use_persistent_scratch_data);
+
+  /*!
+   * getPersistentScratchDataBytes() returns the number of bytes of 
+   * scratch PatchData kept allocated on this processor.
+   *
+   * Arguments:      none
+   *
+   * Return value:   number of bytes of persistent scratch PatchData
+   *                 (zero if persistent scratch PatchData is not used)
+   *
+   */
+  virtual size_t getPersistentScratchDataBytes() const;
+
   //! @}
 
 protected:
@@ -414,7 +524,10 @@ protected:
    *  - dt (in):                  time increment to advance the level set 
    *                              functions
    *  - component (in):           component of level set function to advance 
-   *                              in time
+   *                              in time.  If component is negative, all
+   *                              components are advanced together (only
+   *                              allowed when batch_ghostcell_fills is 
+   *                              true).
    *  - lower_bc (in):            vector of integers specifying the
    *                              type of boundary conditions to impose
    *                              on the lower face of the computational
@@ -463,6 +576,44 @@ protected:
     const IntVector<DIM>& lower_bc,
     const IntVector<DIM>& upper_bc);
 
+  /*!
+   * advanceReinitializationEqnUsingDeepGhostcells() advances the 
+   * reinitialization equation one TVD Runge-Kutta step when ghost cells 
+   * are only exchanged every ghostcell_exchange_interval iterations 
+   * (see NOTES in class description).  The level set function is 
+   * advanced in the first scratch PatchData and then copied into the
+   * specified component of phi.
+   *
+   * Arguments:
+   *  - dt (in):              time increment to advance the level set 
+   *                          functions
+   *  - component (in):       component of level set function to advance 
+   *                          in time
+   *  - iteration (in):       number of iterations taken so far.  Ghost 
+   *                          cells are filled when iteration is a 
+   *                          multiple of ghostcell_exchange_interval.
+   *  - compute_change (in):  true if the max norm of the change in the
+   *                          level set function should be computed
+   *  - lower_bc (in):        boundary conditions on the lower faces of
+   *                          the computational domain (see 
+   *                          advanceReinitializationEqnUsingTVDRK*())
+   *  - upper_bc (in):        boundary conditions on the upper faces of
+   *                          the computational domain (see 
+   *                          advanceReinitializationEqnUsingTVDRK*())
+   *
+   * Return value:            max norm of the change in the level set 
+   *                          function if compute_change is true; 
+   *                          0 otherwise
+   *
+   */
+  virtual LSMLIB_REAL advanceReinitializationEqnUsingDeepGhostcells(
+    const LSMLIB_REAL dt,
+    const int component,
+    const int iteration,
+    const bool compute_change,
+    const IntVector<DIM>& lower_bc,
+    const IntVector<DIM>& upper_bc);
+
   /*!
    * computeReinitializationEqnRHS() computes the right-hand side of
    * the reinitialization equation when it is written in the form:
@@ -470,14 +621,20 @@ protected:
    *   phi_t = ...
    *
    * Arguments:
-   *  - phi_handle (in):  PatchData handle to use in computing RHS of 
-   *                      reinitialization equation
+   *  - phi_handle (in):      PatchData handle to use in computing RHS of 
+   *                          reinitialization equation
+   *  - fillbox_growth (in):  number of ghost cells in which to also 
+   *                          compute the RHS (default = 0)
+   *  - phi_component (in):   component of phi_handle to use in computing
+   *                          RHS (default = 0)
    *
-   * Return value:        none
+   * Return value:            none
    *
    */
   virtual void computeReinitializationEqnRHS(
-    const int phi_handle);
+    const int phi_handle,
+    const int fillbox_growth = 0,
+    const int phi_component = 0);
 
   //! @}
 
@@ -568,6 +725,11 @@ protected:
   int d_max_iterations;
   LSMLIB_REAL d_iteration_stop_tol;
 
+  // communication parameters
+  int d_ghostcell_exchange_interval;
+  int d_convergence_check_interval;
+  bool d_batch_ghostcell_fills;
+
   // verbose mode
   bool d_verbose_mode;
 
@@ -592,6 +754,7 @@ protected:
   // scratch data 
   vector<int> d_phi_scr_handles;
   IntVector<DIM> d_phi_scratch_ghostcell_width;
+  int d_stencil_width;  // ghost cells consumed by one TVD Runge-Kutta stage
   int d_rhs_handle;
   int d_grad_phi_plus_handle;
   int d_grad_phi_minus_handle;
@@ -614,6 +777,10 @@ protected:
   // ComponentSelector to organize variables
   ComponentSelector d_scratch_data;
 
+  // persistent scratch data
+  bool d_use_persistent_scratch_data;
+  size_t d_persistent_scratch_data_bytes;
+
   /*
    * Boundary condition objects
    */
@@ -24,6 +24,12 @@
  *    -# FMM_NDIM:  the number of spatial dimensions.
  *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION:  desired name of function 
  *       that solves the Eikonal equation.
+ *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE:  desired name 
+ *       of function that solves the Eikonal equation using a 
+ *       caller-supplied workspace.
+ *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_ENGINE:  desired name 
+ *       of function that solves the Eikonal equation using a specified
+ *       algorithm (fast marching or fast sweeping).
  *    -# FMM_EIKONAL_INITIALIZE_FRONT:  desired name of function that
  *       initializes the values on the front.
  *    -# FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1:  desired name of function 
@@ -54,6 +60,7 @@
 #include "FMM_Core.h"
 #include "FMM_Heap.h"
 #include "FMM_Macros.h"
+#include "lsm_fast_sweeping_method.h"
 
 
 /*
@@ -66,6 +73,12 @@
 #ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION
 #error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION not defined!"
 #endif
+#ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE not defined!"
+#endif
+#ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_ENGINE
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_ENGINE not defined!"
+#endif
 #ifndef FMM_EIKONAL_INITIALIZE_FRONT
 #error "lsm_FMM_eikonal: required macro FMM_EIKONAL_INITIALIZE_FRONT not defined!"
 #endif
@@ -100,7 +113,7 @@ void FMM_EIKONAL_INITIALIZE_FRONT(
 
 /* 
  * FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1() implements the callback 
- * function required by FMM_Core::FMM_Core_updateNeighbors() to
+ * function registered with FMM_Core_setUpdateGridPointLinearIdx() to
  * update the solution at a grid point.  It computes and returns 
  * the updated phi value of the specified grid point using values of 
  * neighbors that have status "KNOWN" and a first-order accurate 
@@ -109,6 +122,7 @@ void FMM_EIKONAL_INITIALIZE_FRONT(
 LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
@@ -116,7 +130,7 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
 
 /* 
  * FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2() implements the callback  
- * function required by FMM_Core::FMM_Core_updateNeighbors() to 
+ * function registered with FMM_Core_setUpdateGridPointLinearIdx() to 
  * update the solution at a grid point.  It computes and returns 
  * the updated phi value of the specified grid point using values of 
  * neighbors that have status "KNOWN" and a second-order accurate 
@@ -128,15 +142,39 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
 LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
   LSMLIB_REAL *dx);
 
 
+/*
+ * FMM_solveEikonalEquation() carries out the Eikonal equation 
+ * calculation for all of the public interface functions.  The work 
+ * arrays are taken from workspace (NULL to allocate new work arrays).
+ * The fast sweeping method is used instead when engine is 
+ * LSM_EIKONAL_ENGINE_FAST_SWEEPING and it supports the calculation.
+ */
+static int FMM_solveEikonalEquation(
+  LSM_FMM_Workspace *workspace,
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+
 /*==================== Function Definitions =========================*/
 
 
+/* 
+ * FMM_EIKONAL_SOLVE_EIKONAL_EQUATION() just calls 
+ * FMM_solveEikonalEquation() with no workspace using the fast 
+ * marching method.
+ */
 int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
   LSMLIB_REAL *phi,
   LSMLIB_REAL *speed,
@@ -144,17 +182,92 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
   int spatial_discretization_order,
   int *grid_dims,
   LSMLIB_REAL *dx)
+{
+  return FMM_solveEikonalEquation(
+           0, /*  no workspace */
+           LSM_EIKONAL_ENGINE_FAST_MARCHING,
+           phi,
+           speed,
+           mask,
+           spatial_discretization_order,
+           grid_dims,
+           dx);
+}
+
+
+/* 
+ * FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE() just calls 
+ * FMM_solveEikonalEquation() with the caller-supplied workspace using
+ * the fast marching method.
+ */
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_solveEikonalEquation(
+           workspace,
+           LSM_EIKONAL_ENGINE_FAST_MARCHING,
+           phi,
+           speed,
+           mask,
+           spatial_discretization_order,
+           grid_dims,
+           dx);
+}
+
+
+/* 
+ * FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_ENGINE() just calls 
+ * FMM_solveEikonalEquation() with no workspace using the specified
+ * engine.
+ */
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_ENGINE(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_solveEikonalEquation(
+           0, /*  no workspace */
+           engine,
+           phi,
+           speed,
+           mask,
+           spatial_discretization_order,
+           grid_dims,
+           dx);
+}
+
+
+static int FMM_solveEikonalEquation(
+  LSM_FMM_Workspace *workspace,
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
 {
   /* fast marching method data */
   FMM_CoreData *fmm_core_data;
 
   /* pointers to callback functions */
-  updateGridPointFuncPtr updateGridPoint;
+  updateGridPointLinearIdxFuncPtr updateGridPoint;
   initializeFrontFuncPtr initializeFront;
 
   /* auxiliary variables */
   int num_gridpoints;       /* number of grid points */
   int i, idx;               /* loop variables */
+  LSMLIB_REAL bucket_width; /* bucket width for bucketed trial queue */
 
 
   /******************************************************
@@ -175,6 +288,20 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
     return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
   }
 
+  /* use the fast sweeping engine when it has been requested and */
+  /* supports the requested calculation                          */
+  if (  (LSM_EIKONAL_ENGINE_FAST_SWEEPING == engine)
+     && (spatial_discretization_order == 1) ) {
+    return FSM_solveEikonalEquation(
+             FMM_NDIM,
+             phi,
+             speed,
+             mask,
+             spatial_discretization_order,
+             grid_dims,
+             dx);
+  }
+
   /********************************************
    * set up FMM Field Data
    ********************************************/
@@ -184,27 +311,53 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
   fmm_field_data->phi   = phi;
   fmm_field_data->speed = speed;
    
+  num_gridpoints = 1;
+  for (i = 0; i < FMM_NDIM; i++) {
+    num_gridpoints *= grid_dims[i];
+  }
+
   /********************************************
    * initialize FMM Core Data
+   *
+   * NOTE: if a bucketed queue is used for the 
+   *       trial points, the bucket width is 
+   *       scaled by the inverse of the maximum 
+   *       speed so that it is a fixed fraction 
+   *       of the smallest possible change in 
+   *       arrival time between grid points
    ********************************************/
-  fmm_core_data = FMM_Core_createFMM_CoreData(
+  bucket_width = 0;  /* default bucket width */
+  if (FMM_CORE_BUCKETED_QUEUE == FMM_Core_getDefaultQueueType()) {
+    LSMLIB_REAL max_speed = 0;
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      if (speed[idx] > max_speed) max_speed = speed[idx];
+    }
+    if (max_speed > LSMLIB_ZERO_TOL) {
+      bucket_width = dx[0];
+      for (i = 1; i < FMM_NDIM; i++) {
+        if (dx[i] < bucket_width) bucket_width = dx[i];
+      }
+      bucket_width *= FMM_CORE_DEFAULT_BUCKET_WIDTH_FRACTION/max_speed;
+    }
+  }
+  fmm_core_data = FMM_acquireCoreData(
+    workspace,
     fmm_field_data,
     FMM_NDIM,
     grid_dims,
     dx,
     initializeFront,
-    updateGridPoint);
+    0,  /* grid point update function set below */
+    FMM_Core_getDefaultQueueType(),
+    bucket_width);
   if (!fmm_core_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  FMM_Core_setUpdateGridPointLinearIdx(fmm_core_data, updateGridPoint);
 
   /********************************************
    * initialize phi and mark grid points
    * outside of the mathematical/physical 
    * domain
    ********************************************/
-  num_gridpoints = 1;
-  for (i = 0; i < FMM_NDIM; i++) {
-    num_gridpoints *= grid_dims[i];
-  }
 
   for (idx = 0; idx < num_gridpoints; idx++) {
 
@@ -250,7 +403,7 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
   }
 
   /* clean up memory */
-  FMM_Core_destroyFMM_CoreData(fmm_core_data);
+  FMM_releaseCoreData(workspace, fmm_core_data);
   free(fmm_field_data);
 
   return LSM_FMM_ERR_SUCCESS;
@@ -264,7 +417,8 @@ void FMM_EIKONAL_INITIALIZE_FRONT(
   LSMLIB_REAL *dx)
 {
   /* Grid point status */
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi   = fmm_field_data->phi;
@@ -316,12 +470,14 @@ void FMM_EIKONAL_INITIALIZE_FRONT(
 LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx_cur_gridpoint,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi   = fmm_field_data->phi; 
@@ -332,8 +488,7 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
   LSMLIB_REAL phi_upwind;
   LSMLIB_REAL phi_plus;
   LSMLIB_REAL inv_dx_sq; 
-  int offset[FMM_NDIM]; 
-  int neighbor[FMM_NDIM];
+  int grid_stride[FMM_NDIM];
 
   /* coefficients of quadratic equation for phi */
   LSMLIB_REAL phi_A = 0;
@@ -344,35 +499,26 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
 
   /* auxilliary variables */
   int dir;  /* loop variable for spatial directions */
-  int l;    /* extra loop variable */ 
-  int idx_cur_gridpoint, idx_neighbor;
-  int grid_idx_out_of_bounds;
+  int idx_neighbor;
 
   /* unused function parameters */
   (void) num_dims;
 
-  /* compute index for current grid point */
-  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+  /* compute offsets of neighboring grid points in each direction */
+  grid_stride[0] = 1;
+  for (dir = 1; dir < FMM_NDIM; dir++) {
+    grid_stride[dir] = grid_stride[dir-1]*grid_dims[dir-1];
+  }
 
   /* calculate update to phi */
   for (dir = 0; dir < FMM_NDIM; dir++) { 
 
-    /* reset offset */
-    for (l = 0; l < FMM_NDIM; l++) { 
-      offset[l] = 0; 
-    }
-
     /* find "upwind" direction and phi value */
     phi_upwind = LSMLIB_REAL_MAX;
 
     /* check minus direction */
-    offset[dir] = -1;
-    for (l = 0; l < FMM_NDIM; l++) { 
-      neighbor[l] = grid_idx[l] + offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+    if (grid_idx[dir] > 0) {
+      idx_neighbor = idx_cur_gridpoint - grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
       if (KNOWN == neighbor_status) {
         phi_upwind = phi[idx_neighbor];
@@ -380,13 +526,8 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
     }
 
     /* check plus direction */
-    offset[dir] = 1;
-    for (l = 0; l < FMM_NDIM; l++) { 
-      neighbor[l] = grid_idx[l] + offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+    if (grid_idx[dir] < grid_dims[dir]-1) {
+      idx_neighbor = idx_cur_gridpoint + grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
       if (KNOWN == neighbor_status) {
         phi_plus = phi[idx_neighbor];
@@ -459,12 +600,14 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
 LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx_cur_gridpoint,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi   = fmm_field_data->phi; 
@@ -476,9 +619,7 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
   LSMLIB_REAL phi_plus;
   int second_order_switch;
   LSMLIB_REAL inv_dx_sq; 
-  int offset[FMM_NDIM]; 
-  int neighbor1[FMM_NDIM];
-  int neighbor2[FMM_NDIM];
+  int grid_stride[FMM_NDIM];
 
   /* coefficients of quadratic equation for phi */
   LSMLIB_REAL phi_A = 0;
@@ -489,24 +630,20 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
 
   /* auxilliary variables */
   int dir;  /* loop variable for spatial directions */
-  int l;    /* extra loop variable */ 
-  int idx_cur_gridpoint, idx_neighbor1, idx_neighbor2;
-  int grid_idx_out_of_bounds;
+  int idx_neighbor1, idx_neighbor2;
 
   /* unused function parameters */
   (void) num_dims;
 
-  /* compute index for current grid point */
-  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+  /* compute offsets of neighboring grid points in each direction */
+  grid_stride[0] = 1;
+  for (dir = 1; dir < FMM_NDIM; dir++) {
+    grid_stride[dir] = grid_stride[dir-1]*grid_dims[dir-1];
+  }
 
   /* calculate update to phi */
   for (dir = 0; dir < FMM_NDIM; dir++) { 
 
-    /* reset offset */
-    for (l = 0; l < FMM_NDIM; l++) { 
-      offset[l] = 0; 
-    }
-
     /* reset phi_upwind1 and phi_upwind2 to LSMLIB_REAL_MAX */
     phi_upwind1 = LSMLIB_REAL_MAX;
     phi_upwind2 = LSMLIB_REAL_MAX;
@@ -516,22 +653,15 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
     second_order_switch = 0;
 
     /* check minus direction */
-    offset[dir] = -1;
-    for (l = 0; l < FMM_NDIM; l++) { 
-      neighbor1[l] = grid_idx[l] + offset[l];
-      neighbor2[l] = grid_idx[l] + 2*offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor1,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
+    if (grid_idx[dir] > 0) {
+      idx_neighbor1 = idx_cur_gridpoint - grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor1];
       if (KNOWN == neighbor_status) {
         phi_upwind1 = phi[idx_neighbor1];
 
         /* check for neighbor required for second-order accuracy */
-        LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor2,grid_dims);
-        if (!grid_idx_out_of_bounds) {
-          LSM_FMM_IDX(idx_neighbor2, neighbor2, grid_dims);
+        if (grid_idx[dir] > 1) {
+          idx_neighbor2 = idx_cur_gridpoint - 2*grid_stride[dir];
           neighbor_status = (PointStatus) gridpoint_status[idx_neighbor2];
           if ( (KNOWN == neighbor_status) &&
                (  LSM_FMM_ABS(phi[idx_neighbor2]) 
@@ -545,14 +675,8 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
     } 
 
     /* check plus direction */
-    offset[dir] = 1;
-    for (l = 0; l < FMM_NDIM; l++) { 
-      neighbor1[l] = grid_idx[l] + offset[l];
-      neighbor2[l] = grid_idx[l] + 2*offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor1,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
+    if (grid_idx[dir] < grid_dims[dir]-1) {
+      idx_neighbor1 = idx_cur_gridpoint + grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor1];
       if (KNOWN == neighbor_status) {
         phi_plus = phi[idx_neighbor1];
@@ -568,9 +692,8 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
           second_order_switch = 0;
 
           /* check for neighbor required for second-order accuracy */
-          LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor2,grid_dims);
-          if (!grid_idx_out_of_bounds) {
-            LSM_FMM_IDX(idx_neighbor2, neighbor2, grid_dims);
+          if (grid_idx[dir] < grid_dims[dir]-2) {
+            idx_neighbor2 = idx_cur_gridpoint + 2*grid_stride[dir];
             neighbor_status = (PointStatus) gridpoint_status[idx_neighbor2];
             if ( (KNOWN == neighbor_status) &&
                  (  LSM_FMM_ABS(phi[idx_neighbor2]) 
@@ -21,6 +21,10 @@
 /* Define required macros */
 #define FMM_NDIM                               2 
 #define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION     solveEikonalEquation2d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE                 \
+        solveEikonalEquationWithWorkspace2d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_ENGINE                    \
+        solveEikonalEquationWithEngine2d
 #define FMM_EIKONAL_INITIALIZE_FRONT           FMM_initializeFront_Eikonal2d
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1                              \
         FMM_updateGridPoint_Eikonal2d_Order1
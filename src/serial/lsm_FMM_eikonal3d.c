@@ -21,6 +21,10 @@
 /* Define required macros */
 #define FMM_NDIM                               3 
 #define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION     solveEikonalEquation3d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE                 \
+        solveEikonalEquationWithWorkspace3d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_ENGINE                    \
+        solveEikonalEquationWithEngine3d
 #define FMM_EIKONAL_INITIALIZE_FRONT           FMM_initializeFront_Eikonal3d
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1                              \
         FMM_updateGridPoint_Eikonal3d_Order1
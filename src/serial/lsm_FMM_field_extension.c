@@ -29,6 +29,28 @@
  *    -# FMM_COMPUTE_EXTENSION_FIELDS:  desired name of function
  *       that computes the extensions of fields off of the zero 
  *       level set 
+ *    -# FMM_COMPUTE_EXTENSION_FIELDS_WITH_BOUNDARY_DATA:  desired name
+ *       of function that computes the extensions of fields off of the
+ *       zero level set using externally supplied values at a set of
+ *       boundary grid points
+ *    -# FMM_COMPUTE_DISTANCE_FUNCTION_WITH_CUTOFF:  desired name of 
+ *       function that computes the distance function within a band 
+ *       of specified width around the zero level set
+ *    -# FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF:  desired name of 
+ *       function that computes the extensions of fields within a band 
+ *       of specified width around the zero level set
+ *    -# FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE:  desired name of
+ *       function that computes the distance function using a
+ *       caller-supplied workspace
+ *    -# FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE:  desired name of
+ *       function that computes the extensions of fields (with optional
+ *       boundary data and cut-off) using a caller-supplied workspace
+ *    -# FMM_COMPUTE_DISTANCE_FUNCTION_WITH_ENGINE:  desired name of
+ *       function that computes the distance function using a specified
+ *       algorithm (fast marching or fast sweeping)
+ *    -# FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE:  desired name of
+ *       function that computes the extensions of fields (with optional
+ *       cut-off) using a specified algorithm
  *    -# FMM_INITIALIZE_FRONT_ORDER1:  desired name of function that
  *       initializes the values on the front using a first-order scheme
  *    -# FMM_INITIALIZE_FRONT_ORDER2:  desired name of function that
@@ -68,6 +90,7 @@
 #include "FMM_Core.h"
 #include "FMM_Heap.h"
 #include "FMM_Macros.h"
+#include "lsm_fast_sweeping_method.h"
 
 
 /*
@@ -83,6 +106,27 @@
 #ifndef FMM_COMPUTE_EXTENSION_FIELDS
 #error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS not defined!"
 #endif
+#ifndef FMM_COMPUTE_EXTENSION_FIELDS_WITH_BOUNDARY_DATA
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS_WITH_BOUNDARY_DATA not defined!"
+#endif
+#ifndef FMM_COMPUTE_DISTANCE_FUNCTION_WITH_CUTOFF
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_DISTANCE_FUNCTION_WITH_CUTOFF not defined!"
+#endif
+#ifndef FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF not defined!"
+#endif
+#ifndef FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE not defined!"
+#endif
+#ifndef FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE not defined!"
+#endif
+#ifndef FMM_COMPUTE_DISTANCE_FUNCTION_WITH_ENGINE
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_DISTANCE_FUNCTION_WITH_ENGINE not defined!"
+#endif
+#ifndef FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE not defined!"
+#endif
 #ifndef FMM_INITIALIZE_FRONT_ORDER1
 #error "lsm_FMM_field_extension: required macro FMM_INITIALIZE_FRONT_ORDER1 not defined!"
 #endif
@@ -107,6 +151,10 @@ struct FMM_FieldData {
                                     /* level set (input)                   */
   LSMLIB_REAL **extension_fields;   /* computed extension field (output)   */
   LSMLIB_REAL *extension_mask;      /* mask the initial extension interface values */
+  LSMLIB_REAL *boundary_mask;       /* grid points with externally supplied */
+                                    /* values (positive value)              */
+  LSMLIB_REAL *boundary_distance_function;   /* supplied boundary values */
+  LSMLIB_REAL **boundary_extension_fields;
   /* data arrays used for initializing and updating extension fields */
   LSMLIB_REAL *extension_fields_numerator;
   LSMLIB_REAL *extension_fields_denominator;
@@ -159,7 +207,7 @@ void FMM_INITIALIZE_FRONT_ORDER2(
 
 /* 
  * FMM_UPDATE_GRID_POINT_ORDER1() implements the callback function 
- * required by FMM_Core::FMM_Core_updateNeighbors() to update the
+ * registered with FMM_Core_setUpdateGridPointLinearIdx() to update the
  * distance function and extension fields at a grid point.  It 
  * computes and returns the updated distance function and extension
  * field values of the specified grid point using values of neighbors
@@ -173,6 +221,7 @@ void FMM_INITIALIZE_FRONT_ORDER2(
 LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
@@ -180,7 +229,7 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
 
 /* 
  * FMM_UPDATE_GRID_POINT_ORDER2() implements the callback function 
- * required by FMM_Core::FMM_Core_updateNeighbors() to update the
+ * registered with FMM_Core_setUpdateGridPointLinearIdx() to update the
  * distance function and extension fields at a grid point.  It 
  * computes and returns the updated distance function and extension
  * field values of the specified grid point using values of neighbors
@@ -194,24 +243,62 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
 LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
   LSMLIB_REAL *dx);
 
 
+/*
+ * FMM_computeExtensionFields() carries out the distance function
+ * and extension field calculations for all of the public interface 
+ * functions.  The calculation is terminated once the front has 
+ * moved beyond max_distance (LSMLIB_REAL_MAX for no cut-off).
+ * The work arrays are taken from workspace (NULL to allocate new
+ * work arrays).  The fast sweeping method is used instead when engine
+ * is LSM_EIKONAL_ENGINE_FAST_SWEEPING and it supports the calculation.
+ */
+static int FMM_computeExtensionFields(
+  LSM_FMM_Workspace *workspace,
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*
+ * FMM_destroyFieldData() frees the FMM_FieldData structure and all of
+ * the work arrays allocated for it.  Work arrays that have not been
+ * allocated must be NULL.
+ */
+static void FMM_destroyFieldData(FMM_FieldData *fmm_field_data);
+
+
 /*==================== Function Definitions =========================*/
 
 
-int FMM_COMPUTE_EXTENSION_FIELDS(
+static int FMM_computeExtensionFields(
+  LSM_FMM_Workspace *workspace,
+  LSM_EikonalEngine engine,
   LSMLIB_REAL *distance_function,
   LSMLIB_REAL **extension_fields,
   LSMLIB_REAL *phi,
   LSMLIB_REAL *mask,
   LSMLIB_REAL **source_fields,
   LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
   int num_extension_fields,
   int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
@@ -219,7 +306,7 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
   FMM_CoreData *fmm_core_data;
 
   /* pointers to callback functions */
-  updateGridPointFuncPtr updateGridPoint;
+  updateGridPointLinearIdxFuncPtr updateGridPoint;
   initializeFrontFuncPtr initializeFront;
 
   /* auxiliary variables */
@@ -254,6 +341,33 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
     return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
   }
 
+  if (max_distance <= 0) {
+    fprintf(stderr,
+           "ERROR: Invalid cut-off distance.  max_distance must be\n");
+    fprintf(stderr,
+           "       positive.\n");
+    return LSM_FMM_ERR_INVALID_CUTOFF_DISTANCE;
+  }
+
+  /* use the fast sweeping engine when it has been requested and */
+  /* supports the requested calculation                          */
+  if (  (LSM_EIKONAL_ENGINE_FAST_SWEEPING == engine)
+     && (spatial_discretization_order == 1) && (!boundary_mask) ) {
+    return FSM_computeExtensionFields(
+             FMM_NDIM,
+             distance_function,
+             extension_fields,
+             phi,
+             mask,
+             source_fields,
+             extension_mask,
+             num_extension_fields,
+             spatial_discretization_order,
+             max_distance,
+             grid_dims,
+             dx);
+  }
+
   /********************************************
    * set up FMM Field Data
    ********************************************/
@@ -266,6 +380,9 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
   fmm_field_data->source_fields = source_fields;
   fmm_field_data->extension_fields = extension_fields;
   fmm_field_data->extension_mask = extension_mask;
+  fmm_field_data->boundary_mask = boundary_mask;
+  fmm_field_data->boundary_distance_function = 0;
+  fmm_field_data->boundary_extension_fields = 0;
 
   /* allocate memory for extension field calculations */
   if (num_extension_fields > 0) {
@@ -281,6 +398,15 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
       (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
     fmm_field_data->extension_fields_denominator = 
       (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
+    if ( !fmm_field_data->extension_fields_cur 
+      || !fmm_field_data->extension_fields_sum_div_dist_sq
+      || !fmm_field_data->extension_fields_minus
+      || !fmm_field_data->extension_fields_plus
+      || !fmm_field_data->extension_fields_numerator
+      || !fmm_field_data->extension_fields_denominator ) {
+      FMM_destroyFieldData(fmm_field_data);
+      return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+    }
   } else {
     fmm_field_data->extension_fields_cur = 0;
     fmm_field_data->extension_fields_sum_div_dist_sq = 0;
@@ -297,27 +423,82 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
   for (i = 0; i < FMM_NDIM; i++) {
     num_gridpoints *= grid_dims[i];
   }
-  for (i = 0, ptr = distance_function; i < num_gridpoints; i++, ptr++) {
-    *ptr = LSM_FMM_DEFAULT_UPDATE_VALUE;
-  }
+  if (boundary_mask) {
+
+    /* save copies of the values supplied at boundary grid points */
+    fmm_field_data->boundary_distance_function = 
+      (LSMLIB_REAL*) malloc(num_gridpoints*sizeof(LSMLIB_REAL));
+    if (!fmm_field_data->boundary_distance_function) {
+      FMM_destroyFieldData(fmm_field_data);
+      return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+    }
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      fmm_field_data->boundary_distance_function[idx] = 
+        distance_function[idx];
+    }
+    if (num_extension_fields > 0) {
+      fmm_field_data->boundary_extension_fields = 
+        (LSMLIB_REAL**) calloc(num_extension_fields,sizeof(LSMLIB_REAL*));
+      if (!fmm_field_data->boundary_extension_fields) {
+        FMM_destroyFieldData(fmm_field_data);
+        return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+      }
+      for (j = 0; j < num_extension_fields; j++) {
+        fmm_field_data->boundary_extension_fields[j] = 
+          (LSMLIB_REAL*) malloc(num_gridpoints*sizeof(LSMLIB_REAL));
+        if (!fmm_field_data->boundary_extension_fields[j]) {
+          FMM_destroyFieldData(fmm_field_data);
+          return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+        }
+        for (idx = 0; idx < num_gridpoints; idx++) {
+          fmm_field_data->boundary_extension_fields[j][idx] = 
+            extension_fields[j][idx];
+        }
+      }
+    }
+
+    /* initialize all other grid points */
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      if (boundary_mask[idx] <= 0) {
+        distance_function[idx] = LSM_FMM_DEFAULT_UPDATE_VALUE;
+        for (j = 0; j < num_extension_fields; j++) {
+          extension_fields[j][idx] = LSM_FMM_DEFAULT_UPDATE_VALUE;
+        }
+      }
+    }
 
-  for (j = 0; j < num_extension_fields; j++) {
-    for (i = 0, ptr = extension_fields[j]; i < num_gridpoints; i++, ptr++) {
+  } else {
+
+    for (i = 0, ptr = distance_function; i < num_gridpoints; i++, ptr++) {
       *ptr = LSM_FMM_DEFAULT_UPDATE_VALUE;
     }
+
+    for (j = 0; j < num_extension_fields; j++) {
+      for (i = 0, ptr = extension_fields[j]; i < num_gridpoints; i++, ptr++) {
+        *ptr = LSM_FMM_DEFAULT_UPDATE_VALUE;
+      }
+    }
+
   }
 
   /********************************************
    * initialize FMM Core Data
    ********************************************/
-  fmm_core_data = FMM_Core_createFMM_CoreData(
+  fmm_core_data = FMM_acquireCoreData(
+    workspace,
     fmm_field_data,
     FMM_NDIM,
     grid_dims,
     dx,
     initializeFront,
-    updateGridPoint);
-  if (!fmm_core_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+    0,  /* grid point update function set below */
+    FMM_Core_getDefaultQueueType(),
+    0); /* default bucket width */
+  if (!fmm_core_data) {
+    FMM_destroyFieldData(fmm_field_data);
+    return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  }
+  FMM_Core_setUpdateGridPointLinearIdx(fmm_core_data, updateGridPoint);
 
   /* mark grid points outside of domain */
   for (idx = 0; idx < num_gridpoints; idx++) {
@@ -349,23 +530,206 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
   FMM_Core_initializeFront(fmm_core_data); 
 
   /* update remaining grid points */
+  FMM_Core_setStopValue(fmm_core_data, max_distance);
   while (FMM_Core_moreGridPointsToUpdate(fmm_core_data)) {
     FMM_Core_advanceFront(fmm_core_data);
   }
 
+  /* when the calculation is cut off, set the distance function to  */
+  /* +/- max_distance and the extension fields to zero at grid      */
+  /* points that were not reached by the front                      */
+  if (max_distance < LSMLIB_REAL_MAX) {
+    unsigned char *gridpoint_status = 
+      FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      if (OUTSIDE_DOMAIN == gridpoint_status[idx]) continue;
+
+      if (KNOWN != gridpoint_status[idx]) {
+        for (i = 0; i < num_extension_fields; i++) {
+          extension_fields[i][idx] = 0.0;
+        }
+      }
+      if ( (KNOWN != gridpoint_status[idx]) || 
+           (fabs(distance_function[idx]) > max_distance) ) {
+        distance_function[idx] = 
+          (phi[idx] > 0) ? max_distance : -max_distance;
+      }
+    }
+  }
+
+  /* when boundary data is supplied, flag grid points that could not  */
+  /* be reached from the front so that they are never mistaken for    */
+  /* computed values (e.g. when they are used as boundary data on the */
+  /* next call)                                                       */
+  else if (boundary_mask) {
+    unsigned char *gridpoint_status = 
+      FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      if (FAR == gridpoint_status[idx]) {
+        distance_function[idx] = 
+          (phi[idx] > 0) ? LSMLIB_REAL_MAX : -LSMLIB_REAL_MAX;
+        for (i = 0; i < num_extension_fields; i++) {
+          extension_fields[i][idx] = LSMLIB_REAL_MAX;
+        }
+      }
+    }
+  }
+
   /* clean up memory */
-  FMM_Core_destroyFMM_CoreData(fmm_core_data);
-  if (num_extension_fields > 0) {
-    free(fmm_field_data->extension_fields_cur);
-    free(fmm_field_data->extension_fields_sum_div_dist_sq);
-    free(fmm_field_data->extension_fields_minus);
-    free(fmm_field_data->extension_fields_plus);
-    free(fmm_field_data->extension_fields_numerator);
-    free(fmm_field_data->extension_fields_denominator);
+  FMM_releaseCoreData(workspace, fmm_core_data);
+  FMM_destroyFieldData(fmm_field_data);
+
+  return LSM_FMM_ERR_SUCCESS;
+}
+
+
+static void FMM_destroyFieldData(FMM_FieldData *fmm_field_data)
+{
+  int j;
+
+  free(fmm_field_data->boundary_distance_function);
+  if (fmm_field_data->boundary_extension_fields) {
+    for (j = 0; j < fmm_field_data->num_extension_fields; j++) {
+      free(fmm_field_data->boundary_extension_fields[j]);
+    }
+    free(fmm_field_data->boundary_extension_fields);
   }
+  free(fmm_field_data->extension_fields_cur);
+  free(fmm_field_data->extension_fields_sum_div_dist_sq);
+  free(fmm_field_data->extension_fields_minus);
+  free(fmm_field_data->extension_fields_plus);
+  free(fmm_field_data->extension_fields_numerator);
+  free(fmm_field_data->extension_fields_denominator);
   free(fmm_field_data);
+}
 
-  return LSM_FMM_ERR_SUCCESS;
+/* 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_BOUNDARY_DATA() just calls 
+ * FMM_computeExtensionFields() with no cut-off.
+ */
+int FMM_COMPUTE_EXTENSION_FIELDS_WITH_BOUNDARY_DATA(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_computeExtensionFields(
+           0, /*  no workspace */
+           LSM_EIKONAL_ENGINE_FAST_MARCHING,
+           distance_function,
+           extension_fields,
+           phi,
+           mask,
+           source_fields,
+           extension_mask,
+           boundary_mask,
+           num_extension_fields,
+           spatial_discretization_order,
+           LSMLIB_REAL_MAX, /* no cut-off */
+           grid_dims,
+           dx);
+}
+
+/* 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF() just calls 
+ * FMM_computeExtensionFields() with no boundary data (i.e. NULL 
+ * boundary mask pointer).
+ */
+int FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_computeExtensionFields(
+           0, /*  no workspace */
+           LSM_EIKONAL_ENGINE_FAST_MARCHING,
+           distance_function,
+           extension_fields,
+           phi,
+           mask,
+           source_fields,
+           extension_mask,
+           0, /*  NULL boundary_mask pointer */
+           num_extension_fields,
+           spatial_discretization_order,
+           max_distance,
+           grid_dims,
+           dx);
+}
+
+/* 
+ * FMM_COMPUTE_EXTENSION_FIELDS() just calls 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF() with no cut-off.
+ */
+int FMM_COMPUTE_EXTENSION_FIELDS(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF(
+           distance_function,
+           extension_fields,
+           phi,
+           mask,
+           source_fields,
+           extension_mask,
+           num_extension_fields,
+           spatial_discretization_order,
+           LSMLIB_REAL_MAX, /* no cut-off */
+           grid_dims,
+           dx);
+}
+
+/* 
+ * FMM_COMPUTE_DISTANCE_FUNCTION_WITH_CUTOFF() just calls 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF() with no source/extension 
+ * fields (i.e. NULL source/extension field pointers).
+ */
+int FMM_COMPUTE_DISTANCE_FUNCTION_WITH_CUTOFF(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF(
+           distance_function,
+           0, /*  NULL extension fields pointer */
+           phi,
+           mask,
+           0, /*  NULL source fields pointer */
+           0, /*  NULL extension_mask pointer */
+           0, /*  zero extension fields to compute */
+           spatial_discretization_order,
+           max_distance,
+           grid_dims,
+           dx);
 }
 
 /* 
@@ -394,6 +758,138 @@ int FMM_COMPUTE_DISTANCE_FUNCTION(
            dx);
 }
 
+/* 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE() just calls 
+ * FMM_computeExtensionFields() with the caller-supplied workspace.
+ */
+int FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_computeExtensionFields(
+           workspace,
+           LSM_EIKONAL_ENGINE_FAST_MARCHING,
+           distance_function,
+           extension_fields,
+           phi,
+           mask,
+           source_fields,
+           extension_mask,
+           boundary_mask,
+           num_extension_fields,
+           spatial_discretization_order,
+           max_distance,
+           grid_dims,
+           dx);
+}
+
+/* 
+ * FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE() just calls 
+ * FMM_computeExtensionFields() with no source/extension fields, no 
+ * boundary data and no cut-off.
+ */
+int FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_computeExtensionFields(
+           workspace,
+           LSM_EIKONAL_ENGINE_FAST_MARCHING,
+           distance_function,
+           0, /*  NULL extension fields pointer */
+           phi,
+           mask,
+           0, /*  NULL source fields pointer */
+           0, /*  NULL extension_mask pointer */
+           0, /*  NULL boundary_mask pointer */
+           0, /*  zero extension fields to compute */
+           spatial_discretization_order,
+           LSMLIB_REAL_MAX, /* no cut-off */
+           grid_dims,
+           dx);
+}
+
+/* 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE() just calls 
+ * FMM_computeExtensionFields() with the specified engine and no 
+ * boundary data.
+ */
+int FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_computeExtensionFields(
+           0, /*  no workspace */
+           engine,
+           distance_function,
+           extension_fields,
+           phi,
+           mask,
+           source_fields,
+           extension_mask,
+           0, /*  NULL boundary_mask pointer */
+           num_extension_fields,
+           spatial_discretization_order,
+           max_distance,
+           grid_dims,
+           dx);
+}
+
+/* 
+ * FMM_COMPUTE_DISTANCE_FUNCTION_WITH_ENGINE() just calls 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE() with no source/extension 
+ * fields and no cut-off.
+ */
+int FMM_COMPUTE_DISTANCE_FUNCTION_WITH_ENGINE(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE(
+           engine,
+           distance_function,
+           0, /*  NULL extension fields pointer */
+           phi,
+           mask,
+           0, /*  NULL source fields pointer */
+           0, /*  NULL extension_mask pointer */
+           0, /*  zero extension fields to compute */
+           spatial_discretization_order,
+           LSMLIB_REAL_MAX, /* no cut-off */
+           grid_dims,
+           dx);
+}
+
 void FMM_INITIALIZE_FRONT_ORDER1(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
@@ -401,7 +897,8 @@ void FMM_INITIALIZE_FRONT_ORDER1(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi = fmm_field_data->phi;
@@ -410,6 +907,7 @@ void FMM_INITIALIZE_FRONT_ORDER1(
   LSMLIB_REAL **source_fields = fmm_field_data->source_fields; 
   LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields;
   LSMLIB_REAL *extension_mask = fmm_field_data->extension_mask;
+  LSMLIB_REAL *boundary_mask = fmm_field_data->boundary_mask;
    
   /* grid variables */
   int offset[FMM_NDIM];
@@ -661,6 +1159,15 @@ void FMM_INITIALIZE_FRONT_ORDER1(
       FMM_Core_setInitialFrontPoint(fmm_core_data, grid_idx,
 				    distance_function[idx]);
 
+    } else if ((boundary_mask) && (boundary_mask[idx] > 0)) {
+
+      /* boundary grid point away from the interface: use the     */
+      /* externally supplied value as a tentative value so that   */
+      /* it is accepted in the correct order relative to the rest */
+      /* of the grid                                              */
+      FMM_Core_setInitialTrialPoint(fmm_core_data, grid_idx,
+                                    distance_function[idx]);
+
     } /* end handling grid points on or near interface */
 
   }  /* end loop over grid */
@@ -675,7 +1182,8 @@ void FMM_INITIALIZE_FRONT_ORDER2(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi = fmm_field_data->phi;
@@ -683,6 +1191,7 @@ void FMM_INITIALIZE_FRONT_ORDER2(
   int num_extension_fields = fmm_field_data->num_extension_fields; 
   LSMLIB_REAL **source_fields = fmm_field_data->source_fields; 
   LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
+  LSMLIB_REAL *boundary_mask = fmm_field_data->boundary_mask;
    
   /* grid variables */
   int neighbor_plus[FMM_NDIM], neighbor_minus[FMM_NDIM];
@@ -957,6 +1466,15 @@ void FMM_INITIALIZE_FRONT_ORDER2(
       FMM_Core_setInitialFrontPoint(fmm_core_data, grid_idx,
                                     distance_function[idx]);
 
+    } else if ((boundary_mask) && (boundary_mask[idx] > 0)) {
+
+      /* boundary grid point away from the interface: use the     */
+      /* externally supplied value as a tentative value so that   */
+      /* it is accepted in the correct order relative to the rest */
+      /* of the grid                                              */
+      FMM_Core_setInitialTrialPoint(fmm_core_data, grid_idx,
+                                    distance_function[idx]);
+
     } /* end handling grid points on or near interface */
 
   }  /* end loop over grid */
@@ -967,17 +1485,22 @@ void FMM_INITIALIZE_FRONT_ORDER2(
 LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx_cur_gridpoint,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
   int num_extension_fields = fmm_field_data->num_extension_fields; 
   LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
+  LSMLIB_REAL *boundary_mask = fmm_field_data->boundary_mask;
+  LSMLIB_REAL *boundary_distance_function = 
+    fmm_field_data->boundary_distance_function;
 
   /* variables for extension field calculations */
   LSMLIB_REAL *extension_fields_numerator = 
@@ -992,8 +1515,7 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   LSMLIB_REAL phi_upwind[FMM_NDIM];
   LSMLIB_REAL phi_plus;
   LSMLIB_REAL inv_dx_sq; 
-  int offset[FMM_NDIM]; 
-  int neighbor[FMM_NDIM];
+  int grid_stride[FMM_NDIM];
 
   /* coefficients of quadratic equation for the updated distance function */
   LSMLIB_REAL phi_A = 0;
@@ -1005,13 +1527,17 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   /* auxilliary variables */
   int dir;  /* loop variable for spatial directions */
   int k;    /* loop variable for extension fields */
-  int l;    /* extra loop variable */ 
-  int idx_cur_gridpoint, idx_neighbor;
-  int grid_idx_out_of_bounds;
+  int idx_neighbor;
 
   /* unused function parameters */
   (void) num_dims;
 
+  /* compute offsets of neighboring grid points in each direction */
+  grid_stride[0] = 1;
+  for (dir = 1; dir < FMM_NDIM; dir++) {
+    grid_stride[dir] = grid_stride[dir-1]*grid_dims[dir-1];
+  }
+
   /* initialize auxilliary variables for extension field calculations */
   for (k = 0; k < num_extension_fields; k++) {
     extension_fields_numerator[k] = 0;
@@ -1020,9 +1546,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
 
   /* calculate update to distance function */
   for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
-    for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
-      offset[l] = 0; 
-    }
 
     /* changed to true if has KNOWN neighbor */
     dir_used[dir] = LSM_FMM_FALSE;  
@@ -1031,13 +1554,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
     phi_upwind[dir] = LSMLIB_REAL_MAX;
 
     /* check minus direction */
-    offset[dir] = -1;
-    for (l = 0; l < FMM_NDIM; l++) {
-      neighbor[l] = grid_idx[l] + offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+    if (grid_idx[dir] > 0) {
+      idx_neighbor = idx_cur_gridpoint - grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
       if (KNOWN == neighbor_status) {
         phi_upwind[dir] = distance_function[idx_neighbor];
@@ -1047,13 +1565,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
     }
 
     /* check plus direction */
-    offset[dir] = 1;
-    for (l = 0; l < FMM_NDIM; l++) {
-      neighbor[l] = grid_idx[l] + offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+    if (grid_idx[dir] < grid_dims[dir]-1) {
+      idx_neighbor = idx_cur_gridpoint + grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
       if (KNOWN == neighbor_status) {
         phi_plus = distance_function[idx_neighbor];
@@ -1096,9 +1609,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   phi_B *= -2.0;
   phi_C -= 1.0;  
 
-  /* compute index of current grid point */
-  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
-
   /* compute updated distance function by solving quadratic equation */
   discriminant = phi_B*phi_B - 4.0*phi_A*phi_C;
   dist_updated = LSMLIB_REAL_MAX;
@@ -1142,14 +1652,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
        * direction was used in the update of the distance function
        */
       if (dir_used[dir]) {
-        for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
-          offset[l] = 0; 
-        }
-        offset[dir] = (use_plus[dir] ? 1 : -1);
-        for (l = 0; l < FMM_NDIM; l++) {
-          neighbor[l] = grid_idx[l] + offset[l];
-        }
-        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        idx_neighbor = idx_cur_gridpoint 
+                     + (use_plus[dir] ? 1 : -1)*grid_stride[dir];
   
         inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
 
@@ -1166,6 +1670,20 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   } /* end case: num_extension_fields > 0 */
 
 
+  /* retain supplied boundary values if they are smaller than the */
+  /* updated value                                                 */
+  if ( (boundary_mask) && (boundary_mask[idx_cur_gridpoint] > 0)
+    && (  LSM_FMM_ABS(boundary_distance_function[idx_cur_gridpoint])
+       <= LSM_FMM_ABS(dist_updated)) ) {
+    distance_function[idx_cur_gridpoint] = 
+      boundary_distance_function[idx_cur_gridpoint];
+    for (k = 0; k < num_extension_fields; k++) {
+      extension_fields[k][idx_cur_gridpoint] =
+        fmm_field_data->boundary_extension_fields[k][idx_cur_gridpoint];
+    }
+    return distance_function[idx_cur_gridpoint];
+  }
+
   /* set updated quantities */
   distance_function[idx_cur_gridpoint] = dist_updated;
   for (k = 0; k < num_extension_fields; k++) {
@@ -1180,17 +1698,22 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
 LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
+  int idx_cur_gridpoint,
   int *grid_idx,
   int num_dims,
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
   int num_extension_fields = fmm_field_data->num_extension_fields; 
   LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
+  LSMLIB_REAL *boundary_mask = fmm_field_data->boundary_mask;
+  LSMLIB_REAL *boundary_distance_function = 
+    fmm_field_data->boundary_distance_function;
 
   /* variables for extension field calculations */
   LSMLIB_REAL *extension_fields_numerator = 
@@ -1206,9 +1729,7 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   int second_order_switch[FMM_NDIM];
   LSMLIB_REAL phi_plus;
   LSMLIB_REAL inv_dx_sq; 
-  int offset[FMM_NDIM]; 
-  int neighbor1[FMM_NDIM];
-  int neighbor2[FMM_NDIM];
+  int grid_stride[FMM_NDIM];
 
   /* coefficients of quadratic equation for the updated distance function */
   LSMLIB_REAL phi_A = 0;
@@ -1220,13 +1741,17 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   /* auxilliary variables */
   int dir;  /* loop variable for spatial directions */
   int k;    /* loop variable for extension fields */
-  int l;    /* extra loop variable */ 
-  int idx_cur_gridpoint, idx_neighbor1, idx_neighbor2;
-  int grid_idx_out_of_bounds;
+  int idx_neighbor1, idx_neighbor2;
 
   /* unused function parameters */
   (void) num_dims;
 
+  /* compute offsets of neighboring grid points in each direction */
+  grid_stride[0] = 1;
+  for (dir = 1; dir < FMM_NDIM; dir++) {
+    grid_stride[dir] = grid_stride[dir-1]*grid_dims[dir-1];
+  }
+
   /* initialize auxilliary variables used for extension field calculation */
   for (k = 0; k < num_extension_fields; k++) {
     extension_fields_numerator[k] = 0;
@@ -1235,9 +1760,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
 
   /* calculate update to distance function */
   for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
-    for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
-      offset[l] = 0; 
-    }
 
     /* changed to true if has KNOWN neighbor */
     dir_used[dir] = LSM_FMM_FALSE;  
@@ -1251,14 +1773,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
     second_order_switch[dir] = 0;
 
     /* check minus direction */
-    offset[dir] = -1;
-    for (l = 0; l < FMM_NDIM; l++) {
-      neighbor1[l] = grid_idx[l] + offset[l];
-      neighbor2[l] = grid_idx[l] + 2*offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor1,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
+    if (grid_idx[dir] > 0) {
+      idx_neighbor1 = idx_cur_gridpoint - grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor1];
       if (KNOWN == neighbor_status) {
         phi_upwind1[dir] = distance_function[idx_neighbor1];
@@ -1266,9 +1782,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
         dir_used[dir] = LSM_FMM_TRUE;
 
         /* check for neighbor required for second-order accuracy */
-        LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor2,grid_dims);
-        if (!grid_idx_out_of_bounds) {
-          LSM_FMM_IDX(idx_neighbor2, neighbor2, grid_dims);
+        if (grid_idx[dir] > 1) {
+          idx_neighbor2 = idx_cur_gridpoint - 2*grid_stride[dir];
           neighbor_status = (PointStatus) gridpoint_status[idx_neighbor2];
           if ( (KNOWN == neighbor_status) &&
                (  LSM_FMM_ABS(distance_function[idx_neighbor2])
@@ -1282,14 +1797,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
     }
 
     /* check plus direction */
-    offset[dir] = 1;
-    for (l = 0; l < FMM_NDIM; l++) {
-      neighbor1[l] = grid_idx[l] + offset[l];
-      neighbor2[l] = grid_idx[l] + 2*offset[l];
-    }
-    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor1,grid_dims);
-    if (!grid_idx_out_of_bounds) {
-      LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
+    if (grid_idx[dir] < grid_dims[dir]-1) {
+      idx_neighbor1 = idx_cur_gridpoint + grid_stride[dir];
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor1];
       if (KNOWN == neighbor_status) {
         phi_plus = distance_function[idx_neighbor1];
@@ -1307,9 +1816,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
           dir_used[dir] = LSM_FMM_TRUE;
           
           /* check for neighbor required for second-order accuracy */
-          LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor2,grid_dims);
-          if (!grid_idx_out_of_bounds) {
-            LSM_FMM_IDX(idx_neighbor2, neighbor2, grid_dims);
+          if (grid_idx[dir] < grid_dims[dir]-2) {
+            idx_neighbor2 = idx_cur_gridpoint + 2*grid_stride[dir];
             neighbor_status = (PointStatus) gridpoint_status[idx_neighbor2];
             if ( (KNOWN == neighbor_status) &&
                  (  LSM_FMM_ABS(distance_function[idx_neighbor2])
@@ -1360,9 +1868,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   phi_B *= -2.0;
   phi_C -= 1.0;  
 
-  /* compute index of current grid point */
-  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
-
   /* compute updated distance function by solving quadratic equation */
   discriminant = phi_B*phi_B - 4.0*phi_A*phi_C;
   dist_updated = LSMLIB_REAL_MAX;
@@ -1406,16 +1911,9 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
        * direction was used in the update of the distance function
        */
       if (dir_used[dir]) {
-        for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
-          offset[l] = 0; 
-        }
-        offset[dir] = (use_plus[dir] == LSM_FMM_TRUE ? 1 : -1);
-        for (l = 0; l < FMM_NDIM; l++) {
-          neighbor1[l] = grid_idx[l] + offset[l];
-          neighbor2[l] = grid_idx[l] + 2*offset[l];
-        }
-        LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
-        LSM_FMM_IDX(idx_neighbor2, neighbor2, grid_dims);
+        int offset = (use_plus[dir] == LSM_FMM_TRUE ? 1 : -1)*grid_stride[dir];
+        idx_neighbor1 = idx_cur_gridpoint + offset;
+        idx_neighbor2 = idx_cur_gridpoint + 2*offset;
   
         inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
         if (second_order_switch[dir] == 1) {
@@ -1459,6 +1957,20 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   } /* end case: num_extension_fields > 0 */
 
 
+  /* retain supplied boundary values if they are smaller than the */
+  /* updated value                                                 */
+  if ( (boundary_mask) && (boundary_mask[idx_cur_gridpoint] > 0)
+    && (  LSM_FMM_ABS(boundary_distance_function[idx_cur_gridpoint])
+       <= LSM_FMM_ABS(dist_updated)) ) {
+    distance_function[idx_cur_gridpoint] = 
+      boundary_distance_function[idx_cur_gridpoint];
+    for (k = 0; k < num_extension_fields; k++) {
+      extension_fields[k][idx_cur_gridpoint] =
+        fmm_field_data->boundary_extension_fields[k][idx_cur_gridpoint];
+    }
+    return distance_function[idx_cur_gridpoint];
+  }
+
   /* set updated quantities */
   distance_function[idx_cur_gridpoint] = dist_updated;
   for (k = 0; k < num_extension_fields; k++) {
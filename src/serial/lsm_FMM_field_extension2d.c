@@ -23,6 +23,20 @@
 #define FMM_NDIM                         2
 #define FMM_COMPUTE_DISTANCE_FUNCTION    computeDistanceFunction2d
 #define FMM_COMPUTE_EXTENSION_FIELDS     computeExtensionFields2d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_BOUNDARY_DATA                     \
+        computeExtensionFieldsWithBoundaryData2d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_CUTOFF                           \
+        computeDistanceFunctionWithCutoff2d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF                            \
+        computeExtensionFieldsWithCutoff2d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE                        \
+        computeDistanceFunctionWithWorkspace2d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE                         \
+        computeExtensionFieldsWithWorkspace2d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_ENGINE                           \
+        computeDistanceFunctionWithEngine2d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE                            \
+        computeExtensionFieldsWithEngine2d
 #define FMM_INITIALIZE_FRONT_ORDER1                                         \
         FMM_initializeFront_FieldExtension2d_Order1
 #define FMM_INITIALIZE_FRONT_ORDER2                                         \
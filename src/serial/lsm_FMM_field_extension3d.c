@@ -23,6 +23,20 @@
 #define FMM_NDIM                         3
 #define FMM_COMPUTE_DISTANCE_FUNCTION    computeDistanceFunction3d
 #define FMM_COMPUTE_EXTENSION_FIELDS     computeExtensionFields3d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_BOUNDARY_DATA                     \
+        computeExtensionFieldsWithBoundaryData3d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_CUTOFF                           \
+        computeDistanceFunctionWithCutoff3d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_CUTOFF                            \
+        computeExtensionFieldsWithCutoff3d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE                        \
+        computeDistanceFunctionWithWorkspace3d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE                         \
+        computeExtensionFieldsWithWorkspace3d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_ENGINE                           \
+        computeDistanceFunctionWithEngine3d
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_ENGINE                            \
+        computeExtensionFieldsWithEngine3d
 #define FMM_INITIALIZE_FRONT_ORDER1                                         \
         FMM_initializeFront_FieldExtension3d_Order1
 #define FMM_INITIALIZE_FRONT_ORDER2                                         \
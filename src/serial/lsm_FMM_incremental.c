@@ -0,0 +1,572 @@
+/*
+ * File:        lsm_FMM_incremental.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation of 2D and 3D incremental distance function
+ *              calculations using the Fast Marching Method
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "LSMLIB_config.h"
+#include "FMM_Macros.h"
+#include "lsm_fast_marching_method.h"
+
+
+/*========================= Constants ===============================*/
+
+/* maximum number of spatial dimensions supported */
+#define LSM_FMM_INCR_MAX_NDIM              (3)
+
+/* change in phi below which a value is considered unchanged */
+#define LSM_FMM_INCR_TOL                   (LSMLIB_ZERO_TOL)
+
+/* change in the distance function (relative to the grid spacing) */
+/* below which a value is considered unchanged                    */
+#define LSM_FMM_INCR_DIST_TOL              (1.e-6)
+
+/* fraction of the grid above which the full calculation is cheaper */
+/* than re-marching the region that changed                         */
+#define LSM_FMM_INCR_MAX_REGION_FRACTION   (0.25)
+
+/* classification of grid points */
+#define LSM_FMM_INCR_UNCHANGED             (0)
+#define LSM_FMM_INCR_RECOMPUTE             (1)
+#define LSM_FMM_INCR_BOUNDARY              (2)
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * FMM_computeDistanceFunctionIncrementally() carries out the
+ * incremental distance function calculation for
+ * computeDistanceFunctionIncrementally2d() and
+ * computeDistanceFunctionIncrementally3d().
+ */
+static int FMM_computeDistanceFunctionIncrementally(
+  int num_dims,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_prev,
+  LSMLIB_REAL *change_mask,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*
+ * FMM_bordersZeroLevelSet() returns 1 if the grid point idx is on or
+ * adjacent to the zero level set of f and 0 otherwise.
+ */
+static int FMM_bordersZeroLevelSet(
+  LSMLIB_REAL *f,
+  int idx,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  int *grid_stride);
+
+/*
+ * FMM_dilateRegion() sets flag[idx] to 1 at every grid point within
+ * width grid cells (in the max-norm) of a grid point where flag is
+ * nonzero.  work must be at least as large as flag.
+ */
+static void FMM_dilateRegion(
+  unsigned char *flag,
+  unsigned char *work,
+  int width,
+  int num_dims,
+  int *grid_dims,
+  int *grid_stride);
+
+
+/*================== Helper Functions Definitions ===================*/
+
+static int FMM_bordersZeroLevelSet(
+  LSMLIB_REAL *f,
+  int idx,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  int *grid_stride)
+{
+  LSMLIB_REAL f_cur = f[idx];
+  int dir;
+
+  if (fabs(f_cur) < LSMLIB_ZERO_TOL) return 1;
+
+  for (dir = 0; dir < num_dims; dir++) {
+    if ( (grid_idx[dir] > 0)
+      && (f[idx-grid_stride[dir]]*f_cur <= 0) ) return 1;
+    if ( (grid_idx[dir] < grid_dims[dir]-1)
+      && (f[idx+grid_stride[dir]]*f_cur <= 0) ) return 1;
+  }
+
+  return 0;
+}
+
+
+static void FMM_dilateRegion(
+  unsigned char *flag,
+  unsigned char *work,
+  int width,
+  int num_dims,
+  int *grid_dims,
+  int *grid_stride)
+{
+  int num_gridpoints = grid_stride[num_dims-1]*grid_dims[num_dims-1];
+  int dir, idx, i;
+
+  /* the max-norm dilation is carried out one direction at a time */
+  for (dir = 0; dir < num_dims; dir++) {
+    int n = grid_dims[dir];
+    int stride = grid_stride[dir];
+
+    memcpy(work, flag, num_gridpoints*sizeof(unsigned char));
+
+    /* loop over the first grid point of every grid line in direction dir */
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      int dist;
+
+      if ( (idx/stride)%n != 0 ) continue;
+
+      /* forward pass */
+      dist = width + 1;
+      for (i = 0; i < n; i++) {
+        if (work[idx+i*stride]) dist = 0; else dist++;
+        if (dist <= width) flag[idx+i*stride] = 1;
+      }
+
+      /* backward pass */
+      dist = width + 1;
+      for (i = n-1; i >= 0; i--) {
+        if (work[idx+i*stride]) dist = 0; else dist++;
+        if (dist <= width) flag[idx+i*stride] = 1;
+      }
+    }
+  }
+}
+
+
+static int FMM_computeDistanceFunctionIncrementally(
+  int num_dims,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_prev,
+  LSMLIB_REAL *change_mask,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  /* work arrays on the full grid */
+  LSMLIB_REAL *distance_function_prev;
+  unsigned char *region;
+  unsigned char *flag;
+  unsigned char *work;
+
+  /* work arrays on the box containing the region */
+  LSMLIB_REAL *box_distance_function = 0;
+  LSMLIB_REAL *box_phi = 0;
+  LSMLIB_REAL *box_mask = 0;
+  LSMLIB_REAL *box_boundary_mask = 0;
+  unsigned char *box_region = 0;
+  unsigned char *box_work = 0;
+  int box_size_allocated = 0;
+
+  /* grid variables (2D grids are treated as 3D grids with a single */
+  /* grid point in the z-direction)                                 */
+  int dims[LSM_FMM_INCR_MAX_NDIM];
+  int grid_stride[LSM_FMM_INCR_MAX_NDIM];
+  int grid_idx[LSM_FMM_INCR_MAX_NDIM];
+  int box_lo[LSM_FMM_INCR_MAX_NDIM];
+  int box_hi[LSM_FMM_INCR_MAX_NDIM];
+  int box_dims[LSM_FMM_INCR_MAX_NDIM];
+  int box_stride[LSM_FMM_INCR_MAX_NDIM];
+  int num_gridpoints;
+  int num_changed;
+  int num_recompute;
+  int box_size;
+
+  /* auxiliary variables */
+  int order = spatial_discretization_order;
+  LSMLIB_REAL dx_min;
+  LSMLIB_REAL dist_tol;
+  int growth_width;
+  int region_is_complete;
+  int error_code = LSM_FMM_ERR_SUCCESS;
+  int idx, box_idx, dir, i, j, k;
+
+
+  /* check arguments */
+  if ( (order != 1) && (order != 2) ) {
+    fprintf(stderr,
+           "ERROR: Invalid spatial derivative order.  Only first-\n");
+    fprintf(stderr,
+           "       and second-order finite differences supported.\n");
+    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
+  }
+  if (max_distance <= 0) {
+    fprintf(stderr,
+           "ERROR: Invalid cut-off distance.  max_distance must be\n");
+    fprintf(stderr,
+           "       positive.\n");
+    return LSM_FMM_ERR_INVALID_CUTOFF_DISTANCE;
+  }
+
+  /* without information about the change in phi, recompute the */
+  /* distance function everywhere.  this is also done for the    */
+  /* second-order scheme because its values at the edge of the   */
+  /* region depend on the order in which the boundary data are   */
+  /* accepted, so they never agree with the previous distance    */
+  /* function closely enough to stop the region from growing.    */
+  if ( ((!change_mask) && (!phi_prev)) || (order != 1) ) {
+    return (2 == num_dims) ?
+      computeDistanceFunctionWithCutoff2d(distance_function, phi, mask,
+                                          order, max_distance,
+                                          grid_dims, dx) :
+      computeDistanceFunctionWithCutoff3d(distance_function, phi, mask,
+                                          order, max_distance,
+                                          grid_dims, dx);
+  }
+
+  /* set up grid information */
+  for (dir = 0; dir < LSM_FMM_INCR_MAX_NDIM; dir++) {
+    dims[dir] = (dir < num_dims) ? grid_dims[dir] : 1;
+  }
+  grid_stride[0] = 1;
+  for (dir = 1; dir < LSM_FMM_INCR_MAX_NDIM; dir++) {
+    grid_stride[dir] = grid_stride[dir-1]*dims[dir-1];
+  }
+  num_gridpoints = grid_stride[2]*dims[2];
+  dx_min = dx[0];
+  for (dir = 1; dir < num_dims; dir++) {
+    if (dx[dir] < dx_min) dx_min = dx[dir];
+  }
+  dist_tol = LSM_FMM_INCR_DIST_TOL*dx_min;
+
+  /* allocate memory for work arrays */
+  region = (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+  flag = (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+  work = (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+  if ( (!region) || (!flag) || (!work) ) {
+    free(region); free(flag); free(work);
+    return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  }
+
+  /******************************************************
+   * find grid points where the change in phi affects the
+   * distance function.  because the distance function
+   * depends on phi only through the grid points on or
+   * adjacent to the zero level set, changes elsewhere
+   * are ignored.
+   ******************************************************/
+  num_changed = 0;
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    int idx_remainder = idx;
+
+    flag[idx] = 0;
+    if ((mask) && (mask[idx] < 0)) continue;
+
+    if (change_mask) {
+      flag[idx] = (change_mask[idx] > 0);
+    } else if (fabs(phi[idx] - phi_prev[idx]) > LSM_FMM_INCR_TOL) {
+      for (dir = 0; dir < num_dims; dir++) {
+        grid_idx[dir] = idx_remainder%grid_dims[dir];
+        idx_remainder /= grid_dims[dir];
+      }
+      flag[idx] =
+           FMM_bordersZeroLevelSet(phi, idx, grid_idx,
+                                   num_dims, grid_dims, grid_stride)
+        || FMM_bordersZeroLevelSet(phi_prev, idx, grid_idx,
+                                   num_dims, grid_dims, grid_stride);
+    }
+    num_changed += flag[idx];
+  }
+
+  /* nothing to do if the zero level set has not changed */
+  if (0 == num_changed) {
+    free(region); free(flag); free(work);
+    return LSM_FMM_ERR_SUCCESS;
+  }
+
+  /* save the previous distance function (phi_prev may be */
+  /* distance_function, so this is done after the changes */
+  /* in phi have been found)                               */
+  distance_function_prev =
+    (LSMLIB_REAL*) malloc(num_gridpoints*sizeof(LSMLIB_REAL));
+  if (!distance_function_prev) {
+    free(region); free(flag); free(work);
+    return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  }
+  memcpy(distance_function_prev, distance_function,
+         num_gridpoints*sizeof(LSMLIB_REAL));
+
+  /* the distance function can change anywhere within the cut-off */
+  /* distance of the grid points where phi changed, so the region */
+  /* starts out one cut-off distance wide (plus a stencil width   */
+  /* so that the changes do not reach the edge of the region)     */
+  growth_width = 2*order;
+  if (max_distance < LSMLIB_REAL_MAX) {
+    LSMLIB_REAL cutoff_width = max_distance/dx_min + order + 1;
+    int max_width = dims[0] + dims[1] + dims[2];
+    growth_width = (cutoff_width < max_width) ? 
+                   (int) ceil(cutoff_width) : max_width;
+  }
+  FMM_dilateRegion(flag, work, growth_width, num_dims, dims, grid_stride);
+  memcpy(region, flag, num_gridpoints*sizeof(unsigned char));
+
+  /******************************************************
+   * re-march the region until the values at the edge of
+   * the region agree with the previous distance function
+   ******************************************************/
+  region_is_complete = 0;
+  while (!region_is_complete) {
+
+    /* once the region covers a large part of the grid, it is */
+    /* cheaper to recompute the distance function everywhere */
+    num_recompute = 0;
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      num_recompute += region[idx];
+    }
+    if (num_recompute > LSM_FMM_INCR_MAX_REGION_FRACTION*num_gridpoints) {
+      error_code = (2 == num_dims) ?
+        computeDistanceFunctionWithCutoff2d(distance_function, phi, mask,
+                                            order, max_distance,
+                                            grid_dims, dx) :
+        computeDistanceFunctionWithCutoff3d(distance_function, phi, mask,
+                                            order, max_distance,
+                                            grid_dims, dx);
+      break;
+    }
+
+    /* find the box containing the region, the grid points within  */
+    /* one stencil width of the region (which supply boundary data */
+    /* for the calculation), and one more layer of grid points (so */
+    /* that the front is initialized in the same way as on the     */
+    /* full grid)                                                  */
+    for (dir = 0; dir < LSM_FMM_INCR_MAX_NDIM; dir++) {
+      box_lo[dir] = dims[dir];
+      box_hi[dir] = -1;
+    }
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      int idx_remainder = idx;
+
+      if (!region[idx]) continue;
+      for (dir = 0; dir < LSM_FMM_INCR_MAX_NDIM; dir++) {
+        grid_idx[dir] = idx_remainder%dims[dir];
+        idx_remainder /= dims[dir];
+        if (grid_idx[dir] < box_lo[dir]) box_lo[dir] = grid_idx[dir];
+        if (grid_idx[dir] > box_hi[dir]) box_hi[dir] = grid_idx[dir];
+      }
+    }
+    box_size = 1;
+    for (dir = 0; dir < LSM_FMM_INCR_MAX_NDIM; dir++) {
+      box_lo[dir] -= order + 1;
+      if (box_lo[dir] < 0) box_lo[dir] = 0;
+      box_hi[dir] += order + 1;
+      if (box_hi[dir] > dims[dir]-1) box_hi[dir] = dims[dir]-1;
+      box_dims[dir] = box_hi[dir] - box_lo[dir] + 1;
+      box_stride[dir] = (0 == dir) ? 1 : box_stride[dir-1]*box_dims[dir-1];
+      box_size *= box_dims[dir];
+    }
+
+    /* allocate memory for the box data */
+    if (box_size > box_size_allocated) {
+      free(box_distance_function); free(box_phi); free(box_mask);
+      free(box_boundary_mask); free(box_region); free(box_work);
+      box_distance_function = 
+        (LSMLIB_REAL*) malloc(box_size*sizeof(LSMLIB_REAL));
+      box_phi = (LSMLIB_REAL*) malloc(box_size*sizeof(LSMLIB_REAL));
+      box_mask = (LSMLIB_REAL*) malloc(box_size*sizeof(LSMLIB_REAL));
+      box_boundary_mask = (LSMLIB_REAL*) malloc(box_size*sizeof(LSMLIB_REAL));
+      box_region = (unsigned char*) malloc(box_size*sizeof(unsigned char));
+      box_work = (unsigned char*) malloc(box_size*sizeof(unsigned char));
+      box_size_allocated = box_size;
+      if ( (!box_distance_function) || (!box_phi) || (!box_mask) 
+        || (!box_boundary_mask) || (!box_region) || (!box_work) ) {
+        error_code = LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+        break;
+      }
+    }
+
+    /* classify the grid points in the box */
+    for (k = 0, box_idx = 0; k < box_dims[2]; k++) {
+      for (j = 0; j < box_dims[1]; j++) {
+        idx = box_lo[0] + (box_lo[1]+j)*grid_stride[1] 
+            + (box_lo[2]+k)*grid_stride[2];
+        for (i = 0; i < box_dims[0]; i++, idx++, box_idx++) {
+          box_region[box_idx] = region[idx];
+        }
+      }
+    }
+    memcpy(box_work, box_region, box_size*sizeof(unsigned char));
+    FMM_dilateRegion(box_work, flag, order, num_dims, box_dims, box_stride);
+
+    /* copy data into the box and restrict the calculation to the */
+    /* recomputed region and its boundary                         */
+    for (k = 0, box_idx = 0; k < box_dims[2]; k++) {
+      for (j = 0; j < box_dims[1]; j++) {
+        idx = box_lo[0] + (box_lo[1]+j)*grid_stride[1] 
+            + (box_lo[2]+k)*grid_stride[2];
+        for (i = 0; i < box_dims[0]; i++, idx++, box_idx++) {
+          if (box_region[box_idx]) {
+            box_region[box_idx] = LSM_FMM_INCR_RECOMPUTE;
+          } else if (box_work[box_idx]) {
+            box_region[box_idx] = LSM_FMM_INCR_BOUNDARY;
+          }
+          box_phi[box_idx] = phi[idx];
+          box_distance_function[box_idx] = distance_function_prev[idx];
+          box_mask[box_idx] = 
+            ( (LSM_FMM_INCR_UNCHANGED == box_region[box_idx])
+           || ((mask) && (mask[idx] < 0)) ) ? -1.0 : 1.0;
+          box_boundary_mask[box_idx] =
+            (LSM_FMM_INCR_BOUNDARY == box_region[box_idx]) ? 1.0 : -1.0;
+        }
+      }
+    }
+
+    error_code = (2 == num_dims) ?
+      computeExtensionFieldsWithBoundaryData2d(
+        box_distance_function, 0, box_phi, box_mask, 0, 0, 
+        box_boundary_mask, 0, order, box_dims, dx) :
+      computeExtensionFieldsWithBoundaryData3d(
+        box_distance_function, 0, box_phi, box_mask, 0, 0, 
+        box_boundary_mask, 0, order, box_dims, dx);
+    if (error_code != LSM_FMM_ERR_SUCCESS) break;
+
+    /* copy the recomputed values back into the full grid and find  */
+    /* grid points that changed and whose stencil reaches outside   */
+    /* of the recomputed region.  the values outside of the region  */
+    /* only remain valid if there are none.                         */
+    region_is_complete = 1;
+    memset(flag, 0, num_gridpoints*sizeof(unsigned char));
+    for (k = 0, box_idx = 0; k < box_dims[2]; k++) {
+      for (j = 0; j < box_dims[1]; j++) {
+        idx = box_lo[0] + (box_lo[1]+j)*grid_stride[1] 
+            + (box_lo[2]+k)*grid_stride[2];
+        for (i = 0; i < box_dims[0]; i++, idx++, box_idx++) {
+          int box_grid_idx[LSM_FMM_INCR_MAX_NDIM];
+          int l;
+
+          if (LSM_FMM_INCR_RECOMPUTE != box_region[box_idx]) continue;
+
+          /* apply the cut-off to the recomputed values */
+          if ( (max_distance < LSMLIB_REAL_MAX)
+            && (!((mask) && (mask[idx] < 0)))
+            && (fabs(box_distance_function[box_idx]) > max_distance) ) {
+            box_distance_function[box_idx] =
+              (phi[idx] > 0) ? max_distance : -max_distance;
+          }
+          distance_function[idx] = box_distance_function[box_idx];
+
+          if ((mask) && (mask[idx] < 0)) continue;
+          if ( fabs(distance_function[idx] - distance_function_prev[idx])
+               <= dist_tol ) continue;
+
+          box_grid_idx[0] = i; box_grid_idx[1] = j; box_grid_idx[2] = k;
+          for (dir = 0; (dir < num_dims) && (!flag[idx]); dir++) {
+            for (l = 1; l <= order; l++) {
+              if ( ( (box_lo[dir]+box_grid_idx[dir]-l >= 0) &&
+                     (LSM_FMM_INCR_RECOMPUTE !=
+                      box_region[box_idx-l*box_stride[dir]]) )
+                || ( (box_lo[dir]+box_grid_idx[dir]+l < dims[dir]) &&
+                     (LSM_FMM_INCR_RECOMPUTE !=
+                      box_region[box_idx+l*box_stride[dir]]) ) ) {
+                flag[idx] = 1;
+                region_is_complete = 0;
+                break;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    /* grow the region around the grid points that changed at its */
+    /* edge (the growth rate doubles on every pass so that the     */
+    /* number of passes stays small)                               */
+    if (!region_is_complete) {
+      FMM_dilateRegion(flag, work, growth_width, num_dims, dims, grid_stride);
+      for (idx = 0; idx < num_gridpoints; idx++) {
+        region[idx] = region[idx] || flag[idx];
+      }
+      growth_width *= 2;
+    }
+
+  } /* end loop over passes */
+
+  /* clean up memory */
+  free(distance_function_prev);
+  free(region);
+  free(flag);
+  free(work);
+  free(box_distance_function);
+  free(box_phi);
+  free(box_mask);
+  free(box_boundary_mask);
+  free(box_region);
+  free(box_work);
+
+  return error_code;
+}
+
+
+/*==================== Function Definitions =========================*/
+
+int computeDistanceFunctionIncrementally2d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_prev,
+  LSMLIB_REAL *change_mask,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_computeDistanceFunctionIncrementally(
+           2,
+           distance_function,
+           phi,
+           phi_prev,
+           change_mask,
+           mask,
+           spatial_discretization_order,
+           max_distance,
+           grid_dims,
+           dx);
+}
+
+
+int computeDistanceFunctionIncrementally3d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_prev,
+  LSMLIB_REAL *change_mask,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return FMM_computeDistanceFunctionIncrementally(
+           3,
+           distance_function,
+           phi,
+           phi_prev,
+           change_mask,
+           mask,
+           spatial_discretization_order,
+           max_distance,
+           grid_dims,
+           dx);
+}
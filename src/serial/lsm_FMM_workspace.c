@@ -0,0 +1,121 @@
+/*
+ * File:        lsm_FMM_workspace.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation of reusable workspaces for the fast
+ *              marching method functions
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "LSMLIB_config.h"
+#include "FMM_Core.h"
+#include "lsm_fast_marching_method.h"
+
+
+/*================== LSM_FMM_Workspace Data Structures ==============*/
+struct LSM_FMM_Workspace {
+  FMM_CoreData *fmm_core_data;   /* FMM_CoreData reused by all      */
+                                 /* calculations (NULL before the   */
+                                 /* first calculation)              */
+  int core_data_in_use;          /* flag indicating whether the     */
+                                 /* FMM_CoreData is being used by a */
+                                 /* calculation                     */
+};
+
+
+/*=============== LSM_FMM_Workspace Function Definitions ============*/
+
+LSM_FMM_Workspace* createFMMWorkspace(void)
+{
+  LSM_FMM_Workspace *workspace =
+    (LSM_FMM_Workspace*) malloc(sizeof(LSM_FMM_Workspace));
+  if (!workspace) return 0;
+
+  workspace->fmm_core_data = 0;
+  workspace->core_data_in_use = 0;
+
+  return workspace;
+}
+
+
+void destroyFMMWorkspace(LSM_FMM_Workspace *workspace)
+{
+  if (!workspace) return;
+
+  if (workspace->fmm_core_data) {
+    FMM_Core_destroyFMM_CoreData(workspace->fmm_core_data);
+  }
+  free(workspace);
+}
+
+
+FMM_CoreData* FMM_acquireCoreData(
+  LSM_FMM_Workspace *workspace,
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL bucket_width)
+{
+  /* without a workspace (or if the workspace is already in use), */
+  /* create a new FMM_CoreData for the calculation                */
+  if ( (!workspace) || (workspace->core_data_in_use) ) {
+    return FMM_Core_createFMM_CoreDataWithQueue(
+             fmm_field_data,
+             num_dims,
+             grid_dims,
+             dx,
+             initializeFront,
+             updateGridPoint,
+             queue_type,
+             bucket_width);
+  }
+
+  if (workspace->fmm_core_data) {
+    FMM_Core_resetFMM_CoreData(
+      workspace->fmm_core_data,
+      fmm_field_data,
+      num_dims,
+      grid_dims,
+      dx,
+      initializeFront,
+      updateGridPoint,
+      queue_type,
+      bucket_width);
+  } else {
+    workspace->fmm_core_data = FMM_Core_createFMM_CoreDataWithQueue(
+                                 fmm_field_data,
+                                 num_dims,
+                                 grid_dims,
+                                 dx,
+                                 initializeFront,
+                                 updateGridPoint,
+                                 queue_type,
+                                 bucket_width);
+    if (!workspace->fmm_core_data) return 0;
+  }
+  workspace->core_data_in_use = 1;
+
+  return workspace->fmm_core_data;
+}
+
+
+void FMM_releaseCoreData(
+  LSM_FMM_Workspace *workspace,
+  FMM_CoreData *fmm_core_data)
+{
+  /* FMM_CoreData owned by the workspace is kept for reuse */
+  if ( (workspace) && (workspace->fmm_core_data == fmm_core_data) ) {
+    workspace->core_data_in_use = 0;
+    return;
+  }
+
+  FMM_Core_destroyFMM_CoreData(fmm_core_data);
+}
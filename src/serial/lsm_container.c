@@ -0,0 +1,652 @@
+/*
+ * File:        lsm_container.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for LSM_Container: a self-describing
+ *              binary file holding a Grid and named data arrays
+ */
+
+/* 64-bit file offsets (fields of large grids extend beyond 2GB) */
+#define _FILE_OFFSET_BITS 64
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "lsm_container.h"
+
+#ifdef LSMLIB_HAVE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)
+#include <stdint.h>
+typedef uint32_t LSM_UInt32;
+typedef int32_t  LSM_Int32;
+typedef uint64_t LSM_UInt64;
+#else
+typedef unsigned int        LSM_UInt32;
+typedef int                 LSM_Int32;
+typedef unsigned long long  LSM_UInt64;
+#endif
+
+#define LSM_CONTAINER_MAGIC       "LSMLIBCF"
+#define LSM_CONTAINER_BYTE_ORDER  0x01020304u
+#define LSM_CONTAINER_VERSION     1
+
+/* number of Grid parameters stored as integers and as reals */
+#define LSM_CONTAINER_GRID_NUM_INTS    42
+#define LSM_CONTAINER_GRID_NUM_MARKS   5
+#define LSM_CONTAINER_GRID_NUM_REALS   17
+
+/* number of elements converted at a time when writing/reading fields */
+#define LSM_CONTAINER_CHUNK_SIZE       65536
+
+/* on-disk header (64 bytes) */
+typedef struct _LSM_ContainerHeader
+{
+  char        magic[8];
+  LSM_UInt32  byte_order;
+  LSM_UInt32  version;
+  LSM_UInt32  alignment;
+  LSM_UInt32  num_fields;
+  LSM_UInt64  grid_offset;
+  LSM_UInt64  directory_offset;
+  LSM_UInt64  reserved[3];
+} LSM_ContainerHeader;
+
+/* on-disk field directory entry (96 bytes) */
+typedef struct _LSM_ContainerEntry
+{
+  char        name[LSM_CONTAINER_MAX_NAME_LENGTH];
+  LSM_UInt32  storage_type;
+  LSM_UInt32  reserved0;
+  LSM_UInt64  num_elements;
+  LSM_UInt64  offset;
+  LSM_UInt64  reserved1;
+} LSM_ContainerEntry;
+
+/* on-disk Grid section: counts followed by the integer parameters */
+/* (plus padding to 8 bytes) and the real parameters               */
+typedef struct _LSM_ContainerGrid
+{
+  LSM_UInt32  num_ints;
+  LSM_UInt32  num_reals;
+  LSM_Int32   ints[LSM_CONTAINER_GRID_NUM_INTS
+                   + LSM_CONTAINER_GRID_NUM_MARKS + 1];
+  double      reals[LSM_CONTAINER_GRID_NUM_REALS];
+} LSM_ContainerGrid;
+
+struct _LSM_Container
+{
+  int                  writing;     /* opened by createLSMContainer() */
+  int                  swap;        /* file has opposite byte order   */
+  int                  error;       /* nonzero if an I/O error occurred */
+  FILE                *fp;
+
+  LSM_ContainerHeader  header;
+  LSM_ContainerGrid    grid;
+
+  /* field directory and (converted or read) field data */
+  LSM_ContainerEntry  *entries;
+  LSMLIB_REAL        **data;
+  int                  num_alloc_entries;
+
+  /* memory-mapped file (NULL if the file is not mapped) */
+  void                *map;
+  size_t               map_size;
+};
+
+
+/*============ Helper functions ==============*/
+
+/* getGridIntFields() collects pointers to the integer Grid parameters */
+/* in the order in which they are stored in a container file.          */
+static void getGridIntFields(Grid *grid, int **p)
+{
+  int n = 0, i;
+
+  p[n++] = &(grid->num_dims);
+  for (i = 0; i < 3; i++) p[n++] = &(grid->grid_dims[i]);
+  for (i = 0; i < 3; i++) p[n++] = &(grid->grid_dims_ghostbox[i]);
+  p[n++] = &(grid->num_gridpts);
+
+  p[n++] = &(grid->ilo_gb); p[n++] = &(grid->ihi_gb);
+  p[n++] = &(grid->jlo_gb); p[n++] = &(grid->jhi_gb);
+  p[n++] = &(grid->klo_gb); p[n++] = &(grid->khi_gb);
+  p[n++] = &(grid->ilo_fb); p[n++] = &(grid->ihi_fb);
+  p[n++] = &(grid->jlo_fb); p[n++] = &(grid->jhi_fb);
+  p[n++] = &(grid->klo_fb); p[n++] = &(grid->khi_fb);
+  p[n++] = &(grid->ilo_D1_fb); p[n++] = &(grid->ihi_D1_fb);
+  p[n++] = &(grid->jlo_D1_fb); p[n++] = &(grid->jhi_D1_fb);
+  p[n++] = &(grid->klo_D1_fb); p[n++] = &(grid->khi_D1_fb);
+  p[n++] = &(grid->ilo_D2_fb); p[n++] = &(grid->ihi_D2_fb);
+  p[n++] = &(grid->jlo_D2_fb); p[n++] = &(grid->jhi_D2_fb);
+  p[n++] = &(grid->klo_D2_fb); p[n++] = &(grid->khi_D2_fb);
+  p[n++] = &(grid->ilo_D3_fb); p[n++] = &(grid->ihi_D3_fb);
+  p[n++] = &(grid->jlo_D3_fb); p[n++] = &(grid->jhi_D3_fb);
+  p[n++] = &(grid->klo_D3_fb); p[n++] = &(grid->khi_D3_fb);
+
+  p[n++] = &(grid->num_nb_levels);
+  for (i = 0; i < 3; i++) p[n++] = &(grid->block_dims[i]);
+}
+
+/* getGridMarkFields() collects pointers to the narrow band marks */
+static void getGridMarkFields(Grid *grid, unsigned char **p)
+{
+  p[0] = &(grid->mark_gb);
+  p[1] = &(grid->mark_D1);
+  p[2] = &(grid->mark_D2);
+  p[3] = &(grid->mark_D3);
+  p[4] = &(grid->mark_fb);
+}
+
+/* getGridRealFields() collects pointers to the real Grid parameters */
+static void getGridRealFields(Grid *grid, LSMLIB_REAL **p)
+{
+  int n = 0, i;
+
+  for (i = 0; i < 3; i++) p[n++] = &(grid->x_lo[i]);
+  for (i = 0; i < 3; i++) p[n++] = &(grid->x_hi[i]);
+  for (i = 0; i < 3; i++) p[n++] = &(grid->x_lo_ghostbox[i]);
+  for (i = 0; i < 3; i++) p[n++] = &(grid->x_hi_ghostbox[i]);
+  for (i = 0; i < 3; i++) p[n++] = &(grid->dx[i]);
+  p[n++] = &(grid->beta);
+  p[n++] = &(grid->gamma);
+}
+
+static void swapBytes(void *data, size_t size, size_t num_items)
+{
+  unsigned char *c = (unsigned char *)data, tmp;
+  size_t i, j;
+
+  for (i = 0; i < num_items; i++, c += size)
+    for (j = 0; j < size/2; j++)
+    {
+      tmp = c[j]; c[j] = c[size-1-j]; c[size-1-j] = tmp;
+    }
+}
+
+static void swapHeader(LSM_ContainerHeader *header)
+{
+  swapBytes(&(header->byte_order), 4, 1);
+  swapBytes(&(header->version), 4, 1);
+  swapBytes(&(header->alignment), 4, 1);
+  swapBytes(&(header->num_fields), 4, 1);
+  swapBytes(&(header->grid_offset), 8, 1);
+  swapBytes(&(header->directory_offset), 8, 1);
+}
+
+static void swapEntry(LSM_ContainerEntry *entry)
+{
+  swapBytes(&(entry->storage_type), 4, 1);
+  swapBytes(&(entry->num_elements), 8, 1);
+  swapBytes(&(entry->offset), 8, 1);
+}
+
+/* padFile() writes zeros until the file position is a multiple */
+/* of the field alignment and returns the new file position     */
+static off_t padFile(LSM_Container *container)
+{
+  static const char zeros[LSM_CONTAINER_ALIGNMENT] = {0};
+  off_t pos = ftello(container->fp);
+  size_t pad;
+
+  if (pos < 0)
+  {
+    container->error = 1;
+    return 0;
+  }
+  pad = (size_t)((LSM_CONTAINER_ALIGNMENT
+                  - pos%LSM_CONTAINER_ALIGNMENT)%LSM_CONTAINER_ALIGNMENT);
+  if (pad > 0 && fwrite(zeros, 1, pad, container->fp) != pad)
+    container->error = 1;
+  return pos + (off_t)pad;
+}
+
+/* convertField() converts num_elements values stored in src using */
+/* storage_type (byte-swapping them if needed) to LSMLIB_REAL      */
+static void convertField(LSMLIB_REAL *dst, const void *src,
+                         size_t num_elements, int storage_type, int swap)
+{
+  const unsigned char *s = (const unsigned char *)src;
+  unsigned char bytes[8];
+  float  f;
+  double d;
+  size_t i;
+
+  /* values are copied through a byte buffer so that byte-swapped */
+  /* data is never loaded as a floating-point number              */
+  for (i = 0; i < num_elements; i++, s += storage_type)
+  {
+    memcpy(bytes, s, (size_t)storage_type);
+    if (swap) swapBytes(bytes, (size_t)storage_type, 1);
+    if (storage_type == LSM_CONTAINER_FLOAT32)
+    {
+      memcpy(&f, bytes, sizeof(float));
+      dst[i] = (LSMLIB_REAL)f;
+    }
+    else
+    {
+      memcpy(&d, bytes, sizeof(double));
+      dst[i] = (LSMLIB_REAL)d;
+    }
+  }
+}
+
+static LSM_ContainerEntry *findEntry(LSM_Container *container,
+                                     char *field_name, int *field)
+{
+  int i;
+
+  for (i = 0; i < (int)container->header.num_fields; i++)
+    if (strncmp(container->entries[i].name, field_name,
+                LSM_CONTAINER_MAX_NAME_LENGTH) == 0)
+    {
+      if (field) *field = i;
+      return &(container->entries[i]);
+    }
+  return NULL;
+}
+
+static void destroyContainer(LSM_Container *container)
+{
+  int i;
+
+  if (container->data)
+  {
+    for (i = 0; i < (int)container->header.num_fields; i++)
+    {
+      /* arrays pointing into the mapping are not owned */
+      char *d = (char *)container->data[i];
+      if ( d && !(container->map && d >= (char *)container->map
+                  && d < (char *)container->map + container->map_size) )
+        free(container->data[i]);
+    }
+  }
+#ifdef LSMLIB_HAVE_MMAP
+  if (container->map) munmap(container->map, container->map_size);
+#endif
+  if (container->fp) fclose(container->fp);
+  free(container->entries);
+  free(container->data);
+  free(container);
+}
+
+
+/*============ Writing ==============*/
+
+LSM_Container *createLSMContainer(char *file_name, Grid *grid)
+{
+  LSM_Container *container;
+  int *int_fields[LSM_CONTAINER_GRID_NUM_INTS];
+  unsigned char *mark_fields[LSM_CONTAINER_GRID_NUM_MARKS];
+  LSMLIB_REAL *real_fields[LSM_CONTAINER_GRID_NUM_REALS];
+  int i;
+
+  container = (LSM_Container *)calloc(1, sizeof(LSM_Container));
+  container->writing = 1;
+  container->fp = fopen(file_name, "wb");
+  if (container->fp == NULL)
+  {
+    free(container);
+    return NULL;
+  }
+
+  memcpy(container->header.magic, LSM_CONTAINER_MAGIC, 8);
+  container->header.byte_order = LSM_CONTAINER_BYTE_ORDER;
+  container->header.version = LSM_CONTAINER_VERSION;
+  container->header.alignment = LSM_CONTAINER_ALIGNMENT;
+  container->header.grid_offset = sizeof(LSM_ContainerHeader);
+
+  /* pack Grid */
+  getGridIntFields(grid, int_fields);
+  getGridMarkFields(grid, mark_fields);
+  getGridRealFields(grid, real_fields);
+  container->grid.num_ints = LSM_CONTAINER_GRID_NUM_INTS
+                           + LSM_CONTAINER_GRID_NUM_MARKS;
+  container->grid.num_reals = LSM_CONTAINER_GRID_NUM_REALS;
+  for (i = 0; i < LSM_CONTAINER_GRID_NUM_INTS; i++)
+    container->grid.ints[i] = (LSM_Int32)(*int_fields[i]);
+  for (i = 0; i < LSM_CONTAINER_GRID_NUM_MARKS; i++)
+    container->grid.ints[LSM_CONTAINER_GRID_NUM_INTS+i] = *mark_fields[i];
+  for (i = 0; i < LSM_CONTAINER_GRID_NUM_REALS; i++)
+    container->grid.reals[i] = (double)(*real_fields[i]);
+
+  /* header is rewritten by closeLSMContainer() */
+  if ( fwrite(&(container->header), sizeof(LSM_ContainerHeader), 1,
+              container->fp) != 1 ||
+       fwrite(&(container->grid), sizeof(LSM_ContainerGrid), 1,
+              container->fp) != 1 )
+    container->error = 1;
+
+  return container;
+}
+
+
+int writeLSMContainerField(LSM_Container *container, char *field_name,
+                           LSMLIB_REAL *data, int num_elements,
+                           int storage_type)
+{
+  LSM_ContainerEntry *entry;
+  size_t n, chunk, count;
+  int num_fields;
+
+  if ( (container == NULL) || !container->writing ) return 1;
+  if ( strlen(field_name) >= LSM_CONTAINER_MAX_NAME_LENGTH )
+  {
+    printf("\nField name %s is too long\n",field_name);
+    return 1;
+  }
+  if ( findEntry(container, field_name, NULL) != NULL )
+  {
+    printf("\nField %s already exists in container\n",field_name);
+    return 1;
+  }
+  if ( (storage_type != LSM_CONTAINER_FLOAT32) &&
+       (storage_type != LSM_CONTAINER_FLOAT64) )
+  {
+    printf("\nInvalid storage type %d for field %s\n",
+           storage_type,field_name);
+    return 1;
+  }
+
+  /* add entry to the directory */
+  num_fields = (int)container->header.num_fields;
+  if (num_fields == container->num_alloc_entries)
+  {
+    container->num_alloc_entries = 2*container->num_alloc_entries + 8;
+    container->entries = (LSM_ContainerEntry *)realloc(container->entries,
+      container->num_alloc_entries*sizeof(LSM_ContainerEntry));
+  }
+  entry = &(container->entries[num_fields]);
+  memset(entry, 0, sizeof(LSM_ContainerEntry));
+  strcpy(entry->name, field_name);
+  entry->storage_type = (LSM_UInt32)storage_type;
+  entry->num_elements = (LSM_UInt64)num_elements;
+  entry->offset = (LSM_UInt64)padFile(container);
+  container->header.num_fields++;
+
+  /* write data, converting to the storage type if necessary */
+  if ((size_t)storage_type == sizeof(LSMLIB_REAL))
+  {
+    if ( fwrite(data, sizeof(LSMLIB_REAL), (size_t)num_elements,
+                container->fp) != (size_t)num_elements )
+      container->error = 1;
+  }
+  else
+  {
+    void *buffer = malloc(LSM_CONTAINER_CHUNK_SIZE*(size_t)storage_type);
+    for (n = 0; n < (size_t)num_elements; n += chunk)
+    {
+      chunk = (size_t)num_elements - n;
+      if (chunk > LSM_CONTAINER_CHUNK_SIZE) chunk = LSM_CONTAINER_CHUNK_SIZE;
+      if (storage_type == LSM_CONTAINER_FLOAT32)
+        for (count = 0; count < chunk; count++)
+          ((float *)buffer)[count] = (float)data[n+count];
+      else
+        for (count = 0; count < chunk; count++)
+          ((double *)buffer)[count] = (double)data[n+count];
+      if (fwrite(buffer, (size_t)storage_type, chunk, container->fp) != chunk)
+      {
+        container->error = 1;
+        break;
+      }
+    }
+    free(buffer);
+  }
+
+  return container->error;
+}
+
+
+/*============ Reading ==============*/
+
+LSM_Container *openLSMContainer(char *file_name)
+{
+  LSM_Container *container;
+  LSM_ContainerHeader *header;
+  LSM_ContainerEntry *entry;
+  off_t file_size;
+  int i, n;
+
+  container = (LSM_Container *)calloc(1, sizeof(LSM_Container));
+  container->fp = fopen(file_name, "rb");
+  if (container->fp == NULL)
+  {
+    free(container);
+    return NULL;
+  }
+  header = &(container->header);
+
+  if ( fseeko(container->fp, 0, SEEK_END) != 0 ||
+       (file_size = ftello(container->fp)) < 0 ||
+       fseeko(container->fp, 0, SEEK_SET) != 0 ||
+       fread(header, sizeof(LSM_ContainerHeader), 1, container->fp) != 1 ||
+       memcmp(header->magic, LSM_CONTAINER_MAGIC, 8) != 0 )
+  {
+    printf("\n%s is not an LSMLIB container file\n",file_name);
+    destroyContainer(container);
+    return NULL;
+  }
+
+  if (header->byte_order != LSM_CONTAINER_BYTE_ORDER)
+  {
+    swapHeader(header);
+    container->swap = 1;
+  }
+  if ( (header->byte_order != LSM_CONTAINER_BYTE_ORDER) ||
+       (header->version > LSM_CONTAINER_VERSION) ||
+       (header->directory_offset
+          + header->num_fields*sizeof(LSM_ContainerEntry)
+          > (LSM_UInt64)file_size) )
+  {
+    printf("\nUnsupported or incomplete container file %s\n",file_name);
+    header->num_fields = 0;
+    destroyContainer(container);
+    return NULL;
+  }
+
+  /* read Grid section */
+  if ( fseeko(container->fp, (off_t)header->grid_offset, SEEK_SET) != 0 ||
+       fread(&(container->grid), sizeof(LSM_ContainerGrid), 1,
+             container->fp) != 1 )
+    container->error = 1;
+  if (container->swap)
+  {
+    swapBytes(&(container->grid.num_ints), 4, 1);
+    swapBytes(&(container->grid.num_reals), 4, 1);
+    swapBytes(container->grid.ints, 4, LSM_CONTAINER_GRID_NUM_INTS
+                                      + LSM_CONTAINER_GRID_NUM_MARKS + 1);
+    swapBytes(container->grid.reals, 8, LSM_CONTAINER_GRID_NUM_REALS);
+  }
+
+  /* read field directory */
+  n = (int)header->num_fields;
+  container->num_alloc_entries = n;
+  container->entries = (LSM_ContainerEntry *)calloc(n > 0 ? n : 1,
+                                                    sizeof(LSM_ContainerEntry));
+  container->data = (LSMLIB_REAL **)calloc(n > 0 ? n : 1,
+                                           sizeof(LSMLIB_REAL *));
+  if ( n > 0 &&
+       ( fseeko(container->fp, (off_t)header->directory_offset,
+                SEEK_SET) != 0 ||
+         fread(container->entries, sizeof(LSM_ContainerEntry), (size_t)n,
+               container->fp) != (size_t)n ) )
+    container->error = 1;
+  for (i = 0; i < n; i++)
+  {
+    entry = &(container->entries[i]);
+    if (container->swap) swapEntry(entry);
+    entry->name[LSM_CONTAINER_MAX_NAME_LENGTH-1] = '\0';
+    if ( ((entry->storage_type != LSM_CONTAINER_FLOAT32) &&
+          (entry->storage_type != LSM_CONTAINER_FLOAT64)) ||
+         (entry->offset + entry->num_elements*entry->storage_type
+            > (LSM_UInt64)file_size) )
+      container->error = 1;
+  }
+  if (container->error)
+  {
+    printf("\nCorrupt container file %s\n",file_name);
+    destroyContainer(container);
+    return NULL;
+  }
+
+#ifdef LSMLIB_HAVE_MMAP
+  /* map the file; the data is only read from disk when it is touched */
+  {
+    void *map = mmap(NULL, (size_t)file_size, PROT_READ|PROT_WRITE,
+                     MAP_PRIVATE, fileno(container->fp), 0);
+    if (map != MAP_FAILED)
+    {
+      container->map = map;
+      container->map_size = (size_t)file_size;
+    }
+  }
+#endif
+
+  return container;
+}
+
+
+Grid *readGridFromLSMContainer(LSM_Container *container)
+{
+  Grid *grid;
+  int *int_fields[LSM_CONTAINER_GRID_NUM_INTS];
+  unsigned char *mark_fields[LSM_CONTAINER_GRID_NUM_MARKS];
+  LSMLIB_REAL *real_fields[LSM_CONTAINER_GRID_NUM_REALS];
+  int i;
+
+  grid = (Grid *)calloc(1, sizeof(Grid));
+  getGridIntFields(grid, int_fields);
+  getGridMarkFields(grid, mark_fields);
+  getGridRealFields(grid, real_fields);
+
+  for (i = 0; i < LSM_CONTAINER_GRID_NUM_INTS; i++)
+    *int_fields[i] = (int)container->grid.ints[i];
+  for (i = 0; i < LSM_CONTAINER_GRID_NUM_MARKS; i++)
+    *mark_fields[i] =
+      (unsigned char)container->grid.ints[LSM_CONTAINER_GRID_NUM_INTS+i];
+  for (i = 0; i < LSM_CONTAINER_GRID_NUM_REALS; i++)
+    *real_fields[i] = (LSMLIB_REAL)container->grid.reals[i];
+
+  return grid;
+}
+
+
+int getLSMContainerNumFields(LSM_Container *container)
+{
+  return (int)container->header.num_fields;
+}
+
+
+char *getLSMContainerFieldName(LSM_Container *container, int field)
+{
+  if ( (field < 0) || (field >= (int)container->header.num_fields) )
+    return NULL;
+  return container->entries[field].name;
+}
+
+
+LSMLIB_REAL *getLSMContainerField(LSM_Container *container,
+                                  char *field_name, int *num_elements)
+{
+  LSM_ContainerEntry *entry;
+  LSMLIB_REAL *data;
+  size_t n, chunk, size;
+  int field;
+
+  if ( (container == NULL) || container->writing ) return NULL;
+  entry = findEntry(container, field_name, &field);
+  if (entry == NULL) return NULL;
+
+  *num_elements = (int)entry->num_elements;
+  if (container->data[field]) return container->data[field];
+
+  size = (size_t)entry->storage_type;
+  if (container->map)
+  {
+    char *src = (char *)container->map + entry->offset;
+    if ( (size == sizeof(LSMLIB_REAL)) && !container->swap )
+    {
+      /* zero-copy */
+      data = (LSMLIB_REAL *)src;
+    }
+    else
+    {
+      data = (LSMLIB_REAL *)malloc(entry->num_elements*sizeof(LSMLIB_REAL));
+      convertField(data, src, (size_t)entry->num_elements,
+                   (int)size, container->swap);
+    }
+  }
+  else
+  {
+    /* no mmap(): read (and convert) the field in chunks */
+    void *buffer = NULL;
+    data = (LSMLIB_REAL *)malloc(entry->num_elements*sizeof(LSMLIB_REAL));
+    if (size != sizeof(LSMLIB_REAL) || container->swap)
+      buffer = malloc(LSM_CONTAINER_CHUNK_SIZE*size);
+    if (fseeko(container->fp, (off_t)entry->offset, SEEK_SET) != 0)
+      container->error = 1;
+    for (n = 0; n < entry->num_elements && !container->error; n += chunk)
+    {
+      chunk = (size_t)entry->num_elements - n;
+      if (chunk > LSM_CONTAINER_CHUNK_SIZE) chunk = LSM_CONTAINER_CHUNK_SIZE;
+      if (buffer)
+      {
+        if (fread(buffer, size, chunk, container->fp) != chunk)
+          container->error = 1;
+        else
+          convertField(&(data[n]), buffer, chunk, (int)size,
+                       container->swap);
+      }
+      else if (fread(&(data[n]), size, chunk, container->fp) != chunk)
+        container->error = 1;
+    }
+    free(buffer);
+    if (container->error)
+    {
+      free(data);
+      return NULL;
+    }
+  }
+
+  container->data[field] = data;
+  return data;
+}
+
+
+int closeLSMContainer(LSM_Container *container)
+{
+  int error;
+
+  if (container == NULL) return 1;
+
+  if (container->writing)
+  {
+    /* write field directory and final header */
+    size_t n = container->header.num_fields;
+    container->header.directory_offset = (LSM_UInt64)padFile(container);
+    if ( (n > 0 && fwrite(container->entries, sizeof(LSM_ContainerEntry),
+                          n, container->fp) != n) ||
+         fseeko(container->fp, 0, SEEK_SET) != 0 ||
+         fwrite(&(container->header), sizeof(LSM_ContainerHeader), 1,
+                container->fp) != 1 )
+      container->error = 1;
+    if (fclose(container->fp) != 0) container->error = 1;
+    container->fp = NULL;
+    /* data arrays are not owned when writing */
+    container->header.num_fields = 0;
+  }
+
+  error = container->error;
+  destroyContainer(container);
+  return error;
+}
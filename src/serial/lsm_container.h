@@ -0,0 +1,254 @@
+/*
+ * File:        lsm_container.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for LSM_Container: a self-describing binary
+ *              file holding a Grid and named data arrays
+ */
+
+#ifndef included_lsm_container_h
+#define included_lsm_container_h
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_container.h
+ *
+ * \brief
+ * @ref lsm_container.h provides support for storing a Grid and any
+ * number of named data arrays (fields) in a single, self-describing
+ * binary file that can be memory-mapped when it is read.
+ *
+ * <h3> File layout </h3>
+ * -# 64-byte header: magic string "LSMLIBCF", byte order mark, format
+ *    version, field alignment, number of fields, offsets of the Grid
+ *    section and of the field directory
+ * -# Grid section: all Grid parameters stored as 32-bit integers and
+ *    64-bit floating-point numbers (independent of LSMLIB_REAL)
+ * -# field data: each field starts at a multiple of the field alignment
+ *    (LSM_CONTAINER_ALIGNMENT bytes, i.e. a page) and is stored as
+ *    either 32-bit or 64-bit floating-point numbers
+ * -# field directory: name, storage type, number of elements and
+ *    offset of each field
+ *
+ * All values are written in the byte order of the machine that wrote
+ * the file; files written on a machine with the opposite byte order
+ * are detected from the byte order mark and converted when read.
+ *
+ * <h3> Zero-copy reads </h3>
+ * When LSMLIB is configured on a system that provides mmap(),
+ * openLSMContainer() maps the file into memory and only reads the header
+ * and the field directory.  getLSMContainerField() returns a pointer
+ * directly into the mapping when the field is stored with the precision
+ * of LSMLIB_REAL and in the native byte order, so the data is paged in
+ * from disk as it is first touched rather than when the file is opened.
+ * Other fields (e.g. 32-bit fields read into a double precision build)
+ * are converted into a newly allocated array on first access.
+ *
+ * The mapping is private (copy-on-write): arrays returned by
+ * getLSMContainerField() may be modified, e.g. used directly as the
+ * level set function of a restarted calculation, but the changes are
+ * never written back to the file.
+ *
+ * <h3> NOTES: </h3>
+ * - Container files are never compressed.  Compression would prevent
+ *   the file from being memory-mapped.
+ *
+ * - Arrays returned by getLSMContainerField() are owned by the
+ *   LSM_Container.  They must NOT be freed by the user and must not
+ *   be used after closeLSMContainer() is called.
+ *
+ */
+
+#include "lsm_grid.h"
+
+/* storage types for fields in a container file */
+#define LSM_CONTAINER_FLOAT32  4
+#define LSM_CONTAINER_FLOAT64  8
+#ifdef LSMLIB_DOUBLE_PRECISION
+#define LSM_CONTAINER_REAL     LSM_CONTAINER_FLOAT64
+#else
+#define LSM_CONTAINER_REAL     LSM_CONTAINER_FLOAT32
+#endif
+
+/* alignment (in bytes) of the field data within a container file */
+#define LSM_CONTAINER_ALIGNMENT         4096
+
+/* maximum length of a field name (including the terminating '\0') */
+#define LSM_CONTAINER_MAX_NAME_LENGTH   64
+
+/*!
+ * LSM_Container is an opaque handle for a container file opened for
+ * writing by createLSMContainer() or for reading by openLSMContainer().
+ */
+typedef struct _LSM_Container LSM_Container;
+
+
+/*!
+ * createLSMContainer() creates a new container file and writes the
+ * specified Grid to it.  Fields are added using writeLSMContainerField().
+ *
+ * Arguments:
+ *  - file_name (in):  name of output file
+ *  - grid (in):       pointer to Grid
+ *
+ * Return value:       pointer to LSM_Container (NULL if the file could
+ *                     not be opened)
+ *
+ * NOTES:
+ * - The file is not complete (and cannot be read) until
+ *   closeLSMContainer() has been called.
+ *
+ * - If a file with the specified file_name already exists, it is
+ *   overwritten.
+ *
+ */
+LSM_Container *createLSMContainer(char *file_name, Grid *grid);
+
+
+/*!
+ * writeLSMContainerField() appends a named data array to a container
+ * file opened by createLSMContainer().
+ *
+ * Arguments:
+ *  - container (in):     pointer to LSM_Container
+ *  - field_name (in):    name of field (at most
+ *                        LSM_CONTAINER_MAX_NAME_LENGTH-1 characters)
+ *  - data (in):          data array to be output to file
+ *  - num_elements (in):  number of elements in the array (typically
+ *                        grid->num_gridpts)
+ *  - storage_type (in):  precision of the data in the file
+ *                        (LSM_CONTAINER_FLOAT32, LSM_CONTAINER_FLOAT64 or
+ *                        LSM_CONTAINER_REAL for the precision of
+ *                        LSMLIB_REAL)
+ *
+ * Return value:          0 on success; 1 otherwise
+ *
+ * NOTES:
+ * - Storing a field as LSM_CONTAINER_FLOAT32 halves its size in a double
+ *   precision build, but the field can then no longer be read without
+ *   making a (converted) copy.
+ *
+ * - Field names must be unique within a container.
+ *
+ */
+int writeLSMContainerField(LSM_Container *container, char *field_name,
+                           LSMLIB_REAL *data, int num_elements,
+                           int storage_type);
+
+
+/*!
+ * openLSMContainer() opens a container file for reading.  Only the
+ * header, the Grid and the field directory are read; the field data
+ * is accessed on demand by getLSMContainerField().
+ *
+ * Arguments:
+ *  - file_name (in):  name of input file
+ *
+ * Return value:       pointer to LSM_Container (NULL if the file could
+ *                     not be opened or is not a valid container file)
+ *
+ */
+LSM_Container *openLSMContainer(char *file_name);
+
+
+/*!
+ * readGridFromLSMContainer() allocates memory for a new Grid structure
+ * and loads the Grid configuration stored in the container.
+ *
+ * Arguments:
+ *  - container (in):  pointer to LSM_Container opened by
+ *                     openLSMContainer()
+ *
+ * Return value:       pointer to newly constructed Grid structure
+ *
+ * NOTES:
+ * - To avoid memory leaks, the grid returned by
+ *   readGridFromLSMContainer() should be destroyed using destroyGrid()
+ *   when it is no longer needed.
+ *
+ */
+Grid *readGridFromLSMContainer(LSM_Container *container);
+
+
+/*!
+ * getLSMContainerNumFields() returns the number of fields stored in the
+ * container.
+ *
+ * Arguments:
+ *  - container (in):  pointer to LSM_Container
+ *
+ * Return value:       number of fields
+ *
+ */
+int getLSMContainerNumFields(LSM_Container *container);
+
+
+/*!
+ * getLSMContainerFieldName() returns the name of the specified field.
+ *
+ * Arguments:
+ *  - container (in):  pointer to LSM_Container
+ *  - field (in):      index of the field (0 <= field < number of fields)
+ *
+ * Return value:       name of field (NULL if field is out of range)
+ *
+ */
+char *getLSMContainerFieldName(LSM_Container *container, int field);
+
+
+/*!
+ * getLSMContainerField() returns the data array stored in the container
+ * under the specified name.
+ *
+ * Arguments:
+ *  - container (in):      pointer to LSM_Container opened by
+ *                         openLSMContainer()
+ *  - field_name (in):     name of field
+ *  - num_elements (out):  number of elements in the array
+ *
+ * Return value:           pointer to data array (NULL if the container
+ *                         does not contain a field with the specified
+ *                         name)
+ *
+ * NOTES:
+ * - The returned array is owned by the container and remains valid
+ *   until closeLSMContainer() is called.  It may be modified; the
+ *   changes are not written to the file.
+ *
+ * - Calling getLSMContainerField() more than once for the same field
+ *   returns the same array.
+ *
+ */
+LSMLIB_REAL *getLSMContainerField(LSM_Container *container,
+                                  char *field_name, int *num_elements);
+
+
+/*!
+ * closeLSMContainer() closes the container file and frees all memory
+ * associated with the container (including arrays returned by
+ * getLSMContainerField()).  For a container created by
+ * createLSMContainer(), the field directory and the header are written
+ * before the file is closed.
+ *
+ * Arguments:
+ *  - container (in):  pointer to LSM_Container
+ *
+ * Return value:       0 on success; 1 if an I/O error occurred
+ *
+ */
+int closeLSMContainer(LSM_Container *container);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
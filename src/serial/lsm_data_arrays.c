@@ -95,14 +95,91 @@ LSM_DataArrays *allocateLSMDataArrays(void)
   lsm_data_arrays->solid_normal_y = LSMLIB_SERIAL_dummy_pointer;
   lsm_data_arrays->solid_normal_z = LSMLIB_SERIAL_dummy_pointer;
   
-  lsm_data_arrays->D1 = LSMLIB_SERIAL_dummy_pointer;
-  lsm_data_arrays->D2 = LSMLIB_SERIAL_dummy_pointer;
-  lsm_data_arrays->D3 = LSMLIB_SERIAL_dummy_pointer;
+  lsm_data_arrays->tile_size = 0;
+  lsm_data_arrays->tiled_band = (LSM_TiledBand *)NULL;
+  lsm_data_arrays->tiled_mask = (LSM_TiledBand *)NULL;
+  lsm_data_arrays->tile_arrays = (LSM_DataArrays *)NULL;
   
   return  lsm_data_arrays;
 }
 
 
+/* 
+ * allocateTiledLSMDataArrays() sets up the tiled storage (see
+ * allocateMemoryForLSMDataArrays()).
+ */
+static void allocateTiledLSMDataArrays(
+  LSM_DataArrays *lsm_data_arrays,
+  Grid *grid)
+{
+  LSM_DataArrays *d = lsm_data_arrays;
+  LSM_DataArrays *td;
+  LSMLIB_REAL    **fields[LSM_NUM_TILED_FIELDS];
+  Grid           tile_alloc_grid;
+  int            f;
+  
+  d->tiled_band = createTiledBand(grid,d->tile_size,LSM_NUM_TILED_FIELDS);
+  if( d->tiled_band != NULL )
+  {
+    if( d->mask != NULL )
+    {
+      d->tiled_mask = createTiledBand(grid,d->tile_size,1);
+      setTiledBandActivateNeighbors(d->tiled_mask,0);
+    }
+    
+    /* scratch arrays: same arrays as d, allocated over a tile ghostbox */
+    td = allocateLSMDataArrays();
+    *td = *d;
+    td->tiled_band = td->tiled_mask = (LSM_TiledBand *)NULL;
+    td->tile_size = 0;
+    td->phi = (d->phi) ? LSMLIB_SERIAL_dummy_pointer : (LSMLIB_REAL *)NULL;
+    td->mask = (LSMLIB_REAL *)NULL;
+    
+    /* only the number of grid points is used for the allocation */
+    tile_alloc_grid = *grid;
+    tile_alloc_grid.num_gridpts = d->tiled_band->tile_box_size;
+    allocateMemoryForLSMDataArrays(td,&tile_alloc_grid);
+    d->tile_arrays = td;
+    
+    fields[LSM_TILED_PHI] = &(d->phi);
+    fields[LSM_TILED_PHI_STAGE1] = &(d->phi_stage1);
+    fields[LSM_TILED_PHI_STAGE2] = &(d->phi_stage2);
+    fields[LSM_TILED_PHI_NEXT] = &(d->phi_next);
+    fields[LSM_TILED_PHI0] = &(d->phi0);
+    fields[LSM_TILED_PHI_PREV] = &(d->phi_prev);
+    fields[LSM_TILED_PHI_EXTRA] = &(d->phi_extra);
+    fields[LSM_TILED_LSE_RHS] = &(d->lse_rhs);
+    for(f = 0; f < LSM_NUM_TILED_FIELDS; f++)
+    {
+      if( *(fields[f]) == NULL ) disableTiledBandField(d->tiled_band,f);
+    }
+  }
+  
+  /* no full-grid arrays except for the user's phi and mask */
+  if( d->phi == LSMLIB_SERIAL_dummy_pointer ) d->phi = (LSMLIB_REAL *)NULL;
+  if( d->mask == LSMLIB_SERIAL_dummy_pointer ) d->mask = (LSMLIB_REAL *)NULL;
+  d->phi_stage1 = d->phi_stage2 = d->phi_next = (LSMLIB_REAL *)NULL;
+  d->phi0 = d->phi_prev = d->phi_extra = (LSMLIB_REAL *)NULL;
+  d->lse_rhs = (LSMLIB_REAL *)NULL;
+  d->phi_x_plus = d->phi_x_minus = d->phi_x = (LSMLIB_REAL *)NULL;
+  d->phi_y_plus = d->phi_y_minus = d->phi_y = (LSMLIB_REAL *)NULL;
+  d->phi_z_plus = d->phi_z_minus = d->phi_z = (LSMLIB_REAL *)NULL;
+  d->phi_xx = d->phi_yy = d->phi_xy = (LSMLIB_REAL *)NULL;
+  d->phi_zz = d->phi_xz = d->phi_yz = (LSMLIB_REAL *)NULL;
+  d->normal_velocity = (LSMLIB_REAL *)NULL;
+  d->external_velocity_x = d->external_velocity_y = (LSMLIB_REAL *)NULL;
+  d->external_velocity_z = (LSMLIB_REAL *)NULL;
+  d->narrow_band = (unsigned char *)NULL;
+  d->index_x = d->index_y = d->index_z = (int *)NULL;
+  d->index_outer_pts = (int *)NULL;
+  d->num_alloc_index_outer_pts = 0;
+  d->solid_narrow_band = (unsigned char *)NULL;
+  d->solid_index_x = d->solid_index_y = d->solid_index_z = (int *)NULL;
+  d->solid_normal_x = d->solid_normal_y = (LSMLIB_REAL *)NULL;
+  d->solid_normal_z = (LSMLIB_REAL *)NULL;
+}
+
+
 void destroyLSMDataArrays(LSM_DataArrays *lsm_data_arrays)
 {
   if (lsm_data_arrays) {
@@ -121,6 +198,12 @@ void  allocateMemoryForLSMDataArrays(
   *   Non-NULL pointers different from LSMLIB_SERIAL_dummy_pointer are assumed allocated
   *   elsewhere and that will not be overridden.
   */
+  
+  if( lsm_data_arrays->tile_size > 0 )
+  {
+    allocateTiledLSMDataArrays(lsm_data_arrays,grid);
+    return;
+  }
         
   if( lsm_data_arrays->phi == LSMLIB_SERIAL_dummy_pointer )
     lsm_data_arrays->phi = (LSMLIB_REAL*) calloc(grid->num_gridpts,DSZ);
@@ -231,15 +314,6 @@ void  allocateMemoryForLSMDataArrays(
   }
   else lsm_data_arrays->external_velocity_z = (LSMLIB_REAL *)NULL;
   
-  if (lsm_data_arrays->D1 == LSMLIB_SERIAL_dummy_pointer )
-    lsm_data_arrays->D1 = (LSMLIB_REAL*) malloc(grid->num_gridpts*DSZ);
-  
-  if (lsm_data_arrays->D2 == LSMLIB_SERIAL_dummy_pointer )  
-    lsm_data_arrays->D2 = (LSMLIB_REAL*) malloc(grid->num_gridpts*DSZ);
-   
-  if (lsm_data_arrays->D3 == LSMLIB_SERIAL_dummy_pointer )
-    lsm_data_arrays->D3 = (LSMLIB_REAL*) malloc(grid->num_gridpts*DSZ);
-        
   if( lsm_data_arrays->narrow_band == LSMLIB_SERIAL_dummy_pointer_uchar )  
     lsm_data_arrays->narrow_band = (unsigned char*) malloc(grid->num_gridpts*UCSZ);
     
@@ -354,26 +428,33 @@ void  freeMemoryForLSMDataArrays(LSM_DataArrays *lsm_data_arrays)
   free(lsm_data_arrays->solid_normal_y);
   free(lsm_data_arrays->solid_normal_z);
   
-  free(lsm_data_arrays->D1);
-  free(lsm_data_arrays->D2);
-  free(lsm_data_arrays->D3);  
+  destroyTiledBand(lsm_data_arrays->tiled_band);
+  destroyTiledBand(lsm_data_arrays->tiled_mask);
+  destroyLSMDataArrays(lsm_data_arrays->tile_arrays);
+  lsm_data_arrays->tiled_band = lsm_data_arrays->tiled_mask = 
+    (LSM_TiledBand *)NULL;
+  lsm_data_arrays->tile_arrays = (LSM_DataArrays *)NULL;
 }
    
 
 void writeDataArray(LSMLIB_REAL *data, Grid *grid, char *file_name,int zip_status)
 {
-   FILE *fp;
+   LSM_File *fp;
    
-   fp = fopen(file_name,"w");   
+   fp = openLSMFileForWriting(file_name,zip_status);
+   if( fp == NULL )
+   {
+      printf("\nCould not open file %s",file_name);
+      return;
+   }
 
    /* write grid dimensions */
-   fwrite(grid->grid_dims_ghostbox, sizeof(int), 3, fp); 
+   writeLSMFile(grid->grid_dims_ghostbox, sizeof(int), 3, fp); 
 
    /* write data array */
-   fwrite(data, DSZ, grid->num_gridpts, fp);
+   writeLSMFile(data, DSZ, grid->num_gridpts, fp);
 
-   fclose(fp);
-   zipFile(file_name,zip_status);
+   closeLSMFile(fp);
 }
 
 
@@ -383,37 +464,38 @@ void writeDataArrayNoGrid(
      char *file_name,
      int zip_status)
 {
-   FILE *fp;
+   LSM_File *fp;
    
-   fp = fopen(file_name,"w");   
+   fp = openLSMFileForWriting(file_name,zip_status);
+   if( fp == NULL )
+   {
+      printf("\nCould not open file %s",file_name);
+      return;
+   }
 
    /* write grid dimensions */
-   fwrite(n, sizeof(int), 3, fp); 
+   writeLSMFile(n, sizeof(int), 3, fp); 
 
    /* write data array */
-   fwrite(data, sizeof(LSMLIB_REAL), n[0]*n[1]*n[2], fp);
+   writeLSMFile(data, sizeof(LSMLIB_REAL), n[0]*n[1]*n[2], fp);
 
-   fclose(fp);
-   zipFile(file_name,zip_status);
+   closeLSMFile(fp);
 }
 
 
 LSMLIB_REAL *readDataArray(int *grid_dims_ghostbox,char *file_name)
 {
-   FILE    *fp;
-   int     zip_status;
+   LSM_File *fp;
    int     num_gridpts;
    LSMLIB_REAL    *data = NULL;
-   char    *file_base;
-   
-   checkUnzipFile(file_name,&zip_status,&file_base);
    
-   fp = fopen(file_base,"r");
+   /* compressed files are decompressed on the fly while reading */
+   fp = openLSMFileForReading(file_name);
 
    if( fp != NULL)
    {
      /* read grid dimensions */
-     fread(grid_dims_ghostbox, sizeof(int), 3, fp); 
+     readLSMFile(grid_dims_ghostbox, sizeof(int), 3, fp); 
   
      /* allocate memory for data array */ 
      num_gridpts = grid_dims_ghostbox[0] * grid_dims_ghostbox[1]
@@ -421,17 +503,14 @@ LSMLIB_REAL *readDataArray(int *grid_dims_ghostbox,char *file_name)
      data = (LSMLIB_REAL *) malloc(num_gridpts*DSZ);
 
      /* read data array */ 
-     fread(data, DSZ, num_gridpts, fp);
+     readLSMFile(data, DSZ, num_gridpts, fp);
 
-     fclose(fp);
-     
-     zipFile(file_base,zip_status);
+     closeLSMFile(fp);
    }
    else
    {
       printf("\nCould not open file %s",file_name);
    }
-   free(file_base);
    return data;
 }
 
@@ -439,52 +518,51 @@ LSMLIB_REAL *readDataArray(int *grid_dims_ghostbox,char *file_name)
 void writeDataArray1d(LSMLIB_REAL *data, int num_elements, char *file_name,
                       int zip_status)
 {
-   FILE *fp;
+   LSM_File *fp;
    
-   fp = fopen(file_name,"w");
+   fp = openLSMFileForWriting(file_name,zip_status);
+   if( fp == NULL )
+   {
+      printf("\nCould not open file %s",file_name);
+      return;
+   }
 
    /* write number of elements */
-   fwrite(&num_elements, sizeof(int), 1, fp); 
+   writeLSMFile(&num_elements, sizeof(int), 1, fp); 
 
    /* write data array */
-   fwrite(data, DSZ, num_elements, fp);
+   writeLSMFile(data, DSZ, num_elements, fp);
 
-   fclose(fp);
-   zipFile(file_name,zip_status);
+   closeLSMFile(fp);
 }
 
 
 LSMLIB_REAL *readDataArray1d(int *num_elements, char *file_name)
 {
-   FILE    *fp;
-   LSMLIB_REAL  *data;
-   char    *file_base;
-   int     zip_status;
-   
-   checkUnzipFile(file_name,&zip_status,&file_base);
+   LSM_File *fp;
+   LSMLIB_REAL  *data = NULL;
    
-   fp = fopen(file_base,"r");
+   /* compressed files are decompressed on the fly while reading */
+   fp = openLSMFileForReading(file_name);
 
    if(fp)
    {
      /* read number of elements */
-     fread(num_elements, sizeof(int), 1, fp); 
+     readLSMFile(num_elements, sizeof(int), 1, fp); 
    
      /* allocate memory for data*/
      data = (LSMLIB_REAL *)malloc((*num_elements)*DSZ);
 
      /* read data array */
-     fread(data ,DSZ, *num_elements, fp);
+     readLSMFile(data ,DSZ, *num_elements, fp);
 
-     fclose(fp);
-     zipFile(file_base,zip_status);
+     closeLSMFile(fp);
    }
    else
    {
       printf("\nCould not open file %s",file_name);
    }
    
-   free(file_base);
    return data;
 }
 
@@ -25,10 +25,26 @@ extern "C" {
  * @ref lsm_data_arrays.h provides support for managing the data arrays
  * required by typical level set method calculcations.
  *
+ * Localized (narrow band) calculations may store the level set 
+ * functions in tiles instead of full-grid arrays by setting tile_size
+ * before allocateMemoryForLSMDataArrays() is called (see 
+ * lsm_tiled_band.h).
+ *
  */
 
 #include "lsm_grid.h"
 #include "lsm_file.h"
+#include "lsm_tiled_band.h"
+
+/*!
+ * Fields of the LSM_TiledBand used by LSM_DataArrays in tiled mode
+ * (see allocateMemoryForLSMDataArrays()).
+ */
+typedef enum { LSM_TILED_PHI = 0, LSM_TILED_PHI_STAGE1 = 1, 
+               LSM_TILED_PHI_STAGE2 = 2, LSM_TILED_PHI_NEXT = 3,
+               LSM_TILED_PHI0 = 4, LSM_TILED_PHI_PREV = 5,
+               LSM_TILED_PHI_EXTRA = 6, LSM_TILED_LSE_RHS = 7,
+               LSM_NUM_TILED_FIELDS = 8 } LSM_TILED_FIELD;
 
 /*!
  * Structure 'LSM_DataArrays' stores pointers for all arrays needed in a
@@ -59,9 +75,6 @@ typedef struct _LSM_DataArrays
   LSMLIB_REAL  *phi_y_plus, *phi_y_minus, *phi_y;
   LSMLIB_REAL  *phi_z_plus, *phi_z_minus, *phi_z;
   
-  /* scratch space for divided differences */
-  LSMLIB_REAL  *D1, *D2, *D3;
-  
   /* 2nd order derivatives */
   LSMLIB_REAL  *phi_xx, *phi_yy, *phi_xy, *phi_zz, *phi_xz, *phi_yz;
   
@@ -93,12 +106,21 @@ typedef struct _LSM_DataArrays
   
   LSMLIB_REAL *solid_normal_x, *solid_normal_y, *solid_normal_z;
 
+  /* tiled storage (used if tile_size > 0): the level set functions and
+     lse_rhs are fields of tiled_band, mask is stored in tiled_mask and
+     tile_arrays holds scratch arrays covering the ghostbox of a tile */
+  int            tile_size;
+  LSM_TiledBand  *tiled_band;
+  LSM_TiledBand  *tiled_mask;
+  struct _LSM_DataArrays *tile_arrays;
+
 }  LSM_DataArrays;
 
 
 /*!
  * allocateLSMDataArrays() allocates a LSM_DataArrays data structure 
  * and initializes all of its data pointers to a non-NULL dummy pointer.
+ * Tiled storage is off (tile_size = 0).
  *  
  * Arguments:    none
  *
@@ -130,6 +152,23 @@ LSM_DataArrays *allocateLSMDataArrays(void);
  *   If memory has already been allocated for a particular data array or
  *  the data pointer is set to NULL, it will not be reallocated.
  *
+ * - If tile_size > 0, no full-grid arrays are allocated.  Instead:
+ *   - tiled_band is created with one field per LSM_TILED_FIELD; the
+ *     fields whose array pointer is NULL are disabled, so they use no
+ *     memory.  The array pointers of the enabled fields are set to 
+ *     NULL.
+ *   - tiled_mask (a single field; only occupied tiles are activated)
+ *     is created unless mask is NULL.
+ *   - tile_arrays is allocated with scratch arrays of 
+ *     tiled_band->tile_box_size elements for every array pointer other
+ *     than mask that is not NULL (including the fields).  All other 
+ *     array pointers are set to NULL.
+ *   Arrays allocated by the user for phi and mask are kept, so they can
+ *   be used to initialize tiled_band and tiled_mask (see 
+ *   initializeTiledBandFromArray()) and then freed.  All other arrays
+ *   must not be allocated by the user.  If tile_size is too small, 
+ *   tiled_band is NULL on return.
+ *
  */
 void allocateMemoryForLSMDataArrays(
   LSM_DataArrays *lsm_data_arrays,
@@ -138,7 +177,8 @@ void allocateMemoryForLSMDataArrays(
 
 /*!
  * freeMemoryForLSMDataArrays() frees ALL memory allocated for the data 
- * arrays contained within the LSM_DataArrays structure.
+ * arrays contained within the LSM_DataArrays structure (including the
+ * tiled storage).
  *   
  * Arguments:
  *  - lsm_data_arrays(in):  pointer to LSM_DataArrays 
@@ -239,7 +279,8 @@ void writeDataArrayNoGrid(LSMLIB_REAL *data, int *n, char *file_name,
  *   data, the third grid dimension is set to 1.
  *
  * - Function recognizes if the file name contains .gz or .bz2 extention
- *   and uncompresses the file accordingly.
+ *   and decompresses the data as it is read (see openLSMFileForReading());
+ *   the compressed file is left untouched.
  */   
 LSMLIB_REAL *readDataArray(int *grid_dims, char *file_name);
 
@@ -286,7 +327,8 @@ void writeDataArray1d(LSMLIB_REAL *data, int num_gridpts, char *file_name,
  * - The memory for num_elements is assumed to be allocated by the user.
  *
  * - Function recognizes if the file name contains .gz or .bz2 extention
- *   and uncompresses the file accordingly.
+ *   and decompresses the data as it is read (see openLSMFileForReading());
+ *   the compressed file is left untouched.
  */   
 LSMLIB_REAL *readDataArray1d(int *num_elements, char *file_name);
 
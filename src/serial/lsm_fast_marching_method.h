@@ -13,6 +13,7 @@
 
 #include "LSMLIB_config.h"
 #include "FMM_Core.h"
+#include "lsm_fast_sweeping_method.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,17 +41,32 @@ extern "C" {
  *
  * - Error Codes:  0 - successful computation,
  *                 1 - FMM_Data creation error,
- *                 2 - invalid spatial discretization order
+ *                 2 - invalid spatial discretization order,
+ *                 3 - invalid cut-off distance
  *
  * - While @ref lsm_fast_marching_method.h only provides functions 
  *   for 2D and 3D FMM calculations, LSMLIB is capable of supporting higher 
  *   dimensional calculations (currently as high as 8, set by 
- *   FMM_HEAP_MAX_NDIM in @ref FMM_Heap.h).  To use LSMLIB to do 
+ *   FMM_CORE_MAX_NDIM in FMM_Core.c).  To use LSMLIB to do 
  *   higher dimensional fast marching method calculations, just modify 
  *   lsm_FMM_field_extension*d.c and/or lsm_FMM_eikonal*d.c so that
  *   the data array sizes and index calculations are appropriate
  *   for the dimensionality of the problem of interest.
  *
+ * - The functions in @ref lsm_fast_marching_method.h use the fast 
+ *   marching method.  The "WithEngine" variants (e.g. 
+ *   computeDistanceFunctionWithEngine3d()) take the algorithm as an 
+ *   argument so that first-order calculations can be carried out 
+ *   using the fast sweeping method instead (see 
+ *   @ref lsm_fast_sweeping_method.h).
+ *
+ * - Each calculation allocates (and frees) grid-sized work arrays and
+ *   priority queues.  When the functions are called repeatedly (e.g.
+ *   to redistance a level set function every few time steps), this
+ *   overhead can be avoided by creating a workspace using 
+ *   createFMMWorkspace() and passing it to the "WithWorkspace" 
+ *   variants of the functions (e.g. computeDistanceFunctionWithWorkspace3d()).
+ *
  */
 
 
@@ -184,6 +200,286 @@ int computeDistanceFunction2d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * computeExtensionFieldsWithBoundaryData2d uses the FMM algorithm to 
+ * compute the distance function and extension fields from the original 
+ * level set function, phi, and the specified source fields when the 
+ * values of the distance function and extension fields are already 
+ * known at a set of "boundary" grid points (e.g. ghost cells filled
+ * with data from a neighboring patch or processor).
+ *
+ * Arguments:
+ *  - distance_function (in/out):         updated distance function; 
+ *                                        on input, contains the values of 
+ *                                        the distance function at boundary 
+ *                                        grid points
+ *  - extension_fields (in/out):          extension fields; on input, 
+ *                                        contains the values of the 
+ *                                        extension fields at boundary 
+ *                                        grid points
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.  
+ *  - source_fields(in):                  source fields used to compute 
+ *                                        extension fields
+ *  - extension_mask(in):                 extension velocities to
+ *                                        ignore when evaluating the
+ *                                        interface values; masked
+ *                                        grid points should be
+ *                                        negative
+ *  - boundary_mask(in):                  mask for boundary grid points;
+ *                                        grid points where the distance 
+ *                                        function and extension fields 
+ *                                        are supplied on input should be
+ *                                        set to a positive value.
+ *  - num_extension_fields (in):          number of extension fields to compute
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ *
+ * NOTES:
+ *  - Boundary grid points that are on or adjacent to the zero level set
+ *    are initialized from phi in the same way as all other grid points.
+ *    All other boundary grid points are treated as part of the initial
+ *    front, and their values are left unchanged.
+ *
+ *  - Boundary values are only useful if they are consistent with the
+ *    distance function in the rest of the grid.  In particular, the
+ *    caller should only supply boundary values that are known to be
+ *    at least as accurate as the values that would be computed from
+ *    the local data.
+ *
+ *  - When boundary_mask is not NULL, grid points that cannot be 
+ *    reached from the zero level set or the boundary grid points have 
+ *    their distance function set to +/- LSMLIB_REAL_MAX (with the sign 
+ *    of phi) and their extension fields set to LSMLIB_REAL_MAX.
+ *
+ *  - If boundary_mask is set to a NULL pointer, then 
+ *    computeExtensionFieldsWithBoundaryData2d() is equivalent to 
+ *    computeExtensionFields2d().
+ *
+ *  - All of the notes for computeExtensionFields2d() also apply.
+ *
+ */
+int computeExtensionFieldsWithBoundaryData2d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeExtensionFieldsWithCutoff2d uses the FMM algorithm to compute
+ * the distance function and extension fields from the original level 
+ * set function, phi, and the specified source fields within a band
+ * around the zero level set.  The calculation is terminated once the
+ * front has moved a distance max_distance away from the zero level set.
+ *
+ * Arguments:
+ *  - distance_function (out):            updated distance function
+ *  - extension_fields (out):             extension fields
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - source_fields(in):                  source fields used to compute 
+ *                                        extension fields
+ *  - extension_mask(in):                 extension velocities to
+ *                                        ignore when evaluating the
+ *                                        interface values; masked
+ *                                        grid points should be
+ *                                        negative
+ *  - num_extension_fields (in):          number of extension fields to compute
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - max_distance (in):                  cut-off distance for the 
+ *                                        calculation; must be positive
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ *
+ * NOTES:
+ *  - Grid points farther than max_distance from the zero level set 
+ *    have their distance function set to +/- max_distance (with the
+ *    sign of phi).  The extension fields at grid points that are not 
+ *    reached by the front are set to 0.
+ *
+ *  - The cost of the calculation is proportional to the number of 
+ *    grid points within the band rather than the total number of grid 
+ *    points, so the cut-off can substantially reduce the computational 
+ *    time for narrow-band level set calculations.
+ *
+ *  - Setting max_distance to LSMLIB_REAL_MAX is equivalent to calling 
+ *    computeExtensionFields2d().
+ *
+ *  - All of the notes for computeExtensionFields2d() also apply.
+ *
+ */
+int computeExtensionFieldsWithCutoff2d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeDistanceFunctionWithCutoff2d uses the FMM algorithm to compute 
+ * the distance function from the original level set function, phi, 
+ * within a band around the zero level set.  The calculation is 
+ * terminated once the front has moved a distance max_distance away 
+ * from the zero level set.
+ *
+ * Arguments:
+ *  - distance_function (out):            updated distance function
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - max_distance (in):                  cut-off distance for the 
+ *                                        calculation; must be positive
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ *
+ * NOTES:
+ *  - Grid points farther than max_distance from the zero level set 
+ *    have their distance function set to +/- max_distance (with the
+ *    sign of phi).
+ *
+ *  - All of the notes for computeDistanceFunction2d() also apply.
+ *
+ */
+int computeDistanceFunctionWithCutoff2d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeDistanceFunctionIncrementally2d uses the FMM algorithm to 
+ * update a distance function after the level set function has changed
+ * in part of the domain.  Only the region where the distance function
+ * changes is re-marched.
+ *
+ * Arguments:
+ *  - distance_function (in/out):         on input, distance function 
+ *                                        computed from the previous level 
+ *                                        set function, phi_prev; on 
+ *                                        output, distance function for phi
+ *  - phi (in):                           level set function
+ *  - phi_prev (in):                      previous level set function (may
+ *                                        be distance_function)
+ *  - change_mask (in):                   grid points where phi differs 
+ *                                        from the previous level set 
+ *                                        function should be set to a 
+ *                                        positive value
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - max_distance (in):                  cut-off distance for the 
+ *                                        calculation (LSMLIB_REAL_MAX for 
+ *                                        no cut-off); must be positive
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ *
+ * NOTES:
+ *  - The change in the level set function is specified by either 
+ *    change_mask or phi_prev.  If change_mask is not NULL, phi_prev is
+ *    ignored.  If both are NULL, the distance function is recomputed
+ *    everywhere (i.e. computeDistanceFunctionWithCutoff2d() is called).
+ *
+ *  - Only first-order calculations are carried out incrementally.  For
+ *    second-order calculations, the distance function is recomputed
+ *    everywhere because the second-order values at the edge of the 
+ *    re-marched region depend on the order in which the boundary data
+ *    are accepted, so the region would grow to cover the grid anyway.
+ *
+ *  - When phi_prev is supplied, only changes at grid points on or 
+ *    adjacent to the zero level set of phi or phi_prev are considered
+ *    because the distance function does not depend on the values of 
+ *    phi at other grid points.
+ *
+ *  - The fast marching method is re-run in a region around the grid 
+ *    points where phi changed.  The values of the distance function 
+ *    around the region are used as boundary data.  The region is 
+ *    enlarged until the recomputed values at its edge agree with the
+ *    previous distance function, so the result is the same as the 
+ *    result of computeDistanceFunctionWithCutoff2d() (up to round-off
+ *    and the order in which grid points with equal values are 
+ *    accepted).  If the region grows to cover more than a quarter of 
+ *    the grid, the distance function is recomputed everywhere.
+ *
+ *  - Without a cut-off, moving part of the zero level set changes the
+ *    distance function at every grid point that is closer to that
+ *    part than to the rest of the zero level set, so the region is 
+ *    often large.  With a cut-off, the region is confined to a band 
+ *    of width max_distance around the part of the zero level set that
+ *    moved.
+ *
+ *  - The savings depend on the input distance function having been 
+ *    computed by computeDistanceFunctionWithCutoff2d() or 
+ *    computeDistanceFunctionIncrementally2d() using the same mask,
+ *    spatial_discretization_order, and max_distance.  Otherwise, the 
+ *    recomputed values will not agree with the input values and the 
+ *    region will grow to cover the entire grid.
+ *
+ *  - All of the notes for computeDistanceFunction2d() also apply.
+ *
+ */
+int computeDistanceFunctionIncrementally2d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_prev,
+  LSMLIB_REAL *change_mask,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 /*!
  * solveEikonalEquation2d uses the FMM algorithm to solve the Eikonal
  * equation 
@@ -392,36 +688,114 @@ int computeDistanceFunction3d(
   LSMLIB_REAL *dx);
 
 /*!
- * solveEikonalEquation3d uses the FMM algorithm to solve the Eikonal
- * equation 
+ * computeExtensionFieldsWithBoundaryData3d uses the FMM algorithm to 
+ * compute the distance function and extension fields from the original 
+ * level set function, phi, and the specified source fields when the 
+ * values of the distance function and extension fields are already 
+ * known at a set of "boundary" grid points (e.g. ghost cells filled
+ * with data from a neighboring patch or processor).
  *
- *   |grad(phi)| = 1/speed(x,y,z)
+ * Arguments:
+ *  - distance_function (in/out):         updated distance function; 
+ *                                        on input, contains the values of 
+ *                                        the distance function at boundary 
+ *                                        grid points
+ *  - extension_fields (in/out):          extension fields; on input, 
+ *                                        contains the values of the 
+ *                                        extension fields at boundary 
+ *                                        grid points
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.  
+ *  - source_fields(in):                  source fields used to compute 
+ *                                        extension fields
+ *  - extension_mask(in):                 extension velocities to
+ *                                        ignore when evaluating the
+ *                                        interface values; masked
+ *                                        grid points should be
+ *                                        negative
+ *  - boundary_mask(in):                  mask for boundary grid points;
+ *                                        grid points where the distance 
+ *                                        function and extension fields 
+ *                                        are supplied on input should be
+ *                                        set to a positive value.
+ *  - num_extension_fields (in):          number of extension fields to compute
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
  *
- * in three space dimensions with the specified boundary data 
- * and speed function. 
+ * Return value:                          error code (see NOTES for translation)
  *
- * This function assumes that the solution phi is assumed to be 
- * strictly non-negative with values in the interior of the domain 
- * greater than the values on the boundaries.  For problems where 
- * phi takes on negative values with interior values greater than 
- * boundary values, this function can be used to solve for 
- * psi = phi + C, where C is a constant offset that ensures that psi 
- * is strictly non-negative.  For problems where interior values are 
- * less than boundary values, this function can be used to solve for
- * psi = -phi.
  *
+ * NOTES:
+ *  - Boundary grid points that are on or adjacent to the zero level set
+ *    are initialized from phi in the same way as all other grid points.
+ *    All other boundary grid points are treated as part of the initial
+ *    front, and their values are left unchanged.
+ *
+ *  - Boundary values are only useful if they are consistent with the
+ *    distance function in the rest of the grid.  In particular, the
+ *    caller should only supply boundary values that are known to be
+ *    at least as accurate as the values that would be computed from
+ *    the local data.
+ *
+ *  - When boundary_mask is not NULL, grid points that cannot be 
+ *    reached from the zero level set or the boundary grid points have 
+ *    their distance function set to +/- LSMLIB_REAL_MAX (with the sign 
+ *    of phi) and their extension fields set to LSMLIB_REAL_MAX.
+ *
+ *  - If boundary_mask is set to a NULL pointer, then 
+ *    computeExtensionFieldsWithBoundaryData3d() is equivalent to 
+ *    computeExtensionFields3d().
+ *
+ *  - All of the notes for computeExtensionFields3d() also apply.
+ *
+ */
+int computeExtensionFieldsWithBoundaryData3d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeExtensionFieldsWithCutoff3d uses the FMM algorithm to compute
+ * the distance function and extension fields from the original level 
+ * set function, phi, and the specified source fields within a band
+ * around the zero level set.  The calculation is terminated once the
+ * front has moved a distance max_distance away from the zero level set.
  *
  * Arguments:
- *  - phi (in/out):                       pointer to solution to Eikonal 
- *                                        equation phi must be initialized as
- *                                        specified in the NOTES below. 
- *  - speed (in):                         pointer to speed field
+ *  - distance_function (out):            updated distance function
+ *  - extension_fields (out):             extension fields
+ *  - phi (in):                           original level set function
  *  - mask (in):                          mask for domain of problem;
  *                                        grid points outside of the domain
  *                                        of the problem should be set to a 
  *                                        negative value.
+ *  - source_fields(in):                  source fields used to compute 
+ *                                        extension fields
+ *  - extension_mask(in):                 extension velocities to
+ *                                        ignore when evaluating the
+ *                                        interface values; masked
+ *                                        grid points should be
+ *                                        negative
+ *  - num_extension_fields (in):          number of extension fields to compute
  *  - spatial_discretization_order (in):  order of finite differences used 
  *                                        to compute spatial derivatives
+ *  - max_distance (in):                  cut-off distance for the 
+ *                                        calculation; must be positive
  *  - grid_dims (in):                     array of index space extents for all 
  *                                        fields 
  *  - dx (in):                            array of grid cell sizes in each 
@@ -431,43 +805,686 @@ int computeDistanceFunction3d(
  *
  *
  * NOTES:
- *  - When using the second-order spatial discretization, the solution
- *    phi is second-order accurate in the L-infinity norm only if the 
- *    "boundary values" of phi are specified in a layer of grid cells at 
- *    least two deep near the mathematical/physical domain boundary.  
- *    Otherwise, the values of the solution near the boundary will only 
- *    be first-order accurate.  Close to second-order convergence in the 
- *    L2 norm is achieved using the second-order scheme even if only one 
- *    layer of boundary values is specified.
- *
- *  - phi MUST be initialized so that the values for phi at grid points on 
- *    or adjacent to the boundary of the domain for the Eikonal equation 
- *    are correctly set.  All other grid points should be set to have
- *    negative values for phi.
- *
- *  - For grid points that are masked out or have speed equal to zero, phi 
- *    is set to LSMLIB_REAL_MAX.
- *
- *  - It is assumed that the phi, speed, and mask data arrays are all of 
- *    the same size.  That is, all data fields are assumed to have the 
- *    same index space extents.
+ *  - Grid points farther than max_distance from the zero level set 
+ *    have their distance function set to +/- max_distance (with the
+ *    sign of phi).  The extension fields at grid points that are not 
+ *    reached by the front are set to 0.
  *
- *  - Both phi and the speed function MUST be strictly non-negative.
+ *  - The cost of the calculation is proportional to the number of 
+ *    grid points within the band rather than the total number of grid 
+ *    points, so the cut-off can substantially reduce the computational 
+ *    time for narrow-band level set calculations.
  *
- *  - It is the user's responsibility to set the speed function.
+ *  - Setting max_distance to LSMLIB_REAL_MAX is equivalent to calling 
+ *    computeExtensionFields3d().
  *
- *  - If mask is set to a NULL pointer, then all grid points are treated
- *    as being in the interior of the domain.
+ *  - All of the notes for computeExtensionFields3d() also apply.
  *
  */
-int solveEikonalEquation3d(
+int computeExtensionFieldsWithCutoff3d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
   LSMLIB_REAL *phi,
-  LSMLIB_REAL *speed,
   LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
   int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * computeDistanceFunctionWithCutoff3d uses the FMM algorithm to compute 
+ * the distance function from the original level set function, phi, 
+ * within a band around the zero level set.  The calculation is 
+ * terminated once the front has moved a distance max_distance away 
+ * from the zero level set.
+ *
+ * Arguments:
+ *  - distance_function (out):            updated distance function
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - max_distance (in):                  cut-off distance for the 
+ *                                        calculation; must be positive
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ *
+ * NOTES:
+ *  - Grid points farther than max_distance from the zero level set 
+ *    have their distance function set to +/- max_distance (with the
+ *    sign of phi).
+ *
+ *  - All of the notes for computeDistanceFunction3d() also apply.
+ *
+ */
+int computeDistanceFunctionWithCutoff3d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeDistanceFunctionIncrementally3d uses the FMM algorithm to 
+ * update a distance function after the level set function has changed
+ * in part of the domain.  Only the region where the distance function
+ * changes is re-marched.
+ *
+ * Arguments:
+ *  - distance_function (in/out):         on input, distance function 
+ *                                        computed from the previous level 
+ *                                        set function, phi_prev; on 
+ *                                        output, distance function for phi
+ *  - phi (in):                           level set function
+ *  - phi_prev (in):                      previous level set function (may
+ *                                        be distance_function)
+ *  - change_mask (in):                   grid points where phi differs 
+ *                                        from the previous level set 
+ *                                        function should be set to a 
+ *                                        positive value
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - max_distance (in):                  cut-off distance for the 
+ *                                        calculation (LSMLIB_REAL_MAX for 
+ *                                        no cut-off); must be positive
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ *
+ * NOTES:
+ *  - The change in the level set function is specified by either 
+ *    change_mask or phi_prev.  If change_mask is not NULL, phi_prev is
+ *    ignored.  If both are NULL, the distance function is recomputed
+ *    everywhere (i.e. computeDistanceFunctionWithCutoff3d() is called).
+ *
+ *  - Only first-order calculations are carried out incrementally.  For
+ *    second-order calculations, the distance function is recomputed
+ *    everywhere because the second-order values at the edge of the 
+ *    re-marched region depend on the order in which the boundary data
+ *    are accepted, so the region would grow to cover the grid anyway.
+ *
+ *  - When phi_prev is supplied, only changes at grid points on or 
+ *    adjacent to the zero level set of phi or phi_prev are considered
+ *    because the distance function does not depend on the values of 
+ *    phi at other grid points.
+ *
+ *  - The fast marching method is re-run in a region around the grid 
+ *    points where phi changed.  The values of the distance function 
+ *    around the region are used as boundary data.  The region is 
+ *    enlarged until the recomputed values at its edge agree with the
+ *    previous distance function, so the result is the same as the 
+ *    result of computeDistanceFunctionWithCutoff3d() (up to round-off
+ *    and the order in which grid points with equal values are 
+ *    accepted).  If the region grows to cover more than a quarter of 
+ *    the grid, the distance function is recomputed everywhere.
+ *
+ *  - Without a cut-off, moving part of the zero level set changes the
+ *    distance function at every grid point that is closer to that
+ *    part than to the rest of the zero level set, so the region is 
+ *    often large.  With a cut-off, the region is confined to a band 
+ *    of width max_distance around the part of the zero level set that
+ *    moved.
+ *
+ *  - The savings depend on the input distance function having been 
+ *    computed by computeDistanceFunctionWithCutoff3d() or 
+ *    computeDistanceFunctionIncrementally3d() using the same mask,
+ *    spatial_discretization_order, and max_distance.  Otherwise, the 
+ *    recomputed values will not agree with the input values and the 
+ *    region will grow to cover the entire grid.
+ *
+ *  - All of the notes for computeDistanceFunction3d() also apply.
+ *
+ */
+int computeDistanceFunctionIncrementally3d(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_prev,
+  LSMLIB_REAL *change_mask,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * solveEikonalEquation3d uses the FMM algorithm to solve the Eikonal
+ * equation 
+ *
+ *   |grad(phi)| = 1/speed(x,y,z)
+ *
+ * in three space dimensions with the specified boundary data 
+ * and speed function. 
+ *
+ * This function assumes that the solution phi is assumed to be 
+ * strictly non-negative with values in the interior of the domain 
+ * greater than the values on the boundaries.  For problems where 
+ * phi takes on negative values with interior values greater than 
+ * boundary values, this function can be used to solve for 
+ * psi = phi + C, where C is a constant offset that ensures that psi 
+ * is strictly non-negative.  For problems where interior values are 
+ * less than boundary values, this function can be used to solve for
+ * psi = -phi.
+ *
+ *
+ * Arguments:
+ *  - phi (in/out):                       pointer to solution to Eikonal 
+ *                                        equation phi must be initialized as
+ *                                        specified in the NOTES below. 
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ *
+ * NOTES:
+ *  - When using the second-order spatial discretization, the solution
+ *    phi is second-order accurate in the L-infinity norm only if the 
+ *    "boundary values" of phi are specified in a layer of grid cells at 
+ *    least two deep near the mathematical/physical domain boundary.  
+ *    Otherwise, the values of the solution near the boundary will only 
+ *    be first-order accurate.  Close to second-order convergence in the 
+ *    L2 norm is achieved using the second-order scheme even if only one 
+ *    layer of boundary values is specified.
+ *
+ *  - phi MUST be initialized so that the values for phi at grid points on 
+ *    or adjacent to the boundary of the domain for the Eikonal equation 
+ *    are correctly set.  All other grid points should be set to have
+ *    negative values for phi.
+ *
+ *  - For grid points that are masked out or have speed equal to zero, phi 
+ *    is set to LSMLIB_REAL_MAX.
+ *
+ *  - It is assumed that the phi, speed, and mask data arrays are all of 
+ *    the same size.  That is, all data fields are assumed to have the 
+ *    same index space extents.
+ *
+ *  - Both phi and the speed function MUST be strictly non-negative.
+ *
+ *  - It is the user's responsibility to set the speed function.
+ *
+ *  - If mask is set to a NULL pointer, then all grid points are treated
+ *    as being in the interior of the domain.
+ *
+ */
+int solveEikonalEquation3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeExtensionFieldsWithEngine2d() is identical to
+ * computeExtensionFieldsWithCutoff2d() except that the algorithm used
+ * for the calculation is specified by the caller.
+ *
+ * Arguments:
+ *  - engine (in):            algorithm to use (see LSM_EikonalEngine in
+ *                            @ref lsm_fast_sweeping_method.h)
+ *  - max_distance (in):      distance from the zero level set beyond which
+ *                            the calculation is terminated 
+ *                            (LSMLIB_REAL_MAX for no cut-off)
+ *  - all other arguments:    see computeExtensionFieldsWithCutoff2d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - The fast sweeping method only supports first-order calculations.
+ *    When spatial_discretization_order is 2, the fast marching method 
+ *    is used regardless of engine.
+ *
+ *  - The distance functions computed by the two engines agree closely,
+ *    but the extension fields can differ at grid points where 
+ *    characteristics from different parts of the zero level set meet.
+ *    See @ref lsm_fast_sweeping_method.h for measured differences and
+ *    for when the fast sweeping method is faster.
+ *
+ */
+int computeExtensionFieldsWithEngine2d(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeExtensionFieldsWithEngine3d() is identical to
+ * computeExtensionFieldsWithCutoff3d() except that the algorithm used
+ * for the calculation is specified by the caller.
+ *
+ * Arguments:
+ *  - engine (in):            algorithm to use (see LSM_EikonalEngine in
+ *                            @ref lsm_fast_sweeping_method.h)
+ *  - max_distance (in):      distance from the zero level set beyond which
+ *                            the calculation is terminated 
+ *                            (LSMLIB_REAL_MAX for no cut-off)
+ *  - all other arguments:    see computeExtensionFieldsWithCutoff3d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithEngine2d().
+ *
+ */
+int computeExtensionFieldsWithEngine3d(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeDistanceFunctionWithEngine2d() is identical to 
+ * computeDistanceFunction2d() except that the algorithm used for the
+ * calculation is specified by the caller.
+ *
+ * Arguments:
+ *  - engine (in):            algorithm to use (see LSM_EikonalEngine in
+ *                            @ref lsm_fast_sweeping_method.h)
+ *  - all other arguments:    see computeDistanceFunction2d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithEngine2d().
+ *
+ */
+int computeDistanceFunctionWithEngine2d(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeDistanceFunctionWithEngine3d() is identical to 
+ * computeDistanceFunction3d() except that the algorithm used for the
+ * calculation is specified by the caller.
+ *
+ * Arguments:
+ *  - engine (in):            algorithm to use (see LSM_EikonalEngine in
+ *                            @ref lsm_fast_sweeping_method.h)
+ *  - all other arguments:    see computeDistanceFunction3d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithEngine2d().
+ *
+ */
+int computeDistanceFunctionWithEngine3d(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * solveEikonalEquationWithEngine2d() is identical to 
+ * solveEikonalEquation2d() except that the algorithm used for the
+ * calculation is specified by the caller.
+ *
+ * Arguments:
+ *  - engine (in):            algorithm to use (see LSM_EikonalEngine in
+ *                            @ref lsm_fast_sweeping_method.h)
+ *  - all other arguments:    see solveEikonalEquation2d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - The fast sweeping method only supports first-order calculations.
+ *    When spatial_discretization_order is 2, the fast marching method 
+ *    is used regardless of engine.
+ *
+ */
+int solveEikonalEquationWithEngine2d(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * solveEikonalEquationWithEngine3d() is identical to 
+ * solveEikonalEquation3d() except that the algorithm used for the
+ * calculation is specified by the caller.
+ *
+ * Arguments:
+ *  - engine (in):            algorithm to use (see LSM_EikonalEngine in
+ *                            @ref lsm_fast_sweeping_method.h)
+ *  - all other arguments:    see solveEikonalEquation3d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See solveEikonalEquationWithEngine2d().
+ *
+ */
+int solveEikonalEquationWithEngine3d(
+  LSM_EikonalEngine engine,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * LSM_FMM_Workspace holds the grid-sized work arrays and priority 
+ * queues used by the fast marching method functions so that they can 
+ * be reused by many calculations.
+ */
+typedef struct LSM_FMM_Workspace LSM_FMM_Workspace;
+
+/*!
+ * createFMMWorkspace() creates an empty workspace for fast marching
+ * method calculations.
+ *
+ * Arguments:      none
+ *
+ * Return value:   pointer to new workspace (NULL if memory could not be
+ *                 allocated)
+ *
+ * NOTES:
+ *  - Memory for the work arrays and priority queues is allocated by
+ *    the first calculation that uses the workspace.  Later calculations
+ *    reset and reuse this memory.  The work arrays are only reallocated
+ *    for grids that are larger than any earlier grid, and the priority
+ *    queues keep the size they grew to during earlier calculations.
+ *
+ */
+LSM_FMM_Workspace* createFMMWorkspace(void);
+
+/*!
+ * destroyFMMWorkspace() frees the memory associated with a workspace.
+ *
+ * Arguments:
+ *  - workspace (in):  workspace to be destroyed
+ *
+ * Return value:       none
+ *
+ * NOTES:
+ *  - workspace MUST NOT be destroyed while it is being used by a
+ *    calculation.
+ *
+ */
+void destroyFMMWorkspace(LSM_FMM_Workspace *workspace);
+
+/*!
+ * computeExtensionFieldsWithWorkspace2d() is identical to
+ * computeExtensionFieldsWithBoundaryData2d() (with an optional cut-off
+ * distance) except that the work arrays and priority queues are taken
+ * from a caller-supplied workspace.
+ *
+ * Arguments:
+ *  - workspace (in/out):     workspace created using createFMMWorkspace()
+ *                            (NULL to allocate new work arrays)
+ *  - max_distance (in):      distance from the zero level set beyond which
+ *                            the calculation is terminated 
+ *                            (LSMLIB_REAL_MAX for no cut-off)
+ *  - all other arguments:    see computeExtensionFieldsWithBoundaryData2d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - A workspace is owned by the caller; no global state is used to
+ *    select it.  Calculations that run concurrently (e.g. in different 
+ *    threads) MUST use different workspaces.  If a workspace is passed 
+ *    to a calculation while it is in use by another calculation on the
+ *    same thread, new work arrays are allocated for that calculation.
+ *
+ *  - boundary_mask may be set to a NULL pointer (see 
+ *    computeExtensionFieldsWithBoundaryData2d()).  Grid points beyond
+ *    the cut-off are handled as in computeExtensionFieldsWithCutoff2d().
+ *
+ */
+int computeExtensionFieldsWithWorkspace2d(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeExtensionFieldsWithWorkspace3d() is identical to
+ * computeExtensionFieldsWithBoundaryData3d() (with an optional cut-off
+ * distance) except that the work arrays and priority queues are taken
+ * from a caller-supplied workspace.
+ *
+ * Arguments:
+ *  - workspace (in/out):     workspace created using createFMMWorkspace()
+ *                            (NULL to allocate new work arrays)
+ *  - max_distance (in):      distance from the zero level set beyond which
+ *                            the calculation is terminated 
+ *                            (LSMLIB_REAL_MAX for no cut-off)
+ *  - all other arguments:    see computeExtensionFieldsWithBoundaryData3d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithWorkspace2d().
+ *
+ */
+int computeExtensionFieldsWithWorkspace3d(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  LSMLIB_REAL *boundary_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeDistanceFunctionWithWorkspace2d() is identical to 
+ * computeDistanceFunction2d() except that the work arrays and priority 
+ * queues are taken from a caller-supplied workspace.
+ *
+ * Arguments:
+ *  - workspace (in/out):     workspace created using createFMMWorkspace()
+ *                            (NULL to allocate new work arrays)
+ *  - all other arguments:    see computeDistanceFunction2d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithWorkspace2d().
+ *
+ */
+int computeDistanceFunctionWithWorkspace2d(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeDistanceFunctionWithWorkspace3d() is identical to 
+ * computeDistanceFunction3d() except that the work arrays and priority 
+ * queues are taken from a caller-supplied workspace.
+ *
+ * Arguments:
+ *  - workspace (in/out):     workspace created using createFMMWorkspace()
+ *                            (NULL to allocate new work arrays)
+ *  - all other arguments:    see computeDistanceFunction3d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithWorkspace2d().
+ *
+ */
+int computeDistanceFunctionWithWorkspace3d(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * solveEikonalEquationWithWorkspace2d() is identical to 
+ * solveEikonalEquation2d() except that the work arrays and priority 
+ * queues are taken from a caller-supplied workspace.
+ *
+ * Arguments:
+ *  - workspace (in/out):     workspace created using createFMMWorkspace()
+ *                            (NULL to allocate new work arrays)
+ *  - all other arguments:    see solveEikonalEquation2d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithWorkspace2d().
+ *
+ */
+int solveEikonalEquationWithWorkspace2d(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * solveEikonalEquationWithWorkspace3d() is identical to 
+ * solveEikonalEquation3d() except that the work arrays and priority 
+ * queues are taken from a caller-supplied workspace.
+ *
+ * Arguments:
+ *  - workspace (in/out):     workspace created using createFMMWorkspace()
+ *                            (NULL to allocate new work arrays)
+ *  - all other arguments:    see solveEikonalEquation3d()
+ *
+ * Return value:              error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeExtensionFieldsWithWorkspace2d().
+ *
+ */
+int solveEikonalEquationWithWorkspace3d(
+  LSM_FMM_Workspace *workspace,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * FMM_acquireCoreData() is used by the fast marching method functions
+ * to obtain an FMM_CoreData for a calculation.  When a workspace is 
+ * supplied (and not already in use), its FMM_CoreData is reset (see 
+ * FMM_Core_resetFMM_CoreData()) and returned.  Otherwise, a new 
+ * FMM_CoreData is created.
+ *
+ * Arguments:
+ *  - workspace (in/out):    workspace to take the FMM_CoreData from
+ *                           (NULL to create a new FMM_CoreData)
+ *  - all other arguments:   see FMM_Core_createFMM_CoreDataWithQueue()
+ *
+ * Return value:   pointer to FMM_CoreData ready for a new calculation
+ *
+ * NOTES:
+ *  - Every FMM_CoreData obtained using FMM_acquireCoreData() MUST be 
+ *    released using FMM_releaseCoreData().
+ *
+ */
+FMM_CoreData* FMM_acquireCoreData(
+  LSM_FMM_Workspace *workspace,
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL bucket_width);
+
+/*!
+ * FMM_releaseCoreData() releases an FMM_CoreData obtained using 
+ * FMM_acquireCoreData().  FMM_CoreData owned by workspace is kept for 
+ * reuse; all other FMM_CoreData are destroyed.
+ *
+ * Arguments:
+ *  - workspace (in/out):  workspace passed to FMM_acquireCoreData()
+ *  - fmm_core_data (in):  FMM_CoreData to release
+ *
+ * Return value:           none
+ *
+ */
+void FMM_releaseCoreData(
+  LSM_FMM_Workspace *workspace,
+  FMM_CoreData *fmm_core_data);
+
 #ifdef __cplusplus
 }
 #endif
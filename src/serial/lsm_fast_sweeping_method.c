@@ -0,0 +1,755 @@
+/*
+ * File:        lsm_fast_sweeping_method.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation of 2D and 3D Fast Sweeping Method Algorithms
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include "LSMLIB_config.h"
+#include "FMM_Macros.h"
+#include "lsm_fast_sweeping_method.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/*========================= Constants ===============================*/
+
+/* maximum number of spatial dimensions supported by the FSM engine */
+#define LSM_FSM_MAX_NDIM                   (3)
+
+/* maximum number of iterations (i.e. sets of 2^N sweeps) */
+#define LSM_FSM_MAX_ITERATIONS             (1000)
+
+/* relative change below which a value is considered converged */
+#define LSM_FSM_CONVERGENCE_TOL            (LSMLIB_ZERO_TOL)
+
+/* status of grid points during the sweeps */
+#define LSM_FSM_FREE                       (0)
+#define LSM_FSM_FIXED                      (1)
+#define LSM_FSM_OUTSIDE_DOMAIN             (2)
+
+
+/*================== FSM Data Structures ============================*/
+
+/*
+ * FSM_Data holds the data shared by all of the sweeps.  In 2D, the
+ * grid is treated as a 3D grid with a single grid point in the
+ * z-direction.
+ */
+typedef struct FSM_Data {
+  int num_dims;
+  int grid_dims[LSM_FSM_MAX_NDIM];
+  int grid_stride[LSM_FSM_MAX_NDIM];
+  LSMLIB_REAL dx[LSM_FSM_MAX_NDIM];
+
+  LSMLIB_REAL *u;                  /* unsigned solution                  */
+  LSMLIB_REAL *speed;              /* speed (NULL for unit speed)        */
+  unsigned char *status;           /* status of grid points              */
+  LSMLIB_REAL max_value;           /* values above max_value are treated */
+                                   /* as unreached (for cut-offs)        */
+  int num_extension_fields;
+  LSMLIB_REAL **extension_fields;
+} FSM_Data;
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * FSM_initializeData() sets up the grid information in an FSM_Data
+ * structure.
+ */
+static int FSM_initializeData(
+  FSM_Data *fsm_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*
+ * FSM_initializeFront() sets the distance function and extension
+ * fields of grid points on or next to the zero level set and marks
+ * them as fixed.  It mirrors the first-order front initialization of
+ * the fast marching method (see lsm_FMM_field_extension.c).
+ */
+static void FSM_initializeFront(
+  FSM_Data *fsm_data,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask);
+
+/*
+ * FSM_updateGridPoint() computes the first-order Godunov upwind update
+ * of the solution (and extension fields) at a single grid point.  It
+ * returns 1 if any value changed by more than the convergence
+ * tolerance and 0 otherwise.
+ */
+static int FSM_updateGridPoint(
+  FSM_Data *fsm_data,
+  int idx,
+  int *grid_idx);
+
+/*
+ * FSM_sweep() carries out one Gauss-Seidel sweep over the grid in the
+ * directions specified by sweep_dir (+1 or -1 in each coordinate
+ * direction).  It returns the number of grid points whose values
+ * changed.
+ */
+static int FSM_sweep(
+  FSM_Data *fsm_data,
+  int *sweep_dir);
+
+#ifdef _OPENMP
+/*
+ * FSM_sweepHyperplanes() is identical to FSM_sweep() except that the
+ * grid is visited one hyperplane (i+j+k = constant) at a time and the
+ * grid points within each hyperplane are updated concurrently.
+ */
+static int FSM_sweepHyperplanes(
+  FSM_Data *fsm_data,
+  int *sweep_dir);
+#endif
+
+/*
+ * FSM_iterate() carries out sets of 2^N sweeps until the solution
+ * converges.
+ */
+static void FSM_iterate(FSM_Data *fsm_data);
+
+
+/*================== FSM Engine Function Definitions ================*/
+
+int FSM_computeExtensionFields(
+  int num_dims,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  FSM_Data fsm_data;
+  int num_gridpoints;
+  int idx, m;
+
+  if (spatial_discretization_order != 1) {
+    fprintf(stderr,
+           "ERROR: Invalid spatial derivative order.  Only first-order\n");
+    fprintf(stderr,
+           "       finite differences supported by the fast sweeping\n");
+    fprintf(stderr,
+           "       method.\n");
+    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
+  }
+
+  if (max_distance <= 0) {
+    fprintf(stderr,
+           "ERROR: Invalid cut-off distance.  max_distance must be\n");
+    fprintf(stderr,
+           "       positive.\n");
+    return LSM_FMM_ERR_INVALID_CUTOFF_DISTANCE;
+  }
+
+  /********************************************
+   * set up FSM Data
+   ********************************************/
+  num_gridpoints = FSM_initializeData(&fsm_data, num_dims, grid_dims, dx);
+  if (num_gridpoints < 0) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+
+  fsm_data.status =
+    (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+  if (!fsm_data.status) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  fsm_data.u = distance_function;
+  fsm_data.speed = 0;
+  fsm_data.max_value = max_distance;
+  fsm_data.num_extension_fields = num_extension_fields;
+  fsm_data.extension_fields = extension_fields;
+
+  /********************************************
+   * initialize distance function and extension
+   * fields and mark grid points outside of
+   * domain
+   ********************************************/
+#ifdef _OPENMP
+#pragma omp parallel for private(m) schedule(static)
+#endif
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    if ((mask) && (mask[idx] < 0)) {
+      fsm_data.status[idx] = LSM_FSM_OUTSIDE_DOMAIN;
+      for (m = 0; m < num_extension_fields; m++) {
+        extension_fields[m][idx] = LSMLIB_REAL_MAX;
+      }
+    } else {
+      fsm_data.status[idx] = LSM_FSM_FREE;
+      for (m = 0; m < num_extension_fields; m++) {
+        extension_fields[m][idx] = 0.0;
+      }
+    }
+    distance_function[idx] = LSMLIB_REAL_MAX;
+  }
+
+  /* initialize grid points around the front */
+  FSM_initializeFront(&fsm_data, phi, source_fields, extension_mask);
+
+  /* update remaining grid points */
+  FSM_iterate(&fsm_data);
+
+  /********************************************
+   * restore the sign of the distance function
+   * and handle grid points that were not
+   * reached
+   ********************************************/
+#ifdef _OPENMP
+#pragma omp parallel for private(m) schedule(static)
+#endif
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    LSMLIB_REAL dist = distance_function[idx];
+
+    if (LSM_FSM_OUTSIDE_DOMAIN == fsm_data.status[idx]) continue;
+
+    if (max_distance < LSMLIB_REAL_MAX) {
+
+      /* when the calculation is cut off, set the distance function */
+      /* to +/- max_distance and the extension fields to zero at    */
+      /* grid points that were not reached                          */
+      if (dist == LSMLIB_REAL_MAX) {
+        for (m = 0; m < num_extension_fields; m++) {
+          extension_fields[m][idx] = 0.0;
+        }
+      }
+      if (dist > max_distance) dist = max_distance;
+
+    } else if (dist == LSMLIB_REAL_MAX) {
+
+      distance_function[idx] = LSM_FMM_DEFAULT_UPDATE_VALUE;
+      for (m = 0; m < num_extension_fields; m++) {
+        extension_fields[m][idx] = LSM_FMM_DEFAULT_UPDATE_VALUE;
+      }
+      continue;
+    }
+
+    distance_function[idx] = (phi[idx] > 0) ? dist : -dist;
+  }
+
+  /* clean up memory */
+  free(fsm_data.status);
+
+  return LSM_FMM_ERR_SUCCESS;
+}
+
+
+int FSM_solveEikonalEquation(
+  int num_dims,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  FSM_Data fsm_data;
+  int num_gridpoints;
+  int idx;
+
+  if (spatial_discretization_order != 1) {
+    fprintf(stderr,
+           "ERROR: Invalid spatial derivative order.  Only first-order\n");
+    fprintf(stderr,
+           "       finite differences supported by the fast sweeping\n");
+    fprintf(stderr,
+           "       method.\n");
+    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
+  }
+
+  /********************************************
+   * set up FSM Data
+   ********************************************/
+  num_gridpoints = FSM_initializeData(&fsm_data, num_dims, grid_dims, dx);
+  if (num_gridpoints < 0) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+
+  fsm_data.status =
+    (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+  if (!fsm_data.status) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  fsm_data.u = phi;
+  fsm_data.speed = speed;
+  fsm_data.max_value = LSMLIB_REAL_MAX;
+  fsm_data.num_extension_fields = 0;
+  fsm_data.extension_fields = 0;
+
+  /********************************************
+   * initialize phi and mark grid points on the
+   * boundary and outside of the
+   * mathematical/physical domain
+   ********************************************/
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (idx = 0; idx < num_gridpoints; idx++) {
+
+    /* grid points with a negative mask value or a non-positive */
+    /* speed are taken to be outside of the domain              */
+    if ( ((mask) && (mask[idx] < 0)) || (speed[idx] < LSMLIB_ZERO_TOL) ) {
+      fsm_data.status[idx] = LSM_FSM_OUTSIDE_DOMAIN;
+      phi[idx] = LSMLIB_REAL_MAX;
+    } else if (phi[idx] > -LSMLIB_ZERO_TOL) {
+      /* the value for phi has already been provided */
+      fsm_data.status[idx] = LSM_FSM_FIXED;
+    } else {
+      fsm_data.status[idx] = LSM_FSM_FREE;
+      phi[idx] = LSMLIB_REAL_MAX;
+    }
+  }
+
+  /* update remaining grid points */
+  FSM_iterate(&fsm_data);
+
+  /* clean up memory */
+  free(fsm_data.status);
+
+  return LSM_FMM_ERR_SUCCESS;
+}
+
+
+/*================== Helper Functions Definitions ===================*/
+
+static int FSM_initializeData(
+  FSM_Data *fsm_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int dir;
+
+  if ((num_dims < 1) || (num_dims > LSM_FSM_MAX_NDIM)) return -1;
+
+  fsm_data->num_dims = num_dims;
+  for (dir = 0; dir < LSM_FSM_MAX_NDIM; dir++) {
+    fsm_data->grid_dims[dir] = (dir < num_dims) ? grid_dims[dir] : 1;
+    fsm_data->dx[dir] = (dir < num_dims) ? dx[dir] : 1;
+  }
+  fsm_data->grid_stride[0] = 1;
+  for (dir = 1; dir < LSM_FSM_MAX_NDIM; dir++) {
+    fsm_data->grid_stride[dir] =
+      fsm_data->grid_stride[dir-1]*fsm_data->grid_dims[dir-1];
+  }
+
+  return fsm_data->grid_stride[LSM_FSM_MAX_NDIM-1]
+        *fsm_data->grid_dims[LSM_FSM_MAX_NDIM-1];
+}
+
+
+static void FSM_initializeFront(
+  FSM_Data *fsm_data,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask)
+{
+  int num_dims = fsm_data->num_dims;
+  int *grid_dims = fsm_data->grid_dims;
+  int *grid_stride = fsm_data->grid_stride;
+  LSMLIB_REAL *dx = fsm_data->dx;
+  LSMLIB_REAL *distance_function = fsm_data->u;
+  unsigned char *status = fsm_data->status;
+  int num_extension_fields = fsm_data->num_extension_fields;
+  LSMLIB_REAL **extension_fields = fsm_data->extension_fields;
+  int num_gridpoints = grid_stride[LSM_FSM_MAX_NDIM-1]
+                      *grid_dims[LSM_FSM_MAX_NDIM-1];
+  int idx;
+
+  /*
+   * loop through cells in grid to find those that border the
+   * zero level set.  each grid point only modifies its own values,
+   * so the loop may be carried out concurrently.
+   */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (idx = 0; idx < num_gridpoints; idx++) {
+
+    LSMLIB_REAL phi_cur = phi[idx];
+    LSMLIB_REAL sum_dist_inv_sq = 0;
+    int on_interface = LSM_FMM_FALSE;
+    int borders_interface = LSM_FMM_FALSE;
+    int grid_idx[LSM_FSM_MAX_NDIM];
+    int idx_remainder = idx;
+    int dir, m;
+
+    /* skip point if it is out of the mathematical/physical domain */
+    if (LSM_FSM_OUTSIDE_DOMAIN == status[idx]) continue;
+
+    /* compute grid_idx */
+    for (dir = 0; dir < LSM_FSM_MAX_NDIM; dir++) {
+      grid_idx[dir] = idx_remainder%grid_dims[dir];
+      idx_remainder /= grid_dims[dir];
+    }
+
+    /* zero out accumulation variables */
+    for (m = 0; m < num_extension_fields; m++) {
+      extension_fields[m][idx] = 0;
+    }
+
+    /* check if current grid point is on the zero level set */
+    if (LSM_FMM_ABS(phi_cur) < LSMLIB_ZERO_TOL) {
+
+      on_interface = LSM_FMM_TRUE;
+
+    } else {
+
+      /* loop over directions */
+      for (dir = 0; dir < num_dims; dir++) {
+        LSMLIB_REAL dist_minus = LSMLIB_REAL_MAX;
+        LSMLIB_REAL dist_plus = LSMLIB_REAL_MAX;
+        LSMLIB_REAL dist_dir, dist_inv_sq_dir;
+        int idx_minus = idx - grid_stride[dir];
+        int idx_plus = idx + grid_stride[dir];
+        int idx_neighbor;
+
+        /* calculate distance to interface in minus direction */
+        if (grid_idx[dir] > 0) {
+          LSMLIB_REAL phi_minus = phi[idx_minus];
+          if (phi_minus*phi_cur <= 0) {
+            dist_minus = phi_cur/(phi_cur-phi_minus)*dx[dir];
+          }
+        }
+
+        /* calculate distance to interface in plus direction */
+        if (grid_idx[dir] < grid_dims[dir]-1) {
+          LSMLIB_REAL phi_plus = phi[idx_plus];
+          if (phi_plus*phi_cur <= 0) {
+            dist_plus = phi_cur/(phi_cur-phi_plus)*dx[dir];
+          }
+        }
+
+        /* skip direction if the interface is not crossed */
+        if (  (dist_plus == LSMLIB_REAL_MAX)
+           && (dist_minus == LSMLIB_REAL_MAX) ) continue;
+
+        borders_interface = LSM_FMM_TRUE;
+
+        if (dist_plus < dist_minus) {
+          dist_dir = dist_plus;
+          idx_neighbor = idx_plus;
+        } else {
+          dist_dir = dist_minus;
+          idx_neighbor = idx_minus;
+        }
+
+        /* update 1/dist^2 and ext_field/dist^2 values with */
+        /* information from current coordinate direction    */
+        dist_inv_sq_dir = 1/dist_dir/dist_dir;
+        sum_dist_inv_sq += dist_inv_sq_dir;
+
+        for (m = 0; m < num_extension_fields; m++) {
+          LSMLIB_REAL ext_cur = source_fields[m][idx];
+          LSMLIB_REAL ext_interface;
+
+          if ((extension_mask) && (extension_mask[idx] < 0))
+            ext_interface = source_fields[m][idx_neighbor];
+          else if ((extension_mask) && (extension_mask[idx_neighbor] < 0))
+            ext_interface = ext_cur;
+          else
+            /* use linear interpolation for value of source field */
+            /* at interface                                       */
+            ext_interface = ext_cur + dist_dir/dx[dir]
+                          *(source_fields[m][idx_neighbor]-ext_cur);
+
+          extension_fields[m][idx] += ext_interface*dist_inv_sq_dir;
+        }
+
+      } /* end loop over directions */
+
+    } /* end case:  abs(phi_cur) >= LSMLIB_ZERO_TOL */
+
+    /* set distance function and extension field of grid points */
+    /* on or bordering the zero level set                       */
+    if (on_interface) {
+
+      distance_function[idx] = LSMLIB_ZERO_TOL;
+      for (m = 0; m < num_extension_fields; m++) {
+        extension_fields[m][idx] = source_fields[m][idx];
+      }
+      status[idx] = LSM_FSM_FIXED;
+
+    } else if (borders_interface) {
+
+      distance_function[idx] = sqrt(1.0/sum_dist_inv_sq);
+      for (m = 0; m < num_extension_fields; m++) {
+        extension_fields[m][idx] /= sum_dist_inv_sq;
+      }
+      status[idx] = LSM_FSM_FIXED;
+
+    }
+
+  } /* end loop over grid */
+}
+
+
+static int FSM_updateGridPoint(
+  FSM_Data *fsm_data,
+  int idx,
+  int *grid_idx)
+{
+  int num_dims = fsm_data->num_dims;
+  LSMLIB_REAL *u = fsm_data->u;
+  LSMLIB_REAL *dx = fsm_data->dx;
+  int num_extension_fields = fsm_data->num_extension_fields;
+  LSMLIB_REAL **extension_fields = fsm_data->extension_fields;
+
+  /* upwind neighbor values, indices and sorted order */
+  LSMLIB_REAL u_upwind[LSM_FSM_MAX_NDIM];
+  int idx_upwind[LSM_FSM_MAX_NDIM];
+  int order[LSM_FSM_MAX_NDIM];
+  int num_upwind = 0;
+
+  /* coefficients of quadratic equation for u */
+  LSMLIB_REAL u_A = 0;
+  LSMLIB_REAL u_B = 0;
+  LSMLIB_REAL u_C = 0;
+  LSMLIB_REAL rhs;
+  LSMLIB_REAL u_cur = u[idx];
+  LSMLIB_REAL u_updated = LSMLIB_REAL_MAX;
+
+  int changed = 0;
+  int dir, l, m;
+
+  /* find upwind neighbor in each direction */
+  for (dir = 0; dir < num_dims; dir++) {
+    int stride = fsm_data->grid_stride[dir];
+    LSMLIB_REAL u_dir = LSMLIB_REAL_MAX;
+    int idx_dir = -1;
+
+    if (grid_idx[dir] > 0) {
+      u_dir = u[idx-stride];
+      idx_dir = idx-stride;
+    }
+    if ( (grid_idx[dir] < fsm_data->grid_dims[dir]-1) &&
+         (u[idx+stride] < u_dir) ) {
+      u_dir = u[idx+stride];
+      idx_dir = idx+stride;
+    }
+
+    /* insert direction into list sorted by upwind value */
+    if (u_dir < LSMLIB_REAL_MAX) {
+      u_upwind[dir] = u_dir;
+      idx_upwind[dir] = idx_dir;
+      for (l = num_upwind; (l > 0) && (u_upwind[order[l-1]] > u_dir); l--) {
+        order[l] = order[l-1];
+      }
+      order[l] = dir;
+      num_upwind++;
+    }
+  }
+
+  /* no neighbors have been reached yet */
+  if (0 == num_upwind) return 0;
+
+  /* right-hand side of Eikonal equation */
+  rhs = (fsm_data->speed) ? 1.0/fsm_data->speed[idx] : 1.0;
+  rhs *= rhs;
+
+  /* compute u by solving quadratic equation with the upwind */
+  /* neighbors in order of increasing value, stopping when   */
+  /* the next neighbor is not upwind of the solution         */
+  for (l = 0; l < num_upwind; l++) {
+    LSMLIB_REAL u_dir = u_upwind[order[l]];
+    LSMLIB_REAL inv_dx_sq = 1.0/dx[order[l]]/dx[order[l]];
+    LSMLIB_REAL discriminant;
+
+    if (u_dir >= u_updated) break;
+
+    u_A += inv_dx_sq;
+    u_B += inv_dx_sq*u_dir;
+    u_C += inv_dx_sq*u_dir*u_dir;
+    discriminant = u_B*u_B - u_A*(u_C - rhs);
+    if (discriminant < 0) break;
+    u_updated = (u_B + sqrt(discriminant))/u_A;
+  }
+
+  /* values beyond the cut-off are treated as unreached */
+  if (u_updated > fsm_data->max_value) return 0;
+
+  if (u_updated < u_cur) {
+    if (u_cur - u_updated > LSM_FSM_CONVERGENCE_TOL*u_updated) changed = 1;
+    u[idx] = u_updated;
+    u_cur = u_updated;
+  }
+
+  /* compute extension field values from the upwind neighbors */
+  /* used to compute the solution                             */
+  if (num_extension_fields > 0) {
+    LSMLIB_REAL weight[LSM_FSM_MAX_NDIM];
+    LSMLIB_REAL weight_sum = 0;
+    int num_used = 0;
+
+    for (l = 0; l < num_upwind; l++) {
+      int d = order[l];
+      if (u_upwind[d] >= u_cur) break;
+      weight[l] = (u_cur - u_upwind[d])/dx[d]/dx[d];
+      weight_sum += weight[l];
+      num_used++;
+    }
+
+    if (weight_sum > 0) {
+      for (m = 0; m < num_extension_fields; m++) {
+        LSMLIB_REAL *ext = extension_fields[m];
+        LSMLIB_REAL ext_updated = 0;
+        LSMLIB_REAL ext_change;
+
+        for (l = 0; l < num_used; l++) {
+          ext_updated += weight[l]*ext[idx_upwind[order[l]]];
+        }
+        ext_updated /= weight_sum;
+
+        ext_change = LSM_FMM_ABS(ext_updated - ext[idx]);
+        if (ext_change > LSM_FSM_CONVERGENCE_TOL*LSM_FMM_ABS(ext_updated)) {
+          changed = 1;
+        }
+        ext[idx] = ext_updated;
+      }
+    }
+  }
+
+  return changed;
+}
+
+
+static int FSM_sweep(
+  FSM_Data *fsm_data,
+  int *sweep_dir)
+{
+  int *grid_dims = fsm_data->grid_dims;
+  int *grid_stride = fsm_data->grid_stride;
+  unsigned char *status = fsm_data->status;
+  int num_changed = 0;
+  int grid_idx[LSM_FSM_MAX_NDIM];
+  int i, j, k;
+
+  for (k = 0; k < grid_dims[2]; k++) {
+    grid_idx[2] = (sweep_dir[2] > 0) ? k : grid_dims[2]-1-k;
+    for (j = 0; j < grid_dims[1]; j++) {
+      grid_idx[1] = (sweep_dir[1] > 0) ? j : grid_dims[1]-1-j;
+      for (i = 0; i < grid_dims[0]; i++) {
+        int idx;
+
+        grid_idx[0] = (sweep_dir[0] > 0) ? i : grid_dims[0]-1-i;
+        idx = grid_idx[0] + grid_idx[1]*grid_stride[1]
+            + grid_idx[2]*grid_stride[2];
+
+        if (LSM_FSM_FREE == status[idx]) {
+          num_changed += FSM_updateGridPoint(fsm_data, idx, grid_idx);
+        }
+      }
+    }
+  }
+
+  return num_changed;
+}
+
+
+#ifdef _OPENMP
+static int FSM_sweepHyperplanes(
+  FSM_Data *fsm_data,
+  int *sweep_dir)
+{
+  int *grid_dims = fsm_data->grid_dims;
+  int *grid_stride = fsm_data->grid_stride;
+  unsigned char *status = fsm_data->status;
+  int max_level = grid_dims[0] + grid_dims[1] + grid_dims[2] - 3;
+  int num_changed = 0;
+
+  /*
+   * grid points within a hyperplane are not neighbors of each other,
+   * so they may be updated concurrently, and every grid point sees the
+   * same upwind values as in the lexicographic ordering used by
+   * FSM_sweep().
+   */
+#pragma omp parallel reduction(+:num_changed)
+  {
+    int level, i;
+    for (level = 0; level <= max_level; level++) {
+      int i_lo = level - (grid_dims[1]-1) - (grid_dims[2]-1);
+      int i_hi = (level < grid_dims[0]-1) ? level : grid_dims[0]-1;
+      if (i_lo < 0) i_lo = 0;
+
+#pragma omp for schedule(static)
+      for (i = i_lo; i <= i_hi; i++) {
+        int grid_idx[LSM_FSM_MAX_NDIM];
+        int j, j_lo, j_hi;
+
+        j_lo = level - i - (grid_dims[2]-1);
+        if (j_lo < 0) j_lo = 0;
+        j_hi = (level - i < grid_dims[1]-1) ? level - i : grid_dims[1]-1;
+
+        grid_idx[0] = (sweep_dir[0] > 0) ? i : grid_dims[0]-1-i;
+        for (j = j_lo; j <= j_hi; j++) {
+          int k = level - i - j;
+          int idx;
+
+          grid_idx[1] = (sweep_dir[1] > 0) ? j : grid_dims[1]-1-j;
+          grid_idx[2] = (sweep_dir[2] > 0) ? k : grid_dims[2]-1-k;
+          idx = grid_idx[0] + grid_idx[1]*grid_stride[1]
+              + grid_idx[2]*grid_stride[2];
+
+          if (LSM_FSM_FREE == status[idx]) {
+            num_changed += FSM_updateGridPoint(fsm_data, idx, grid_idx);
+          }
+        }
+      }
+    }
+  }
+
+  return num_changed;
+}
+#endif
+
+
+static void FSM_iterate(FSM_Data *fsm_data)
+{
+  int num_sweeps = 1 << fsm_data->num_dims;
+  int iteration;
+
+#ifdef _OPENMP
+  /* the hyperplane ordering only pays off when there are multiple */
+  /* threads to share the work                                     */
+  int use_hyperplanes = (omp_get_max_threads() > 1);
+#endif
+
+  for (iteration = 0; iteration < LSM_FSM_MAX_ITERATIONS; iteration++) {
+    int num_changed = 0;
+    int sweep, dir;
+
+    for (sweep = 0; sweep < num_sweeps; sweep++) {
+      int sweep_dir[LSM_FSM_MAX_NDIM];
+      for (dir = 0; dir < LSM_FSM_MAX_NDIM; dir++) {
+        sweep_dir[dir] = ((sweep >> dir) & 1) ? -1 : 1;
+      }
+#ifdef _OPENMP
+      if (use_hyperplanes) {
+        num_changed += FSM_sweepHyperplanes(fsm_data, sweep_dir);
+        continue;
+      }
+#endif
+      num_changed += FSM_sweep(fsm_data, sweep_dir);
+    }
+
+    if (0 == num_changed) return;
+  }
+
+  fprintf(stderr,
+         "WARNING: fast sweeping method did not converge after %d\n",
+         LSM_FSM_MAX_ITERATIONS);
+  fprintf(stderr,
+         "         iterations.\n");
+}
@@ -0,0 +1,222 @@
+/*
+ * File:        lsm_fast_sweeping_method.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for 2D and 3D Fast Sweeping Method Algorithms
+ */
+
+#ifndef included_fast_sweeping_method_h
+#define included_fast_sweeping_method_h
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_fast_sweeping_method.h
+ *
+ * \brief
+ * @ref lsm_fast_sweeping_method.h provides a Gauss-Seidel fast
+ * sweeping method engine for the calculations supported by
+ * @ref lsm_fast_marching_method.h:  computing distance functions,
+ * extensions of field variables off of the zero contour of a level
+ * set function, and solving the Eikonal equation.
+ *
+ * The algorithm follows "A Fast Sweeping Method for Eikonal Equations"
+ * by H. Zhao (Math. Comp., vol 74, p 603-627, 2005).  Each iteration
+ * consists of 2^N Gauss-Seidel sweeps over the grid (one for each
+ * combination of sweep directions), and iterations are repeated until
+ * the solution stops changing.  When LSMLIB is configured with
+ * --enable-openmp and more than one thread is available, each sweep
+ * visits the grid one hyperplane (i+j+k = constant) at a time and the
+ * grid points within a hyperplane are updated concurrently, following
+ * "A Parallel Fast Sweeping Method for the Eikonal Equation" by
+ * M. Detrixhe, F. Gibou and C. Min (J. Comp. Phys, vol 237, p 46-55,
+ * 2013).
+ *
+ * The fast sweeping engine is normally used through the "WithEngine"
+ * drivers in @ref lsm_fast_marching_method.h (e.g. 
+ * computeDistanceFunctionWithEngine3d()), which take the engine as an
+ * argument.
+ *
+ *
+ * <h3> NOTES </h3>
+ * - The fast sweeping engine assumes that the field data are stored
+ *   in Fortran order (i.e. column-major order).
+ *
+ * - Error codes are the same as the ones for the fast marching
+ *   method (see @ref lsm_fast_marching_method.h).
+ *
+ * - Only a first-order accurate spatial discretization is supported.
+ *
+ * - Within a hyperplane, grid points do not depend on each other, so
+ *   the hyperplane ordering sees exactly the same upwind values as the
+ *   lexicographic ordering used by the serial sweeps.  The results
+ *   are therefore identical for any number of threads.
+ *
+ * - The number of iterations required for convergence grows with the
+ *   number of times the characteristics change direction (e.g. around
+ *   obstacles introduced by the mask or by a variable speed function).
+ *
+ * - Performance.  Single-threaded, the fast sweeping engine is SLOWER
+ *   than the fast marching method.  For the 3D problems in
+ *   examples/serial/fast_marching_method/benchmarkEikonalEngines
+ *   (sphere, N = 100-150, first-order, wall clock time), the fast 
+ *   sweeping engine takes 1.0-1.8x as long for the distance function, 
+ *   1.8-2.3x as long for the Eikonal equation and 2-5.5x as long for 
+ *   extension fields.  It can only be faster when it is run (with 
+ *   --enable-openmp) on at least that many otherwise idle cores; each
+ *   sweep synchronizes the threads once per hyperplane, so speedup is 
+ *   less than linear and small grids do not benefit.  Running more 
+ *   threads than cores makes it slower.  Use the fast marching method
+ *   unless benchmarkEikonalEngines shows a gain on the target machine.
+ *
+ * - Accuracy.  The two engines agree to round-off for the Eikonal 
+ *   equation and to about 3e-4 (dx = 0.02-0.04) for the distance 
+ *   function.  Extension fields can differ at the small number of grid
+ *   points where characteristics from different parts of the zero 
+ *   level set meet (e.g. near the center of a sphere), where the 
+ *   extended value depends on the update order:  in the benchmark, 
+ *   about 100 of 10^6 grid points differ by more than 5e-3, and the 
+ *   maximum difference is 4e-2 (N = 100) to 2e-1 (N = 50).
+ *
+ */
+
+
+/*!
+ * LSM_EikonalEngine is an enumerated type that selects the algorithm
+ * used by the "WithEngine" drivers in @ref lsm_fast_marching_method.h.
+ *
+ *  - LSM_EIKONAL_ENGINE_FAST_MARCHING:  heap-ordered fast marching
+ *                                       method (see @ref FMM_Core.h)
+ *  - LSM_EIKONAL_ENGINE_FAST_SWEEPING:  Gauss-Seidel fast sweeping
+ *                                       method
+ */
+typedef enum { LSM_EIKONAL_ENGINE_FAST_MARCHING,
+               LSM_EIKONAL_ENGINE_FAST_SWEEPING } LSM_EikonalEngine;
+
+
+/*!
+ * FSM_computeExtensionFields() uses the fast sweeping method to
+ * compute the distance function and extension fields from the original
+ * level set function, phi, and the specified source fields.
+ *
+ * Arguments:
+ *  - num_dims (in):                      number of spatial dimensions
+ *                                        (2 or 3)
+ *  - distance_function (out):            updated distance function
+ *  - extension_fields (out):             extension fields
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a
+ *                                        negative value.
+ *  - source_fields(in):                  source fields used to compute
+ *                                        extension fields
+ *  - extension_mask(in):                 extension velocities to
+ *                                        ignore when evaluating the
+ *                                        interface values; masked
+ *                                        grid points should be
+ *                                        negative
+ *  - num_extension_fields (in):          number of extension fields to compute
+ *  - spatial_discretization_order (in):  order of finite differences used
+ *                                        to compute spatial derivatives
+ *                                        (must be 1)
+ *  - max_distance (in):                  distance at which to cut off the
+ *                                        calculation (LSMLIB_REAL_MAX for
+ *                                        no cut-off)
+ *  - grid_dims (in):                     array of index space extents for all
+ *                                        fields
+ *  - dx (in):                            array of grid cell sizes in each
+ *                                        coordinate direction
+ *
+ * Return value:                          error code
+ *
+ *
+ * NOTES:
+ *  - The results follow the conventions of computeExtensionFields2d()
+ *    and computeExtensionFieldsWithCutoff2d():  grid points on or next
+ *    to the zero level set are initialized in the same way as the
+ *    first-order fast marching method, grid points that are masked
+ *    out are set to LSMLIB_REAL_MAX, and, when the calculation is cut
+ *    off, grid points farther than max_distance from the zero level
+ *    set have a distance function of +/- max_distance and extension
+ *    fields equal to zero.
+ *
+ *  - When there is no cut-off, grid points that cannot be reached from
+ *    the zero level set (e.g. because they are isolated by the mask)
+ *    are set to LSM_FMM_DEFAULT_UPDATE_VALUE, which is the value the
+ *    fast marching method leaves at these grid points.
+ *
+ */
+int FSM_computeExtensionFields(
+  int num_dims,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  LSMLIB_REAL max_distance,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * FSM_solveEikonalEquation() uses the fast sweeping method to solve
+ * the Eikonal equation
+ *
+ *   |grad(phi)| = 1/speed
+ *
+ * with the boundary data supplied in phi.
+ *
+ * Arguments:
+ *  - num_dims (in):                      number of spatial dimensions
+ *                                        (2 or 3)
+ *  - phi (in/out):                       pointer to solution to Eikonal
+ *                                        equation phi must be initialized
+ *                                        as specified in the NOTES below.
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used
+ *                                        to compute spatial derivatives
+ *                                        (must be 1)
+ *  - grid_dims (in):                     array of index space extents for all
+ *                                        fields
+ *  - dx (in):                            array of grid cell sizes in each
+ *                                        coordinate direction
+ *
+ * Return value:                          error code
+ *
+ * NOTES:
+ *  - phi must be initialized in the same way as for
+ *    solveEikonalEquation2d():  boundary values are non-negative and
+ *    all other grid points are set to a negative value.
+ *
+ *  - Grid points that are masked out, have a speed less than
+ *    LSMLIB_ZERO_TOL, or cannot be reached from the boundary are
+ *    set to LSMLIB_REAL_MAX.
+ *
+ */
+int FSM_solveEikonalEquation(
+  int num_dims,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -5,7 +5,8 @@
  *              (c) 2009 Kevin T. Chu.  All rights reserved.
  * Revision:    $Revision$
  * Modified:    $Date$
- * Description: Implementation file for file management functions (zipping etc.)
+ * Description: Implementation file for file management functions (zipping,
+ *              compressed I/O etc.)
  */
 
 #include <stdio.h>
@@ -14,6 +15,53 @@
 
 #include "lsm_file.h"
 
+#ifdef LSMLIB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LSMLIB_HAVE_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* size of the blocks compressed independently when writing .gz files */
+#define LSM_FILE_GZIP_BLOCK_SIZE   (1<<20)
+
+/* maximum number of bytes passed to a single zlib/libbz2 call */
+#define LSM_FILE_MAX_CHUNK         (1<<30)
+
+#define LSM_FILE_READ   0
+#define LSM_FILE_WRITE  1
+
+struct _LSM_File
+{
+  int    zip_status;   /* NO_ZIP, GZIP or BZIP2 */
+  int    mode;         /* LSM_FILE_READ or LSM_FILE_WRITE */
+  int    error;        /* nonzero if an I/O error has occurred */
+  
+  FILE  *fp;           /* uncompressed/compressed file or pipe */
+  int    is_pipe;      /* fp is a pipe from/to gzip or bzip2 */
+
+#ifdef LSMLIB_HAVE_ZLIB
+  gzFile gz;           /* zlib input stream */
+  
+  /* uncompressed data waiting to be compressed (num_blocks blocks) 
+     and space for the compressed blocks */
+  unsigned char  *block_in;
+  unsigned char  *block_out;
+  size_t         *block_out_size;
+  size_t          block_out_capacity;
+  size_t          num_in;
+  int             num_blocks;
+#endif
+
+#ifdef LSMLIB_HAVE_BZIP2
+  BZFILE *bz;          /* libbz2 input or output stream */
+  char    bz_unused[BZ_MAX_UNUSED];
+#endif
+};
+
 
 void checkUnzipFile(char *file_name,int *pzip_status, char **pfile_base)
 {
@@ -67,3 +115,427 @@ void  zipFile(char *file_base,int zip_status)
         system(command);
      }
 }
+
+
+/* 
+ * getZipStatus() determines the compression status of a file from its 
+ * extension in the same way as checkUnzipFile().
+ */
+static int getZipStatus(char *file_name)
+{
+  if( strstr(file_name,".gz") != (char *)NULL ) return GZIP;
+  if( strstr(file_name,".bz2") != (char *)NULL ) return BZIP2;
+  return NO_ZIP;
+}
+
+
+static LSM_File *allocateLSMFile(int zip_status, int mode)
+{
+  LSM_File *file = (LSM_File *)calloc(1,sizeof(LSM_File));
+  file->zip_status = zip_status;
+  file->mode = mode;
+  return file;
+}
+
+
+#if !defined(LSMLIB_HAVE_ZLIB) || !defined(LSMLIB_HAVE_BZIP2)
+/* 
+ * openPipe() opens a pipe from/to the external (de)compression program 
+ * when LSMLIB is not configured with the corresponding library.
+ */
+static FILE *openPipe(char *program, char *file_name, int mode)
+{
+  FILE *fp;
+  char *command = (char *)malloc((strlen(file_name)+32)*sizeof(char));
+
+  if (mode == LSM_FILE_READ)
+  {
+    sprintf(command,"%s -dc '%s'",program,file_name);
+    fp = popen(command,"r");
+  }
+  else
+  {
+    sprintf(command,"%s -c > '%s'",program,file_name);
+    fp = popen(command,"w");
+  }
+  free(command);
+  return fp;
+}
+#endif
+
+
+LSM_File *openLSMFileForReading(char *file_name)
+{
+  LSM_File *file;
+  int       zip_status = getZipStatus(file_name);
+
+  file = allocateLSMFile(zip_status,LSM_FILE_READ);
+
+  if( zip_status == GZIP )
+  {
+#ifdef LSMLIB_HAVE_ZLIB
+    file->gz = gzopen(file_name,"rb");
+    if (file->gz == NULL)
+    {
+      free(file);
+      return NULL;
+    }
+    gzbuffer(file->gz,LSM_FILE_GZIP_BLOCK_SIZE/4);
+    return file;
+#else
+    /* check that the file exists before starting gzip */
+    file->fp = fopen(file_name,"rb");
+    if (file->fp != NULL)
+    {
+      fclose(file->fp);
+      file->fp = openPipe("gzip",file_name,LSM_FILE_READ);
+      file->is_pipe = 1;
+    }
+#endif
+  }
+  else if( zip_status == BZIP2 )
+  {
+    file->fp = fopen(file_name,"rb");
+#ifdef LSMLIB_HAVE_BZIP2
+    if (file->fp != NULL)
+    {
+      int bz_error;
+      file->bz = BZ2_bzReadOpen(&bz_error,file->fp,0,0,NULL,0);
+      if (bz_error != BZ_OK)
+      {
+        BZ2_bzReadClose(&bz_error,file->bz);
+        fclose(file->fp);
+        file->fp = NULL;
+      }
+    }
+#else
+    if (file->fp != NULL)
+    {
+      fclose(file->fp);
+      file->fp = openPipe("bzip2",file_name,LSM_FILE_READ);
+      file->is_pipe = 1;
+    }
+#endif
+  }
+  else
+  {
+    file->fp = fopen(file_name,"rb");
+  }
+
+  if (file->fp == NULL) 
+  {
+    free(file);
+    return NULL;
+  }
+  return file;
+}
+
+
+LSM_File *openLSMFileForWriting(char *file_name, int zip_status)
+{
+  LSM_File *file;
+  char     *full_name;
+
+  full_name = (char *)malloc((strlen(file_name)+5)*sizeof(char));
+  strcpy(full_name,file_name);
+  if (zip_status == GZIP) 
+    strcat(full_name,".gz");
+  else if (zip_status == BZIP2) 
+    strcat(full_name,".bz2");
+  else
+    zip_status = NO_ZIP;
+
+  file = allocateLSMFile(zip_status,LSM_FILE_WRITE);
+
+  if( zip_status == GZIP )
+  {
+#ifdef LSMLIB_HAVE_ZLIB
+    file->fp = fopen(full_name,"wb");
+    if (file->fp != NULL)
+    {
+      file->num_blocks = 1;
+#ifdef _OPENMP
+      file->num_blocks = omp_get_max_threads();
+#endif
+      /* gzip wrapper adds 12 more bytes than the zlib wrapper */
+      file->block_out_capacity = compressBound(LSM_FILE_GZIP_BLOCK_SIZE)+12;
+      file->block_in = (unsigned char *)malloc(
+        (size_t)file->num_blocks*LSM_FILE_GZIP_BLOCK_SIZE);
+      file->block_out = (unsigned char *)malloc(
+        (size_t)file->num_blocks*file->block_out_capacity);
+      file->block_out_size = (size_t *)malloc(
+        (size_t)file->num_blocks*sizeof(size_t));
+    }
+#else
+    file->fp = openPipe("gzip",full_name,LSM_FILE_WRITE);
+    file->is_pipe = 1;
+#endif
+  }
+  else if( zip_status == BZIP2 )
+  {
+#ifdef LSMLIB_HAVE_BZIP2
+    file->fp = fopen(full_name,"wb");
+    if (file->fp != NULL)
+    {
+      int bz_error;
+      file->bz = BZ2_bzWriteOpen(&bz_error,file->fp,9,0,0);
+      if (bz_error != BZ_OK)
+      {
+        BZ2_bzWriteClose(&bz_error,file->bz,1,NULL,NULL);
+        fclose(file->fp);
+        file->fp = NULL;
+      }
+    }
+#else
+    file->fp = openPipe("bzip2",full_name,LSM_FILE_WRITE);
+    file->is_pipe = 1;
+#endif
+  }
+  else
+  {
+    file->fp = fopen(full_name,"wb");
+  }
+
+  free(full_name);
+  if (file->fp == NULL) 
+  {
+    free(file);
+    return NULL;
+  }
+  return file;
+}
+
+
+#ifdef LSMLIB_HAVE_ZLIB
+/*
+ * compressGzipBlocks() compresses the buffered data as independent gzip 
+ * members (in parallel if OpenMP is enabled) and writes them to the file
+ * in order.  Concatenated gzip members form a valid .gz file.
+ */
+static void compressGzipBlocks(LSM_File *file)
+{
+  int num_blocks = (int)((file->num_in + LSM_FILE_GZIP_BLOCK_SIZE - 1)
+                   / LSM_FILE_GZIP_BLOCK_SIZE);
+  int error = 0;
+  int b;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1) reduction(+:error)
+#endif
+  for (b = 0; b < num_blocks; b++)
+  {
+    z_stream strm;
+    size_t   offset = (size_t)b*LSM_FILE_GZIP_BLOCK_SIZE;
+    size_t   num_bytes = file->num_in - offset;
+    if (num_bytes > LSM_FILE_GZIP_BLOCK_SIZE) 
+      num_bytes = LSM_FILE_GZIP_BLOCK_SIZE;
+
+    memset(&strm,0,sizeof(z_stream));
+    if (deflateInit2(&strm,Z_DEFAULT_COMPRESSION,Z_DEFLATED,15+16,8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      error++;
+      file->block_out_size[b] = 0;
+      continue;
+    }
+    strm.next_in = file->block_in + offset;
+    strm.avail_in = (uInt)num_bytes;
+    strm.next_out = file->block_out + (size_t)b*file->block_out_capacity;
+    strm.avail_out = (uInt)file->block_out_capacity;
+    if (deflate(&strm,Z_FINISH) != Z_STREAM_END) error++;
+    file->block_out_size[b] = file->block_out_capacity - strm.avail_out;
+    deflateEnd(&strm);
+  }
+
+  for (b = 0; b < num_blocks; b++)
+  {
+    if (fwrite(file->block_out + (size_t)b*file->block_out_capacity, 1,
+               file->block_out_size[b], file->fp) != file->block_out_size[b])
+      error++;
+  }
+
+  if (error) file->error = 1;
+  file->num_in = 0;
+}
+#endif
+
+
+size_t readLSMFile(void *data, size_t size, size_t num_items, LSM_File *file)
+{
+  size_t num_bytes = size*num_items;
+  size_t num_read = 0;
+
+  if (num_bytes == 0) return 0;
+
+#ifdef LSMLIB_HAVE_ZLIB
+  if (file->gz != NULL)
+  {
+    while (num_read < num_bytes)
+    {
+      size_t chunk = num_bytes - num_read;
+      int    n;
+      if (chunk > LSM_FILE_MAX_CHUNK) chunk = LSM_FILE_MAX_CHUNK;
+      n = gzread(file->gz,(char *)data + num_read,(unsigned)chunk);
+      if (n <= 0) 
+      {
+        if (n < 0) file->error = 1;
+        break;
+      }
+      num_read += n;
+    }
+    return num_read/size;
+  }
+#endif
+
+#ifdef LSMLIB_HAVE_BZIP2
+  if (file->zip_status == BZIP2)
+  {
+    /* NOTE: files written by parallel bzip2 compressors consist of
+       several concatenated streams, so a new stream is opened with the
+       unused input when the end of a stream is reached */
+    while ( (num_read < num_bytes) && (file->bz != NULL) )
+    {
+      size_t chunk = num_bytes - num_read;
+      int    bz_error, n;
+      if (chunk > LSM_FILE_MAX_CHUNK) chunk = LSM_FILE_MAX_CHUNK;
+      n = BZ2_bzRead(&bz_error,file->bz,(char *)data + num_read,(int)chunk);
+      if ( (bz_error == BZ_OK) || (bz_error == BZ_STREAM_END) )
+        num_read += n;
+
+      if (bz_error == BZ_STREAM_END)
+      {
+        void *unused;
+        int   num_unused;
+        BZ2_bzReadGetUnused(&bz_error,file->bz,&unused,&num_unused);
+        memcpy(file->bz_unused,unused,num_unused);
+        BZ2_bzReadClose(&bz_error,file->bz);
+        file->bz = NULL;
+        if ( (num_unused > 0) || (!feof(file->fp)) )
+        {
+          file->bz = BZ2_bzReadOpen(&bz_error,file->fp,0,0,
+                                    file->bz_unused,num_unused);
+          if (bz_error != BZ_OK)
+          {
+            BZ2_bzReadClose(&bz_error,file->bz);
+            file->bz = NULL;
+          }
+        }
+      }
+      else if (bz_error != BZ_OK)
+      {
+        file->error = 1;
+        break;
+      }
+    }
+    return num_read/size;
+  }
+#endif
+
+  return fread(data,size,num_items,file->fp);
+}
+
+
+size_t writeLSMFile(const void *data, size_t size, size_t num_items, 
+                    LSM_File *file)
+{
+  size_t num_bytes = size*num_items;
+
+  if (num_bytes == 0) return 0;
+
+#ifdef LSMLIB_HAVE_ZLIB
+  if (file->block_in != NULL)
+  {
+    const size_t buffer_size = 
+      (size_t)file->num_blocks*LSM_FILE_GZIP_BLOCK_SIZE;
+    size_t num_written = 0;
+    while (num_written < num_bytes)
+    {
+      size_t chunk = buffer_size - file->num_in;
+      if (chunk > num_bytes - num_written) chunk = num_bytes - num_written;
+      memcpy(file->block_in + file->num_in,
+             (const char *)data + num_written, chunk);
+      file->num_in += chunk;
+      num_written += chunk;
+      if (file->num_in == buffer_size) compressGzipBlocks(file);
+    }
+    return (file->error ? 0 : num_items);
+  }
+#endif
+
+#ifdef LSMLIB_HAVE_BZIP2
+  if (file->bz != NULL)
+  {
+    size_t num_written = 0;
+    while (num_written < num_bytes)
+    {
+      size_t chunk = num_bytes - num_written;
+      int    bz_error;
+      if (chunk > LSM_FILE_MAX_CHUNK) chunk = LSM_FILE_MAX_CHUNK;
+      BZ2_bzWrite(&bz_error,file->bz,(char *)data + num_written,(int)chunk);
+      if (bz_error != BZ_OK) 
+      {
+        file->error = 1;
+        break;
+      }
+      num_written += chunk;
+    }
+    return num_written/size;
+  }
+#endif
+
+  return fwrite(data,size,num_items,file->fp);
+}
+
+
+int closeLSMFile(LSM_File *file)
+{
+  int error;
+
+  if (file == NULL) return 1;
+
+#ifdef LSMLIB_HAVE_ZLIB
+  if (file->gz != NULL)
+  {
+    if (gzclose(file->gz) != Z_OK) file->error = 1;
+  }
+  if (file->block_in != NULL)
+  {
+    if (file->num_in > 0) compressGzipBlocks(file);
+    free(file->block_in);
+    free(file->block_out);
+    free(file->block_out_size);
+  }
+#endif
+
+#ifdef LSMLIB_HAVE_BZIP2
+  if (file->bz != NULL)
+  {
+    int bz_error;
+    if (file->mode == LSM_FILE_READ)
+    {
+      BZ2_bzReadClose(&bz_error,file->bz);
+    }
+    else
+    {
+      BZ2_bzWriteClose(&bz_error,file->bz,0,NULL,NULL);
+      if (bz_error != BZ_OK) file->error = 1;
+    }
+  }
+#endif
+
+  if (file->fp != NULL)
+  {
+    if (file->is_pipe)
+    {
+      if (pclose(file->fp) != 0) file->error = 1;
+    }
+    else
+    {
+      if (fclose(file->fp) != 0) file->error = 1;
+    }
+  }
+
+  error = file->error;
+  free(file);
+  return error;
+}
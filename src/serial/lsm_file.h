@@ -5,18 +5,25 @@
  *              (c) 2009 Kevin T. Chu.  All rights reserved.
  * Revision:    $Revision$
  * Modified:    $Date$
- * Description: Routines for checking if file management (zipping etc.)
+ * Description: Routines for file management (zipping, compressed I/O etc.)
  */
 
 #ifndef included_lsm_file_h
 #define included_lsm_file_h
 
+#include <stddef.h>
 #include "LSMLIB_config.h"
 
 #define NO_ZIP 0
 #define GZIP   1
 #define BZIP2  2
 
+/*!
+ * LSM_File is an opaque handle for a (possibly compressed) file that is
+ * read or written as a stream by readLSMFile() and writeLSMFile().
+ */
+typedef struct _LSM_File LSM_File;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -58,6 +65,93 @@ void checkUnzipFile(char *file_name,int *pzip_status,char **pfile_base);
  */        
 void   zipFile(char *file_base,int zip_status);
 
+/*!
+ * openLSMFileForReading() opens a file for streaming input.  Files with 
+ *   a .gz or .bz2 extension are decompressed on the fly as they are read;
+ *   the file itself is not modified.
+ *
+ *   Arguments:
+ *    - file_name(in):     name of the file
+ *
+ *  Return value:          handle for the open file (NULL if the file could
+ *                         not be opened)
+ *
+ *  Notes: 
+ *     - When LSMLIB is configured with zlib (libbz2), .gz (.bz2) files are
+ *       decompressed in-process.  Otherwise the data is read through a 
+ *       pipe from gzip (bzip2), so no uncompressed copy of the file is 
+ *       written to disk in either case.
+ *
+ */        
+LSM_File *openLSMFileForReading(char *file_name);
+
+/*!
+ * openLSMFileForWriting() opens a file for streaming output.  The data 
+ *   is compressed on the fly as it is written.
+ *
+ *   Arguments:
+ *    - file_name(in):     name of the file (without compression extension)
+ *    - zip_status(in):    integer compression status of the file 
+ *                         (NO_ZIP,GZIP,BZIP2); the extension .gz (.bz2) is
+ *                         appended to file_name for GZIP (BZIP2)
+ *
+ *  Return value:          handle for the open file (NULL if the file could
+ *                         not be opened)
+ *
+ *  Notes: 
+ *     - With zlib, GZIP data is compressed in independent blocks (gzip 
+ *       members) of LSM_FILE_GZIP_BLOCK_SIZE bytes.  If LSMLIB is 
+ *       configured with --enable-openmp, the blocks are compressed in 
+ *       parallel.  The result is a standard .gz file that can be read 
+ *       by gunzip.
+ *
+ */        
+LSM_File *openLSMFileForWriting(char *file_name, int zip_status);
+
+/*!
+ * readLSMFile() reads num_items items of the given size from the file 
+ *   (same semantics as fread()).
+ *
+ *   Arguments:
+ *    - data(out):         buffer to read the data into
+ *    - size(in):          size of each item in bytes
+ *    - num_items(in):     number of items to read
+ *    - file(in):          file opened by openLSMFileForReading()
+ *
+ *  Return value:          number of items read
+ *
+ */        
+size_t readLSMFile(void *data, size_t size, size_t num_items, LSM_File *file);
+
+/*!
+ * writeLSMFile() writes num_items items of the given size to the file 
+ *   (same semantics as fwrite()).
+ *
+ *   Arguments:
+ *    - data(in):          data to write
+ *    - size(in):          size of each item in bytes
+ *    - num_items(in):     number of items to write
+ *    - file(in):          file opened by openLSMFileForWriting()
+ *
+ *  Return value:          number of items written
+ *
+ */        
+size_t writeLSMFile(const void *data, size_t size, size_t num_items, 
+                    LSM_File *file);
+
+/*!
+ * closeLSMFile() flushes any buffered data, closes the file and frees 
+ *   the file handle.
+ *
+ *   Arguments:
+ *    - file(in):          file to close
+ *
+ *  Return value:          0 on success, nonzero if an error occurred
+ *                         while reading or writing the file
+ *
+ */        
+int closeLSMFile(LSM_File *file);
+
 #ifdef __cplusplus
 }
 #endif
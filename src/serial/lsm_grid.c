@@ -309,6 +309,11 @@ Grid *copyGrid(Grid *grid)
    new_grid->beta = grid->beta;
    new_grid->gamma = grid->gamma;
    
+   for(i = 0; i < 3; i++)
+   {
+       new_grid->block_dims[i] = grid->block_dims[i];
+   }
+   
    return new_grid;
 }
 
@@ -612,151 +617,149 @@ void writeGridToAsciiFile(Grid *grid, char *file_name, int zip_status)
 
 void writeGridToBinaryFile(Grid *grid, char *file_name, int zip_status)
 {
-  FILE *fp;
+  LSM_File *fp;
     
-  fp = fopen(file_name,"w");
-
-  fwrite(&(grid->num_dims), sizeof(int), 1, fp);
-  fwrite(grid->x_lo, sizeof(LSMLIB_REAL), 3, fp);
-  fwrite(grid->x_hi, sizeof(LSMLIB_REAL), 3, fp);
-  fwrite(grid->x_lo_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
-  fwrite(grid->x_hi_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
-  fwrite(grid->grid_dims, sizeof(int), 3, fp); 
-  fwrite(grid->grid_dims_ghostbox, sizeof(int), 3, fp); 
-  fwrite(grid->dx, sizeof(LSMLIB_REAL), 3, fp);
-  fwrite(&(grid->num_gridpts), sizeof(int), 1, fp);
-
-  fwrite(&(grid->ilo_gb), sizeof(int), 1, fp);
-  fwrite(&(grid->ihi_gb), sizeof(int), 1, fp);
-  fwrite(&(grid->jlo_gb), sizeof(int), 1, fp);
-  fwrite(&(grid->jhi_gb), sizeof(int), 1, fp);  
-  fwrite(&(grid->klo_gb), sizeof(int), 1, fp);
-  fwrite(&(grid->khi_gb), sizeof(int), 1, fp);
+  fp = openLSMFileForWriting(file_name,zip_status);
+  if( fp == NULL )
+  {
+    printf("\nCould not open file %s",file_name);
+    return;
+  }
+
+  writeLSMFile(&(grid->num_dims), sizeof(int), 1, fp);
+  writeLSMFile(grid->x_lo, sizeof(LSMLIB_REAL), 3, fp);
+  writeLSMFile(grid->x_hi, sizeof(LSMLIB_REAL), 3, fp);
+  writeLSMFile(grid->x_lo_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
+  writeLSMFile(grid->x_hi_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
+  writeLSMFile(grid->grid_dims, sizeof(int), 3, fp); 
+  writeLSMFile(grid->grid_dims_ghostbox, sizeof(int), 3, fp); 
+  writeLSMFile(grid->dx, sizeof(LSMLIB_REAL), 3, fp);
+  writeLSMFile(&(grid->num_gridpts), sizeof(int), 1, fp);
+
+  writeLSMFile(&(grid->ilo_gb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ihi_gb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jlo_gb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jhi_gb), sizeof(int), 1, fp);  
+  writeLSMFile(&(grid->klo_gb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->khi_gb), sizeof(int), 1, fp);
  
-  fwrite(&(grid->ilo_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->ihi_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jlo_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jhi_fb), sizeof(int), 1, fp);  
-  fwrite(&(grid->klo_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->khi_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ilo_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ihi_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jlo_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jhi_fb), sizeof(int), 1, fp);  
+  writeLSMFile(&(grid->klo_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->khi_fb), sizeof(int), 1, fp);
   
-  fwrite(&(grid->ilo_D1_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->ihi_D1_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jlo_D1_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jhi_D1_fb), sizeof(int), 1, fp);  
-  fwrite(&(grid->klo_D1_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->khi_D1_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ilo_D1_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ihi_D1_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jlo_D1_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jhi_D1_fb), sizeof(int), 1, fp);  
+  writeLSMFile(&(grid->klo_D1_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->khi_D1_fb), sizeof(int), 1, fp);
   
-  fwrite(&(grid->ilo_D2_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->ihi_D2_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jlo_D2_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jhi_D2_fb), sizeof(int), 1, fp);  
-  fwrite(&(grid->klo_D2_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->khi_D2_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ilo_D2_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ihi_D2_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jlo_D2_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jhi_D2_fb), sizeof(int), 1, fp);  
+  writeLSMFile(&(grid->klo_D2_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->khi_D2_fb), sizeof(int), 1, fp);
   
-  fwrite(&(grid->ilo_D3_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->ihi_D3_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jlo_D3_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->jhi_D3_fb), sizeof(int), 1, fp);  
-  fwrite(&(grid->klo_D3_fb), sizeof(int), 1, fp);
-  fwrite(&(grid->khi_D3_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ilo_D3_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->ihi_D3_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jlo_D3_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->jhi_D3_fb), sizeof(int), 1, fp);  
+  writeLSMFile(&(grid->klo_D3_fb), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->khi_D3_fb), sizeof(int), 1, fp);
   
-  fwrite(&(grid->num_nb_levels), sizeof(int), 1, fp);
-  fwrite(&(grid->mark_gb), sizeof(unsigned char), 1, fp);
-  fwrite(&(grid->mark_D1), sizeof(unsigned char), 1, fp);
-  fwrite(&(grid->mark_D2), sizeof(unsigned char), 1, fp);
-  fwrite(&(grid->mark_D3), sizeof(unsigned char), 1, fp);
-  fwrite(&(grid->mark_fb), sizeof(unsigned char), 1, fp);
+  writeLSMFile(&(grid->num_nb_levels), sizeof(int), 1, fp);
+  writeLSMFile(&(grid->mark_gb), sizeof(unsigned char), 1, fp);
+  writeLSMFile(&(grid->mark_D1), sizeof(unsigned char), 1, fp);
+  writeLSMFile(&(grid->mark_D2), sizeof(unsigned char), 1, fp);
+  writeLSMFile(&(grid->mark_D3), sizeof(unsigned char), 1, fp);
+  writeLSMFile(&(grid->mark_fb), sizeof(unsigned char), 1, fp);
   
-  fwrite(&(grid->beta),   sizeof(LSMLIB_REAL), 1, fp);
-  fwrite(&(grid->gamma),  sizeof(LSMLIB_REAL), 1, fp);
+  writeLSMFile(&(grid->beta),   sizeof(LSMLIB_REAL), 1, fp);
+  writeLSMFile(&(grid->gamma),  sizeof(LSMLIB_REAL), 1, fp);
   
-  fclose(fp);
-  zipFile(file_name,zip_status);
+  closeLSMFile(fp);
 }
 
 
 Grid *readGridFromBinaryFile(char *file_name)
 {
-  FILE *fp;
+  LSM_File *fp;
   Grid *grid;
-  char   *file_base;
-  int    zip_status;
    
-  checkUnzipFile(file_name,&zip_status,&file_base);
-  
- /* open file and allocate Grid */
-  fp = fopen(file_base,"r");
+ /* open file (decompressing on the fly if needed) and allocate Grid */
+  fp = openLSMFileForReading(file_name);
   grid = allocateGrid();
  
   if( fp != NULL)
   {
-    fread(&(grid->num_dims), sizeof(int), 1, fp);
+    readLSMFile(&(grid->num_dims), sizeof(int), 1, fp);
     
-    fread(grid->x_lo, sizeof(LSMLIB_REAL), 3, fp);
-    fread(grid->x_hi, sizeof(LSMLIB_REAL), 3, fp);
-    fread(grid->x_lo_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
-    fread(grid->x_hi_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
+    readLSMFile(grid->x_lo, sizeof(LSMLIB_REAL), 3, fp);
+    readLSMFile(grid->x_hi, sizeof(LSMLIB_REAL), 3, fp);
+    readLSMFile(grid->x_lo_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
+    readLSMFile(grid->x_hi_ghostbox, sizeof(LSMLIB_REAL), 3, fp);
     
-    fread(grid->grid_dims, sizeof(int), 3, fp); 
-    fread(grid->grid_dims_ghostbox, sizeof(int), 3, fp);
+    readLSMFile(grid->grid_dims, sizeof(int), 3, fp); 
+    readLSMFile(grid->grid_dims_ghostbox, sizeof(int), 3, fp);
      
-    fread(grid->dx, sizeof(LSMLIB_REAL), 3, fp);
+    readLSMFile(grid->dx, sizeof(LSMLIB_REAL), 3, fp);
     
-    fread(&(grid->num_gridpts), sizeof(int), 1, fp);
-
-    fread(&(grid->ilo_gb), sizeof(int), 1, fp);
-    fread(&(grid->ihi_gb), sizeof(int), 1, fp);
-    fread(&(grid->jlo_gb), sizeof(int), 1, fp);
-    fread(&(grid->jhi_gb), sizeof(int), 1, fp);  
-    fread(&(grid->klo_gb), sizeof(int), 1, fp);
-    fread(&(grid->khi_gb), sizeof(int), 1, fp);
-
-    fread(&(grid->ilo_fb), sizeof(int), 1, fp);
-    fread(&(grid->ihi_fb), sizeof(int), 1, fp);
-    fread(&(grid->jlo_fb), sizeof(int), 1, fp);
-    fread(&(grid->jhi_fb), sizeof(int), 1, fp);  
-    fread(&(grid->klo_fb), sizeof(int), 1, fp);
-    fread(&(grid->khi_fb), sizeof(int), 1, fp);
-
-    fread(&(grid->ilo_D1_fb), sizeof(int), 1, fp);
-    fread(&(grid->ihi_D1_fb), sizeof(int), 1, fp);
-    fread(&(grid->jlo_D1_fb), sizeof(int), 1, fp);
-    fread(&(grid->jhi_D1_fb), sizeof(int), 1, fp);  
-    fread(&(grid->klo_D1_fb), sizeof(int), 1, fp);
-    fread(&(grid->khi_D1_fb), sizeof(int), 1, fp);
-
-    fread(&(grid->ilo_D2_fb), sizeof(int), 1, fp);
-    fread(&(grid->ihi_D2_fb), sizeof(int), 1, fp);
-    fread(&(grid->jlo_D2_fb), sizeof(int), 1, fp);
-    fread(&(grid->jhi_D2_fb), sizeof(int), 1, fp);  
-    fread(&(grid->klo_D2_fb), sizeof(int), 1, fp);
-    fread(&(grid->khi_D2_fb), sizeof(int), 1, fp);
-
-    fread(&(grid->ilo_D3_fb), sizeof(int), 1, fp);
-    fread(&(grid->ihi_D3_fb), sizeof(int), 1, fp);
-    fread(&(grid->jlo_D3_fb), sizeof(int), 1, fp);
-    fread(&(grid->jhi_D3_fb), sizeof(int), 1, fp);  
-    fread(&(grid->klo_D3_fb), sizeof(int), 1, fp);
-    fread(&(grid->khi_D3_fb), sizeof(int), 1, fp);
-
-    fread(&(grid->num_nb_levels), sizeof(int), 1, fp);
-    fread(&(grid->mark_gb), sizeof(unsigned char), 1, fp);
-    fread(&(grid->mark_D1), sizeof(unsigned char), 1, fp);
-    fread(&(grid->mark_D2), sizeof(unsigned char), 1, fp);
-    fread(&(grid->mark_D3), sizeof(unsigned char), 1, fp);
-    fread(&(grid->mark_fb), sizeof(unsigned char), 1, fp);
-
-    fread(&(grid->beta),   sizeof(LSMLIB_REAL), 1, fp);
-    fread(&(grid->gamma),  sizeof(LSMLIB_REAL), 1, fp);
-
-    fclose(fp);
-    zipFile(file_base,zip_status);
-    free(file_base);
+    readLSMFile(&(grid->num_gridpts), sizeof(int), 1, fp);
+
+    readLSMFile(&(grid->ilo_gb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->ihi_gb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jlo_gb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jhi_gb), sizeof(int), 1, fp);  
+    readLSMFile(&(grid->klo_gb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->khi_gb), sizeof(int), 1, fp);
+
+    readLSMFile(&(grid->ilo_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->ihi_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jlo_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jhi_fb), sizeof(int), 1, fp);  
+    readLSMFile(&(grid->klo_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->khi_fb), sizeof(int), 1, fp);
+
+    readLSMFile(&(grid->ilo_D1_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->ihi_D1_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jlo_D1_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jhi_D1_fb), sizeof(int), 1, fp);  
+    readLSMFile(&(grid->klo_D1_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->khi_D1_fb), sizeof(int), 1, fp);
+
+    readLSMFile(&(grid->ilo_D2_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->ihi_D2_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jlo_D2_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jhi_D2_fb), sizeof(int), 1, fp);  
+    readLSMFile(&(grid->klo_D2_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->khi_D2_fb), sizeof(int), 1, fp);
+
+    readLSMFile(&(grid->ilo_D3_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->ihi_D3_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jlo_D3_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->jhi_D3_fb), sizeof(int), 1, fp);  
+    readLSMFile(&(grid->klo_D3_fb), sizeof(int), 1, fp);
+    readLSMFile(&(grid->khi_D3_fb), sizeof(int), 1, fp);
+
+    readLSMFile(&(grid->num_nb_levels), sizeof(int), 1, fp);
+    readLSMFile(&(grid->mark_gb), sizeof(unsigned char), 1, fp);
+    readLSMFile(&(grid->mark_D1), sizeof(unsigned char), 1, fp);
+    readLSMFile(&(grid->mark_D2), sizeof(unsigned char), 1, fp);
+    readLSMFile(&(grid->mark_D3), sizeof(unsigned char), 1, fp);
+    readLSMFile(&(grid->mark_fb), sizeof(unsigned char), 1, fp);
+
+    readLSMFile(&(grid->beta),   sizeof(LSMLIB_REAL), 1, fp);
+    readLSMFile(&(grid->gamma),  sizeof(LSMLIB_REAL), 1, fp);
+
+    closeLSMFile(fp);
   }
   else
   {
-      printf("\nCould not open file %s",file_base);
+      printf("\nCould not open file %s",file_name);
   }
   return grid;
 }
@@ -1033,3 +1036,124 @@ void setIndexSpaceLimits(LSMLIB_SPATIAL_DERIVATIVE_ACCURACY_TYPE accuracy,
   }
 }
 
+
+/*================= Cache blocking ==================*/
+
+/* number of blocks of the fillbox in coordinate direction dim */
+static int getGridNumBlocksInDirection(Grid *grid, int dim)
+{
+  int *fb = &(grid->ilo_fb);
+  int n = fb[2*dim+1] - fb[2*dim] + 1;
+  
+  if( (dim >= grid->num_dims) || (grid->block_dims[dim] <= 0) || (n <= 0) )
+    return 1;
+  return (n + grid->block_dims[dim] - 1)/grid->block_dims[dim];
+}
+
+
+void setGridBlockDims(Grid *grid, int *block_dims)
+{
+  int dim;
+  
+  for(dim = 0; dim < 3; dim++)
+  {
+    grid->block_dims[dim] = (dim < grid->num_dims) ? block_dims[dim] : 0;
+    if( grid->block_dims[dim] < 0 ) grid->block_dims[dim] = 0;
+  }
+}
+
+
+int getGridNumBlocks(Grid *grid)
+{
+  return getGridNumBlocksInDirection(grid,0)
+       * getGridNumBlocksInDirection(grid,1)
+       * getGridNumBlocksInDirection(grid,2);
+}
+
+
+void getGridBlock(Grid *grid, int block, Grid *block_grid)
+{
+  int   *fb, *grid_box[4], *block_box[4];
+  int   lo[3], hi[3], nb, b, dim;
+  
+  *block_grid = *grid;
+  
+  /* fillbox of the block; the boxes are stored as 
+     (ilo, ihi, jlo, jhi, klo, khi) in the Grid structure */
+  fb = &(grid->ilo_fb);
+  for(dim = 0; dim < 3; dim++)
+  {
+    nb = getGridNumBlocksInDirection(grid,dim);
+    b = block % nb;
+    block /= nb;
+    
+    if( nb == 1 )
+    {
+      lo[dim] = fb[2*dim];  hi[dim] = fb[2*dim+1];
+    }
+    else
+    {
+      lo[dim] = fb[2*dim] + b*grid->block_dims[dim];
+      hi[dim] = lo[dim] + grid->block_dims[dim] - 1;
+      if( hi[dim] > fb[2*dim+1] ) hi[dim] = fb[2*dim+1];
+    }
+  }
+  
+  /* fillbox and fillboxes for undivided differences */
+  grid_box[0] = &(grid->ilo_fb);     block_box[0] = &(block_grid->ilo_fb);
+  grid_box[1] = &(grid->ilo_D1_fb);  block_box[1] = &(block_grid->ilo_D1_fb);
+  grid_box[2] = &(grid->ilo_D2_fb);  block_box[2] = &(block_grid->ilo_D2_fb);
+  grid_box[3] = &(grid->ilo_D3_fb);  block_box[3] = &(block_grid->ilo_D3_fb);
+  
+  for(b = 0; b < 4; b++)
+  {
+    for(dim = 0; dim < grid->num_dims; dim++)
+    {
+      block_box[b][2*dim]   = lo[dim] - (fb[2*dim] - grid_box[b][2*dim]);
+      block_box[b][2*dim+1] = hi[dim] + (grid_box[b][2*dim+1] - fb[2*dim+1]);
+    }
+  }
+}
+
+
+int getGridBlockScratchSize(Grid *grid)
+{
+  int *gb = &(grid->ilo_gb), *fb = &(grid->ilo_fb);
+  int n_gb, n_fb, size = 1, dim;
+  
+  for(dim = 0; dim < 3; dim++)
+  {
+    n_gb = gb[2*dim+1] - gb[2*dim] + 1;
+    n_fb = fb[2*dim+1] - fb[2*dim] + 1;
+    
+    if( (dim < grid->num_dims) && (grid->block_dims[dim] > 0) && 
+        (grid->block_dims[dim] < n_fb) )
+      size *= n_gb - n_fb + grid->block_dims[dim];
+    else
+      size *= n_gb;
+  }
+  
+  return size;
+}
+
+
+void getGridBlockScratchBox(Grid *grid, Grid *block_grid, int *scratch_box)
+{
+  int *gb = &(grid->ilo_gb), *fb = &(grid->ilo_fb);
+  int *block_fb = &(block_grid->ilo_fb);
+  int dim;
+  
+  for(dim = 0; dim < 3; dim++)
+  {
+    if( dim < grid->num_dims )
+    {
+      scratch_box[2*dim]   = block_fb[2*dim] - (fb[2*dim] - gb[2*dim]);
+      scratch_box[2*dim+1] = block_fb[2*dim+1] + (gb[2*dim+1] - fb[2*dim+1]);
+    }
+    else
+    {
+      scratch_box[2*dim]   = gb[2*dim];
+      scratch_box[2*dim+1] = gb[2*dim+1];
+    }
+  }
+}
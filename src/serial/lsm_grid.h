@@ -91,6 +91,10 @@ typedef struct _Grid {
   /* inner and outer narrow band widths (local method) */
   LSMLIB_REAL beta, gamma;
   
+  /* number of grid cells in each coordinate direction of the blocks */
+  /* used to traverse the fillbox in cache-blocked loops             */
+  /* (0 = no blocking in that direction; see setGridBlockDims())     */
+  int  block_dims[3];
   
 } Grid;
  
@@ -330,7 +334,7 @@ void writeGridToBinaryFile(Grid *grid, char *file_name, int zip_status);
  *   should be destroyed using destroyGrid() when it is no longer needed.
  *
  * - Function recognizes if the file name contains .gz or .bz2 extention
- *   and uncompresses the file accordingly
+ *   and decompresses the data as it is read (see openLSMFileForReading())
  *
  */
 Grid *readGridFromBinaryFile(char *file_name);
@@ -355,6 +359,141 @@ void setIndexSpaceLimits(LSMLIB_SPATIAL_DERIVATIVE_ACCURACY_TYPE accuracy,
 /*! @} */
 
 
+/*! @{ 
+ ****************************************************************
+ *
+ * @name Cache blocking functions
+ *
+ * On large grids, the stencils of the spatial derivative kernels 
+ * reach grid points that are (grid_dims_ghostbox[0] * 
+ * grid_dims_ghostbox[1]) array elements apart, so a kernel applied 
+ * to the entire fillbox streams every data array through the cache 
+ * several times.  The functions below split the fillbox into 
+ * blocks so that a sequence of kernels can be applied block by 
+ * block while the data for the block is still in cache:
+ *
+ * \code
+ *   setGridBlockDims(grid,block_dims);
+ *   num_blocks = getGridNumBlocks(grid);
+ *   for (b = 0; b < num_blocks; b++) {
+ *     getGridBlock(grid,b,&block_grid);
+ *     ... kernels called with the ghostbox and fillboxes of block_grid ...
+ *   }
+ * \endcode
+ *
+ * The data arrays are NOT reorganized: the ghostbox of a block Grid 
+ * is the ghostbox of the original Grid, so the arrays allocated by 
+ * allocateMemoryForLSMDataArrays() are used unchanged and the 
+ * results are identical to the unblocked calculation.
+ *
+ * The HJ ENO/WENO kernels should be called in their *_NO_SCRATCH 
+ * form, which computes the undivided differences along the stencil.  
+ * The older kernels that take scratch arrays for the undivided 
+ * differences (D1, D2, D3) reset the entire ghostbox of those arrays, 
+ * which would defeat the blocking; if they are used, they should be 
+ * passed small scratch arrays (of getGridBlockScratchSize() values) 
+ * together with the box returned by getGridBlockScratchBox().
+ *
+ ****************************************************************/
+
+/*!
+ * setGridBlockDims() sets the dimensions of the blocks used to 
+ * traverse the fillbox of the Grid.
+ *
+ * Arguments:
+ *  - grid (in/out):      pointer to Grid structure
+ *  - block_dims (in):    number of grid cells of a block in each 
+ *                        coordinate direction (0 = entire fillbox)
+ *
+ * Return value:          none
+ *
+ * NOTES:
+ * - The Grid creation functions set block_dims to 0 (no blocking).
+ *
+ * - Blocking in the j- and k-directions only (block_dims[0] = 0) 
+ *   keeps the innermost loops of the kernels long and is usually 
+ *   the best choice.
+ *
+ * - The size of the block_dims array should be equal to the number
+ *   of dimensions.
+ *
+ */
+void setGridBlockDims(Grid *grid, int *block_dims);
+
+/*!
+ * getGridNumBlocks() returns the number of blocks that the fillbox of
+ * the Grid is split into.
+ *
+ * Arguments:
+ *  - grid (in):  pointer to Grid structure
+ *
+ * Return value:  number of blocks (1 if blocking is not used)
+ *
+ */
+int getGridNumBlocks(Grid *grid);
+
+/*!
+ * getGridBlock() sets up a Grid structure for a single block of the 
+ * fillbox.  The ghostbox of block_grid is the ghostbox of grid, the 
+ * fillbox is the block and the fillboxes for the undivided differences 
+ * are the block grown by the same number of cells as in grid.
+ *
+ * Arguments:
+ *  - grid (in):         pointer to Grid structure
+ *  - block (in):        block index (0 <= block < getGridNumBlocks())
+ *  - block_grid (out):  Grid structure for the block
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - block_grid is assumed to be allocated by the user.
+ *
+ * - Blocks are numbered with the i-direction changing fastest.
+ *
+ */
+void getGridBlock(Grid *grid, int block, Grid *block_grid);
+
+/*!
+ * getGridBlockScratchSize() returns the number of values needed by a
+ * scratch array that covers the scratch box of any block of the Grid
+ * (see getGridBlockScratchBox()).
+ *
+ * Arguments:
+ *  - grid (in):  pointer to Grid structure
+ *
+ * Return value:  size of the block scratch arrays
+ *
+ * NOTES:
+ * - If blocking is not used, the scratch box is the ghostbox and the
+ *   return value is num_gridpts.
+ *
+ */
+int getGridBlockScratchSize(Grid *grid);
+
+/*!
+ * getGridBlockScratchBox() returns the index space of the scratch 
+ * arrays for a block: the fillbox of the block grown by the ghostcell 
+ * width of the Grid.
+ *
+ * Arguments:
+ *  - grid (in):          pointer to Grid structure
+ *  - block_grid (in):    Grid structure of the block (from getGridBlock())
+ *  - scratch_box (out):  (ilo, ihi, jlo, jhi, klo, khi) of the scratch box
+ *
+ * Return value:          none
+ *
+ * NOTES:
+ * - scratch_box is assumed to be allocated by the user (6 integers).
+ *
+ * - Scratch arrays of getGridBlockScratchSize() values can be passed to 
+ *   the Fortran kernels as arrays with the index space scratch_box.
+ *
+ */
+void getGridBlockScratchBox(Grid *grid, Grid *block_grid, int *scratch_box);
+
+/*! @} */
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,7 +13,189 @@
 #include <float.h>
 
 #include "lsm_initialization2d.h"
+#include "lsm_fast_marching_method.h"
 #include "lsm_macros.h"
+#include "lsm_primitive_bins.h"
+
+/* minimum number of bounded primitives for which a bin grid is used */
+#define LSM_INIT2D_MIN_BINNED_PRIMITIVES  16
+
+
+/*============ Helper functions for many-primitive geometries ==============*/
+
+/* data needed to evaluate the level set function of a circle or a */
+/* rectangle                                                        */
+typedef struct _PrimitiveData2d {
+  LSMLIB_REAL *a_x, *a_y;   /* circle centers or rectangle corners */
+  LSMLIB_REAL *b_x, *b_y;   /* rectangle side lengths              */
+  LSMLIB_REAL *radius;
+  int         *inside_flag;
+} PrimitiveData2d;
+
+static LSMLIB_REAL evaluateCircle(int l, LSMLIB_REAL *x, void *context)
+{
+  PrimitiveData2d *p = (PrimitiveData2d *)context;
+  LSMLIB_REAL signed_dist_to_circle;
+
+  signed_dist_to_circle = sqrt( (x[0]-p->a_x[l])*(x[0]-p->a_x[l])
+                               +(x[1]-p->a_y[l])*(x[1]-p->a_y[l]) ) 
+                        - p->radius[l];
+  if (p->inside_flag[l] >= 0) {
+    signed_dist_to_circle = -signed_dist_to_circle; 
+  }
+  return signed_dist_to_circle;
+}
+
+/* same arithmetic as createIntersectionOfHalfSpaces2d() applied to */
+/* the four sides of the rectangle                                   */
+static LSMLIB_REAL evaluateRectangle(int l, LSMLIB_REAL *x, void *context)
+{
+  static const LSMLIB_REAL normal[4][2] = {
+    {-1, 0}, {0, -1}, {1, 0}, {0, 1} };
+  PrimitiveData2d *p = (PrimitiveData2d *)context;
+  LSMLIB_REAL point[2], dot_prod, norm, signed_dist_to_line;
+  LSMLIB_REAL max = -FLT_MAX;
+  int i;
+
+  for (i = 0; i < 4; i++)
+  {
+    if (i < 2) {
+      point[0] = p->a_x[l];
+      point[1] = p->a_y[l];
+    } else {
+      point[0] = p->a_x[l] + p->b_x[l];
+      point[1] = p->a_y[l] + p->b_y[l];
+    }
+    dot_prod = (x[0] - point[0])*normal[i][0] + (x[1] - point[1])*normal[i][1];
+    norm = normal[i][0]*normal[i][0] + normal[i][1]*normal[i][1];
+    signed_dist_to_line = dot_prod/norm;
+    if (signed_dist_to_line > max) max = signed_dist_to_line;
+  }
+
+  if (p->inside_flag[l] >= 1) max = -max;
+  return max;
+}
+
+/*
+ * fillFarField2d() replaces the values of phi at grid points where
+ * phi <= -band_width by the distance function computed by the FMM
+ * (but no larger than -band_width).
+ */
+static void fillFarField2d(LSMLIB_REAL *phi, LSMLIB_REAL band_width,
+                           Grid *grid)
+{
+  LSMLIB_REAL *distance;
+  int idx, status;
+
+  distance = (LSMLIB_REAL *)malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  status = computeDistanceFunction2d(distance, phi, NULL, 2,
+                                     grid->grid_dims_ghostbox, grid->dx);
+  if (status == 0)
+  {
+    for (idx = 0; idx < grid->num_gridpts; idx++)
+    {
+      if (phi[idx] <= -band_width)
+        phi[idx] = (distance[idx] < -band_width) ? distance[idx] 
+                                                 : -band_width;
+    }
+  }
+  free(distance);
+}
+
+/*
+ * createIntersectionOfPrimitives2d() sets phi to the maximum over all
+ * primitives of their level set functions.  Primitives with bounded[l]
+ * set satisfy f_l(x) <= reach[l] - |x - center_l| and are sorted into a
+ * bin grid (see lsm_primitive_bins.h) so that only the primitives near
+ * a grid point are evaluated; the other primitives are evaluated at
+ * every grid point.
+ *
+ * If band_width > 0, phi is only computed exactly where phi > -band_width;
+ * the remaining grid points are filled using the FMM (see
+ * fillFarField2d()).
+ */
+static void createIntersectionOfPrimitives2d(
+  LSMLIB_REAL *phi,
+  int num_primitives,
+  int *bounded,
+  LSMLIB_REAL *center_x, LSMLIB_REAL *center_y,
+  LSMLIB_REAL *reach,
+  LSM_PrimitiveFunction function,
+  void *context,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  LSM_PrimitiveBins *bins = NULL;
+  LSMLIB_REAL *center[2];
+  LSMLIB_REAL min_value;
+  int *local_items, *global_items;
+  int num_local = 0, num_global = 0;
+  int j, l, nx;
+
+  min_value = (band_width > 0) ? -band_width : -LSMLIB_REAL_MAX;
+
+  local_items = (int *)malloc((num_primitives+1)*sizeof(int));
+  global_items = (int *)malloc((num_primitives+1)*sizeof(int));
+  for (l = 0; l < num_primitives; l++)
+  {
+    if (bounded[l]) local_items[num_local++] = l;
+    else            global_items[num_global++] = l;
+  }
+
+  if (num_local >= LSM_INIT2D_MIN_BINNED_PRIMITIVES)
+  {
+    center[0] = center_x; center[1] = center_y;
+    bins = createPrimitiveBins(num_local, local_items, center, reach, grid);
+  }
+
+  nx = (grid->grid_dims_ghostbox)[0];
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) private(l)
+#endif
+  for (j = 0; j < (grid->grid_dims_ghostbox)[1]; j++)
+  {
+    int i, n;
+    LSMLIB_REAL x[3], max, value;
+
+    for (i = 0; i < (grid->grid_dims_ghostbox)[0]; i++) 
+    {
+      x[0] = (grid->x_lo_ghostbox)[0] + (grid->dx)[0]*i;
+      x[1] = (grid->x_lo_ghostbox)[1] + (grid->dx)[1]*j;
+      x[2] = 0.0;
+
+      max = -FLT_MAX;
+      for (n = 0; n < num_global; n++)
+      {
+        value = function(global_items[n], x, context);
+        if (value > max) max = value;
+      }
+      if (bins)
+      {
+        max = queryPrimitiveBins(bins, x, max, min_value, function, 
+                                 context);
+      }
+      else
+      {
+        for (n = 0; n < num_local; n++)
+        {
+          l = local_items[n];
+          value = function(l, x, context);
+          if (value > max) max = value;
+        }
+      }
+      if (max < min_value) max = min_value;
+
+      phi[i + j*nx] = max;
+    }
+  } /* end of loop over grid */
+
+  destroyPrimitiveBins(bins);
+  free(local_items);
+  free(global_items);
+
+  if (band_width > 0) fillFarField2d(phi, band_width, grid);
+}
 
 
 void createLine(
@@ -144,36 +326,36 @@ void createIntersectionOfCircles(
   int *inside_flag,
   Grid *grid)
 {
-  int    i,j,l;
-  int    idx;
-  LSMLIB_REAL x,y;
-  LSMLIB_REAL max;
-  LSMLIB_REAL signed_dist_to_circle;
-    
-    
-  for (j = 0; j < (grid->grid_dims_ghostbox)[1]; j++)
-  {
-    for (i = 0; i < (grid->grid_dims_ghostbox)[0]; i++) 
-    {
-      idx = i+j*(grid->grid_dims_ghostbox)[0];
-      x = (grid->x_lo_ghostbox)[0] + (grid->dx)[0]*i;
-      y = (grid->x_lo_ghostbox)[1] + (grid->dx)[1]*j;
-    
-      max = -FLT_MAX;
+  createIntersectionOfCirclesNarrowBand(
+    phi, num_circles, center_x, center_y, radius, inside_flag, 0.0, grid);
+}
 
-      for (l = 0; l < num_circles; l++)
-      {
-        signed_dist_to_circle = sqrt( (x-center_x[l])*(x-center_x[l])
-                                     +(y-center_y[l])*(y-center_y[l]) ) 
-                                - radius[l];
-        if (inside_flag[l] >= 0) {
-          signed_dist_to_circle = -signed_dist_to_circle; 
-        }
-        if (signed_dist_to_circle > max) max = signed_dist_to_circle;
-      }
-      phi[idx] = max;
-    }
-  }
+
+void createIntersectionOfCirclesNarrowBand(
+  LSMLIB_REAL *phi, 
+  int num_circles,
+  LSMLIB_REAL *center_x, LSMLIB_REAL *center_y,
+  LSMLIB_REAL *radius,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  PrimitiveData2d data;
+  int *bounded, l;
+
+  /* circles with nonnegative inside_flag satisfy          */
+  /* phi <= radius - |x - center|; the others are unbounded */
+  bounded = (int *)malloc((num_circles+1)*sizeof(int));
+  for (l = 0; l < num_circles; l++) bounded[l] = (inside_flag[l] >= 0);
+
+  data.a_x = center_x; data.a_y = center_y;
+  data.radius = radius;
+  data.inside_flag = inside_flag;
+
+  createIntersectionOfPrimitives2d(phi, num_circles, bounded,
+                                   center_x, center_y, radius,
+                                   evaluateCircle, &data, band_width, grid);
+  free(bounded);
 }
 
 
@@ -202,51 +384,55 @@ void createIntersectionOfRectangles(
   int *inside_flag,
   Grid *grid)
 {   
-  LSMLIB_REAL point_x[4], point_y[4];
-  LSMLIB_REAL normal_x[4], normal_y[4];
-  int i, l, num_planes;
-     
-  LSMLIB_REAL  *phi1 = 
-    (LSMLIB_REAL *)malloc(grid->num_gridpts*sizeof(LSMLIB_REAL)); 
-        
-  for(l = 0; l < num_rectangles; l++) {
-    /* Each rectangle is the intersection of 4 half spaces */
-    for(i = 0; i < 2; i++) {
-      point_x[i] = corner_x[l];
-      point_y[i] = corner_y[l];
-    
-      if (i == 0) normal_x[i] = -1;
-      else        normal_x[i] = 0;
-    
-      if (i == 1) normal_y[i] = -1;
-      else        normal_y[i] = 0;
-    }
-       
-    for(i = 2; i < 4; i++)
-    {
-      point_x[i] = corner_x[l] + side_length_x[l];
-      point_y[i] = corner_y[l] + side_length_y[l];
-    
-      if (i == 2) normal_x[i] = 1;
-      else        normal_x[i] = 0;
-    
-      if (i == 3) normal_y[i] = 1;
-      else        normal_y[i] = 0;
-    }
-      
-    num_planes = 4;
-    createIntersectionOfHalfSpaces2d(phi1, num_planes,
-                                     normal_x, normal_y,
-                                     point_x, point_y,
-                                     grid);
-    if (inside_flag[l] >= 1) 
-    { 
-      NEGATE_DATA(phi1,grid)
-    }
-      
-    if (l == 0 ) COPY_DATA(phi,phi1,grid)
-    else         IMPOSE_MASK(phi,phi1,phi,grid)              
+  createIntersectionOfRectanglesNarrowBand(
+    phi, num_rectangles,
+    corner_x, corner_y,
+    side_length_x, side_length_y,
+    inside_flag, 0.0, grid);
+}
+
+
+void createIntersectionOfRectanglesNarrowBand(
+  LSMLIB_REAL *phi,
+  int num_rectangles,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL  *corner_y,
+  LSMLIB_REAL *side_length_x, LSMLIB_REAL *side_length_y,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{   
+  PrimitiveData2d data;
+  LSMLIB_REAL *center, *reach;
+  int *bounded, l;
+
+  /* phi is left unchanged if there are no rectangles */
+  if (num_rectangles <= 0) return;
+
+  /* rectangles with inside_flag >= 1 satisfy                     */
+  /* phi <= (largest half side length) - |x - center|_max;        */
+  /* the others are unbounded                                      */
+  center = (LSMLIB_REAL *)malloc(2*num_rectangles*sizeof(LSMLIB_REAL));
+  reach = (LSMLIB_REAL *)malloc(num_rectangles*sizeof(LSMLIB_REAL));
+  bounded = (int *)malloc(num_rectangles*sizeof(int));
+  for (l = 0; l < num_rectangles; l++)
+  {
+    center[l] = corner_x[l] + 0.5*side_length_x[l];
+    center[l+num_rectangles] = corner_y[l] + 0.5*side_length_y[l];
+    reach[l] = 0.5*fabs(side_length_x[l]);
+    if (0.5*fabs(side_length_y[l]) > reach[l])
+      reach[l] = 0.5*fabs(side_length_y[l]);
+    bounded[l] = (inside_flag[l] >= 1);
   }
-    
-  free(phi1);
+
+  data.a_x = corner_x; data.a_y = corner_y;
+  data.b_x = side_length_x; data.b_y = side_length_y;
+  data.inside_flag = inside_flag;
+
+  createIntersectionOfPrimitives2d(phi, num_rectangles, bounded,
+                                   center, center+num_rectangles, reach,
+                                   evaluateRectangle, &data, band_width,
+                                   grid);
+  free(center);
+  free(reach);
+  free(bounded);
 }
@@ -275,6 +275,12 @@ void createCircle(
  *   regions where phi > 0 simultaneously for the level set functions of
  *   multiple circles.
  *
+ * - Circles with nonnegative inside_flag are sorted into a uniform bin 
+ *   grid (see lsm_primitive_bins.h), so only the circles near a grid
+ *   point are evaluated there.  The result is the same as evaluating
+ *   every circle at every grid point.  Circles with negative inside_flag 
+ *   are evaluated at every grid point.
+ *
  * - Is it the user's responsibility to ensure that memory for phi
  *   has been allocated.
  *
@@ -287,6 +293,41 @@ void createIntersectionOfCircles(
   Grid *grid);
 
 
+/*!
+ * createIntersectionOfCirclesNarrowBand() is the same as
+ * createIntersectionOfCircles() except that phi is only computed 
+ * exactly in a band around the zero level set.  The remaining grid 
+ * points are filled using the Fast Marching Method.
+ *
+ * Arguments:
+ *  - band_width (in):   phi is exact at grid points where 
+ *                       phi > -band_width (a nonpositive value gives 
+ *                       the same result as createIntersectionOfCircles())
+ *  - all other arguments are the same as for 
+ *    createIntersectionOfCircles()
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - At grid points where phi <= -band_width, phi is set to the 
+ *   (second-order) FMM distance function computed by 
+ *   computeDistanceFunction2d() from the band, but no larger than 
+ *   -band_width.
+ *
+ * - Because far away circles need not be visited, the cost of the 
+ *   exact evaluation per grid point is bounded by the number of circles
+ *   within (largest radius + band_width) of the grid point.
+ *
+ */
+void createIntersectionOfCirclesNarrowBand(
+  LSMLIB_REAL *phi, int num_circles, 
+  LSMLIB_REAL *center_x, LSMLIB_REAL *center_y,
+  LSMLIB_REAL *radius,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
+
 /*!
  * createRectangle() sets phi to be a level set function corresponding to 
  * a rectangle with its sides parallel to coordinate axes. The rectangle is 
@@ -364,6 +405,13 @@ void createRectangle(
  *   regions where phi > 0 simultaneously for any two of the half-spaces
  *   that define the rectangles.
  * 
+ * - Rectangles with inside_flag[i] >= 1 are sorted into a uniform bin 
+ *   grid (see lsm_primitive_bins.h), so only the rectangles near a grid
+ *   point are evaluated there.  The result is the same as evaluating 
+ *   every rectangle at every grid point.
+ *
+ * - If num_rectangles is zero, phi is not modified.
+ *
  * - Is it the user's responsbility to ensure that memory for phi
  *   has been allocated.
  *
@@ -376,6 +424,36 @@ void createIntersectionOfRectangles(
   int *inside_flag,
   Grid *grid);
 
+
+/*!
+ * createIntersectionOfRectanglesNarrowBand() is the same as
+ * createIntersectionOfRectangles() except that phi is only computed 
+ * exactly in a band around the zero level set.  The remaining grid 
+ * points are filled using the Fast Marching Method.
+ *
+ * Arguments:
+ *  - band_width (in):      phi is exact at grid points where 
+ *                          phi > -band_width (a nonpositive value gives 
+ *                          the same result as 
+ *                          createIntersectionOfRectangles())
+ *  - all other arguments are the same as for 
+ *    createIntersectionOfRectangles()
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - See createIntersectionOfCirclesNarrowBand().
+ *
+ */
+void createIntersectionOfRectanglesNarrowBand(
+  LSMLIB_REAL *phi,
+  int num_rectangles,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL *corner_y,
+  LSMLIB_REAL *side_length_x, LSMLIB_REAL *side_length_y,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
      
 #ifdef __cplusplus
 }
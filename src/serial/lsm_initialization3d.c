@@ -12,7 +12,200 @@
 #include <float.h>
 #include <stdlib.h>
 #include "lsm_initialization3d.h"
+#include "lsm_fast_marching_method.h"
 #include "lsm_macros.h"
+#include "lsm_primitive_bins.h"
+
+/* minimum number of bounded primitives for which a bin grid is used */
+#define LSM_INIT3D_MIN_BINNED_PRIMITIVES  16
+
+
+/*============ Helper functions for many-primitive geometries ==============*/
+
+/* data needed to evaluate the level set function of a sphere or a box */
+typedef struct _PrimitiveData3d {
+  LSMLIB_REAL *a_x, *a_y, *a_z;   /* sphere centers or box corners */
+  LSMLIB_REAL *b_x, *b_y, *b_z;   /* box side lengths              */
+  LSMLIB_REAL *radius;
+  int         *inside_flag;
+} PrimitiveData3d;
+
+static LSMLIB_REAL evaluateSphere(int l, LSMLIB_REAL *x, void *context)
+{
+  PrimitiveData3d *p = (PrimitiveData3d *)context;
+  LSMLIB_REAL signed_dist_to_sphere;
+
+  signed_dist_to_sphere = sqrt( (x[0]-p->a_x[l])*(x[0]-p->a_x[l])
+                               +(x[1]-p->a_y[l])*(x[1]-p->a_y[l])
+                               +(x[2]-p->a_z[l])*(x[2]-p->a_z[l]) )
+                        - p->radius[l];
+  if (p->inside_flag[l] >= 0) {
+    signed_dist_to_sphere = -signed_dist_to_sphere;
+  }
+  return signed_dist_to_sphere;
+}
+
+/* same arithmetic as createIntersectionOfHalfSpaces3d() applied to */
+/* the six faces of the box                                          */
+static LSMLIB_REAL evaluateBox(int l, LSMLIB_REAL *x, void *context)
+{
+  static const LSMLIB_REAL normal[6][3] = {
+    {-1, 0, 0}, {0, -1, 0}, {0, 0, -1}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1} };
+  PrimitiveData3d *p = (PrimitiveData3d *)context;
+  LSMLIB_REAL point[3], dot_prod, norm, signed_dist_to_plane;
+  LSMLIB_REAL max = -FLT_MAX;
+  int i;
+
+  for (i = 0; i < 6; i++)
+  {
+    if (i < 3) {
+      point[0] = p->a_x[l];
+      point[1] = p->a_y[l];
+      point[2] = p->a_z[l];
+    } else {
+      point[0] = p->a_x[l] + p->b_x[l];
+      point[1] = p->a_y[l] + p->b_y[l];
+      point[2] = p->a_z[l] + p->b_z[l];
+    }
+    dot_prod = (x[0] - point[0])*normal[i][0] +
+               (x[1] - point[1])*normal[i][1] +
+               (x[2] - point[2])*normal[i][2];
+    norm = normal[i][0]*normal[i][0] + normal[i][1]*normal[i][1]+
+           normal[i][2]*normal[i][2];
+    norm = sqrt(norm);
+
+    signed_dist_to_plane = dot_prod/norm;
+    if (signed_dist_to_plane > max) max = signed_dist_to_plane;
+  }
+
+  if (p->inside_flag[l] >= 1) max = -max;
+  return max;
+}
+
+/*
+ * fillFarField3d() replaces the values of phi at grid points where
+ * phi <= -band_width by the distance function computed by the FMM
+ * (but no larger than -band_width).
+ */
+static void fillFarField3d(LSMLIB_REAL *phi, LSMLIB_REAL band_width,
+                           Grid *grid)
+{
+  LSMLIB_REAL *distance;
+  int idx, status;
+
+  distance = (LSMLIB_REAL *)malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  status = computeDistanceFunction3d(distance, phi, NULL, 2,
+                                     grid->grid_dims_ghostbox, grid->dx);
+  if (status == 0)
+  {
+    for (idx = 0; idx < grid->num_gridpts; idx++)
+    {
+      if (phi[idx] <= -band_width)
+        phi[idx] = (distance[idx] < -band_width) ? distance[idx] 
+                                                 : -band_width;
+    }
+  }
+  free(distance);
+}
+
+/*
+ * createIntersectionOfPrimitives3d() sets phi to the maximum over all
+ * primitives of their level set functions.  Primitives with bounded[l]
+ * set satisfy f_l(x) <= reach[l] - |x - center_l| and are sorted into a
+ * bin grid (see lsm_primitive_bins.h) so that only the primitives near
+ * a grid point are evaluated; the other primitives are evaluated at
+ * every grid point.
+ *
+ * If band_width > 0, phi is only computed exactly where phi > -band_width;
+ * the remaining grid points are filled using the FMM (see
+ * fillFarField3d()).
+ */
+static void createIntersectionOfPrimitives3d(
+  LSMLIB_REAL *phi,
+  int num_primitives,
+  int *bounded,
+  LSMLIB_REAL *center_x, LSMLIB_REAL *center_y, LSMLIB_REAL *center_z,
+  LSMLIB_REAL *reach,
+  LSM_PrimitiveFunction function,
+  void *context,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  LSM_PrimitiveBins *bins = NULL;
+  LSMLIB_REAL *center[3];
+  LSMLIB_REAL min_value;
+  int *local_items, *global_items;
+  int num_local = 0, num_global = 0;
+  int k, l, nx, nxy;
+
+  min_value = (band_width > 0) ? -band_width : -LSMLIB_REAL_MAX;
+
+  local_items = (int *)malloc((num_primitives+1)*sizeof(int));
+  global_items = (int *)malloc((num_primitives+1)*sizeof(int));
+  for (l = 0; l < num_primitives; l++)
+  {
+    if (bounded[l]) local_items[num_local++] = l;
+    else            global_items[num_global++] = l;
+  }
+
+  if (num_local >= LSM_INIT3D_MIN_BINNED_PRIMITIVES)
+  {
+    center[0] = center_x; center[1] = center_y; center[2] = center_z;
+    bins = createPrimitiveBins(num_local, local_items, center, reach, grid);
+  }
+
+  nx = (grid->grid_dims_ghostbox)[0];
+  nxy = (grid->grid_dims_ghostbox)[0]*(grid->grid_dims_ghostbox)[1];
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) private(l)
+#endif
+  for (k = 0; k < (grid->grid_dims_ghostbox)[2]; k++)
+  {
+    int i, j, n;
+    LSMLIB_REAL x[3], max, value;
+
+    for (j = 0; j < (grid->grid_dims_ghostbox)[1]; j++)
+    {
+      for (i = 0; i < (grid->grid_dims_ghostbox)[0]; i++) 
+      {
+        x[0] = (grid->x_lo_ghostbox)[0] + (grid->dx)[0]*i;
+        x[1] = (grid->x_lo_ghostbox)[1] + (grid->dx)[1]*j;
+        x[2] = (grid->x_lo_ghostbox)[2] + (grid->dx)[2]*k;
+
+        max = -FLT_MAX;
+        for (n = 0; n < num_global; n++)
+        {
+          value = function(global_items[n], x, context);
+          if (value > max) max = value;
+        }
+        if (bins)
+        {
+          max = queryPrimitiveBins(bins, x, max, min_value, function, 
+                                   context);
+        }
+        else
+        {
+          for (n = 0; n < num_local; n++)
+          {
+            l = local_items[n];
+            value = function(l, x, context);
+            if (value > max) max = value;
+          }
+        }
+        if (max < min_value) max = min_value;
+
+        phi[i + j*nx + k*nxy] = max;
+      }
+    }
+  } /* end of loop over grid */
+
+  destroyPrimitiveBins(bins);
+  free(local_items);
+  free(global_items);
+
+  if (band_width > 0) fillFarField3d(phi, band_width, grid);
+}
 
 
 void createPlane(
@@ -122,45 +315,41 @@ void createIntersectionOfSpheres(
   int      *inside_flag,
   Grid     *grid)
 {
-  int    i, j, k, l;
-  int    idx, nx, nxy;
-  LSMLIB_REAL x, y, z;
-  LSMLIB_REAL max;
-  LSMLIB_REAL signed_dist_to_sphere;
-  
-  nx = (grid->grid_dims_ghostbox)[0];
-  nxy = (grid->grid_dims_ghostbox)[0]*(grid->grid_dims_ghostbox)[1];
-  
-  for (k = 0; k < (grid->grid_dims_ghostbox)[2]; k++)
-  {
-    for (j = 0; j < (grid->grid_dims_ghostbox)[1]; j++)
-    {
-      for (i = 0; i < (grid->grid_dims_ghostbox)[0]; i++) 
-      {
-        idx = i + j*nx + k*nxy;
-        x = (grid->x_lo_ghostbox)[0] + (grid->dx)[0]*i;
-        y = (grid->x_lo_ghostbox)[1] + (grid->dx)[1]*j;
-        z = (grid->x_lo_ghostbox)[2] + (grid->dx)[2]*k;
-    
-        max = -FLT_MAX;
-
-        for (l = 0; l < num_spheres; l++)
-        {
-          signed_dist_to_sphere = sqrt( (x-center_x[l])*(x-center_x[l])
-                                       +(y-center_y[l])*(y-center_y[l])
-                                       +(z-center_z[l])*(z-center_z[l]) ) 
-                                - radius[l];
+  createIntersectionOfSpheresNarrowBand(
+    phi, num_spheres,
+    center_x, center_y, center_z,
+    radius, inside_flag,
+    0.0, grid);
+}
 
-          if (inside_flag[l] >= 0) {
-            signed_dist_to_sphere = -signed_dist_to_sphere;
-          }
 
-          if (signed_dist_to_sphere > max) max = signed_dist_to_sphere;
-        }
-        phi[idx] = max;
-      }
-    }
-  } /* end of loop over grid */
+void createIntersectionOfSpheresNarrowBand(
+  LSMLIB_REAL   *phi,
+  int       num_spheres,
+  LSMLIB_REAL   *center_x,
+  LSMLIB_REAL   *center_y,
+  LSMLIB_REAL   *center_z,
+  LSMLIB_REAL   *radius,
+  int      *inside_flag,
+  LSMLIB_REAL   band_width,
+  Grid     *grid)
+{
+  PrimitiveData3d data;
+  int *bounded, l;
+
+  /* spheres with nonnegative inside_flag satisfy          */
+  /* phi <= radius - |x - center|; the others are unbounded */
+  bounded = (int *)malloc((num_spheres+1)*sizeof(int));
+  for (l = 0; l < num_spheres; l++) bounded[l] = (inside_flag[l] >= 0);
+
+  data.a_x = center_x; data.a_y = center_y; data.a_z = center_z;
+  data.radius = radius;
+  data.inside_flag = inside_flag;
+
+  createIntersectionOfPrimitives3d(phi, num_spheres, bounded,
+                                   center_x, center_y, center_z, radius,
+                                   evaluateSphere, &data, band_width, grid);
+  free(bounded);
 }
 
 
@@ -460,62 +649,59 @@ void createIntersectionOfBoxes(
   int *inside_flag,
   Grid *grid)
 {   
-  LSMLIB_REAL  point_x[6], point_y[6], point_z[6];
-  LSMLIB_REAL  normal_x[6], normal_y[6], normal_z[6];
-  int     i, l, num_planes;
-     
-  LSMLIB_REAL  *phi1 = 
-    (LSMLIB_REAL *)malloc(grid->num_gridpts*sizeof(LSMLIB_REAL)); 
-        
-  for(l = 0; l < num_cuboids; l++)
-  {
+  createIntersectionOfBoxesNarrowBand(
+    phi, num_cuboids,
+    corner_x, corner_y, corner_z,
+    side_length_x, side_length_y, side_length_z,
+    inside_flag, 0.0, grid);
+}
 
-    /* Each cuboid is intersection of 6 half spaces */
-    for(i = 0; i < 3; i++)
-    {
-      point_x[i] = corner_x[l];
-      point_y[i] = corner_y[l];
-      point_z[i] = corner_z[l];
-    
-      if (i == 0) normal_x[i] = -1;
-      else        normal_x[i] = 0;
-    
-      if (i == 1) normal_y[i] = -1;
-      else        normal_y[i] = 0;
-    
-      if (i == 2) normal_z[i] = -1;
-      else        normal_z[i] = 0;
-    }
-       
-    for(i = 3; i < 6; i++)
-    {
-      point_x[i] = corner_x[l] + side_length_x[l];
-      point_y[i] = corner_y[l] + side_length_y[l];
-      point_z[i] = corner_z[l] + side_length_z[l];
-    
-      if (i == 3) normal_x[i] = 1;
-      else        normal_x[i] = 0;
-    
-      if (i == 4) normal_y[i] = 1;
-      else        normal_y[i] = 0;
-    
-      if (i == 5) normal_z[i] = 1;
-      else        normal_z[i] = 0;
-    }
-      
-    num_planes = 6;
-    createIntersectionOfHalfSpaces3d(phi1,num_planes,
-				     normal_x,normal_y,normal_z,
-				     point_x,point_y,point_z,
-				     grid);
-    if(inside_flag[l] >= 1) 
-    { 
-	NEGATE_DATA(phi1,grid)
-    }
 
-    if(l == 0 ) COPY_DATA(phi,phi1,grid)
-    else        IMPOSE_MASK(phi,phi1,phi,grid)				      
+void createIntersectionOfBoxesNarrowBand(
+  LSMLIB_REAL *phi,
+  int num_cuboids,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL *corner_y, LSMLIB_REAL *corner_z,
+  LSMLIB_REAL *side_length_x, LSMLIB_REAL *side_length_y, LSMLIB_REAL *side_length_z,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{   
+  PrimitiveData3d data;
+  LSMLIB_REAL *center, *reach;
+  int *bounded, l;
+
+  /* phi is left unchanged if there are no cuboids */
+  if (num_cuboids <= 0) return;
+
+  /* cuboids with inside_flag >= 1 satisfy                        */
+  /* phi <= (largest half side length) - |x - center|_max;        */
+  /* the others are unbounded                                      */
+  center = (LSMLIB_REAL *)malloc(3*num_cuboids*sizeof(LSMLIB_REAL));
+  reach = (LSMLIB_REAL *)malloc(num_cuboids*sizeof(LSMLIB_REAL));
+  bounded = (int *)malloc(num_cuboids*sizeof(int));
+  for (l = 0; l < num_cuboids; l++)
+  {
+    center[l] = corner_x[l] + 0.5*side_length_x[l];
+    center[l+num_cuboids] = corner_y[l] + 0.5*side_length_y[l];
+    center[l+2*num_cuboids] = corner_z[l] + 0.5*side_length_z[l];
+    reach[l] = 0.5*fabs(side_length_x[l]);
+    if (0.5*fabs(side_length_y[l]) > reach[l])
+      reach[l] = 0.5*fabs(side_length_y[l]);
+    if (0.5*fabs(side_length_z[l]) > reach[l])
+      reach[l] = 0.5*fabs(side_length_z[l]);
+    bounded[l] = (inside_flag[l] >= 1);
   }
-    
-  free(phi1);
+
+  data.a_x = corner_x; data.a_y = corner_y; data.a_z = corner_z;
+  data.b_x = side_length_x; data.b_y = side_length_y; 
+  data.b_z = side_length_z;
+  data.inside_flag = inside_flag;
+
+  createIntersectionOfPrimitives3d(phi, num_cuboids, bounded,
+                                   center, center+num_cuboids,
+                                   center+2*num_cuboids, reach,
+                                   evaluateBox, &data, band_width, grid);
+  free(center);
+  free(reach);
+  free(bounded);
 }
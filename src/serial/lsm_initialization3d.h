@@ -230,6 +230,12 @@ void createSphere(
  *   phi > 0, it is a signed distance function everywhere except for 
  *   regions where phi > 0 simultaneously for multiple spheres.
  *
+ * - Spheres with nonnegative inside_flag are sorted into a uniform bin 
+ *   grid (see lsm_primitive_bins.h), so only the spheres near a grid
+ *   point are evaluated there.  The result is the same as evaluating
+ *   every sphere at every grid point.  Spheres with negative inside_flag 
+ *   are evaluated at every grid point.
+ *
  * - Is it the user's responsbility to ensure that memory for phi
  *   has been allocated.
  *
@@ -242,6 +248,42 @@ void createIntersectionOfSpheres(
   Grid *grid);
 
 
+/*!
+ * createIntersectionOfSpheresNarrowBand() is the same as
+ * createIntersectionOfSpheres() except that phi is only computed 
+ * exactly in a band around the zero level set.  The remaining grid 
+ * points are filled using the Fast Marching Method.
+ *
+ * Arguments:
+ *  - band_width (in):   phi is exact at grid points where 
+ *                       phi > -band_width (a nonpositive value gives 
+ *                       the same result as createIntersectionOfSpheres())
+ *  - all other arguments are the same as for 
+ *    createIntersectionOfSpheres()
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - At grid points where phi <= -band_width, phi is set to the 
+ *   (second-order) FMM distance function computed by 
+ *   computeDistanceFunction3d() from the band, but no larger than 
+ *   -band_width.
+ *
+ * - Because far away spheres need not be visited, the cost of the 
+ *   exact evaluation per grid point is bounded by the number of spheres
+ *   within (largest radius + band_width) of the grid point.  This is the
+ *   recommended initialization for packs of many spheres.
+ *
+ */
+void createIntersectionOfSpheresNarrowBand(
+  LSMLIB_REAL *phi, int num_spheres,
+  LSMLIB_REAL *center_x, LSMLIB_REAL *center_y, LSMLIB_REAL *center_z,
+  LSMLIB_REAL *radius, 
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
+
 /*!
  * createCylinder() sets phi to be a level set function corresponding to 
  * a cylinders with arbitrary axes.
@@ -590,6 +632,13 @@ void createBox(
  *   regions where phi > 0 simultaneously for any two of the half-spaces
  *   that define the cuboids.
  *
+ * - Cuboids with inside_flag[i] >= 1 are sorted into a uniform bin grid
+ *   (see lsm_primitive_bins.h), so only the cuboids near a grid point 
+ *   are evaluated there.  The result is the same as evaluating every 
+ *   cuboid at every grid point.
+ *
+ * - If num_cuboids is zero, phi is not modified.
+ *
  * - Is it the user's responsbility to ensure that memory for phi
  *   has been allocated. 
  *
@@ -605,6 +654,36 @@ void  createIntersectionOfBoxes(
   Grid *grid);     
 
 
+/*!
+ * createIntersectionOfBoxesNarrowBand() is the same as
+ * createIntersectionOfBoxes() except that phi is only computed exactly
+ * in a band around the zero level set.  The remaining grid points are 
+ * filled using the Fast Marching Method.
+ *
+ * Arguments:
+ *  - band_width (in):     phi is exact at grid points where 
+ *                         phi > -band_width (a nonpositive value gives 
+ *                         the same result as createIntersectionOfBoxes())
+ *  - all other arguments are the same as for createIntersectionOfBoxes()
+ *
+ * Return value:           none
+ *
+ * NOTES:
+ * - See createIntersectionOfSpheresNarrowBand().
+ *
+ */
+void  createIntersectionOfBoxesNarrowBand(
+  LSMLIB_REAL *phi,
+  int num_cuboids,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL *corner_y, LSMLIB_REAL *corner_z,
+  LSMLIB_REAL *side_length_x, 
+  LSMLIB_REAL *side_length_y, 
+  LSMLIB_REAL *side_length_z,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);     
+
+
 #ifdef __cplusplus
 }
 #endif
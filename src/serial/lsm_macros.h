@@ -110,19 +110,46 @@ extern "C" {
    int idx, l;                                                               \
                                                                              \
    if(grid->num_dims == 3)                                                   \
-     for(l = (p->n_lo)[0]; l < (p->n_hi)[0]; l++)                            \
+     for(l = (p->n_lo)[0]; l <= (p->n_hi)[0]; l++)                           \
      {                                                                       \
   idx = (p->index_x)[l] + (p->index_y)[l]*nx + (p->index_z)[l]*nxy;          \
         phi_masked[idx] = (mask[idx] > phi[idx]) ? mask[idx] : phi[idx];     \
      }                                                                       \
    else                                                                      \
-     for(l = (p->n_lo)[0]; l < (p->n_hi)[0]; l++)                            \
+     for(l = (p->n_lo)[0]; l <= (p->n_hi)[0]; l++)                           \
      {                                                                       \
   idx = (p->index_x)[l] + (p->index_y)[l]*nx;                                \
         phi_masked[idx] = (mask[idx] > phi[idx]) ? mask[idx] : phi[idx];     \
      }                                                                       \
 }
 
+
+/*!
+ * SET_DATA_FAR_FROM_NARROW_BAND() sets data to (+value) or (-value),
+ * following the sign of phi, at the grid points marked in the far array
+ * (far value non-zero).  This keeps values left far outside of the 
+ * narrow band by earlier time steps from being carried along as the 
+ * narrow band moves.
+ *
+ * Arguments:
+ *  - data (in/out):  data array of size (grid->num_gridpts) 
+ *  - phi (in):       level set function (may be the same as data)
+ *  - far (in):       array of size (grid->num_gridpts) marking the grid
+ *                    points to set
+ *  - value (in):     magnitude of data at the marked grid points
+ *  - grid (in):      pointer to Grid 
+ *
+ */
+#define SET_DATA_FAR_FROM_NARROW_BAND(data, phi, far, value, grid)         \
+{                                                                          \
+  int idx;                                                                 \
+  for(idx = 0; idx < grid->num_gridpts; idx++)                             \
+  {                                                                        \
+    if( far[idx] )                                                         \
+      data[idx] = (phi[idx] < 0) ? -(value) : (value);                     \
+  }                                                                        \
+}
+
  
  /* IMPOSE_MIN(phi_min, phi1, phi2, grid) computes minimum of two (level set)
  * functions. Note that the set described by (phi_min < 0) is union of
@@ -0,0 +1,196 @@
+/*
+ * File:        lsm_primitive_bins.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for uniform bin grid used to accelerate
+ *              the initialization of level set functions from many
+ *              primitives
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include "lsm_primitive_bins.h"
+
+
+LSM_PrimitiveBins *createPrimitiveBins(int num_items, int *items,
+                                       LSMLIB_REAL **center,
+                                       LSMLIB_REAL *reach, Grid *grid)
+{
+  LSM_PrimitiveBins *bins;
+  LSMLIB_REAL volume = 1.0, length, extent = 0.0, size;
+  int  *bin_of_item, *count;
+  int  num_bins_total, d, n, b, ib[3];
+
+  bins = (LSM_PrimitiveBins *)calloc(1, sizeof(LSM_PrimitiveBins));
+
+  /* largest reach */
+  bins->reach_max = (num_items > 0) ? reach[items[0]] : 0.0;
+  for (n = 1; n < num_items; n++)
+    if (reach[items[n]] > bins->reach_max) bins->reach_max = reach[items[n]];
+
+  /* bin size: about one primitive per bin, but no smaller than the
+     largest reach (so that the search stops after a few shells) or the
+     grid spacing */
+  size = 0.0;
+  bins->tol = fabs(bins->reach_max);
+  for (d = 0; d < grid->num_dims; d++)
+  {
+    length = (grid->x_hi_ghostbox)[d] - (grid->x_lo_ghostbox)[d];
+    volume *= length;
+    if (length > extent) extent = length;
+    if ((grid->dx)[d] > size) size = (grid->dx)[d];
+    bins->tol += fabs((grid->x_lo_ghostbox)[d]);
+  }
+  length = pow(volume/(num_items > 0 ? num_items : 1), 1.0/grid->num_dims);
+  if (length > size) size = length;
+  if (bins->reach_max > size) size = bins->reach_max;
+  bins->bin_size = size;
+
+  num_bins_total = 1;
+  for (d = 0; d < 3; d++)
+  {
+    if (d < grid->num_dims)
+    {
+      bins->x_lo[d] = (grid->x_lo_ghostbox)[d];
+      bins->num_bins[d] = (int)ceil(
+        ((grid->x_hi_ghostbox)[d] - (grid->x_lo_ghostbox)[d])/size);
+      if (bins->num_bins[d] < 1) bins->num_bins[d] = 1;
+    }
+    else
+    {
+      bins->x_lo[d] = 0.0;
+      bins->num_bins[d] = 1;
+    }
+    num_bins_total *= bins->num_bins[d];
+  }
+
+  /* tolerance for round-off in the evaluation of the primitives */
+  bins->tol = 64*LSMLIB_REAL_EPSILON*(bins->tol + 2*extent);
+
+  /* sort primitives by bin (counting sort) */
+  bin_of_item = (int *)malloc((num_items > 0 ? num_items : 1)*sizeof(int));
+  count = (int *)calloc(num_bins_total + 1, sizeof(int));
+  for (n = 0; n < num_items; n++)
+  {
+    for (d = 0; d < 3; d++)
+    {
+      ib[d] = 0;
+      if (d < grid->num_dims)
+      {
+        LSMLIB_REAL s = (center[d][items[n]] - bins->x_lo[d])/size;
+        if (s > 0)
+          ib[d] = (s < bins->num_bins[d]) ? (int)s : bins->num_bins[d]-1;
+      }
+    }
+    b = ib[0] + bins->num_bins[0]*(ib[1] + bins->num_bins[1]*ib[2]);
+    bin_of_item[n] = b;
+    count[b+1]++;
+  }
+  for (b = 0; b < num_bins_total; b++) count[b+1] += count[b];
+
+  bins->bin_start = (int *)malloc((num_bins_total + 1)*sizeof(int));
+  for (b = 0; b <= num_bins_total; b++) bins->bin_start[b] = count[b];
+  bins->bin_items = (int *)malloc((num_items > 0 ? num_items : 1)
+                                  *sizeof(int));
+  for (n = 0; n < num_items; n++)
+    bins->bin_items[count[bin_of_item[n]]++] = items[n];
+
+  free(count);
+  free(bin_of_item);
+  return bins;
+}
+
+
+void destroyPrimitiveBins(LSM_PrimitiveBins *bins)
+{
+  if (bins)
+  {
+    free(bins->bin_start);
+    free(bins->bin_items);
+    free(bins);
+  }
+}
+
+
+/* visitBin() evaluates the primitives in bin b and updates max */
+static LSMLIB_REAL visitBin(LSM_PrimitiveBins *bins, int b, LSMLIB_REAL *x,
+                            LSMLIB_REAL max, LSM_PrimitiveFunction function,
+                            void *context)
+{
+  LSMLIB_REAL value;
+  int n;
+
+  for (n = bins->bin_start[b]; n < bins->bin_start[b+1]; n++)
+  {
+    value = function(bins->bin_items[n], x, context);
+    if (value > max) max = value;
+  }
+  return max;
+}
+
+
+LSMLIB_REAL queryPrimitiveBins(LSM_PrimitiveBins *bins, LSMLIB_REAL *x,
+                               LSMLIB_REAL max, LSMLIB_REAL min_value,
+                               LSM_PrimitiveFunction function,
+                               void *context)
+{
+  int  *nb = bins->num_bins;
+  int   ib[3], lo[3], hi[3];
+  int   s, s_max, d, i, j, k, row;
+  LSMLIB_REAL bound, t;
+
+  /* bin containing x */
+  s_max = 0;
+  for (d = 0; d < 3; d++)
+  {
+    t = (x[d] - bins->x_lo[d])/bins->bin_size;
+    ib[d] = 0;
+    if (t > 0) ib[d] = (t < nb[d]) ? (int)t : nb[d]-1;
+    if (ib[d] > s_max) s_max = ib[d];
+    if (nb[d]-1-ib[d] > s_max) s_max = nb[d]-1-ib[d];
+  }
+
+  /* visit the bins in shells of increasing (maximum norm) bin distance
+     s from the bin containing x.  Every primitive in a bin of shell s
+     or beyond is at least (s-1)*bin_size away from x, so its level set
+     function is at most reach_max - (s-1)*bin_size. */
+  for (s = 0; s <= s_max; s++)
+  {
+    if (s >= 2)
+    {
+      bound = bins->reach_max - (s-1)*bins->bin_size + bins->tol;
+      if ( (bound < max) || (bound < min_value) ) break;
+    }
+
+    for (d = 0; d < 3; d++)
+    {
+      lo[d] = (ib[d]-s < 0) ? -ib[d] : -s;
+      hi[d] = (ib[d]+s > nb[d]-1) ? nb[d]-1-ib[d] : s;
+    }
+    for (k = lo[2]; k <= hi[2]; k++)
+    {
+      for (j = lo[1]; j <= hi[1]; j++)
+      {
+        row = ib[0] + nb[0]*((ib[1]+j) + nb[1]*(ib[2]+k));
+        if ( (k == -s) || (k == s) || (j == -s) || (j == s) )
+        { /* whole row lies on the shell */
+          for (i = lo[0]; i <= hi[0]; i++)
+            max = visitBin(bins, row+i, x, max, function, context);
+        }
+        else
+        { /* only the two end bins of the row lie on the shell */
+          if (lo[0] == -s)
+            max = visitBin(bins, row-s, x, max, function, context);
+          if (hi[0] == s)
+            max = visitBin(bins, row+s, x, max, function, context);
+        }
+      }
+    }
+  }
+
+  return max;
+}
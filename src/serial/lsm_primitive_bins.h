@@ -0,0 +1,148 @@
+/*
+ * File:        lsm_primitive_bins.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for uniform bin grid used to accelerate the
+ *              initialization of level set functions from many primitives
+ */
+
+#ifndef included_lsm_primitive_bins_h
+#define included_lsm_primitive_bins_h
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_primitive_bins.h
+ *
+ * \brief
+ * @ref lsm_primitive_bins.h provides a uniform bin grid over the ghostbox
+ * of a Grid that is used by the createIntersectionOf*() initialization
+ * functions to evaluate the maximum of the level set functions of a
+ * large number of geometric primitives (spheres, boxes, circles,
+ * rectangles) without visiting every primitive at every grid point.
+ *
+ * Each primitive l is stored in the bin containing its center c_l
+ * together with a "reach" r_l such that its level set function
+ * satisfies
+ *
+ *   f_l(x) <= r_l - |x - c_l|
+ *
+ * (|.| is the Euclidean or the maximum norm).  queryPrimitiveBins()
+ * visits the bins in shells of increasing distance from the query point
+ * and stops as soon as no primitive in the remaining shells can
+ * increase the maximum, so the result is the same as that of a loop
+ * over all primitives.
+ *
+ */
+
+#include "lsm_grid.h"
+
+
+/*!
+ * Structure 'LSM_PrimitiveBins' stores the primitives sorted by bin.
+ */
+typedef struct _LSM_PrimitiveBins
+{
+  /* number of bins and lower corner of the bin grid */
+  int          num_bins[3];
+  LSMLIB_REAL  x_lo[3];
+  LSMLIB_REAL  bin_size;
+
+  /* primitives in bin b: bin_items[bin_start[b]] ...
+                          bin_items[bin_start[b+1]-1] */
+  int          *bin_start;
+  int          *bin_items;
+
+  /* largest reach and round-off tolerance used in the stopping test */
+  LSMLIB_REAL  reach_max;
+  LSMLIB_REAL  tol;
+
+} LSM_PrimitiveBins;
+
+
+/*!
+ * LSM_PrimitiveFunction is the type of the function that evaluates the
+ * level set function of primitive l at the point x.
+ */
+typedef LSMLIB_REAL (*LSM_PrimitiveFunction)(int l, LSMLIB_REAL *x,
+                                             void *context);
+
+
+/*!
+ * createPrimitiveBins() sorts the specified primitives into a uniform
+ * bin grid covering the ghostbox of the grid.
+ *
+ * Arguments:
+ *  - num_items (in):  number of primitives to store
+ *  - items (in):      indices of the primitives to store
+ *  - center (in):     coordinates of the centers of the primitives
+ *                     (center[d][l] for the d-th coordinate of the
+ *                     primitive with index l)
+ *  - reach (in):      reach of each primitive (see above)
+ *  - grid (in):       pointer to Grid
+ *
+ * Return value:       pointer to new LSM_PrimitiveBins
+ *
+ * NOTES:
+ * - The bin size is chosen so that the number of bins is about the
+ *   number of primitives, but no smaller than the largest reach or
+ *   the grid spacing.
+ *
+ * - Primitives with centers outside the ghostbox are stored in the
+ *   nearest bin.
+ *
+ */
+LSM_PrimitiveBins *createPrimitiveBins(int num_items, int *items,
+                                       LSMLIB_REAL **center,
+                                       LSMLIB_REAL *reach, Grid *grid);
+
+
+/*!
+ * destroyPrimitiveBins() frees the memory used by a LSM_PrimitiveBins.
+ *
+ * Arguments:
+ *  - bins (in):  pointer to LSM_PrimitiveBins
+ *
+ * Return value:  none
+ *
+ */
+void destroyPrimitiveBins(LSM_PrimitiveBins *bins);
+
+
+/*!
+ * queryPrimitiveBins() returns the maximum of the level set functions of
+ * the binned primitives at x and the specified initial value.
+ *
+ * Arguments:
+ *  - bins (in):       pointer to LSM_PrimitiveBins
+ *  - x (in):          query point (inside the ghostbox)
+ *  - max (in):        initial value of the maximum
+ *  - min_value (in):  the search stops once the maximum is known to be
+ *                     less than min_value (-LSMLIB_REAL_MAX for an exact
+ *                     result)
+ *  - function (in):   function evaluating the level set function of a
+ *                     primitive
+ *  - context (in):    data passed to function
+ *
+ * Return value:       max(max, f_l(x) for all binned primitives l) if
+ *                     this value is at least min_value; otherwise a
+ *                     value less than min_value
+ *
+ */
+LSMLIB_REAL queryPrimitiveBins(LSM_PrimitiveBins *bins, LSMLIB_REAL *x,
+                               LSMLIB_REAL max, LSMLIB_REAL min_value,
+                               LSM_PrimitiveFunction function,
+                               void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,875 @@
+/*
+ * File:        lsm_tiled_band.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for LSM_TiledBand structure
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#include "lsm_tiled_band.h"
+
+#define DSZ  sizeof(LSMLIB_REAL)
+#define ISZ  sizeof(int)
+#define UCSZ sizeof(unsigned char)
+
+/* minimum number of slots allocated in the tile memory pool */
+#define LSM_TILED_BAND_MIN_ALLOC_SLOTS  (16)
+
+/* flags used in tile_flag */
+#define LSM_TILED_BAND_OCCUPIED  (1)
+#define LSM_TILED_BAND_WANTED    (2)
+
+
+/*========================= Helper Functions ==========================*/
+
+/*
+ * getTileCoords() computes the coordinates of a tile in the array of tiles.
+ */
+static void getTileCoords(LSM_TiledBand *tb, int tile, int *tc)
+{
+  tc[0] = tile % tb->num_tiles[0];
+  tc[1] = (tile / tb->num_tiles[0]) % tb->num_tiles[1];
+  tc[2] = tile / (tb->num_tiles[0]*tb->num_tiles[1]);
+}
+
+
+/*
+ * getTileBoxes() computes the index range of the interior and ghostbox
+ * of a tile.  Both boxes are clipped to the ghostbox of the Grid.
+ */
+static void getTileBoxes(
+  LSM_TiledBand *tb,
+  int tile,
+  int *int_lo, int *int_hi,
+  int *box_lo, int *box_hi)
+{
+  Grid *g = tb->grid;
+  int glo[3], ghi[3], tc[3];
+  int d, lo, hi;
+
+  glo[0] = g->ilo_gb;  ghi[0] = g->ihi_gb;
+  glo[1] = g->jlo_gb;  ghi[1] = g->jhi_gb;
+  glo[2] = g->klo_gb;  ghi[2] = g->khi_gb;
+
+  getTileCoords(tb,tile,tc);
+  for (d = 0; d < 3; d++) {
+    lo = tb->tile_origin[d] + tc[d]*tb->tile_dims[d];
+    hi = lo + tb->tile_dims[d] - 1;
+    int_lo[d] = (lo > glo[d]) ? lo : glo[d];
+    int_hi[d] = (hi < ghi[d]) ? hi : ghi[d];
+    lo = int_lo[d] - tb->tile_ghost[d];
+    hi = int_hi[d] + tb->tile_ghost[d];
+    box_lo[d] = (lo > glo[d]) ? lo : glo[d];
+    box_hi[d] = (hi < ghi[d]) ? hi : ghi[d];
+  }
+}
+
+
+/*
+ * getGridBox() returns the lower corner and the strides of a full-grid
+ * data array.
+ */
+static void getGridBox(LSM_TiledBand *tb, int *lo, int *nx, int *nxy)
+{
+  Grid *g = tb->grid;
+
+  lo[0] = g->ilo_gb;  lo[1] = g->jlo_gb;  lo[2] = g->klo_gb;
+  *nx = (g->grid_dims_ghostbox)[0];
+  *nxy = (*nx)*(g->grid_dims_ghostbox)[1];
+}
+
+
+/*
+ * copyBox() copies the index range [lo,hi] from one array to another.
+ * Each array is described by the index of its first element and its
+ * strides in the j and k directions; esz is the size of an element.
+ */
+static void copyBox(
+  void *dst, const int *dst_lo, int dst_nx, int dst_nxy,
+  const void *src, const int *src_lo, int src_nx, int src_nxy,
+  const int *lo, const int *hi,
+  size_t esz)
+{
+  size_t len = (hi[0] - lo[0] + 1)*esz;
+  int j, k;
+
+  for (k = lo[2]; k <= hi[2]; k++) {
+    for (j = lo[1]; j <= hi[1]; j++) {
+      memcpy((char*) dst + ( (lo[0]-dst_lo[0]) + (j-dst_lo[1])*dst_nx
+                           + (k-dst_lo[2])*dst_nxy )*esz,
+             (const char*) src + ( (lo[0]-src_lo[0]) + (j-src_lo[1])*src_nx
+                                 + (k-src_lo[2])*src_nxy )*esz,
+             len);
+    }
+  }
+}
+
+
+/*
+ * fillBoxValue() sets the index range [lo,hi] of an array to a
+ * constant value.
+ */
+static void fillBoxValue(
+  LSMLIB_REAL *dst, const int *dst_lo, int dst_nx, int dst_nxy,
+  const int *lo, const int *hi,
+  LSMLIB_REAL value)
+{
+  LSMLIB_REAL *row;
+  int i, j, k;
+
+  for (k = lo[2]; k <= hi[2]; k++) {
+    for (j = lo[1]; j <= hi[1]; j++) {
+      row = dst + (lo[0]-dst_lo[0]) + (j-dst_lo[1])*dst_nx
+                + (k-dst_lo[2])*dst_nxy;
+      for (i = 0; i <= hi[0]-lo[0]; i++) row[i] = value;
+    }
+  }
+}
+
+
+/*
+ * scanInterior() finds the value with the smallest magnitude over the
+ * specified index range of a data array and checks if it is less than
+ * width or if the data changes sign within the index range.
+ */
+static void scanInterior(
+  const LSMLIB_REAL *data,
+  const int *data_lo, int nx, int nxy,
+  const int *lo, const int *hi,
+  LSMLIB_REAL width,
+  int *occupied,
+  signed char *sign)
+{
+  LSMLIB_REAL min_abs = DBL_MAX, abs_val;
+  int i, j, k, idx, num_neg = 0, num_pts = 0;
+
+  *sign = 1;
+  for (k = lo[2]; k <= hi[2]; k++) {
+    for (j = lo[1]; j <= hi[1]; j++) {
+      idx = (lo[0]-data_lo[0]) + (j-data_lo[1])*nx + (k-data_lo[2])*nxy;
+      for (i = lo[0]; i <= hi[0]; i++, idx++) {
+        abs_val = fabs(data[idx]);
+        if (abs_val < min_abs) {
+          min_abs = abs_val;
+          *sign = (data[idx] < 0) ? -1 : 1;
+        }
+        if (data[idx] < 0) num_neg++;
+      }
+      num_pts += hi[0] - lo[0] + 1;
+    }
+  }
+  *occupied = (min_abs < width) || ((num_neg > 0) && (num_neg < num_pts));
+}
+
+
+/*
+ * growTilePool() increases the number of slots in the tile memory pool.
+ */
+static void growTilePool(LSM_TiledBand *tb)
+{
+  int old_alloc = tb->num_alloc_slots;
+  int new_alloc = 2*old_alloc;
+  int f, s;
+
+  if (new_alloc < LSM_TILED_BAND_MIN_ALLOC_SLOTS)
+    new_alloc = LSM_TILED_BAND_MIN_ALLOC_SLOTS;
+  if (new_alloc > tb->num_tiles_total) new_alloc = tb->num_tiles_total;
+
+  for (f = 0; f < tb->num_fields; f++) {
+    if (!tb->field_enabled[f]) continue;
+    tb->field[f] = (LSMLIB_REAL*) realloc(tb->field[f],
+      ((size_t) new_alloc)*tb->tile_alloc_size*DSZ);
+  }
+  tb->narrow_band = (unsigned char*) realloc(tb->narrow_band,
+    ((size_t) new_alloc)*tb->tile_alloc_size*UCSZ);
+  tb->free_slots = (int*) realloc(tb->free_slots, new_alloc*ISZ);
+
+  /* new slots are pushed in reverse order so that they are used in order */
+  for (s = new_alloc-1; s >= old_alloc; s--) {
+    tb->free_slots[tb->num_free_slots++] = s;
+  }
+  tb->num_alloc_slots = new_alloc;
+}
+
+
+/*
+ * activateTile() assigns a slot in the tile memory pool to a tile and
+ * sets all of the fields on the tile to their background values.
+ */
+static void activateTile(LSM_TiledBand *tb, int tile)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3];
+  int nx, nxy, slot, f;
+
+  if (tb->num_free_slots == 0) growTilePool(tb);
+  slot = tb->free_slots[--(tb->num_free_slots)];
+  tb->tile_slot[tile] = slot;
+
+  getTileBoxes(tb,tile,int_lo,int_hi,box_lo,box_hi);
+  nx = int_hi[0] - int_lo[0] + 1;
+  nxy = nx*(int_hi[1] - int_lo[1] + 1);
+
+  for (f = 0; f < tb->num_fields; f++) {
+    if (!tb->field_enabled[f]) continue;
+    fillBoxValue(getTiledBandTileData(tb,f,tile),int_lo,nx,nxy,
+                 int_lo,int_hi,tb->tile_sign[tile]*tb->background[f]);
+  }
+  memset(getTiledBandTileNarrowBand(tb,tile), 0, tb->tile_alloc_size*UCSZ);
+  tb->tile_level[tile] = 0;
+}
+
+
+/*
+ * deactivateTile() returns the slot used by a tile to the memory pool.
+ */
+static void deactivateTile(LSM_TiledBand *tb, int tile)
+{
+  tb->free_slots[tb->num_free_slots++] = tb->tile_slot[tile];
+  tb->tile_slot[tile] = -1;
+  tb->tile_level[tile] = 0;
+}
+
+
+/*
+ * selectActiveTiles() activates all tiles that are occupied or within
+ * activate_neighbors tiles of an occupied tile (as marked in tile_flag)
+ * and, if release_tiles is non-zero, deactivates the rest.  Returns the
+ * number of tiles that changed state.
+ */
+static int selectActiveTiles(LSM_TiledBand *tb, int release_tiles)
+{
+  int t, n, tc[3], nc[3], oi, oj, ok, r[3], d;
+  int num_changed = 0;
+
+  for (d = 0; d < 3; d++) {
+    r[d] = (d < tb->num_dims) ? tb->activate_neighbors : 0;
+  }
+
+  /* dilate the set of occupied tiles by activate_neighbors tiles */
+  for (t = 0; t < tb->num_tiles_total; t++) {
+    if (!release_tiles && (tb->tile_slot[t] >= 0)) {
+      tb->tile_flag[t] |= LSM_TILED_BAND_WANTED;
+    }
+    if (!(tb->tile_flag[t] & LSM_TILED_BAND_OCCUPIED)) continue;
+
+    getTileCoords(tb,t,tc);
+    for (ok = -r[2]; ok <= r[2]; ok++) {
+      nc[2] = tc[2] + ok;
+      if ((nc[2] < 0) || (nc[2] >= tb->num_tiles[2])) continue;
+      for (oj = -r[1]; oj <= r[1]; oj++) {
+        nc[1] = tc[1] + oj;
+        if ((nc[1] < 0) || (nc[1] >= tb->num_tiles[1])) continue;
+        for (oi = -r[0]; oi <= r[0]; oi++) {
+          nc[0] = tc[0] + oi;
+          if ((nc[0] < 0) || (nc[0] >= tb->num_tiles[0])) continue;
+          n = nc[0] + nc[1]*tb->num_tiles[0]
+            + nc[2]*tb->num_tiles[0]*tb->num_tiles[1];
+          tb->tile_flag[n] |= LSM_TILED_BAND_WANTED;
+        }
+      }
+    }
+  }
+
+  /* release tiles first so that their slots can be reused */
+  for (t = 0; t < tb->num_tiles_total; t++) {
+    if ( (tb->tile_slot[t] >= 0) &&
+         !(tb->tile_flag[t] & LSM_TILED_BAND_WANTED) ) {
+      deactivateTile(tb,t);
+      num_changed++;
+    }
+  }
+
+  tb->num_active_tiles = 0;
+  for (t = 0; t < tb->num_tiles_total; t++) {
+    if (tb->tile_flag[t] & LSM_TILED_BAND_WANTED) {
+      if (tb->tile_slot[t] < 0) {
+        activateTile(tb,t);
+        num_changed++;
+      }
+      tb->active_tiles[tb->num_active_tiles++] = t;
+    }
+  }
+
+  return num_changed;
+}
+
+
+/*
+ * gatherTileGhostbox() gathers a field (or the narrow band levels if
+ * field < 0) over the ghostbox of a tile from the interiors of the tile
+ * and its neighbors.
+ */
+static void gatherTileGhostbox(
+  LSM_TiledBand *tb,
+  int field,
+  int tile,
+  void *data)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3];
+  int n_int_lo[3], n_int_hi[3], n_box_lo[3], n_box_hi[3];
+  int r_lo[3], r_hi[3], tc[3], nc[3], o[3];
+  int nx, nxy, n_nx, n_nxy, d, j, k, n;
+  size_t esz = (field < 0) ? UCSZ : DSZ;
+  void *n_data;
+
+  getTileBoxes(tb,tile,int_lo,int_hi,box_lo,box_hi);
+  getTileCoords(tb,tile,tc);
+  nx = box_hi[0] - box_lo[0] + 1;
+  nxy = nx*(box_hi[1] - box_lo[1] + 1);
+
+  for (o[2] = -1; o[2] <= 1; o[2]++) {
+    for (o[1] = -1; o[1] <= 1; o[1]++) {
+      for (o[0] = -1; o[0] <= 1; o[0]++) {
+
+        /* index range of the ghostbox owned by the tile at offset o */
+        for (d = 0; d < 3; d++) {
+          if (o[d] < 0) {
+            r_lo[d] = box_lo[d];     r_hi[d] = int_lo[d]-1;
+          } else if (o[d] > 0) {
+            r_lo[d] = int_hi[d]+1;   r_hi[d] = box_hi[d];
+          } else {
+            r_lo[d] = int_lo[d];     r_hi[d] = int_hi[d];
+          }
+          nc[d] = tc[d] + o[d];
+        }
+        if ( (r_lo[0] > r_hi[0]) || (r_lo[1] > r_hi[1]) ||
+             (r_lo[2] > r_hi[2]) ) continue;
+
+        n = nc[0] + nc[1]*tb->num_tiles[0]
+          + nc[2]*tb->num_tiles[0]*tb->num_tiles[1];
+
+        if (tb->tile_slot[n] >= 0) {
+          getTileBoxes(tb,n,n_int_lo,n_int_hi,n_box_lo,n_box_hi);
+          n_nx = n_int_hi[0] - n_int_lo[0] + 1;
+          n_nxy = n_nx*(n_int_hi[1] - n_int_lo[1] + 1);
+          if (field < 0) {
+            n_data = getTiledBandTileNarrowBand(tb,n);
+          } else {
+            n_data = getTiledBandTileData(tb,field,n);
+          }
+          copyBox(data,box_lo,nx,nxy,n_data,n_int_lo,n_nx,n_nxy,
+                  r_lo,r_hi,esz);
+        } else if (field < 0) {
+          for (k = r_lo[2]; k <= r_hi[2]; k++) {
+            for (j = r_lo[1]; j <= r_hi[1]; j++) {
+              memset((unsigned char*) data + (r_lo[0]-box_lo[0])
+                       + (j-box_lo[1])*nx + (k-box_lo[2])*nxy,
+                     0, (r_hi[0]-r_lo[0]+1)*UCSZ);
+            }
+          }
+        } else {
+          fillBoxValue((LSMLIB_REAL*) data,box_lo,nx,nxy,r_lo,r_hi,
+                       tb->tile_sign[n]*tb->background[field]);
+        }
+      }
+    }
+  }
+}
+
+
+/*====================== LSM_TiledBand Functions =======================*/
+
+LSM_TiledBand *createTiledBand(
+  Grid *grid,
+  int tile_size,
+  int num_fields)
+{
+  LSM_TiledBand *tb;
+  int glo[3], ghi[3];
+  int ghostcell_width = grid->ilo_fb - grid->ilo_gb;
+  int min_edge_size = ghostcell_width + 2;
+  int d, N, t, a, r;
+
+  if (tile_size < 2*ghostcell_width + 3) {
+    fprintf(stderr,
+      "ERROR: tile_size %d too small; must be at least %d\n",
+      tile_size, 2*ghostcell_width + 3);
+    return NULL;
+  }
+
+  tb = (LSM_TiledBand*) malloc(sizeof(LSM_TiledBand));
+  tb->grid = grid;
+  tb->num_dims = grid->num_dims;
+
+  glo[0] = grid->ilo_gb;  ghi[0] = grid->ihi_gb;
+  glo[1] = grid->jlo_gb;  ghi[1] = grid->jhi_gb;
+  glo[2] = grid->klo_gb;  ghi[2] = grid->khi_gb;
+
+  tb->num_tiles_total = 1;
+  tb->tile_alloc_size = 1;
+  tb->tile_box_size = 1;
+  for (d = 0; d < 3; d++) {
+    N = ghi[d] - glo[d] + 1;
+    if (d < tb->num_dims) {
+      tb->tile_dims[d] = tile_size;
+      tb->tile_ghost[d] = ghostcell_width;
+
+      /* shift the tiles so that the first tile has a cells and the
+         last tile has either tile_size or at least min_edge_size cells
+         (such a shift exists because tile_size >= 2*min_edge_size-1) */
+      for (a = tile_size; a > min_edge_size; a--) {
+        r = (N - a) % tile_size;
+        if ( (N <= a) || (r == 0) || (r >= min_edge_size) ) break;
+      }
+      tb->tile_origin[d] = glo[d] - (tile_size - a);
+    } else {
+      tb->tile_dims[d] = N;
+      tb->tile_ghost[d] = 0;
+      tb->tile_origin[d] = glo[d];
+    }
+    tb->num_tiles[d] = (ghi[d] - tb->tile_origin[d] + tb->tile_dims[d])
+                     / tb->tile_dims[d];
+    tb->num_tiles_total *= tb->num_tiles[d];
+    tb->tile_alloc_size *= tb->tile_dims[d];
+    tb->tile_box_size *= tb->tile_dims[d] + 2*tb->tile_ghost[d];
+  }
+
+  tb->tile_slot = (int*) malloc(tb->num_tiles_total*ISZ);
+  tb->tile_sign = (signed char*) malloc(tb->num_tiles_total);
+  tb->tile_level = (unsigned char*) calloc(tb->num_tiles_total,UCSZ);
+  tb->tile_flag = (unsigned char*) malloc(tb->num_tiles_total*UCSZ);
+  tb->active_tiles = (int*) malloc(tb->num_tiles_total*ISZ);
+  for (t = 0; t < tb->num_tiles_total; t++) {
+    tb->tile_slot[t] = -1;
+    tb->tile_sign[t] = 1;
+  }
+  tb->num_active_tiles = 0;
+
+  tb->num_alloc_slots = 0;
+  tb->free_slots = NULL;
+  tb->num_free_slots = 0;
+
+  tb->num_fields = num_fields;
+  tb->field = (LSMLIB_REAL**) calloc(num_fields,sizeof(LSMLIB_REAL*));
+  tb->field_enabled = (unsigned char*) malloc(num_fields*UCSZ);
+  memset(tb->field_enabled, 1, num_fields*UCSZ);
+  tb->background = (LSMLIB_REAL*) calloc(num_fields,DSZ);
+  tb->activate_neighbors = 1;
+  tb->narrow_band = NULL;
+
+  return tb;
+}
+
+
+void destroyTiledBand(LSM_TiledBand *tb)
+{
+  int f;
+
+  if (tb) {
+    for (f = 0; f < tb->num_fields; f++) free(tb->field[f]);
+    free(tb->field);
+    free(tb->field_enabled);
+    free(tb->background);
+    free(tb->narrow_band);
+    free(tb->tile_slot);
+    free(tb->tile_sign);
+    free(tb->tile_level);
+    free(tb->tile_flag);
+    free(tb->active_tiles);
+    free(tb->free_slots);
+    free(tb);
+  }
+}
+
+
+void setTiledBandBackgroundValue(
+  LSM_TiledBand *tb,
+  int field,
+  LSMLIB_REAL value)
+{
+  tb->background[field] = value;
+}
+
+
+void disableTiledBandField(
+  LSM_TiledBand *tb,
+  int field)
+{
+  free(tb->field[field]);
+  tb->field[field] = NULL;
+  tb->field_enabled[field] = 0;
+}
+
+
+void setTiledBandActivateNeighbors(
+  LSM_TiledBand *tb,
+  int activate_neighbors)
+{
+  tb->activate_neighbors = activate_neighbors;
+}
+
+
+int initializeTiledBandFromArray(
+  LSM_TiledBand *tb,
+  int field,
+  LSMLIB_REAL *data,
+  LSMLIB_REAL width)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3], glo[3];
+  int nx, nxy, t, occupied;
+
+  getGridBox(tb,glo,&nx,&nxy);
+
+  for (t = 0; t < tb->num_tiles_total; t++) {
+    if (tb->tile_slot[t] >= 0) deactivateTile(tb,t);
+
+    getTileBoxes(tb,t,int_lo,int_hi,box_lo,box_hi);
+    scanInterior(data,glo,nx,nxy,int_lo,int_hi,width,
+                 &occupied,&(tb->tile_sign[t]));
+    tb->tile_flag[t] = occupied ? LSM_TILED_BAND_OCCUPIED : 0;
+  }
+
+  selectActiveTiles(tb,1);
+  copyArrayToTiledBand(tb,field,data);
+
+  return tb->num_active_tiles;
+}
+
+
+int updateTiledBandActiveTiles(
+  LSM_TiledBand *tb,
+  int field,
+  LSMLIB_REAL width,
+  int release_tiles)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3];
+  int nx, nxy, l, t, occupied;
+
+  memset(tb->tile_flag, 0, tb->num_tiles_total*UCSZ);
+  for (l = 0; l < tb->num_active_tiles; l++) {
+    t = tb->active_tiles[l];
+    getTileBoxes(tb,t,int_lo,int_hi,box_lo,box_hi);
+    nx = int_hi[0] - int_lo[0] + 1;
+    nxy = nx*(int_hi[1] - int_lo[1] + 1);
+    scanInterior(getTiledBandTileData(tb,field,t),int_lo,nx,nxy,
+                 int_lo,int_hi,width,&occupied,&(tb->tile_sign[t]));
+    if (occupied) tb->tile_flag[t] = LSM_TILED_BAND_OCCUPIED;
+  }
+
+  return selectActiveTiles(tb,release_tiles);
+}
+
+
+void copyArrayToTiledBand(
+  LSM_TiledBand *tb,
+  int field,
+  LSMLIB_REAL *data)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3], glo[3];
+  int gnx, gnxy, nx, nxy, l, t;
+
+  getGridBox(tb,glo,&gnx,&gnxy);
+
+  for (l = 0; l < tb->num_active_tiles; l++) {
+    t = tb->active_tiles[l];
+    getTileBoxes(tb,t,int_lo,int_hi,box_lo,box_hi);
+    nx = int_hi[0] - int_lo[0] + 1;
+    nxy = nx*(int_hi[1] - int_lo[1] + 1);
+    copyBox(getTiledBandTileData(tb,field,t),int_lo,nx,nxy,
+            data,glo,gnx,gnxy,int_lo,int_hi,DSZ);
+  }
+}
+
+
+void copyTiledBandToArray(
+  LSM_TiledBand *tb,
+  int field,
+  LSMLIB_REAL *data)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3], glo[3];
+  int gnx, gnxy, nx, nxy, t;
+  LSMLIB_REAL *t_data;
+
+  getGridBox(tb,glo,&gnx,&gnxy);
+
+  for (t = 0; t < tb->num_tiles_total; t++) {
+    getTileBoxes(tb,t,int_lo,int_hi,box_lo,box_hi);
+    t_data = getTiledBandTileData(tb,field,t);
+    nx = int_hi[0] - int_lo[0] + 1;
+    nxy = nx*(int_hi[1] - int_lo[1] + 1);
+
+    if (t_data) {
+      copyBox(data,glo,gnx,gnxy,t_data,int_lo,nx,nxy,int_lo,int_hi,DSZ);
+    } else {
+      fillBoxValue(data,glo,gnx,gnxy,int_lo,int_hi,
+                   tb->tile_sign[t]*tb->background[field]);
+    }
+  }
+}
+
+
+void copyTiledBandField(
+  LSM_TiledBand *tb,
+  int field_dst,
+  int field_src)
+{
+  int l, t;
+
+  for (l = 0; l < tb->num_active_tiles; l++) {
+    t = tb->active_tiles[l];
+    memcpy(getTiledBandTileData(tb,field_dst,t),
+           getTiledBandTileData(tb,field_src,t),
+           tb->tile_alloc_size*DSZ);
+  }
+}
+
+
+void getTiledBandTileGhostboxData(
+  LSM_TiledBand *tb,
+  int field,
+  int tile,
+  LSMLIB_REAL *data)
+{
+  gatherTileGhostbox(tb,field,tile,data);
+}
+
+
+void setTiledBandTileInteriorData(
+  LSM_TiledBand *tb,
+  int field,
+  int tile,
+  LSMLIB_REAL *data,
+  unsigned char *narrow_band,
+  int level)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3];
+  int nx, nxy, t_nx, t_nxy, i, j, k, idx, t_idx;
+  LSMLIB_REAL *t_data = getTiledBandTileData(tb,field,tile);
+
+  getTileBoxes(tb,tile,int_lo,int_hi,box_lo,box_hi);
+  nx = box_hi[0] - box_lo[0] + 1;
+  nxy = nx*(box_hi[1] - box_lo[1] + 1);
+  t_nx = int_hi[0] - int_lo[0] + 1;
+  t_nxy = t_nx*(int_hi[1] - int_lo[1] + 1);
+
+  if (!narrow_band) {
+    copyBox(t_data,int_lo,t_nx,t_nxy,data,box_lo,nx,nxy,int_lo,int_hi,DSZ);
+    return;
+  }
+
+  t_idx = 0;
+  for (k = int_lo[2]; k <= int_hi[2]; k++) {
+    for (j = int_lo[1]; j <= int_hi[1]; j++) {
+      idx = (int_lo[0]-box_lo[0]) + (j-box_lo[1])*nx + (k-box_lo[2])*nxy;
+      for (i = int_lo[0]; i <= int_hi[0]; i++, idx++, t_idx++) {
+        if ( (narrow_band[idx] > 0) && (narrow_band[idx] <= level+1) ) {
+          t_data[t_idx] = data[idx];
+        }
+      }
+    }
+  }
+}
+
+
+void getTiledBandTileGhostboxNarrowBand(
+  LSM_TiledBand *tb,
+  int tile,
+  unsigned char *narrow_band)
+{
+  gatherTileGhostbox(tb,-1,tile,narrow_band);
+}
+
+
+int setTiledBandTileInteriorNarrowBand(
+  LSM_TiledBand *tb,
+  int tile,
+  unsigned char *narrow_band)
+{
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3];
+  int nx, nxy, t_nx, t_nxy, idx, num_pts;
+  unsigned char *t_nb = getTiledBandTileNarrowBand(tb,tile);
+  unsigned char min_level = 0;
+
+  getTileBoxes(tb,tile,int_lo,int_hi,box_lo,box_hi);
+  nx = box_hi[0] - box_lo[0] + 1;
+  nxy = nx*(box_hi[1] - box_lo[1] + 1);
+  t_nx = int_hi[0] - int_lo[0] + 1;
+  t_nxy = t_nx*(int_hi[1] - int_lo[1] + 1);
+  copyBox(t_nb,int_lo,t_nx,t_nxy,narrow_band,box_lo,nx,nxy,
+          int_lo,int_hi,UCSZ);
+
+  num_pts = t_nxy*(int_hi[2] - int_lo[2] + 1);
+  for (idx = 0; idx < num_pts; idx++) {
+    if ( (t_nb[idx] > 0) && ((min_level == 0) || (t_nb[idx] < min_level)) )
+      min_level = t_nb[idx];
+  }
+  tb->tile_level[tile] = min_level;
+
+  return min_level;
+}
+
+
+void clearTiledBandTileNarrowBand(
+  LSM_TiledBand *tb,
+  int tile)
+{
+  memset(getTiledBandTileNarrowBand(tb,tile), 0, tb->tile_alloc_size*UCSZ);
+  tb->tile_level[tile] = 0;
+}
+
+
+int isTiledBandTileNearOccupiedTile(
+  LSM_TiledBand *tb,
+  int tile,
+  int num_layers)
+{
+  int tc[3], lo[3], hi[3], nc[3], d;
+
+  getTileCoords(tb,tile,tc);
+  for (d = 0; d < 3; d++) {
+    lo[d] = tc[d] - num_layers;
+    hi[d] = tc[d] + num_layers;
+    if (lo[d] < 0) lo[d] = 0;
+    if (hi[d] >= tb->num_tiles[d]) hi[d] = tb->num_tiles[d] - 1;
+  }
+
+  for (nc[2] = lo[2]; nc[2] <= hi[2]; nc[2]++) {
+    for (nc[1] = lo[1]; nc[1] <= hi[1]; nc[1]++) {
+      for (nc[0] = lo[0]; nc[0] <= hi[0]; nc[0]++) {
+        if (tb->tile_flag[nc[0] + nc[1]*tb->num_tiles[0]
+                          + nc[2]*tb->num_tiles[0]*tb->num_tiles[1]]
+            & LSM_TILED_BAND_OCCUPIED) return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+
+void getTiledBandTileGrid(
+  LSM_TiledBand *tb,
+  int tile,
+  Grid *tile_grid)
+{
+  Grid *g = tb->grid;
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3];
+  int fb_lo[3], fb_hi[3], lo[3], hi[3];
+  int *grid_box[4], *tile_box[4];
+  int b, d;
+
+  getTileBoxes(tb,tile,int_lo,int_hi,box_lo,box_hi);
+  *tile_grid = *g;
+
+  /* ghostbox */
+  tile_grid->ilo_gb = box_lo[0];  tile_grid->ihi_gb = box_hi[0];
+  tile_grid->jlo_gb = box_lo[1];  tile_grid->jhi_gb = box_hi[1];
+  tile_grid->klo_gb = box_lo[2];  tile_grid->khi_gb = box_hi[2];
+
+  /* fillbox and fillboxes for undivided differences; the boxes are
+     stored as (ilo, ihi, jlo, jhi, klo, khi) in the Grid structure */
+  fb_lo[0] = g->ilo_fb;  fb_hi[0] = g->ihi_fb;
+  fb_lo[1] = g->jlo_fb;  fb_hi[1] = g->jhi_fb;
+  fb_lo[2] = g->klo_fb;  fb_hi[2] = g->khi_fb;
+
+  grid_box[0] = &(g->ilo_fb);     tile_box[0] = &(tile_grid->ilo_fb);
+  grid_box[1] = &(g->ilo_D1_fb);  tile_box[1] = &(tile_grid->ilo_D1_fb);
+  grid_box[2] = &(g->ilo_D2_fb);  tile_box[2] = &(tile_grid->ilo_D2_fb);
+  grid_box[3] = &(g->ilo_D3_fb);  tile_box[3] = &(tile_grid->ilo_D3_fb);
+
+  for (b = 0; b < 4; b++) {
+    for (d = 0; d < tb->num_dims; d++) {
+      lo[d] = int_lo[d] - (fb_lo[d] - grid_box[b][2*d]);
+      hi[d] = int_hi[d] + (grid_box[b][2*d+1] - fb_hi[d]);
+      tile_box[b][2*d]   = (lo[d] > grid_box[b][2*d]) ?
+                           lo[d] : grid_box[b][2*d];
+      tile_box[b][2*d+1] = (hi[d] < grid_box[b][2*d+1]) ?
+                           hi[d] : grid_box[b][2*d+1];
+    }
+  }
+
+  tile_grid->grid_dims_ghostbox[0] = box_hi[0] - box_lo[0] + 1;
+  tile_grid->grid_dims_ghostbox[1] = box_hi[1] - box_lo[1] + 1;
+  tile_grid->grid_dims_ghostbox[2] = box_hi[2] - box_lo[2] + 1;
+  tile_grid->num_gridpts = (tile_grid->grid_dims_ghostbox)[0]
+                         * (tile_grid->grid_dims_ghostbox)[1]
+                         * (tile_grid->grid_dims_ghostbox)[2];
+}
+
+
+void getTiledBandTileInterior(
+  LSM_TiledBand *tb,
+  int tile,
+  int *lo,
+  int *hi)
+{
+  int box_lo[3], box_hi[3];
+  getTileBoxes(tb,tile,lo,hi,box_lo,box_hi);
+}
+
+
+LSMLIB_REAL *getTiledBandTileData(
+  LSM_TiledBand *tb,
+  int field,
+  int tile)
+{
+  if (tb->tile_slot[tile] < 0) return NULL;
+  return tb->field[field] + ((size_t) tb->tile_slot[tile])*tb->tile_alloc_size;
+}
+
+
+unsigned char *getTiledBandTileNarrowBand(
+  LSM_TiledBand *tb,
+  int tile)
+{
+  if (tb->tile_slot[tile] < 0) return NULL;
+  return tb->narrow_band
+       + ((size_t) tb->tile_slot[tile])*tb->tile_alloc_size;
+}
+
+
+int getTiledBandTileNarrowBandIndices(
+  LSM_TiledBand *tb,
+  int tile,
+  int level,
+  int fillbox_only,
+  int *index_x,
+  int *index_y,
+  int *index_z)
+{
+  Grid *g = tb->grid;
+  int int_lo[3], int_hi[3], box_lo[3], box_hi[3], lo[3], hi[3];
+  int nx, nxy, i, j, k, idx, num_pts = 0;
+  unsigned char *nb = getTiledBandTileNarrowBand(tb,tile);
+  unsigned char max_nb = (unsigned char) (level+1);
+
+  getTileBoxes(tb,tile,int_lo,int_hi,box_lo,box_hi);
+  nx = int_hi[0] - int_lo[0] + 1;
+  nxy = nx*(int_hi[1] - int_lo[1] + 1);
+
+  lo[0] = int_lo[0];  lo[1] = int_lo[1];  lo[2] = int_lo[2];
+  hi[0] = int_hi[0];  hi[1] = int_hi[1];  hi[2] = int_hi[2];
+  if (fillbox_only) {
+    if (lo[0] < g->ilo_fb) lo[0] = g->ilo_fb;
+    if (hi[0] > g->ihi_fb) hi[0] = g->ihi_fb;
+    if (lo[1] < g->jlo_fb) lo[1] = g->jlo_fb;
+    if (hi[1] > g->jhi_fb) hi[1] = g->jhi_fb;
+    if (tb->num_dims == 3) {
+      if (lo[2] < g->klo_fb) lo[2] = g->klo_fb;
+      if (hi[2] > g->khi_fb) hi[2] = g->khi_fb;
+    }
+  }
+
+  for (k = lo[2]; k <= hi[2]; k++) {
+    for (j = lo[1]; j <= hi[1]; j++) {
+      idx = (lo[0]-int_lo[0]) + (j-int_lo[1])*nx + (k-int_lo[2])*nxy;
+      for (i = lo[0]; i <= hi[0]; i++, idx++) {
+        if ( (nb[idx] > 0) && (nb[idx] <= max_nb) ) {
+          index_x[num_pts] = i;
+          index_y[num_pts] = j;
+          if (index_z) index_z[num_pts] = k;
+          num_pts++;
+        }
+      }
+    }
+  }
+
+  return num_pts;
+}
@@ -0,0 +1,657 @@
+/*
+ * File:        lsm_tiled_band.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for LSM_TiledBand data structure and functions
+ *              that support sparse (tiled) narrow band storage for serial
+ *              LSMLIB calculations
+ */
+
+#ifndef included_lsm_tiled_band_h
+#define included_lsm_tiled_band_h
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_tiled_band.h
+ *
+ * \brief
+ * @ref lsm_tiled_band.h provides support for storing the data arrays of
+ * localized (narrow band) level set method calculations in a block-sparse
+ * format so that the memory requirements scale with the size of the
+ * interface rather than the size of the computational grid.
+ *
+ * The index space of the Grid (including ghostcells) is partitioned into
+ * tiles of tile_size^3 (tile_size^2 in 2D) grid cells.  Only tiles
+ * that are "active" (i.e. that contain part of the narrow band or are
+ * near such tiles) are allocated, and each active tile stores
+ * only the grid cells it owns (its interior) for every field.  The 
+ * localized Fortran kernels (*_LOCAL) are applied to one tile at a time
+ * on a scratch array that covers the ghostbox of the tile (the interior
+ * grown by the ghostcell width of the Grid and clipped to the ghostbox 
+ * of the Grid): getTiledBandTileGhostboxData() gathers the data from the
+ * tile and its neighbors into the scratch array and 
+ * setTiledBandTileInteriorData() copies the result back into the tile.
+ * Because the ghostbox of a tile is expressed in the (global) index 
+ * space of the Grid, the kernels can be used without modification by 
+ * passing the tile ghostbox as the array bounds (see 
+ * getTiledBandTileGrid()).
+ *
+ * Within inactive tiles, the value of field f is (sign * background[f]),
+ * where sign is the sign of the tile when it was released.  No full-grid
+ * array is kept, so a calculation that uses a LSM_TiledBand must leave
+ * every field equal to (sign * background) at the grid points it 
+ * considers to be outside of the narrow band before tiles are released
+ * (see updateTiledBandActiveTiles()).
+ *
+ * <h3> NOTES: </h3>
+ * - Tiles are laid out so that the first and the last tile in each 
+ *   coordinate direction have at least (ghostcell width + 2) interior 
+ *   grid cells.  The ghostcells of the Grid within a tile and the two 
+ *   layers of the fillbox that linear extrapolation boundary conditions
+ *   use to fill them then belong to the same tile.  The tile_size must 
+ *   be at least (2*ghostcell width + 3).
+ *
+ * - The memory pool for the tiles may be reallocated when tiles are
+ *   activated, so pointers returned by getTiledBandTileData() and
+ *   getTiledBandTileNarrowBand() should not be used after a call to
+ *   initializeTiledBandFromArray() or updateTiledBandActiveTiles().
+ *
+ */
+
+#include "lsm_grid.h"
+
+
+/*!
+ * Structure 'LSM_TiledBand' stores the tile layout and the data for
+ * a set of fields defined on the active tiles of a Grid.
+ */
+typedef struct _LSM_TiledBand
+{
+  /* Grid the tiles are defined on (NOT owned by the LSM_TiledBand) */
+  Grid   *grid;
+  int    num_dims;
+
+  /* number of interior grid cells and ghostcells of a tile in each
+     coordinate direction (1 and 0 for the unused direction in 2D) */
+  int    tile_dims[3];
+  int    tile_ghost[3];
+
+  /* index of the lower corner of the first tile in each direction */
+  int    tile_origin[3];
+
+  /* number of tiles in each direction and in total */
+  int    num_tiles[3];
+  int    num_tiles_total;
+
+  /* number of grid points stored for each tile (the tile interior) and
+     largest number of grid points in the ghostbox of a tile */
+  int    tile_alloc_size;
+  int    tile_box_size;
+
+  /* tile_slot[t] is the slot in the memory pool used by tile t (-1 if
+     tile t is not active); tile_sign[t] is the sign of the fields in
+     tile t when it is not active; tile_level[t] is the lowest narrow 
+     band level in the interior of tile t plus one (0 if there are no
+     narrow band points in the tile) */
+  int           *tile_slot;
+  signed char   *tile_sign;
+  unsigned char *tile_level;
+
+  /* list of active tiles (in increasing tile order) */
+  int    *active_tiles;
+  int    num_active_tiles;
+
+  /* memory pool bookkeeping */
+  int    num_alloc_slots;
+  int    *free_slots;
+  int    num_free_slots;
+
+  /* field data: field[f] holds num_alloc_slots*tile_alloc_size values
+     (no memory is allocated for fields with field_enabled[f] == 0);
+     background[f] is the magnitude of field f within inactive tiles */
+  int           num_fields;
+  LSMLIB_REAL   **field;
+  unsigned char *field_enabled;
+  LSMLIB_REAL   *background;
+
+  /* number of layers of neighboring tiles activated around occupied 
+     tiles (0 to activate only the occupied tiles) */
+  int    activate_neighbors;
+
+  /* narrow band levels (see LSM3D_DETERMINE_NARROW_BAND) for each tile */
+  unsigned char *narrow_band;
+
+  /* flags set when updating active tiles (which tiles are occupied
+     is kept until the next update) */
+  unsigned char *tile_flag;
+
+} LSM_TiledBand;
+
+
+/*!
+ * createTiledBand() allocates a LSM_TiledBand data structure for the
+ * specified Grid with no active tiles.
+ *
+ * Arguments:
+ *  - grid (in):        pointer to Grid
+ *  - tile_size (in):   number of interior grid cells of a tile in each
+ *                      coordinate direction
+ *  - num_fields (in):  number of fields stored in each tile
+ *
+ * Return value:        pointer to LSM_TiledBand structure (NULL if
+ *                      tile_size is too small)
+ *
+ * NOTES:
+ * - The ghostcell width of the tiles is taken to be the width of the
+ *   ghostcell layer of the Grid (i.e. grid->ilo_fb - grid->ilo_gb).
+ *
+ * - The background values of all fields are initialized to 0.  Use
+ *   setTiledBandBackgroundValue() to change them.
+ *
+ * - All fields are enabled and one layer of neighbors of occupied 
+ *   tiles is activated (see disableTiledBandField() and 
+ *   setTiledBandActivateNeighbors()).
+ *
+ * - The Grid must not be destroyed before the LSM_TiledBand.
+ *
+ */
+LSM_TiledBand *createTiledBand(
+  Grid *grid,
+  int tile_size,
+  int num_fields);
+
+
+/*!
+ * destroyTiledBand() frees ALL memory allocated for the LSM_TiledBand
+ * structure (except for the Grid).
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *
+ * Return value:        none
+ *
+ */
+void destroyTiledBand(LSM_TiledBand *tiled_band);
+
+
+/*!
+ * setTiledBandBackgroundValue() sets the magnitude of the specified field
+ * within inactive tiles.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - field (in):           field index
+ *  - value (in):           background value (magnitude) of field
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - The background value of the field used to select the active tiles
+ *   should be at least the width passed to initializeTiledBandFromArray()
+ *   and updateTiledBandActiveTiles() so that inactive tiles never contain
+ *   narrow band points.
+ *
+ */
+void setTiledBandBackgroundValue(
+  LSM_TiledBand *tiled_band,
+  int field,
+  LSMLIB_REAL value);
+
+
+/*!
+ * disableTiledBandField() releases the memory of a field and stops
+ * allocating memory for it when tiles are activated.  A disabled field
+ * must not be accessed.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - field (in):           field index
+ *
+ * Return value:            none
+ *
+ */
+void disableTiledBandField(
+  LSM_TiledBand *tiled_band,
+  int field);
+
+
+/*!
+ * setTiledBandActivateNeighbors() sets the number of layers of 
+ * neighboring tiles (including diagonal neighbors) that are activated
+ * around occupied tiles.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):      pointer to LSM_TiledBand
+ *  - activate_neighbors (in):  number of layers of neighboring tiles
+ *                              (0 to activate only the occupied tiles;
+ *                              the default is 1)
+ *
+ * Return value:                none
+ *
+ * NOTES:
+ * - Neighbors need not be activated for data that is only read at 
+ *   grid points where the data itself is small (e.g. a mask that is
+ *   a signed distance function).
+ *
+ * - A calculation that keeps the data at grid points up to n grid cells
+ *   away from the occupied tiles should activate ceil(n/tile_size) 
+ *   layers.
+ *
+ */
+void setTiledBandActivateNeighbors(
+  LSM_TiledBand *tiled_band,
+  int activate_neighbors);
+
+
+/*!
+ * initializeTiledBandFromArray() selects the active tiles using the
+ * values of a full-grid data array and copies the data array into the
+ * specified field of the tiled band.
+ *
+ * A tile is occupied if |data| < width at any of its interior grid
+ * points or if data changes sign within its interior.  All occupied 
+ * tiles and the layers of neighboring tiles around them (see 
+ * setTiledBandActivateNeighbors()) are activated.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - field (in):           field to copy data into
+ *  - data (in):            full-grid data array
+ *  - width (in):           width of the narrow band
+ *
+ * Return value:            number of active tiles
+ *
+ * NOTES:
+ * - Any previously active tiles are deactivated first.  The remaining
+ *   fields in the active tiles are set to (sign * background value).
+ *
+ * - The sign of every tile is set from the grid point in the tile
+ *   interior where |data| is smallest.  Tiles that are not occupied 
+ *   have a single sign, so inactive tiles are set to 
+ *   (sign * background value) consistently with data as long as the
+ *   background value is at least width.
+ *
+ */
+int initializeTiledBandFromArray(
+  LSM_TiledBand *tiled_band,
+  int field,
+  LSMLIB_REAL *data,
+  LSMLIB_REAL width);
+
+
+/*!
+ * updateTiledBandActiveTiles() updates the set of active tiles using the
+ * current values of the specified field.
+ *
+ * Active tiles are selected as in initializeTiledBandFromArray().  If
+ * release_tiles is non-zero, tiles that are no longer needed are 
+ * released (their sign is set from the data in the tile); otherwise,
+ * tiles are only activated.  Newly activated tiles have all of their 
+ * fields set to (sign * background value).
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - field (in):           field used to select the active tiles
+ *  - width (in):           width of the narrow band
+ *  - release_tiles (in):   release tiles that are no longer needed 
+ *                          (1) or not (0)
+ *
+ * Return value:            number of tiles activated or deactivated
+ *
+ * NOTES:
+ * - All fields of a released tile are replaced by 
+ *   (sign * background value).  Released tiles contain no grid points
+ *   within activate_neighbors tiles of an occupied tile, so this is 
+ *   lossless if the calculation has set the fields to these values at
+ *   all grid points that far from its narrow band.  Calculations that compare a field
+ *   over a period of time (e.g. with the level set function at the
+ *   start of the period) should only release tiles at the start of 
+ *   the period.
+ *
+ * - The narrow band levels of newly activated tiles are set to 0.
+ *
+ */
+int updateTiledBandActiveTiles(
+  LSM_TiledBand *tiled_band,
+  int field,
+  LSMLIB_REAL width,
+  int release_tiles);
+
+
+/*!
+ * copyArrayToTiledBand() copies a full-grid data array into the specified
+ * field on all active tiles.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - field (in):           field index
+ *  - data (in):            full-grid data array
+ *
+ * Return value:            none
+ *
+ */
+void copyArrayToTiledBand(
+  LSM_TiledBand *tiled_band,
+  int field,
+  LSMLIB_REAL *data);
+
+
+/*!
+ * copyTiledBandToArray() copies the specified field into a full-grid
+ * data array.  Grid points in inactive tiles are set to 
+ * (sign * background value).
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *  - field (in):       field index
+ *  - data (out):       full-grid data array
+ *
+ * Return value:        none
+ *
+ */
+void copyTiledBandToArray(
+  LSM_TiledBand *tiled_band,
+  int field,
+  LSMLIB_REAL *data);
+
+
+/*!
+ * copyTiledBandField() copies one field into another on all active
+ * tiles.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - field_dst (in):       index of destination field
+ *  - field_src (in):       index of source field
+ *
+ * Return value:            none
+ *
+ */
+void copyTiledBandField(
+  LSM_TiledBand *tiled_band,
+  int field_dst,
+  int field_src);
+
+
+/*!
+ * getTiledBandTileGhostboxData() gathers the specified field over the
+ * ghostbox of a tile from the tile and its neighbors.
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *  - field (in):       field index
+ *  - tile (in):        tile index
+ *  - data (out):       array over the tile ghostbox (see 
+ *                      getTiledBandTileGrid())
+ *
+ * Return value:        none
+ *
+ * NOTES:
+ * - data must be large enough to hold tile_box_size values.
+ *
+ */
+void getTiledBandTileGhostboxData(
+  LSM_TiledBand *tiled_band,
+  int field,
+  int tile,
+  LSMLIB_REAL *data);
+
+
+/*!
+ * setTiledBandTileInteriorData() copies the interior of an array over
+ * the ghostbox of a tile into the specified field of the tile.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - field (in):           field index
+ *  - tile (in):            tile index
+ *  - data (in):            array over the tile ghostbox
+ *  - narrow_band (in):     narrow band array over the tile ghostbox 
+ *                          (NULL to copy all interior grid points)
+ *  - level (in):           highest narrow band level copied
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - If narrow_band is not NULL, only grid points where 
+ *   0 < narrow_band <= level+1 are copied, so grid points that have 
+ *   been marked with LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER() keep their
+ *   values.
+ *
+ */
+void setTiledBandTileInteriorData(
+  LSM_TiledBand *tiled_band,
+  int field,
+  int tile,
+  LSMLIB_REAL *data,
+  unsigned char *narrow_band,
+  int level);
+
+
+/*!
+ * getTiledBandTileGhostboxNarrowBand() gathers the narrow band levels
+ * over the ghostbox of a tile from the tile and its neighbors.  Grid 
+ * points in inactive tiles are not in the narrow band (level value 0).
+ *
+ * Arguments:
+ *  - tiled_band (in):    pointer to LSM_TiledBand
+ *  - tile (in):          tile index
+ *  - narrow_band (out):  narrow band array over the tile ghostbox
+ *
+ * Return value:          none
+ *
+ */
+void getTiledBandTileGhostboxNarrowBand(
+  LSM_TiledBand *tiled_band,
+  int tile,
+  unsigned char *narrow_band);
+
+
+/*!
+ * setTiledBandTileInteriorNarrowBand() stores the narrow band levels of
+ * the interior of a tile from a narrow band array over the tile ghostbox
+ * (e.g. as computed by LSM3D_DETERMINE_NARROW_BAND) and updates 
+ * tile_level for the tile.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - tile (in):            tile index
+ *  - narrow_band (in):     narrow band array over the tile ghostbox
+ *
+ * Return value:            lowest narrow band level in the tile interior
+ *                          plus one (0 if the tile interior contains no
+ *                          narrow band points)
+ *
+ */
+int setTiledBandTileInteriorNarrowBand(
+  LSM_TiledBand *tiled_band,
+  int tile,
+  unsigned char *narrow_band);
+
+
+/*!
+ * clearTiledBandTileNarrowBand() sets the narrow band levels of the
+ * interior of a tile to 0 (not in the narrow band) and sets tile_level
+ * for the tile to 0.
+ *
+ * Arguments:
+ *  - tiled_band (in/out):  pointer to LSM_TiledBand
+ *  - tile (in):            tile index
+ *
+ * Return value:            none
+ *
+ */
+void clearTiledBandTileNarrowBand(
+  LSM_TiledBand *tiled_band,
+  int tile);
+
+
+/*!
+ * isTiledBandTileNearOccupiedTile() checks if a tile is occupied or 
+ * within the specified number of layers of neighboring tiles of an
+ * occupied tile.  Tiles are occupied as determined by the last call to 
+ * initializeTiledBandFromArray() or updateTiledBandActiveTiles().
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *  - tile (in):        tile index
+ *  - num_layers (in):  number of layers of neighboring tiles
+ *
+ * Return value:        1 if the tile is near an occupied tile; 0 
+ *                      otherwise
+ *
+ * NOTES:
+ * - Narrow band points (see LSM3D_DETERMINE_NARROW_BAND) can only be
+ *   found in tiles that are within one layer of an occupied tile if
+ *   the width used to select the occupied tiles is the width of narrow
+ *   band level 0 and tile_size is larger than the number of narrow band
+ *   levels.
+ *
+ */
+int isTiledBandTileNearOccupiedTile(
+  LSM_TiledBand *tiled_band,
+  int tile,
+  int num_layers);
+
+
+/*!
+ * getTiledBandTileGrid() sets up a Grid structure that describes the
+ * index space of a single tile.  The Grid may be passed to the
+ * localized Fortran kernels and to the boundary condition functions
+ * together with data gathered by getTiledBandTileGhostboxData().
+ *
+ * The ghostbox of the tile Grid is the ghostbox of the tile, the fillbox
+ * is the intersection of the tile interior with the fillbox of the Grid,
+ * and the fillboxes for the undivided differences are the tile interior
+ * grown by the same number of cells as in the Grid (and clipped to the
+ * corresponding fillboxes of the Grid).
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *  - tile (in):        tile index
+ *  - tile_grid (out):  Grid structure for the tile
+ *
+ * Return value:        none
+ *
+ * NOTES:
+ * - tile_grid is assumed to be allocated by the user.  All of the data
+ *   fields of tile_grid that are not related to the index space are
+ *   copied from the Grid.
+ *
+ * - The fillbox of tile_grid is empty (lo > hi) for tiles that contain
+ *   only ghostcells of the Grid.
+ *
+ */
+void getTiledBandTileGrid(
+  LSM_TiledBand *tiled_band,
+  int tile,
+  Grid *tile_grid);
+
+
+/*!
+ * getTiledBandTileInterior() returns the index range of the interior of
+ * a tile (i.e. the grid cells owned by the tile).
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *  - tile (in):        tile index
+ *  - lo (out):         lower corner of tile interior (array of 3 integers)
+ *  - hi (out):         upper corner of tile interior (array of 3 integers)
+ *
+ * Return value:        none
+ *
+ */
+void getTiledBandTileInterior(
+  LSM_TiledBand *tiled_band,
+  int tile,
+  int *lo,
+  int *hi);
+
+
+/*!
+ * getTiledBandTileData() returns a pointer to the data of the specified
+ * field on a tile.  The data is stored over the tile interior in the
+ * usual (i fastest) order.
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *  - field (in):       field index
+ *  - tile (in):        tile index
+ *
+ * Return value:        pointer to tile data (NULL if the tile is not
+ *                      active)
+ *
+ */
+LSMLIB_REAL *getTiledBandTileData(
+  LSM_TiledBand *tiled_band,
+  int field,
+  int tile);
+
+
+/*!
+ * getTiledBandTileNarrowBand() returns a pointer to the narrow band
+ * level array of a tile (stored over the tile interior).
+ *
+ * Arguments:
+ *  - tiled_band (in):  pointer to LSM_TiledBand
+ *  - tile (in):        tile index
+ *
+ * Return value:        pointer to narrow band array (NULL if the tile
+ *                      is not active)
+ *
+ */
+unsigned char *getTiledBandTileNarrowBand(
+  LSM_TiledBand *tiled_band,
+  int tile);
+
+
+/*!
+ * getTiledBandTileNarrowBandIndices() builds the index arrays of the
+ * narrow band points of levels 0 through level in the interior of a
+ * tile from the narrow band levels stored for the tile.
+ *
+ * Arguments:
+ *  - tiled_band (in):    pointer to LSM_TiledBand
+ *  - tile (in):          tile index
+ *  - level (in):         highest narrow band level
+ *  - fillbox_only (in):  only include points in the fillbox of the 
+ *                        Grid (1) or include the ghostcells of the
+ *                        Grid as well (0)
+ *  - index_[xyz] (out):  coordinates of narrow band points
+ *
+ * Return value:          number of narrow band points
+ *
+ * NOTES:
+ * - The index arrays must be large enough to hold tile_alloc_size 
+ *   points (index_z is not used in 2D).
+ *
+ * - Points are ordered with i changing fastest.
+ *
+ * - The narrow band array of the tile (see 
+ *   getTiledBandTileNarrowBand()) can be passed to the localized 
+ *   Fortran kernels together with the index arrays: its values at
+ *   the listed points are at most level+1, so no point is skipped.
+ *
+ */
+int getTiledBandTileNarrowBandIndices(
+  LSM_TiledBand *tiled_band,
+  int tile,
+  int level,
+  int fillbox_only,
+  int *index_x,
+  int *index_y,
+  int *index_z);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,444 @@
+/*
+ * File:        FMM_BucketQueue.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: C bucketed priority queue library for supporting fast
+ *              marching method
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <float.h>
+#include <limits.h>
+#include "FMM_BucketQueue.h"
+
+#include "LSMLIB_config.h"
+
+/*
+ * FMM_BucketQueue Constants
+ */
+#define DEFAULT_NODE_MEM_SIZE  (64)
+#define DEFAULT_NUM_BUCKETS    (64)         /* MUST be a power of 2 */
+#define MAX_NUM_BUCKETS        (1 << 22)    /* MUST be a power of 2 */
+#define MAX_BUCKET             (INT_MAX - MAX_NUM_BUCKETS)
+#define OVERFLOW_BUCKET        (-1)
+#define NULL_NODE              (-1)
+
+
+/*
+ * FMM_BucketQueueNode stores the linear grid index and value of a node
+ * along with the links for the doubly-linked list of nodes in the
+ * bucket that contains it.  For nodes that are not in the queue,
+ * "next" links the list of free nodes.
+ */
+typedef struct FMM_BucketQueueNode {
+  int idx;                /* linear grid index                       */
+  LSMLIB_REAL value;      /* function value                          */
+  int bucket;             /* absolute bucket number (or overflow)    */
+  int prev;               /* previous node in bucket                 */
+  int next;               /* next node in bucket (or free list)      */
+} FMM_BucketQueueNode;
+
+/*
+ * Definition of FMM_BucketQueue structure.
+ *
+ * NOTE: all nodes in the bucket array have absolute bucket numbers in
+ *       the range [d_cur_bucket, d_cur_bucket + d_num_buckets) and
+ *       are stored in position (bucket & (d_num_buckets-1)).
+ */
+struct FMM_BucketQueue {
+  LSMLIB_REAL d_bucket_width;
+  LSMLIB_REAL d_inv_bucket_width;
+  int* d_buckets;
+  int d_num_buckets;
+  int d_cur_bucket;
+  int d_max_bucket;
+  int d_overflow;
+  FMM_BucketQueueNode* d_nodes;
+  int d_node_mem_size;
+  int d_num_nodes_used;
+  int d_free_list;
+  int d_bucket_size;
+  int d_overflow_size;
+};
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * FMM_BucketQueue_allocateNode() returns the handle of an unused node,
+ * growing the node array if necessary.
+ */
+static int FMM_BucketQueue_allocateNode(FMM_BucketQueue* queue);
+
+/*
+ * FMM_BucketQueue_growBuckets() increases the size of the bucket array
+ * so that it can hold at least num_buckets buckets.
+ */
+static void FMM_BucketQueue_growBuckets(FMM_BucketQueue* queue,
+  int num_buckets);
+
+/*
+ * FMM_BucketQueue_link() places the specified node in the appropriate
+ * bucket for its value.
+ */
+static void FMM_BucketQueue_link(FMM_BucketQueue* queue, int node_handle);
+
+/*
+ * FMM_BucketQueue_unlink() removes the specified node from its bucket.
+ */
+static void FMM_BucketQueue_unlink(FMM_BucketQueue* queue, int node_handle);
+
+/*
+ * FMM_BucketQueue_rebaseOverflow() moves nodes from the overflow list
+ * into the bucket array when the bucket array is empty.
+ */
+static void FMM_BucketQueue_rebaseOverflow(FMM_BucketQueue* queue);
+
+
+/*================== FMM_BucketQueue Functions ==================*/
+
+FMM_BucketQueue* FMM_BucketQueue_createBucketQueue(
+  LSMLIB_REAL bucket_width,
+  int node_mem_size)
+{
+  FMM_BucketQueue* queue;
+  int i;
+
+  /* check that the bucket width is valid */
+  if (bucket_width <= 0) {
+    fprintf(stderr,
+            "ERROR: FMM_BucketQueue bucket width must be positive.\n");
+    return 0;
+  }
+
+  queue = (FMM_BucketQueue*) malloc(sizeof(FMM_BucketQueue));
+  if (!queue) return 0;
+
+  if (node_mem_size <= 0) node_mem_size = DEFAULT_NODE_MEM_SIZE;
+
+  queue->d_bucket_width = bucket_width;
+  queue->d_inv_bucket_width = 1.0/bucket_width;
+  queue->d_num_buckets = DEFAULT_NUM_BUCKETS;
+  queue->d_buckets = (int*) malloc(DEFAULT_NUM_BUCKETS*sizeof(int));
+  for (i = 0; i < DEFAULT_NUM_BUCKETS; i++) {
+    queue->d_buckets[i] = NULL_NODE;
+  }
+  queue->d_node_mem_size = node_mem_size;
+  queue->d_nodes = (FMM_BucketQueueNode*)
+    malloc(node_mem_size*sizeof(FMM_BucketQueueNode));
+
+  FMM_BucketQueue_clear(queue);
+
+  return queue;
+}
+
+
+void FMM_BucketQueue_destroyBucketQueue(FMM_BucketQueue* queue)
+{
+  if (queue) {
+    free(queue->d_buckets);
+    free(queue->d_nodes);
+    free(queue);
+  }
+}
+
+
+int FMM_BucketQueue_insertNode(FMM_BucketQueue* queue, int idx,
+  LSMLIB_REAL value)
+{
+  int node_handle = FMM_BucketQueue_allocateNode(queue);
+  FMM_BucketQueueNode* node = &(queue->d_nodes[node_handle]);
+
+  node->idx = idx;
+  node->value = value;
+  FMM_BucketQueue_link(queue, node_handle);
+
+  return node_handle;
+}
+
+
+int FMM_BucketQueue_extractMin(FMM_BucketQueue* queue, LSMLIB_REAL* value)
+{
+  int *buckets;
+  int mask;
+  int node_handle;
+  FMM_BucketQueueNode* node;
+
+  /* nothing to extract from an empty queue */
+  if ( (0 == queue->d_bucket_size) && (0 == queue->d_overflow_size) ) {
+    return NULL_NODE;
+  }
+
+  /* move overflow nodes into bucket array if it is empty */
+  if (0 == queue->d_bucket_size) {
+    FMM_BucketQueue_rebaseOverflow(queue);
+  }
+
+  if (queue->d_bucket_size > 0) {
+
+    /* advance to the lowest non-empty bucket */
+    buckets = queue->d_buckets;
+    mask = queue->d_num_buckets-1;
+    while (NULL_NODE == buckets[queue->d_cur_bucket & mask]) {
+      queue->d_cur_bucket++;
+    }
+    node_handle = buckets[queue->d_cur_bucket & mask];
+
+  } else {
+
+    /* only nodes with values that cannot be represented remain */
+    node_handle = queue->d_overflow;
+  }
+
+  FMM_BucketQueue_unlink(queue, node_handle);
+
+  /* return node to free list */
+  node = &(queue->d_nodes[node_handle]);
+  node->next = queue->d_free_list;
+  queue->d_free_list = node_handle;
+
+  if (value) *value = node->value;
+  return node->idx;
+}
+
+
+void FMM_BucketQueue_updateNode(FMM_BucketQueue* queue, int node_handle,
+  LSMLIB_REAL value)
+{
+  FMM_BucketQueue_unlink(queue, node_handle);
+  queue->d_nodes[node_handle].value = value;
+  FMM_BucketQueue_link(queue, node_handle);
+}
+
+
+void FMM_BucketQueue_clear(FMM_BucketQueue* queue)
+{
+  int i;
+  for (i = 0; i < queue->d_num_buckets; i++) {
+    queue->d_buckets[i] = NULL_NODE;
+  }
+  queue->d_cur_bucket = 0;
+  queue->d_max_bucket = 0;
+  queue->d_overflow = NULL_NODE;
+  queue->d_num_nodes_used = 0;
+  queue->d_free_list = NULL_NODE;
+  queue->d_bucket_size = 0;
+  queue->d_overflow_size = 0;
+}
+
+
+void FMM_BucketQueue_setBucketWidth(FMM_BucketQueue* queue,
+  LSMLIB_REAL bucket_width)
+{
+  /* check that the bucket width is valid */
+  if (bucket_width <= 0) {
+    fprintf(stderr,
+            "ERROR: FMM_BucketQueue bucket width must be positive.\n");
+    return;
+  }
+
+  queue->d_bucket_width = bucket_width;
+  queue->d_inv_bucket_width = 1.0/bucket_width;
+  FMM_BucketQueue_clear(queue);
+}
+
+
+int FMM_BucketQueue_isEmpty(FMM_BucketQueue* queue)
+{
+  return (0 == queue->d_bucket_size + queue->d_overflow_size);
+}
+
+
+int FMM_BucketQueue_getQueueSize(FMM_BucketQueue* queue)
+{
+  return queue->d_bucket_size + queue->d_overflow_size;
+}
+
+
+/*================== Helper Functions Definitions ==================*/
+
+int FMM_BucketQueue_allocateNode(FMM_BucketQueue* queue)
+{
+  int node_handle;
+
+  /* reuse a free node if one is available */
+  if (NULL_NODE != queue->d_free_list) {
+    node_handle = queue->d_free_list;
+    queue->d_free_list = queue->d_nodes[node_handle].next;
+    return node_handle;
+  }
+
+  /* grow node array if necessary */
+  if (queue->d_num_nodes_used == queue->d_node_mem_size) {
+    queue->d_node_mem_size *= 2;
+    queue->d_nodes = (FMM_BucketQueueNode*) realloc(queue->d_nodes,
+      queue->d_node_mem_size*sizeof(FMM_BucketQueueNode));
+    if (!queue->d_nodes) {
+      fprintf(stderr,"ERROR: FMM_BucketQueue memory allocation failed.\n");
+      exit(-1);
+    }
+  }
+
+  node_handle = queue->d_num_nodes_used;
+  queue->d_num_nodes_used++;
+  return node_handle;
+}
+
+
+void FMM_BucketQueue_growBuckets(FMM_BucketQueue* queue, int num_buckets)
+{
+  int new_num_buckets = queue->d_num_buckets;
+  int old_mask = queue->d_num_buckets-1;
+  int new_mask;
+  int *new_buckets;
+  int b, head;
+
+  while (new_num_buckets < num_buckets) new_num_buckets *= 2;
+  new_mask = new_num_buckets-1;
+
+  new_buckets = (int*) malloc(new_num_buckets*sizeof(int));
+  if (!new_buckets) {
+    fprintf(stderr,"ERROR: FMM_BucketQueue memory allocation failed.\n");
+    exit(-1);
+  }
+  for (b = 0; b < new_num_buckets; b++) {
+    new_buckets[b] = NULL_NODE;
+  }
+
+  /* all nodes in a bucket share the same absolute bucket number, */
+  /* so whole lists can be moved at once                          */
+  for (b = 0; b <= old_mask; b++) {
+    head = queue->d_buckets[b];
+    if (NULL_NODE != head) {
+      new_buckets[queue->d_nodes[head].bucket & new_mask] = head;
+    }
+  }
+
+  free(queue->d_buckets);
+  queue->d_buckets = new_buckets;
+  queue->d_num_buckets = new_num_buckets;
+}
+
+
+void FMM_BucketQueue_link(FMM_BucketQueue* queue, int node_handle)
+{
+  FMM_BucketQueueNode* nodes = queue->d_nodes;
+  FMM_BucketQueueNode* node = &(nodes[node_handle]);
+  LSMLIB_REAL scaled_value = node->value*queue->d_inv_bucket_width;
+  int bucket = OVERFLOW_BUCKET;
+  int *head;
+
+  if (scaled_value < (LSMLIB_REAL) MAX_BUCKET) {
+
+    bucket = (scaled_value > 0) ? (int) scaled_value : 0;
+
+    if (0 == queue->d_bucket_size) {
+
+      /* bucket array is empty, so move its range to the new value */
+      queue->d_cur_bucket = bucket;
+      queue->d_max_bucket = bucket;
+
+    } else if (bucket < queue->d_cur_bucket) {
+
+      /* move the range of the bucket array down if possible; */
+      /* otherwise, place the node in the current bucket      */
+      if (queue->d_max_bucket - bucket < MAX_NUM_BUCKETS) {
+        if (queue->d_max_bucket - bucket >= queue->d_num_buckets) {
+          FMM_BucketQueue_growBuckets(queue, queue->d_max_bucket-bucket+1);
+        }
+        queue->d_cur_bucket = bucket;
+      } else {
+        bucket = queue->d_cur_bucket;
+      }
+
+    } else if (bucket - queue->d_cur_bucket >= MAX_NUM_BUCKETS) {
+
+      /* too far beyond the current bucket */
+      bucket = OVERFLOW_BUCKET;
+
+    } else if (bucket - queue->d_cur_bucket >= queue->d_num_buckets) {
+      FMM_BucketQueue_growBuckets(queue, bucket-queue->d_cur_bucket+1);
+    }
+  }
+
+  node->bucket = bucket;
+  node->prev = NULL_NODE;
+
+  if (OVERFLOW_BUCKET == bucket) {
+
+    /* value cannot be represented in bucket array */
+    head = &(queue->d_overflow);
+    queue->d_overflow_size++;
+
+  } else {
+
+    if (bucket > queue->d_max_bucket) queue->d_max_bucket = bucket;
+    head = &(queue->d_buckets[bucket & (queue->d_num_buckets-1)]);
+    queue->d_bucket_size++;
+
+  }
+
+  /* push node onto the front of the list */
+  node->next = *head;
+  if (NULL_NODE != *head) nodes[*head].prev = node_handle;
+  *head = node_handle;
+}
+
+
+void FMM_BucketQueue_unlink(FMM_BucketQueue* queue, int node_handle)
+{
+  FMM_BucketQueueNode* nodes = queue->d_nodes;
+  FMM_BucketQueueNode* node = &(nodes[node_handle]);
+
+  if (NULL_NODE != node->prev) {
+    nodes[node->prev].next = node->next;
+  } else if (OVERFLOW_BUCKET == node->bucket) {
+    queue->d_overflow = node->next;
+  } else {
+    queue->d_buckets[node->bucket & (queue->d_num_buckets-1)] = node->next;
+  }
+  if (NULL_NODE != node->next) {
+    nodes[node->next].prev = node->prev;
+  }
+
+  if (OVERFLOW_BUCKET == node->bucket) {
+    queue->d_overflow_size--;
+  } else {
+    queue->d_bucket_size--;
+  }
+}
+
+
+void FMM_BucketQueue_rebaseOverflow(FMM_BucketQueue* queue)
+{
+  FMM_BucketQueueNode* nodes = queue->d_nodes;
+  LSMLIB_REAL min_value = LSMLIB_REAL_MAX;
+  int node_handle, next;
+
+  if (NULL_NODE == queue->d_overflow) return;
+
+  /* nothing to do if none of the values can be represented */
+  for (node_handle = queue->d_overflow; NULL_NODE != node_handle;
+       node_handle = nodes[node_handle].next) {
+    if (nodes[node_handle].value < min_value) {
+      min_value = nodes[node_handle].value;
+    }
+  }
+  if (min_value*queue->d_inv_bucket_width >= (LSMLIB_REAL) MAX_BUCKET) {
+    return;
+  }
+
+  /* relink all overflow nodes (starting with an empty bucket array) */
+  node_handle = queue->d_overflow;
+  queue->d_overflow = NULL_NODE;
+  queue->d_overflow_size = 0;
+  while (NULL_NODE != node_handle) {
+    next = nodes[node_handle].next;
+    FMM_BucketQueue_link(queue, node_handle);
+    node_handle = next;
+  }
+}
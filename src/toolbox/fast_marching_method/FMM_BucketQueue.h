@@ -0,0 +1,224 @@
+/*
+ * File:        FMM_BucketQueue.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for C bucketed priority queue library for
+ *              supporting FMM algorithm
+ */
+
+#ifndef included_FMM_BucketQueue_h
+#define included_FMM_BucketQueue_h
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file FMM_BucketQueue.h
+ *
+ * \brief
+ * @ref FMM_BucketQueue.h provides a bucketed (Dial-type) priority queue
+ * that may be used in place of @ref FMM_Heap.h to order the "trial"
+ * points in the Fast Marching Method.
+ *
+ * Values are quantized into buckets of fixed width.  Insertion, update
+ * and removal of a node are all O(1) operations.  Nodes that fall into
+ * the same bucket are extracted in an arbitrary order (i.e. the queue
+ * is "untidy"), so the ordering of grid points is only exact up to the
+ * bucket width.  For details see "O(N) Implementation of the Fast
+ * Marching Algorithm" by L. Yatziv, A. Bartesaghi, and G. Sapiro
+ * (J. Comp. Phys, vol 212, p 393-399, 2006).
+ *
+ * Each node stores only the linear index of its grid point, and nodes
+ * never move in memory, so the integer handle returned by
+ * FMM_BucketQueue_insertNode() remains valid until the node is
+ * extracted from the queue.
+ *
+ *
+ * <h3> NOTES: </h3>
+ * - The buckets are stored in a circular array that is grown as
+ *   needed to accomodate the range of values in the queue.  Values
+ *   that are too large to be represented by the bucket array
+ *   (e.g. LSMLIB_REAL_MAX) are kept in a separate overflow list
+ *   and are only extracted after all other nodes.
+ *
+ * - Values smaller than the value of the current bucket move the 
+ *   current bucket down so that they are extracted next.
+ *
+ * - Because nodes in the same bucket are extracted out of order,
+ *   results differ from those computed using @ref FMM_Heap.h.  The
+ *   effect is small for distance functions and solutions of the 
+ *   Eikonal equation but much larger for extension fields.  With the
+ *   FMM_Core default bucket width of 0.1*min(dx), the maximum 
+ *   differences from the binary heap results measured by the 
+ *   first-order benchmarkFMMQueues example (sphere/circle of radius 
+ *   0.4 in [-1,1]^n, source field x + y*z) were:
+ *
+ *   grid        distance function    extension field
+ *   64^3        1.1e-3 (0.03 dx)     3.8e-2 (1.2 dx)
+ *   100^3       6.0e-4 (0.03 dx)     5.3e-2 (2.7 dx)
+ *   160^3       5.1e-4 (0.04 dx)     1.2e-2 (1.0 dx)
+ *   1000^2      4.8e-5 (0.02 dx)     6.7e-3 (3.4 dx)
+ *
+ *   Extension fields computed with the bucketed queue should 
+ *   therefore only be trusted to within a few grid cells along the 
+ *   characteristics.  Use the binary heap when extension fields 
+ *   must be accurate.
+ *
+ */
+
+
+/*!
+ * The FMM_BucketQueue structure stores the internal data required to
+ * maintain the state of the bucketed priority queue.
+ */
+typedef struct FMM_BucketQueue FMM_BucketQueue;
+
+
+/*!
+ * FMM_BucketQueue_createBucketQueue() dynamically allocates an empty
+ * bucketed priority queue.
+ *
+ * Arguments:
+ *  - bucket_width (in):   width of each bucket
+ *  - node_mem_size (in):  number of nodes to initially allocate memory for
+ *
+ * Return value:           pointer to new queue
+ *
+ * NOTES:
+ *  - To use the default amount of memory (64 nodes), set node_mem_size
+ *    to 0.
+ *
+ *  - bucket_width MUST be positive.
+ *
+ */
+FMM_BucketQueue* FMM_BucketQueue_createBucketQueue(
+  LSMLIB_REAL bucket_width,
+  int node_mem_size);
+
+/*!
+ * FMM_BucketQueue_destroyBucketQueue() frees the memory used to store
+ * the queue.
+ *
+ * Arguments:
+ *  - queue (in):  pointer to queue to be destroyed
+ *
+ * Return value:   none
+ *
+ */
+void FMM_BucketQueue_destroyBucketQueue(FMM_BucketQueue* queue);
+
+/*!
+ * FMM_BucketQueue_insertNode() inserts a new node into the queue and
+ * returns an integer handle to the node.
+ *
+ * Arguments:
+ *  - queue (in):  pointer to queue
+ *  - idx (in):    linear grid index of node to insert into queue
+ *  - value (in):  value of node to insert into queue
+ *
+ * Return value:   integer handle to the node
+ *
+ */
+int FMM_BucketQueue_insertNode(FMM_BucketQueue* queue, int idx,
+  LSMLIB_REAL value);
+
+/*!
+ * FMM_BucketQueue_extractMin() removes a node from the lowest
+ * non-empty bucket of the queue.
+ *
+ * Arguments:
+ *  - queue (in):   pointer to queue
+ *  - value (out):  value of the extracted node
+ *
+ * Return value:    linear grid index of the extracted node;
+ *                  -1 if the queue is empty
+ *
+ * NOTES:
+ *  - value may be set to NULL if the value of the extracted node
+ *    is not needed.
+ *
+ *  - If the queue is empty, nothing is extracted and value is 
+ *    not modified.
+ *
+ */
+int FMM_BucketQueue_extractMin(FMM_BucketQueue* queue, LSMLIB_REAL* value);
+
+/*!
+ * FMM_BucketQueue_updateNode() updates the value of the specified node
+ * and moves it to the appropriate bucket.
+ *
+ * Arguments:
+ *  - queue (in):        pointer to queue
+ *  - node_handle (in):  integer handle of node to update
+ *  - value (in):        new value for updated node
+ *
+ * Return value:         none
+ *
+ */
+void FMM_BucketQueue_updateNode(FMM_BucketQueue* queue, int node_handle,
+  LSMLIB_REAL value);
+
+/*!
+ * FMM_BucketQueue_clear() empties out the queue.
+ *
+ * Arguments:
+ *  - queue (in):  pointer to queue
+ *
+ * Return value:   none
+ *
+ */
+void FMM_BucketQueue_clear(FMM_BucketQueue* queue);
+
+/*!
+ * FMM_BucketQueue_setBucketWidth() empties out the queue and changes 
+ * the width of its buckets.
+ *
+ * Arguments:
+ *  - queue (in):         pointer to queue
+ *  - bucket_width (in):  new width of each bucket (must be positive)
+ *
+ * Return value:          none
+ *
+ * NOTES:
+ *  - The memory allocated for the nodes and buckets is retained, so
+ *    a queue can be reused for a new calculation without growing 
+ *    again.
+ *
+ */
+void FMM_BucketQueue_setBucketWidth(FMM_BucketQueue* queue,
+  LSMLIB_REAL bucket_width);
+
+/*!
+ * FMM_BucketQueue_isEmpty() returns true (1) if the queue is empty and
+ * false (0) otherwise.
+ *
+ * Arguments:
+ *  - queue (in):  pointer to queue
+ *
+ * Return value:   true (1) if the queue is empty; false (0) otherwise
+ *
+ */
+int FMM_BucketQueue_isEmpty(FMM_BucketQueue* queue);
+
+/*!
+ * FMM_BucketQueue_getQueueSize() returns the current number of nodes in
+ * the queue.
+ *
+ * Arguments:
+ *  - queue (in):  pointer to queue
+ *
+ * Return value:   current number of nodes in queue
+ *
+ */
+int FMM_BucketQueue_getQueueSize(FMM_BucketQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
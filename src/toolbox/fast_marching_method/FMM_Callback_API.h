@@ -101,6 +101,46 @@ LSMLIB_REAL updateGridPoint_CallbackFunc(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * updateGridPointLinearIdx_CallbackFunc() defines the signature of an
+ * alternative to updateGridPoint_CallbackFunc() that is also passed
+ * the linear (i.e. array) index of the grid point to update.  It is
+ * registered using FMM_Core_setUpdateGridPointLinearIdx().
+ *
+ * Arguments:
+ *  - fmm_core_data (in/out):       FMM_CoreData "object" actively managing 
+ *                                  the FMM computation
+ *  - fmm_field_data (in/out):      pointer to FMM_FieldData containing
+ *                                  application specific field data
+ *  - idx (in):                     linear index of the grid point to update
+ *  - grid_idx (in):                integer array containing the grid index 
+ *                                  of the grid point to update
+ *  - num_dims (in):                number of dimensions for FMM computation
+ *  - grid_dims (in):               integer array of dimensions of computational
+ *                                  grid
+ *  - dx (in):                      LSMLIB_REAL array containing grid cell 
+ *                                  sizes in each of the coordinate directions
+ *
+ * Return value:                    updated distance function value at
+ *                                  specified grid point
+ *
+ * NOTES:
+ *  - The linear index of the neighbor of the grid point in the 
+ *    positive (negative) i-th coordinate direction is obtained by
+ *    adding (subtracting) the product of grid_dims[0], ..., 
+ *    grid_dims[i-1] to (from) idx.  grid_idx only needs to be used 
+ *    to check whether the neighbor lies within the computational grid.
+ *
+ */
+LSMLIB_REAL updateGridPointLinearIdx_CallbackFunc(
+  FMM_CoreData *fmm_core_data, 
+  FMM_FieldData *fmm_field_data, 
+  int idx,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <float.h>
 #include "FMM_Heap.h"
+#include "FMM_BucketQueue.h"
 #include "FMM_Core.h"
 
 #include "LSMLIB_config.h"
@@ -20,7 +21,7 @@
 #define FMM_CORE_TRUE                   (1)
 #define FMM_CORE_FALSE                  (0)
 #define FMM_CORE_NULL                   (0)
-#define FMM_CORE_MAX_NDIM               (FMM_HEAP_MAX_NDIM)
+#define FMM_CORE_MAX_NDIM               (8)
 
 
 /*======================= FMM_Core Macros =========================*/
@@ -37,18 +38,17 @@
   }                                                                        \
 }
 
-#define FMM_CORE_IDX_OUT_OF_BOUNDS(out_of_bounds, num_dims, grid_idx,     \
-                                   grid_dims)                             \
-{                                                                         \
-  int macro_i;       /* loop variable */                                  \
-  out_of_bounds = 0;                                                      \
-  for (macro_i = 0; macro_i < num_dims; macro_i++) {                      \
-    if (  (grid_idx[macro_i] < 0)                                         \
-       || (grid_idx[macro_i] > grid_dims[macro_i]-1) ) {                  \
-      out_of_bounds = 1;                                                  \
-      break;                                                              \
-    }                                                                     \
-  }                                                                       \
+#define FMM_CORE_GRID_IDX(grid_idx, num_dims, idx, grid_dims)              \
+{                                                                          \
+  int macro_i;                         /* loop variable */                 \
+  int macro_idx_remainder = idx;                                           \
+  for (macro_i = 0; macro_i < num_dims; macro_i++) {                       \
+    grid_idx[macro_i] = macro_idx_remainder%grid_dims[macro_i];            \
+    macro_idx_remainder /= grid_dims[macro_i];                             \
+  }                                                                        \
+  for (macro_i = num_dims; macro_i < FMM_CORE_MAX_NDIM; macro_i++) {       \
+    grid_idx[macro_i] = 0;                                                 \
+  }                                                                        \
 }
 
 
@@ -56,10 +56,12 @@
 
 /* 
  * FMM_Core_updateNeighbors() updates the neighbors of the specified
- * grid point.
+ * grid point.  Both the linear index and the grid index of the grid
+ * point are required.
  */
 static 
-void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int *grid_idx); 
+void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int idx,
+                              int *grid_idx); 
 
 
 /*=============== Fast Marching Method Data Structures ==============*/
@@ -69,20 +71,35 @@ struct FMM_CoreData {
   int num_dims;
   FMM_FieldData *fmm_field_data;
   int grid_dims[FMM_CORE_MAX_NDIM];
+  int grid_strides[FMM_CORE_MAX_NDIM];
   LSMLIB_REAL dx[FMM_CORE_MAX_NDIM];
 
   /* function pointer to grid update function */
   initializeFrontFuncPtr initializeFront;
   updateGridPointFuncPtr updateGridPoint;
+  updateGridPointLinearIdxFuncPtr updateGridPointLinearIdx;
 
   /* internal data */
+  int num_gridpoints_allocated;
   int* heapnode_handles;
-  int* gridpoint_status;
+  unsigned char* gridpoint_status;
+  FMM_CoreQueueType queue_type;
   FMM_Heap* trial_points;
+  FMM_BucketQueue* trial_points_bucketed;
   FMM_Heap* known_points;
+
+  /* front value beyond which the front is no longer advanced */
+  LSMLIB_REAL stop_value;
+  LSMLIB_REAL front_value;
 };
 
 
+/*=============== FMM_Core Static Data ==============*/
+
+/* priority queue used by FMM_Core_createFMM_CoreData() */
+static FMM_CoreQueueType fmm_core_default_queue_type = FMM_CORE_BINARY_HEAP;
+
+
 /*=============== FMM_Core API Function Definitions ==============*/
 
 FMM_CoreData* FMM_Core_createFMM_CoreData(
@@ -92,12 +109,74 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   LSMLIB_REAL *dx,
   initializeFrontFuncPtr initializeFront,
   updateGridPointFuncPtr updateGridPoint)
+{
+  return FMM_Core_createFMM_CoreDataWithQueue(
+           fmm_field_data,
+           num_dims,
+           grid_dims,
+           dx,
+           initializeFront,
+           updateGridPoint,
+           fmm_core_default_queue_type,
+           0); /* default bucket width */
+}
+
+
+FMM_CoreData* FMM_Core_createFMM_CoreDataWithQueue(
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL bucket_width)
 {
   FMM_CoreData *fmm_core_data;     /* pointer to new FMM_CoreData */
+
+  /* allocate memory for FMM_CoreData */
+  fmm_core_data = (FMM_CoreData*) malloc( sizeof(FMM_CoreData) );
+
+  /* no grid or priority queue memory has been allocated yet */
+  fmm_core_data->heapnode_handles = FMM_CORE_NULL;
+  fmm_core_data->gridpoint_status = FMM_CORE_NULL;
+  fmm_core_data->num_gridpoints_allocated = 0;
+  fmm_core_data->trial_points = FMM_CORE_NULL;
+  fmm_core_data->trial_points_bucketed = FMM_CORE_NULL;
+  fmm_core_data->known_points = FMM_CORE_NULL;
+
+  /* initialize FMM data */
+  FMM_Core_resetFMM_CoreData(
+    fmm_core_data,
+    fmm_field_data,
+    num_dims,
+    grid_dims,
+    dx,
+    initializeFront,
+    updateGridPoint,
+    queue_type,
+    bucket_width);
+
+  return fmm_core_data;
+}
+
+
+void FMM_Core_resetFMM_CoreData(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL bucket_width)
+{
   int num_gridpoints;              /* number of grid points */
   int initial_heap_size;           /* initial size for FMM_Heap */
   int i;                           /* loop variable */
   int *ptr;                        /* integer pointer loop variable */
+  unsigned char *status_ptr;       /* status pointer loop variable */
 
   /* check that num_dimension is supported */
   if ( num_dims > FMM_CORE_MAX_NDIM ) {
@@ -107,24 +186,33 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
     exit(-1);
   } 
 
-  /* allocate memory for FMM_CoreData */
-  fmm_core_data = (FMM_CoreData*) malloc( sizeof(FMM_CoreData) );
-
   /* compute number of grid points */
   num_gridpoints = 1;
   for (i = 0; i < num_dims; i++) num_gridpoints *= grid_dims[i];
 
+  /* allocate grid data (only if the grid is larger than any grid */
+  /* that this FMM_CoreData has been used for)                    */
+  if (num_gridpoints > fmm_core_data->num_gridpoints_allocated) {
+    free(fmm_core_data->heapnode_handles);
+    free(fmm_core_data->gridpoint_status);
+    fmm_core_data->heapnode_handles = 
+      (int*) malloc(num_gridpoints*sizeof(int));
+    fmm_core_data->gridpoint_status = 
+      (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+    fmm_core_data->num_gridpoints_allocated = num_gridpoints;
+  }
+
   /* initialize FMM data */
-  fmm_core_data->heapnode_handles = (int*) malloc(num_gridpoints*sizeof(int));
-  fmm_core_data->gridpoint_status = (int*) malloc(num_gridpoints*sizeof(int));
   fmm_core_data->num_dims = num_dims;
   fmm_core_data->fmm_field_data = fmm_field_data;
   fmm_core_data->initializeFront = initializeFront;
   fmm_core_data->updateGridPoint = updateGridPoint;
+  fmm_core_data->updateGridPointLinearIdx = FMM_CORE_NULL;
 
-  /* initialize grid_dims and dx to zero */
+  /* initialize grid_dims, grid_strides and dx to zero */
   for (i = 0; i < FMM_CORE_MAX_NDIM; i++) {
     fmm_core_data->grid_dims[i] = 0;
+    fmm_core_data->grid_strides[i] = 0;
     fmm_core_data->dx[i] = 0.0;
   }
 
@@ -133,16 +221,59 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   /*        dimensions specified for the computation.       */
   for (i = 0; i < num_dims; i++) {
     fmm_core_data->grid_dims[i] = grid_dims[i];
+    fmm_core_data->grid_strides[i] = (i == 0) ? 1 :
+      fmm_core_data->grid_strides[i-1]*grid_dims[i-1];
     fmm_core_data->dx[i] = dx[i];
   }
 
-  /* create an FMM_Heap to store the trial points */
-  /* NOTE: using default heap growth factor by    */
-  /*       specifying 0 for the second argument   */
+  /* set up the priority queue for the trial points.  an existing */
+  /* queue of the requested type is emptied and reused so that it */
+  /* keeps the memory it grew to during earlier calculations.     */
+  /* NOTE: using default heap growth factor by specifying 0 for   */
+  /*       the second argument                                    */
   initial_heap_size = 0;
   for (i = 0; i < num_dims; i++) initial_heap_size += grid_dims[i];
-  fmm_core_data->trial_points = 
-    FMM_Heap_createHeap(num_dims,initial_heap_size,0); 
+  fmm_core_data->queue_type = queue_type;
+  fmm_core_data->stop_value = LSMLIB_REAL_MAX;
+  fmm_core_data->front_value = 0.0;
+  if (FMM_CORE_BUCKETED_QUEUE == queue_type) {
+
+    /* use default bucket width if necessary */
+    if (bucket_width <= 0) {
+      bucket_width = dx[0];
+      for (i = 1; i < num_dims; i++) {
+        if (dx[i] < bucket_width) bucket_width = dx[i];
+      }
+      bucket_width *= FMM_CORE_DEFAULT_BUCKET_WIDTH_FRACTION;
+    }
+
+    if (fmm_core_data->trial_points != FMM_CORE_NULL) {
+      FMM_Heap_destroyHeap(fmm_core_data->trial_points);
+      fmm_core_data->trial_points = FMM_CORE_NULL;
+    }
+    if (fmm_core_data->trial_points_bucketed != FMM_CORE_NULL) {
+      FMM_BucketQueue_setBucketWidth(fmm_core_data->trial_points_bucketed,
+                                     bucket_width);
+    } else {
+      fmm_core_data->trial_points_bucketed =
+        FMM_BucketQueue_createBucketQueue(bucket_width,initial_heap_size);
+    }
+
+  } else {
+
+    if (fmm_core_data->trial_points_bucketed != FMM_CORE_NULL) {
+      FMM_BucketQueue_destroyBucketQueue(
+        fmm_core_data->trial_points_bucketed);
+      fmm_core_data->trial_points_bucketed = FMM_CORE_NULL;
+    }
+    if (fmm_core_data->trial_points != FMM_CORE_NULL) {
+      FMM_Heap_clear(fmm_core_data->trial_points);
+    } else {
+      fmm_core_data->trial_points = 
+        FMM_Heap_createHeap(initial_heap_size,0); 
+    }
+
+  }
 
   /* initialize heapnode handles to have a default value of -1 */
   ptr = fmm_core_data->heapnode_handles;
@@ -151,12 +282,10 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   }
 
   /* initialize gridpoint status of all cells to FAR */
-  ptr = fmm_core_data->gridpoint_status;
-  for (i = 0; i < num_gridpoints; i++, ptr++) {
-    *ptr = FAR;
+  status_ptr = fmm_core_data->gridpoint_status;
+  for (i = 0; i < num_gridpoints; i++, status_ptr++) {
+    *status_ptr = FAR;
   }
-
-  return fmm_core_data;
 }
 
 
@@ -164,13 +293,44 @@ void FMM_Core_destroyFMM_CoreData(FMM_CoreData *fmm_core_data)
 {
   free(fmm_core_data->heapnode_handles);
   free(fmm_core_data->gridpoint_status);
-  FMM_Heap_destroyHeap(fmm_core_data->trial_points);
+  if (fmm_core_data->trial_points != FMM_CORE_NULL)
+    FMM_Heap_destroyHeap(fmm_core_data->trial_points);
+  if (fmm_core_data->trial_points_bucketed != FMM_CORE_NULL)
+    FMM_BucketQueue_destroyBucketQueue(fmm_core_data->trial_points_bucketed);
   if (fmm_core_data->known_points != FMM_CORE_NULL)
     FMM_Heap_destroyHeap(fmm_core_data->known_points);
   free(fmm_core_data);
 }
 
 
+void FMM_Core_setUpdateGridPointLinearIdx(
+  FMM_CoreData *fmm_core_data,
+  updateGridPointLinearIdxFuncPtr updateGridPointLinearIdx)
+{
+  fmm_core_data->updateGridPointLinearIdx = updateGridPointLinearIdx;
+}
+
+
+void FMM_Core_setStopValue(
+  FMM_CoreData *fmm_core_data,
+  LSMLIB_REAL stop_value)
+{
+  fmm_core_data->stop_value = stop_value;
+}
+
+
+void FMM_Core_setDefaultQueueType(FMM_CoreQueueType queue_type)
+{
+  fmm_core_default_queue_type = queue_type;
+}
+
+
+FMM_CoreQueueType FMM_Core_getDefaultQueueType(void)
+{
+  return fmm_core_default_queue_type;
+}
+
+
 void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
 {
   int num_dims = fmm_core_data->num_dims; 
@@ -196,9 +356,14 @@ void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
 
   /* create FMM_Heap to contain known points      */
   /* NOTE: using default heap growth factor by    */
-  /*       specifying 0 for the second argument   */
-  known_points = FMM_Heap_createHeap(num_dims,initial_heap_size,0);
-  fmm_core_data->known_points = known_points;
+  /*       specifying 0 for the second argument.  */
+  /*       the heap is kept (empty) until the     */
+  /*       FMM_CoreData is destroyed so that it   */
+  /*       can be reused by later calculations.   */
+  if (FMM_CORE_NULL == fmm_core_data->known_points) {
+    fmm_core_data->known_points = FMM_Heap_createHeap(initial_heap_size,0);
+  }
+  known_points = fmm_core_data->known_points;
 
   /* let user-provided callback function find and initialize the front */
   fmm_core_data->initializeFront(
@@ -228,31 +393,16 @@ void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
     /* less than LSMLIB_REAL_MAX                    */
     if (node.value < LSMLIB_REAL_MAX) {
 
-      /* set grid_idx */
-      for (i = 0; i < num_dims; i++) {
-        grid_idx[i] = node.grid_idx[i];
-      }
-      for (i = num_dims; i < FMM_CORE_MAX_NDIM; i++) {
-        grid_idx[i] = 0;
-      }
+      /* compute grid_idx */
+      FMM_CORE_GRID_IDX(grid_idx, num_dims, node.idx, grid_dims);
 
-      FMM_Core_updateNeighbors(fmm_core_data, grid_idx);
+      FMM_Core_updateNeighbors(fmm_core_data, node.idx, grid_idx);
     }
 
   } /* end loop over "known" points */
-
-  /* clean up memory */
-  FMM_Heap_destroyHeap(known_points);
-  fmm_core_data->known_points = FMM_CORE_NULL;
 }
 
 
-/*
- * FMM_Core_setInitialFrontPoint() first makes a local copy of the grid_idx
- * because the FMM_CORE_IDX calculation and FMM_Heap_insertNode() function
- * require that grid_idx is an array of size FMM_CORE_MAX_NDIM 
- * (= FMM_HEAP_MAX_NDIM).
- */
 void FMM_Core_setInitialFrontPoint(
   FMM_CoreData *fmm_core_data, 
   int *grid_idx, 
@@ -260,57 +410,59 @@ void FMM_Core_setInitialFrontPoint(
 {
   int num_dims = fmm_core_data->num_dims; 
   int *grid_dims = fmm_core_data->grid_dims;
-  int *gridpoint_status = fmm_core_data->gridpoint_status; 
-  int grid_idx_local[FMM_CORE_MAX_NDIM];     /* local copy of grid_idx */
+  unsigned char *gridpoint_status = fmm_core_data->gridpoint_status; 
 
   /* auxilliary variables */
-  int i;    /* loop variable */
   int idx;  /* data array index */
 
-  /* make local copy of grid index */
-  for (i = 0; i < num_dims; i++) {
-    grid_idx_local[i] = grid_idx[i];
-  }
-  for (i = num_dims; i < FMM_CORE_MAX_NDIM; i++) {
-    grid_idx_local[i] = 0;
-  }
-
   /* Set status of grid point based and add it to the "known_points" heap. */
-  FMM_CORE_IDX(idx, num_dims, grid_idx_local, grid_dims);
+  FMM_CORE_IDX(idx, num_dims, grid_idx, grid_dims);
   gridpoint_status[idx] = KNOWN;
-  FMM_Heap_insertNode(fmm_core_data->known_points,grid_idx_local,value);
+  FMM_Heap_insertNode(fmm_core_data->known_points,idx,value);
 
 }
 
-/*
- * FMM_Core_markPointOutsideDomain() first makes a local copy of the grid_idx
- * because the FMM_CORE_IDX calculation and FMM_Heap_insertNode() function
- * require that grid_idx is an array of size FMM_CORE_MAX_NDIM 
- * (= FMM_HEAP_MAX_NDIM).
- */
-void FMM_Core_markPointOutsideDomain(
+void FMM_Core_setInitialTrialPoint(
   FMM_CoreData *fmm_core_data, 
-  int *grid_idx)
+  int *grid_idx, 
+  LSMLIB_REAL value)
 {
   int num_dims = fmm_core_data->num_dims; 
   int *grid_dims = fmm_core_data->grid_dims;
-  int *gridpoint_status = fmm_core_data->gridpoint_status; 
-  int grid_idx_local[FMM_CORE_MAX_NDIM];     /* local copy of grid_idx */
+  unsigned char *gridpoint_status = fmm_core_data->gridpoint_status; 
 
   /* auxilliary variables */
-  int i;    /* loop variable */
   int idx;  /* data array index */
 
-  /* make local copy of grid index */
-  for (i = 0; i < num_dims; i++) {
-    grid_idx_local[i] = grid_idx[i];
-  }
-  for (i = num_dims; i < FMM_CORE_MAX_NDIM; i++) {
-    grid_idx_local[i] = 0;
+  /* only absolute value matters for ordering of trial points */
+  if (value < 0) value *= -1;
+
+  /* Set status of grid point and add it to the "trial_points" heap. */
+  FMM_CORE_IDX(idx, num_dims, grid_idx, grid_dims);
+  gridpoint_status[idx] = TRIAL;
+  if (FMM_CORE_BUCKETED_QUEUE == fmm_core_data->queue_type) {
+    fmm_core_data->heapnode_handles[idx] = FMM_BucketQueue_insertNode(
+      fmm_core_data->trial_points_bucketed,idx,value);
+  } else {
+    fmm_core_data->heapnode_handles[idx] = 
+      FMM_Heap_insertNode(fmm_core_data->trial_points,idx,value);
   }
 
+}
+
+void FMM_Core_markPointOutsideDomain(
+  FMM_CoreData *fmm_core_data, 
+  int *grid_idx)
+{
+  int num_dims = fmm_core_data->num_dims; 
+  int *grid_dims = fmm_core_data->grid_dims;
+  unsigned char *gridpoint_status = fmm_core_data->gridpoint_status; 
+
+  /* auxilliary variables */
+  int idx;  /* data array index */
+
   /* set grid point status to OUTSIDE_DOMAIN */
-  FMM_CORE_IDX(idx, num_dims, grid_idx_local, grid_dims);
+  FMM_CORE_IDX(idx, num_dims, grid_idx, grid_dims);
   gridpoint_status[idx] = OUTSIDE_DOMAIN;
 
 }
@@ -327,39 +479,67 @@ void FMM_Core_advanceFront(FMM_CoreData *fmm_core_data)
   int* grid_dims = fmm_core_data->grid_dims;
   FMM_Heap *fmm_trial_points = fmm_core_data->trial_points;
   int *heapnode_handles = fmm_core_data->heapnode_handles;
-  int *gridpoint_status = fmm_core_data->gridpoint_status;
+  unsigned char *gridpoint_status = fmm_core_data->gridpoint_status;
   FMM_HeapNode moved_node;
   int moved_handle;
   FMM_HeapNode min_node;
+  int grid_idx[FMM_CORE_MAX_NDIM];
   int idx;
 
-  /* 
-   * remove the point with the smallest value from the set of "trial" points.
-   */
-  min_node = FMM_Heap_extractMin(fmm_trial_points, &moved_node, &moved_handle);
+  if (FMM_CORE_BUCKETED_QUEUE == fmm_core_data->queue_type) {
+
+    /* 
+     * remove a point from the lowest bucket of "trial" points.
+     */
+    idx = FMM_BucketQueue_extractMin(fmm_core_data->trial_points_bucketed, 
+                                     &(fmm_core_data->front_value));
+    if (idx < 0) return;  /* no "trial" points left */
+
+  } else {
+
+    /* 
+     * remove the point with the smallest value from the set of "trial" 
+     * points.
+     */
+    min_node = FMM_Heap_extractMin(fmm_trial_points, &moved_node, 
+                                   &moved_handle);
+    idx = min_node.idx;
+    fmm_core_data->front_value = min_node.value;
+
+    /* correct the handle for the moved node */
+    if (-1 != moved_handle) {  /* update heapnode_data if necessary */
+      heapnode_handles[moved_node.idx] = moved_handle;
+    }
 
-  /* correct the handle for the moved node */
-  if (-1 != moved_handle) {  /* update heapnode_data if necessary */
-    FMM_CORE_IDX(idx, num_dims, moved_node.grid_idx, grid_dims);
-    heapnode_handles[idx] = moved_handle;
   }
 
-  /* set status of min node to "known" */
-  FMM_CORE_IDX(idx, num_dims, min_node.grid_idx, grid_dims);
+  /* set status of extracted point to "known" */
   gridpoint_status[idx] = KNOWN;
 
   /* update neighbors */
-  FMM_Core_updateNeighbors(fmm_core_data, min_node.grid_idx);
+  FMM_CORE_GRID_IDX(grid_idx, num_dims, idx, grid_dims);
+  FMM_Core_updateNeighbors(fmm_core_data, idx, grid_idx);
 
 }
 
 int FMM_Core_moreGridPointsToUpdate(FMM_CoreData *fmm_core_data)
 {
+  /* stop once the front has passed the stop value */
+  if (fmm_core_data->front_value > fmm_core_data->stop_value) {
+    return FMM_CORE_FALSE;
+  }
+
+  if (FMM_CORE_BUCKETED_QUEUE == fmm_core_data->queue_type) {
+    return ( FMM_BucketQueue_isEmpty(fmm_core_data->trial_points_bucketed) ?
+             FMM_CORE_FALSE : FMM_CORE_TRUE);
+  }
+
   return ( FMM_Heap_isEmpty(fmm_core_data->trial_points) ?
            FMM_CORE_FALSE : FMM_CORE_TRUE);
 }
 
-int* FMM_Core_getGridPointStatusDataArray(FMM_CoreData *fmm_core_data)
+unsigned char* FMM_Core_getGridPointStatusDataArray(
+  FMM_CoreData *fmm_core_data)
 {
   return (fmm_core_data->gridpoint_status);
 }
@@ -367,18 +547,21 @@ int* FMM_Core_getGridPointStatusDataArray(FMM_CoreData *fmm_core_data)
 
 /*=============== FMM_Core Helper Function Definitions ==============*/
 
-void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int *grid_idx)
+void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int idx,
+                              int *grid_idx)
 {
   int* grid_dims = fmm_core_data->grid_dims;
+  int* grid_strides = fmm_core_data->grid_strides;
   FMM_Heap *fmm_trial_points = fmm_core_data->trial_points;
+  FMM_BucketQueue *fmm_trial_points_bucketed = 
+    fmm_core_data->trial_points_bucketed;
   FMM_FieldData *fmm_field_data = fmm_core_data->fmm_field_data;
   int *heapnode_handles = fmm_core_data->heapnode_handles;
-  int *gridpoint_status = fmm_core_data->gridpoint_status;
+  unsigned char *gridpoint_status = fmm_core_data->gridpoint_status;
   int num_dims = fmm_core_data->num_dims;
 
   /* variables for update calculation */
   int neighbor[FMM_CORE_MAX_NDIM];
-  int offset[FMM_CORE_MAX_NDIM];
   LSMLIB_REAL value;
   int heapnode_handle;
 
@@ -386,69 +569,88 @@ void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int *grid_idx)
   int dir; 	       /* loop variable for spatial directions */
   int n;	         /* loop variable for neighbors */
   int m;	         /* extra loop variable */
-  int idx;             /* data array index */
-  int out_of_bounds;   /* boolean indicating if index is out of bounds */
+  int idx_neighbor;    /* data array index of neighbor */
+
+  /* initialize neighbor to grid_idx */
+  for (m = 0; m < FMM_CORE_MAX_NDIM; m++) {
+    neighbor[m] = (m < num_dims) ? grid_idx[m] : 0;
+  }
 
   /* loop over coordinate directions */
   for (dir = 0; dir < num_dims; dir++) { 
 
-    /* reset neighbor and offset */
-    for (m = 0; m < FMM_CORE_MAX_NDIM; m++) {
-      neighbor[m] = 0; offset[m] = 0; 
-    }
-
     for (n = -1; n<=1; n+=2) { /* loop over neighbors */
       PointStatus neighbor_status;
 
-      offset[dir] = n;
-
-      for (m = 0; m < num_dims; m++) neighbor[m] = grid_idx[m]+offset[m];
-
-      FMM_CORE_IDX_OUT_OF_BOUNDS(out_of_bounds, num_dims, neighbor, grid_dims);
-      if (!out_of_bounds) {
+      neighbor[dir] = grid_idx[dir] + n;
+      if ( (neighbor[dir] >= 0) && (neighbor[dir] < grid_dims[dir]) ) {
 
-        FMM_CORE_IDX(idx, num_dims, neighbor, grid_dims);
-        neighbor_status = (PointStatus) gridpoint_status[idx];
+        idx_neighbor = idx + n*grid_strides[dir];
+        neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
         if (  (KNOWN != neighbor_status) 
            && (OUTSIDE_DOMAIN != neighbor_status) ) {
 
           /* compute trial values for neighbor */
-          value = fmm_core_data->updateGridPoint(fmm_core_data, 
-                                                 fmm_field_data,
-                                                 neighbor,
-                                                 fmm_core_data->num_dims, 
-                                                 fmm_core_data->grid_dims, 
-                                                 fmm_core_data->dx);
+          if (fmm_core_data->updateGridPointLinearIdx) {
+            value = fmm_core_data->updateGridPointLinearIdx(
+                      fmm_core_data, 
+                      fmm_field_data,
+                      idx_neighbor,
+                      neighbor,
+                      fmm_core_data->num_dims, 
+                      fmm_core_data->grid_dims, 
+                      fmm_core_data->dx);
+          } else {
+            value = fmm_core_data->updateGridPoint(
+                      fmm_core_data, 
+                      fmm_field_data,
+                      neighbor,
+                      fmm_core_data->num_dims, 
+                      fmm_core_data->grid_dims, 
+                      fmm_core_data->dx);
+          }
           if (value < 0) value *= -1; /* only absolute value matters here */
 
           if (FAR == neighbor_status) {
 
             /* set the status of the neighbor to TRIAL */
-            FMM_CORE_IDX(idx, num_dims, neighbor, grid_dims);
-            gridpoint_status[idx] = TRIAL;
+            gridpoint_status[idx_neighbor] = TRIAL;
 
-            /* insert the new TRIAL point into the FMM_Heap */
-            heapnode_handle = FMM_Heap_insertNode(fmm_trial_points, 
-                                                  neighbor, value);
+            /* insert the new TRIAL point into the priority queue */
+            if (fmm_trial_points_bucketed) {
+              heapnode_handle = FMM_BucketQueue_insertNode(
+                fmm_trial_points_bucketed, idx_neighbor, value);
+            } else {
+              heapnode_handle = FMM_Heap_insertNode(fmm_trial_points, 
+                                                    idx_neighbor, value);
+            }
 
             /* set the heap node handle */
-            heapnode_handles[idx] = heapnode_handle;
+            heapnode_handles[idx_neighbor] = heapnode_handle;
 
           } else { 
             /* 
              * neighbor has status TRIAL, so just update its value in 
-             * the heap
+             * the priority queue
              */
-            FMM_CORE_IDX(idx, num_dims, neighbor, grid_dims);
-            FMM_Heap_updateNode(fmm_trial_points, heapnode_handles[idx], 
-                                value);
+            if (fmm_trial_points_bucketed) {
+              FMM_BucketQueue_updateNode(fmm_trial_points_bucketed, 
+                                         heapnode_handles[idx_neighbor], 
+                                         value);
+            } else {
+              FMM_Heap_updateNode(fmm_trial_points, 
+                                  heapnode_handles[idx_neighbor], value);
+            }
           } 
         } /* end update of neighbor point (not in "known" set) */
 
       } /* end case: grid index of neighbor is not out of bounds */
 
     } /* end loop over neighbors */
+
+    /* reset neighbor */
+    neighbor[dir] = grid_idx[dir];
+
   } /* end loop over coordinate directions */
 
 }
-
@@ -28,23 +28,42 @@ extern "C" {
  * callback functions for detecting/initializing the front and updating 
  * individual grid points.
  *
- * Dependencies:  @ref FMM_Heap.h and user-supplied callback routines
+ * Dependencies:  @ref FMM_Heap.h, @ref FMM_BucketQueue.h and user-supplied 
+ *                callback routines
  *                                 
  * <h3> Usage: </h3>
  * 
  * -# Provide implementations for the callback functions defined in 
  *    @ref FMM_Callback_API.h.  
  * -# Create an FMM_CoreData structure using FMM_Core_createFMM_CoreData().
+ *    Optionally, register a linear-index grid point update function
+ *    using FMM_Core_setUpdateGridPointLinearIdx().
  * -# Initialize the front using FMM_Core_initializeFront().  
  * -# Mark grid points that are outside of the mathematical domain for 
  *    the problem using the FMM_Core_markPointOutsideDomain() function.
  * -# Advance the front as far as desired using FMM_Core_advanceFront().
  *    Typically, the front is advanced until there are no more grid 
- *    points to update.
+ *    points to update.  To limit the calculation to a band around the
+ *    initial front, set a stop value using FMM_Core_setStopValue().
  * -# Clean up the memory allocated for the FMM_CoreData using
  *    FMM_Core_destroyFMM_CoreData().
  *
+ * To carry out many calculations (e.g. redistancing a level set 
+ * function every few time steps), an FMM_CoreData may be reused by 
+ * calling FMM_Core_resetFMM_CoreData() in place of 
+ * FMM_Core_createFMM_CoreData() and destroying it only after the last
+ * calculation.
+ *
+ */
+
+
+/*================== FMM_Core Constants ==============================*/
+
+/*!
+ * default width of the buckets in the bucketed queue as a fraction of
+ * the smallest grid spacing
  */
+#define FMM_CORE_DEFAULT_BUCKET_WIDTH_FRACTION   (0.1)
 
 
 /*================== FMM_Core Type Declarations ======================*/
@@ -68,6 +87,24 @@ typedef struct FMM_FieldData FMM_FieldData;
  */
 typedef enum { KNOWN, TRIAL, FAR, OUTSIDE_DOMAIN } PointStatus;
 
+/*!
+ * FMM_CoreQueueType is an enumerated type that selects the priority 
+ * queue used to order the "trial" points during the Fast Marching 
+ * Method computation.
+ *
+ *  - FMM_CORE_BINARY_HEAP:     binary heap (see @ref FMM_Heap.h); 
+ *                              trial points are accepted in exact order
+ *  - FMM_CORE_BUCKETED_QUEUE:  bucketed "untidy" queue (see 
+ *                              @ref FMM_BucketQueue.h); O(1) queue 
+ *                              operations, but trial points are only 
+ *                              accepted in order up to the bucket width
+ *                              (extension fields may differ from the 
+ *                              binary heap results by a few grid 
+ *                              cells; see @ref FMM_BucketQueue.h)
+ */
+typedef enum { FMM_CORE_BINARY_HEAP, 
+               FMM_CORE_BUCKETED_QUEUE } FMM_CoreQueueType;
+
 /*!
  * initializeFrontFuncPtr is a function pointer to one of the
  * callback functions defined in @ref FMM_Callback_API.h, which must be
@@ -93,6 +130,21 @@ typedef LSMLIB_REAL (*updateGridPointFuncPtr)(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * updateGridPointLinearIdxFuncPtr is a function pointer to one of the 
+ * callback functions defined in @ref FMM_Callback_API.h.  It may be 
+ * used in place of an updateGridPointFuncPtr (see 
+ * FMM_Core_setUpdateGridPointLinearIdx()).
+ */
+typedef LSMLIB_REAL (*updateGridPointLinearIdxFuncPtr)(  
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int idx,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 
 /*================== FMM_Core Function Declarations ==================*/
 
@@ -135,6 +187,9 @@ typedef LSMLIB_REAL (*updateGridPointFuncPtr)(
  *  - The updateGridPoint() and initializeFront() callback functions
  *    MUST follow the protocol described in @ref FMM_Callback_API.h.
  *
+ *  - The trial points are stored in the priority queue selected by
+ *    FMM_Core_setDefaultQueueType() using the default bucket width.
+ *
  */
 FMM_CoreData* FMM_Core_createFMM_CoreData(
   FMM_FieldData *fmm_field_data,
@@ -144,6 +199,149 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   initializeFrontFuncPtr initializeFront,
   updateGridPointFuncPtr updateGridPoint);
 
+/*!
+ * FMM_Core_createFMM_CoreDataWithQueue() is identical to 
+ * FMM_Core_createFMM_CoreData() except that the priority queue used 
+ * for the "trial" points is explicitly specified.
+ *
+ * Arguments:
+ *  - fmm_field_data (in):          pointer to FMM_FieldData data structure
+ *  - num_dims (in):                number of dimensions for FMM computation
+ *  - grid_dims (in):               integer array of dimensions of computational
+ *                                  grid
+ *  - dx (in):                      LSMLIB_REAL array containing grid cell 
+ *                                  sizes in each of the coordinate directions
+ *  - initializeFront (in):         callback function pointer that is 
+ *                                  used to find and initialize the front
+ *  - updateGridPoint (in):         callback function pointer that is 
+ *                                  used to update individual grid points
+ *  - queue_type (in):              type of priority queue to use for 
+ *                                  trial points
+ *  - bucket_width (in):            width of buckets in the bucketed queue
+ *                                  (ignored for the binary heap)
+ *
+ * Return value:                    pointer to new FMM_CoreData structure
+ *
+ * NOTES:
+ *  - If bucket_width is not positive, the default bucket width of
+ *    FMM_CORE_DEFAULT_BUCKET_WIDTH_FRACTION*min(dx) is used.  This 
+ *    default is appropriate for distance function calculations.  For 
+ *    solutions of the Eikonal equation, the bucket width should be 
+ *    scaled by the inverse of the maximum speed.
+ *
+ *  - See FMM_Core_createFMM_CoreData() for additional notes.
+ *
+ */
+FMM_CoreData* FMM_Core_createFMM_CoreDataWithQueue(
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL bucket_width);
+
+/*!
+ * FMM_Core_resetFMM_CoreData() reinitializes an existing FMM_CoreData 
+ * structure for a new calculation.  The result is the same as 
+ * destroying the FMM_CoreData and creating a new one using
+ * FMM_Core_createFMM_CoreDataWithQueue(), but the memory allocated
+ * for earlier calculations is reused.
+ *
+ * Arguments:
+ *  - fmm_core_data (in/out):       FMM_CoreData "object" to reinitialize
+ *  - all other arguments:          see FMM_Core_createFMM_CoreDataWithQueue()
+ *
+ * Return value:                    none
+ *
+ * NOTES:
+ *  - The grid data arrays are only reallocated when the grid has more
+ *    grid points than any grid that the FMM_CoreData has been used for.
+ *
+ *  - The priority queues are emptied but keep the memory they grew to
+ *    during earlier calculations, so they do not need to grow again
+ *    for calculations of similar size.  The trial point queue is only
+ *    recreated when the queue type changes.
+ *
+ *  - Any linear-index grid point update function registered using 
+ *    FMM_Core_setUpdateGridPointLinearIdx() and any stop value set 
+ *    using FMM_Core_setStopValue() are cleared.
+ *
+ */
+void FMM_Core_resetFMM_CoreData(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_CoreQueueType queue_type,
+  LSMLIB_REAL bucket_width);
+
+/*!
+ * FMM_Core_setUpdateGridPointLinearIdx() sets the callback function 
+ * used to update individual grid points to a function that is passed
+ * the linear (i.e. array) index of the grid point in addition to its 
+ * grid index.
+ *
+ * Arguments:
+ *  - fmm_core_data (in/out):       FMM_CoreData "object" actively managing 
+ *                                  the FMM computation
+ *  - updateGridPointLinearIdx (in):callback function pointer that is 
+ *                                  used to update individual grid points
+ *                                  during the FMM algorithm
+ *                                  (see @ref FMM_Callback_API.h for more 
+ *                                  details)
+ *
+ * Return value:                    none
+ *
+ * NOTES:
+ *  - When set, updateGridPointLinearIdx() is used instead of the 
+ *    updateGridPoint() callback passed to FMM_Core_createFMM_CoreData(),
+ *    so updateGridPoint may be NULL.
+ *
+ *  - Because the linear index of the grid point is supplied, the 
+ *    callback function can locate neighboring grid points using 
+ *    fixed offsets into the data arrays instead of converting between 
+ *    the grid index and linear index for every neighbor.
+ *
+ */
+void FMM_Core_setUpdateGridPointLinearIdx(
+  FMM_CoreData *fmm_core_data,
+  updateGridPointLinearIdxFuncPtr updateGridPointLinearIdx);
+
+/*!
+ * FMM_Core_setDefaultQueueType() sets the type of priority queue used 
+ * by FMM_Core_createFMM_CoreData().  The initial default is 
+ * FMM_CORE_BINARY_HEAP.
+ *
+ * Arguments:
+ *  - queue_type (in):  type of priority queue to use for trial points
+ *
+ * Return value:        none
+ *
+ * NOTES:
+ *  - The default queue type is shared by all FMM calculations in
+ *    the process, so it provides a way to select the queue used by
+ *    the fast marching method drivers (e.g. computeDistanceFunction3d())
+ *    without changing their interfaces.
+ *
+ */
+void FMM_Core_setDefaultQueueType(FMM_CoreQueueType queue_type);
+
+/*!
+ * FMM_Core_getDefaultQueueType() returns the type of priority queue 
+ * used by FMM_Core_createFMM_CoreData().
+ *
+ * Arguments:           none
+ *
+ * Return value:        default type of priority queue for trial points
+ *
+ */
+FMM_CoreQueueType FMM_Core_getDefaultQueueType(void);
+
 /*!
  * FMM_Core_destroyFMM_CoreData() frees the memory associated with an 
  * FMM_CoreData structure.
@@ -205,6 +403,40 @@ void FMM_Core_setInitialFrontPoint(
   int *grid_idx, 
   LSMLIB_REAL value);
 
+/*!
+ * FMM_Core_setInitialTrialPoint() sets a grid point as being an initial
+ * "trial" point with a tentative value supplied by the user.
+ *
+ * Arguments:
+ *  - fmm_core_data (in):  FMM_CoreData "object" actively managing the 
+ *                         FMM computation
+ *  - grid_idx (in):       integer array containing the grid index of the 
+ *                         grid point to set as an initial trial point
+ *  - value (in):          tentative value of the grid point (e.g. distance 
+ *                         or arrival time supplied as boundary data)
+ *
+ * Return value:           none
+ *
+ * NOTES:
+ *  - This function may only be called during the user-defined 
+ *    initializeFrontFuncPtr() callback function.
+ *
+ *  - Initial trial points are treated in exactly the same way as any 
+ *    other trial point.  In particular, their value will be recomputed 
+ *    by the user-defined updateGridPointFuncPtr() callback function 
+ *    whenever one of their neighbors is accepted as "known".  It is 
+ *    the responsibility of the callback function to retain the 
+ *    tentative value if it is smaller than the updated value.
+ *
+ *  - It is assumed that the size of the grid_idx array is at least 
+ *    equal to the number of spatial dimensions of the problem. 
+ *
+ */
+void FMM_Core_setInitialTrialPoint(
+  FMM_CoreData *fmm_core_data, 
+  int *grid_idx, 
+  LSMLIB_REAL value);
+
 /*!
  * FMM_Core_markPointOutsideDomain() sets a grid point as being outside of 
  * the mathematical domain for the problem.
@@ -245,6 +477,34 @@ void FMM_Core_markPointOutsideDomain(
  */
 void FMM_Core_advanceFront(FMM_CoreData *fmm_core_data);
 
+/*!
+ * FMM_Core_setStopValue() sets the value of the front beyond which
+ * the FMM calculation is terminated.
+ *
+ * Arguments:
+ *  - fmm_core_data (in):  FMM_CoreData "object" actively managing the 
+ *                         FMM computation
+ *  - stop_value (in):     value of the front beyond which no more grid
+ *                         points are updated
+ *
+ * Return value:           none
+ *
+ * NOTES:
+ *  - Once a grid point with a value greater than stop_value has been
+ *    accepted by FMM_Core_advanceFront(), FMM_Core_moreGridPointsToUpdate() 
+ *    returns false even if there are "trial" points remaining.  At most
+ *    one grid point with a value greater than stop_value is set to 
+ *    "known".  The remaining grid points keep their "trial" or "far" 
+ *    status.
+ *
+ *  - By default, the stop value is LSMLIB_REAL_MAX (i.e. the
+ *    calculation continues until there are no "trial" points left).
+ *
+ */
+void FMM_Core_setStopValue(
+  FMM_CoreData *fmm_core_data,
+  LSMLIB_REAL stop_value);
+
 /*!
  * FMM_Core_moreGridPointsToUpdate() determines whether there are more grid 
  * points to update.
@@ -269,8 +529,13 @@ int FMM_Core_moreGridPointsToUpdate(FMM_CoreData *fmm_core_data);
  * 
  * Return value:           pointer to gridpoint_status data array
  *
+ * NOTES:
+ *  - The status of each grid point is stored as a single byte 
+ *    containing one of the PointStatus values.
+ *
  */
-int* FMM_Core_getGridPointStatusDataArray(FMM_CoreData *fmm_core_data);
+unsigned char* FMM_Core_getGridPointStatusDataArray(
+  FMM_CoreData *fmm_core_data);
 
 #ifdef __cplusplus
 }
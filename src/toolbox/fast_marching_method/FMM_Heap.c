@@ -43,7 +43,6 @@
 struct FMM_Heap {
   int* d_heap;
   FMM_HeapNode* d_nodes;
-  int d_num_dims;
   int d_heap_size;
   int d_heap_mem_size;
   LSMLIB_REAL d_heap_growth_factor;
@@ -88,8 +87,7 @@ static void FMM_Heap_downHeap(FMM_Heap* heap, int heap_pos);
 
 /*==================== Function Definitions =========================*/
 
-FMM_Heap* FMM_Heap_createHeap(int num_dims, int heap_mem_size, 
-  LSMLIB_REAL growth_factor)
+FMM_Heap* FMM_Heap_createHeap(int heap_mem_size, LSMLIB_REAL growth_factor)
 {
   FMM_Heap* heap;
 
@@ -98,7 +96,6 @@ FMM_Heap* FMM_Heap_createHeap(int num_dims, int heap_mem_size,
   if (growth_factor < 1) growth_factor = DEFAULT_HEAP_GROWTH_FACTOR; 
 
   heap = (FMM_Heap*) malloc(sizeof(FMM_Heap));
-  heap->d_num_dims = num_dims;
   heap->d_heap_size = 0;
   heap->d_heap_mem_size = heap_mem_size;
   heap->d_heap_growth_factor = growth_factor;
@@ -115,18 +112,15 @@ void FMM_Heap_destroyHeap(FMM_Heap* heap)
   free(heap);
 }
 
-int FMM_Heap_insertNode(FMM_Heap* heap, int *grid_idx, LSMLIB_REAL value)
+int FMM_Heap_insertNode(FMM_Heap* heap, int idx, LSMLIB_REAL value)
 {
   int *d_heap = heap->d_heap;
   FMM_HeapNode* d_nodes = heap->d_nodes;
   int d_heap_size = heap->d_heap_size;
-  int i;
 
   /* insert node at bottom heap */
   d_heap[d_heap_size] = d_heap_size;
-  for (i = 0; i< heap->d_num_dims; i++) {
-    d_nodes[d_heap_size].grid_idx[i] = grid_idx[i];
-  }
+  d_nodes[d_heap_size].idx = idx;
   d_nodes[d_heap_size].value = value;
   d_nodes[d_heap_size].heap_pos = d_heap_size;
 
@@ -174,15 +168,11 @@ FMM_HeapNode FMM_Heap_extractMin(FMM_Heap* heap, FMM_HeapNode* moved_node,
 
   } else {
 
-    int i;
-
     /* set position occupied by root node to invalid state */
     d_nodes[root_handle].value = LSMLIB_REAL_MAX;
     
     /* set moved_node and moved_handle to invalid state */
-    for (i = 0; i < FMM_HEAP_MAX_NDIM; i++) {
-      moved_node_local.grid_idx[i] = -1;
-    }
+    moved_node_local.idx = -1;
     moved_node_local.value = LSMLIB_REAL_MAX;
     moved_node_local.heap_pos = -1;
     moved_handle_local = -1;
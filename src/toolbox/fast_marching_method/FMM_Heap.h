@@ -37,10 +37,10 @@ extern "C" {
  *
  *
  * <h3> NOTES: </h3>
- * - At this point in time, this library is only works for up
- *   to 8 spatial dimensions.   This source of this 
- *   is the size of the grid_idx data member in 
- *   of the FMM_HeapNode structure.  
+ * - Grid points are identified by their linear (i.e. array) index
+ *   so that FMM_HeapNodes are compact and independent of the number 
+ *   of spatial dimensions.  Conversion between the linear index and 
+ *   the grid index is the responsibility of the user of FMM_Heap.
  *
  */
 
@@ -52,20 +52,15 @@ extern "C" {
 typedef struct FMM_Heap FMM_Heap;
 
 
-/*! 
- * maximum number of spatial dimensions in grid 
- */
-#define FMM_HEAP_MAX_NDIM (8)
-
 /*!
- * The FMM_HeapNode structure stores the index of a grid cell, the value 
- * of the function within that cell, and heap_pos that is used 
- * internally to maintain the heap.
+ * The FMM_HeapNode structure stores the linear index of a grid cell, 
+ * the value of the function within that cell, and heap_pos that is 
+ * used internally to maintain the heap.
  */
 typedef struct HeapNode {
-  int grid_idx[FMM_HEAP_MAX_NDIM];      /* grid index     */
-  LSMLIB_REAL value;                    /* function value */
-  int heap_pos;                         /* internal data  */
+  int idx;                              /* linear grid index */
+  LSMLIB_REAL value;                    /* function value    */
+  int heap_pos;                         /* internal data     */
 } FMM_HeapNode;
 
 
@@ -75,7 +70,6 @@ typedef struct HeapNode {
  * growth factor.
  *
  * Arguments:
- *  - num_dims (in):       number of spatial dimensions for FMM calculation
  *  - heap_mem_size (in):  number of nodes to initially allocate memory for
  *  - growth_factor (in):  factor used to grow size of memory allocated for
  *                         heap when the heap exhausts its memory allocation
@@ -89,8 +83,7 @@ typedef struct HeapNode {
  *  - To use the default growth factor (2), set growth_factor = 0.
  *
  */
-FMM_Heap* FMM_Heap_createHeap(int num_dims, int heap_mem_size, 
-  LSMLIB_REAL growth_factor);
+FMM_Heap* FMM_Heap_createHeap(int heap_mem_size, LSMLIB_REAL growth_factor);
 
 /*!
  * FMM_Heap_destroyHeap() frees the memory used to store the heap.
@@ -109,7 +102,7 @@ void FMM_Heap_destroyHeap(FMM_Heap* heap);
  *
  * Arguments:
  *  - heap (in):      pointer to heap 
- *  - grid_idx (in):  grid index of node to insert into heap
+ *  - idx (in):       linear grid index of node to insert into heap
  *  - value (in):     value of node to insert into heap
  *
  * Return value:      integer handle to the FMM_HeapNode created for 
@@ -119,7 +112,7 @@ void FMM_Heap_destroyHeap(FMM_Heap* heap);
  *       may be changed by an FMM_Heap_extractMin() operation and need 
  *       to be updated accordingly after calling FMM_Heap_extractMin().
  */
-int FMM_Heap_insertNode(FMM_Heap* heap, int *grid_idx, LSMLIB_REAL value);
+int FMM_Heap_insertNode(FMM_Heap* heap, int idx, LSMLIB_REAL value);
 
 /*!
  * FMM_Heap_extractMin() removes the FMM_HeapNode with the minimum 
@@ -35,6 +35,8 @@ extern "C" {
  *      ----------                             ------------
  */
 #define LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL lsm2dzerooutlevelseteqnrhslocal_
+#define LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL                          \
+                                        lsm2dzerooutlevelseteqnrhsfblocal_
 #define LSM2D_ADD_ADVECTION_TERM_TO_LSE_RHS_LOCAL                             \
                                         lsm2daddadvectiontermtolserhslocal_
 #define LSM2D_ADD_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL                            \
@@ -77,6 +79,40 @@ void LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL(
   const int *index_y,
   const int *nlo_index,
   const int *nhi_index);
+
+/*!
+ * LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL() is the same as 
+ * LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL() except that only the narrow 
+ * band points in the fillbox are zeroed out, so lse_rhs only needs to
+ * be allocated on the fillbox.
+ *
+ * Arguments:
+ *  - lse_rhs (in/out):  right-hand of level set equation
+ *  - *_gb (in):         index range for ghostbox
+ *  - index_[xy](in):    [xy] coordinates of local (narrow band) points
+ *  - n*_index(in):      index range of points in index_*
+ *  - narrow_band(in):   array that marks voxels outside desired fillbox
+ *  - mark_fb(in):       upper limit narrow band value for voxels in 
+ *                       fillbox
+ *
+ * Return value:         none
+ */
+void LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL(
+  LSMLIB_REAL *lse_rhs,
+  const int *ilo_lse_rhs_gb, 
+  const int *ihi_lse_rhs_gb,
+  const int *jlo_lse_rhs_gb, 
+  const int *jhi_lse_rhs_gb,
+  const int *index_x,
+  const int *index_y,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const unsigned char *mark_fb);
   
   
 /*!
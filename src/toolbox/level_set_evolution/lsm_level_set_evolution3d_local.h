@@ -35,6 +35,8 @@ extern "C" {
  *      ----------                             ------------
  */
 #define LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL lsm3dzerooutlevelseteqnrhslocal_ 
+#define LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL                          \
+                                        lsm3dzerooutlevelseteqnrhsfblocal_
 #define LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL   \
                                         lsm3daddconstnormalveltermtolserhslocal_
 #define LSM3D_ADD_ADVECTION_TERM_TO_LSE_RHS_LOCAL          \
@@ -47,6 +49,8 @@ extern "C" {
                                        lsm3daddconstprecomputedcurvtermtolserhslocal_					
 #define LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL	\
                                   lsm3daddexternalandnormalveltermtolserhslocal_						
+#define LSM3D_COMPUTE_CONST_NORMAL_VEL_CONST_CURV_LSE_RHS_LOCAL \
+                               lsm3dcomputeconstnormalvelconstcurvlserhslocal_
 
 
 /*!
@@ -78,6 +82,45 @@ void LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL(
   const int *nlo_index,
   const int *nhi_index);
 
+/*!
+*
+*  LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL() is the same as 
+*  LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL() except that only the narrow 
+*  band points in the fillbox are zeroed out, so lse_rhs only needs to
+*  be allocated on the fillbox.
+*
+*  Arguments:
+*    lse_rhs (in/out):  right-hand of level set equation
+*    index_[xyz](in):  [xyz] coordinates of local (narrow band) points
+*    n*_index(in):     index range of points in index_*
+*    narrow_band(in):  array that marks voxels outside desired fillbox
+*    mark_fb(in):      upper limit narrow band value for voxels in 
+*                      fillbox
+*    *_gb (in):        index range for ghostbox
+*
+*/
+void LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_FB_LOCAL(
+  LSMLIB_REAL *lse_rhs,
+  const int *ilo_lse_rhs_gb, 
+  const int *ihi_lse_rhs_gb,
+  const int *jlo_lse_rhs_gb, 
+  const int *jhi_lse_rhs_gb,
+  const int *klo_lse_rhs_gb, 
+  const int *khi_lse_rhs_gb,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
 /*!
 *
 *  LSM3D_ADD_ADVECTION_TERM_TO_LSE_RHS_LOCAL() adds the contribution of an advection
@@ -495,6 +538,82 @@ void LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
   const int *klo_nb_gb,
   const int *khi_nb_gb,
   const unsigned char *mark_fb);
+
+
+/*!
+*
+*  LSM3D_COMPUTE_CONST_NORMAL_VEL_CONST_CURV_LSE_RHS_LOCAL() computes the
+*  right-hand side of the level set equation when it is written in the 
+*  form:
+*
+*    phi_t = -vel_n |grad(phi)| + b*kappa*|grad(phi)|
+*
+*  and the stable time step for the normal velocity term in a single pass
+*  over the narrow band.  The second-order HJ ENO approximations to 
+*  grad(phi) and the central differences used in the curvature term are 
+*  computed directly from phi, so no derivative arrays are required.
+*  The routine loops only over local (narrow band) points.
+*
+*  Arguments:
+*    lse_rhs (out):     right-hand of level set equation
+*    phi (in):          level set function at t = t_cur
+*    vel_n (in):        scalar normal velocity at t = t_cur
+*    b (in):            scalar curvature term component
+*    dx, dy, dz (in):   grid spacing
+*    cfl_number (in):   CFL number
+*    dt (out):          stable time step for normal velocity term
+*    *_gb (in):         index range for ghostbox
+*    index_[xyz](in):   [xyz] coordinates of local (narrow band) points
+*    n*_index(in):      index range of level 0 points in index_*
+*    narrow_band(in):   array that marks voxels outside desired fillbox
+*    mark_fb(in):       upper limit narrow band value for voxels in 
+*                       fillbox
+*
+*  NOTES:
+*   - the result is identical to calling LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL(),
+*     LSM3D_HJ_ENO2_LOCAL(), LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(),
+*     LSM3D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT_LOCAL(),
+*     LSM3D_CENTRAL_GRAD_ORDER2_LOCAL() and 
+*     LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL() in sequence.
+*   - the normal velocity term (and dt calculation) is skipped when 
+*     vel_n is zero; the curvature term is skipped when b is zero.
+*
+*/
+void LSM3D_COMPUTE_CONST_NORMAL_VEL_CONST_CURV_LSE_RHS_LOCAL(
+  LSMLIB_REAL *lse_rhs,
+  const int *ilo_lse_rhs_gb, 
+  const int *ihi_lse_rhs_gb,
+  const int *jlo_lse_rhs_gb, 
+  const int *jhi_lse_rhs_gb,
+  const int *klo_lse_rhs_gb, 
+  const int *khi_lse_rhs_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb, 
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *vel_n,
+  const LSMLIB_REAL *b,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const LSMLIB_REAL *cfl_number,
+  LSMLIB_REAL *dt,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z, 
+  const int *nlo_index,
+  const int *nhi_index, 
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
   
 #ifdef __cplusplus
 }
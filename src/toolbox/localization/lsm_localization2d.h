@@ -42,6 +42,8 @@ extern "C" {
  #define LSM2D_MARK_NARROW_BAND_BOUNDARY_LAYER lsm2dmarknarrowbandboundarylayer_
  #define LSM2D_DETERMINE_NARROW_BAND_FROM_MASK lsm2ddeterminenarrowbandfrommask_
  #define LSM2D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL  lsm2dmultiplycutofflserhslocal_
+ #define LSM2D_MULTIPLY_CUT_OFF_LSE_RHS_FB_LOCAL \
+                                        lsm2dmultiplycutofflserhsfblocal_
  #define LSM2D_CHECK_OUTER_NARROW_BAND_LAYER   lsm2dcheckouternarrowbandlayer_ 
 
  #define LSM2D_IMPOSE_MASK_LOCAL               lsm2dimposemasklocal_
@@ -385,6 +387,49 @@ extern "C" {
  const LSMLIB_REAL *gamma);
 
  
+/*!
+*
+*  LSM2D_MULTIPLY_CUT_OFF_LSE_RHS_FB_LOCAL() is the same as 
+*  LSM2D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL() except that phi and lse_rhs
+*  have separate index ranges, so lse_rhs only needs to be allocated on 
+*  the fillbox.
+*
+*  Arguments:
+*    phi(in):           level set method function
+*    lse_rhs (in/out):  right-hand of level set equation         
+*    index_*(in):       array with coordinates of narrow band voxels
+*                       indices
+*    narrow_band(in):   array that marks voxels outside desired fillbox
+*    mark_fb(in):       upper limit narrow band value for voxels in 
+*                       fillbox
+*    n*_index:          index range of index_* arrays
+*    *_gb (in):         index range for ghostbox
+*
+*/
+ void LSM2D_MULTIPLY_CUT_OFF_LSE_RHS_FB_LOCAL(
+ const LSMLIB_REAL *phi,
+ const int *ilo_phi_gb, 
+ const int *ihi_phi_gb,
+ const int *jlo_phi_gb, 
+ const int *jhi_phi_gb,
+ LSMLIB_REAL *lse_rhs,
+ const int *ilo_lse_rhs_gb, 
+ const int *ihi_lse_rhs_gb,
+ const int *jlo_lse_rhs_gb, 
+ const int *jhi_lse_rhs_gb,
+ const int *index_x,
+ const int *index_y, 
+ const int *nlo_index, 
+ const int *nhi_index,
+ const unsigned char *narrow_band,
+ const int *ilo_nb_gb, 
+ const int *ihi_nb_gb,
+ const int *jlo_nb_gb, 
+ const int *jhi_nb_gb,
+ const unsigned char *mark_fb,
+ const LSMLIB_REAL *beta,
+ const LSMLIB_REAL *gamma);
+
 /*!
 *
 *  LSM2D_CHECK_OUTER_NARROW_BAND_LAYER() checks outer narrow band voxels for 
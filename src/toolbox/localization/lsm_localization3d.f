@@ -156,8 +156,10 @@ c       } end examine points one level less
 	  n_lo(l) = n_hi(l-1) + 1
 	  n_hi(l) = count - 1
 	else
-	  n_lo(l) = -1
-	  n_hi(l) = -1
+c         empty level: store an empty index range so that the next
+c         level (and the narrow band kernels) skip it
+	  n_lo(l) = n_hi(l-1) + 1
+	  n_hi(l) = n_hi(l-1)
 	endif
 	
       enddo
@@ -563,6 +565,95 @@ c } end subroutine
 c***********************************************************************
 
 
+c***********************************************************************
+      subroutine lsm3dMultiplyCutOffLSERHSFBLOCAL(
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  klo_phi_gb, khi_phi_gb,
+     &  lse_rhs,
+     &  ilo_lse_rhs_gb, ihi_lse_rhs_gb,
+     &  jlo_lse_rhs_gb, jhi_lse_rhs_gb,
+     &  klo_lse_rhs_gb, khi_lse_rhs_gb,
+     &  index_x,
+     &  index_y, 
+     &  index_z, 
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb,
+     &  jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb,
+     &  mark_fb,
+     &  beta, gamma)
+c**********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer klo_phi_gb, khi_phi_gb
+      integer ilo_lse_rhs_gb, ihi_lse_rhs_gb
+      integer jlo_lse_rhs_gb, jhi_lse_rhs_gb
+      integer klo_lse_rhs_gb, khi_lse_rhs_gb
+      real phi(ilo_phi_gb:ihi_phi_gb,jlo_phi_gb:jhi_phi_gb,
+     &         klo_phi_gb:khi_phi_gb)
+      real lse_rhs(ilo_lse_rhs_gb:ihi_lse_rhs_gb,
+     &             jlo_lse_rhs_gb:jhi_lse_rhs_gb,
+     &             klo_lse_rhs_gb:khi_lse_rhs_gb)
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      real beta, gamma
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,
+     &                      jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer*1 mark_fb
+      
+c     local variables      
+      integer i,j,k,l
+      real abs_phi_val, cut_off_coeff
+      real gb_const1, gb_const2, temp
+      
+      gb_const1 = gamma - 3*beta;
+      gb_const2 = (gamma - beta);
+      gb_const2 = gb_const2*gb_const2*gb_const2;
+      
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index      
+        i=index_x(l)
+	j=index_y(l)
+	k=index_z(l)        
+	
+        if( narrow_band(i,j,k) .le. mark_fb ) then
+
+	    abs_phi_val = abs(phi(i,j,k))
+	      	      
+	    if( abs_phi_val .le. beta ) then
+	       cut_off_coeff = 1
+	    else if( abs_phi_val .le. gamma ) then
+	       temp = (abs_phi_val - gamma);
+	       cut_off_coeff = ( temp * temp
+     &               *(2*abs_phi_val + gb_const1) ) / gb_const2
+	    else 
+	       cut_off_coeff = 0
+	    endif
+	    
+            lse_rhs(i,j,k) = cut_off_coeff*lse_rhs(i,j,k)
+	endif
+	    
+      enddo 
+c     } end loop over indexed points
+	
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+
 
 c***********************************************************************
       subroutine lsm3dCheckOuterNarrowBandLayer(
@@ -37,10 +37,18 @@ extern "C" {
 #define LSM1D_HJ_ENO2                lsm1dhjeno2_
 #define LSM1D_HJ_ENO3                lsm1dhjeno3_
 #define LSM1D_HJ_WENO5               lsm1dhjweno5_
+#define LSM1D_HJ_ENO1_NO_SCRATCH     lsm1dhjeno1noscratch_
+#define LSM1D_HJ_ENO2_NO_SCRATCH     lsm1dhjeno2noscratch_
+#define LSM1D_HJ_ENO3_NO_SCRATCH     lsm1dhjeno3noscratch_
+#define LSM1D_HJ_WENO5_NO_SCRATCH    lsm1dhjweno5noscratch_
 #define LSM1D_UPWIND_HJ_ENO1         lsm1dupwindhjeno1_
 #define LSM1D_UPWIND_HJ_ENO2         lsm1dupwindhjeno2_
 #define LSM1D_UPWIND_HJ_ENO3         lsm1dupwindhjeno3_
 #define LSM1D_UPWIND_HJ_WENO5        lsm1dupwindhjweno5_
+#define LSM1D_UPWIND_HJ_ENO1_NO_SCRATCH  lsm1dupwindhjeno1noscratch_
+#define LSM1D_UPWIND_HJ_ENO2_NO_SCRATCH  lsm1dupwindhjeno2noscratch_
+#define LSM1D_UPWIND_HJ_ENO3_NO_SCRATCH  lsm1dupwindhjeno3noscratch_
+#define LSM1D_UPWIND_HJ_WENO5_NO_SCRATCH lsm1dupwindhjweno5noscratch_
 #define LSM1D_CENTRAL_GRAD_ORDER2    lsm1dcentralgradorder2_
 #define LSM1D_CENTRAL_GRAD_ORDER4    lsm1dcentralgradorder4_
 #define LSM1D_LAPLACIAN_ORDER2       lsm1dlaplacianorder2_
@@ -248,6 +256,158 @@ void LSM1D_HJ_WENO5(
   const LSMLIB_REAL *dx);
 
 
+/*!
+ * LSM1D_HJ_ENO1_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * first-order Hamilton-Jacobi ENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx (in):            grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_HJ_ENO1(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM1D_HJ_ENO1_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
+/*!
+ * LSM1D_HJ_ENO2_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * second-order Hamilton-Jacobi ENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx (in):            grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_HJ_ENO2(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM1D_HJ_ENO2_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
+/*!
+ * LSM1D_HJ_ENO3_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * third-order Hamilton-Jacobi ENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx (in):            grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_HJ_ENO3(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM1D_HJ_ENO3_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
+/*!
+ * LSM1D_HJ_WENO5_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * fifth-order Hamilton-Jacobi WENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx (in):            grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_HJ_WENO5(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM1D_HJ_WENO5_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
 /*! 
  * LSM1D_UPWIND_HJ_ENO1() computes the first-order Hamilton-Jacobi ENO
  * upwind approximation to the gradient of \f$ \phi \f$.
@@ -408,6 +568,154 @@ void LSM1D_UPWIND_HJ_WENO5(
   const LSMLIB_REAL *dx);
 
 
+/*! 
+ * LSM1D_UPWIND_HJ_ENO1_NO_SCRATCH() computes the first-order Hamilton-Jacobi
+ * ENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_x (out):  derivative of \f$ \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_x (in):   velocity in the x-direction
+ *  - dx (in):      grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_UPWIND_HJ_ENO1(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM1D_UPWIND_HJ_ENO1_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
+/*! 
+ * LSM1D_UPWIND_HJ_ENO2_NO_SCRATCH() computes the second-order Hamilton-Jacobi
+ * ENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_x (out):  derivative of \f$ \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_x (in):   velocity in the x-direction
+ *  - dx (in):      grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_UPWIND_HJ_ENO2(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM1D_UPWIND_HJ_ENO2_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
+/*! 
+ * LSM1D_UPWIND_HJ_ENO3_NO_SCRATCH() computes the third-order Hamilton-Jacobi
+ * ENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_x (out):  derivative of \f$ \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_x (in):   velocity in the x-direction
+ *  - dx (in):      grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_UPWIND_HJ_ENO3(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM1D_UPWIND_HJ_ENO3_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
+/*! 
+ * LSM1D_UPWIND_HJ_WENO5_NO_SCRATCH() computes the fifth-order Hamilton-Jacobi
+ * WENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_x (out):  derivative of \f$ \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_x (in):   velocity in the x-direction
+ *  - dx (in):      grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM1D_UPWIND_HJ_WENO5(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM1D_UPWIND_HJ_WENO5_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *dx);
+
+
 /*! 
  * LSM1D_CENTRAL_GRAD_ORDER2() computes the second-order, central,
  * finite difference approximation to the gradient of \f$ \phi \f$ using 
@@ -37,10 +37,18 @@ extern "C" {
 #define LSM2D_HJ_ENO2                lsm2dhjeno2_
 #define LSM2D_HJ_ENO3                lsm2dhjeno3_
 #define LSM2D_HJ_WENO5               lsm2dhjweno5_
+#define LSM2D_HJ_ENO1_NO_SCRATCH     lsm2dhjeno1noscratch_
+#define LSM2D_HJ_ENO2_NO_SCRATCH     lsm2dhjeno2noscratch_
+#define LSM2D_HJ_ENO3_NO_SCRATCH     lsm2dhjeno3noscratch_
+#define LSM2D_HJ_WENO5_NO_SCRATCH    lsm2dhjweno5noscratch_
 #define LSM2D_UPWIND_HJ_ENO1         lsm2dupwindhjeno1_
 #define LSM2D_UPWIND_HJ_ENO2         lsm2dupwindhjeno2_
 #define LSM2D_UPWIND_HJ_ENO3         lsm2dupwindhjeno3_
 #define LSM2D_UPWIND_HJ_WENO5        lsm2dupwindhjweno5_
+#define LSM2D_UPWIND_HJ_ENO1_NO_SCRATCH  lsm2dupwindhjeno1noscratch_
+#define LSM2D_UPWIND_HJ_ENO2_NO_SCRATCH  lsm2dupwindhjeno2noscratch_
+#define LSM2D_UPWIND_HJ_ENO3_NO_SCRATCH  lsm2dupwindhjeno3noscratch_
+#define LSM2D_UPWIND_HJ_WENO5_NO_SCRATCH lsm2dupwindhjweno5noscratch_
 #define LSM2D_CENTRAL_GRAD_ORDER2    lsm2dcentralgradorder2_
 #define LSM2D_CENTRAL_GRAD_ORDER4    lsm2dcentralgradorder4_
 #define LSM2D_LAPLACIAN_ORDER2       lsm2dlaplacianorder2_
@@ -314,6 +322,202 @@ void LSM2D_HJ_WENO5(
   const LSMLIB_REAL *dy);
 
 
+/*!
+ * LSM2D_HJ_ENO1_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * first-order Hamilton-Jacobi ENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx, dy (in):        grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_HJ_ENO1(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM2D_HJ_ENO1_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_HJ_ENO2_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * second-order Hamilton-Jacobi ENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx, dy (in):        grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_HJ_ENO2(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM2D_HJ_ENO2_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_HJ_ENO3_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * third-order Hamilton-Jacobi ENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx, dy (in):        grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_HJ_ENO3(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM2D_HJ_ENO3_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_HJ_WENO5_NO_SCRATCH() computes the forward (plus) and backward (minus)
+ * fifth-order Hamilton-Jacobi WENO approximations to the gradient of
+ * \f$ \phi \f$ without scratch arrays for the undivided differences.
+ *           
+ * Arguments:
+ *  - phi_*_plus (out):   components of \f$ \nabla \phi \f$ in plus direction
+ *  - phi_*_minus (out):  components of \f$ \nabla \phi \f$ in minus direction
+ *  - phi (in):           \f$ \phi \f$
+ *  - dx, dy (in):        grid spacing
+ *  - *_gb (in):          index range for ghostbox
+ *  - *_fb (in):          index range for fillbox
+ *      
+ * Return value:          none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_HJ_WENO5(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - it is assumed that BOTH the plus AND minus derivatives have
+ *    the same fillbox
+ *
+ */
+void LSM2D_HJ_WENO5_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
 /*! 
  * LSM2D_UPWIND_HJ_ENO1() computes the first-order Hamilton-Jacobi ENO
  * upwind approximation to the gradient of \f$ \phi \f$.
@@ -532,6 +736,198 @@ void LSM2D_UPWIND_HJ_WENO5(
   const LSMLIB_REAL *dy);
 
 
+/*! 
+ * LSM2D_UPWIND_HJ_ENO1_NO_SCRATCH() computes the first-order Hamilton-Jacobi
+ * ENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_* (out):  components of \f$ \nabla \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_* (in):   components of the velocity 
+ *  - dx, dy (in):  grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_UPWIND_HJ_ENO1(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM2D_UPWIND_HJ_ENO1_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*! 
+ * LSM2D_UPWIND_HJ_ENO2_NO_SCRATCH() computes the second-order Hamilton-Jacobi
+ * ENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_* (out):  components of \f$ \nabla \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_* (in):   components of the velocity 
+ *  - dx, dy (in):  grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_UPWIND_HJ_ENO2(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM2D_UPWIND_HJ_ENO2_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*! 
+ * LSM2D_UPWIND_HJ_ENO3_NO_SCRATCH() computes the third-order Hamilton-Jacobi
+ * ENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_* (out):  components of \f$ \nabla \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_* (in):   components of the velocity 
+ *  - dx, dy (in):  grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_UPWIND_HJ_ENO3(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM2D_UPWIND_HJ_ENO3_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*! 
+ * LSM2D_UPWIND_HJ_WENO5_NO_SCRATCH() computes the fifth-order Hamilton-Jacobi
+ * WENO upwind approximation to the gradient of \f$ \phi \f$ without
+ * scratch arrays for the undivided differences.
+ * 
+ * Arguments:
+ *  - phi_* (out):  components of \f$ \nabla \phi \f$
+ *  - phi (in):     \f$ \phi \f$
+ *  - vel_* (in):   components of the velocity 
+ *  - dx, dy (in):  grid cell size
+ *  - *_gb (in):    index range for ghostbox
+ *  - *_fb (in):    index range for fillbox
+ *
+ * Return value:    none
+ *
+ * NOTES:
+ *  - the results are identical to those of LSM2D_UPWIND_HJ_WENO5(); the
+ *    undivided differences are computed from \f$ \phi \f$ along the
+ *    stencil instead of being stored in grid-sized D* arrays
+ *  - the fillbox is defined in terms of the index range for 
+ *    cell-centered data
+ */
+void LSM2D_UPWIND_HJ_WENO5_NO_SCRATCH(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
 /*! 
  * LSM2D_CENTRAL_GRAD_ORDER2() computes the second-order, central,
  * finite difference approximation to the gradient of \f$ \phi \f$ 
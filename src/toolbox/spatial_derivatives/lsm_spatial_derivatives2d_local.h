@@ -45,6 +45,7 @@ extern "C" {
 #define LSM2D_LAPLACIAN_ORDER2_LOCAL     lsm2dlaplacianorder2local_
 #define LSM2D_COMPUTE_AVE_GRAD_PHI_LOCAL lsm2dcomputeavegradphilocal_
 #define LSM2D_GRADIENT_MAGNITUDE_LOCAL   lsm2dgradientmagnitudelocal_
+#define LSM2D_SELECT_UPWIND_HJ_LOCAL     lsm2dselectupwindhjlocal_
 #define LSM2D_DIVERGENCE_CENTRAL_LOCAL   lsm2ddivergencecentrallocal_
 
 /*!
@@ -651,6 +652,59 @@ void LSM2D_COMPUTE_AVE_GRAD_PHI_LOCAL(
   const unsigned char *mark_fb); 
 
        
+/*!
+*
+*  LSM2D_SELECT_UPWIND_HJ_LOCAL() selects the upwind approximation to the
+*  gradient of phi from precomputed plus and minus HJ derivatives.  
+*  The component of the upwind gradient is set to the minus derivative
+*  when the velocity component is positive, the plus derivative when 
+*  it is negative and zero when it is (numerically) zero.
+*
+*  Arguments:
+*    phi_* (out):        components of upwind grad(phi) 
+*    phi_*_plus (in):    components of grad(phi) in plus direction 
+*    phi_*_minus (in):   components of grad(phi) in minus direction
+*    vel_* (in):         components of velocity
+*    *_gb (in):          index range for ghostbox
+*    index_*(in):        coordinates of local (narrow band) points
+*    n*_index(in):       index range of points to loop over in index_*
+*    narrow_band(in):    array that marks voxels outside desired fillbox
+*    mark_fb(in):        upper limit narrow band value for voxels in 
+*                        fillbox
+*
+*  NOTES:
+*   - the upwind, plus and minus derivatives are assumed to have the 
+*     same ghostbox
+*
+*/
+void LSM2D_SELECT_UPWIND_HJ_LOCAL(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  const LSMLIB_REAL *phi_x_plus,
+  const LSMLIB_REAL *phi_y_plus,
+  const LSMLIB_REAL *phi_x_minus,
+  const LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *index_x,
+  const int *index_y,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const unsigned char *mark_fb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,7 @@ extern "C" {
  */
 #define LSM3D_HJ_ENO1_LOCAL              lsm3dhjeno1local_
 #define LSM3D_HJ_ENO2_LOCAL              lsm3dhjeno2local_
+#define LSM3D_HJ_ENO2_LOCAL_NO_SCRATCH   lsm3dhjeno2localnoscratch_
 
 #define LSM3D_CENTRAL_GRAD_ORDER2_LOCAL  lsm3dcentralgradorder2local_
 #define LSM3D_CENTRAL_GRAD_ORDER4_LOCAL  lsm3dcentralgradorder4local_
@@ -42,6 +43,7 @@ extern "C" {
 #define LSM3D_LAPLACIAN_ORDER2_LOCAL     lsm3dlaplacianorder2local_
 #define LSM3D_COMPUTE_AVE_GRAD_PHI_LOCAL lsm3dcomputeavegradphilocal_
 #define LSM3D_GRADIENT_MAGNITUDE_LOCAL   lsm3dgradientmagnitudelocal_
+#define LSM3D_SELECT_UPWIND_HJ_LOCAL     lsm3dselectupwindhjlocal_
 
 
 #ifdef __cplusplus
@@ -219,6 +221,84 @@ void LSM3D_HJ_ENO2_LOCAL(
   const unsigned char *mark_D1,
   const unsigned char *mark_D2);
 
+/*!
+*
+*  LSM3D_HJ_ENO2_LOCAL_NO_SCRATCH() computes the forward (plus) and 
+*  backward (minus) second-order Hamilton-Jacobi ENO approximations to 
+*  the gradient of phi without scratch arrays for the undivided 
+*  differences.
+*  The routine loops only over local (narrow band) points.
+*
+*  Arguments:
+*    phi_*_plus (out):   components of grad(phi) in plus direction 
+*    phi_*_minus (out):  components of grad(phi) in minus direction
+*    phi (in):           phi
+*    dx, dy, dz (in):    grid spacing
+*    *_gb (in):          index range for ghostbox
+*    index_*(in):        coordinates of local (narrow band) points
+*    n*_index[012](in):  index range of points in index_* that are in
+*                        level [012] of the narrow band
+*    narrow_band(in):    array that marks voxels outside desired fillbox
+*    mark_fb(in):        upper limit narrow band value for voxels in 
+*                        the fillbox
+*
+*  NOTES:
+*   - it is assumed that BOTH the plus and minus derivatives have
+*     the same fillbox
+*   - index_* arrays range at minimum from nlo_index0 to nhi_index2
+*   - the undivided differences are computed from phi along the 
+*     stencil, so phi must be valid two cells beyond every fillbox 
+*     point; no D1/D2 scratch arrays or mark_D1/mark_D2 levels are 
+*     required
+*/
+
+void LSM3D_HJ_ENO2_LOCAL_NO_SCRATCH(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb,
+  const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z,
+  const int *nlo_index0,
+  const int *nhi_index0,
+  const int *nlo_index1,
+  const int *nhi_index1,
+  const int *nlo_index2,
+  const int *nhi_index2,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
 /*!
 *
 *  LSM3D_CENTRAL_GRAD_ORDER2_LOCAL() computes the second-order central 
@@ -461,6 +541,70 @@ void LSM3D_GRADIENT_MAGNITUDE_LOCAL(
   const unsigned char *mark_fb);   
    
 
+/*!
+*
+*  LSM3D_SELECT_UPWIND_HJ_LOCAL() selects the upwind approximation to the
+*  gradient of phi from precomputed plus and minus HJ derivatives.  
+*  The component of the upwind gradient is set to the minus derivative
+*  when the velocity component is positive, the plus derivative when 
+*  it is negative and zero when it is (numerically) zero.
+*
+*  Arguments:
+*    phi_* (out):        components of upwind grad(phi) 
+*    phi_*_plus (in):    components of grad(phi) in plus direction 
+*    phi_*_minus (in):   components of grad(phi) in minus direction
+*    vel_* (in):         components of velocity
+*    *_gb (in):          index range for ghostbox
+*    index_*(in):        coordinates of local (narrow band) points
+*    n*_index(in):       index range of points to loop over in index_*
+*    narrow_band(in):    array that marks voxels outside desired fillbox
+*    mark_fb(in):        upper limit narrow band value for voxels in 
+*                        fillbox
+*
+*  NOTES:
+*   - the upwind, plus and minus derivatives are assumed to have the 
+*     same ghostbox
+*
+*/
+void LSM3D_SELECT_UPWIND_HJ_LOCAL(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  LSMLIB_REAL *phi_z,
+  const LSMLIB_REAL *phi_x_plus,
+  const LSMLIB_REAL *phi_y_plus,
+  const LSMLIB_REAL *phi_z_plus,
+  const LSMLIB_REAL *phi_x_minus,
+  const LSMLIB_REAL *phi_y_minus,
+  const LSMLIB_REAL *phi_z_minus,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const int *klo_grad_phi_gb,
+  const int *khi_grad_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const LSMLIB_REAL *vel_z,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *klo_vel_gb,
+  const int *khi_vel_gb,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,203 @@
+c***********************************************************************
+c
+c  File:        lsm_semi_implicit3d.f
+c  Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+c                   Regents of the University of Texas.  All rights reserved.
+c               (c) 2009 Kevin T. Chu.  All rights reserved.
+c  Revision:    $Revision$
+c  Modified:    $Date$
+c  Description: F77 routines for 3D semi-implicit time integration of
+c               curvature-driven motion
+c
+c***********************************************************************
+
+c***********************************************************************
+c The semi-implicit method used in these subroutines follows
+c "Semi-Implicit Level Set Methods for Curvature and Surface Diffusion
+c Motion" by P. Smereka (J. Sci. Comp., vol 19, p 439-456, 2003).  The
+c curvature term b*kappa*|grad(phi)| is stabilized by treating the
+c linear term b*Laplacian(phi) implicitly:
+c
+c   phi^{n+1} - dt*b*L(phi^{n+1}) = phi^n + dt*(rhs^n - b*L(phi^n))
+c
+c The implicit operator is approximately factored into one-dimensional
+c operators (alternating direction implicit method), and the step is
+c written in delta form
+c
+c   (1 - dt*b*Dxx)(1 - dt*b*Dyy)(1 - dt*b*Dzz) (phi^{n+1} - phi^n)
+c     = dt*rhs^n
+c
+c so that only tridiagonal systems need to be solved and steady states
+c of the explicit right-hand side are preserved exactly.
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dSemiImplicitCurvatureRHS() replaces the right-hand side of the
+c  level set evolution equation with the right-hand side of the
+c  semi-implicit method,
+c
+c    rhs <- (1 - dt*b*Dxx)^{-1} (1 - dt*b*Dyy)^{-1} (1 - dt*b*Dzz)^{-1} rhs
+c
+c  so that a Forward Euler (or TVD Runge-Kutta stage) update using
+c  the new right-hand side is a semi-implicit step.
+c
+c  Arguments:
+c    rhs (in/out):  right-hand side of time evolution equation
+c    work (out):    work array of length at least n_work
+c    n_work (in):   length of work array; must be at least the largest
+c                   extent of the fillbox
+c    dt (in):       step size
+c    b (in):        coefficient of the curvature term
+c    dx, dy, dz (in):  grid spacing
+c    *_gb (in):     index range for ghostbox
+c    *_fb (in):     index range for fillbox
+c
+c  NOTES:
+c   - the right-hand side should be computed with the curvature term
+c     treated explicitly (e.g. lsm3dAddConstCurvTermToLSERHS())
+c   - the one-dimensional operators use homogeneous Neumann boundary
+c     conditions for phi^{n+1} - phi^n at the boundary of the fillbox
+c   - when b is not positive, rhs is not changed
+c
+c***********************************************************************
+      subroutine lsm3dSemiImplicitCurvatureRHS(
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  jlo_rhs_gb, jhi_rhs_gb,
+     &  klo_rhs_gb, khi_rhs_gb,
+     &  work, n_work,
+     &  ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb,
+     &  dt, b, dx, dy, dz)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer jlo_rhs_gb, jhi_rhs_gb
+      integer klo_rhs_gb, khi_rhs_gb
+      integer ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb
+      integer n_work
+      real rhs(ilo_rhs_gb:ihi_rhs_gb,
+     &                     jlo_rhs_gb:jhi_rhs_gb,
+     &                     klo_rhs_gb:khi_rhs_gb)
+      real work(n_work)
+      real dt, b, dx, dy, dz
+      real cx, cy, cz
+      integer i, j, k, m, n
+      real zero, one, two
+      parameter (zero=0.0d0, one=1.0d0, two=2.0d0)
+
+      if (b .le. zero) return
+
+      cx = dt*b/(dx*dx)
+      cy = dt*b/(dy*dy)
+      cz = dt*b/(dz*dz)
+
+c     { begin solve in x-direction
+      n = ihi_fb - ilo_fb + 1
+      if (n .gt. 1) then
+
+c       inverse of the pivots of the tridiagonal matrix
+        work(1) = one/(one + cx)
+        do m=2,n-1
+          work(m) = one/(one + two*cx - cx*cx*work(m-1))
+        enddo
+        work(n) = one/(one + cx - cx*cx*work(n-1))
+
+        do k=klo_fb,khi_fb
+          do j=jlo_fb,jhi_fb
+
+            rhs(ilo_fb,j,k) = rhs(ilo_fb,j,k)*work(1)
+            do i=ilo_fb+1,ihi_fb
+              m = i - ilo_fb + 1
+              rhs(i,j,k) = (rhs(i,j,k) + cx*rhs(i-1,j,k))*work(m)
+            enddo
+
+            do i=ihi_fb-1,ilo_fb,-1
+              m = i - ilo_fb + 1
+              rhs(i,j,k) = rhs(i,j,k) + cx*work(m)*rhs(i+1,j,k)
+            enddo
+
+          enddo
+        enddo
+
+      endif
+c     } end solve in x-direction
+
+c     { begin solve in y-direction
+      n = jhi_fb - jlo_fb + 1
+      if (n .gt. 1) then
+
+        work(1) = one/(one + cy)
+        do m=2,n-1
+          work(m) = one/(one + two*cy - cy*cy*work(m-1))
+        enddo
+        work(n) = one/(one + cy - cy*cy*work(n-1))
+
+c       the lines in the x-direction are solved together so that the
+c       inner loop has unit stride
+        do k=klo_fb,khi_fb
+
+          do i=ilo_fb,ihi_fb
+            rhs(i,jlo_fb,k) = rhs(i,jlo_fb,k)*work(1)
+          enddo
+          do j=jlo_fb+1,jhi_fb
+            m = j - jlo_fb + 1
+            do i=ilo_fb,ihi_fb
+              rhs(i,j,k) = (rhs(i,j,k) + cy*rhs(i,j-1,k))*work(m)
+            enddo
+          enddo
+
+          do j=jhi_fb-1,jlo_fb,-1
+            m = j - jlo_fb + 1
+            do i=ilo_fb,ihi_fb
+              rhs(i,j,k) = rhs(i,j,k) + cy*work(m)*rhs(i,j+1,k)
+            enddo
+          enddo
+
+        enddo
+
+      endif
+c     } end solve in y-direction
+
+c     { begin solve in z-direction
+      n = khi_fb - klo_fb + 1
+      if (n .gt. 1) then
+
+        work(1) = one/(one + cz)
+        do m=2,n-1
+          work(m) = one/(one + two*cz - cz*cz*work(m-1))
+        enddo
+        work(n) = one/(one + cz - cz*cz*work(n-1))
+
+        do j=jlo_fb,jhi_fb
+          do i=ilo_fb,ihi_fb
+            rhs(i,j,klo_fb) = rhs(i,j,klo_fb)*work(1)
+          enddo
+        enddo
+        do k=klo_fb+1,khi_fb
+          m = k - klo_fb + 1
+          do j=jlo_fb,jhi_fb
+            do i=ilo_fb,ihi_fb
+              rhs(i,j,k) = (rhs(i,j,k) + cz*rhs(i,j,k-1))*work(m)
+            enddo
+          enddo
+        enddo
+
+        do k=khi_fb-1,klo_fb,-1
+          m = k - klo_fb + 1
+          do j=jlo_fb,jhi_fb
+            do i=ilo_fb,ihi_fb
+              rhs(i,j,k) = rhs(i,j,k) + cz*work(m)*rhs(i,j,k+1)
+            enddo
+          enddo
+        enddo
+
+      endif
+c     } end solve in z-direction
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
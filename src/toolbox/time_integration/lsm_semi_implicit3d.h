@@ -0,0 +1,124 @@
+/*
+ * File:        lsm_semi_implicit3d.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for Fortran 77 3D semi-implicit time 
+ *              integration routines
+ */
+
+#ifndef INCLUDED_LSM_SEMI_IMPLICIT_3D_H
+#define INCLUDED_LSM_SEMI_IMPLICIT_3D_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_semi_implicit3d.h
+ *
+ * \brief
+ * @ref lsm_semi_implicit3d.h provides support for semi-implicit time 
+ * integration of curvature-driven motion in three space dimensions.
+ *
+ * The method follows "Semi-Implicit Level Set Methods for Curvature and 
+ * Surface Diffusion Motion" by P. Smereka (J. Sci. Comp., vol 19, 
+ * p 439-456, 2003).  The curvature term b*kappa*|grad(phi)| is 
+ * stabilized by treating the linear term b*Laplacian(phi) implicitly.  
+ * The implicit operator is approximately factored into one-dimensional 
+ * operators (alternating direction implicit method), so that each step 
+ * only requires the solution of tridiagonal systems:
+ *
+ *   (1 - dt*b*Dxx)(1 - dt*b*Dyy)(1 - dt*b*Dzz) (phi^{n+1} - phi^n) 
+ *     = dt*rhs^n
+ *
+ * The stable time step is then limited by the hyperbolic terms (e.g. 
+ * the normal velocity term) instead of the dt ~ dx^2 restriction of 
+ * the explicit curvature term.
+ *
+ */
+
+
+/* Link between C/C++ and Fortran function names
+ *
+ *      name in                             name in
+ *      C/C++ code                          Fortran code
+ *      ----------                          ------------
+ */
+#define LSM3D_SEMI_IMPLICIT_CURVATURE_RHS   lsm3dsemiimplicitcurvaturerhs_
+
+
+/*!
+ * LSM3D_SEMI_IMPLICIT_CURVATURE_RHS() replaces the right-hand side of 
+ * the level set evolution equation with the right-hand side of the 
+ * semi-implicit method
+ *
+ *   rhs <- (1 - dt*b*Dxx)^{-1} (1 - dt*b*Dyy)^{-1} (1 - dt*b*Dzz)^{-1} rhs
+ *
+ * so that a Forward Euler step (or a TVD Runge-Kutta stage) that uses 
+ * the new right-hand side is a semi-implicit step.
+ *
+ * Arguments:
+ *  - rhs (in/out):     right-hand side of time evolution equation
+ *  - work (out):       work array 
+ *  - n_work (in):      length of work array; must be at least the 
+ *                      largest extent of the fillbox
+ *  - dt (in):          step size
+ *  - b (in):           coefficient of the curvature term
+ *  - dx, dy, dz (in):  grid spacing
+ *  - *_gb (in):        index range for ghostbox
+ *  - *_fb (in):        index range for fillbox
+ *
+ * Return value:        none
+ *
+ * NOTES:
+ *  - rhs should be computed with the curvature term treated explicitly
+ *    (e.g. using LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS()).  Because the
+ *    step is written in terms of phi^{n+1} - phi^n, steady states of 
+ *    the explicit right-hand side are preserved exactly.
+ *
+ *  - The one-dimensional operators use homogeneous Neumann boundary 
+ *    conditions for phi^{n+1} - phi^n at the boundary of the fillbox.
+ *
+ *  - The method is stable for time steps much larger than the explicit 
+ *    limit dt < dx^2/(6*b), but it is only first-order accurate in time 
+ *    for the curvature term.  The error is small as long as phi stays 
+ *    close to a signed distance function (i.e. when the level set 
+ *    function is reinitialized periodically).
+ *
+ *  - Because the tridiagonal systems couple all grid points along each
+ *    grid line of the fillbox, there is no narrow-band (_LOCAL) version.
+ *
+ *  - When b is not positive, rhs is not changed.
+ *
+ */
+void LSM3D_SEMI_IMPLICIT_CURVATURE_RHS(
+  LSMLIB_REAL *rhs,
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *klo_rhs_gb,
+  const int *khi_rhs_gb,
+  LSMLIB_REAL *work,
+  const int *n_work,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dt,
+  const LSMLIB_REAL *b,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
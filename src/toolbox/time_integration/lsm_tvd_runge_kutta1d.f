@@ -343,3 +343,178 @@ c     } end loop over grid
       end
 c } end subroutine
 c***********************************************************************
+
+c***********************************************************************
+c The low-storage TVD Runge-Kutta routines below overwrite one of their
+c input arrays with the result of the stage, so that a TVD RK2 or TVD
+c RK3 step requires only two solution arrays (u and a single stage
+c array u_stage) in addition to the right-hand side.  A step proceeds
+c as follows (the first stage is an ordinary RK1 step):
+c
+c   RK2:  RK1Step(u_stage, u) -> LowStorageTVDRK2Stage2(u, u_stage)
+c   RK3:  RK1Step(u_stage, u) -> LowStorageTVDRK3Stage2(u_stage, u)
+c                              -> LowStorageTVDRK3Stage3(u, u_stage)
+c
+c The arithmetic is identical to the TVDRK*Stage* routines, so both
+c forms produce the same solution.
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm1dLowStorageTVDRK2Stage2() completes advancing the solution
+c  through a single step of the second-order TVD Runge-Kutta method
+c  using the low-storage form.
+c  
+c  Arguments:
+c    u (in/out):    on input, u(t_cur); on output, u(t_cur+dt)
+c    u_stage1 (in): u_approx(t_cur+dt)
+c    rhs (in):      right-hand side of time evolution equation
+c    dt (in):       step size
+c    *_gb (in):     index range for ghostbox
+c    *_fb (in):     index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm1dLowStorageTVDRK2Stage2(
+     &  u,
+     &  ilo_u_gb, ihi_u_gb,
+     &  u_stage1,
+     &  ilo_u_stage1_gb, ihi_u_stage1_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  ilo_fb, ihi_fb,
+     &  dt)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_gb, ihi_u_gb
+      integer ilo_u_stage1_gb, ihi_u_stage1_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer ilo_fb, ihi_fb
+      real u(ilo_u_gb:ihi_u_gb)
+      real u_stage1(ilo_u_stage1_gb:ihi_u_stage1_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb)
+      real dt
+      integer i
+
+c     { begin loop over grid
+      do i=ilo_fb,ihi_fb
+
+        u(i) = 0.5d0*( u(i)
+     &         + u_stage1(i) + dt*rhs(i) )
+
+      enddo
+c     } end loop over grid
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm1dLowStorageTVDRK3Stage2() advances the solution through second
+c  stage of the third-order TVD Runge-Kutta method using the low-storage
+c  form.
+c  
+c  Arguments:
+c    u_stage (in/out): on input, u_approx(t_cur+dt);
+c                      on output, u_approx(t_cur+dt/2)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    *_gb (in):        index range for ghostbox
+c    *_fb (in):        index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm1dLowStorageTVDRK3Stage2(
+     &  u_stage,
+     &  ilo_u_stage_gb, ihi_u_stage_gb,
+     &  u_cur,
+     &  ilo_u_cur_gb, ihi_u_cur_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  ilo_fb, ihi_fb,
+     &  dt)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_stage_gb, ihi_u_stage_gb
+      integer ilo_u_cur_gb, ihi_u_cur_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer ilo_fb, ihi_fb
+      real u_stage(ilo_u_stage_gb:ihi_u_stage_gb)
+      real u_cur(ilo_u_cur_gb:ihi_u_cur_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb)
+      real dt
+      integer i
+
+c     { begin loop over grid
+      do i=ilo_fb,ihi_fb
+
+        u_stage(i) = 0.75d0*u_cur(i)
+     &               + 0.25d0*( u_stage(i) + dt*rhs(i) )
+
+      enddo
+c     } end loop over grid
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm1dLowStorageTVDRK3Stage3() completes advancing the solution
+c  through a single step of the third-order TVD Runge-Kutta method using
+c  the low-storage form.
+c  
+c  Arguments:
+c    u (in/out):    on input, u(t_cur); on output, u(t_cur+dt)
+c    u_stage (in):  u_approx(t_cur+dt/2)
+c    rhs (in):      right-hand side of time evolution equation
+c    dt (in):       step size
+c    *_gb (in):     index range for ghostbox
+c    *_fb (in):     index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm1dLowStorageTVDRK3Stage3(
+     &  u,
+     &  ilo_u_gb, ihi_u_gb,
+     &  u_stage,
+     &  ilo_u_stage_gb, ihi_u_stage_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  ilo_fb, ihi_fb,
+     &  dt)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_gb, ihi_u_gb
+      integer ilo_u_stage_gb, ihi_u_stage_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer ilo_fb, ihi_fb
+      real u(ilo_u_gb:ihi_u_gb)
+      real u_stage(ilo_u_stage_gb:ihi_u_stage_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb)
+      real dt
+      integer i
+      real one_third, two_thirds
+      parameter (one_third = 1.d0/3.d0)
+      parameter (two_thirds = 2.d0/3.d0)
+
+c     { begin loop over grid
+      do i=ilo_fb,ihi_fb
+
+        u(i) = one_third*u(i)
+     &         + two_thirds*( u_stage(i) + dt*rhs(i) )
+
+      enddo
+c     } end loop over grid
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
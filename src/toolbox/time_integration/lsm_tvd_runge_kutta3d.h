@@ -24,6 +24,9 @@ extern "C" {
  * partial differential equations in three space dimensions via 
  * total-variation diminishing Runge-Kutta methods.  Support is provided 
  * for first-, second-, and third-order time integration.
+ * Low-storage forms of the second- and third-order methods, which
+ * update the solution in place and need only a single stage array,
+ * are also provided.
  * 
  */
 
@@ -40,6 +43,9 @@ extern "C" {
 #define LSM3D_TVD_RK3_STAGE1                lsm3dtvdrk3stage1_
 #define LSM3D_TVD_RK3_STAGE2                lsm3dtvdrk3stage2_
 #define LSM3D_TVD_RK3_STAGE3                lsm3dtvdrk3stage3_
+#define LSM3D_LOW_STORAGE_TVD_RK2_STAGE2    lsm3dlowstoragetvdrk2stage2_
+#define LSM3D_LOW_STORAGE_TVD_RK3_STAGE2    lsm3dlowstoragetvdrk3stage2_
+#define LSM3D_LOW_STORAGE_TVD_RK3_STAGE3    lsm3dlowstoragetvdrk3stage3_
 
 
 /*!
@@ -343,6 +349,145 @@ void LSM3D_TVD_RK3_STAGE3(
   const int *khi_fb,
   const LSMLIB_REAL *dt);
 
+
+/*!
+ * LSM3D_LOW_STORAGE_TVD_RK2_STAGE2() completes advancing the solution
+ * through a single step of the second-order TVD Runge-Kutta method using
+ * the low-storage form.
+ *
+ * Arguments:
+ *  - u (in/out):     on input, u(t_cur); on output, u(t_cur+dt)
+ *  - u_stage1 (in):  u_approx(t_cur+dt)
+ *  - rhs (in):       right-hand side of time evolution equation
+ *  - dt (in):        step size
+ *  - *_gb (in):      index range for ghostbox
+ *  - *_fb (in):      index range for fillbox
+ *
+ * Return value:      none
+ */
+void LSM3D_LOW_STORAGE_TVD_RK2_STAGE2(
+  LSMLIB_REAL *u,
+  const int *ilo_u_gb,
+  const int *ihi_u_gb,
+  const int *jlo_u_gb,
+  const int *jhi_u_gb,
+  const int *klo_u_gb,
+  const int *khi_u_gb,
+  const LSMLIB_REAL *u_stage1,
+  const int *ilo_u_stage1_gb,
+  const int *ihi_u_stage1_gb,
+  const int *jlo_u_stage1_gb,
+  const int *jhi_u_stage1_gb,
+  const int *klo_u_stage1_gb,
+  const int *khi_u_stage1_gb,
+  const LSMLIB_REAL *rhs, 
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *klo_rhs_gb,
+  const int *khi_rhs_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dt);
+
+
+/*!
+ * LSM3D_LOW_STORAGE_TVD_RK3_STAGE2() advances the solution through second
+ * stage of the third-order TVD Runge-Kutta method using the low-storage
+ * form.
+ *
+ * Arguments:
+ *  - u_stage (in/out):  on input, u_approx(t_cur+dt);
+ *                       on output, u_approx(t_cur+dt/2)
+ *  - u_cur (in):        u(t_cur)
+ *  - rhs (in):          right-hand side of time evolution equation
+ *  - dt (in):           step size
+ *  - *_gb (in):         index range for ghostbox
+ *  - *_fb (in):         index range for fillbox
+ *
+ * Return value:         none
+ */
+void LSM3D_LOW_STORAGE_TVD_RK3_STAGE2(
+  LSMLIB_REAL *u_stage,
+  const int *ilo_u_stage_gb,
+  const int *ihi_u_stage_gb,
+  const int *jlo_u_stage_gb,
+  const int *jhi_u_stage_gb,
+  const int *klo_u_stage_gb,
+  const int *khi_u_stage_gb,
+  const LSMLIB_REAL *u_cur,
+  const int *ilo_u_cur_gb,
+  const int *ihi_u_cur_gb,
+  const int *jlo_u_cur_gb,
+  const int *jhi_u_cur_gb,
+  const int *klo_u_cur_gb,
+  const int *khi_u_cur_gb,
+  const LSMLIB_REAL *rhs, 
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *klo_rhs_gb,
+  const int *khi_rhs_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dt);
+
+
+/*!
+ * LSM3D_LOW_STORAGE_TVD_RK3_STAGE3() completes advancing the solution
+ * through a single step of the third-order TVD Runge-Kutta method using
+ * the low-storage form.
+ *
+ * Arguments:
+ *  - u (in/out):    on input, u(t_cur); on output, u(t_cur+dt)
+ *  - u_stage (in):  u_approx(t_cur+dt/2)
+ *  - rhs (in):      right-hand side of time evolution equation
+ *  - dt (in):       step size
+ *  - *_gb (in):     index range for ghostbox
+ *  - *_fb (in):     index range for fillbox
+ *
+ * Return value:     none
+ */
+void LSM3D_LOW_STORAGE_TVD_RK3_STAGE3(
+  LSMLIB_REAL *u,
+  const int *ilo_u_gb,
+  const int *ihi_u_gb,
+  const int *jlo_u_gb,
+  const int *jhi_u_gb,
+  const int *klo_u_gb,
+  const int *khi_u_gb,
+  const LSMLIB_REAL *u_stage,
+  const int *ilo_u_stage_gb,
+  const int *ihi_u_stage_gb,
+  const int *jlo_u_stage_gb,
+  const int *jhi_u_stage_gb,
+  const int *klo_u_stage_gb,
+  const int *khi_u_stage_gb,
+  const LSMLIB_REAL *rhs, 
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *klo_rhs_gb,
+  const int *khi_rhs_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dt);
+
 #ifdef __cplusplus
 }
 #endif
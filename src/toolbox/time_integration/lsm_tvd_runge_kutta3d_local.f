@@ -93,6 +93,8 @@ c     local variables
       real dt
      
 c     { begin loop over indexed points
+c$omp parallel do default(shared) schedule(static)
+c$omp&  private(i,j,k)
       do l=nlo_index, nhi_index      
         i=index_x(l)
 	j=index_y(l)
@@ -102,6 +104,7 @@ c     { begin loop over indexed points
 	   u_next(i,j,k) = u_cur(i,j,k) + dt*rhs(i,j,k)             
         endif
       enddo
+c$omp end parallel do
 c     } end loop over indexed points
 
       return
@@ -312,6 +315,8 @@ c     local variables
       integer i, j, k, l
 
 c     { begin loop over indexed points
+c$omp parallel do default(shared) schedule(static)
+c$omp&  private(i,j,k)
       do l=nlo_index, nhi_index      
         i=index_x(l)
 	j=index_y(l)
@@ -323,6 +328,7 @@ c     { begin loop over indexed points
         endif
 	
       enddo
+c$omp end parallel do
 c     } end loop over indexed points
 
       return
@@ -532,6 +538,8 @@ c { begin subroutine
       integer i,j,k,l
      
 c     { begin loop over indexed points
+c$omp parallel do default(shared) schedule(static)
+c$omp&  private(i,j,k)
       do l=nlo_index, nhi_index      
         i=index_x(l)
 	j=index_y(l)
@@ -544,6 +552,7 @@ c     { begin loop over indexed points
 
         endif
       enddo
+c$omp end parallel do
 c     } end loop over indexed points
 
       return
@@ -646,6 +655,8 @@ c { begin subroutine
       parameter (two_thirds = 2.d0/3.d0)
 
 c     { begin loop over indexed points
+c$omp parallel do default(shared) schedule(static)
+c$omp&  private(i,j,k)
       do l=nlo_index, nhi_index      
         i=index_x(l)
 	j=index_y(l)
@@ -659,6 +670,317 @@ c     { begin loop over indexed points
        
         endif
       enddo
+c$omp end parallel do
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dLowStorageTVDRK2Stage2LOCAL() completes advancing the solution
+c  through a single step of the second-order TVD Runge-Kutta method
+c  using the low-storage form.
+c  The routine loops only over local (narrow band) points.
+c  
+c  Arguments:
+c    u (in/out):       on input, u(t_cur); on output, u(t_cur+dt)
+c    u_stage1 (in):    u_approx(t_cur+dt)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    *_gb (in):        index range for ghostbox
+c    index_[xyz](in):  [xyz] coordinates of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_*
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in
+c                      fillbox
+c
+c***********************************************************************
+      subroutine lsm3dLowStorageTVDRK2Stage2LOCAL(
+     &  u,
+     &  ilo_u_gb, ihi_u_gb,
+     &  jlo_u_gb, jhi_u_gb,
+     &  klo_u_gb, khi_u_gb,
+     &  u_stage1,
+     &  ilo_u_stage1_gb, ihi_u_stage1_gb,
+     &  jlo_u_stage1_gb, jhi_u_stage1_gb,
+     &  klo_u_stage1_gb, khi_u_stage1_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  jlo_rhs_gb, jhi_rhs_gb,
+     &  klo_rhs_gb, khi_rhs_gb,
+     &  dt,
+     &  index_x,
+     &  index_y,
+     &  index_z,
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb,
+     &  jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_gb, ihi_u_gb
+      integer jlo_u_gb, jhi_u_gb
+      integer klo_u_gb, khi_u_gb
+      integer ilo_u_stage1_gb, ihi_u_stage1_gb
+      integer jlo_u_stage1_gb, jhi_u_stage1_gb
+      integer klo_u_stage1_gb, khi_u_stage1_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer jlo_rhs_gb, jhi_rhs_gb
+      integer klo_rhs_gb, khi_rhs_gb
+      real u(ilo_u_gb:ihi_u_gb,
+     &       jlo_u_gb:jhi_u_gb,
+     &       klo_u_gb:khi_u_gb)
+      real u_stage1(ilo_u_stage1_gb:ihi_u_stage1_gb,
+     &              jlo_u_stage1_gb:jhi_u_stage1_gb,
+     &              klo_u_stage1_gb:khi_u_stage1_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb,
+     &         jlo_rhs_gb:jhi_rhs_gb,
+     &         klo_rhs_gb:khi_rhs_gb)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,
+     &                      jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer*1 mark_fb
+      integer i,j,k,l
+
+c     { begin loop over indexed points
+c$omp parallel do default(shared) schedule(static)
+c$omp&  private(i,j,k)
+      do l=nlo_index, nhi_index
+        i=index_x(l)
+        j=index_y(l)
+        k=index_z(l)
+
+c       include only fill box points (marked appropriately)
+        if( narrow_band(i,j,k) .le. mark_fb ) then
+          u(i,j,k) = 0.5d0*( u(i,j,k)
+     &               + u_stage1(i,j,k) + dt*rhs(i,j,k) )
+        endif
+
+      enddo
+c$omp end parallel do
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dLowStorageTVDRK3Stage2LOCAL() advances the solution through
+c  second stage of the third-order TVD Runge-Kutta method using the
+c  low-storage form.
+c  The routine loops only over local (narrow band) points.
+c  
+c  Arguments:
+c    u_stage (in/out): on input, u_approx(t_cur+dt);
+c                      on output, u_approx(t_cur+dt/2)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    *_gb (in):        index range for ghostbox
+c    index_[xyz](in):  [xyz] coordinates of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_*
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in
+c                      fillbox
+c
+c***********************************************************************
+      subroutine lsm3dLowStorageTVDRK3Stage2LOCAL(
+     &  u_stage,
+     &  ilo_u_stage_gb, ihi_u_stage_gb,
+     &  jlo_u_stage_gb, jhi_u_stage_gb,
+     &  klo_u_stage_gb, khi_u_stage_gb,
+     &  u_cur,
+     &  ilo_u_cur_gb, ihi_u_cur_gb,
+     &  jlo_u_cur_gb, jhi_u_cur_gb,
+     &  klo_u_cur_gb, khi_u_cur_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  jlo_rhs_gb, jhi_rhs_gb,
+     &  klo_rhs_gb, khi_rhs_gb,
+     &  dt,
+     &  index_x,
+     &  index_y,
+     &  index_z,
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb,
+     &  jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_stage_gb, ihi_u_stage_gb
+      integer jlo_u_stage_gb, jhi_u_stage_gb
+      integer klo_u_stage_gb, khi_u_stage_gb
+      integer ilo_u_cur_gb, ihi_u_cur_gb
+      integer jlo_u_cur_gb, jhi_u_cur_gb
+      integer klo_u_cur_gb, khi_u_cur_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer jlo_rhs_gb, jhi_rhs_gb
+      integer klo_rhs_gb, khi_rhs_gb
+      real u_stage(ilo_u_stage_gb:ihi_u_stage_gb,
+     &             jlo_u_stage_gb:jhi_u_stage_gb,
+     &             klo_u_stage_gb:khi_u_stage_gb)
+      real u_cur(ilo_u_cur_gb:ihi_u_cur_gb,
+     &           jlo_u_cur_gb:jhi_u_cur_gb,
+     &           klo_u_cur_gb:khi_u_cur_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb,
+     &         jlo_rhs_gb:jhi_rhs_gb,
+     &         klo_rhs_gb:khi_rhs_gb)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,
+     &                      jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer*1 mark_fb
+      integer i,j,k,l
+
+c     { begin loop over indexed points
+c$omp parallel do default(shared) schedule(static)
+c$omp&  private(i,j,k)
+      do l=nlo_index, nhi_index
+        i=index_x(l)
+        j=index_y(l)
+        k=index_z(l)
+
+c       include only fill box points (marked appropriately)
+        if( narrow_band(i,j,k) .le. mark_fb ) then
+          u_stage(i,j,k) = 0.75d0*u_cur(i,j,k)
+     &                     + 0.25d0*( u_stage(i,j,k) + dt*rhs(i,j,k) )
+        endif
+
+      enddo
+c$omp end parallel do
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dLowStorageTVDRK3Stage3LOCAL() completes advancing the solution
+c  through a single step of the third-order TVD Runge-Kutta method using
+c  the low-storage form.
+c  The routine loops only over local (narrow band) points.
+c  
+c  Arguments:
+c    u (in/out):       on input, u(t_cur); on output, u(t_cur+dt)
+c    u_stage (in):     u_approx(t_cur+dt/2)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    *_gb (in):        index range for ghostbox
+c    index_[xyz](in):  [xyz] coordinates of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_*
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in
+c                      fillbox
+c
+c***********************************************************************
+      subroutine lsm3dLowStorageTVDRK3Stage3LOCAL(
+     &  u,
+     &  ilo_u_gb, ihi_u_gb,
+     &  jlo_u_gb, jhi_u_gb,
+     &  klo_u_gb, khi_u_gb,
+     &  u_stage,
+     &  ilo_u_stage_gb, ihi_u_stage_gb,
+     &  jlo_u_stage_gb, jhi_u_stage_gb,
+     &  klo_u_stage_gb, khi_u_stage_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  jlo_rhs_gb, jhi_rhs_gb,
+     &  klo_rhs_gb, khi_rhs_gb,
+     &  dt,
+     &  index_x,
+     &  index_y,
+     &  index_z,
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb,
+     &  jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_gb, ihi_u_gb
+      integer jlo_u_gb, jhi_u_gb
+      integer klo_u_gb, khi_u_gb
+      integer ilo_u_stage_gb, ihi_u_stage_gb
+      integer jlo_u_stage_gb, jhi_u_stage_gb
+      integer klo_u_stage_gb, khi_u_stage_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer jlo_rhs_gb, jhi_rhs_gb
+      integer klo_rhs_gb, khi_rhs_gb
+      real u(ilo_u_gb:ihi_u_gb,
+     &       jlo_u_gb:jhi_u_gb,
+     &       klo_u_gb:khi_u_gb)
+      real u_stage(ilo_u_stage_gb:ihi_u_stage_gb,
+     &             jlo_u_stage_gb:jhi_u_stage_gb,
+     &             klo_u_stage_gb:khi_u_stage_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb,
+     &         jlo_rhs_gb:jhi_rhs_gb,
+     &         klo_rhs_gb:khi_rhs_gb)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,
+     &                      jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer*1 mark_fb
+      integer i,j,k,l
+      real one_third, two_thirds
+      parameter (one_third = 1.d0/3.d0)
+      parameter (two_thirds = 2.d0/3.d0)
+
+c     { begin loop over indexed points
+c$omp parallel do default(shared) schedule(static)
+c$omp&  private(i,j,k)
+      do l=nlo_index, nhi_index
+        i=index_x(l)
+        j=index_y(l)
+        k=index_z(l)
+
+c       include only fill box points (marked appropriately)
+        if( narrow_band(i,j,k) .le. mark_fb ) then
+          u(i,j,k) = one_third*u(i,j,k)
+     &               + two_thirds*( u_stage(i,j,k) + dt*rhs(i,j,k) )
+        endif
+
+      enddo
+c$omp end parallel do
 c     } end loop over indexed points
 
       return
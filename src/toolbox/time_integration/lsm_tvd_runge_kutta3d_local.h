@@ -25,6 +25,9 @@
 #define LSM3D_TVD_RK3_STAGE1_LOCAL                lsm3dtvdrk3stage1local_
 #define LSM3D_TVD_RK3_STAGE2_LOCAL                lsm3dtvdrk3stage2local_
 #define LSM3D_TVD_RK3_STAGE3_LOCAL                lsm3dtvdrk3stage3local_
+#define LSM3D_LOW_STORAGE_TVD_RK2_STAGE2_LOCAL    lsm3dlowstoragetvdrk2stage2local_
+#define LSM3D_LOW_STORAGE_TVD_RK3_STAGE2_LOCAL    lsm3dlowstoragetvdrk3stage2local_
+#define LSM3D_LOW_STORAGE_TVD_RK3_STAGE3_LOCAL    lsm3dlowstoragetvdrk3stage3local_
 
 #include "LSMLIB_config.h"
 
@@ -278,6 +281,121 @@ void LSM3D_TVD_RK3_STAGE1_LOCAL(
   const int *khi_nb_gb,
   const unsigned char *mark_fb);
        
+
+
+void LSM3D_LOW_STORAGE_TVD_RK2_STAGE2_LOCAL(
+  LSMLIB_REAL *u,
+  const int *ilo_u_gb,
+  const int *ihi_u_gb,
+  const int *jlo_u_gb,
+  const int *jhi_u_gb,
+  const int *klo_u_gb,
+  const int *khi_u_gb,
+  const LSMLIB_REAL *u_stage1,
+  const int *ilo_u_stage1_gb,
+  const int *ihi_u_stage1_gb,
+  const int *jlo_u_stage1_gb,
+  const int *jhi_u_stage1_gb,
+  const int *klo_u_stage1_gb,
+  const int *khi_u_stage1_gb,
+  const LSMLIB_REAL *rhs, 
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *klo_rhs_gb,
+  const int *khi_rhs_gb,
+  const LSMLIB_REAL *dt,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+void LSM3D_LOW_STORAGE_TVD_RK3_STAGE2_LOCAL(
+  LSMLIB_REAL *u_stage,
+  const int *ilo_u_stage_gb,
+  const int *ihi_u_stage_gb,
+  const int *jlo_u_stage_gb,
+  const int *jhi_u_stage_gb,
+  const int *klo_u_stage_gb,
+  const int *khi_u_stage_gb,
+  const LSMLIB_REAL *u_cur,
+  const int *ilo_u_cur_gb,
+  const int *ihi_u_cur_gb,
+  const int *jlo_u_cur_gb,
+  const int *jhi_u_cur_gb,
+  const int *klo_u_cur_gb,
+  const int *khi_u_cur_gb,
+  const LSMLIB_REAL *rhs, 
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *klo_rhs_gb,
+  const int *khi_rhs_gb,
+  const LSMLIB_REAL *dt,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+void LSM3D_LOW_STORAGE_TVD_RK3_STAGE3_LOCAL(
+  LSMLIB_REAL *u,
+  const int *ilo_u_gb,
+  const int *ihi_u_gb,
+  const int *jlo_u_gb,
+  const int *jhi_u_gb,
+  const int *klo_u_gb,
+  const int *khi_u_gb,
+  const LSMLIB_REAL *u_stage,
+  const int *ilo_u_stage_gb,
+  const int *ihi_u_stage_gb,
+  const int *jlo_u_stage_gb,
+  const int *jhi_u_stage_gb,
+  const int *klo_u_stage_gb,
+  const int *khi_u_stage_gb,
+  const LSMLIB_REAL *rhs, 
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *klo_rhs_gb,
+  const int *khi_rhs_gb,
+  const LSMLIB_REAL *dt,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,8 @@ extern "C" {
 
 #define LSM2D_MAX_NORM_DIFF_CONTROL_VOLUME                                    \
                        lsm2dmaxnormdiffcontrolvolume_
+#define LSM2D_MAX_NORM_DIFF_NEAR_INTERFACE_CONTROL_VOLUME                     \
+                       lsm2dmaxnormdiffnearinterfacecontrolvolume_
 #define LSM2D_COMPUTE_STABLE_ADVECTION_DT_CONTROL_VOLUME                      \
                        lsm2dcomputestableadvectiondtcontrolvolume_
 #define LSM2D_COMPUTE_STABLE_NORMAL_VEL_DT_CONTROL_VOLUME                    \
@@ -558,6 +560,51 @@ void LSM2D_MAX_NORM_DIFF_CONTROL_VOLUME(
   const int *jhi_ib);
 
 
+/*!
+ * LSM2D_MAX_NORM_DIFF_NEAR_INTERFACE_CONTROL_VOLUME() computes the max 
+ * norm of the difference between a level set function and a reference 
+ * level set function in the cells near the zero level set of the 
+ * reference (|field_ref| < cutoff) that have a positive control volume.
+ *      
+ * Arguments:
+ *  - max_norm_diff (out):  max norm of the difference between the fields
+ *                          (zero if no cells are included)
+ *  - field (in):           level set function
+ *  - field_ref (in):       reference level set function
+ *  - control_vol (in):     control volume data (used to exclude cells
+ *                          from the max norm calculation)
+ *  - cutoff (in):          only cells with |field_ref| < cutoff are 
+ *                          included in the max norm calculation
+ *  - *_gb (in):            index range for ghostbox
+ *  - *_ib (in):            index range for box to include in norm
+ *                          calculation
+ *
+ * Return value:            none
+ */
+void LSM2D_MAX_NORM_DIFF_NEAR_INTERFACE_CONTROL_VOLUME(
+  LSMLIB_REAL *max_norm_diff,
+  const LSMLIB_REAL *field,
+  const int *ilo_field_gb, 
+  const int *ihi_field_gb,
+  const int *jlo_field_gb, 
+  const int *jhi_field_gb,
+  const LSMLIB_REAL *field_ref,
+  const int *ilo_field_ref_gb, 
+  const int *ihi_field_ref_gb,
+  const int *jlo_field_ref_gb, 
+  const int *jhi_field_ref_gb,
+  const LSMLIB_REAL *control_vol,
+  const int *ilo_control_vol_gb, 
+  const int *ihi_control_vol_gb,
+  const int *jlo_control_vol_gb, 
+  const int *jhi_control_vol_gb,
+  const LSMLIB_REAL *cutoff,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib);
+
+
 /*!
  * LSM2D_COMPUTE_STABLE_ADVECTION_DT_CONTROL_VOLUME() computes the stable 
  * time step size for an advection term based on a CFL criterion for